@@ -231,6 +231,7 @@ typedef unsigned char byte;
 #define CM_DEFAULT_PRINT_BUFFER_SIZE           (1*1024*1024) // 1M print buffer size
 #define PRINT_BUFFER_HEADER_SIZE            32
 #define CM_PRINTF_STATIC_BUFFER_ID          1
+#define CM_PRINT_BUFFER_SLOT_COUNT          4
 
 #define CM_INVALID_COLOR_COUNT              0
 
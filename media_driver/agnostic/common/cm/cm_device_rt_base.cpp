@@ -126,10 +126,10 @@ CmDeviceRTBase::CmDeviceRTBase(uint32_t options):
     m_gtpin(nullptr),
 #endif
     m_printBufferMem (nullptr),
-    m_printBufferUP(nullptr),
     m_isPrintEnabled(false),
     m_printBufferSize(0),
-    m_printBufferIndex(nullptr),
+    m_printBufferSlotCurrent(CM_PRINT_BUFFER_SLOT_COUNT - 1),
+    m_printStreamOut(nullptr),
     m_threadGroupSpaceArray(CM_INIT_THREADGROUPSPACE_COUNT),
     m_threadGroupSpaceCount(0),
     m_taskArray(CM_INIT_TASK_COUNT),
@@ -147,6 +147,7 @@ CmDeviceRTBase::CmDeviceRTBase(uint32_t options):
     MOS_ZeroMemory(&m_halMaxValues, sizeof(m_halMaxValues));
     MOS_ZeroMemory(&m_halMaxValuesEx, sizeof(m_halMaxValuesEx));
     MOS_ZeroMemory(&m_cmHalCreateOption, sizeof(m_cmHalCreateOption));
+    MOS_ZeroMemory(m_printBufferSlots, sizeof(m_printBufferSlots));
 
     //Initialize Dev Create Param
     InitDevCreateOption( m_cmHalCreateOption, options );
@@ -172,17 +173,6 @@ void CmDeviceRTBase::DestructCommon()
         DestroyProgram(m_surfInitKernelProgram);
     }
 
-    //Free the surface/memory for print buffer
-    if(m_printBufferMem)
-    {
-        MOS_AlignedFreeMemory(m_printBufferMem);
-    }
-
-    if(m_printBufferUP)
-    {
-        DestroyBufferUP(m_printBufferUP);
-    }
-
 #if USE_EXTENSION_CODE
     // Free CmGTPin
     MOS_Delete(m_gtpin);
@@ -202,6 +192,14 @@ void CmDeviceRTBase::DestructCommon()
         pCmData->cmHalState->advExecutor->WaitForAllTasksFinished();
     }
 
+    // Free the surface/memory for print buffer once the tasks have drained it
+    DestroyPrintBuffer();
+    if (m_printStreamOut && m_printStreamOut != stdout)
+    {
+        fclose(m_printStreamOut);
+    }
+    m_printStreamOut = nullptr;
+
     for( uint32_t i = 0; i < m_kernelCount; i ++ )
     {
         CmKernelRT* kernel = (CmKernelRT*)m_kernelArray.GetElement( i );
@@ -2982,13 +2980,20 @@ finish:
 
 //*-----------------------------------------------------------------------------
 //| Purpose:    Create print buffer to support print in cm kernel
+//|             The print buffer is a ring of CM_PRINT_BUFFER_SLOT_COUNT slots of
+//|             printbufsize bytes. Each task is bound to a slot, which keeps the
+//|             output of its tasks until they completed and a flush selected
+//|             the stream it is drained into.
 //| Returns:    result of operation.
 //*-----------------------------------------------------------------------------
 CM_RT_API int32_t CmDeviceRTBase::InitPrintBuffer(size_t printbufsize)
 {
     INSERT_API_CALL_LOG();
 
-    if (m_printBufferUP)
+    int32_t result   = CM_SUCCESS;
+    size_t  slotSize = 0;
+
+    if (m_printBufferMem)
     {
         if (printbufsize == m_printBufferSize)
         {
@@ -2998,35 +3003,88 @@ CM_RT_API int32_t CmDeviceRTBase::InitPrintBuffer(size_t printbufsize)
         else
         {
             // Free the existing one first
-            DestroyBufferUP(m_printBufferUP);
-            MOS_AlignedFreeMemory(m_printBufferMem);
+            DestroyPrintBuffer();
         }
     }
 
-    /// Allocate and Initialize host memory.
+    CLock locker(m_criticalSectionPrintBuffer);
+
+    /// Allocate and Initialize host memory, each slot starts at a page
     m_printBufferSize = printbufsize;
-    m_printBufferMem = (uint8_t*)MOS_AlignedAllocMemory(m_printBufferSize, 0x1000); //PAGE SIZE
+    slotSize = MOS_ALIGN_CEIL(m_printBufferSize, 0x1000);
+    m_printBufferMem = (uint8_t*)MOS_AlignedAllocMemory(slotSize * CM_PRINT_BUFFER_SLOT_COUNT, 0x1000); //PAGE SIZE
     if(!m_printBufferMem)
     {
         return CM_OUT_OF_HOST_MEMORY;
     }
 
-    CmSafeMemSet(m_printBufferMem, 0, m_printBufferSize);
-    *(unsigned int*)m_printBufferMem = PRINT_BUFFER_HEADER_SIZE;
-
-    /// Allocate device memory and MemCopy from host to device.
-    int32_t result = CreateBufferUP((uint32_t)m_printBufferSize, m_printBufferMem, m_printBufferUP);
-    if (result != CM_SUCCESS || m_printBufferUP == nullptr)
+    MOS_ZeroMemory(m_printBufferSlots, sizeof(m_printBufferSlots));
+    m_printBufferSlotCurrent = CM_PRINT_BUFFER_SLOT_COUNT - 1;
+    for (uint32_t i = 0; i < CM_PRINT_BUFFER_SLOT_COUNT; i++)
     {
-        m_isPrintEnabled = false;
-        MOS_AlignedFreeMemory(m_printBufferMem);
-        return result;
+        CM_PRINT_BUFFER_SLOT *slot = &m_printBufferSlots[i];
+        slot->mem = m_printBufferMem + i * slotSize;
+        CmSafeMemSet(slot->mem, 0, m_printBufferSize);
+        *(unsigned int*)slot->mem = PRINT_BUFFER_HEADER_SIZE;
+
+        /// Allocate device memory and MemCopy from host to device.
+        result = CreateBufferUP((uint32_t)m_printBufferSize, slot->mem, slot->bufferUP);
+        if (result != CM_SUCCESS || slot->bufferUP == nullptr)
+        {
+            for (uint32_t j = 0; j < i; j++)
+            {
+                DestroyBufferUP(m_printBufferSlots[j].bufferUP);
+            }
+            MOS_ZeroMemory(m_printBufferSlots, sizeof(m_printBufferSlots));
+            m_isPrintEnabled = false;
+            MOS_AlignedFreeMemory(m_printBufferMem);
+            m_printBufferMem = nullptr;
+            return (result != CM_SUCCESS) ? result : CM_FAILURE;
+        }
+        slot->bufferUP->GetIndex(slot->index);
     }
-    m_printBufferUP->GetIndex(m_printBufferIndex);
+
     m_isPrintEnabled = true;
     return CM_SUCCESS;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Destroy the print buffer, the output left in the slots is
+//|             drained into the selected stream, dropped if none is selected
+//| Returns:    None.
+//*-----------------------------------------------------------------------------
+void CmDeviceRTBase::DestroyPrintBuffer()
+{
+    CLock locker(m_criticalSectionPrintBuffer);
+
+    if (m_printBufferMem == nullptr)
+    {
+        return;
+    }
+
+    for (uint32_t i = 1; i <= CM_PRINT_BUFFER_SLOT_COUNT; i++)
+    {
+        CM_PRINT_BUFFER_SLOT *slot = &m_printBufferSlots[(m_printBufferSlotCurrent + i) % CM_PRINT_BUFFER_SLOT_COUNT];
+        if (slot->bufferUP)
+        {
+            if (m_printStreamOut)
+            {
+                DrainPrintBufferSlot(slot, m_printStreamOut);
+            }
+            DestroyBufferUP(slot->bufferUP);
+        }
+    }
+    if (m_printStreamOut)
+    {
+        fflush(m_printStreamOut);
+    }
+    MOS_ZeroMemory(m_printBufferSlots, sizeof(m_printBufferSlots));
+
+    MOS_AlignedFreeMemory(m_printBufferMem);
+    m_printBufferMem = nullptr;
+    m_isPrintEnabled = false;
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:    Get print buffer memory
 //| Returns:    result of operation.
@@ -3038,35 +3096,103 @@ int32_t CmDeviceRTBase::GetPrintBufferMem(unsigned char * &printBufferMem) const
 }
 
 //*-----------------------------------------------------------------------------
-//| Purpose:    Get the print buffer's surface index
-//| Returns:    The print buffer's surface index
+//| Purpose:    Bind a task to a slot of the print buffer ring
+//|             Each task is bound to the next slot. When that slot is still used
+//|             by running tasks or holds output not flushed yet, the task shares
+//|             the current slot instead, its output is added after the output
+//|             already there.
+//| Returns:    result of operation.
 //*-----------------------------------------------------------------------------
-int32_t CmDeviceRTBase::GetPrintBufferIndex(SurfaceIndex *& index) const
+int32_t CmDeviceRTBase::AcquirePrintBufferSlot(int32_t &slot, SurfaceIndex *& index)
 {
-    index = m_printBufferIndex;
+    CLock locker(m_criticalSectionPrintBuffer);
+
+    slot  = CM_INVALID_INDEX;
+    index = nullptr;
+    if (m_printBufferMem == nullptr)
+    {
+        return CM_FAILURE;
+    }
+
+    uint32_t             nextSlot = (m_printBufferSlotCurrent + 1) % CM_PRINT_BUFFER_SLOT_COUNT;
+    CM_PRINT_BUFFER_SLOT *next    = &m_printBufferSlots[nextSlot];
+    if (next->taskCount == 0 && *(unsigned int*)next->mem == PRINT_BUFFER_HEADER_SIZE)
+    {
+        m_printBufferSlotCurrent = nextSlot;
+    }
+
+    CM_PRINT_BUFFER_SLOT *current = &m_printBufferSlots[m_printBufferSlotCurrent];
+    current->taskCount++;
+    slot  = (int32_t)m_printBufferSlotCurrent;
+    index = current->index;
     return CM_SUCCESS;
 }
 
 //*-----------------------------------------------------------------------------
-//| Purpose:    Whether the kernel print is enabled
-//| Returns:    Whether the kernel print is enabled.
+//| Purpose:    Release a slot of the print buffer ring when a task completes
+//|             Once a flush selected the output stream, the idle slots are
+//|             drained into it from the oldest one, up to the first slot still
+//|             used by running tasks so that the output stays in task order.
+//|             Until then the output is kept for the first flush.
+//| Returns:    None.
 //*-----------------------------------------------------------------------------
-bool CmDeviceRTBase::IsPrintEnable() const
+void CmDeviceRTBase::ReleasePrintBufferSlot(int32_t slot)
 {
-     return m_isPrintEnabled;
+    CLock locker(m_criticalSectionPrintBuffer);
+
+    if (slot < 0 || slot >= CM_PRINT_BUFFER_SLOT_COUNT || m_printBufferMem == nullptr)
+    {
+        return;
+    }
+
+    CM_PRINT_BUFFER_SLOT *printSlot = &m_printBufferSlots[slot];
+    if (printSlot->taskCount > 0)
+    {
+        printSlot->taskCount--;
+    }
+
+    if (m_printStreamOut == nullptr)
+    {
+        return;
+    }
+
+    for (uint32_t i = 1; i <= CM_PRINT_BUFFER_SLOT_COUNT; i++)
+    {
+        CM_PRINT_BUFFER_SLOT *idleSlot = &m_printBufferSlots[(m_printBufferSlotCurrent + i) % CM_PRINT_BUFFER_SLOT_COUNT];
+        if (idleSlot->taskCount > 0)
+        {
+            break;
+        }
+        DrainPrintBufferSlot(idleSlot, m_printStreamOut);
+    }
+    fflush(m_printStreamOut);
 }
 
 //*-----------------------------------------------------------------------------
-//| Purpose:    Clear print buffer
-//| Returns:    CM_SUCCESS.
+//| Purpose:    Parse the output of a print buffer slot into streamOut and
+//|             recycle the slot. Called with the print buffer lock held.
+//| Returns:    None.
 //*-----------------------------------------------------------------------------
-int32_t CmDeviceRTBase::ClearPrintBuffer()
+void CmDeviceRTBase::DrainPrintBufferSlot(CM_PRINT_BUFFER_SLOT *printSlot, FILE *streamOut)
 {
-    //clean memory
-    CmSafeMemSet(m_printBufferMem, 0, m_printBufferSize);
-    *(unsigned int*)m_printBufferMem = PRINT_BUFFER_HEADER_SIZE;
+#if CM_KERNEL_PRINTF_ON
+    if (*(unsigned int*)printSlot->mem > PRINT_BUFFER_HEADER_SIZE)
+    {
+        DumpAllThreadOutput(streamOut, printSlot->mem, m_printBufferSize);
+    }
+#endif
 
-    return CM_SUCCESS;
+    //Rewind the write offset, the kernels write over the consumed output
+    *(unsigned int*)printSlot->mem = PRINT_BUFFER_HEADER_SIZE;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Whether the kernel print is enabled
+//| Returns:    Whether the kernel print is enabled.
+//*-----------------------------------------------------------------------------
+bool CmDeviceRTBase::IsPrintEnable() const
+{
+     return m_isPrintEnabled;
 }
 
 //*-----------------------------------------------------------------------------
@@ -3429,7 +3555,11 @@ bool CmDeviceRTBase::CheckGTPinEnabled( )
 #endif
 
 //*-----------------------------------------------------------------------------
-//| Purpose:    Internal function to flush print buffer on stdout or file.
+//| Purpose:    Internal function to flush print buffer to stdout or file.
+//|             The stdout or the file becomes the stream the device drains the
+//|             tasks into as they complete, the previous file is closed. The
+//|             slots whose tasks all completed are dumped, oldest first, the
+//|             slots still used by running tasks are drained when they complete.
 //| Returns:    result of operation.
 //*-----------------------------------------------------------------------------
 int32_t CmDeviceRTBase::FlushPrintBufferInternal(const char *filename)
@@ -3451,6 +3581,8 @@ int32_t CmDeviceRTBase::FlushPrintBufferInternal(const char *filename)
         }
     }
 
+    CLock locker(m_criticalSectionPrintBuffer);
+
     if( m_printBufferMem == nullptr ||
         m_printBufferSize == 0 ||
         m_isPrintEnabled == false)
@@ -3461,20 +3593,23 @@ int32_t CmDeviceRTBase::FlushPrintBufferInternal(const char *filename)
         return CM_FAILURE;
     }
 
-    //Dump memory on the screen.
-    DumpAllThreadOutput(streamOutFile, m_printBufferMem, m_printBufferSize);
+    if (m_printStreamOut && m_printStreamOut != stdout)
+    {
+        fclose(m_printStreamOut);
+    }
+    m_printStreamOut = streamOutFile;
 
-    //Flush and close stream
-    fflush(streamOutFile);
-    if (filename && streamOutFile)
+    //Dump the idle slots from the oldest one
+    for (uint32_t i = 1; i <= CM_PRINT_BUFFER_SLOT_COUNT; i++)
     {
-        fclose(streamOutFile);
-        streamOutFile = nullptr;
+        CM_PRINT_BUFFER_SLOT *slot = &m_printBufferSlots[(m_printBufferSlotCurrent + i) % CM_PRINT_BUFFER_SLOT_COUNT];
+        if (slot->taskCount == 0)
+        {
+            DrainPrintBufferSlot(slot, m_printStreamOut);
+        }
     }
 
-    //clean memory
-    CmSafeMemSet(m_printBufferMem, 0, m_printBufferSize);
-    *(unsigned int*)m_printBufferMem = sizeof(CM_PRINT_HEADER);
+    fflush(m_printStreamOut);
 
     return CM_SUCCESS;
 #else
@@ -65,6 +65,15 @@ class CmSurface3D;
 class CmSampler8x8;
 class CmSampler8x8State_RT;
 
+//! \brief    Print buffer slot bound to the tasks running printf() in kernel
+struct CM_PRINT_BUFFER_SLOT
+{
+    unsigned char  *mem;        // dword 0 is the write offset the kernels add to atomically
+    CmBufferUP     *bufferUP;
+    SurfaceIndex   *index;
+    uint32_t       taskCount;   // Tasks bound to the slot and not completed
+};
+
 //! \brief    Class CmDeviceRTBase definitions
 class CmDeviceRTBase: public CmDevice
 {
@@ -351,7 +360,9 @@ public:
 
     int32_t Release();
 
-    int32_t GetPrintBufferIndex(SurfaceIndex *& pIndex) const;
+    int32_t AcquirePrintBufferSlot(int32_t &slot, SurfaceIndex *& pIndex);
+
+    void ReleasePrintBufferSlot(int32_t slot);
 
     bool IsPrintEnable() const;
 
@@ -359,8 +370,6 @@ public:
 
     int32_t GetPrintBufferMem(unsigned char *& pPrintBufferMem) const;
 
-    int32_t ClearPrintBuffer();
-
     int32_t GetSurf2DLookUpEntry(uint32_t index,
                                  PCMLOOKUP_ENTRY &pLookupEntry);
 
@@ -464,6 +473,10 @@ protected:
 
     int32_t FlushPrintBufferInternal(const char *filename);
 
+    void DrainPrintBufferSlot(CM_PRINT_BUFFER_SLOT *pSlot, FILE *streamOut);
+
+    void DestroyPrintBuffer();
+
     MOS_CONTEXT    *m_mosContext;
 
     void* m_accelData;          // Pointer to the private data used by the acceleration service
@@ -547,15 +560,19 @@ protected:
 
     CSync m_criticalSectionQueue;
 
-    unsigned char* m_printBufferMem;
+    CSync m_criticalSectionPrintBuffer;
 
-    CmBufferUP*    m_printBufferUP;
+    unsigned char* m_printBufferMem;
 
     bool           m_isPrintEnabled;
 
     size_t         m_printBufferSize;
 
-    SurfaceIndex*  m_printBufferIndex;
+    CM_PRINT_BUFFER_SLOT m_printBufferSlots[CM_PRINT_BUFFER_SLOT_COUNT];  // Ring of print buffers
+
+    uint32_t       m_printBufferSlotCurrent;    // Slot the last task was bound to
+
+    FILE*          m_printStreamOut;            // Stream the completed tasks are drained into, nullptr until a flush selects it
 
     CmDynamicArray m_threadGroupSpaceArray;
 
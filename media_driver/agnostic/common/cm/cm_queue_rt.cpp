@@ -153,7 +153,8 @@ CmQueueRT::~CmQueueRT()
     }
     m_eventArray.Delete();
 
-    // Do not destroy the kernel in m_copyKernelParamArray.
+    // Do not destroy the kernel, task and thread space in m_copyKernelParamArray,
+    // nor the BufferUP in m_copyBufferUPPool.
     // They have been destoyed in ~CmDevice() before destroying Queue
     for( uint32_t i = 0; i < m_copyKernelParamArrayCount; i ++ )
     {
@@ -447,11 +448,6 @@ CM_RT_API int32_t CmQueueRT::Enqueue(
     }
 #endif
 
-    if(m_device->IsPrintEnable())
-    {
-        m_device->ClearPrintBuffer();
-    }
-
     typedef CmKernelRT* pCmKernel;
     CmKernelRT** tmp = MOS_NewArray(pCmKernel, (kernelCount + 1));
     if(tmp == nullptr)
@@ -820,11 +816,6 @@ CM_RT_API int32_t CmQueueRT::EnqueueWithGroup( CmTask* task, CmEvent* & event, c
         return CM_FAILURE;
     }
 
-    if(m_device->IsPrintEnable())
-    {
-        m_device->ClearPrintBuffer();
-    }
-
     typedef CmKernelRT* pCmKernel;
     CmKernelRT** tmp = MOS_NewArray(pCmKernel, (count+1));
     if(tmp == nullptr)
@@ -938,11 +929,6 @@ CM_RT_API int32_t CmQueueRT::EnqueueWithHints(
         splitTask = true;
     }
 
-    if( m_device->IsPrintEnable() )
-    {
-        m_device->ClearPrintBuffer();
-    }
-
     kernels = MOS_NewArray(CmKernelRT*, (count + 1));
     CM_CHK_NULL_GOTOFINISH_CMERROR(kernels);
 
@@ -1453,7 +1439,7 @@ int32_t CmQueueRT::EnqueueCopyInternal_1Plane(CmSurface2DRT* surface,
         }
 
         kernel = nullptr;
-        CM_CHK_CMSTATUS_GOTOFINISH( m_device->CreateBufferUP(  sliceCopyBufferUPSize, ( void * )linearAddressAligned, cmbufferUP ));
+        CM_CHK_CMSTATUS_GOTOFINISH(AcquireGPUCopyBufferUP(linearAddressAligned, sliceCopyBufferUPSize, cmbufferUP));
         CM_CHK_NULL_GOTOFINISH_CMERROR(cmbufferUP);
 
         //Configure memory object control for BufferUP to solve the cache-line issue.
@@ -1475,7 +1461,6 @@ int32_t CmQueueRT::EnqueueCopyInternal_1Plane(CmSurface2DRT* surface,
         threadHeight = ( uint32_t )ceil( ( double )sliceCopyHeightRow/BLOCK_HEIGHT/INNER_LOOP );
         threadNum = threadWidth * threadHeight;
         CM_CHK_CMSTATUS_GOTOFINISH(kernel->SetThreadCount( threadNum ));
-        CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateThreadSpace( threadWidth, threadHeight, threadSpace ));
 
         if(direction == CM_FASTCOPY_GPU2CPU)
         {
@@ -1520,20 +1505,12 @@ int32_t CmQueueRT::EnqueueCopyInternal_1Plane(CmSurface2DRT* surface,
             CM_CHK_CMSTATUS_GOTOFINISH(kernel->SetKernelArg( 7, sizeof( uint32_t ), &startY ));
         }
 
-        CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateTask(gpuCopyTask));
-        CM_CHK_CMSTATUS_GOTOFINISH(gpuCopyTask->AddKernel( kernel ));
-        if (option & CM_FASTCOPY_OPTION_DISABLE_TURBO_BOOST)
-        {
-            // disable turbo
-            CM_TASK_CONFIG taskConfig;
-            CmSafeMemSet(&taskConfig, 0, sizeof(CM_TASK_CONFIG));
-            taskConfig.turboBoostFlag = CM_TURBO_BOOST_DISABLE;
-            gpuCopyTask->SetProperty(taskConfig);
-        }
+        CM_CHK_CMSTATUS_GOTOFINISH(GetGPUCopyTask(gpuCopyKernelParam, threadWidth, threadHeight, option, gpuCopyTask, threadSpace));
         CM_CHK_CMSTATUS_GOTOFINISH(EnqueueFast(gpuCopyTask, internalEvent,
                                            threadSpace));
 
         GPUCOPY_KERNEL_UNLOCK(gpuCopyKernelParam);
+        ReleaseGPUCopyBufferUP(cmbufferUP, false);
 
         //update for next slice
         linearAddress += sliceCopyBufferUPSize - addedShiftLeftOffset;
@@ -1551,6 +1528,7 @@ int32_t CmQueueRT::EnqueueCopyInternal_1Plane(CmSurface2DRT* surface,
             if ((option & CM_FASTCOPY_OPTION_BLOCKING) && (internalEvent))
             {
                 CM_CHK_CMSTATUS_GOTOFINISH(internalEvent->WaitForTaskFinished());
+                DestroyCompletedGPUCopyBufferUPs();
             }
 
             if(event == CM_NO_EVENT)  //User doesn't need CmEvent for this copy
@@ -1563,26 +1541,20 @@ int32_t CmQueueRT::EnqueueCopyInternal_1Plane(CmSurface2DRT* surface,
                 event = internalEvent;
             }
         }
-
-        CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyTask(gpuCopyTask));
-        CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyThreadSpace(threadSpace));
-        CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyBufferUP(cmbufferUP));
     }
 
 finish:
 
     if(hr != CM_SUCCESS)
     {
-        if(cmbufferUP == nullptr)
+        if(cmbufferUP == nullptr && kernel == nullptr)
         {
             // user need to know whether the failure is caused by out of BufferUP.
             hr = CM_GPUCOPY_OUT_OF_RESOURCE;
         }
 
         if(kernel && gpuCopyKernelParam)        GPUCOPY_KERNEL_UNLOCK(gpuCopyKernelParam);
-        if(threadSpace)                                m_device->DestroyThreadSpace(threadSpace);
-        if(gpuCopyTask)                       m_device->DestroyTask(gpuCopyTask);
-        if(cmbufferUP)                        m_device->DestroyBufferUP(cmbufferUP);
+        if(cmbufferUP)                        ReleaseGPUCopyBufferUP(cmbufferUP, true);
         if(internalEvent)                     DestroyEventFast(internalEvent);
 
         // CM_FAILURE for all the other errors
@@ -1711,9 +1683,9 @@ int32_t CmQueueRT::EnqueueCopyInternal_2Planes(CmSurface2DRT* surface,
     }
 
     kernel = nullptr;
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateBufferUP(bufferUPYSize, (void *)linearAddressAlignedY, cmbufferUPY));
+    CM_CHK_CMSTATUS_GOTOFINISH(AcquireGPUCopyBufferUP(linearAddressAlignedY, bufferUPYSize, cmbufferUPY));
     CM_CHK_NULL_GOTOFINISH_CMERROR(cmbufferUPY);
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateBufferUP(bufferUPUVSize, (void *)linearAddressAlignedUV, cmbufferUPUV));
+    CM_CHK_CMSTATUS_GOTOFINISH(AcquireGPUCopyBufferUP(linearAddressAlignedUV, bufferUPUVSize, cmbufferUPUV));
     CM_CHK_NULL_GOTOFINISH_CMERROR(cmbufferUPUV);
 
     //Configure memory object control for the two BufferUP to solve the same cache-line coherency issue.
@@ -1744,7 +1716,6 @@ int32_t CmQueueRT::EnqueueCopyInternal_2Planes(CmSurface2DRT* surface,
     threadHeight = (uint32_t)ceil((double)copyHeightRow / BLOCK_HEIGHT / INNER_LOOP);
     threadNum = threadWidth * threadHeight;
     CM_CHK_CMSTATUS_GOTOFINISH(kernel->SetThreadCount(threadNum));
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateThreadSpace(threadWidth, threadHeight, threadSpace));
 
     widthDword = (uint32_t)ceil((double)widthByte / 4);
     strideInDwords = (uint32_t)ceil((double)strideInBytes / 4);
@@ -1786,24 +1757,18 @@ int32_t CmQueueRT::EnqueueCopyInternal_2Planes(CmSurface2DRT* surface,
         surface->SetReadSyncFlag(true, this); // GPU -> CPU, set surf2d as read sync flag
     }
 
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateTask(gpuCopyTask));
-    CM_CHK_CMSTATUS_GOTOFINISH(gpuCopyTask->AddKernel(kernel));
-    if (option & CM_FASTCOPY_OPTION_DISABLE_TURBO_BOOST)
-    {
-        // disable turbo
-        CM_TASK_CONFIG taskConfig;
-        CmSafeMemSet(&taskConfig, 0, sizeof(CM_TASK_CONFIG));
-        taskConfig.turboBoostFlag = CM_TURBO_BOOST_DISABLE;
-        gpuCopyTask->SetProperty(taskConfig);
-    }
+    CM_CHK_CMSTATUS_GOTOFINISH(GetGPUCopyTask(gpuCopyKernelParam, threadWidth, threadHeight, option, gpuCopyTask, threadSpace));
     CM_CHK_CMSTATUS_GOTOFINISH(EnqueueFast(gpuCopyTask, internalEvent,
                                        threadSpace));
 
     GPUCOPY_KERNEL_UNLOCK(gpuCopyKernelParam);
+    ReleaseGPUCopyBufferUP(cmbufferUPY, false);
+    ReleaseGPUCopyBufferUP(cmbufferUPUV, false);
 
     if ((option & CM_FASTCOPY_OPTION_BLOCKING) && (internalEvent))
     {
         CM_CHK_CMSTATUS_GOTOFINISH(internalEvent->WaitForTaskFinished());
+        DestroyCompletedGPUCopyBufferUPs();
     }
 
     if (event == CM_NO_EVENT)  //User doesn't need CmEvent for this copy
@@ -1816,26 +1781,19 @@ int32_t CmQueueRT::EnqueueCopyInternal_2Planes(CmSurface2DRT* surface,
         event = internalEvent;
     }
 
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyTask(gpuCopyTask));
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyThreadSpace(threadSpace));
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyBufferUP(cmbufferUPY));
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyBufferUP(cmbufferUPUV));
-
 finish:
 
     if (hr != CM_SUCCESS)
     {
-        if ((cmbufferUPY == nullptr) || (cmbufferUPUV == nullptr))
+        if (((cmbufferUPY == nullptr) || (cmbufferUPUV == nullptr)) && (kernel == nullptr))
         {
             // user need to know whether the failure is caused by out of BufferUP.
             hr = CM_GPUCOPY_OUT_OF_RESOURCE;
         }
 
         if (kernel && gpuCopyKernelParam)        GPUCOPY_KERNEL_UNLOCK(gpuCopyKernelParam);
-        if (threadSpace)                                m_device->DestroyThreadSpace(threadSpace);
-        if (gpuCopyTask)                       m_device->DestroyTask(gpuCopyTask);
-        if (cmbufferUPY)                      m_device->DestroyBufferUP(cmbufferUPY);
-        if (cmbufferUPUV)                     m_device->DestroyBufferUP(cmbufferUPUV);
+        if (cmbufferUPY)                      ReleaseGPUCopyBufferUP(cmbufferUPY, true);
+        if (cmbufferUPUV)                     ReleaseGPUCopyBufferUP(cmbufferUPUV, true);
         if (internalEvent)                     DestroyEventFast(internalEvent);
 
         // CM_FAILURE for all the other errors
@@ -2114,9 +2072,9 @@ CM_RT_API int32_t CmQueueRT::EnqueueCopyCPUToCPU( unsigned char* dstSysMem, unsi
         }
     }
 
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateBufferUP(size + srcLeftShiftOffset, (void *)inputLinearAddressAligned,surfaceInput));
+    CM_CHK_CMSTATUS_GOTOFINISH(AcquireGPUCopyBufferUP(inputLinearAddressAligned, size + srcLeftShiftOffset, surfaceInput));
 
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateBufferUP(size + dstLeftShiftOffset, (void *)outputLinearAddressAligned,surfaceOutput));
+    CM_CHK_CMSTATUS_GOTOFINISH(AcquireGPUCopyBufferUP(outputLinearAddressAligned, size + dstLeftShiftOffset, surfaceOutput));
 
     CM_CHK_CMSTATUS_GOTOFINISH(CreateGPUCopyKernel(size, 0, CM_SURFACE_FORMAT_INVALID, CM_FASTCOPY_CPU2CPU, gpuCopyKernelParam));
     CM_CHK_NULL_GOTOFINISH_CMERROR(gpuCopyKernelParam);
@@ -2137,26 +2095,20 @@ CM_RT_API int32_t CmQueueRT::EnqueueCopyCPUToCPU( unsigned char* dstSysMem, unsi
     CM_CHK_CMSTATUS_GOTOFINISH(kernel->SetKernelArg( 5, sizeof( int ), &dstLeftShiftOffset ));
     CM_CHK_CMSTATUS_GOTOFINISH(kernel->SetKernelArg( 6, sizeof( int ), &size ));
 
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateThreadSpace(threadWidth, threadHeight, threadSpace));
-
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateTask(task));
-    CM_CHK_NULL_GOTOFINISH_CMERROR(task);
-    CM_CHK_CMSTATUS_GOTOFINISH(task->AddKernel (kernel));
-
-    if (option & CM_FASTCOPY_OPTION_DISABLE_TURBO_BOOST)
-    {
-        // disable turbo
-        CM_TASK_CONFIG taskConfig;
-        CmSafeMemSet(&taskConfig, 0, sizeof(CM_TASK_CONFIG));
-        taskConfig.turboBoostFlag = CM_TURBO_BOOST_DISABLE;
-        task->SetProperty(taskConfig);
-    }
+    CM_CHK_CMSTATUS_GOTOFINISH(GetGPUCopyTask(gpuCopyKernelParam, threadWidth, threadHeight, option, task, threadSpace));
 
     CM_CHK_CMSTATUS_GOTOFINISH(EnqueueFast(task, event, threadSpace));
 
+    // The BufferUPs stay alive in the pool until the task completes
+    GPUCOPY_KERNEL_UNLOCK(gpuCopyKernelParam);
+    ReleaseGPUCopyBufferUP(surfaceOutput, false);
+    ReleaseGPUCopyBufferUP(surfaceInput, false);
+    kernel = nullptr;
+
     if ((option & CM_FASTCOPY_OPTION_BLOCKING) && (event))
     {
         CM_CHK_CMSTATUS_GOTOFINISH(event->WaitForTaskFinished());
+        DestroyCompletedGPUCopyBufferUPs();
     }
 
     //Copy the unaligned part by using CPU
@@ -2167,17 +2119,10 @@ CM_RT_API int32_t CmQueueRT::EnqueueCopyCPUToCPU( unsigned char* dstSysMem, unsi
                   (void *)(inputLinearAddress+gpuMemcopySize),
                           cpuMemcopySize); //SSE copy used in CMRT.
 
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyThreadSpace(threadSpace));
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyTask(task));
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyBufferUP(surfaceOutput));   // ref_cnf to guarantee task finish before BufferUP being really destroy.
-    CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyBufferUP(surfaceInput));
-
-    GPUCOPY_KERNEL_UNLOCK(gpuCopyKernelParam);
-
 finish:
     if(hr != CM_SUCCESS)
     {   //Failed
-        if( surfaceInput == nullptr || surfaceOutput == nullptr)
+        if( (surfaceInput == nullptr || surfaceOutput == nullptr) && gpuCopyKernelParam == nullptr)
         {
             hr = CM_GPUCOPY_OUT_OF_RESOURCE; // user need to know whether the failure is caused by out of BufferUP.
         }
@@ -2185,11 +2130,9 @@ finish:
         {
             hr = CM_FAILURE;
         }
-        if(surfaceInput)                      m_device->DestroyBufferUP(surfaceInput);
-        if(surfaceOutput)                     m_device->DestroyBufferUP(surfaceOutput);
+        if(surfaceInput)                      ReleaseGPUCopyBufferUP(surfaceInput, true);
+        if(surfaceOutput)                     ReleaseGPUCopyBufferUP(surfaceOutput, true);
         if(kernel && gpuCopyKernelParam)        GPUCOPY_KERNEL_UNLOCK(gpuCopyKernelParam);
-        if(threadSpace)                                m_device->DestroyThreadSpace(threadSpace);
-        if(task)                              m_device->DestroyTask(task);
     }
 
     return hr;
@@ -2220,6 +2163,9 @@ void CmQueueRT::PopTaskFromFlushedQueue()
             }
         }
 
+        // Drain the kernel print output of the completed task
+        topTask->ReleasePrintBuffer();
+
         CmTaskInternal::Destroy( topTask );
     }
     return;
@@ -3429,6 +3375,201 @@ finish:
     return hr;
 }
 
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       GetGPUCopyTask()
+//| Purpose:    Get the task and thread space of a GPU copy running the given kernel.
+//|             They are kept with the kernel and only created again when the thread space changes.
+//|             The kernel must be locked by the caller.
+//| Arguments:
+//|             gpuCopyKernelParam [in]  kernel param
+//|             threadWidth      [in]  thread space's width
+//|             threadHeight     [in]  thread space's height
+//|             option           [in]  copy option, blocking copy, non-blocking copy or disable turbo boost
+//|             task             [out] task holding the kernel
+//|             threadSpace      [out] thread space of the copy
+//|
+//| Returns:    Result of the operation.
+//|
+//*---------------------------------------------------------------------------------------------------------
+int32_t CmQueueRT::GetGPUCopyTask(CM_GPUCOPY_KERNEL *gpuCopyKernelParam,
+                                  uint32_t threadWidth,
+                                  uint32_t threadHeight,
+                                  uint32_t option,
+                                  CmTask* &task,
+                                  CmThreadSpace* &threadSpace)
+{
+    int32_t         hr = CM_SUCCESS;
+    CM_TASK_CONFIG  taskConfig;
+
+    task        = nullptr;
+    threadSpace = nullptr;
+    CM_CHK_NULL_GOTOFINISH_CMERROR(gpuCopyKernelParam);
+
+    if (gpuCopyKernelParam->threadSpace &&
+        (gpuCopyKernelParam->threadSpaceWidth != threadWidth ||
+         gpuCopyKernelParam->threadSpaceHeight != threadHeight))
+    {
+        CM_CHK_CMSTATUS_GOTOFINISH(m_device->DestroyThreadSpace(gpuCopyKernelParam->threadSpace));
+        gpuCopyKernelParam->threadSpace = nullptr;
+    }
+
+    if (gpuCopyKernelParam->threadSpace == nullptr)
+    {
+        CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateThreadSpace(threadWidth, threadHeight, gpuCopyKernelParam->threadSpace));
+        gpuCopyKernelParam->threadSpaceWidth  = threadWidth;
+        gpuCopyKernelParam->threadSpaceHeight = threadHeight;
+        MOS_IncrementUltCounter(MOS_ULT_COUNTER_CM_GPU_COPY_TASK_CREATES);
+    }
+
+    if (gpuCopyKernelParam->task == nullptr)
+    {
+        CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateTask(gpuCopyKernelParam->task));
+        CM_CHK_NULL_GOTOFINISH_CMERROR(gpuCopyKernelParam->task);
+        MOS_IncrementUltCounter(MOS_ULT_COUNTER_CM_GPU_COPY_TASK_CREATES);
+    }
+
+    // Reset also restores the default task config
+    CM_CHK_CMSTATUS_GOTOFINISH(gpuCopyKernelParam->task->Reset());
+    CM_CHK_CMSTATUS_GOTOFINISH(gpuCopyKernelParam->task->AddKernel(gpuCopyKernelParam->kernel));
+    if (option & CM_FASTCOPY_OPTION_DISABLE_TURBO_BOOST)
+    {
+        // disable turbo
+        CmSafeMemSet(&taskConfig, 0, sizeof(CM_TASK_CONFIG));
+        taskConfig.turboBoostFlag = CM_TURBO_BOOST_DISABLE;
+        gpuCopyKernelParam->task->SetProperty(taskConfig);
+    }
+
+    task        = gpuCopyKernelParam->task;
+    threadSpace = gpuCopyKernelParam->threadSpace;
+
+finish:
+    return hr;
+}
+
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       AcquireGPUCopyBufferUP()
+//| Purpose:    Get a BufferUP wrapping the system memory of a GPU copy.
+//|             A BufferUP of the pool with the same address and size is reused while a copy using it
+//|             has not completed, the application keeps the memory until then. Otherwise a new one
+//|             is created and added to the pool.
+//| Arguments:
+//|             linearAddressAligned [in]  page aligned start address of the system memory
+//|             size             [in]  size of the BufferUP
+//|             bufferUP         [out] BufferUP, locked until ReleaseGPUCopyBufferUP() is called
+//|
+//| Returns:    Result of the operation.
+//|
+//*---------------------------------------------------------------------------------------------------------
+int32_t CmQueueRT::AcquireGPUCopyBufferUP(size_t linearAddressAligned,
+                                          uint32_t size,
+                                          CmBufferUP* &bufferUP)
+{
+    int32_t             hr = CM_SUCCESS;
+    CM_GPUCOPY_BUFFERUP entry;
+
+    // Once its copies completed, the memory of a BufferUP may have been freed
+    // and its address given to another allocation, so it is not reused.
+    DestroyCompletedGPUCopyBufferUPs();
+
+    CLock               locker(m_criticalSectionGPUCopyBufferUP);
+
+    bufferUP = nullptr;
+    CmSafeMemSet(&entry, 0, sizeof(CM_GPUCOPY_BUFFERUP));
+
+    for (auto iter = m_copyBufferUPPool.begin(); iter != m_copyBufferUPPool.end(); iter++)
+    {
+        if (!iter->locked &&
+            iter->linearAddressAligned == linearAddressAligned &&
+            iter->size == size)
+        {
+            entry = *iter;
+            m_copyBufferUPPool.erase(iter);
+            break;
+        }
+    }
+
+    if (entry.bufferUP == nullptr)
+    {
+        CM_CHK_CMSTATUS_GOTOFINISH(m_device->CreateBufferUP(size, (void *)linearAddressAligned, entry.bufferUP));
+        CM_CHK_NULL_GOTOFINISH_CMERROR(entry.bufferUP);
+        entry.linearAddressAligned = linearAddressAligned;
+        entry.size                 = size;
+        MOS_IncrementUltCounter(MOS_ULT_COUNTER_CM_GPU_COPY_BUFFERUP_CREATES);
+    }
+
+    entry.locked = true;
+    m_copyBufferUPPool.push_back(entry);
+    bufferUP = entry.bufferUP;
+
+finish:
+    return hr;
+}
+
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       ReleaseGPUCopyBufferUP()
+//| Purpose:    Give back a BufferUP got from AcquireGPUCopyBufferUP().
+//|             The BufferUP stays in the pool unless destroy is set, the references of the
+//|             enqueued copies keep it alive until they complete.
+//| Arguments:
+//|             bufferUP         [in/out] BufferUP, set to nullptr
+//|             destroy          [in]  remove the BufferUP from the pool and destroy it
+//|
+//| Returns:    None.
+//|
+//*---------------------------------------------------------------------------------------------------------
+void CmQueueRT::ReleaseGPUCopyBufferUP(CmBufferUP* &bufferUP, bool destroy)
+{
+    CLock locker(m_criticalSectionGPUCopyBufferUP);
+
+    for (auto iter = m_copyBufferUPPool.begin(); iter != m_copyBufferUPPool.end(); iter++)
+    {
+        if (iter->bufferUP == bufferUP)
+        {
+            if (destroy)
+            {
+                m_device->DestroyBufferUP(iter->bufferUP);
+                m_copyBufferUPPool.erase(iter);
+            }
+            else
+            {
+                iter->locked = false;
+            }
+            break;
+        }
+    }
+
+    bufferUP = nullptr;
+}
+
+//*---------------------------------------------------------------------------------------------------------
+//| Name:       DestroyCompletedGPUCopyBufferUPs()
+//| Purpose:    Destroy the BufferUPs of the pool whose copies have all completed.
+//|             The BufferUPs locked or referenced by a running task are kept.
+//| Arguments:  None.
+//|
+//| Returns:    None.
+//|
+//*---------------------------------------------------------------------------------------------------------
+void CmQueueRT::DestroyCompletedGPUCopyBufferUPs()
+{
+    CLock locker(m_criticalSectionGPUCopyBufferUP);
+
+    auto iter = m_copyBufferUPPool.begin();
+    while (iter != m_copyBufferUPPool.end())
+    {
+        CmBuffer_RT *buffer = static_cast<CmBuffer_RT *>(iter->bufferUP);
+        if (!iter->locked && buffer->AllReferenceCompleted())
+        {
+            m_device->DestroyBufferUP(iter->bufferUP);
+            iter = m_copyBufferUPPool.erase(iter);
+        }
+        else
+        {
+            iter++;
+        }
+    }
+}
+
 //*---------------------------------------------------------------------------------------------------------
 //| Name:       GetGPUCopyKrnID()
 //| Purpose:    Calculate the kernel ID accroding surface's width, height and copy direction
@@ -30,6 +30,7 @@
 #include "cm_queue.h"
 
 #include <queue>
+#include <vector>
 
 #include "cm_array.h"
 #include "cm_csync.h"
@@ -55,12 +56,26 @@ class CmThreadGroupSpace;
 class CmVebox;
 class CmSurface2D;
 class CmSurface2DRT;
+class CmBufferUP;
 
 struct CM_GPUCOPY_KERNEL
 {
     CmKernel *kernel;
     CM_GPUCOPY_KERNEL_ID kernelID;
     bool locked;
+    CmTask *task;                   // Task reused by the copies running this kernel
+    CmThreadSpace *threadSpace;     // Thread space of the last copy running this kernel
+    uint32_t threadSpaceWidth;
+    uint32_t threadSpaceHeight;
+};
+
+// BufferUP wrapping the system memory of GPU copies, reused until the copies using it complete
+struct CM_GPUCOPY_BUFFERUP
+{
+    size_t linearAddressAligned;    // Page aligned start address of the system memory
+    uint32_t size;
+    CmBufferUP *bufferUP;
+    bool locked;                    // Used by a copy being enqueued
 };
 
 class ThreadSafeQueue
@@ -329,6 +344,21 @@ protected:
                                 CM_GPUCOPY_DIRECTION copyDirection,
                                 CM_GPUCOPY_KERNEL* &kernelParam);
 
+    int32_t GetGPUCopyTask(CM_GPUCOPY_KERNEL *gpuCopyKernelParam,
+                           uint32_t threadWidth,
+                           uint32_t threadHeight,
+                           uint32_t option,
+                           CmTask* &task,
+                           CmThreadSpace* &threadSpace);
+
+    int32_t AcquireGPUCopyBufferUP(size_t linearAddressAligned,
+                                   uint32_t size,
+                                   CmBufferUP* &bufferUP);
+
+    void ReleaseGPUCopyBufferUP(CmBufferUP* &bufferUP, bool destroy);
+
+    void DestroyCompletedGPUCopyBufferUPs();
+
     int32_t RegisterSyncEvent();
 
 
@@ -349,6 +379,9 @@ protected:
 
     CSync m_criticalSectionGPUCopyKrn;
 
+    std::vector<CM_GPUCOPY_BUFFERUP> m_copyBufferUPPool;  // BufferUPs of the copies not completed yet
+    CSync m_criticalSectionGPUCopyBufferUP;               // Protect m_copyBufferUPPool
+
     CM_HAL_MAX_VALUES *m_halMaxValues;
     CM_QUEUE_CREATE_OPTION m_queueOption;
 
@@ -158,6 +158,20 @@ int32_t CmTaskInternal::Create(const uint32_t kernelCount, const uint32_t totalT
     return result;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Release the print buffer slot of the task once it completed,
+//|             the kernel print output is drained into the selected stream
+//| Returns:    None.
+//*-----------------------------------------------------------------------------
+void CmTaskInternal::ReleasePrintBuffer()
+{
+    if (m_printBufferSlot != CM_INVALID_INDEX)
+    {
+        m_cmDevice->ReleasePrintBufferSlot(m_printBufferSlot);
+        m_printBufferSlot = CM_INVALID_INDEX;
+    }
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:    Destroy Task internal
 //| Returns:    None.
@@ -210,7 +224,8 @@ CmTaskInternal::CmTaskInternal(const uint32_t kernelCount, const uint32_t totalT
     m_surfaceArray (nullptr),
     m_isSurfaceUpdateDone(false),
     m_taskType(CM_TASK_TYPE_DEFAULT),
-    m_mediaStatePtr( nullptr )
+    m_mediaStatePtr( nullptr ),
+    m_printBufferSlot( CM_INVALID_INDEX )
 {
     m_kernelSurfInfo.kernelNum = 0;
     m_kernelSurfInfo.surfEntryInfosArray = nullptr;
@@ -266,6 +281,8 @@ CmTaskInternal::~CmTaskInternal( void )
     //Release Profiling Info
     VtuneReleaseProfilingInfo();
 
+    ReleasePrintBuffer();
+
     for( uint32_t i = 0; i < m_kernelCount; i ++ )
     {
         CmKernelRT *kernel = (CmKernelRT*)m_kernels.GetElement(i);
@@ -339,7 +356,7 @@ int32_t CmTaskInternal::Initialize(const CmThreadSpaceRT* threadSpace, bool isWi
     if (m_cmDevice->IsPrintEnable())
     {
         SurfaceIndex *printBufferIndex = nullptr;
-        m_cmDevice->GetPrintBufferIndex(printBufferIndex);
+        m_cmDevice->AcquirePrintBufferSlot(m_printBufferSlot, printBufferIndex);
         CM_ASSERT(printBufferIndex);
         for (uint32_t i = 0; i < m_kernelCount; i++)
         {
@@ -533,7 +550,7 @@ int32_t CmTaskInternal::Initialize(const CmThreadGroupSpace* threadGroupSpace)
     if (m_cmDevice->IsPrintEnable())
     {
         SurfaceIndex *printBufferIndex = nullptr;
-        m_cmDevice->GetPrintBufferIndex(printBufferIndex);
+        m_cmDevice->AcquirePrintBufferSlot(m_printBufferSlot, printBufferIndex);
         CM_ASSERT(printBufferIndex);
         for (uint32_t i = 0; i < m_kernelCount; i++)
         {
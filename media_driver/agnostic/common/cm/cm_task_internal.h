@@ -162,6 +162,7 @@ public:
     int32_t GetProperty(CM_TASK_CONFIG &taskConfig);
     const CM_EXECUTION_CONFIG* GetKernelExecuteConfig() { return m_krnExecCfg; };
     void  *GetMediaStatePtr();
+    void ReleasePrintBuffer();
 #if CM_LOG_ON
     std::string Log();
 #endif
@@ -250,6 +251,7 @@ protected:
     CM_TASK_CONFIG  m_taskConfig;
     CM_EXECUTION_CONFIG m_krnExecCfg[CM_MAX_KERNELS_PER_TASK];
     void            *m_mediaStatePtr;
+    int32_t         m_printBufferSlot;  // Slot of the print buffer ring bound to the task
 private:
     CmTaskInternal (const CmTaskInternal& other);
     CmTaskInternal& operator= (const CmTaskInternal& other);
@@ -31,6 +31,7 @@
 #include "codechal_mmc_decode_hevc.h"
 #include "codechal_decode_nv12top010.h"
 #include "media_interfaces_nv12top010.h"
+#include "mhw_cmd_template.h"
 
 #if USE_CODECHAL_DEBUG_TOOL
 #include "codechal_debug.h"
@@ -702,6 +703,11 @@ CodechalDecodeHevc::~CodechalDecodeHevc ()
         MOS_Delete(m_picMhwParams.HevcTileState);
         m_picMhwParams.HevcTileState = nullptr;
     }
+    if (m_picTemplate)
+    {
+        MOS_Delete(m_picTemplate);
+        m_picTemplate = nullptr;
+    }
 
     return;
 }
@@ -1790,7 +1796,137 @@ MOS_STATUS CodechalDecodeHevc::InitPicLongFormatMhwParams()
     return eStatus;
 }
 
-MOS_STATUS CodechalDecodeHevc::AddPictureLongFormatCmds(
+//!
+//! \brief    Surface layout programmed by the template commands
+//!
+typedef struct _CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE
+{
+    MOS_FORMAT              Format;
+    MOS_TILE_TYPE           TileType;
+    uint32_t                dwPitch;
+    uint32_t                dwWidth;
+    uint32_t                dwHeight;
+    uint32_t                dwOffset;
+    MOS_PLANE_OFFSET        UPlaneOffset;
+    MOS_PLANE_OFFSET        VPlaneOffset;
+    int32_t                 bIsCompressed;
+    MOS_RESOURCE_MMC_MODE   CompressionMode;
+    MOS_MEMCOMP_STATE       MmcMode;
+} CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE;
+
+//!
+//! \brief    HCP_PIPE_MODE_SELECT parameters programmed by the template commands
+//! \details  The gen11 pipe work and multi engine modes are only set in
+//!           scalable mode, where the template is not used.
+//!
+typedef struct _CODECHAL_DECODE_HEVC_PIC_TEMPLATE_PIPE_MODE
+{
+    uint32_t                Mode;
+    uint32_t                ChromaType;
+    MOS_FORMAT              Format;
+    uint32_t                dwMediaSoftResetCounterValue;
+    uint8_t                 ucVdencBitDepthMinus8;
+    uint8_t                 bStreamOutEnabled;
+    uint8_t                 bShortFormatInUse;
+    uint8_t                 bVC1OddFrameHeight;
+    uint8_t                 pakFrmLvlStrmoutEnable;
+    uint8_t                 pakPiplnStrmoutEnabled;
+    uint8_t                 bDeblockerStreamOutEnable;
+    uint8_t                 bPostDeblockOutEnable;
+    uint8_t                 bPreDeblockOutEnable;
+    uint8_t                 bDynamicSliceEnable;
+    uint8_t                 bSaoFirstPass;
+    uint8_t                 bRdoqEnable;
+    uint8_t                 bDynamicScalingEnabled;
+    uint8_t                 bVdencEnabled;
+    uint8_t                 bVdencStreamInEnable;
+    uint8_t                 bPakThresholdCheckEnable;
+    uint8_t                 bVdencPakObjCmdStreamOutEnable;
+    uint8_t                 bBatchBufferInUse;
+    uint8_t                 bTlbPrefetchEnable;
+    uint8_t                 bAdvancedRateControlEnable;
+    uint8_t                 bStreamObjectUsed;
+    uint8_t                 disableProtectionSetting;
+} CODECHAL_DECODE_HEVC_PIC_TEMPLATE_PIPE_MODE;
+
+//!
+//! \brief    HCP_SURFACE_STATE parameters programmed by the template commands
+//! \details  The layout of psSurface is keyed apart, as a surface layout
+//!
+typedef struct _CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE_PARAMS
+{
+    uint32_t                Mode;
+    uint32_t                dwUVPlaneAlignment;
+    uint32_t                dwActualWidth;
+    uint32_t                dwActualHeight;
+    uint32_t                dwReconSurfHeight;
+    uint32_t                dwCompressionFormat;
+    MOS_MEMCOMP_STATE       mmcState;
+    uint8_t                 ucVDirection;
+    uint8_t                 ChromaType;
+    uint8_t                 ucSurfaceStateId;
+    uint8_t                 ucBitDepthLumaMinus8;
+    uint8_t                 ucBitDepthChromaMinus8;
+    uint8_t                 mmcSkipMask;
+    uint8_t                 bDisplayFormatSwizzle;
+    uint8_t                 bSrc8Pak10Mode;
+    uint8_t                 bColorSpaceSelection;
+    uint8_t                 bVdencDynamicScaling;
+} CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE_PARAMS;
+
+//!
+//! \brief    Inputs of the template commands besides their resources
+//! \details  Zeroed before it is filled, so it can be compared with memcmp.
+//!           Every field is set explicitly, no pointer or padding of the MHW
+//!           parameters is part of the key.
+//!
+typedef struct _CODECHAL_DECODE_HEVC_PIC_TEMPLATE_KEY
+{
+    CODECHAL_DECODE_HEVC_PIC_TEMPLATE_PIPE_MODE         PipeModeSelect;
+    uint32_t                                            dwWidth;                // Row store caching
+    uint32_t                                            dwHeight;
+    uint32_t                                            ucLCUSize;
+    CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE_PARAMS    SurfaceParams;
+    CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE           Surface;
+    MOS_MEMCOMP_STATE                                   PreDeblockSurfMmcState;
+    MOS_MEMCOMP_STATE                                   PostDeblockSurfMmcState;
+    MOS_MEMCOMP_STATE                                   StreamOutBufMmcState;
+    CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE           DestSurface;
+    CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE           References[CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC];
+} CODECHAL_DECODE_HEVC_PIC_TEMPLATE_KEY;
+
+//!
+//! \brief    Fill the template key of a surface layout
+//!
+static void CodecHalDecodeHevc_GetTemplateSurface(
+    PMOS_SURFACE                                surface,
+    CODECHAL_DECODE_HEVC_PIC_TEMPLATE_SURFACE   *templateSurface)
+{
+    templateSurface->Format          = surface->Format;
+    templateSurface->TileType        = surface->TileType;
+    templateSurface->dwPitch         = surface->dwPitch;
+    templateSurface->dwWidth         = surface->dwWidth;
+    templateSurface->dwHeight        = surface->dwHeight;
+    templateSurface->dwOffset        = surface->dwOffset;
+    templateSurface->UPlaneOffset    = surface->UPlaneOffset;
+    templateSurface->VPlaneOffset    = surface->VPlaneOffset;
+    templateSurface->bIsCompressed   = surface->bIsCompressed;
+    templateSurface->CompressionMode = surface->CompressionMode;
+}
+
+#define CODECHAL_DECODE_HEVC_PIC_TEMPLATE_BUFFERS       12
+#define CODECHAL_DECODE_HEVC_PIC_TEMPLATE_RESOURCES     (2 + CODECHAL_DECODE_HEVC_PIC_TEMPLATE_BUFFERS + 2 * CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC)
+
+bool CodechalDecodeHevc::IsPicTemplateAllowed()
+{
+    // The P010 render target is registered without a relocation
+    return m_picTemplateEnabled &&
+        !m_is8BitFrameIn10BitHevc &&
+        m_secureDecoder == nullptr &&
+        !m_osInterface->osCpInterface->IsCpEnabled();
+}
+
+MOS_STATUS CodechalDecodeHevc::AddPictureTemplateCmds(
     PMOS_COMMAND_BUFFER             cmdBufferInUse,
     PIC_LONG_FORMAT_MHW_PARAMS      *picMhwParams)
 {
@@ -1801,17 +1937,203 @@ MOS_STATUS CodechalDecodeHevc::AddPictureLongFormatCmds(
     CODECHAL_DECODE_CHK_NULL_RETURN(cmdBufferInUse);
     CODECHAL_DECODE_CHK_NULL_RETURN(picMhwParams);
 
-    CODECHAL_DECODE_CHK_STATUS_RETURN(m_hcpInterface->AddHcpPipeModeSelectCmd(
-        cmdBufferInUse,
-        picMhwParams->PipeModeSelectParams));
+    PMHW_VDBOX_SURFACE_PARAMS       surfaceParams     = picMhwParams->SurfaceParams;
+    PMHW_VDBOX_PIPE_BUF_ADDR_PARAMS pipeBufAddrParams = picMhwParams->PipeBufAddrParams;
+    bool                            record            = false;
+
+    PMOS_RESOURCE                           resources[CODECHAL_DECODE_HEVC_PIC_TEMPLATE_RESOURCES];
+    CODECHAL_DECODE_HEVC_PIC_TEMPLATE_KEY   key;
+
+    if (m_picTemplate != nullptr && m_picTemplate->IsEnabled() && IsPicTemplateAllowed())
+    {
+        CODECHAL_DECODE_CHK_NULL_RETURN(picMhwParams->PipeModeSelectParams);
+        CODECHAL_DECODE_CHK_NULL_RETURN(surfaceParams->psSurface);
+        CODECHAL_DECODE_CHK_NULL_RETURN(pipeBufAddrParams->psPreDeblockSurface);
+
+        uint32_t numResources = 0;
+        resources[numResources++] = &surfaceParams->psSurface->OsResource;
+        resources[numResources++] = &pipeBufAddrParams->psPreDeblockSurface->OsResource;
+        resources[numResources++] = pipeBufAddrParams->presMfdDeblockingFilterRowStoreScratchBuffer;
+        resources[numResources++] = pipeBufAddrParams->presDeblockingFilterTileRowStoreScratchBuffer;
+        resources[numResources++] = pipeBufAddrParams->presDeblockingFilterColumnRowStoreScratchBuffer;
+        resources[numResources++] = pipeBufAddrParams->presMetadataLineBuffer;
+        resources[numResources++] = pipeBufAddrParams->presMetadataTileLineBuffer;
+        resources[numResources++] = pipeBufAddrParams->presMetadataTileColumnBuffer;
+        resources[numResources++] = pipeBufAddrParams->presSaoLineBuffer;
+        resources[numResources++] = pipeBufAddrParams->presSaoTileLineBuffer;
+        resources[numResources++] = pipeBufAddrParams->presSaoTileColumnBuffer;
+        resources[numResources++] = pipeBufAddrParams->presCurMvTempBuffer;
+        resources[numResources++] = pipeBufAddrParams->presStreamOutBuffer;
+        resources[numResources++] = pipeBufAddrParams->presDataBuffer;
+        for (uint32_t i = 0; i < CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC; i++)
+        {
+            resources[numResources++] = pipeBufAddrParams->presReferences[i];
+        }
+        for (uint32_t i = 0; i < CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC; i++)
+        {
+            resources[numResources++] = pipeBufAddrParams->presColMvTempBuffer[i];
+        }
+        CODECHAL_DECODE_ASSERT(numResources == CODECHAL_DECODE_HEVC_PIC_TEMPLATE_RESOURCES);
+
+        MOS_ZeroMemory(&key, sizeof(key));
+        PMHW_VDBOX_PIPE_MODE_SELECT_PARAMS pipeModeSelectParams = picMhwParams->PipeModeSelectParams;
+        key.PipeModeSelect.Mode                             = pipeModeSelectParams->Mode;
+        key.PipeModeSelect.ChromaType                       = pipeModeSelectParams->ChromaType;
+        key.PipeModeSelect.Format                           = pipeModeSelectParams->Format;
+        key.PipeModeSelect.dwMediaSoftResetCounterValue     = pipeModeSelectParams->dwMediaSoftResetCounterValue;
+        key.PipeModeSelect.ucVdencBitDepthMinus8            = pipeModeSelectParams->ucVdencBitDepthMinus8;
+        key.PipeModeSelect.bStreamOutEnabled                = pipeModeSelectParams->bStreamOutEnabled;
+        key.PipeModeSelect.bShortFormatInUse                = pipeModeSelectParams->bShortFormatInUse;
+        key.PipeModeSelect.bVC1OddFrameHeight               = pipeModeSelectParams->bVC1OddFrameHeight;
+        key.PipeModeSelect.pakFrmLvlStrmoutEnable           = pipeModeSelectParams->pakFrmLvlStrmoutEnable;
+        key.PipeModeSelect.pakPiplnStrmoutEnabled           = pipeModeSelectParams->pakPiplnStrmoutEnabled;
+        key.PipeModeSelect.bDeblockerStreamOutEnable        = pipeModeSelectParams->bDeblockerStreamOutEnable;
+        key.PipeModeSelect.bPostDeblockOutEnable            = pipeModeSelectParams->bPostDeblockOutEnable;
+        key.PipeModeSelect.bPreDeblockOutEnable             = pipeModeSelectParams->bPreDeblockOutEnable;
+        key.PipeModeSelect.bDynamicSliceEnable              = pipeModeSelectParams->bDynamicSliceEnable;
+        key.PipeModeSelect.bSaoFirstPass                    = pipeModeSelectParams->bSaoFirstPass;
+        key.PipeModeSelect.bRdoqEnable                      = pipeModeSelectParams->bRdoqEnable;
+        key.PipeModeSelect.bDynamicScalingEnabled           = pipeModeSelectParams->bDynamicScalingEnabled;
+        key.PipeModeSelect.bVdencEnabled                    = pipeModeSelectParams->bVdencEnabled;
+        key.PipeModeSelect.bVdencStreamInEnable             = pipeModeSelectParams->bVdencStreamInEnable;
+        key.PipeModeSelect.bPakThresholdCheckEnable         = pipeModeSelectParams->bPakThresholdCheckEnable;
+        key.PipeModeSelect.bVdencPakObjCmdStreamOutEnable   = pipeModeSelectParams->bVdencPakObjCmdStreamOutEnable;
+        key.PipeModeSelect.bBatchBufferInUse                = pipeModeSelectParams->bBatchBufferInUse;
+        key.PipeModeSelect.bTlbPrefetchEnable               = pipeModeSelectParams->bTlbPrefetchEnable;
+        key.PipeModeSelect.bAdvancedRateControlEnable       = pipeModeSelectParams->bAdvancedRateControlEnable;
+        key.PipeModeSelect.bStreamObjectUsed                = pipeModeSelectParams->bStreamObjectUsed;
+        key.PipeModeSelect.disableProtectionSetting         = pipeModeSelectParams->disableProtectionSetting;
+
+        key.dwWidth                 = m_width;
+        key.dwHeight                = m_height;
+        key.ucLCUSize               = 1 << (m_hevcPicParams->log2_min_luma_coding_block_size_minus3 + 3 +
+                                            m_hevcPicParams->log2_diff_max_min_luma_coding_block_size);
+        key.PreDeblockSurfMmcState  = pipeBufAddrParams->PreDeblockSurfMmcState;
+        key.PostDeblockSurfMmcState = pipeBufAddrParams->PostDeblockSurfMmcState;
+        key.StreamOutBufMmcState    = pipeBufAddrParams->StreamOutBufMmcState;
+
+        key.SurfaceParams.Mode                   = surfaceParams->Mode;
+        key.SurfaceParams.dwUVPlaneAlignment     = surfaceParams->dwUVPlaneAlignment;
+        key.SurfaceParams.dwActualWidth          = surfaceParams->dwActualWidth;
+        key.SurfaceParams.dwActualHeight         = surfaceParams->dwActualHeight;
+        key.SurfaceParams.dwReconSurfHeight      = surfaceParams->dwReconSurfHeight;
+        key.SurfaceParams.dwCompressionFormat    = surfaceParams->dwCompressionFormat;
+        key.SurfaceParams.mmcState               = surfaceParams->mmcState;
+        key.SurfaceParams.ucVDirection           = surfaceParams->ucVDirection;
+        key.SurfaceParams.ChromaType             = surfaceParams->ChromaType;
+        key.SurfaceParams.ucSurfaceStateId       = surfaceParams->ucSurfaceStateId;
+        key.SurfaceParams.ucBitDepthLumaMinus8   = surfaceParams->ucBitDepthLumaMinus8;
+        key.SurfaceParams.ucBitDepthChromaMinus8 = surfaceParams->ucBitDepthChromaMinus8;
+        key.SurfaceParams.mmcSkipMask            = surfaceParams->mmcSkipMask;
+        key.SurfaceParams.bDisplayFormatSwizzle  = surfaceParams->bDisplayFormatSwizzle;
+        key.SurfaceParams.bSrc8Pak10Mode         = surfaceParams->bSrc8Pak10Mode;
+        key.SurfaceParams.bColorSpaceSelection   = surfaceParams->bColorSpaceSelection;
+        key.SurfaceParams.bVdencDynamicScaling   = surfaceParams->bVdencDynamicScaling;
+        CodecHalDecodeHevc_GetTemplateSurface(surfaceParams->psSurface, &key.Surface);
+        CODECHAL_DECODE_CHK_STATUS_RETURN(m_osInterface->pfnGetMemoryCompressionMode(
+            m_osInterface,
+            &surfaceParams->psSurface->OsResource,
+            &key.Surface.MmcMode));
+
+        PMOS_SURFACE destSurface = pipeBufAddrParams->psPreDeblockSurface;
+        CodecHalDecodeHevc_GetTemplateSurface(destSurface, &key.DestSurface);
+        CODECHAL_DECODE_CHK_STATUS_RETURN(m_osInterface->pfnGetMemoryCompressionMode(
+            m_osInterface,
+            &destSurface->OsResource,
+            &key.DestSurface.MmcMode));
+
+        // Layouts of the references are programmed with their addresses
+        for (uint32_t i = 0; i < CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC; i++)
+        {
+            PMOS_RESOURCE reference = pipeBufAddrParams->presReferences[i];
+            if (reference == nullptr)
+            {
+                continue;
+            }
+
+            MOS_SURFACE details;
+            MOS_ZeroMemory(&details, sizeof(details));
+            details.Format = Format_Invalid;
+            CODECHAL_DECODE_CHK_STATUS_RETURN(m_osInterface->pfnGetResourceInfo(m_osInterface, reference, &details));
+
+            key.References[i].Format   = details.Format;
+            key.References[i].TileType = details.TileType;
+            key.References[i].dwPitch  = details.dwPitch;
+            key.References[i].dwHeight = details.dwHeight;
+            key.References[i].dwOffset = details.RenderOffset.YUV.Y.BaseOffset;
+            CODECHAL_DECODE_CHK_STATUS_RETURN(m_osInterface->pfnGetMemoryCompressionMode(
+                m_osInterface,
+                reference,
+                &key.References[i].MmcMode));
+        }
+
+        if (m_picTemplate->Matches(&key, sizeof(key), resources, numResources))
+        {
+            return m_picTemplate->Replay(cmdBufferInUse, resources, numResources);
+        }
 
-    CODECHAL_DECODE_CHK_STATUS_RETURN(m_hcpInterface->AddHcpSurfaceCmd(
+        CODECHAL_DECODE_CHK_STATUS_RETURN(m_picTemplate->BeginRecord(
+            cmdBufferInUse,
+            &key,
+            sizeof(key),
+            resources,
+            numResources));
+        record = true;
+    }
+    else if (m_picTemplate != nullptr)
+    {
+        m_picTemplate->Invalidate();
+    }
+
+    eStatus = m_hcpInterface->AddHcpPipeModeSelectCmd(
         cmdBufferInUse,
-        picMhwParams->SurfaceParams));
+        picMhwParams->PipeModeSelectParams);
+
+    if (eStatus == MOS_STATUS_SUCCESS)
+    {
+        eStatus = m_hcpInterface->AddHcpSurfaceCmd(
+            cmdBufferInUse,
+            surfaceParams);
+    }
+
+    if (eStatus == MOS_STATUS_SUCCESS)
+    {
+        eStatus = m_hcpInterface->AddHcpPipeBufAddrCmd(
+            cmdBufferInUse,
+            pipeBufAddrParams);
+    }
+
+    if (record)
+    {
+        // Recording must be stopped even if a command failed
+        MOS_STATUS recordStatus = m_picTemplate->EndRecord(cmdBufferInUse);
+        if (eStatus != MOS_STATUS_SUCCESS)
+        {
+            m_picTemplate->Invalidate();
+        }
+        else
+        {
+            eStatus = recordStatus;
+        }
+    }
+
+    return eStatus;
+}
+
+MOS_STATUS CodechalDecodeHevc::AddPictureLongFormatCmds(
+    PMOS_COMMAND_BUFFER             cmdBufferInUse,
+    PIC_LONG_FORMAT_MHW_PARAMS      *picMhwParams)
+{
+    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+
+    CODECHAL_DECODE_FUNCTION_ENTER;
 
-    CODECHAL_DECODE_CHK_STATUS_RETURN(m_hcpInterface->AddHcpPipeBufAddrCmd(
+    CODECHAL_DECODE_CHK_NULL_RETURN(cmdBufferInUse);
+    CODECHAL_DECODE_CHK_NULL_RETURN(picMhwParams);
+
+    CODECHAL_DECODE_CHK_STATUS_RETURN(AddPictureTemplateCmds(
         cmdBufferInUse,
-        picMhwParams->PipeBufAddrParams));
+        picMhwParams));
 
     CODECHAL_DECODE_CHK_STATUS_RETURN(m_hcpInterface->AddHcpIndObjBaseAddrCmd(
         cmdBufferInUse,
@@ -2648,6 +2970,20 @@ MOS_STATUS CodechalDecodeHevc::AllocateStandard (
     MOS_ZeroMemory(m_picMhwParams.QmParams, sizeof(MHW_VDBOX_QM_PARAMS));
     MOS_ZeroMemory(m_picMhwParams.HevcTileState, sizeof(MHW_VDBOX_HEVC_TILE_STATE));
 
+    MOS_USER_FEATURE_VALUE_DATA userFeatureData;
+    MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __MEDIA_USER_FEATURE_VALUE_HEVC_PIC_TEMPLATE_ENABLE_ID,
+        &userFeatureData);
+    m_picTemplateEnabled = userFeatureData.i32Data ? true : false;
+
+    if (m_picTemplateEnabled)
+    {
+        m_picTemplate = MOS_New(MhwCmdTemplate, m_osInterface);
+        CODECHAL_DECODE_CHK_NULL_RETURN(m_picTemplate);
+    }
+
     return eStatus;
 }
 
@@ -2669,7 +3005,9 @@ CodechalDecodeHevc::CodechalDecodeHevc(
                                             m_enableSf2DmaSubmits(false),
                                             m_widthLastMaxAlloced(0),
                                             m_heightLastMaxAlloced(0),
-                                            m_ctbLog2SizeYMax(0)
+                                            m_ctbLog2SizeYMax(0),
+                                            m_picTemplate(nullptr),
+                                            m_picTemplateEnabled(false)
 {
     CODECHAL_DECODE_FUNCTION_ENTER;
 
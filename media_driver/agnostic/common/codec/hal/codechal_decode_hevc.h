@@ -34,6 +34,7 @@
 #include "codechal_decoder.h"
 
 class CodechalDecodeNV12ToP010;
+class MhwCmdTemplate;
 
 typedef class CodechalDecodeHevc *PCODECHAL_DECODE_HEVC_STATE;
 
@@ -360,6 +361,34 @@ public:
         PMOS_COMMAND_BUFFER             cmdBufferInUse,
         PIC_LONG_FORMAT_MHW_PARAMS      *picMhwParams);
 
+    //!
+    //! \brief    Check if the picture level commands can be replayed from a template
+    //! \details  The template can't replay relocations added outside of the
+    //!           patch list or resources registered without a relocation
+    //!
+    //! \return   bool
+    //!           true if the template can be used for the current picture
+    //!
+    virtual bool IsPicTemplateAllowed();
+
+    //!
+    //! \brief    Add HCP pipe mode select, surface and pipe buffer address commands
+    //! \details  The commands are replayed from m_picTemplate while their
+    //!           parameters and the layouts of their surfaces do not change,
+    //!           else they are built and recorded again
+    //!
+    //! \param    [out] cmdBufferInUse
+    //!           Pointer to Command buffer
+    //! \param    [in] picMhwParams
+    //!           Pointer to the picture level MHW parameters
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AddPictureTemplateCmds(
+        PMOS_COMMAND_BUFFER             cmdBufferInUse,
+        PIC_LONG_FORMAT_MHW_PARAMS      *picMhwParams);
+
     //!
     //! \brief    Send long format picture level commands
     //! \details  Send long format picture level commands in HEVC decode driver
@@ -581,6 +610,9 @@ public:
     PIC_LONG_FORMAT_MHW_PARAMS      m_picMhwParams;                                         //!< picture parameters
 
     bool                         m_dummyReferenceSlot[CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC];
+
+    MhwCmdTemplate               *m_picTemplate;                                         //!< Recorded picture level commands
+    bool                         m_picTemplateEnabled;                                   //!< Indicate picture level commands are replayed from m_picTemplate
 };
 
 #endif  // __CODECHAL_DECODER_HEVC_H__
@@ -426,11 +426,26 @@ MOS_STATUS CodechalDecodeJpeg::SetFrameStates()
 
     m_hwInterface->GetCpInterface()->SetCpSecurityType();
 
-    if (m_firstExecuteCall)
+    // Each picture of a batch is a frame of its own
+    if (m_firstExecuteCall || m_decodeParams.m_batchPicNum > 1)
     {
         CODECHAL_DECODE_CHK_STATUS_RETURN(InitializeBeginFrame());
     }
 
+    // The pictures of a batch share the command buffer, so none of them may wait for more bitstream data
+    if (m_decodeParams.m_batchPicNum > 1)
+    {
+        CODECHAL_DECODE_CHK_NULL_RETURN(m_jpegScanParams);
+        CODECHAL_DECODE_CHK_COND_RETURN(
+            m_jpegScanParams->NumScans == 0 || m_jpegScanParams->NumScans < m_jpegPicParams->m_totalScans,
+            "Batched JPEG picture %d misses scans.", m_decodeParams.m_batchPicIdx);
+
+        uint32_t lastScan = m_jpegScanParams->NumScans - 1;
+        CODECHAL_DECODE_CHK_COND_RETURN(
+            m_dataSize < m_jpegScanParams->ScanHeader[lastScan].DataOffset + m_jpegScanParams->ScanHeader[lastScan].DataLength,
+            "Batched JPEG picture %d misses bitstream data.", m_decodeParams.m_batchPicIdx);
+    }
+
     // Check whether the bitstream buffer is completed. If not, allocate a larger buffer and copy the bitstream.
     CODECHAL_DECODE_CHK_STATUS_RETURN(CheckAndCopyIncompleteBitStream());
 
@@ -509,6 +524,11 @@ MOS_STATUS CodechalDecodeJpeg::SetFrameStates()
 
 #ifdef _DECODE_PROCESSING_SUPPORTED
     m_sfcState->CheckAndInitialize(&m_destSurface, m_jpegPicParams);
+
+    // The engine hints of a submission follow its last picture, so batched pictures are not output through SFC
+    CODECHAL_DECODE_CHK_COND_RETURN(
+        m_decodeParams.m_batchPicNum > 1 && m_sfcState->m_sfcPipeOut,
+        "Batched JPEG pictures can not be output through SFC.");
 #endif
 
     CODECHAL_DEBUG_TOOL(
@@ -640,8 +660,12 @@ MOS_STATUS CodechalDecodeJpeg::DecodeStateLevel()
         &cmdBuffer,
         0));
 
-    CODECHAL_DECODE_CHK_STATUS_RETURN(SendPrologWithFrameTracking(
-        &cmdBuffer, true));
+    // Send command buffer header at the beginning, once for the pictures of a batch
+    if (IsFirstPictureInBatch())
+    {
+        CODECHAL_DECODE_CHK_STATUS_RETURN(SendPrologWithFrameTracking(
+            &cmdBuffer, true));
+    }
 
     // Set PIPE_MODE_SELECT
     MHW_VDBOX_PIPE_MODE_SELECT_PARAMS pipeModeSelectParams;
@@ -928,6 +952,14 @@ MOS_STATUS CodechalDecodeJpeg::DecodePrimitiveLevel()
             &cmdBuffer));
     }
 
+    // The next picture of a batch continues this command buffer
+    if (!IsLastPictureInBatch())
+    {
+        m_osInterface->pfnReturnCommandBuffer(m_osInterface, &cmdBuffer, 0);
+        SetOutputSurfaceLayout(&m_decodeParams.m_outputSurfLayout);
+        return eStatus;
+    }
+
     CODECHAL_DECODE_CHK_STATUS_RETURN(m_miInterface->AddMiBatchBufferEnd(
         &cmdBuffer,
         nullptr));
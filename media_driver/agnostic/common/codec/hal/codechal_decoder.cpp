@@ -815,6 +815,16 @@ void CodechalDecode::CalcRequestedSpace(
     requestedPatchListSize = m_commandPatchListSizeNeeded +
         (m_standardDecodePatchListSizeNeeded * (m_decodeParams.m_numSlices + 1));
     additionalSizeNeeded = COMMAND_BUFFER_RESERVED_SPACE;
+
+    // The pictures of a batch share the command buffer
+    if (m_decodeParams.m_batchPicNum > 1)
+    {
+        uint32_t numPics = m_decodeParams.m_batchPicNum;
+        requestedSize = m_commandBufferSizeNeeded * numPics +
+            (m_standardDecodeSizeNeeded * (m_decodeParams.m_batchNumSlices + numPics));
+        requestedPatchListSize = m_commandPatchListSizeNeeded * numPics +
+            (m_standardDecodePatchListSizeNeeded * (m_decodeParams.m_batchNumSlices + numPics));
+    }
 }
 
 MOS_STATUS CodechalDecode::VerifySpaceAvailable ()
@@ -1198,6 +1208,15 @@ MOS_STATUS CodechalDecode::Execute(void *params)
 #endif
     m_decodeParams  = *decodeParams;
 
+    // Only JPEG pictures can share a command buffer, each picture of the batch takes a status report entry
+    CODECHAL_DECODE_CHK_COND_RETURN(
+        m_decodeParams.m_batchPicNum > 1 && m_standard != CODECHAL_JPEG,
+        "Batched decode is not supported for standard %d", m_standard);
+    CODECHAL_DECODE_CHK_COND_RETURN(
+        m_decodeParams.m_batchPicNum > CODECHAL_DECODE_MAX_BATCH_PICS ||
+        (m_decodeParams.m_batchPicNum > 0 && m_decodeParams.m_batchPicIdx >= m_decodeParams.m_batchPicNum),
+        "Invalid batch picture %d of %d", m_decodeParams.m_batchPicIdx, m_decodeParams.m_batchPicNum);
+
     CODECHAL_DECODE_CHK_STATUS_RETURN(Mos_Solo_PreProcessDecode(
         m_osInterface,
         m_decodeParams.m_destSurface));
@@ -1208,13 +1227,14 @@ MOS_STATUS CodechalDecode::Execute(void *params)
         m_osInterface,
         decodeParams->m_destSurface));
 
-    if(!m_isHybridDecoder)
+    // Later pictures of a batch add to the command buffer of the first one
+    if(!m_isHybridDecoder && IsFirstPictureInBatch())
     {
         CODECHAL_DECODE_CHK_STATUS_RETURN(m_osInterface->pfnSetGpuContext(
             m_osInterface,
             m_videoContext));
     }
-    if (!m_incompletePicture)
+    if (!m_incompletePicture && IsFirstPictureInBatch())
     {
         m_osInterface->pfnResetOsStates(m_osInterface);
     }
@@ -1222,13 +1242,30 @@ MOS_STATUS CodechalDecode::Execute(void *params)
     CODECHAL_DECODE_CHK_STATUS_MESSAGE_RETURN(SetFrameStates(),
         "Decoding initialization failed.");
 
-    CODECHAL_DECODE_CHK_STATUS_RETURN(VerifySpaceAvailable());
+    if (IsFirstPictureInBatch())
+    {
+        CODECHAL_DECODE_CHK_STATUS_RETURN(VerifySpaceAvailable());
+    }
 
     CODECHAL_DECODE_CHK_STATUS_RETURN(SetDummyReference());
 
-    CODECHAL_DECODE_CHK_STATUS_RETURN(m_miInterface->SetWatchdogTimerThreshold(m_width, m_height, false));
+    // The watchdog timer covers the command buffer, so it is set for all the pictures of a batch before the prolog
+    if (m_decodeParams.m_batchPicNum > 1)
+    {
+        if (IsFirstPictureInBatch())
+        {
+            CODECHAL_DECODE_CHK_STATUS_RETURN(m_miInterface->SetWatchdogTimerThreshold(
+                m_decodeParams.m_batchWidth,
+                m_decodeParams.m_batchHeight,
+                false));
+        }
+    }
+    else
+    {
+        CODECHAL_DECODE_CHK_STATUS_RETURN(m_miInterface->SetWatchdogTimerThreshold(m_width, m_height, false));
+    }
 
-    if ((!m_incompletePicture) && (!m_isHybridDecoder))
+    if ((!m_incompletePicture) && (!m_isHybridDecoder) && IsFirstPictureInBatch())
     {
         m_osInterface->pfnIncPerfFrameID(m_osInterface);
         m_osInterface->pfnSetPerfTag(
@@ -1749,16 +1786,19 @@ MOS_STATUS CodechalDecode::SendPrologWithFrameTracking(
         cmdBuffer->Attributes.dwMediaFrameTrackingAddrOffset = 0;
     }
 
-#ifdef _MMC_SUPPORTED
-    CODECHAL_DECODE_CHK_STATUS_RETURN(m_mmc->SendPrologCmd(m_miInterface, cmdBuffer, MOS_RCS_ENGINE_USED(gpuContext)));
-#endif
-
     MHW_GENERIC_PROLOG_PARAMS genericPrologParams;
     MOS_ZeroMemory(&genericPrologParams, sizeof(genericPrologParams));
     genericPrologParams.pOsInterface                    = m_osInterface;
     genericPrologParams.pvMiInterface                   = m_miInterface;
     genericPrologParams.bMmcEnabled                     = CodecHalMmcState::IsMmcEnabled();
 
+    // MMC prolog and invariant generic prolog from the cached batch of this GPU context
+    CODECHAL_DECODE_CHK_STATUS_RETURN(m_hwInterface->SendPrologInvariantCmds(
+        cmdBuffer,
+        m_mmc,
+        &genericPrologParams));
+    genericPrologParams.bSkipInvariantCmds              = true;
+
     CODECHAL_DECODE_CHK_STATUS_RETURN(Mhw_SendGenericPrologCmd(
         cmdBuffer,
         &genericPrologParams));
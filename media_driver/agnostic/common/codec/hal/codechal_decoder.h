@@ -568,6 +568,20 @@ public:
     //!
     bool IsStatusQueryReportingEnabled() { return m_statusQueryReportingEnabled; }
 
+    //!
+    //! \brief  Check if the current picture starts its command buffer
+    //! \return bool
+    //!         true unless the picture follows another picture of its batch
+    //!
+    bool IsFirstPictureInBatch() { return m_decodeParams.m_batchPicIdx == 0; }
+
+    //!
+    //! \brief  Check if the current picture ends its command buffer
+    //! \return bool
+    //!         true if the picture is the last of its batch or is not batched
+    //!
+    bool IsLastPictureInBatch() { return m_decodeParams.m_batchPicIdx + 1 >= m_decodeParams.m_batchPicNum; }
+
     //!
     //! \brief  Gets decode status buffer
     //! \return The decode status buffer \see m_decodeStatusBuf
@@ -26,6 +26,8 @@
 
 #include "codechal_encoder_base.h"
 #include "codechal_encode_csc_ds.h"
+#include "codechal_encode_ds_share.h"
+#include "codechal_encode_wp.h"
 
 MOS_STATUS CodechalEncodeCscDs::AllocateSurfaceCsc()
 {
@@ -420,6 +422,12 @@ MOS_STATUS CodechalEncodeCscDs::SetSurfacesToEncPak()
     {
         m_rawSurfaceToEnc = cscSurface;
 
+        // the CSC surface gets a new picture, its weighted copies are stale
+        if (m_encoder->m_wpState)
+        {
+            m_encoder->m_wpState->InvalidateRef(cscSurface);
+        }
+
         // update the RawBuffer and RefBuffer (if Raw is used as Ref)
         m_currRefList->sRefRawBuffer = *cscSurface;
         if (m_useRawForRef)
@@ -1210,6 +1218,28 @@ MOS_STATUS CodechalEncodeCscDs::KernelFunctions(
     bool useDsConvInCombinedKernel = m_useCommonKernel
         && !(CODECHAL_AVC == m_standard || CODECHAL_MPEG2 == m_standard || CODECHAL_VP8 == m_standard);
 
+    // the streams of a MFE context encoding the same raw surface share its DS surfaces,
+    // the CSC output is the raw surface of the PAK so it is not shared.
+    // Sharing stops at the MFE context: its streams are submitted in order on one device,
+    // so the readers only need the MOS resource sync. Separate encode sessions have no
+    // such order and would need cross-context fences, they keep downscaling on their own.
+    if (m_encoder->m_mfeEnabled && m_encoder->m_mfeEncodeSharedState && m_encoder->m_mfeEncodeSharedState->dsShare &&
+        m_scalingEnabled && !m_2xScalingEnabled && m_firstField && !m_currRefList->b4xScalingUsed &&
+        !m_cscFlag && !useDsConvInCombinedKernel && CODECHAL_VP9 != m_standard)
+    {
+        bool shared = false;
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_encoder->m_trackedBuf->AllocateSharedSurfaceDS(
+            m_encoder->m_mfeEncodeSharedState->dsShare, m_rawSurfaceToEnc, &shared));
+
+        if (shared)
+        {
+            m_currRefList->b4xScalingUsed  = true;
+            m_currRefList->b16xScalingUsed = m_16xMeSupported;
+            m_currRefList->b32xScalingUsed = m_32xMeSupported;
+            return MOS_STATUS_SUCCESS;
+        }
+    }
+
     // call Ds+Copy
     if (m_cscFlag || useDsConvInCombinedKernel)
     {
@@ -1752,6 +1782,7 @@ MOS_STATUS CodechalEncodeCscDs::DsKernel(
     }
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(m_renderInterface->AddMediaObjectWalkerCmd(&cmdBuffer, &walkerParams));
+    MOS_IncrementUltCounter(MOS_ULT_COUNTER_ENCODE_DS_WALKERS);
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(m_encoder->EndStatusReport(&cmdBuffer, encFunctionType));
 
@@ -0,0 +1,256 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     codechal_encode_ds_share.cpp
+//! \brief    Downscaled surfaces shared by the encoders of a MFE context
+//!
+
+#include "codechal_encode_ds_share.h"
+#include "codechal_encoder_base.h"
+
+CodechalEncodeDsShare::CodechalEncodeDsShare()
+{
+    m_mutex = MOS_CreateMutex();
+}
+
+CodechalEncodeDsShare::~CodechalEncodeDsShare()
+{
+    // the surfaces are freed by the users, only the idle entries of the last one can remain
+    for (auto entry : m_entries)
+    {
+        MOS_Delete(entry);
+    }
+    m_entries.clear();
+
+    MOS_DestroyMutex(m_mutex);
+}
+
+void CodechalEncodeDsShare::AddUser()
+{
+    MOS_LockMutex(m_mutex);
+    m_userNum++;
+    MOS_UnlockMutex(m_mutex);
+}
+
+uint32_t CodechalEncodeDsShare::RemoveUser(PMOS_INTERFACE osInterface)
+{
+    MOS_LockMutex(m_mutex);
+
+    if (osInterface)
+    {
+        Trim(osInterface, 0);
+    }
+
+    uint32_t userNum = m_userNum ? --m_userNum : 0;
+
+    MOS_UnlockMutex(m_mutex);
+
+    return userNum;
+}
+
+void CodechalEncodeDsShare::NewSubmission()
+{
+    MOS_LockMutex(m_mutex);
+    m_submission++;
+    MOS_UnlockMutex(m_mutex);
+}
+
+bool CodechalEncodeDsShare::IsSameSize(const Key &key1, const Key &key2)
+{
+    for (uint32_t i = 0; i < dsNum; i++)
+    {
+        if (key1.width[i] != key2.width[i] || key1.height[i] != key2.height[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CodechalEncodeDsShare::IsSameKey(const Key &key1, const Key &key2)
+{
+    return key1.rawSurface  == key2.rawSurface &&
+           key1.submission  == key2.submission &&
+           key1.standard    == key2.standard   &&
+           key1.picFlags    == key2.picFlags   &&
+           key1.interleaved == key2.interleaved &&
+           IsSameSize(key1, key2);
+}
+
+CodechalEncodeDsShare::Entry *CodechalEncodeDsShare::Acquire(const Key &key)
+{
+    Entry *found = nullptr;
+
+    MOS_LockMutex(m_mutex);
+
+    for (auto entry : m_entries)
+    {
+        if (entry->ready && IsSameKey(entry->key, key))
+        {
+            entry->refCount++;
+            found = entry;
+            break;
+        }
+    }
+
+    MOS_UnlockMutex(m_mutex);
+
+    return found;
+}
+
+MOS_STATUS CodechalEncodeDsShare::Create(PMOS_INTERFACE osInterface, const Key &key, Entry **entry)
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    CODECHAL_ENCODE_CHK_NULL_RETURN(osInterface);
+    CODECHAL_ENCODE_CHK_NULL_RETURN(entry);
+
+    MOS_STATUS eStatus  = MOS_STATUS_SUCCESS;
+    Entry      *created = nullptr;
+    *entry = nullptr;
+
+    MOS_LockMutex(m_mutex);
+
+    // reuse the surfaces of the oldest idle entry with the same sizes
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        Entry *idle = *it;
+        if (idle->refCount == 0 && IsSameSize(idle->key, key))
+        {
+            m_entries.erase(it);
+            created = idle;
+            break;
+        }
+    }
+
+    if (created == nullptr)
+    {
+        created = MOS_New(Entry);
+        if (created == nullptr)
+        {
+            eStatus = MOS_STATUS_NO_SPACE;
+            goto finish;
+        }
+
+        for (uint32_t i = 0; i < dsNum; i++)
+        {
+            if (key.width[i] == 0)
+            {
+                continue;
+            }
+
+            MOS_ALLOC_GFXRES_PARAMS allocParams;
+            MOS_ZeroMemory(&allocParams, sizeof(allocParams));
+            allocParams.Type     = MOS_GFXRES_2D;
+            allocParams.Format   = Format_NV12;
+            allocParams.TileType = MOS_TILE_Y;
+            allocParams.dwWidth  = key.width[i];
+            allocParams.dwHeight = key.height[i];
+            allocParams.pBufName = "sharedDsSurface";
+
+            eStatus = osInterface->pfnAllocateResource(osInterface, &allocParams, &created->surface[i].OsResource);
+            if (eStatus == MOS_STATUS_SUCCESS)
+            {
+                eStatus = CodecHalGetResourceInfo(osInterface, &created->surface[i]);
+            }
+            if (eStatus != MOS_STATUS_SUCCESS)
+            {
+                CODECHAL_ENCODE_ASSERTMESSAGE("Failed to allocate the shared downscaled surfaces.");
+                FreeEntry(osInterface, created);
+                goto finish;
+            }
+        }
+    }
+
+    created->key      = key;
+    created->refCount = 1;
+    created->ready    = false;
+    m_entries.push_back(created);
+    *entry = created;
+
+finish:
+    MOS_UnlockMutex(m_mutex);
+    return eStatus;
+}
+
+void CodechalEncodeDsShare::Publish(Entry *entry)
+{
+    MOS_LockMutex(m_mutex);
+    entry->ready = true;
+    MOS_UnlockMutex(m_mutex);
+}
+
+void CodechalEncodeDsShare::Release(PMOS_INTERFACE osInterface, Entry *entry)
+{
+    MOS_LockMutex(m_mutex);
+
+    if (entry->refCount)
+    {
+        entry->refCount--;
+    }
+
+    // an entry whose downscaling never got submitted cannot be found by the other encoders
+    if (entry->refCount == 0)
+    {
+        entry->ready = false;
+    }
+
+    Trim(osInterface, CODECHAL_ENCODE_DS_SHARE_MAX_IDLE_ENTRIES);
+
+    MOS_UnlockMutex(m_mutex);
+}
+
+void CodechalEncodeDsShare::FreeEntry(PMOS_INTERFACE osInterface, Entry *entry)
+{
+    for (uint32_t i = 0; i < dsNum; i++)
+    {
+        if (!Mos_ResourceIsNull(&entry->surface[i].OsResource))
+        {
+            osInterface->pfnFreeResource(osInterface, &entry->surface[i].OsResource);
+        }
+    }
+    MOS_Delete(entry);
+}
+
+void CodechalEncodeDsShare::Trim(PMOS_INTERFACE osInterface, uint32_t maxIdleNum)
+{
+    uint32_t idleNum = 0;
+    for (auto entry : m_entries)
+    {
+        idleNum += (entry->refCount == 0);
+    }
+
+    for (auto it = m_entries.begin(); it != m_entries.end() && idleNum > maxIdleNum;)
+    {
+        if ((*it)->refCount == 0)
+        {
+            FreeEntry(osInterface, *it);
+            it = m_entries.erase(it);
+            idleNum--;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
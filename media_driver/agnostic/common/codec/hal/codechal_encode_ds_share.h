@@ -0,0 +1,193 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     codechal_encode_ds_share.h
+//! \brief    Downscaled surfaces shared by the encoders of a MFE context
+//! \details  Encoders of an adaptive bitrate ladder encode the same raw surface at
+//!           the same resolution. The 4x/16x/32x downscaled surfaces of a raw
+//!           surface only depend on the raw surface and the downscaling setup, so
+//!           the first encoder of a submission downscales it and the following
+//!           ones with the same setup use its surfaces.
+//!           The share belongs to one MFE context, not to the device. Encoders of
+//!           separate contexts are not ordered against each other and do not share.
+//!
+
+#ifndef __CODECHAL_ENCODE_DS_SHARE_H__
+#define __CODECHAL_ENCODE_DS_SHARE_H__
+
+#include "codechal.h"
+#include <vector>
+
+#define CODECHAL_ENCODE_DS_SHARE_MAX_IDLE_ENTRIES   4   //!< Max unreferenced entries kept for reuse
+
+//!
+//! \class    CodechalEncodeDsShare
+//! \brief    Reference counted downscaled surfaces, keyed by raw surface and submission
+//! \details  The surfaces of an entry are owned by the share. Tracked buffer slots
+//!           reference the entries of the frames they track, so an entry stays
+//!           valid as long as one encoder uses its frame as a reference. Entries
+//!           are only used by other encoders once the downscaling is submitted.
+//!
+class CodechalEncodeDsShare
+{
+public:
+    //!
+    //! \brief    Downscaled surfaces of an entry
+    //!
+    enum DsSurface
+    {
+        ds4x = 0,
+        ds16x,
+        ds32x,
+        dsNum
+    };
+
+    //!
+    //! \brief    Raw surface and downscaling setup the surfaces are generated from
+    //!
+    struct Key
+    {
+        const void              *rawSurface = nullptr;          //!< Identity of the raw surface allocation
+        uint32_t                submission  = 0;                //!< Submission the raw surface is encoded in
+        uint32_t                standard    = 0;                //!< Encoder standard, it selects the DS kernel
+        uint8_t                 picFlags    = 0;                //!< Picture structure
+        bool                    interleaved = false;            //!< Field scaling output interleaved
+        uint32_t                width[dsNum]  = {};             //!< Surface widths, 0 if the surface is not used
+        uint32_t                height[dsNum] = {};             //!< Surface heights, 0 if the surface is not used
+    };
+
+    //!
+    //! \brief    Downscaled surfaces of a raw surface
+    //!
+    struct Entry
+    {
+        Key                     key;
+        MOS_SURFACE             surface[dsNum] = {};
+        uint32_t                refCount = 0;
+        bool                    ready    = false;               //!< Downscaling submitted
+    };
+
+    //!
+    //! \brief    Constructor, the creator is the first user
+    //!
+    CodechalEncodeDsShare();
+
+    //!
+    //! \brief    Destructor
+    //!
+    ~CodechalEncodeDsShare();
+
+    //!
+    //! \brief    Register a user of the share
+    //!
+    void AddUser();
+
+    //!
+    //! \brief    Unregister a user of the share
+    //! \details  The idle entries are freed with the OS interface of the user.
+    //! \param    [in] osInterface
+    //!           OS interface of an encoder, nullptr for the owner of the MFE context
+    //! \return   uint32_t
+    //!           Remaining users, the share is deleted by the caller when it is 0
+    //!
+    uint32_t RemoveUser(PMOS_INTERFACE osInterface);
+
+    //!
+    //! \brief    Start a submission, entries of previous submissions are no longer found
+    //!
+    void NewSubmission();
+
+    //!
+    //! \brief    Get the current submission
+    //!
+    uint32_t GetSubmission() { return m_submission; }
+
+    //!
+    //! \brief    Take a reference on the downscaled surfaces of key
+    //! \return   Entry *
+    //!           The entry, nullptr if no encoder submitted the downscaling of key
+    //!
+    Entry *Acquire(const Key &key);
+
+    //!
+    //! \brief    Create the entry of key, with a reference taken by the caller
+    //! \details  An idle entry with the same surface sizes is reused, else the
+    //!           surfaces are allocated. The caller downscales into the surfaces
+    //!           and then calls Publish().
+    //! \param    [in] osInterface
+    //!           OS interface of the caller
+    //! \param    [in] key
+    //!           Raw surface and downscaling setup
+    //! \param    [out] entry
+    //!           The entry
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Create(PMOS_INTERFACE osInterface, const Key &key, Entry **entry);
+
+    //!
+    //! \brief    Make an entry available to the other encoders
+    //! \param    [in] entry
+    //!           Entry whose downscaling is submitted
+    //!
+    void Publish(Entry *entry);
+
+    //!
+    //! \brief    Drop a reference on an entry
+    //! \param    [in] osInterface
+    //!           OS interface of the caller, used to free the entries in excess
+    //! \param    [in] entry
+    //!           The entry
+    //!
+    void Release(PMOS_INTERFACE osInterface, Entry *entry);
+
+private:
+    CodechalEncodeDsShare(const CodechalEncodeDsShare &) = delete;
+    CodechalEncodeDsShare &operator=(const CodechalEncodeDsShare &) = delete;
+
+    //!
+    //! \brief    Check if the surfaces of two keys have the same sizes
+    //!
+    static bool IsSameSize(const Key &key1, const Key &key2);
+
+    //!
+    //! \brief    Check if two keys are the same
+    //!
+    static bool IsSameKey(const Key &key1, const Key &key2);
+
+    //!
+    //! \brief    Free the surfaces of an entry and delete it
+    //!
+    void FreeEntry(PMOS_INTERFACE osInterface, Entry *entry);
+
+    //!
+    //! \brief    Free the idle entries beyond maxIdleNum, the oldest first
+    //!
+    void Trim(PMOS_INTERFACE osInterface, uint32_t maxIdleNum);
+
+    PMOS_MUTEX              m_mutex      = nullptr;
+    std::vector<Entry *>    m_entries;                          //!< Entries, the oldest first
+    uint32_t                m_userNum    = 1;
+    uint32_t                m_submission = 0;
+};
+
+#endif  // __CODECHAL_ENCODE_DS_SHARE_H__
@@ -1563,10 +1563,150 @@ MOS_STATUS CodechalEncHevcState::InitializePicture(const EncoderParams& params)
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(CodechalEncodeHevcBase::InitializePicture(params));
     CODECHAL_ENCODE_CHK_STATUS_RETURN(GetFrameBrcLevel());
-    
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(InitMfe());
+
     return eStatus;
 }
 
+MOS_STATUS CodechalEncHevcState::InitMfe()
+{
+    if (!m_mfeEnabled)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    CODECHAL_ENCODE_CHK_NULL_RETURN(m_mfeEncodeSharedState);
+
+    m_mfeLastStream  = (m_mfeEncodeParams.submitIndex == m_mfeEncodeParams.submitNumber - 1);
+    m_mfeFirstStream = (m_mfeEncodeParams.submitIndex == 0);
+
+    if (!m_mfeInitialized)
+    {
+        CODECHAL_DEBUG_TOOL(
+            m_debugInterface->m_streamId = m_mfeEncodeParams.streamId;)
+
+        // bookkeeping the orignal interfaces, which are changed during the merged mbenc phase
+        m_origHwInterface        = m_hwInterface;
+        m_origOsInterface        = m_osInterface;
+        m_origStateHeapInterface = m_stateHeapInterface;
+        m_origMbEncKernelStates  = m_mbEncKernelStates;
+
+        // Whether mbenc kernels of all the streams are merged or not.
+        // The merged phase chains the streams in one command buffer, so it needs single task phase.
+        MOS_USER_FEATURE_VALUE_DATA userFeatureData;
+        MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+        MOS_UserFeature_ReadValue_ID(
+            nullptr,
+            __MEDIA_USER_FEATURE_VALUE_MFE_MBENC_ENABLE_ID,
+            &userFeatureData);
+        m_mfeMbEncEanbled = (userFeatureData.i32Data && m_singleTaskPhaseSupported) ? true : false;
+
+        m_mfeInitialized = true;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS CodechalEncHevcState::MfeMbEncPhaseBegin()
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    if (!IsMfeMbEncEnabled())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    auto mfeEncodeSharedState = m_mfeEncodeSharedState;
+    CODECHAL_ENCODE_CHK_NULL_RETURN(mfeEncodeSharedState);
+
+    if (m_mfeFirstStream)
+    {
+        mfeEncodeSharedState->pHwInterface         = m_hwInterface;
+        mfeEncodeSharedState->pOsInterface         = m_osInterface;
+        mfeEncodeSharedState->pMfeMbEncKernelState = m_mbEncKernelStates;
+        m_hwInterface->GetRenderInterface()->m_stateHeapInterface = m_stateHeapInterface;
+    }
+    else
+    {
+        // Kernels are loaded into the instruction heap of each stream, so the streams use
+        // the kernel states of the first stream together with its state heap.
+        CODECHAL_ENCODE_CHK_NULL_RETURN(mfeEncodeSharedState->pHwInterface);
+        CODECHAL_ENCODE_CHK_NULL_RETURN(mfeEncodeSharedState->pOsInterface);
+        CODECHAL_ENCODE_CHK_NULL_RETURN(mfeEncodeSharedState->pMfeMbEncKernelState);
+
+        m_hwInterface        = mfeEncodeSharedState->pHwInterface;
+        m_osInterface        = mfeEncodeSharedState->pOsInterface;
+        m_stateHeapInterface = m_hwInterface->GetRenderInterface()->m_stateHeapInterface;
+        m_mbEncKernelStates  = mfeEncodeSharedState->pMfeMbEncKernelState;
+        m_renderEngineInterface->SetOsInterface(m_osInterface);
+
+        CODECHAL_DEBUG_TOOL(
+            m_debugInterface->m_osInterface = m_osInterface;)
+    }
+
+    // The binding tables and surface states of stream N start at N slots in the SSH of the
+    // merged command buffer, a slot holding the largest task phase of one stream. The first
+    // stream's slot starts with the phase, so it also holds the BRC kernels run before MbEnc.
+    auto stateHeap = m_stateHeapInterface->pStateHeapInterface;
+    CODECHAL_ENCODE_CHK_NULL_RETURN(stateHeap);
+    if (m_mfeFirstStream)
+    {
+        uint32_t btSize = 0;
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_stateHeapInterface->pfnCalculateSshAndBtSizesRequested(
+            m_stateHeapInterface,
+            m_maxBtCount,
+            &mfeEncodeSharedState->dwMbEncSshStreamSize,
+            &btSize));
+    }
+    else
+    {
+        uint32_t sshOffset = m_mfeEncodeParams.submitIndex * mfeEncodeSharedState->dwMbEncSshStreamSize;
+        CODECHAL_ENCODE_CHK_COND_RETURN(
+            stateHeap->GetSshCurrOffset() > sshOffset,
+            "MbEnc kernels of stream %d overflow its SSH slot", m_mfeEncodeParams.submitIndex - 1);
+        stateHeap->SetSshCurrOffset(sshOffset);
+    }
+
+    // Set maximum width/height of the streams in this submission
+    if (m_picWidthInMb > mfeEncodeSharedState->dwPicWidthInMB)
+    {
+        mfeEncodeSharedState->dwPicWidthInMB = m_picWidthInMb;
+    }
+    if (m_picHeightInMb > mfeEncodeSharedState->dwPicHeightInMB)
+    {
+        mfeEncodeSharedState->dwPicHeightInMB = m_picHeightInMb;
+    }
+
+    // Only the first stream sends the prolog, only the last stream submits
+    m_firstTaskInPhase = m_mfeFirstStream;
+    m_lastTaskInPhase  = false;
+    m_mfeMbEncPhase    = true;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS CodechalEncHevcState::MfeMbEncPhaseEnd()
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    if (!m_mfeMbEncPhase)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    m_stateHeapInterface = m_origStateHeapInterface;
+    m_hwInterface        = m_origHwInterface;
+    m_osInterface        = m_origOsInterface;
+    m_mbEncKernelStates  = m_origMbEncKernelStates;
+    m_renderEngineInterface->SetOsInterface(m_origOsInterface);
+    m_mfeMbEncPhase      = false;
+
+    CODECHAL_DEBUG_TOOL(
+        m_debugInterface->m_osInterface = m_osInterface;)
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS CodechalEncHevcState::SetMeCurbeParams(
     CodechalKernelHme::CurbeParam &curbeParams)
 {
@@ -169,6 +169,13 @@ public:
     uint8_t                                     m_roundingIntraInUse = 10;             //!< rounding intra actually used
     uint8_t                                     m_roundingInterInUse = 4;             //!< rounding inter actually used
 
+    // MFE
+    bool                                        m_mfeMbEncPhase           = false;    //!< MbEnc phase is merged with the other MFE streams
+    PMHW_KERNEL_STATE                           m_origMbEncKernelStates   = nullptr;  //!< Own MbEnc kernel states, replaced by the first stream's during the merged phase
+    PMOS_INTERFACE                              m_origOsInterface         = nullptr;  //!< Own Os Interface
+    CodechalHwInterface                         *m_origHwInterface        = nullptr;  //!< Own Hw Interface
+    PMHW_STATE_HEAP_INTERFACE                   m_origStateHeapInterface  = nullptr;  //!< Own StateHeap Interface
+
     // ScalingAndConversion
     PMHW_KERNEL_STATE                      m_scalingAndConversionKernelState        = nullptr;  //!< Pointer to ScalingAndConversion kernel state
     PCODECHAL_ENCODE_BINDING_TABLE_GENERIC m_scalingAndConversionKernelBindingTable = nullptr;  //!< ScalingAndConversion kernel binding table
@@ -521,6 +528,61 @@ public:
     //!           MOS_STATUS_SUCCESS if success, else fail reason
     //!
     MOS_STATUS DumpHMESurfaces();
+    //!
+    //! \brief    Defer init MFE specific flags
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS InitMfe();
+
+    //!
+    //! \brief    Check whether MbEnc kernels are merged across MFE streams
+    //!
+    //! \return   bool
+    //!           true if MFE MbEnc is enabled, otherwise false
+    //!
+    bool IsMfeMbEncEnabled()
+    {
+        return m_mfeEnabled && m_mfeMbEncEanbled;
+    }
+
+    //!
+    //! \brief    Start the MbEnc phase merged across MFE streams
+    //! \details  All the streams of one submission record their MbEnc kernels into the
+    //!           command buffer of the first stream, using its HW/OS/StateHeap interfaces
+    //!           and its MbEnc kernel states. The last stream submits the command buffer.
+    //!           The SSH of the command buffer is split in one slot per stream, sized for
+    //!           m_maxBtCount entries: the binding tables of stream N start at N times the
+    //!           slot size. The CURBE and interface descriptor of each kernel are assigned
+    //!           a new block of the shared DSH per stream, kept until the command buffer
+    //!           completes, so the streams never overwrite each other's CURBE.
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS MfeMbEncPhaseBegin();
+
+    //!
+    //! \brief    End the MbEnc phase merged across MFE streams
+    //! \details  Restore the interfaces and kernel states of this stream.
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS MfeMbEncPhaseEnd();
+
+    //!
+    //! \brief    Get the last task flag of the MbEnc phase
+    //!
+    //! \return   bool
+    //!           true if the current kernel closes and submits the MbEnc phase
+    //!
+    bool IsLastTaskInMbEncPhase()
+    {
+        return m_mfeMbEncPhase ? m_mfeLastStream : true;
+    }
+
     //!
     //! \brief    Get rounding inter/intra for current frame to use
     //!           
@@ -41,6 +41,16 @@ MOS_STATUS CodechalEncodeJpegState::Initialize(CodechalSetting  *settings)
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(CodechalEncoderState::Initialize(settings));
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+    MOS_USER_FEATURE_VALUE_DATA userFeatureData;
+    MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __MEDIA_USER_FEATURE_VALUE_JPEG_ENCODE_TABLE_REUSE_DISABLE_ID,
+        &userFeatureData);
+    m_tableReuseDisabled = userFeatureData.i32Data ? true : false;
+#endif
+
     // Picture Level Commands
     CODECHAL_ENCODE_CHK_STATUS_RETURN(
         m_hwInterface->GetMfxStateCommandsDataSize(
@@ -108,6 +118,14 @@ MOS_STATUS CodechalEncodeJpegState::InitializePicture(const EncoderParams& param
     CODECHAL_ENCODE_CHK_NULL_RETURN(m_jpegQuantTables);
     CODECHAL_ENCODE_CHK_NULL_RETURN(m_jpegHuffmanTable);
 
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(CheckScanParams());
+
+    // The status report gives the end of each scan
+    CODECHAL_ENCODE_CHK_NULL_RETURN(m_encodeStatusBuf.pEncodeStatus);
+    EncodeStatus *encodeStatus = (EncodeStatus *)(m_encodeStatusBuf.pEncodeStatus +
+        m_encodeStatusBuf.wCurrIndex * m_encodeStatusBuf.dwReportSize);
+    encodeStatus->dwNumScans = m_encodeParams.dwNumSlices;
+
     // Set Status Report Feedback Number
     m_statusReportFeedbackNumber = m_jpegPicParams->m_statusReportFeedbackNumber;
     m_currRefList                = m_refList[m_currOriginalPic.FrameIdx];
@@ -472,20 +490,23 @@ MOS_STATUS CodechalEncodeJpegState::PackQuantTable(
 }
 
 MOS_STATUS CodechalEncodeJpegState::PackRestartInterval(
-    BSBuffer                        *buffer)
+    BSBuffer                        *buffer,
+    CodecEncodeJpegScanHeader       *scanParams)
 {
     CODECHAL_ENCODE_FUNCTION_ENTER;
 
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
+    CODECHAL_ENCODE_CHK_NULL_RETURN(scanParams);
+
     CodechalEncodeJpegRestartHeader *restartHeader = (CodechalEncodeJpegRestartHeader *)MOS_AllocAndZeroMemory(sizeof(CodechalEncodeJpegRestartHeader));
     CODECHAL_ENCODE_CHK_NULL_RETURN(restartHeader);
 
     restartHeader->m_dri = 0xDDFF;
     uint16_t hdrSize  = sizeof(uint16_t) * 3;
     restartHeader->m_lr  = (((hdrSize - 2) & 0xFF) << 8) | (((hdrSize - 2) & 0xFF00) >> 8);
-    restartHeader->m_ri  = (uint16_t)(((m_jpegScanParams->m_restartInterval & 0xFF) << 8) |
-        ((m_jpegScanParams->m_restartInterval & 0xFF00) >> 8));
+    restartHeader->m_ri  = (uint16_t)(((scanParams->m_restartInterval & 0xFF) << 8) |
+        ((scanParams->m_restartInterval & 0xFF00) >> 8));
 
     buffer->pBase        = (uint8_t*)restartHeader;
     buffer->BitOffset    = 0;
@@ -495,15 +516,37 @@ MOS_STATUS CodechalEncodeJpegState::PackRestartInterval(
 }
 
 MOS_STATUS CodechalEncodeJpegState::PackScanHeader(
-    BSBuffer                        *buffer)
+    BSBuffer                        *buffer,
+    CodecEncodeJpegScanHeader       *scanParams)
 {
     CODECHAL_ENCODE_FUNCTION_ENTER;
 
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
+    CODECHAL_ENCODE_CHK_NULL_RETURN(scanParams);
+
+    // A single scan codes the frame components in their order
+    uint32_t numComponent = m_jpegPicParams->m_numComponent;
+    int32_t  componentIdx[jpegNumComponent];
+    if (m_encodeParams.dwNumSlices > 1)
+    {
+        numComponent = scanParams->m_numComponent;
+    }
+    CODECHAL_ENCODE_CHK_COND_RETURN(numComponent > jpegNumComponent, "Invalid JPEG scan component number.");
+
+    for (uint32_t j = 0; j < numComponent; j++)
+    {
+        componentIdx[j] = j;
+        if (m_encodeParams.dwNumSlices > 1)
+        {
+            componentIdx[j] = GetFrameComponentIdx(scanParams->m_componentSelector[j]);
+            CODECHAL_ENCODE_CHK_COND_RETURN(componentIdx[j] < 0, "Invalid JPEG scan component.");
+        }
+    }
+
     // Size of Scan header in bytes = sos (2 bytes) + ls (2 bytes) + ns (1 byte)
     // + ss (1 byte) + se (1 byte) + ahl (1 byte) + scanComponent (2 bytes) * Number of scan components
-    uint16_t hdrSize = 8 + 2 * m_jpegPicParams->m_numComponent;
+    uint16_t hdrSize = 8 + 2 * numComponent;
 
     uint8_t *scanHeader = (uint8_t*)MOS_AllocAndZeroMemory(hdrSize);
     CODECHAL_ENCODE_CHK_NULL_RETURN(scanHeader);
@@ -523,17 +566,17 @@ MOS_STATUS CodechalEncodeJpegState::PackScanHeader(
     scanHeader += 1;
 
     // scanHeader->ns
-    *scanHeader = (uint8_t)m_jpegPicParams->m_numComponent;
+    *scanHeader = (uint8_t)numComponent;
     scanHeader += 1;
 
-    for (uint32_t j = 0; j < m_jpegPicParams->m_numComponent; j++)
+    for (uint32_t j = 0; j < numComponent; j++)
     {
-        *scanHeader = (uint8_t)m_jpegPicParams->m_componentID[j];
+        *scanHeader = (uint8_t)m_jpegPicParams->m_componentID[componentIdx[j]];
         scanHeader += 1;
 
         // For Y8 image format there is only one scan component, so scanComponent[1] and scanComponent[2] should not be added to the header
-        // scanHeader->scanComponent[j].Tdaj
-        if (j == 0)
+        // scanHeader->scanComponent[j].Tdaj, the luma tables are used for the first frame component
+        if (componentIdx[j] == 0)
         {
             *scanHeader = (uint8_t)(((m_jpegHuffmanTable->m_huffmanData[0].m_tableID & 0x0F) << 4)
                 | ((m_jpegHuffmanTable->m_huffmanData[1].m_tableID & 0x0F)));
@@ -565,6 +608,320 @@ MOS_STATUS CodechalEncodeJpegState::PackScanHeader(
     return eStatus;
 }
 
+int32_t CodechalEncodeJpegState::GetFrameComponentIdx(
+    uint8_t                         componentSelector)
+{
+    for (uint32_t i = 0; i < m_jpegPicParams->m_numComponent && i < jpegNumComponent; i++)
+    {
+        if (m_jpegPicParams->m_componentID[i] == componentSelector)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+MOS_STATUS CodechalEncodeJpegState::CheckScanParams()
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+
+    uint32_t numScans = m_encodeParams.dwNumSlices;
+    CODECHAL_ENCODE_CHK_COND_RETURN(numScans == 0 || numScans > CODECHAL_ENCODE_MAX_SCANS, "Invalid JPEG scan number.");
+
+    // A single scan codes every frame component
+    if (numScans == 1)
+    {
+        return eStatus;
+    }
+
+    CODECHAL_ENCODE_CHK_COND_RETURN(m_jpegPicParams->m_progressive, "Progressive JPEG encode is not supported.");
+    CODECHAL_ENCODE_CHK_COND_RETURN(m_fullHeaderInAppData, "JPEG scan headers of several scans can't be in application data.");
+
+    uint32_t codedComponents = 0;
+    for (uint32_t scanCount = 0; scanCount < numScans; scanCount++)
+    {
+        CodecEncodeJpegScanHeader *scanParams = &m_jpegScanParams[scanCount];
+        CODECHAL_ENCODE_CHK_COND_RETURN(scanParams->m_numComponent == 0 || scanParams->m_numComponent > jpegNumComponent,
+            "Invalid JPEG scan component number.");
+
+        for (uint32_t j = 0; j < scanParams->m_numComponent; j++)
+        {
+            int32_t componentIdx = GetFrameComponentIdx(scanParams->m_componentSelector[j]);
+            CODECHAL_ENCODE_CHK_COND_RETURN(componentIdx < 0, "Invalid JPEG scan component.");
+            CODECHAL_ENCODE_CHK_COND_RETURN(codedComponents & (1 << componentIdx), "JPEG component is coded by several scans.");
+            codedComponents |= (1 << componentIdx);
+        }
+    }
+
+    CODECHAL_ENCODE_CHK_COND_RETURN(codedComponents != (uint32_t)((1 << m_jpegPicParams->m_numComponent) - 1),
+        "JPEG component is not coded by any scan.");
+
+    return eStatus;
+}
+
+uint32_t CodechalEncodeJpegState::GetScanMcuCount(
+    CodecEncodeJpegScanHeader       *scanParams)
+{
+    if (m_encodeParams.dwNumSlices == 1 || scanParams->m_numComponent != 1)
+    {
+        return 0;
+    }
+
+    // The blocks of a chroma component are subsampled like the luma MCU
+    uint32_t width  = m_jpegPicParams->m_picWidth;
+    uint32_t height = m_jpegPicParams->m_picHeight;
+    if (GetFrameComponentIdx(scanParams->m_componentSelector[0]) > 0)
+    {
+        CodecEncodeJpegInputSurfaceFormat format = (CodecEncodeJpegInputSurfaceFormat)m_jpegPicParams->m_inputSurfaceFormat;
+        width  = MOS_ROUNDUP_DIVIDE(width, m_mfxInterface->GetJpegHorizontalSamplingFactorForY(format));
+        height = MOS_ROUNDUP_DIVIDE(height, m_mfxInterface->GetJpegVerticalSamplingFactorForY(format));
+    }
+
+    return MOS_ROUNDUP_DIVIDE(width, 8) * MOS_ROUNDUP_DIVIDE(height, 8);
+}
+
+MOS_STATUS CodechalEncodeJpegState::ReadScanStatus(
+    PMOS_COMMAND_BUFFER             cmdBuffer,
+    uint32_t                        scanIdx)
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+
+    CODECHAL_ENCODE_CHK_NULL_RETURN(cmdBuffer);
+    CODECHAL_ENCODE_CHK_COND_RETURN(scanIdx >= CODECHAL_ENCODE_MAX_SCANS, "Invalid JPEG scan index.");
+    CODECHAL_ENCODE_CHK_COND_RETURN((m_vdboxIndex > m_mfxInterface->GetMaxVdboxIndex()), "ERROR - vdbox index exceed the maximum");
+
+    MmioRegistersMfx *mmioRegisters = m_hwInterface->SelectVdboxAndGetMmioRegister(m_vdboxIndex, cmdBuffer);
+    CODECHAL_ENCODE_CHK_NULL_RETURN(mmioRegisters);
+
+    uint32_t baseOffset =
+        (m_encodeStatusBuf.wCurrIndex * m_encodeStatusBuf.dwReportSize) +
+        sizeof(uint32_t) * 2;  // pEncodeStatus is offset by 2 DWs in the resource
+
+    MHW_MI_FLUSH_DW_PARAMS flushDwParams;
+    MOS_ZeroMemory(&flushDwParams, sizeof(flushDwParams));
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(m_miInterface->AddMiFlushDwCmd(cmdBuffer, &flushDwParams));
+
+    MHW_MI_STORE_REGISTER_MEM_PARAMS miStoreRegMemParams;
+    MOS_ZeroMemory(&miStoreRegMemParams, sizeof(miStoreRegMemParams));
+    miStoreRegMemParams.presStoreBuffer = &m_encodeStatusBuf.resStatusBuffer;
+    miStoreRegMemParams.dwOffset        = baseOffset + m_encodeStatusBuf.dwBSByteCountPerScanOffset + scanIdx * sizeof(uint32_t);
+    miStoreRegMemParams.dwRegister      = mmioRegisters->mfcBitstreamBytecountFrameRegOffset;
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(m_miInterface->AddMiStoreRegisterMemCmd(cmdBuffer, &miStoreRegMemParams));
+
+    return eStatus;
+}
+
+MOS_STATUS CodechalEncodeJpegState::SetQuantTableState(
+    bool                            useSingleDefaultQuantTable,
+    uint32_t                        &numQuantTables)
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+
+    CODECHAL_ENCODE_CHK_NULL_RETURN(m_jpegPicParams);
+    CODECHAL_ENCODE_CHK_NULL_RETURN(m_jpegQuantTables);
+
+    numQuantTables = JPEG_MAX_NUM_QUANT_TABLE_INDEX;
+
+    // For monochrome inputs there will be only 1 quantization table sent
+    if (m_jpegPicParams->m_inputSurfaceFormat == codechalJpegY8)
+    {
+        numQuantTables = 1;
+    }
+    // If there is only 1 quantization table copy over the table to 2nd and 3rd table in JPEG state (used for frame header)
+    // OR For RGB input surfaces, if the app does not send quantization tables, then use luma quant table for all 3 components
+    else if (m_jpegPicParams->m_numQuantTable == 1 || useSingleDefaultQuantTable)
+    {
+        for (auto i = 1; i < JPEG_MAX_NUM_QUANT_TABLE_INDEX; i++)
+        {
+            m_jpegQuantTables->m_quantTable[i].m_precision = m_jpegQuantTables->m_quantTable[0].m_precision;
+            m_jpegQuantTables->m_quantTable[i].m_tableID = m_jpegQuantTables->m_quantTable[0].m_tableID;
+
+            eStatus = MOS_SecureMemcpy(&m_jpegQuantTables->m_quantTable[i].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t),
+                &m_jpegQuantTables->m_quantTable[0].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t));
+            if (eStatus != MOS_STATUS_SUCCESS)
+            {
+                CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
+                return eStatus;
+            }
+        }
+    }
+    // If there are 2 quantization tables copy over the second table to 3rd table in JPEG state since U and V share the same table (used for frame header)
+    else if (m_jpegPicParams->m_numQuantTable == 2)
+    {
+        m_jpegQuantTables->m_quantTable[2].m_precision    = m_jpegQuantTables->m_quantTable[1].m_precision;
+        m_jpegQuantTables->m_quantTable[2].m_tableID      = m_jpegQuantTables->m_quantTable[1].m_tableID;
+
+        eStatus = MOS_SecureMemcpy(&m_jpegQuantTables->m_quantTable[2].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t),
+            &m_jpegQuantTables->m_quantTable[1].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t));
+        if (eStatus != MOS_STATUS_SUCCESS)
+        {
+            CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
+            return eStatus;
+        }
+    }
+    // else 3 quantization tables are sent by the application for non monochrome input formats. In that case, do nothing.
+
+    // Since there is no U and V in monochrome format, no quantization table header is added for U and V components
+    uint32_t numHeaders = (useSingleDefaultQuantTable || m_jpegPicParams->m_inputSurfaceFormat == codechalJpegY8) ?
+        1 : JPEG_MAX_NUM_QUANT_TABLE_INDEX;
+
+    bool reuse = m_quantTableState.m_valid &&
+        m_quantTableState.m_numQuantTables == numQuantTables &&
+        m_quantTableState.m_numHeaders == numHeaders &&
+        memcmp(&m_quantTableState.m_quantTables.m_quantTable[0], &m_jpegQuantTables->m_quantTable[0],
+            numQuantTables * sizeof(m_jpegQuantTables->m_quantTable[0])) == 0;
+    reuse = reuse && !m_tableReuseDisabled;
+    if (reuse)
+    {
+        return eStatus;
+    }
+
+    m_quantTableState.m_valid = false;
+    MOS_ZeroMemory(&m_quantTableState.m_quantMatrix, sizeof(m_quantTableState.m_quantMatrix));
+
+    for (uint32_t i = 0; i < numQuantTables; i++)
+    {
+        m_quantTableState.m_quantMatrix.m_jpegQMTableType[i] = m_jpegQuantTables->m_quantTable[i].m_tableID; // Used to distinguish between Y,U,V quantization tables for the same scan
+
+        for (auto j = 0; j < JPEG_NUM_QUANTMATRIX; j++)
+        {
+            uint32_t k = jpeg_qm_scan_8x8[j];
+
+            // copy over Quant matrix in raster order from zig zag
+            m_quantTableState.m_quantMatrix.m_quantMatrix[i][k] = (uint8_t)m_jpegQuantTables->m_quantTable[i].m_qm[j];
+        }
+    }
+
+    for (uint32_t i = 0; i < numHeaders; i++)
+    {
+        BSBuffer buffer;
+        MOS_ZeroMemory(&buffer, sizeof(buffer));
+
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(PackQuantTable(&buffer, (CodecJpegComponents)i));
+        eStatus = MOS_SecureMemcpy(&m_quantTableState.m_headers[i], sizeof(m_quantTableState.m_headers[i]),
+            buffer.pBase, sizeof(CodechalEncodeJpegQuantHeader));
+        m_quantTableState.m_headerBitSize[i] = buffer.BufferSize;
+        MOS_FreeMemory(buffer.pBase);
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(eStatus);
+    }
+
+    m_quantTableState.m_quantTables    = *m_jpegQuantTables;
+    m_quantTableState.m_numQuantTables = numQuantTables;
+    m_quantTableState.m_numHeaders     = numHeaders;
+    m_quantTableState.m_valid          = true;
+
+    return eStatus;
+}
+
+MOS_STATUS CodechalEncodeJpegState::SetHuffTableState()
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
+
+    CODECHAL_ENCODE_CHK_NULL_RETURN(m_jpegHuffmanTable);
+
+    uint32_t numHuffBuffers = m_encodeParams.dwNumHuffBuffers;
+    if (numHuffBuffers > JPEG_NUM_ENCODE_HUFF_BUFF)
+    {
+        CODECHAL_ENCODE_ASSERTMESSAGE("Too many Huffman tables.");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    bool reuse = m_huffTableState.m_valid &&
+        m_huffTableState.m_numHuffBuffers == numHuffBuffers &&
+        memcmp(&m_huffTableState.m_huffmanData[0], &m_jpegHuffmanTable->m_huffmanData[0],
+            numHuffBuffers * sizeof(m_jpegHuffmanTable->m_huffmanData[0])) == 0;
+    reuse = reuse && !m_tableReuseDisabled;
+    if (reuse)
+    {
+        return eStatus;
+    }
+
+    m_huffTableState.m_valid = false;
+    MOS_ZeroMemory(&m_huffTableState.m_huffTableParams, sizeof(m_huffTableState.m_huffTableParams));
+
+    // We need a different params struct for JPEG Encode Huffman table because JPEG decode huffman table has Bits and codes,
+    // whereas JPEG encode huffman table has huffman code lengths and values
+    MHW_VDBOX_ENCODE_HUFF_TABLE_PARAMS *huffTableParams = m_huffTableState.m_huffTableParams;
+    for (uint32_t i = 0; i < numHuffBuffers; i++)
+    {
+        uint32_t tableID = m_jpegHuffmanTable->m_huffmanData[i].m_tableID;
+        if (tableID >= JPEG_MAX_NUM_HUFF_TABLE_INDEX)
+        {
+            CODECHAL_ENCODE_ASSERTMESSAGE("Invalid Huffman table ID.");
+            return MOS_STATUS_INVALID_PARAMETER;
+        }
+
+        CodechalEncodeJpegHuffTable huffmanTable;// intermediate table for each AC/DC component which will be copied to huffTableParams
+        MOS_ZeroMemory(&huffmanTable, sizeof(huffmanTable));
+
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(ConvertHuffDataToTable(m_jpegHuffmanTable->m_huffmanData[i], &huffmanTable));
+
+        huffTableParams[tableID].HuffTableID = tableID;
+
+        if (m_jpegHuffmanTable->m_huffmanData[i].m_tableClass == 0) // DC table
+        {
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(
+                huffTableParams[tableID].pDCCodeValues,
+                JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint16_t),
+                &huffmanTable.m_huffCode,
+                JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint16_t)));
+
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[tableID].pDCCodeLength,
+                JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint8_t),
+                &huffmanTable.m_huffSize,
+                JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint8_t)));
+        }
+        else // AC Table
+        {
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[tableID].pACCodeValues,
+                JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint16_t),
+                &huffmanTable.m_huffCode,
+                JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint16_t)));
+
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[tableID].pACCodeLength,
+                JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint8_t),
+                &huffmanTable.m_huffSize,
+                JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint8_t)));
+        }
+
+        BSBuffer buffer;
+        MOS_ZeroMemory(&buffer, sizeof(buffer));
+
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(PackHuffmanTable(&buffer, i));
+        eStatus = MOS_SecureMemcpy(&m_huffTableState.m_headers[i], sizeof(m_huffTableState.m_headers[i]),
+            buffer.pBase, sizeof(CodechalJpegHuffmanHeader));
+        m_huffTableState.m_headerBitSize[i] = buffer.BufferSize;
+        MOS_FreeMemory(buffer.pBase);
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(eStatus);
+    }
+
+    MOS_SecureMemcpy(&m_huffTableState.m_huffmanData[0], sizeof(m_huffTableState.m_huffmanData),
+        &m_jpegHuffmanTable->m_huffmanData[0], numHuffBuffers * sizeof(m_jpegHuffmanTable->m_huffmanData[0]));
+    m_huffTableState.m_numHuffBuffers = numHuffBuffers;
+    m_huffTableState.m_valid          = true;
+
+    return eStatus;
+}
+
+void CodechalEncodeJpegState::SetPackedHeader(
+    BSBuffer                        *buffer,
+    void                            *header,
+    uint32_t                        bitSize)
+{
+    buffer->pBase       = (uint8_t *)header;
+    buffer->BitOffset   = 0;
+    buffer->BufferSize  = bitSize;
+}
+
 MOS_STATUS CodechalEncodeJpegState::ExecutePictureLevel()
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
@@ -625,8 +982,11 @@ MOS_STATUS CodechalEncodeJpegState::ExecutePictureLevel()
     jpegPicState.pJpegEncodePicParams   = m_jpegPicParams;
     jpegPicState.mode                   = m_mode;
 
-    // Send command buffer header at the beginning (OS dependent)
-    CODECHAL_ENCODE_CHK_STATUS_RETURN(SendPrologWithFrameTracking(&cmdBuffer, true));
+    // Send command buffer header at the beginning (OS dependent), once for the pictures of a batch
+    if (IsFirstPictureInBatch())
+    {
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(SendPrologWithFrameTracking(&cmdBuffer, true));
+    }
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(StartStatusReport(&cmdBuffer, CODECHAL_NUM_MEDIA_STATES));
 
@@ -654,11 +1014,6 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
     MOS_COMMAND_BUFFER cmdBuffer;
     CODECHAL_ENCODE_CHK_STATUS_RETURN(m_osInterface->pfnGetCommandBuffer(m_osInterface, &cmdBuffer, 0));
 
-    if (m_encodeParams.dwNumSlices != 1)
-    {
-        CODECHAL_ENCODE_ASSERTMESSAGE("JPEG encode only one scan is supported.");
-    }
-
     MOS_SURFACE *surface = &m_rawSurface;
 
     bool useSingleDefaultQuantTable = (m_jpegQuantMatrixSent == false &&
@@ -667,168 +1022,91 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
                                         (surface->Format == Format_A8B8G8R8) ||
                                         (surface->Format == Format_X8B8G8R8)));
 
-    CodecJpegQuantMatrix *tempJpegQuantMatrix = (CodecJpegQuantMatrix *)MOS_AllocAndZeroMemory(sizeof(CodecJpegQuantMatrix));
-    CODECHAL_ENCODE_CHK_NULL_RETURN(tempJpegQuantMatrix);
-
     uint32_t numQuantTables = JPEG_MAX_NUM_QUANT_TABLE_INDEX;
-    for (uint32_t scanCount = 0; scanCount < m_encodeParams.dwNumSlices; scanCount++)
-    {
-        MHW_VDBOX_QM_PARAMS fqmParams;
-        MOS_ZeroMemory(&fqmParams, sizeof(fqmParams));
-
-        // set MFX_FQM_STATE
-        fqmParams.pJpegQuantMatrix = tempJpegQuantMatrix;
 
-        // For monochrome inputs there will be only 1 quantization table and huffman table sent
-        if (m_jpegPicParams->m_inputSurfaceFormat == codechalJpegY8)
-        {
-            numQuantTables = 1;
-            m_encodeParams.dwNumHuffBuffers = 2; //for Y8 only 2 huff tables
-        }
-        // If there is only 1 quantization table copy over the table to 2nd and 3rd table in JPEG state (used for frame header)
-        // OR For RGB input surfaces, if the app does not send quantization tables, then use luma quant table for all 3 components
-        else if (m_jpegPicParams->m_numQuantTable == 1 || useSingleDefaultQuantTable)
-        {
-            for (auto i = 1; i < JPEG_MAX_NUM_QUANT_TABLE_INDEX; i++)
-            {
-                m_jpegQuantTables->m_quantTable[i].m_precision = m_jpegQuantTables->m_quantTable[0].m_precision;
-                m_jpegQuantTables->m_quantTable[i].m_tableID = m_jpegQuantTables->m_quantTable[0].m_tableID;
+    // For monochrome inputs there will be only 1 quantization table and huffman table sent
+    if (m_jpegPicParams->m_inputSurfaceFormat == codechalJpegY8)
+    {
+        m_encodeParams.dwNumHuffBuffers = 2; //for Y8 only 2 huff tables
+    }
 
-                eStatus = MOS_SecureMemcpy(&m_jpegQuantTables->m_quantTable[i].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t),
-                    &m_jpegQuantTables->m_quantTable[0].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t));
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
-                    return eStatus;
-                }
-            }
-        }
-        // If there are 2 quantization tables copy over the second table to 3rd table in JPEG state since U and V share the same table (used for frame header)
-        else if (m_jpegPicParams->m_numQuantTable == 2)
-        {
-            m_jpegQuantTables->m_quantTable[2].m_precision    = m_jpegQuantTables->m_quantTable[1].m_precision;
-            m_jpegQuantTables->m_quantTable[2].m_tableID      = m_jpegQuantTables->m_quantTable[1].m_tableID;
+    // The tables of the frame are shared by its scans
+    // set MFX_FQM_STATE
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(SetQuantTableState(useSingleDefaultQuantTable, numQuantTables));
 
-            eStatus = MOS_SecureMemcpy(&m_jpegQuantTables->m_quantTable[2].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t),
-                &m_jpegQuantTables->m_quantTable[1].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t));
-            if (eStatus != MOS_STATUS_SUCCESS)
-            {
-                CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
-                return eStatus;
-            }
+    MHW_VDBOX_QM_PARAMS fqmParams;
+    MOS_ZeroMemory(&fqmParams, sizeof(fqmParams));
+    fqmParams.pJpegQuantMatrix = &m_quantTableState.m_quantMatrix;
 
-        }
-        // else 3 quantization tables are sent by the application for non monochrome input formats. In that case, do nothing.
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxJpegFqmCmd(&cmdBuffer, &fqmParams, numQuantTables));
 
-        for (uint32_t i = 0; i < numQuantTables; i++)
-        {
-            fqmParams.pJpegQuantMatrix->m_jpegQMTableType[i] = m_jpegQuantTables->m_quantTable[i].m_tableID; // Used to distinguish between Y,U,V quantization tables for the same scan
+    // set MFC_JPEG_HUFF_TABLE - Convert encoded huffman table to actual table for HW
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(SetHuffTableState());
+    MHW_VDBOX_ENCODE_HUFF_TABLE_PARAMS *huffTableParams = m_huffTableState.m_huffTableParams;
 
-            for (auto j = 0; j < JPEG_NUM_QUANTMATRIX; j++)
-            {
-                uint32_t k = jpeg_qm_scan_8x8[j];
-
-                // copy over Quant matrix in raster order from zig zag
-                fqmParams.pJpegQuantMatrix->m_quantMatrix[i][k] = (uint8_t)m_jpegQuantTables->m_quantTable[i].m_qm[j];
-            }
-        }
-
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxJpegFqmCmd(&cmdBuffer, &fqmParams, numQuantTables));
+    // Send 2 huffman table commands - 1 for Luma and one for chroma for non-monchrome input formats
+    // If only one table is sent by the app (2 buffers), send the same table for Luma and chroma
+    bool repeatHuffTable = false;
+    if ((m_encodeParams.dwNumHuffBuffers / 2 < JPEG_MAX_NUM_HUFF_TABLE_INDEX)
+        && (m_jpegPicParams->m_inputSurfaceFormat != codechalJpegY8))
+    {
+        repeatHuffTable = true;
 
-        // set MFC_JPEG_HUFF_TABLE - Convert encoded huffman table to actual table for HW
-        // We need a different params struct for JPEG Encode Huffman table because JPEG decode huffman table has Bits and codes,
-        // whereas JPEG encode huffman table has huffman code lengths and values
-        MHW_VDBOX_ENCODE_HUFF_TABLE_PARAMS   huffTableParams[JPEG_MAX_NUM_HUFF_TABLE_INDEX];
+        // Copy over huffman data to the other two data buffers for JPEG picture header
         for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers; i++)
         {
-            CodechalEncodeJpegHuffTable huffmanTable;// intermediate table for each AC/DC component which will be copied to huffTableParams
-            MOS_ZeroMemory(&huffmanTable, sizeof(huffmanTable));
-
-            CODECHAL_ENCODE_CHK_STATUS_RETURN(ConvertHuffDataToTable(m_jpegHuffmanTable->m_huffmanData[i], &huffmanTable));
-
-            huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].HuffTableID = m_jpegHuffmanTable->m_huffmanData[i].m_tableID;
+            m_jpegHuffmanTable->m_huffmanData[i + 2].m_tableClass = m_jpegHuffmanTable->m_huffmanData[i].m_tableClass;
+            m_jpegHuffmanTable->m_huffmanData[i + 2].m_tableID    = m_jpegHuffmanTable->m_huffmanData[i].m_tableID;
 
-            if (m_jpegHuffmanTable->m_huffmanData[i].m_tableClass == 0) // DC table
-            {
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(
-                    huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].pDCCodeValues,
-                    JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint16_t),
-                    &huffmanTable.m_huffCode,
-                    JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint16_t)));
-
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].pDCCodeLength,
-                    JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint8_t),
-                    &huffmanTable.m_huffSize,
-                    JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint8_t)));
-            }
-            else // AC Table
+            eStatus = MOS_SecureMemcpy(&m_jpegHuffmanTable->m_huffmanData[i + 2].m_bits[0],
+                sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_BITS,
+                &m_jpegHuffmanTable->m_huffmanData[i].m_bits[0],
+                sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_BITS);
+            if (eStatus != MOS_STATUS_SUCCESS)
             {
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].pACCodeValues,
-                    JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint16_t),
-                    &huffmanTable.m_huffCode,
-                    JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint16_t)));
-
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].pACCodeLength,
-                    JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint8_t),
-                    &huffmanTable.m_huffSize,
-                    JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint8_t)));
+                CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
+                return eStatus;
             }
-        }
 
-        // Send 2 huffman table commands - 1 for Luma and one for chroma for non-monchrome input formats
-        // If only one table is sent by the app (2 buffers), send the same table for Luma and chroma
-        bool repeatHuffTable = false;
-        if ((m_encodeParams.dwNumHuffBuffers / 2 < JPEG_MAX_NUM_HUFF_TABLE_INDEX)
-            && (m_jpegPicParams->m_inputSurfaceFormat != codechalJpegY8))
-        {
-            repeatHuffTable = true;
-
-            // Copy over huffman data to the other two data buffers for JPEG picture header
-            for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers; i++)
+            eStatus = MOS_SecureMemcpy(&m_jpegHuffmanTable->m_huffmanData[i + 2].m_huffVal[0],
+                sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_HUFFVAL,
+                &m_jpegHuffmanTable->m_huffmanData[i].m_huffVal[0],
+                sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_HUFFVAL);
+            if (eStatus != MOS_STATUS_SUCCESS)
             {
-                m_jpegHuffmanTable->m_huffmanData[i + 2].m_tableClass = m_jpegHuffmanTable->m_huffmanData[i].m_tableClass;
-                m_jpegHuffmanTable->m_huffmanData[i + 2].m_tableID    = m_jpegHuffmanTable->m_huffmanData[i].m_tableID;
-
-                eStatus = MOS_SecureMemcpy(&m_jpegHuffmanTable->m_huffmanData[i + 2].m_bits[0],
-                    sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_BITS,
-                    &m_jpegHuffmanTable->m_huffmanData[i].m_bits[0],
-                    sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_BITS);
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
-                    return eStatus;
-                }
-
-                eStatus = MOS_SecureMemcpy(&m_jpegHuffmanTable->m_huffmanData[i + 2].m_huffVal[0],
-                    sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_HUFFVAL,
-                    &m_jpegHuffmanTable->m_huffmanData[i].m_huffVal[0],
-                    sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_HUFFVAL);
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
-                    return eStatus;
-                }
+                CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
+                return eStatus;
             }
         }
+    }
 
-        // the number of huffman commands is half of the huffman buffers sent by the app, since AC and DC buffers are combined into one command
-        for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers / 2; i++)
+    // the number of huffman commands is half of the huffman buffers sent by the app, since AC and DC buffers are combined into one command
+    for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers / 2; i++)
+    {
+        if (repeatHuffTable)
         {
-            if (repeatHuffTable)
-            {
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfcJpegHuffTableStateCmd(&cmdBuffer, &huffTableParams[i]));
-            }
-
             CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfcJpegHuffTableStateCmd(&cmdBuffer, &huffTableParams[i]));
         }
 
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfcJpegHuffTableStateCmd(&cmdBuffer, &huffTableParams[i]));
+    }
+
+    for (uint32_t scanCount = 0; scanCount < m_encodeParams.dwNumSlices; scanCount++)
+    {
+        CodecEncodeJpegScanHeader *scanParams = &m_jpegScanParams[scanCount];
+        bool firstScan = (scanCount == 0);
+        bool lastScan  = (scanCount + 1 == m_encodeParams.dwNumSlices);
+
         // set MFC_JPEG_SCAN_OBJECT
         MhwVdboxJpegScanParams scanObjectParams;
+        MOS_ZeroMemory(&scanObjectParams, sizeof(scanObjectParams));
         scanObjectParams.mode                   = m_mode;
         scanObjectParams.inputSurfaceFormat     = (CodecEncodeJpegInputSurfaceFormat)m_jpegPicParams->m_inputSurfaceFormat;
         scanObjectParams.dwPicWidth             = m_jpegPicParams->m_picWidth;
         scanObjectParams.dwPicHeight            = m_jpegPicParams->m_picHeight;
-        scanObjectParams.pJpegEncodeScanParams  = m_jpegScanParams;
+        scanObjectParams.pJpegEncodeScanParams  = scanParams;
+        scanObjectParams.dwMcuCount             = GetScanMcuCount(scanParams);
+        scanObjectParams.isLastScan             = lastScan;
 
         CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfcJpegScanObjCmd(&cmdBuffer, &scanObjectParams));
         // set MFC_JPEG_PAK_INSERT_OBJECT
@@ -838,7 +1116,8 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
         // The largest component written through the MFC_JPEG_PAK_INSERT_OBJECT command is Huffman table
         pakInsertObjectParams.pBsBuffer = (BSBuffer *)MOS_AllocAndZeroMemory(sizeof(CodechalEncodeJpegFrameHeader));
         CODECHAL_ENCODE_CHK_NULL_RETURN(pakInsertObjectParams.pBsBuffer);
-        if(!m_fullHeaderInAppData)
+        // The frame headers precede the first scan
+        if (firstScan && !m_fullHeaderInAppData)
         {
             // Add SOI (0xFFD8) (only if it was sent by the application)
             CODECHAL_ENCODE_CHK_STATUS_RETURN(PackSOI(pakInsertObjectParams.pBsBuffer));
@@ -851,7 +1130,7 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
             MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
         }
         // Add Application data if it was sent by application
-        if (m_applicationData != nullptr)
+        if (firstScan && m_applicationData != nullptr)
         {
             uint8_t* appDataChunk = nullptr;
             uint32_t appDataChunkSize = m_appDataSize;
@@ -927,47 +1206,19 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
 
             MOS_FreeMemory(appDataChunk);
         }
-        if(!m_fullHeaderInAppData)
+        if (firstScan && !m_fullHeaderInAppData)
         {
-        // Add Quant Table for Y
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(PackQuantTable(pakInsertObjectParams.pBsBuffer, jpegComponentY));
-
-        pakInsertObjectParams.dwOffset                      = 0;
-        pakInsertObjectParams.dwBitSize                     = pakInsertObjectParams.pBsBuffer->BufferSize;
-        pakInsertObjectParams.bLastHeader                   = false;
-        pakInsertObjectParams.bEndOfSlice                   = false;
-        pakInsertObjectParams.bResetBitstreamStartingPos    = 1; // from discussion with HW Architect
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
-            &pakInsertObjectParams));
-        MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
-
-        if (!useSingleDefaultQuantTable)
+        // Add Quant Table for Y, and for U and V unless a single table is used or the format is monochrome
+        for (uint32_t i = 0; i < m_quantTableState.m_numHeaders; i++)
         {
-            // Since there is no U and V in monochrome format, donot add Quantization table header for U and V components
-            if (m_jpegPicParams->m_inputSurfaceFormat != codechalJpegY8)
-            {
-                // Add quant table for U
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(PackQuantTable(pakInsertObjectParams.pBsBuffer, jpegComponentU));
-                pakInsertObjectParams.dwOffset                      = 0;
-                pakInsertObjectParams.dwBitSize                     = pakInsertObjectParams.pBsBuffer->BufferSize;
-                pakInsertObjectParams.bLastHeader                   = false;
-                pakInsertObjectParams.bEndOfSlice                   = false;
-                pakInsertObjectParams.bResetBitstreamStartingPos    = 1; // from discussion with HW Architect
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
-                    &pakInsertObjectParams));
-                MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
-
-                // Add quant table for V
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(PackQuantTable(pakInsertObjectParams.pBsBuffer, jpegComponentV));
-                pakInsertObjectParams.dwOffset                      = 0;
-                pakInsertObjectParams.dwBitSize                     = pakInsertObjectParams.pBsBuffer->BufferSize;
-                pakInsertObjectParams.bLastHeader                   = false;
-                pakInsertObjectParams.bEndOfSlice                   = false;
-                pakInsertObjectParams.bResetBitstreamStartingPos    = 1; // from discussion with HW Architect
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
-                    &pakInsertObjectParams));
-                MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
-            }
+            SetPackedHeader(pakInsertObjectParams.pBsBuffer, &m_quantTableState.m_headers[i], m_quantTableState.m_headerBitSize[i]);
+            pakInsertObjectParams.dwOffset                      = 0;
+            pakInsertObjectParams.dwBitSize                     = pakInsertObjectParams.pBsBuffer->BufferSize;
+            pakInsertObjectParams.bLastHeader                   = false;
+            pakInsertObjectParams.bEndOfSlice                   = false;
+            pakInsertObjectParams.bResetBitstreamStartingPos    = 1; // from discussion with HW Architect
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
+                &pakInsertObjectParams));
         }
 
         // Add Frame Header
@@ -984,7 +1235,7 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
         // Add Huffman Table for Y - DC table, Y- AC table, U/V - DC table, U/V - AC table
         for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers; i++)
         {
-            CODECHAL_ENCODE_CHK_STATUS_RETURN(PackHuffmanTable(pakInsertObjectParams.pBsBuffer, i));
+            SetPackedHeader(pakInsertObjectParams.pBsBuffer, &m_huffTableState.m_headers[i], m_huffTableState.m_headerBitSize[i]);
             pakInsertObjectParams.dwOffset                      = 0;
             pakInsertObjectParams.dwBitSize                     = pakInsertObjectParams.pBsBuffer->BufferSize;
             pakInsertObjectParams.bLastHeader                   = false;
@@ -992,13 +1243,16 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
             pakInsertObjectParams.bResetBitstreamStartingPos    = 1; // from discussion with HW Architect
             CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
                 &pakInsertObjectParams));
-            MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
+        }
         }
 
-        // Restart Interval - Add only if the restart interval is not zero
-        if (m_jpegScanParams->m_restartInterval != 0)
+        if (!m_fullHeaderInAppData)
         {
-            CODECHAL_ENCODE_CHK_STATUS_RETURN(PackRestartInterval(pakInsertObjectParams.pBsBuffer));
+        // Restart Interval - Add only if the restart interval is not zero, or if it changes between scans
+        if ((firstScan && scanParams->m_restartInterval != 0) ||
+            (!firstScan && scanParams->m_restartInterval != m_jpegScanParams[scanCount - 1].m_restartInterval))
+        {
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(PackRestartInterval(pakInsertObjectParams.pBsBuffer, scanParams));
             pakInsertObjectParams.dwOffset                      = 0;
             pakInsertObjectParams.dwBitSize                     = pakInsertObjectParams.pBsBuffer->BufferSize;
             pakInsertObjectParams.bLastHeader                   = false;
@@ -1010,7 +1264,7 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
         }
 
         // Add scan header
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(PackScanHeader(pakInsertObjectParams.pBsBuffer));
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(PackScanHeader(pakInsertObjectParams.pBsBuffer, scanParams));
         pakInsertObjectParams.dwOffset                      = 0;
         pakInsertObjectParams.dwBitSize                     = pakInsertObjectParams.pBsBuffer->BufferSize;
         pakInsertObjectParams.bLastHeader                   = true;
@@ -1021,12 +1275,25 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
         MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
         }
         MOS_FreeMemory(pakInsertObjectParams.pBsBuffer);
+
+        // The status report gives where each scan ends
+        if (!lastScan)
+        {
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(ReadScanStatus(&cmdBuffer, scanCount));
+        }
     }
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(ReadMfcStatus(&cmdBuffer));
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(EndStatusReport(&cmdBuffer, CODECHAL_NUM_MEDIA_STATES));
 
+    // The next picture of a batch continues this command buffer
+    if (!IsLastPictureInBatch())
+    {
+        m_osInterface->pfnReturnCommandBuffer(m_osInterface, &cmdBuffer, 0);
+        return eStatus;
+    }
+
     CODECHAL_ENCODE_CHK_STATUS_RETURN(m_miInterface->AddMiBatchBufferEnd(&cmdBuffer, nullptr));
 
     std::string pakPassName = "PAK_PASS" + std::to_string(static_cast<uint32_t>(m_currPass));
@@ -1045,21 +1312,20 @@ MOS_STATUS CodechalEncodeJpegState::ExecuteSliceLevel()
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(SubmitCommandBuffer(&cmdBuffer, m_renderContextUsesNullHw));
 
-    if (tempJpegQuantMatrix != nullptr)
-    {
-        MOS_FreeMemory(tempJpegQuantMatrix);
-        tempJpegQuantMatrix = nullptr;
-    }
-
     return eStatus;
 }
 
 uint32_t CodechalEncodeJpegState::CalculateCommandBufferSize()
 {
+    // The size is checked for the first picture of a batch, the others may have up to the max scans
+    uint32_t numScans = (m_encodeParams.dwBatchPicNum > 1) ? CODECHAL_ENCODE_MAX_SCANS : MOS_MAX(m_numSlices, 1);
+
     uint32_t commandBufferSize =
         m_pictureStatesSize        +
         m_extraPictureStatesSize   +
-        (m_sliceStatesSize * m_numSlices);
+        (m_sliceStatesSize * numScans) +
+        // MI_FLUSH_DW and MI_STORE_REGISTER_MEM (4 DWORDs) reading the end of each scan
+        (numScans - 1) * (m_miInterface->GetMiFlushDwCmdSize() + 4 * sizeof(uint32_t));
 
     // For JPEG encoder, add the size of PAK_INSERT_OBJ commands which is also part of command buffer
     if(m_standard == CODECHAL_JPEG)
@@ -1068,20 +1334,24 @@ uint32_t CodechalEncodeJpegState::CalculateCommandBufferSize()
         // PAK_INSERT_OBJ contains 2 DWORDS + bytes of payload data
         // There is a max of 1024 payload bytes of app data per PAK_INSERT_OBJ command, so adding 2 DWORDS for each of them
         // Total payload data is the same size as app data
-        commandBufferSize += (m_encodeParams.dwAppDataSize + (2 * sizeof(uint32_t) * (m_encodeParams.dwAppDataSize / 1020+1)));  //to be consistent with how we split app data into chunks.
+        // The pictures of a batch share the command buffer, each one splits its own app data into chunks
+        uint32_t numPics     = MOS_MAX(m_encodeParams.dwBatchPicNum, 1);
+        uint32_t appDataSize = (numPics > 1) ? m_encodeParams.dwBatchAppDataSize : m_encodeParams.dwAppDataSize;
+        commandBufferSize *= numPics;
+        commandBufferSize += (appDataSize + (2 * sizeof(uint32_t) * (appDataSize / 1020 + numPics)));  //to be consistent with how we split app data into chunks.
 
         // Add number of bytes of data added through PAK_INSERT_OBJ command
-        commandBufferSize += (2 + // SOI = 2 bytes
+        commandBufferSize += numPics * (2 + // SOI = 2 bytes
                 // Frame header - add sizes of each component of CodechalEncodeJpegFrameHeader
                 (2 * sizeof(uint8_t)) + (4 * sizeof(uint16_t)) + 3 * sizeof(uint8_t)*  jpegNumComponent +
                 // AC and DC Huffman tables - 2 Huffman tables for each component, and 3 components
                 (2 * 3 * sizeof(CodechalJpegHuffmanHeader)) +
                 // Quant tables - 1 for Quant table of each component, so 3 quant tables per frame
                 (3 * sizeof(CodechalEncodeJpegQuantHeader)) +
-                // Restart interval - 1 per frame
-                sizeof(CodechalEncodeJpegRestartHeader) +
-                // Scan header - 1 per frame
-                sizeof(CodechalEncodeJpegScanHeader));
+                // Restart interval - at most 1 per scan
+                numScans * sizeof(CodechalEncodeJpegRestartHeader) +
+                // Scan header - 1 per scan
+                numScans * sizeof(CodechalEncodeJpegScanHeader));
     }
 
     if (m_singleTaskPhaseSupported)
@@ -194,7 +194,7 @@ public:
 
     // Parameters passed by application
     CodecEncodeJpegPictureParams                *m_jpegPicParams        = nullptr;                             //!< Pointer to picture parameter
-    CodecEncodeJpegScanHeader                   *m_jpegScanParams       = nullptr;                             //!< Pointer to scan parameter
+    CodecEncodeJpegScanHeader                   *m_jpegScanParams       = nullptr;                             //!< Pointer to scan parameters, one per scan
     CodecEncodeJpegQuantTable                   *m_jpegQuantTables      = nullptr;                             //!< Pointer to quant tables
     CodecEncodeJpegHuffmanDataArray             *m_jpegHuffmanTable     = nullptr;                             //!< Pointer to Huffman table
     void                                        *m_applicationData      = nullptr;                             //!< Pointer to Application data
@@ -364,24 +364,157 @@ protected:
     //!
     //! \param    [out] buffer
     //!           Bitstream buffer
+    //! \param    [in] scanParams
+    //!           Scan the restart interval is defined for
     //!
     //! \return   MOS_STATUS
     //!           MOS_STATUS_SUCCESS if success, else fail reason
     //!
     MOS_STATUS PackRestartInterval(
-        BSBuffer                        *buffer);
+        BSBuffer                        *buffer,
+        CodecEncodeJpegScanHeader       *scanParams);
 
     //!
     //! \brief    Pack Scan Header
     //!
     //! \param    [out] buffer
     //!           Bitstream buffer
+    //! \param    [in] scanParams
+    //!           Scan to pack the header of
     //!
     //! \return   MOS_STATUS
     //!           MOS_STATUS_SUCCESS if success, else fail reason
     //!
     MOS_STATUS PackScanHeader(
-        BSBuffer                        *buffer);
+        BSBuffer                        *buffer,
+        CodecEncodeJpegScanHeader       *scanParams);
+
+    //!
+    //! \brief    Get the frame component coded by a scan component
+    //!
+    //! \param    [in] componentSelector
+    //!           Component identifier of the scan component
+    //!
+    //! \return   int32_t
+    //!           Index of the frame component, -1 if there is none
+    //!
+    int32_t GetFrameComponentIdx(
+        uint8_t                         componentSelector);
+
+    //!
+    //! \brief    Check the scans of the picture
+    //! \details  Every frame component must be coded by exactly one sequential scan,
+    //!           and the scans can only be packed by the driver.
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS CheckScanParams();
+
+    //!
+    //! \brief    Get the MCU count of a scan
+    //! \details  A scan of one component has one MCU per block of the component,
+    //!           other scans have the MCUs of the picture.
+    //!
+    //! \param    [in] scanParams
+    //!           Scan
+    //!
+    //! \return   uint32_t
+    //!           MCU count, 0 for the MCUs of the picture
+    //!
+    uint32_t GetScanMcuCount(
+        CodecEncodeJpegScanHeader       *scanParams);
+
+    //!
+    //! \brief    Store the bitstream byte count at the end of a scan in the status report
+    //!
+    //! \param    [in] cmdBuffer
+    //!           Command buffer
+    //! \param    [in] scanIdx
+    //!           Index of the scan, the last scan is read with the frame
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ReadScanStatus(
+        PMOS_COMMAND_BUFFER             cmdBuffer,
+        uint32_t                        scanIdx);
+
+    //!
+    //! \brief    Set the quantization table state of the picture
+    //! \details  Completes the quantization tables used by the frame header, then
+    //!           converts them to raster order for MFX_FQM_STATE and packs their
+    //!           headers, unless they are the same as for the previous picture.
+    //!
+    //! \param    [in] useSingleDefaultQuantTable
+    //!           The flag of using single default Quant Table
+    //! \param    [out] numQuantTables
+    //!           Number of quantization tables sent to the HW
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS SetQuantTableState(
+        bool                            useSingleDefaultQuantTable,
+        uint32_t                        &numQuantTables);
+
+    //!
+    //! \brief    Set the Huffman table state of the picture
+    //! \details  Converts the Huffman tables for MFC_JPEG_HUFF_TABLE_STATE and packs
+    //!           their headers, unless they are the same as for the previous picture.
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS SetHuffTableState();
+
+    //!
+    //! \brief    Point a bitstream buffer to a header packed by the table state
+    //!
+    //! \param    [out] buffer
+    //!           Bitstream buffer
+    //! \param    [in] header
+    //!           Packed header
+    //! \param    [in] bitSize
+    //!           Size of the header in bits
+    //!
+    void SetPackedHeader(
+        BSBuffer                        *buffer,
+        void                            *header,
+        uint32_t                        bitSize);
+
+    //!
+    //! \struct   QuantTableState
+    //! \brief    Quantization tables of the previous picture and their converted state
+    //!
+    struct QuantTableState
+    {
+        bool                            m_valid = false;                                        //!< State was built
+        uint32_t                        m_numQuantTables = 0;                                   //!< Number of quantization tables sent to the HW
+        uint32_t                        m_numHeaders = 0;                                       //!< Number of packed headers
+        CodecEncodeJpegQuantTable       m_quantTables = {};                                     //!< Quantization tables the state was built from
+        CodecJpegQuantMatrix            m_quantMatrix = {};                                     //!< Raster order matrices for MFX_FQM_STATE
+        CodechalEncodeJpegQuantHeader   m_headers[JPEG_MAX_NUM_QUANT_TABLE_INDEX] = {};         //!< Packed quantization table headers
+        uint32_t                        m_headerBitSize[JPEG_MAX_NUM_QUANT_TABLE_INDEX] = {};   //!< Size of the headers in bits
+    };
+
+    //!
+    //! \struct   HuffTableState
+    //! \brief    Huffman tables of the previous picture and their converted state
+    //!
+    struct HuffTableState
+    {
+        bool                                m_valid = false;                                            //!< State was built
+        uint32_t                            m_numHuffBuffers = 0;                                       //!< Number of Huffman tables
+        CodecEncodeJpegHuffData             m_huffmanData[JPEG_NUM_ENCODE_HUFF_BUFF] = {};              //!< Huffman tables the state was built from
+        MHW_VDBOX_ENCODE_HUFF_TABLE_PARAMS  m_huffTableParams[JPEG_MAX_NUM_HUFF_TABLE_INDEX] = {};      //!< Tables for MFC_JPEG_HUFF_TABLE_STATE
+        CodechalJpegHuffmanHeader           m_headers[JPEG_NUM_ENCODE_HUFF_BUFF] = {};                  //!< Packed Huffman table headers
+        uint32_t                            m_headerBitSize[JPEG_NUM_ENCODE_HUFF_BUFF] = {};            //!< Size of the headers in bits
+    };
+
+    QuantTableState                             m_quantTableState;                                      //!< Quantization table state
+    HuffTableState                              m_huffTableState;                                       //!< Huffman table state
+    bool                                        m_tableReuseDisabled = false;                           //!< Build the table state every picture, debug only
 };
 
 #endif //__CODECHAL_ENCODER_JPEG_H__
@@ -34,9 +34,19 @@ MOS_STATUS CodechalEncodeSwScoreboard::AllocateResources()
 
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
-    if (Mos_ResourceIsNull(&m_surfaceParams.swScoreboardSurface[m_surfaceParams.surfaceIndex].OsResource))
+    PMOS_SURFACE surface = &m_surfaceParams.swScoreboardSurface[m_surfaceParams.surfaceIndex];
+    if (!Mos_ResourceIsNull(&surface->OsResource) &&
+        (surface->dwWidth != m_surfaceParams.swScoreboardSurfaceWidth ||
+         surface->dwHeight != m_surfaceParams.swScoreboardSurfaceHeight))
     {
-        MOS_ZeroMemory(&m_surfaceParams.swScoreboardSurface[m_surfaceParams.surfaceIndex], sizeof(MOS_SURFACE));
+        // Resolution changed, the surface is allocated again with the new size
+        m_osInterface->pfnFreeResource(m_osInterface, &surface->OsResource);
+        MOS_ZeroMemory(surface, sizeof(MOS_SURFACE));
+    }
+
+    if (Mos_ResourceIsNull(&surface->OsResource))
+    {
+        MOS_ZeroMemory(surface, sizeof(MOS_SURFACE));
 
         MOS_ALLOC_GFXRES_PARAMS  allocParamsForBuffer2D;
         MOS_ZeroMemory(&allocParamsForBuffer2D, sizeof(MOS_ALLOC_GFXRES_PARAMS));
@@ -49,11 +59,11 @@ MOS_STATUS CodechalEncodeSwScoreboard::AllocateResources()
         CODECHAL_ENCODE_CHK_STATUS_MESSAGE_RETURN(m_osInterface->pfnAllocateResource(
             m_osInterface,
             &allocParamsForBuffer2D,
-            &m_surfaceParams.swScoreboardSurface[m_surfaceParams.surfaceIndex].OsResource),
+            &surface->OsResource),
             "Failed to allocate SW scoreboard init Buffer.");
 
         CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface,
-            &m_surfaceParams.swScoreboardSurface[m_surfaceParams.surfaceIndex]));
+            surface));
     }
 
     return eStatus;
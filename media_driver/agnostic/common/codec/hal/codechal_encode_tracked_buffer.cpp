@@ -45,6 +45,9 @@ MOS_STATUS CodechalEncodeTrackedBuffer::AllocateForCurrFrame()
 
     CODECHAL_ENCODE_CHK_COND_RETURN(m_trackedBufCurrIdx >= CODEC_NUM_TRACKED_BUFFERS, "No tracked buffer is available!");
 
+    // the frame using the shared DS surfaces of the slot is no longer tracked
+    ReleaseSharedSurfaceDS(m_trackedBufCurrIdx);
+
     // wait to re-use once # of non-ref slots being used reaches 3
     m_waitTrackedBuffer = (m_trackedBufCurrIdx >= CODEC_NUM_REF_BUFFERS && m_trackedBufCountNonRef >= CODEC_NUM_NON_REF_BUFFERS);
 
@@ -506,79 +509,48 @@ MOS_STATUS CodechalEncodeTrackedBuffer::ResizeSurfaceDS() {
     return eStatus;
 }
 
-MOS_STATUS CodechalEncodeTrackedBuffer::AllocateSurfaceDS()
+void CodechalEncodeTrackedBuffer::GetSurfaceDSSize(uint32_t width[], uint32_t height[])
 {
-    CODECHAL_ENCODE_FUNCTION_ENTER;
-
-    // early exit if already allocated
-    if ((m_trackedBufCurrDs4x = (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds4xSurface, m_trackedBufCurrIdx)))
-    {
-        if (m_encoder->m_16xMeSupported)
-        {
-            m_trackedBufCurrDs16x = (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds16xSurface, m_trackedBufCurrIdx);
-        }
-
-        if (m_encoder->m_32xMeSupported)
-        {
-            m_trackedBufCurrDs32x = (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds32xSurface, m_trackedBufCurrIdx);
-        }
-        return MOS_STATUS_SUCCESS;
-    }
-
-    uint32_t downscaledSurfaceWidth4x, downscaledSurfaceHeight4x;
-    uint32_t downscaledSurfaceWidth16x, downscaledSurfaceHeight16x;
-    uint32_t downscaledSurfaceWidth32x, downscaledSurfaceHeight32x;
     if (m_encoder->m_useCommonKernel)
     {
-        downscaledSurfaceWidth4x = m_encoder->m_downscaledWidth4x;
-        downscaledSurfaceHeight4x = MOS_ALIGN_CEIL(m_encoder->m_downscaledHeight4x, MOS_YTILE_H_ALIGNMENT);
-        downscaledSurfaceWidth16x = m_encoder->m_downscaledWidth16x;
-        downscaledSurfaceHeight16x = MOS_ALIGN_CEIL(m_encoder->m_downscaledHeight16x, MOS_YTILE_H_ALIGNMENT);
-        downscaledSurfaceWidth32x = m_encoder->m_downscaledWidth32x;
-        downscaledSurfaceHeight32x = MOS_ALIGN_CEIL(m_encoder->m_downscaledHeight32x, MOS_YTILE_H_ALIGNMENT);
+        width[CodechalEncodeDsShare::ds4x]   = m_encoder->m_downscaledWidth4x;
+        height[CodechalEncodeDsShare::ds4x]  = MOS_ALIGN_CEIL(m_encoder->m_downscaledHeight4x, MOS_YTILE_H_ALIGNMENT);
+        width[CodechalEncodeDsShare::ds16x]  = m_encoder->m_downscaledWidth16x;
+        height[CodechalEncodeDsShare::ds16x] = MOS_ALIGN_CEIL(m_encoder->m_downscaledHeight16x, MOS_YTILE_H_ALIGNMENT);
+        width[CodechalEncodeDsShare::ds32x]  = m_encoder->m_downscaledWidth32x;
+        height[CodechalEncodeDsShare::ds32x] = MOS_ALIGN_CEIL(m_encoder->m_downscaledHeight32x, MOS_YTILE_H_ALIGNMENT);
     }
     else
     {
         // MB-alignment not required since dataport handles out-of-bound pixel replication, but IME requires this.
-        downscaledSurfaceWidth4x = m_encoder->m_downscaledWidth4x;
+        width[CodechalEncodeDsShare::ds4x] = m_encoder->m_downscaledWidth4x;
         // Account for field case, offset needs to be 4K aligned if tiled for DI surface state.
         // Width will be allocated tile Y aligned, so also tile align height.
-        downscaledSurfaceHeight4x = ((m_encoder->m_downscaledHeight4x / CODECHAL_MACROBLOCK_HEIGHT + 1) >> 1) * CODECHAL_MACROBLOCK_HEIGHT;
-        downscaledSurfaceHeight4x = MOS_ALIGN_CEIL(downscaledSurfaceHeight4x, MOS_YTILE_H_ALIGNMENT) << 1;
+        height[CodechalEncodeDsShare::ds4x] = ((m_encoder->m_downscaledHeight4x / CODECHAL_MACROBLOCK_HEIGHT + 1) >> 1) * CODECHAL_MACROBLOCK_HEIGHT;
+        height[CodechalEncodeDsShare::ds4x] = MOS_ALIGN_CEIL(height[CodechalEncodeDsShare::ds4x], MOS_YTILE_H_ALIGNMENT) << 1;
 
-        downscaledSurfaceWidth16x = m_encoder->m_downscaledWidth16x;
-        downscaledSurfaceHeight16x = ((m_encoder->m_downscaledHeight16x / CODECHAL_MACROBLOCK_HEIGHT + 1) >> 1) * CODECHAL_MACROBLOCK_HEIGHT;
-        downscaledSurfaceHeight16x = MOS_ALIGN_CEIL(downscaledSurfaceHeight16x, MOS_YTILE_H_ALIGNMENT) << 1;
+        width[CodechalEncodeDsShare::ds16x] = m_encoder->m_downscaledWidth16x;
+        height[CodechalEncodeDsShare::ds16x] = ((m_encoder->m_downscaledHeight16x / CODECHAL_MACROBLOCK_HEIGHT + 1) >> 1) * CODECHAL_MACROBLOCK_HEIGHT;
+        height[CodechalEncodeDsShare::ds16x] = MOS_ALIGN_CEIL(height[CodechalEncodeDsShare::ds16x], MOS_YTILE_H_ALIGNMENT) << 1;
 
-        downscaledSurfaceWidth32x = m_encoder->m_downscaledWidth32x;
-        downscaledSurfaceHeight32x = ((m_encoder->m_downscaledHeight32x / CODECHAL_MACROBLOCK_HEIGHT + 1) >> 1) * CODECHAL_MACROBLOCK_HEIGHT;
-        downscaledSurfaceHeight32x = MOS_ALIGN_CEIL(downscaledSurfaceHeight32x, MOS_YTILE_H_ALIGNMENT) << 1;
+        width[CodechalEncodeDsShare::ds32x] = m_encoder->m_downscaledWidth32x;
+        height[CodechalEncodeDsShare::ds32x] = ((m_encoder->m_downscaledHeight32x / CODECHAL_MACROBLOCK_HEIGHT + 1) >> 1) * CODECHAL_MACROBLOCK_HEIGHT;
+        height[CodechalEncodeDsShare::ds32x] = MOS_ALIGN_CEIL(height[CodechalEncodeDsShare::ds32x], MOS_YTILE_H_ALIGNMENT) << 1;
     }
 
-    // allocating 4x DS surface
-    CODECHAL_ENCODE_CHK_NULL_RETURN(m_trackedBufCurrDs4x = (MOS_SURFACE*)m_allocator->AllocateResource(
-        m_standard, downscaledSurfaceWidth4x, downscaledSurfaceHeight4x, ds4xSurface, "ds4xSurface", m_trackedBufCurrIdx, false, Format_NV12, MOS_TILE_Y));
-
-    CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface, m_trackedBufCurrDs4x));
-
-    // allocate 16x DS surface
-    if (m_encoder->m_16xMeSupported)
+    if (!m_encoder->m_16xMeSupported)
     {
-        CODECHAL_ENCODE_CHK_NULL_RETURN(m_trackedBufCurrDs16x = (MOS_SURFACE*)m_allocator->AllocateResource(
-            m_standard, downscaledSurfaceWidth16x, downscaledSurfaceHeight16x, ds16xSurface, "ds16xSurface", m_trackedBufCurrIdx, false, Format_NV12, MOS_TILE_Y));
-
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface, m_trackedBufCurrDs16x));
+        width[CodechalEncodeDsShare::ds16x] = height[CodechalEncodeDsShare::ds16x] = 0;
     }
 
-    // allocate 32x DS surface
-    if (m_encoder->m_32xMeSupported)
+    if (!m_encoder->m_32xMeSupported)
     {
-        CODECHAL_ENCODE_CHK_NULL_RETURN(m_trackedBufCurrDs32x = (MOS_SURFACE*)m_allocator->AllocateResource(
-            m_standard, downscaledSurfaceWidth32x, downscaledSurfaceHeight32x, ds32xSurface, "ds32xSurface", m_trackedBufCurrIdx, false, Format_NV12, MOS_TILE_Y));
-
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface, m_trackedBufCurrDs32x));
+        width[CodechalEncodeDsShare::ds32x] = height[CodechalEncodeDsShare::ds32x] = 0;
     }
+}
 
+void CodechalEncodeTrackedBuffer::SetScaledBottomFieldOffset()
+{
     if (!m_encoder->m_fieldScalingOutputInterleaved)
     {
         // Separated scaled surfaces
@@ -608,10 +580,138 @@ MOS_STATUS CodechalEncodeTrackedBuffer::AllocateSurfaceDS()
         m_encoder->m_scaled16xBottomFieldOffset =
         m_encoder->m_scaled32xBottomFieldOffset = 0;
     }
+}
+
+MOS_STATUS CodechalEncodeTrackedBuffer::AllocateSurfaceDS()
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    // the slot uses the DS surfaces shared in the MFE context
+    CodechalEncodeDsShare::Entry *sharedDs = m_sharedDs[m_trackedBufCurrIdx];
+    if (sharedDs)
+    {
+        m_trackedBufCurrDs4x  = &sharedDs->surface[CodechalEncodeDsShare::ds4x];
+        m_trackedBufCurrDs16x = &sharedDs->surface[CodechalEncodeDsShare::ds16x];
+        m_trackedBufCurrDs32x = &sharedDs->surface[CodechalEncodeDsShare::ds32x];
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // early exit if already allocated
+    if ((m_trackedBufCurrDs4x = (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds4xSurface, m_trackedBufCurrIdx)))
+    {
+        if (m_encoder->m_16xMeSupported)
+        {
+            m_trackedBufCurrDs16x = (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds16xSurface, m_trackedBufCurrIdx);
+        }
+
+        if (m_encoder->m_32xMeSupported)
+        {
+            m_trackedBufCurrDs32x = (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds32xSurface, m_trackedBufCurrIdx);
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    uint32_t width[CodechalEncodeDsShare::dsNum], height[CodechalEncodeDsShare::dsNum];
+    GetSurfaceDSSize(width, height);
+
+    // allocating 4x DS surface
+    CODECHAL_ENCODE_CHK_NULL_RETURN(m_trackedBufCurrDs4x = (MOS_SURFACE*)m_allocator->AllocateResource(
+        m_standard, width[CodechalEncodeDsShare::ds4x], height[CodechalEncodeDsShare::ds4x], ds4xSurface, "ds4xSurface", m_trackedBufCurrIdx, false, Format_NV12, MOS_TILE_Y));
+
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface, m_trackedBufCurrDs4x));
+
+    // allocate 16x DS surface
+    if (m_encoder->m_16xMeSupported)
+    {
+        CODECHAL_ENCODE_CHK_NULL_RETURN(m_trackedBufCurrDs16x = (MOS_SURFACE*)m_allocator->AllocateResource(
+            m_standard, width[CodechalEncodeDsShare::ds16x], height[CodechalEncodeDsShare::ds16x], ds16xSurface, "ds16xSurface", m_trackedBufCurrIdx, false, Format_NV12, MOS_TILE_Y));
+
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface, m_trackedBufCurrDs16x));
+    }
+
+    // allocate 32x DS surface
+    if (m_encoder->m_32xMeSupported)
+    {
+        CODECHAL_ENCODE_CHK_NULL_RETURN(m_trackedBufCurrDs32x = (MOS_SURFACE*)m_allocator->AllocateResource(
+            m_standard, width[CodechalEncodeDsShare::ds32x], height[CodechalEncodeDsShare::ds32x], ds32xSurface, "ds32xSurface", m_trackedBufCurrIdx, false, Format_NV12, MOS_TILE_Y));
+
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface, m_trackedBufCurrDs32x));
+    }
+
+    SetScaledBottomFieldOffset();
 
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS CodechalEncodeTrackedBuffer::AllocateSharedSurfaceDS(
+    CodechalEncodeDsShare   *dsShare,
+    PMOS_SURFACE            rawSurface,
+    bool                    *shared)
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    CODECHAL_ENCODE_CHK_NULL_RETURN(dsShare);
+    CODECHAL_ENCODE_CHK_NULL_RETURN(rawSurface);
+    CODECHAL_ENCODE_CHK_NULL_RETURN(shared);
+
+    *shared = false;
+
+    if (m_dsShare == nullptr)
+    {
+        dsShare->AddUser();
+        m_dsShare = dsShare;
+    }
+    CODECHAL_ENCODE_CHK_COND_RETURN(m_dsShare != dsShare, "The encoder moved to another MFE context!");
+
+    // the slot now tracks another frame
+    ReleaseSharedSurfaceDS(m_trackedBufCurrIdx);
+
+    CodechalEncodeDsShare::Key key;
+    key.rawSurface  = rawSurface->OsResource.pGmmResInfo;
+    key.submission  = m_dsShare->GetSubmission();
+    key.standard    = m_standard;
+    key.picFlags    = m_encoder->m_currOriginalPic.PicFlags;
+    key.interleaved = m_encoder->m_fieldScalingOutputInterleaved;
+    GetSurfaceDSSize(key.width, key.height);
+
+    CodechalEncodeDsShare::Entry *entry = m_dsShare->Acquire(key);
+    *shared = (entry != nullptr);
+    if (entry == nullptr)
+    {
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_dsShare->Create(m_osInterface, key, &entry));
+        m_sharedDsToPublish = entry;
+    }
+    m_sharedDs[m_trackedBufCurrIdx] = entry;
+
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(AllocateSurfaceDS());
+    SetScaledBottomFieldOffset();
+
+    // the surfaces are written by the render context of another encoder
+    MOS_SYNC_PARAMS syncParams = g_cInitSyncParams;
+    syncParams.GpuContext = m_encoder->m_renderContext;
+    syncParams.bReadOnly  = *shared;
+    for (uint32_t i = 0; i < CodechalEncodeDsShare::dsNum; i++)
+    {
+        if (!Mos_ResourceIsNull(&entry->surface[i].OsResource))
+        {
+            syncParams.presSyncResource = &entry->surface[i].OsResource;
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(m_osInterface->pfnResourceWait(m_osInterface, &syncParams));
+            m_osInterface->pfnSetResourceSyncTag(m_osInterface, &syncParams);
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void CodechalEncodeTrackedBuffer::PublishSharedSurfaceDS()
+{
+    if (m_sharedDsToPublish)
+    {
+        m_dsShare->Publish(m_sharedDsToPublish);
+        m_sharedDsToPublish = nullptr;
+    }
+}
+
 MOS_STATUS CodechalEncodeTrackedBuffer::AllocateSurface2xDS()
 {
     CODECHAL_ENCODE_FUNCTION_ENTER;
@@ -774,6 +874,23 @@ void CodechalEncodeTrackedBuffer::ReleaseSurfaceDS(uint8_t bufIndex)
     m_allocator->ReleaseResource(m_standard, ds2xSurface, bufIndex);
     m_allocator->ReleaseResource(m_standard, ds16xSurface, bufIndex);
     m_allocator->ReleaseResource(m_standard, ds32xSurface, bufIndex);
+    ReleaseSharedSurfaceDS(bufIndex);
+}
+
+void CodechalEncodeTrackedBuffer::ReleaseSharedSurfaceDS(uint8_t bufIndex)
+{
+    CodechalEncodeDsShare::Entry *sharedDs = m_sharedDs[bufIndex];
+    if (sharedDs == nullptr)
+    {
+        return;
+    }
+
+    if (sharedDs == m_sharedDsToPublish)
+    {
+        m_sharedDsToPublish = nullptr;
+    }
+    m_sharedDs[bufIndex] = nullptr;
+    m_dsShare->Release(m_osInterface, sharedDs);
 }
 
 void CodechalEncodeTrackedBuffer::ReleaseDsRecon(uint8_t bufIndex)
@@ -804,4 +921,17 @@ CodechalEncodeTrackedBuffer::CodechalEncodeTrackedBuffer(CodechalEncoderState* e
 CodechalEncodeTrackedBuffer::~CodechalEncodeTrackedBuffer()
 {
     CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    if (m_dsShare)
+    {
+        for (uint8_t i = 0; i < CODEC_NUM_TRACKED_BUFFERS; i++)
+        {
+            ReleaseSharedSurfaceDS(i);
+        }
+
+        if (m_dsShare->RemoveUser(m_osInterface) == 0)
+        {
+            MOS_Delete(m_dsShare);
+        }
+    }
 }
@@ -34,6 +34,7 @@
 #include "codechal.h"
 #include "codechal_encode_allocator.h"
 #include "codec_def_common_encode.h"
+#include "codechal_encode_ds_share.h"
 
 //!
 //! Tracked buffer 
@@ -126,6 +127,10 @@ public:
         {
             return m_trackedBufCurrDs4x;
         }
+        else if (bufIndex < CODEC_NUM_TRACKED_BUFFERS && m_sharedDs[bufIndex])
+        {
+            return &m_sharedDs[bufIndex]->surface[CodechalEncodeDsShare::ds4x];
+        }
         else
         {
             return  (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds4xSurface, bufIndex);
@@ -160,6 +165,10 @@ public:
         {
             return m_trackedBufCurrDs16x;
         }
+        else if (bufIndex < CODEC_NUM_TRACKED_BUFFERS && m_sharedDs[bufIndex])
+        {
+            return &m_sharedDs[bufIndex]->surface[CodechalEncodeDsShare::ds16x];
+        }
         else
         {
             return  (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds16xSurface, bufIndex);
@@ -177,6 +186,10 @@ public:
         {
             return m_trackedBufCurrDs32x;
         }
+        else if (bufIndex < CODEC_NUM_TRACKED_BUFFERS && m_sharedDs[bufIndex])
+        {
+            return &m_sharedDs[bufIndex]->surface[CodechalEncodeDsShare::ds32x];
+        }
         else
         {
             return  (MOS_SURFACE*)m_allocator->GetResource(m_standard, ds32xSurface, bufIndex);
@@ -339,6 +352,31 @@ public:
     //!
     MOS_STATUS AllocateSurfaceDS();
 
+    //!
+    //! \brief    Use the DS surfaces of the raw surface shared by the encoders of a MFE context
+    //! \details  If another encoder already downscaled the raw surface in this submission,
+    //!           its surfaces are used for the current frame and the DS kernels can be
+    //!           skipped. Else shared surfaces are picked for the current frame, the caller
+    //!           downscales into them and they are published once the ENC is submitted.
+    //! \param    [in] dsShare
+    //!           DS surfaces shared by the encoders of the MFE context
+    //! \param    [in] rawSurface
+    //!           Raw surface downscaled
+    //! \param    [out] shared
+    //!           true if the surfaces are already downscaled
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AllocateSharedSurfaceDS(CodechalEncodeDsShare *dsShare, PMOS_SURFACE rawSurface, bool *shared);
+
+    //!
+    //! \brief    Make the DS surfaces downscaled for the current frame available to the other encoders
+    //!
+    //! \return   void
+    //!
+    void PublishSharedSurfaceDS();
+
     //!
     //! \brief    Allocate 2xDS surface or pick an existing one from the pool
     //!
@@ -419,6 +457,16 @@ protected:
     //!
     void ReleaseSurfaceDS(uint8_t index);
 
+    //!
+    //! \brief  Release the shared DS surfaces of a slot
+    //!
+    //! \param  [in] index
+    //!         buffer index to be released
+    //!
+    //! \return void
+    //!
+    void ReleaseSharedSurfaceDS(uint8_t index);
+
     //!
     //! \brief  Release DsRecon buffer
     //!
@@ -485,6 +533,25 @@ private:
     //!
     MOS_STATUS AllocateDsReconSurfacesVdenc();
 
+    //!
+    //! \brief  Get the sizes of the 4x/16x/32x DS surfaces, 0 for the surfaces not used
+    //!
+    //! \param  [out] width
+    //!         Widths indexed by CodechalEncodeDsShare::DsSurface
+    //! \param  [out] height
+    //!         Heights indexed by CodechalEncodeDsShare::DsSurface
+    //!
+    //! \return void
+    //!
+    void GetSurfaceDSSize(uint32_t width[], uint32_t height[]);
+
+    //!
+    //! \brief  Set the bottom field offsets of the current DS surfaces
+    //!
+    //! \return void
+    //!
+    void SetScaledBottomFieldOffset();
+
     MOS_INTERFACE*          m_osInterface = nullptr;                            //!< OS interface
 
     uint8_t                 m_trackedBufNonRefIdx = 0;                          //!< current tracked buffer index when frame won't be used as ref
@@ -507,6 +574,10 @@ private:
         bool                bUsedforCurFrame;                                   //!< Used for FEI Preenc to mark whether this enty can be reused in multi-call case
     };
     tracker                 m_tracker[CODEC_NUM_TRACKED_BUFFERS];
+
+    CodechalEncodeDsShare           *m_dsShare = nullptr;                       //!< DS surfaces shared by the encoders of the MFE context
+    CodechalEncodeDsShare::Entry    *m_sharedDs[CODEC_NUM_TRACKED_BUFFERS] = {}; //!< Shared DS surfaces used by the slots
+    CodechalEncodeDsShare::Entry    *m_sharedDsToPublish = nullptr;             //!< Shared DS surfaces downscaled for the current frame
 };
 
 #endif  // __CODECHAL_ENCODE_TRACKED_BUFFER_H__
\ No newline at end of file
@@ -33,9 +33,19 @@ MOS_STATUS CodechalEncodeWP::AllocateResources()
 
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
 
-    if (Mos_ResourceIsNull(&m_surfaceParams.weightedPredOutputPicList[m_surfaceParams.wpOutListIdx].OsResource))
+    CODECHAL_ENCODE_CHK_NULL_RETURN(m_currWeightedRef);
+    PMOS_SURFACE surface = &m_currWeightedRef->surface;
+
+    // reallocate the output on resolution change
+    if (!Mos_ResourceIsNull(&surface->OsResource) &&
+        (surface->dwWidth != m_frameWidth || surface->dwHeight != m_frameHeight))
+    {
+        m_osInterface->pfnFreeResource(m_osInterface, &surface->OsResource);
+    }
+
+    if (Mos_ResourceIsNull(&surface->OsResource))
     {
-        MOS_ZeroMemory(&m_surfaceParams.weightedPredOutputPicList[m_surfaceParams.wpOutListIdx], sizeof(MOS_SURFACE));
+        MOS_ZeroMemory(surface, sizeof(MOS_SURFACE));
 
         MOS_ALLOC_GFXRES_PARAMS  allocParamsForBufferNV12;
         MOS_ZeroMemory(&allocParamsForBufferNV12, sizeof(MOS_ALLOC_GFXRES_PARAMS));
@@ -48,11 +58,10 @@ MOS_STATUS CodechalEncodeWP::AllocateResources()
         CODECHAL_ENCODE_CHK_STATUS_MESSAGE_RETURN(m_osInterface->pfnAllocateResource(
             m_osInterface,
             &allocParamsForBufferNV12,
-            &m_surfaceParams.weightedPredOutputPicList[m_surfaceParams.wpOutListIdx].OsResource),
+            &surface->OsResource),
             "Failed to allocate WP Scaled output Buffer.");
 
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface,
-            &m_surfaceParams.weightedPredOutputPicList[m_surfaceParams.wpOutListIdx]));
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(CodecHalGetResourceInfo(m_osInterface, surface));
     }
 
     return eStatus;
@@ -60,13 +69,120 @@ MOS_STATUS CodechalEncodeWP::AllocateResources()
 
 void CodechalEncodeWP::ReleaseResources()
 {
-    for (auto i = 0; i < CODEC_NUM_WP_FRAME; i++)
+    // the output slots only refer to the weighted references
+    for (auto &weightedRef : m_weightedRefs)
     {
-        if (!Mos_ResourceIsNull(&m_surfaceParams.weightedPredOutputPicList[i].OsResource))
+        if (!Mos_ResourceIsNull(&weightedRef.surface.OsResource))
         {
             m_osInterface->pfnFreeResource(
                 m_osInterface,
-                &m_surfaceParams.weightedPredOutputPicList[i].OsResource);
+                &weightedRef.surface.OsResource);
+        }
+    }
+}
+
+MOS_STATUS CodechalEncodeWP::BindWeightedRef(KernelParams *params, bool *weighted)
+{
+    CODECHAL_ENCODE_FUNCTION_ENTER;
+
+    CODECHAL_ENCODE_CHK_NULL_RETURN(params);
+    CODECHAL_ENCODE_CHK_NULL_RETURN(params->refFrameInput);
+    CODECHAL_ENCODE_CHK_NULL_RETURN(params->slcWPParams);
+    CODECHAL_ENCODE_CHK_NULL_RETURN(weighted);
+
+    *weighted = false;
+
+    // the outputs bound by the previous frame are no longer in use
+    if (m_weightedRefFrame != m_storeData)
+    {
+        for (auto &weightedRef : m_weightedRefs)
+        {
+            weightedRef.inUse = false;
+        }
+        m_weightedRefFrame = m_storeData;
+    }
+
+    uint8_t   listIdx          = params->useRefPicList1 ? LIST_1 : LIST_0;
+    uint16_t  weight           = params->slcWPParams->weights[listIdx][params->wpIndex][0][0];
+    uint16_t  offset           = params->slcWPParams->weights[listIdx][params->wpIndex][0][1];
+    bool      fieldPicture     = CodecHal_PictureIsField(m_currOriginalPic);
+    const void *refSurface     = params->refFrameInput->OsResource.pGmmResInfo;
+
+    WeightedRef *found  = nullptr;
+    WeightedRef *unused = nullptr;
+    WeightedRef *lru    = nullptr;
+    uint32_t    idleNum = 0;
+    for (auto &weightedRef : m_weightedRefs)
+    {
+        if (Mos_ResourceIsNull(&weightedRef.surface.OsResource))
+        {
+            unused = unused ? unused : &weightedRef;
+            continue;
+        }
+
+        if (weightedRef.refSurface       == refSurface              &&
+            weightedRef.weight           == weight                  &&
+            weightedRef.offset           == offset                  &&
+            weightedRef.refIsBottomField == params->refIsBottomField &&
+            weightedRef.fieldPicture     == fieldPicture            &&
+            weightedRef.frameWidth       == m_frameWidth            &&
+            weightedRef.frameFieldHeight == m_frameFieldHeight)
+        {
+            found = &weightedRef;
+            break;
+        }
+
+        if (!weightedRef.inUse)
+        {
+            idleNum++;
+            if (lru == nullptr || weightedRef.lruTag < lru->lruTag)
+            {
+                lru = &weightedRef;
+            }
+        }
+    }
+
+    if (found)
+    {
+        *weighted = true;
+        m_currWeightedRef = found;
+    }
+    else
+    {
+        // keep a few idle outputs for the next frames, the outputs in use by this frame are pinned
+        m_currWeightedRef = (lru && (idleNum >= CODECHAL_ENCODE_WP_MAX_IDLE_REFS || unused == nullptr)) ? lru : unused;
+        CODECHAL_ENCODE_CHK_NULL_RETURN(m_currWeightedRef);
+
+        // valid once the kernel writes it
+        m_currWeightedRef->refSurface       = nullptr;
+        m_currWeightedRef->weight           = weight;
+        m_currWeightedRef->offset           = offset;
+        m_currWeightedRef->refIsBottomField = params->refIsBottomField;
+        m_currWeightedRef->fieldPicture     = fieldPicture;
+        m_currWeightedRef->frameWidth       = m_frameWidth;
+        m_currWeightedRef->frameFieldHeight = m_frameFieldHeight;
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(AllocateResources());
+    }
+
+    m_currWeightedRef->inUse  = true;
+    m_currWeightedRef->lruTag = ++m_lruTag;
+    m_surfaceParams.weightedPredOutputPicList[m_surfaceParams.wpOutListIdx] = m_currWeightedRef->surface;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void CodechalEncodeWP::InvalidateRef(PMOS_SURFACE surface)
+{
+    if (surface == nullptr || surface->OsResource.pGmmResInfo == nullptr)
+    {
+        return;
+    }
+
+    for (auto &weightedRef : m_weightedRefs)
+    {
+        if (weightedRef.refSurface == surface->OsResource.pGmmResInfo)
+        {
+            weightedRef.refSurface = nullptr;
         }
     }
 }
@@ -264,8 +380,13 @@ MOS_STATUS CodechalEncodeWP::Execute(KernelParams *params)
         return eStatus;
     }
 
-    // Allocate output surface
-    CODECHAL_ENCODE_CHK_STATUS_RETURN(AllocateResources());
+    // Bind the output surface, the kernel is skipped if the reference is already weighted
+    bool weighted = false;
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(BindWeightedRef(params, &weighted));
+    if (weighted)
+    {
+        return eStatus;
+    }
 
     // If Single Task Phase is not enabled, use BT count for the kernel state.
     if (m_firstTaskInPhase == true || !m_singleTaskPhaseSupported)
@@ -387,6 +508,8 @@ MOS_STATUS CodechalEncodeWP::Execute(KernelParams *params)
         m_lastTaskInPhase = false;
     }
 
+    m_currWeightedRef->refSurface = params->refFrameInput->OsResource.pGmmResInfo;
+
     return eStatus;
 }
 
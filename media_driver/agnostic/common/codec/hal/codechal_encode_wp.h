@@ -31,6 +31,8 @@
 #include "codechal_hw.h"
 #include "codechal_encoder_base.h"
 
+#define CODECHAL_ENCODE_WP_MAX_IDLE_REFS    2   //!< Weighted references kept for the next frames beyond the ones in use
+
 //!
 //! \class    CodechalEncodeWP
 //! \brief    Weighted prediction kernel base class
@@ -130,6 +132,16 @@ public:
     //!
     PMOS_SURFACE GetWPOutputPicList(uint8_t index) { return &m_surfaceParams.weightedPredOutputPicList[index]; }
 
+    //!
+    //! \brief    Invalidate the weighted copies of a surface
+    //! \details  Called when the surface is written with a new picture, so the
+    //!           weighted reference of the previous picture is not used again
+    //!
+    //! \param    [in] surface
+    //!           Surface overwritten
+    //!
+    void InvalidateRef(PMOS_SURFACE surface);
+
     //!
     //! \brief    Copy constructor
     //!
@@ -928,6 +940,26 @@ protected:
     };
     C_ASSERT(MOS_BYTES_TO_DWORDS(sizeof(CurbeData)) == 51);
 
+    //!
+    //! \brief    Reference weighted by the WP kernel
+    //! \details  Fades and static overlays weight the same reference with the same
+    //!           parameters over several frames, the output is then bound again
+    //!           instead of running the kernel.
+    //!
+    struct WeightedRef
+    {
+        const void      *refSurface = nullptr;                           //!< Allocation of the reference, nullptr if the output is not valid
+        uint16_t        weight = 0;                                      //!< Luma weight
+        uint16_t        offset = 0;                                      //!< Luma offset
+        bool            refIsBottomField = false;                        //!< Bottom field of the reference weighted
+        bool            fieldPicture = false;                            //!< Field of the reference weighted
+        uint32_t        frameWidth = 0;                                  //!< Frame width of the output
+        uint32_t        frameFieldHeight = 0;                            //!< Frame or field height of the output
+        uint32_t        lruTag = 0;                                      //!< Last use, the least recently used output is reused first
+        bool            inUse = false;                                   //!< Bound to an output slot of the current frame
+        MOS_SURFACE     surface = {};                                    //!< Output surface
+    };
+
     //!
     //! \brief    Constructor
     //!
@@ -948,6 +980,10 @@ protected:
     uint8_t                     *m_kernelBase = nullptr;                     //!< kernel binary base address
     CurbeParams                 m_curbeParams = {};                          //!< Curbe parameters
     SurfaceParams               m_surfaceParams = {};                        //!< Surface parameters
+    WeightedRef                 m_weightedRefs[CODEC_NUM_WP_FRAME + CODECHAL_ENCODE_WP_MAX_IDLE_REFS]; //!< Outputs of the WP kernel, bound to the output slots
+    WeightedRef                 *m_currWeightedRef = nullptr;                //!< Output written by the current kernel
+    uint32_t                    m_weightedRefFrame = 0;                      //!< Frame of the in use outputs
+    uint32_t                    m_lruTag = 0;                                //!< Last LRU tag
 
     //!
     //! Reference to data members in Encoder class
@@ -981,6 +1017,22 @@ protected:
     //!
     MOS_STATUS AllocateResources();
 
+    //!
+    //! \brief    Bind the output of the reference weighted with the kernel params
+    //! \details  A reference already weighted with the same params is bound to the
+    //!           output slot. Else an output not in use by the current frame is
+    //!           picked, the least recently used one first, for the kernel.
+    //!
+    //! \param    [in] params
+    //!           Pointer to KernelParams
+    //! \param    [out] weighted
+    //!           true if the bound output is already weighted
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS BindWeightedRef(KernelParams *params, bool *weighted);
+
     //!
     //! \brief    Release weighted prediction surface
     //!
@@ -27,6 +27,7 @@
 
 #include "codechal_encoder_base.h"
 #include "codechal_encode_tracked_buffer_hevc.h"
+#include "codechal_encode_wp.h"
 #include "mos_solo_generic.h"
 
 void CodechalEncoderState::PrepareNodes(
@@ -1390,6 +1391,7 @@ MOS_STATUS CodechalEncoderState::AllocateResources()
     m_encodeStatusBuf.dwSceneChangedOffset    = CODECHAL_OFFSETOF(EncodeStatus, dwSceneChangedFlag);
     m_encodeStatusBuf.dwSumSquareErrorOffset  = CODECHAL_OFFSETOF(EncodeStatus, sumSquareError[0]);
     m_encodeStatusBuf.dwSliceReportOffset     = CODECHAL_OFFSETOF(EncodeStatus, sliceReport);
+    m_encodeStatusBuf.dwBSByteCountPerScanOffset = CODECHAL_OFFSETOF(EncodeStatus, dwMFCBitstreamByteCountPerScan);
     m_encodeStatusBuf.dwHuCStatusMaskOffset   = CODECHAL_OFFSETOF(EncodeStatus, HuCStatusRegMask);
     m_encodeStatusBuf.dwHuCStatusRegOffset    = CODECHAL_OFFSETOF(EncodeStatus, HuCStatusReg);
 
@@ -1585,6 +1587,8 @@ MOS_STATUS CodechalEncoderState::AllocateResources()
             allocParamsForBufferLinear.dwBytes = m_picWidthInMb * m_picHeightInMb * CODECHAL_CACHELINE_SIZE;
         }
         allocParamsForBufferLinear.pBufName = "VDEnc StreamIn Data Buffer";
+        // Filled by the CPU for ROI and dirty rects every frame, keep them mapped
+        allocParamsForBufferLinear.Flags.bPersistentMap = true;
 
         for (auto i = 0; i < CODECHAL_ENCODE_RECYCLED_BUFFER_NUM; i++)
         {
@@ -1608,6 +1612,7 @@ MOS_STATUS CodechalEncoderState::AllocateResources()
 
             m_osInterface->pfnUnlockResource(m_osInterface, &m_resVdencStreamInBuffer[i]);
         }
+        allocParamsForBufferLinear.Flags.bPersistentMap = false;
     }
 
     if (m_vdencEnabled)
@@ -2258,6 +2263,12 @@ MOS_STATUS CodechalEncoderState::VerifySpaceAvailable()
             {
                 requestedPatchListSize *= (m_numPasses + 1);
             }
+
+            // The pictures of a batch share the command buffer
+            if (m_encodeParams.dwBatchPicNum > 1)
+            {
+                requestedPatchListSize *= m_encodeParams.dwBatchPicNum;
+            }
         }
 
         requestedSize = CalculateCommandBufferSize();
@@ -3432,7 +3443,8 @@ MOS_STATUS CodechalEncoderState::ResetStatusReport()
         (EncodeStatus*)(encodeStatusBuf->pEncodeStatus +
         encodeStatusBuf->wCurrIndex * encodeStatusBuf->dwReportSize);
 
-    if (!m_frameTrackingEnabled && !m_inlineEncodeStatusUpdate)
+    // A batch stores its status once its last picture is added, which completes every picture of the batch
+    if (!m_frameTrackingEnabled && !m_inlineEncodeStatusUpdate && IsLastPictureInBatch())
     {
         bool renderEngineInUse = m_osInterface->pfnGetGpuContext(m_osInterface) == m_renderContext;
         bool nullRendering = false;
@@ -3819,6 +3831,19 @@ MOS_STATUS CodechalEncoderState::GetStatusReport(
                         encodeStatusReport->NumSlicesNonCompliant = 1;
                     }
                     encodeStatusReport->NumberSlices = numSlices->NumberOfSlices;
+
+                    // Each JPEG scan is reported as a slice, the last one ends with the frame
+                    if (m_standard == CODECHAL_JPEG && encodeStatus->dwNumScans > 0)
+                    {
+                        uint32_t numScans = MOS_MIN(encodeStatus->dwNumScans, CODECHAL_ENCODE_MAX_SCANS);
+                        for (uint32_t i = 0; i < numScans - 1; i++)
+                        {
+                            encodeStatusReport->ScanEndOffset[i] =
+                                encodeStatus->dwMFCBitstreamByteCountPerScan[i] + encodeStatus->dwHeaderBytesInserted;
+                        }
+                        encodeStatusReport->ScanEndOffset[numScans - 1] = encodeStatusReport->bitstreamSize;
+                        encodeStatusReport->NumberSlices                = (uint8_t)numScans;
+                    }
                 }
 
                 if (encodeStatusReport->bitstreamSize > m_bitstreamUpperBound)
@@ -4154,16 +4179,17 @@ MOS_STATUS CodechalEncoderState::SendPrologWithFrameTracking(
         cmdBuffer->Attributes.dwMediaFrameTrackingAddrOffset   = 0;
     }
 
-#ifdef _MMC_SUPPORTED
-    CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mmcState->SendPrologCmd(m_miInterface, cmdBuffer, MOS_RCS_ENGINE_USED(gpuContext)));
-#endif
-
     MHW_GENERIC_PROLOG_PARAMS genericPrologParams;
     MOS_ZeroMemory(&genericPrologParams, sizeof(genericPrologParams));
     genericPrologParams.pOsInterface            = m_osInterface;
     genericPrologParams.pvMiInterface     = m_miInterface;
     genericPrologParams.bMmcEnabled             = CodecHalMmcState::IsMmcEnabled();
     genericPrologParams.dwStoreDataValue = m_storeData - 1;
+
+    // MMC prolog and invariant generic prolog from the cached batch of this GPU context
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(m_hwInterface->SendPrologInvariantCmds(cmdBuffer, m_mmcState, &genericPrologParams));
+    genericPrologParams.bSkipInvariantCmds      = true;
+
     CODECHAL_ENCODE_CHK_STATUS_RETURN(Mhw_SendGenericPrologCmd(cmdBuffer, &genericPrologParams));
 
     return eStatus;
@@ -4243,6 +4269,15 @@ MOS_STATUS CodechalEncoderState::ExecuteEnc(
 
         m_encodeParams = *encodeParams;
 
+        // Only JPEG pictures can share a command buffer, each picture of the batch takes a recycled buffer
+        CODECHAL_ENCODE_CHK_COND_RETURN(
+            m_encodeParams.dwBatchPicNum > 1 && m_standard != CODECHAL_JPEG,
+            "Batched encode is not supported for standard %d", m_standard);
+        CODECHAL_ENCODE_CHK_COND_RETURN(
+            m_encodeParams.dwBatchPicNum > CODECHAL_ENCODE_MAX_BATCH_PICS ||
+            (m_encodeParams.dwBatchPicNum > 0 && m_encodeParams.dwBatchPicIdx >= m_encodeParams.dwBatchPicNum),
+            "Invalid batch picture %d of %d", m_encodeParams.dwBatchPicIdx, m_encodeParams.dwBatchPicNum);
+
         CODECHAL_ENCODE_CHK_STATUS_RETURN(m_hwInterface->GetCpInterface()->UpdateParams(true));
 
         if (CodecHalUsesVideoEngine(m_codecFunction))
@@ -4339,6 +4374,13 @@ MOS_STATUS CodechalEncoderState::ExecuteEnc(
             m_currRefList->b16xScalingUsed =
             m_currRefList->b32xScalingUsed = false;
 
+            // the raw and recon surfaces get a new picture, their weighted copies are stale
+            if (m_wpState)
+            {
+                m_wpState->InvalidateRef(&m_rawSurface);
+                m_wpState->InvalidateRef(&m_reconSurface);
+            }
+
             // allocate tracked buffer for current frame
             CODECHAL_ENCODE_CHK_STATUS_RETURN(m_trackedBuf->AllocateForCurrFrame());
             m_currRefList->ucScalingIdx = m_trackedBuf->GetCurrIndex();
@@ -4385,6 +4427,9 @@ MOS_STATUS CodechalEncoderState::ExecuteEnc(
             // Call ENC Kernels
             CODECHAL_ENCODE_CHK_STATUS_MESSAGE_RETURN(ExecuteKernelFunctions(),
                 "ENC failed.");
+
+            // the other streams of the MFE context can use the DS surfaces of the raw surface
+            m_trackedBuf->PublishSharedSurfaceDS();
         }
     }
 
@@ -4395,9 +4440,12 @@ MOS_STATUS CodechalEncoderState::ExecuteEnc(
 
         if (CodecHalUsesVideoEngine(m_codecFunction))
         {
-            // Set to video context
-            m_osInterface->pfnSetGpuContext(m_osInterface, m_videoContext);
-            m_osInterface->pfnResetOsStates(m_osInterface);
+            // Set to video context, later pictures of a batch add to the command buffer of the first one
+            if (IsFirstPictureInBatch())
+            {
+                m_osInterface->pfnSetGpuContext(m_osInterface, m_videoContext);
+                m_osInterface->pfnResetOsStates(m_osInterface);
+            }
             m_currPass = 0;
 
             for (m_currPass = 0; m_currPass <= m_numPasses; m_currPass++)
@@ -4405,7 +4453,7 @@ MOS_STATUS CodechalEncoderState::ExecuteEnc(
                 m_firstTaskInPhase = (m_currPass == 0);
                 m_lastTaskInPhase = (m_currPass == m_numPasses);
 
-                if (m_firstTaskInPhase || !m_singleTaskPhaseSupported)
+                if ((m_firstTaskInPhase || !m_singleTaskPhaseSupported) && IsFirstPictureInBatch())
                     CODECHAL_ENCODE_CHK_STATUS_RETURN(VerifySpaceAvailable());
 
                 // Setup picture level PAK commands
@@ -357,6 +357,8 @@ struct MfeParams
     uint32_t                           maxHeight;            //!< Maximum height for all frames
 };
 
+class CodechalEncodeDsShare;
+
 //!
 //! \struct MfeSharedState
 //! \brief  State shared across multiple streams
@@ -369,6 +371,7 @@ struct MfeSharedState
     uint32_t                        dwPicWidthInMB;           //!< Keep the maximum width
     uint32_t                        dwPicHeightInMB;          //!< Keep the maximum height
     uint16_t                        sliceHeight;              //!< Keep the maximum slice height
+    uint32_t                        dwMbEncSshStreamSize;     //!< SSH slot of one stream in the merged MbEnc phase, set in the first stream
 
     CmDevice                                *pCmDev;          //!< Set in the first stream, Used by the rest streams
     CmTask                                  *pCmTask;
@@ -377,6 +380,7 @@ struct MfeSharedState
     SurfaceIndex                            *vmeSurface;
     SurfaceIndex                            *commonSurface;
     std::vector<CodechalEncoderState*>      encoders;
+    CodechalEncodeDsShare                   *dsShare;         //!< Downscaled surfaces shared by the streams
 };
 
 //!
@@ -889,6 +893,7 @@ struct EncodeStatusReport
     uint32_t                        SizeOfTileInfoBuffer;   //!< Store the size of tile info buffer
     CodechalTileInfo*               pHEVCTileinfo;          //!< Pointer to the tile info buffer
     uint32_t                        NumTileReported;        //!< The number of tiles reported in status
+    uint32_t                        ScanEndOffset[CODECHAL_ENCODE_MAX_SCANS];   //!< [JPEG] Bitstream size at the end of each of the NumberSlices scans
 
     /*! \brief indicate whether it is single stream encoder or MFE.
     *
@@ -943,6 +948,8 @@ struct EncodeStatus
     uint32_t                        dwSceneChangedFlag;     //!< The flag indicate if the scene is changed
     uint64_t                        sumSquareError[3];      //!< The list of sum square error
     EncodeStatusSliceReport         sliceReport;
+    uint32_t                        dwNumScans;             //!< [JPEG] Number of scans of the picture
+    uint32_t                        dwMFCBitstreamByteCountPerScan[CODECHAL_ENCODE_MAX_SCANS]; //!< [JPEG] Bitstream byte count at the end of each scan but the last
 };
 
 //!
@@ -972,6 +979,7 @@ struct EncodeStatusBuffer
     uint32_t                                dwSceneChangedOffset;           //!> The offset of the scene changed flag
     uint32_t                                dwSumSquareErrorOffset;         //!> The offset of list of sum square error
     uint32_t                                dwSliceReportOffset;            //!> The offset of slice size report structure
+    uint32_t                                dwBSByteCountPerScanOffset;     //!> The offset of BS byte count of each scan
     uint32_t                                dwSize;                         //!> Size of status buffer
     uint32_t                                dwReportSize;                   //!> Size of report
 };
@@ -1924,6 +1932,20 @@ public:
     //!
     MOS_STATUS VerifySpaceAvailable();
 
+    //!
+    //! \brief  Check if the current picture starts its command buffer
+    //! \return bool
+    //!         true unless the picture follows another picture of its batch
+    //!
+    bool IsFirstPictureInBatch() { return m_encodeParams.dwBatchPicIdx == 0; }
+
+    //!
+    //! \brief  Check if the current picture ends its command buffer
+    //! \return bool
+    //!         true if the picture is the last of its batch or is not batched
+    //!
+    bool IsLastPictureInBatch() { return m_encodeParams.dwBatchPicIdx + 1 >= m_encodeParams.dwBatchPicNum; }
+
     //!
     //! \brief  Add MEDIA_VFE command to command buffer
     //! \param  [in, out] cmdBuffer
@@ -25,9 +25,12 @@
 //!
 #include "codechal_hw.h"
 #include "codechal_setting.h"
+#include "codechal_mmc.h"
 
 #define VDBOX_HUC_VDENC_BRC_INIT_KERNEL_DESCRIPTOR 4
 
+#define CODECHAL_PROLOG_CACHE_MAX_SIZE  1024    //!< Largest invariant prolog in bytes
+
 //| HW parameter initializers
 const MOS_SYNC_PARAMS     g_cInitSyncParams =
 {
@@ -76,6 +79,16 @@ CodechalHwInterface::CodechalHwInterface(
     MOS_ZeroMemory(&m_dummyStreamIn, sizeof(m_dummyStreamIn));
     MOS_ZeroMemory(&m_dummyStreamOut, sizeof(m_dummyStreamOut));
     MOS_ZeroMemory(&m_conditionalBbEndDummy, sizeof(m_conditionalBbEndDummy));
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    MOS_USER_FEATURE_VALUE_DATA userFeatureData;
+    MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __MEDIA_USER_FEATURE_VALUE_CODEC_PROLOG_CACHE_MODE_ID,
+        &userFeatureData);
+    m_prologCacheMode = (uint8_t)userFeatureData.i32Data;
+#endif
 }
 
 MOS_STATUS CodechalHwInterface::SetCacheabilitySettings(
@@ -1716,3 +1729,146 @@ MOS_STATUS CodechalHwInterface::SetStatusTagByMiCommand(
 
     return result;
 }
+
+MOS_STATUS CodechalHwInterface::SendPrologInvariantCmds(
+    PMOS_COMMAND_BUFFER         cmdBuffer,
+    CodecHalMmcState            *mmcState,
+    PMHW_GENERIC_PROLOG_PARAMS  prologParams)
+{
+    CODECHAL_HW_FUNCTION_ENTER;
+
+    CODECHAL_HW_CHK_NULL_RETURN(cmdBuffer);
+    CODECHAL_HW_CHK_NULL_RETURN(prologParams);
+    CODECHAL_HW_CHK_NULL_RETURN(m_osInterface);
+    CODECHAL_HW_CHK_NULL_RETURN(m_miInterface);
+
+    MOS_GPU_CONTEXT gpuContext = m_osInterface->pfnGetGpuContext(m_osInterface);
+    uint8_t         mode       = m_prologCacheMode;
+
+    if (mode == CODECHAL_PROLOG_CACHE_DISABLE || gpuContext >= MOS_GPU_CONTEXT_MAX)
+    {
+#ifdef _MMC_SUPPORTED
+        if (mmcState)
+        {
+            CODECHAL_HW_CHK_STATUS_RETURN(mmcState->SendPrologCmd(
+                m_miInterface,
+                cmdBuffer,
+                MOS_RCS_ENGINE_USED(gpuContext)));
+        }
+#endif
+        return Mhw_SendGenericPrologInvariantCmd(cmdBuffer, prologParams);
+    }
+
+    PrologCache &cache = m_prologCache[gpuContext];
+
+    // The watchdog threshold follows the frame size of the codec
+    if (!cache.valid ||
+        cache.mmcState != mmcState ||
+        cache.mmcEnabled != prologParams->bMmcEnabled ||
+        cache.watchdogThreshold != m_miInterface->GetWatchdogTimerThreshold())
+    {
+        CODECHAL_HW_CHK_STATUS_RETURN(BuildPrologCache(cache, mmcState, prologParams));
+    }
+
+    if (cache.cmds.empty())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    if (mode == CODECHAL_PROLOG_CACHE_COPY)
+    {
+        return Mos_AddCommand(cmdBuffer, cache.cmds.data(), cache.cmds.size());
+    }
+
+    return m_miInterface->AddMiBatchBufferStartCmd(cmdBuffer, &cache.batch);
+}
+
+MOS_STATUS CodechalHwInterface::BuildPrologCache(
+    PrologCache                 &cache,
+    CodecHalMmcState            *mmcState,
+    PMHW_GENERIC_PROLOG_PARAMS  prologParams)
+{
+    CODECHAL_HW_FUNCTION_ENTER;
+
+    CODECHAL_HW_CHK_NULL_RETURN(prologParams);
+
+    cache.valid = false;
+    cache.cmds.clear();
+
+    // Build the commands out of the command buffer, they have no relocations
+    uint32_t           staging[CODECHAL_PROLOG_CACHE_MAX_SIZE / sizeof(uint32_t)];
+    MOS_COMMAND_BUFFER constructedCmdBuf;
+
+    MOS_ZeroMemory(&constructedCmdBuf, sizeof(constructedCmdBuf));
+    constructedCmdBuf.pCmdBase   = staging;
+    constructedCmdBuf.pCmdPtr    = staging;
+    constructedCmdBuf.iOffset    = 0;
+    constructedCmdBuf.iRemaining = sizeof(staging);
+
+#ifdef _MMC_SUPPORTED
+    if (mmcState)
+    {
+        CODECHAL_HW_CHK_STATUS_RETURN(mmcState->SendPrologCmd(
+            m_miInterface,
+            &constructedCmdBuf,
+            MOS_RCS_ENGINE_USED(m_osInterface->pfnGetGpuContext(m_osInterface))));
+    }
+#endif
+    CODECHAL_HW_CHK_STATUS_RETURN(Mhw_SendGenericPrologInvariantCmd(&constructedCmdBuf, prologParams));
+
+    cache.cmds.assign(
+        (uint8_t *)staging,
+        (uint8_t *)staging + constructedCmdBuf.iOffset);
+
+    FreePrologBatch(cache);
+
+    if (!cache.cmds.empty())
+    {
+        MOS_ZeroMemory(&cache.batch, sizeof(cache.batch));
+        cache.batch.bSecondLevel = true;
+        CODECHAL_HW_CHK_STATUS_RETURN(Mhw_AllocateBb(
+            m_osInterface,
+            &cache.batch,
+            nullptr,
+            cache.cmds.size() + m_sizeOfCmdBatchBufferEnd));
+        cache.batchAllocated = true;
+
+        CODECHAL_HW_CHK_STATUS_RETURN(Mhw_LockBb(m_osInterface, &cache.batch));
+        CODECHAL_HW_CHK_STATUS_RETURN(Mhw_AddCommandBB(
+            &cache.batch,
+            cache.cmds.data(),
+            cache.cmds.size()));
+        CODECHAL_HW_CHK_STATUS_RETURN(m_miInterface->AddMiBatchBufferEnd(nullptr, &cache.batch));
+        CODECHAL_HW_CHK_STATUS_RETURN(Mhw_UnlockBb(m_osInterface, &cache.batch, true));
+    }
+
+    cache.mmcState          = mmcState;
+    cache.mmcEnabled        = prologParams->bMmcEnabled;
+    cache.watchdogThreshold = m_miInterface->GetWatchdogTimerThreshold();
+    cache.valid             = true;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void CodechalHwInterface::FreePrologBatch(PrologCache &cache)
+{
+    if (cache.batchAllocated && m_osInterface)
+    {
+        // Command buffers already submitted may still start the batch
+        m_osInterface->pfnWaitOnResource(m_osInterface, &cache.batch.OsResource);
+        Mhw_FreeBb(m_osInterface, &cache.batch, nullptr);
+    }
+    cache.batchAllocated = false;
+}
+
+void CodechalHwInterface::FreePrologCache()
+{
+    for (uint32_t i = 0; i < MOS_GPU_CONTEXT_MAX; i++)
+    {
+        PrologCache &cache = m_prologCache[i];
+
+        FreePrologBatch(cache);
+        cache.valid = false;
+        cache.cmds.clear();
+    }
+}
@@ -26,6 +26,7 @@
 #ifndef __CODECHAL_HW_H__
 #define __CODECHAL_HW_H__
 
+#include <vector>
 #include "codechal.h"
 #include "mhw_mi.h"
 #include "mhw_render.h"
@@ -103,6 +104,13 @@
 
 #define CODECHAL_INVALID_BINDING_TABLE_IDX  0xFFFFFFFF
 
+// Ways to add the invariant prolog commands, debug drivers select one through "Codec Prolog Cache Mode"
+#define CODECHAL_PROLOG_CACHE_CHAIN         0   //!< Start the cached batch buffer
+#define CODECHAL_PROLOG_CACHE_COPY          1   //!< Copy the cached commands to the command buffer
+#define CODECHAL_PROLOG_CACHE_DISABLE       2   //!< Build the commands in the command buffer
+
+class CodecHalMmcState;
+
 //!
 //! \enum     MoTargetCache
 //! \brief    Mo target cache
@@ -395,6 +403,52 @@ protected:
 
     bool                        m_noSeparateL3LlcCacheabilitySettings = false;   // No separate L3 LLC cacheability settings
 
+    //!
+    //! \brief    Invariant prolog commands of a GPU context
+    //!
+    struct PrologCache
+    {
+        bool                    valid = false;          //!< Commands were built
+        bool                    mmcEnabled = false;     //!< MMC enabled when built
+        CodecHalMmcState        *mmcState = nullptr;    //!< MMC state used to build
+        uint32_t                watchdogThreshold = 0;  //!< Watchdog timer threshold when built
+        bool                    batchAllocated = false; //!< Batch buffer is allocated
+        MHW_BATCH_BUFFER        batch = {};             //!< Second level batch buffer of the commands
+        std::vector<uint8_t>    cmds;                   //!< Commands, without MI_BATCH_BUFFER_END
+    };
+
+    PrologCache                 m_prologCache[MOS_GPU_CONTEXT_MAX];    //!< Invariant prolog per GPU context
+    uint8_t                     m_prologCacheMode = CODECHAL_PROLOG_CACHE_CHAIN;   //!< How the invariant prolog is added
+
+    //!
+    //! \brief    Build the invariant prolog commands of a GPU context
+    //! \param    [in, out] cache
+    //!           Cache of the GPU context
+    //! \param    [in] mmcState
+    //!           MMC state of the codec, may be nullptr
+    //! \param    [in] prologParams
+    //!           Generic prolog params of the command buffer
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS BuildPrologCache(
+        PrologCache                 &cache,
+        CodecHalMmcState            *mmcState,
+        PMHW_GENERIC_PROLOG_PARAMS  prologParams);
+
+    //!
+    //! \brief    Free the batch buffer of an invariant prolog
+    //! \details  Waits for the submitted command buffers starting it
+    //! \param    [in, out] cache
+    //!           Cache of the GPU context
+    //!
+    void FreePrologBatch(PrologCache &cache);
+
+    //!
+    //! \brief    Free the batch buffers of the invariant prolog
+    //!
+    void FreePrologCache();
+
 public:
     // Hardware dependent parameters
     bool                        m_turboMode = false;                            //!> Turbo mode info to pass in cmdBuf
@@ -455,6 +509,8 @@ public:
     {
         CODECHAL_HW_FUNCTION_ENTER;
 
+        FreePrologCache();
+
         if (MEDIA_IS_WA(m_waTable, WaHucStreamoutEnable))
         {
             m_osInterface->pfnFreeResource(
@@ -1424,6 +1480,29 @@ public:
         uint32_t tag,
         PMOS_COMMAND_BUFFER cmdBuffer);
 
+    //!
+    //! \brief    Add the invariant prolog commands
+    //! \details  The MMC prolog and the invariant commands of the generic
+    //!           prolog only depend on the GPU context. They are built once per
+    //!           GPU context into a second level batch buffer, which is started
+    //!           from each command buffer, and rebuilt when the MMC state
+    //!           changes. The caller must set bSkipInvariantCmds before passing
+    //!           prologParams to Mhw_SendGenericPrologCmd. The commands must
+    //!           not have relocations.
+    //! \param    [in, out] cmdBuffer
+    //!           Command buffer
+    //! \param    [in] mmcState
+    //!           MMC state of the codec, may be nullptr
+    //! \param    [in] prologParams
+    //!           Generic prolog params of the command buffer
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS SendPrologInvariantCmds(
+        PMOS_COMMAND_BUFFER         cmdBuffer,
+        CodecHalMmcState            *mmcState,
+        PMHW_GENERIC_PROLOG_PARAMS  prologParams);
+
     //!
     //! \brief    Check if simulation/emulation is active
     //! \return   bool
@@ -4219,6 +4219,9 @@ MOS_STATUS CodechalVdencAvcState::AllocateResources()
     // VDENC BRC buffer allocation
     for (uint32_t i = 0; i < CODECHAL_ENCODE_RECYCLED_BUFFER_NUM; i++)
     {
+        // HuC BRC inputs are written by the CPU every frame, keep them mapped
+        allocParamsForBufferLinear.Flags.bPersistentMap = true;
+
         // BRC update DMEM
         allocParamsForBufferLinear.dwBytes  = MOS_ALIGN_CEIL(m_vdencBrcUpdateDmemBufferSize, CODECHAL_CACHELINE_SIZE);
         allocParamsForBufferLinear.pBufName = "VDENC BrcUpdate DmemBuffer";
@@ -4277,6 +4280,8 @@ MOS_STATUS CodechalVdencAvcState::AllocateResources()
             CODECHAL_ENCODE_ASSERTMESSAGE("%s: Failed to allocate VDENC BRC IMG State Read Buffer\n", __FUNCTION__);
             return eStatus;
         }
+
+        allocParamsForBufferLinear.Flags.bPersistentMap = false;
     }
 
     // Const Data buffer
@@ -2909,6 +2909,9 @@ MOS_STATUS CodechalVdencHevcState::AllocateBrcResources()
             &m_vdencDeltaQpBuffer[k]),
             "Failed to create Delta QP for ROI Buffer");
 
+        // HuC BRC inputs are written by the CPU every frame, keep them mapped
+        allocParamsForBufferLinear.Flags.bPersistentMap = true;
+
         // BRC update DMEM
         allocParamsForBufferLinear.dwBytes = MOS_ALIGN_CEIL(m_vdencBrcUpdateDmemBufferSize, CODECHAL_CACHELINE_SIZE);
         allocParamsForBufferLinear.pBufName = "VDENC BrcUpdate DmemBuffer";
@@ -2970,6 +2973,8 @@ MOS_STATUS CodechalVdencHevcState::AllocateBrcResources()
                 &m_vdencReadBatchBuffer[k][i]),
                 "Failed to allocate VDENC Read Batch Buffer");
         }
+
+        allocParamsForBufferLinear.Flags.bPersistentMap = false;
     }
 
     for (auto j = 0; j < CODECHAL_ENCODE_RECYCLED_BUFFER_NUM; j++)
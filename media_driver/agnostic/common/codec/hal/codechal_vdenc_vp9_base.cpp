@@ -6298,9 +6298,10 @@ MOS_STATUS CodechalVdencVp9State::AllocateResources()
             &allocParamsForBufferLinear,
             &m_resCuStatsStrmOutBuffer));
 
-        // HUC Prob DMEM buffer
+        // HUC Prob DMEM buffer, written by the CPU every frame
         allocParamsForBufferLinear.dwBytes = MOS_ALIGN_CEIL(MOS_MAX(sizeof(HucProbDmem), sizeof(HucProbDmem)), CODECHAL_CACHELINE_SIZE);
         allocParamsForBufferLinear.pBufName = "HucProbDmemBuffer";
+        allocParamsForBufferLinear.Flags.bPersistentMap = true;
         for (auto i = 0; i < 3; i++)
         {
             CODECHAL_ENCODE_CHK_STATUS_RETURN(m_osInterface->pfnAllocateResource(
@@ -6308,6 +6309,7 @@ MOS_STATUS CodechalVdencVp9State::AllocateResources()
                 &allocParamsForBufferLinear,
                 &m_resHucProbDmemBuffer[i]));
         }
+        allocParamsForBufferLinear.Flags.bPersistentMap = false;
 
         // Huc default prob buffer
         allocParamsForBufferLinear.dwBytes = sizeof(Keyframe_Default_Probs)+sizeof(Inter_Default_Probs);
@@ -6549,6 +6551,9 @@ MOS_STATUS CodechalVdencVp9State::AllocateResources()
         return eStatus;
     }
 
+    // BRC DMEM buffers are written by the CPU every frame, keep them mapped
+    allocParamsForBufferLinear.Flags.bPersistentMap = true;
+
     // BRC init/reset DMEM
     allocParamsForBufferLinear.dwBytes = MOS_ALIGN_CEIL(sizeof(HucBrcInitDmem), CODECHAL_CACHELINE_SIZE);
     allocParamsForBufferLinear.pBufName = "VDENC BrcInit DmemBuffer";
@@ -6574,6 +6579,7 @@ MOS_STATUS CodechalVdencVp9State::AllocateResources()
             &allocParamsForBufferLinear,
             &m_resVdencBrcUpdateDmemBuffer[i]);
     }
+    allocParamsForBufferLinear.Flags.bPersistentMap = false;
 
     if (eStatus != MOS_STATUS_SUCCESS)
     {
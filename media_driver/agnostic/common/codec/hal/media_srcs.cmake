@@ -299,6 +299,7 @@ if(${Common_Encode_Supported} STREQUAL "yes")
         ${CMAKE_CURRENT_LIST_DIR}/codechal_encode_singlepipe_virtualengine.cpp
         ${CMAKE_CURRENT_LIST_DIR}/codechal_encode_scalability.cpp
         ${CMAKE_CURRENT_LIST_DIR}/codechal_encode_sw_scoreboard.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/codechal_encode_ds_share.cpp
     )
 
     set(TMP_3_HEADERS_
@@ -316,6 +317,7 @@ if(${Common_Encode_Supported} STREQUAL "yes")
         ${CMAKE_CURRENT_LIST_DIR}/codechal_encode_singlepipe_virtualengine.h
         ${CMAKE_CURRENT_LIST_DIR}/codechal_encode_scalability.h
         ${CMAKE_CURRENT_LIST_DIR}/codechal_encode_sw_scoreboard.h
+        ${CMAKE_CURRENT_LIST_DIR}/codechal_encode_ds_share.h
     )
 endif()
 
@@ -31,6 +31,8 @@
 #include "mos_os.h"
 #include "codec_def_decode_jpeg.h"
 
+#define CODECHAL_DECODE_MAX_BATCH_PICS  16  //!< [JPEG] Max pictures decoded in one command buffer, each one takes a status report entry
+
 struct CencDecodeShareBuf;
 
 //!
@@ -130,6 +132,19 @@ struct CodechalDecodeParams
     void                    *m_huffmanTable = nullptr;
     //! \brief [JPEG] Describes the layout of the decode render target
     CodecDecodeJpegImageLayout m_outputSurfLayout = {{0}};
+    //! \brief [JPEG] Index of the picture in its batch
+    //!      The pictures of a batch are sent by their own Execute calls in batch order, each one with its own
+    //!      parameters, bitstream and render target, and are decoded back to back in one command buffer which is
+    //!      submitted with the last picture. m_batchPicNum is 0 when the picture is not part of a batch.
+    uint32_t                m_batchPicIdx = 0;
+    //! \brief [JPEG] Number of pictures in the batch
+    uint32_t                m_batchPicNum = 0;
+    //! \brief [JPEG] Number of scans of all the pictures in the batch
+    uint32_t                m_batchNumSlices = 0;
+    //! \brief [JPEG] Width and height covering the pictures of the batch
+    //!      The watchdog timer of the command buffer is set for this size with the first picture.
+    uint32_t                m_batchWidth = 0;
+    uint32_t                m_batchHeight = 0;
 
     //! \brief [AVC] Indicates whethe or not PicId remapping is in use
     bool                    m_picIdRemappingInUse = false;
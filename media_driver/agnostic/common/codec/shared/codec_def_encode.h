@@ -29,6 +29,9 @@
 #define __CODEC_DEF_ENCODE_H__
 #include "mos_os.h"
 
+#define CODECHAL_ENCODE_MAX_BATCH_PICS  6   //!< [JPEG] Max pictures encoded in one command buffer, at most the recycled buffers
+#define CODECHAL_ENCODE_MAX_SCANS       4   //!< [JPEG] Max scans of a picture, one per component
+
 //!
 //! \struct CodechalEncodeSeiData
 //! \brief  Indicate the SeiData parameters
@@ -130,6 +133,16 @@ struct EncoderParams
     HANDLE                          gpuAppTaskEvent;                // MSDK event handling
 
     bool                            fullHeaderInAppData;         //!< [JPEG]
+
+    /*! \brief [JPEG] Pictures encoded back to back in one command buffer.
+    *
+    *    Each picture of the batch is sent by its own Execute call in batch order, with its own surfaces,
+    *    tables and bitstream buffer. The command buffer is submitted with the last picture. dwBatchPicNum is 0
+    *    when the picture is not part of a batch.
+    */
+    uint32_t                        dwBatchPicIdx;              //!< [JPEG] Index of the picture in its batch
+    uint32_t                        dwBatchPicNum;              //!< [JPEG] Number of pictures in the batch
+    uint32_t                        dwBatchAppDataSize;         //!< [JPEG] Application data size of the whole batch
 };
 
 #endif // !__CODEC_DEF_ENCODE_H__
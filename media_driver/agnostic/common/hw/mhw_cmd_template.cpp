@@ -0,0 +1,281 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      mhw_cmd_template.cpp
+//! \brief     Implementation of class MhwCmdTemplate
+//!
+
+#include "mhw_cmd_template.h"
+#include "mhw_utilities.h"
+
+thread_local MhwCmdTemplate *MhwCmdTemplate::m_recording = nullptr;
+
+MhwCmdTemplate::~MhwCmdTemplate()
+{
+    if (m_recording == this)
+    {
+        m_recording = nullptr;
+    }
+}
+
+bool MhwCmdTemplate::IsEnabled() const
+{
+    if (m_osInterface == nullptr || m_osInterface->bUsesGfxAddress)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void MhwCmdTemplate::GetAliases(
+    PMOS_RESOURCE           *resources,
+    uint32_t                numResources,
+    std::vector<uint16_t>   &aliases)
+{
+    aliases.resize(numResources);
+
+    for (uint32_t i = 0; i < numResources; i++)
+    {
+        aliases[i] = MHW_CMD_TEMPLATE_NO_RESOURCE;
+        if (resources[i] == nullptr)
+        {
+            continue;
+        }
+
+        for (uint32_t j = 0; j <= i; j++)
+        {
+            if (resources[j] == resources[i])
+            {
+                aliases[i] = (uint16_t)j;
+                break;
+            }
+        }
+    }
+}
+
+bool MhwCmdTemplate::Matches(
+    const void      *key,
+    uint32_t        keySize,
+    PMOS_RESOURCE   *resources,
+    uint32_t        numResources)
+{
+    if (!m_valid || key == nullptr || resources == nullptr ||
+        keySize != m_key.size() || numResources != m_aliases.size())
+    {
+        return false;
+    }
+
+    if (memcmp(key, m_key.data(), keySize) != 0)
+    {
+        return false;
+    }
+
+    GetAliases(resources, numResources, m_replayAliases);
+
+    return m_replayAliases == m_aliases;
+}
+
+MOS_STATUS MhwCmdTemplate::BeginRecord(
+    PMOS_COMMAND_BUFFER cmdBuffer,
+    const void          *key,
+    uint32_t            keySize,
+    PMOS_RESOURCE       *resources,
+    uint32_t            numResources)
+{
+    MHW_CHK_NULL_RETURN(cmdBuffer);
+    MHW_CHK_NULL_RETURN(key);
+    MHW_CHK_NULL_RETURN(resources);
+
+    if (numResources >= MHW_CMD_TEMPLATE_NO_RESOURCE)
+    {
+        MHW_ASSERTMESSAGE("Too many resources in command template.");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    if (m_recording != nullptr)
+    {
+        MHW_ASSERTMESSAGE("Another command template is being recorded.");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    Invalidate();
+
+    m_key.assign((const uint8_t *)key, (const uint8_t *)key + keySize);
+    GetAliases(resources, numResources, m_aliases);
+
+    m_recordCmdBuffer    = cmdBuffer;
+    m_recordResources    = resources;
+    m_recordNumResources = numResources;
+    m_recordOffset       = cmdBuffer->iOffset;
+    m_recordFailed       = false;
+    m_recording          = this;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MhwCmdTemplate::EndRecord(
+    PMOS_COMMAND_BUFFER cmdBuffer)
+{
+    MHW_CHK_NULL_RETURN(cmdBuffer);
+
+    if (m_recording != this || m_recordCmdBuffer != cmdBuffer)
+    {
+        MHW_ASSERTMESSAGE("Command template is not recording this command buffer.");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    m_recording         = nullptr;
+    m_recordCmdBuffer   = nullptr;
+    m_recordResources   = nullptr;
+
+    if (m_recordFailed || cmdBuffer->iOffset < (int32_t)m_recordOffset)
+    {
+        // Commands could not be recorded, build them again next time
+        Invalidate();
+        return MOS_STATUS_SUCCESS;
+    }
+
+    m_cmds.assign(
+        (uint8_t *)cmdBuffer->pCmdBase + m_recordOffset,
+        (uint8_t *)cmdBuffer->pCmdBase + cmdBuffer->iOffset);
+    m_patchEntries.resize(m_relocations.size());
+    m_valid = true;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MhwCmdTemplate::Replay(
+    PMOS_COMMAND_BUFFER cmdBuffer,
+    PMOS_RESOURCE       *resources,
+    uint32_t            numResources)
+{
+    MHW_CHK_NULL_RETURN(m_osInterface);
+    MHW_CHK_NULL_RETURN(cmdBuffer);
+    MHW_CHK_NULL_RETURN(resources);
+
+    if (!m_valid || numResources != m_aliases.size())
+    {
+        MHW_ASSERTMESSAGE("Command template does not match the resources.");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    uint32_t segmentOffset = cmdBuffer->iOffset;
+
+    MHW_CHK_STATUS_RETURN(Mos_AddCommand(cmdBuffer, m_cmds.data(), m_cmds.size()));
+
+    int32_t allocationIndex = 0;
+    for (uint32_t i = 0; i < m_relocations.size(); i++)
+    {
+        const Relocation        &relocation = m_relocations[i];
+        PMOS_PATCH_ENTRY_PARAMS entry       = &m_patchEntries[i];
+        PMOS_RESOURCE           resource    = resources[relocation.slot];
+
+        MHW_CHK_NULL_RETURN(resource);
+
+        // The upper bound entry follows the entry of the same resource
+        if (!relocation.entry.bUpperBoundPatch || i == 0 || m_relocations[i - 1].slot != relocation.slot)
+        {
+            MHW_CHK_STATUS_RETURN(m_osInterface->pfnRegisterResource(
+                m_osInterface,
+                resource,
+                relocation.entry.bWrite ? true : false,
+                relocation.entry.bWrite ? true : false));
+
+            allocationIndex = m_osInterface->pfnGetResourceAllocationIndex(m_osInterface, resource);
+        }
+
+        *entry                      = relocation.entry;
+        entry->presResource         = resource;
+        entry->uiAllocationIndex    = allocationIndex;
+        entry->uiPatchOffset       += segmentOffset;
+        if (!entry->bUpperBoundPatch)
+        {
+            entry->cmdBufBase       = (uint8_t *)cmdBuffer->pCmdBase;
+        }
+    }
+
+    if (!m_patchEntries.empty())
+    {
+        MHW_CHK_STATUS_RETURN(m_osInterface->pfnSetPatchEntries(
+            m_osInterface,
+            m_patchEntries.data(),
+            m_patchEntries.size()));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void MhwCmdTemplate::Invalidate()
+{
+    m_valid = false;
+    m_key.clear();
+    m_aliases.clear();
+    m_cmds.clear();
+    m_relocations.clear();
+    m_patchEntries.clear();
+}
+
+void MhwCmdTemplate::RecordPatchEntries(
+    PMOS_COMMAND_BUFFER     cmdBuffer,
+    PMOS_PATCH_ENTRY_PARAMS entries,
+    uint32_t                numEntries)
+{
+    MhwCmdTemplate *recording = m_recording;
+
+    if (recording == nullptr || recording->m_recordCmdBuffer != cmdBuffer ||
+        recording->m_recordFailed || entries == nullptr)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < numEntries; i++)
+    {
+        const MOS_PATCH_ENTRY_PARAMS &entry = entries[i];
+        Relocation                   relocation;
+
+        relocation.slot = recording->m_recordNumResources;
+        for (uint32_t slot = 0; slot < recording->m_recordNumResources; slot++)
+        {
+            if (recording->m_recordResources[slot] == entry.presResource)
+            {
+                relocation.slot = slot;
+                break;
+            }
+        }
+
+        // Relocations in the SSH or of resources outside the table can't be replayed
+        if (entry.offsetInSSH > 0 ||
+            relocation.slot == recording->m_recordNumResources ||
+            entry.uiPatchOffset < recording->m_recordOffset)
+        {
+            recording->m_recordFailed = true;
+            return;
+        }
+
+        relocation.entry                = entry;
+        relocation.entry.presResource   = nullptr;
+        relocation.entry.cmdBufBase     = nullptr;
+        relocation.entry.uiPatchOffset -= recording->m_recordOffset;
+        recording->m_relocations.push_back(relocation);
+    }
+}
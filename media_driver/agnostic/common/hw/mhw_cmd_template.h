@@ -0,0 +1,201 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mhw_cmd_template.h
+//! \brief    Recorded command segments replayed with new resource addresses
+//! \details  A segment of commands is recorded once with the patch entries of
+//!           its relocations. Each relocation refers to a slot of a resource
+//!           table given by the caller. While the caller's key is unchanged,
+//!           the segment is replayed by copying its bytes to the command buffer
+//!           and adding its patch entries for the resources of the new table.
+//!           The key must cover every input of the segment except the
+//!           resources of the table. Only patch list relocations can be
+//!           recorded.
+//!
+
+#ifndef __MHW_CMD_TEMPLATE_H__
+#define __MHW_CMD_TEMPLATE_H__
+
+#include <vector>
+#include "mos_os.h"
+
+#define MHW_CMD_TEMPLATE_NO_RESOURCE    0xFFFF  //!< Resource slot without resource
+
+class MhwCmdTemplate
+{
+public:
+    //!
+    //! \brief    Constructor
+    //! \param    [in] osInterface
+    //!           OS interface
+    //!
+    MhwCmdTemplate(PMOS_INTERFACE osInterface) : m_osInterface(osInterface) {}
+
+    virtual ~MhwCmdTemplate();
+
+    //!
+    //! \brief    Check if commands can be recorded and replayed
+    //! \return   bool
+    //!           true if the relocations go through the patch list
+    //!
+    bool IsEnabled() const;
+
+    //!
+    //! \brief    Check if the recorded segment can be replayed
+    //! \param    [in] key
+    //!           Inputs of the segment besides its resources
+    //! \param    [in] keySize
+    //!           Size of key in bytes
+    //! \param    [in] resources
+    //!           Resource table, entries may be nullptr or repeated
+    //! \param    [in] numResources
+    //!           Number of resources in the table
+    //! \return   bool
+    //!           true if a segment was recorded with the same key, and the
+    //!           same null and repeated entries in its resource table
+    //!
+    bool Matches(
+        const void      *key,
+        uint32_t        keySize,
+        PMOS_RESOURCE   *resources,
+        uint32_t        numResources);
+
+    //!
+    //! \brief    Start recording the commands added to a command buffer
+    //! \details  Commands are added to the command buffer as usual until
+    //!           EndRecord. Nothing else may be added to it in between.
+    //! \param    [in] cmdBuffer
+    //!           Command buffer
+    //! \param    [in] key
+    //!           Inputs of the segment besides its resources
+    //! \param    [in] keySize
+    //!           Size of key in bytes
+    //! \param    [in] resources
+    //!           Resource table of the segment, every relocation must use one
+    //!           of its resources
+    //! \param    [in] numResources
+    //!           Number of resources in the table
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS BeginRecord(
+        PMOS_COMMAND_BUFFER cmdBuffer,
+        const void          *key,
+        uint32_t            keySize,
+        PMOS_RESOURCE       *resources,
+        uint32_t            numResources);
+
+    //!
+    //! \brief    Stop recording
+    //! \details  The template is left invalid if a relocation could not be
+    //!           recorded. The commands are in the command buffer either way.
+    //! \param    [in] cmdBuffer
+    //!           Command buffer given to BeginRecord
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS EndRecord(
+        PMOS_COMMAND_BUFFER cmdBuffer);
+
+    //!
+    //! \brief    Add the recorded segment to a command buffer
+    //! \details  Registers the resources of the table and adds the patch
+    //!           entries of the segment. Matches must have returned true.
+    //! \param    [in] cmdBuffer
+    //!           Command buffer
+    //! \param    [in] resources
+    //!           Resource table of this segment
+    //! \param    [in] numResources
+    //!           Number of resources in the table
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Replay(
+        PMOS_COMMAND_BUFFER cmdBuffer,
+        PMOS_RESOURCE       *resources,
+        uint32_t            numResources);
+
+    //!
+    //! \brief    Drop the recorded segment
+    //!
+    void Invalidate();
+
+    //!
+    //! \brief    Record patch entries added to a command buffer
+    //! \details  Called by MHW for every patch entry it builds, does nothing
+    //!           unless a template records this command buffer on this thread.
+    //! \param    [in] cmdBuffer
+    //!           Command buffer of the patch entries
+    //! \param    [in] entries
+    //!           Patch entries
+    //! \param    [in] numEntries
+    //!           Number of patch entries
+    //!
+    static void RecordPatchEntries(
+        PMOS_COMMAND_BUFFER     cmdBuffer,
+        PMOS_PATCH_ENTRY_PARAMS entries,
+        uint32_t                numEntries);
+
+protected:
+    //!
+    //! \brief    Patch entry of a recorded relocation
+    //!
+    struct Relocation
+    {
+        MOS_PATCH_ENTRY_PARAMS  entry;      //!< Patch offset relative to the segment, no resource
+        uint32_t                slot;       //!< Resource table slot
+    };
+
+    //!
+    //! \brief    Get the first slot holding the resource of each slot
+    //! \param    [in] resources
+    //!           Resource table
+    //! \param    [in] numResources
+    //!           Number of resources in the table
+    //! \param    [out] aliases
+    //!           First slot of each slot, MHW_CMD_TEMPLATE_NO_RESOURCE if empty
+    //!
+    static void GetAliases(
+        PMOS_RESOURCE           *resources,
+        uint32_t                numResources,
+        std::vector<uint16_t>   &aliases);
+
+    PMOS_INTERFACE                      m_osInterface = nullptr;
+    bool                                m_valid = false;            //!< A segment is recorded
+    std::vector<uint8_t>                m_key;                      //!< Key of the recorded segment
+    std::vector<uint16_t>               m_aliases;                  //!< Aliases of the recorded resource table
+    std::vector<uint8_t>                m_cmds;                     //!< Recorded commands
+    std::vector<Relocation>             m_relocations;              //!< Recorded relocations
+    std::vector<MOS_PATCH_ENTRY_PARAMS> m_patchEntries;             //!< Patch entries of a replay
+    std::vector<uint16_t>               m_replayAliases;            //!< Aliases of the resource table to match
+
+    // Recording state
+    PMOS_COMMAND_BUFFER                 m_recordCmdBuffer = nullptr;
+    PMOS_RESOURCE                       *m_recordResources = nullptr;
+    uint32_t                            m_recordNumResources = 0;
+    uint32_t                            m_recordOffset = 0;
+    bool                                m_recordFailed = false;
+
+    static thread_local MhwCmdTemplate  *m_recording;               //!< Template recording on this thread
+};
+
+#endif // __MHW_CMD_TEMPLATE_H__
@@ -672,6 +672,14 @@ public:
     //!
     virtual MOS_STATUS SetWatchdogTimerThreshold(uint32_t frameWidth, uint32_t frameHeight, bool isEncoder = true) = 0;
 
+    //!
+    //! \brief    Get Watchdog Timer Threshold
+    //! \details  Get the threshold programmed by AddWatchdogTimerStartCmd
+    //! \return   uint32_t
+    //!           Watchdog timer threshold in milliseconds
+    //!
+    uint32_t GetWatchdogTimerThreshold() { return MediaResetParam.watchdogCountThreshold; }
+
     //!
     //! \brief    Set Watchdog Timer Register Offset
     //! \details  Set Watchdog Timer Register Offset
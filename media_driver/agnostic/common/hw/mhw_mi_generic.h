@@ -305,7 +305,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pOsResource);
 
-        typename TMiCmds::MI_STORE_DATA_IMM_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_STORE_DATA_IMM_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         MHW_RESOURCE_PARAMS                 resourceParams;
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
         resourceParams.presResource     = params->pOsResource;
@@ -328,7 +330,7 @@ public:
 
         cmd.DW3.DataDword0 = params->dwValue;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -342,7 +344,9 @@ public:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMiCmds::MI_FLUSH_DW_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_FLUSH_DW_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         // set the protection bit based on CP status
         MHW_MI_CHK_STATUS(m_cpInterface->SetProtectionSettingsForMiFlushDw(m_osInterface, &cmd));
@@ -386,7 +390,7 @@ public:
             cmd.DW0.DwordLength--;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -402,7 +406,9 @@ public:
         MHW_MI_CHK_NULL(params->presSrc);
         MHW_MI_CHK_NULL(params->presDst);
 
-        typename TMiCmds::MI_COPY_MEM_MEM_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_COPY_MEM_MEM_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         cmd.DW0.UseGlobalGttDestination = IsGlobalGttInUse();
         cmd.DW0.UseGlobalGttSource      = IsGlobalGttInUse();
 
@@ -435,7 +441,7 @@ public:
             cmdBuffer,
             &resourceParams));
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -450,7 +456,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->presStoreBuffer);
 
-        typename TMiCmds::MI_STORE_REGISTER_MEM_CMD  cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_STORE_REGISTER_MEM_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         MHW_RESOURCE_PARAMS                 resourceParams;
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
         resourceParams.presResource     = params->presStoreBuffer;
@@ -469,7 +477,7 @@ public:
         cmd.DW0.UseGlobalGtt = IsGlobalGttInUse();
         cmd.DW1.RegisterAddress = params->dwRegister >> 2;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -484,7 +492,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->presStoreBuffer);
 
-        typename TMiCmds::MI_LOAD_REGISTER_MEM_CMD   cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_LOAD_REGISTER_MEM_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         MHW_RESOURCE_PARAMS                 resourceParams;
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
         resourceParams.presResource     = params->presStoreBuffer;
@@ -503,7 +513,7 @@ public:
         cmd.DW0.UseGlobalGtt    = IsGlobalGttInUse();
         cmd.DW1.RegisterAddress = params->dwRegister >> 2;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -517,11 +527,13 @@ public:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMiCmds::MI_LOAD_REGISTER_IMM_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_LOAD_REGISTER_IMM_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         cmd.DW1.RegisterOffset = params->dwRegister >> 2;
         cmd.DW2.DataDword = params->dwData;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -535,11 +547,13 @@ public:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMiCmds::MI_LOAD_REGISTER_REG_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_LOAD_REGISTER_REG_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         cmd.DW1.SourceRegisterAddress = params->dwSrcRegister >> 2;
         cmd.DW2.DestinationRegisterAddress = params->dwDstRegister >> 2;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -559,10 +573,12 @@ public:
             return MOS_STATUS_INVALID_PARAMETER;
         }
 
-        typename TMiCmds::MI_MATH_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_MATH_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         cmd.DW0.DwordLength = params->dwNumAluParams - 1;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         MHW_MI_CHK_STATUS(Mos_AddCommand(
             cmdBuffer,
@@ -580,9 +596,11 @@ public:
 
         MHW_MI_CHK_NULL(cmdBuffer);
 
-        typename TMiCmds::MI_SET_PREDICATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_SET_PREDICATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         cmd.DW0.PredicateEnable = enableFlag;
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -597,7 +615,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pOsResource);
 
-        typename TMiCmds::MI_ATOMIC_CMD  cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_ATOMIC_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         MHW_RESOURCE_PARAMS     resourceParams;
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
         resourceParams.presResource = params->pOsResource;
@@ -671,7 +691,7 @@ public:
             cmd.DW10.Operand2DataDword3 = params->dwOperand2Data[3];
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -686,7 +706,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->presSemaphoreMem);
 
-        typename TMiCmds::MI_SEMAPHORE_WAIT_CMD  cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_SEMAPHORE_WAIT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         MHW_RESOURCE_PARAMS             resourceParams;
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
         resourceParams.presResource     = params->presSemaphoreMem;
@@ -707,7 +729,7 @@ public:
         cmd.DW0.CompareOperation    = params->CompareOperation;
         cmd.DW1.SemaphoreDataDword  = params->dwSemaphoreData;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -719,8 +741,10 @@ public:
 
         MHW_MI_CHK_NULL(cmdBuffer);
 
-        typename TMiCmds::MI_ARB_CHECK_CMD cmd;
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        auto cmdPtr = Mhw_ReserveCommand<typename TMiCmds::MI_ARB_CHECK_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -942,6 +942,11 @@ public:
 
     uint32_t GetSizeofSamplerStateAvs() { return m_HwSizes.dwSizeSamplerStateAvs;};
 
+    uint32_t GetSshCurrOffset() { return m_SurfaceStateHeap.dwCurrOffset; };
+
+    //! Place the next SSH space assigned to a kernel at a fixed offset of the command buffer SSH
+    void SetSshCurrOffset(uint32_t dwOffset) { m_SurfaceStateHeap.dwCurrOffset = dwOffset; };
+
     //!
     //! \brief    Initializes the MI StateHeap interface
     //! \details  Internal MHW function to initialize all function pointers and some parameters
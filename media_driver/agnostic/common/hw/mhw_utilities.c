@@ -26,6 +26,7 @@
 #include "mhw_utilities.h"
 #include "mhw_render.h"
 #include "mhw_state_heap.h"
+#include "mhw_cmd_template.h"
 
 #define MHW_NS_PER_TICK_RENDER_ENGINE 80  // 80 nano seconds per tick in render engine
 
@@ -147,35 +148,45 @@ finish:
 }
 
 //!
-//! \brief    Adds resources to a patch list
-//! \details  Internal MHW function to put resources to be added to the command
-//!           buffer or indirect state into a patch list for patch later
+//! \brief    Registers a resource and builds its patch entries
+//! \details  Internal MHW function to register a resource to be added to the
+//!           command buffer or indirect state and build the patch entries of
+//!           its address, and of its upper bound if any
 //! \param    PMOS_INTERFACE pOsInterface
 //!           [in] OS interface
 //! \param    PMOS_COMMAND_BUFFER pCmdBuffer
 //!           [in] Command buffer
 //! \param    PMHW_RESOURCE_PARAMS pParams
 //!           [in] Parameters necessary to add the resource to the patch list
+//! \param    PMOS_PATCH_ENTRY_PARAMS pPatchEntries
+//!           [out] Room for MHW_MAX_PATCH_ENTRIES_PER_RESOURCE patch entries
+//! \param    uint32_t *pdwNumPatchEntries
+//!           [out] Number of patch entries built
 //! \return   MOS_STATUS
 //!           MOS_STATUS_SUCCESS if success, else fail reason
 //!
-MOS_STATUS Mhw_AddResourceToCmd_PatchList(
+static MOS_STATUS Mhw_GetPatchEntries(
     PMOS_INTERFACE              pOsInterface,
     PMOS_COMMAND_BUFFER         pCmdBuffer,
-    PMHW_RESOURCE_PARAMS        pParams)
+    PMHW_RESOURCE_PARAMS        pParams,
+    PMOS_PATCH_ENTRY_PARAMS     pPatchEntries,
+    uint32_t                    *pdwNumPatchEntries)
 {
-    MOS_GPU_CONTEXT         GpuContext;
     int32_t                 iAllocationIndex;
     uint32_t                dwLsbNum, dwUpperBoundOffset;
     uint32_t                dwOffset;
     uint32_t                uiPatchOffset;
-    MOS_PATCH_ENTRY_PARAMS  PatchEntryParams;
+    PMOS_PATCH_ENTRY_PARAMS pPatchEntryParams;
     MOS_STATUS              eStatus = MOS_STATUS_SUCCESS;
 
     MHW_CHK_NULL(pOsInterface);
     MHW_CHK_NULL(pParams);
     MHW_CHK_NULL(pParams->presResource);
     MHW_CHK_NULL(pCmdBuffer);
+    MHW_CHK_NULL(pPatchEntries);
+    MHW_CHK_NULL(pdwNumPatchEntries);
+
+    *pdwNumPatchEntries = 0;
 
     MHW_CHK_STATUS(pOsInterface->pfnRegisterResource(
         pOsInterface,
@@ -183,7 +194,6 @@ MOS_STATUS Mhw_AddResourceToCmd_PatchList(
         pParams->bIsWritable ? true : false,
         pParams->bIsWritable ? true : false));
 
-    GpuContext = pOsInterface->pfnGetGpuContext(pOsInterface);
     iAllocationIndex = pOsInterface->pfnGetResourceAllocationIndex(pOsInterface, pParams->presResource);
     dwLsbNum = pParams->dwLsbNum;
 
@@ -201,33 +211,30 @@ MOS_STATUS Mhw_AddResourceToCmd_PatchList(
         uiPatchOffset = pCmdBuffer->iOffset + (pParams->dwLocationInCmd * sizeof(uint32_t));
     }
 
-    MOS_ZeroMemory(&PatchEntryParams, sizeof(PatchEntryParams));
-    PatchEntryParams.uiAllocationIndex = iAllocationIndex;
+    // Patch entry of the address field for this command
+    pPatchEntryParams = &pPatchEntries[(*pdwNumPatchEntries)++];
+    MOS_ZeroMemory(pPatchEntryParams, sizeof(*pPatchEntryParams));
+    pPatchEntryParams->uiAllocationIndex = iAllocationIndex;
     if(pParams->patchType == MOS_PATCH_TYPE_UV_Y_OFFSET ||
        pParams->patchType == MOS_PATCH_TYPE_PITCH ||
        pParams->patchType == MOS_PATCH_TYPE_V_Y_OFFSET)
     {
-        PatchEntryParams.uiResourceOffset = *pParams->pdwCmd;
+        pPatchEntryParams->uiResourceOffset = *pParams->pdwCmd;
     }
     else
     {
-        PatchEntryParams.uiResourceOffset = dwOffset;
+        pPatchEntryParams->uiResourceOffset = dwOffset;
     }
-    PatchEntryParams.uiPatchOffset    = uiPatchOffset;
-    PatchEntryParams.bWrite           = pParams->bIsWritable;
-    PatchEntryParams.HwCommandType    = pParams->HwCommandType;
-    PatchEntryParams.forceDwordOffset = pParams->dwSharedMocsOffset;
-    PatchEntryParams.cmdBufBase       = (uint8_t*)pCmdBuffer->pCmdBase;
-    PatchEntryParams.presResource     = pParams->presResource;
-    PatchEntryParams.patchType        = pParams->patchType;
-    PatchEntryParams.shiftAmount      = pParams->shiftAmount;
-    PatchEntryParams.shiftDirection   = pParams->shiftDirection;
-    PatchEntryParams.offsetInSSH      = pParams->dwOffsetInSSH;
-
-    // Add patch entry to patch the address field for this command
-    MHW_CHK_STATUS(pOsInterface->pfnSetPatchEntry(
-        pOsInterface,
-        &PatchEntryParams));
+    pPatchEntryParams->uiPatchOffset    = uiPatchOffset;
+    pPatchEntryParams->bWrite           = pParams->bIsWritable;
+    pPatchEntryParams->HwCommandType    = pParams->HwCommandType;
+    pPatchEntryParams->forceDwordOffset = pParams->dwSharedMocsOffset;
+    pPatchEntryParams->cmdBufBase       = (uint8_t*)pCmdBuffer->pCmdBase;
+    pPatchEntryParams->presResource     = pParams->presResource;
+    pPatchEntryParams->patchType        = pParams->patchType;
+    pPatchEntryParams->shiftAmount      = pParams->shiftAmount;
+    pPatchEntryParams->shiftDirection   = pParams->shiftDirection;
+    pPatchEntryParams->offsetInSSH      = pParams->dwOffsetInSSH;
 
     if (pParams->dwUpperBoundLocationOffsetFromCmd > 0)
     {
@@ -241,29 +248,152 @@ MOS_STATUS Mhw_AddResourceToCmd_PatchList(
         // Calculate the patch offset to command buffer
         uiPatchOffset += dwUpperBoundOffset * sizeof(uint32_t);
 
-        MOS_ZeroMemory(&PatchEntryParams, sizeof(PatchEntryParams));
-        PatchEntryParams.uiAllocationIndex = iAllocationIndex;
-        PatchEntryParams.uiResourceOffset = dwOffset;
-        PatchEntryParams.uiPatchOffset    = uiPatchOffset;
-        PatchEntryParams.bUpperBoundPatch = true;
-        PatchEntryParams.presResource     = pParams->presResource;
-        PatchEntryParams.patchType        = pParams->patchType;
-        PatchEntryParams.shiftAmount      = pParams->shiftAmount;
-        PatchEntryParams.shiftDirection   = pParams->shiftDirection;
-        PatchEntryParams.offsetInSSH      = pParams->dwOffsetInSSH;
+        // Patch entry of the upper bound field for this command
+        pPatchEntryParams = &pPatchEntries[(*pdwNumPatchEntries)++];
+        MOS_ZeroMemory(pPatchEntryParams, sizeof(*pPatchEntryParams));
+        pPatchEntryParams->uiAllocationIndex = iAllocationIndex;
+        pPatchEntryParams->uiResourceOffset = dwOffset;
+        pPatchEntryParams->uiPatchOffset    = uiPatchOffset;
+        pPatchEntryParams->bUpperBoundPatch = true;
+        pPatchEntryParams->presResource     = pParams->presResource;
+        pPatchEntryParams->patchType        = pParams->patchType;
+        pPatchEntryParams->shiftAmount      = pParams->shiftAmount;
+        pPatchEntryParams->shiftDirection   = pParams->shiftDirection;
+        pPatchEntryParams->offsetInSSH      = pParams->dwOffsetInSSH;
 
         if(dwLsbNum)
         {
-            PatchEntryParams.shiftAmount = dwLsbNum;
-            PatchEntryParams.shiftDirection = 0;
+            pPatchEntryParams->shiftAmount = dwLsbNum;
+            pPatchEntryParams->shiftDirection = 0;
         }
+    }
 
-        // Add patch entry to patch the address field for this command
-        MHW_CHK_STATUS(pOsInterface->pfnSetPatchEntry(
+finish:
+    return eStatus;
+}
+
+//!
+//! \brief    Adds resources to a patch list
+//! \details  Internal MHW function to put resources to be added to the command
+//!           buffer or indirect state into a patch list for patch later
+//! \param    PMOS_INTERFACE pOsInterface
+//!           [in] OS interface
+//! \param    PMOS_COMMAND_BUFFER pCmdBuffer
+//!           [in] Command buffer
+//! \param    PMHW_RESOURCE_PARAMS pParams
+//!           [in] Parameters necessary to add the resource to the patch list
+//! \return   MOS_STATUS
+//!           MOS_STATUS_SUCCESS if success, else fail reason
+//!
+MOS_STATUS Mhw_AddResourceToCmd_PatchList(
+    PMOS_INTERFACE              pOsInterface,
+    PMOS_COMMAND_BUFFER         pCmdBuffer,
+    PMHW_RESOURCE_PARAMS        pParams)
+{
+    MOS_PATCH_ENTRY_PARAMS  PatchEntryParams[MHW_MAX_PATCH_ENTRIES_PER_RESOURCE];
+    uint32_t                dwNumPatchEntries = 0;
+    MOS_STATUS              eStatus = MOS_STATUS_SUCCESS;
+
+    MHW_CHK_NULL(pOsInterface);
+
+    MHW_CHK_STATUS(Mhw_GetPatchEntries(
+        pOsInterface,
+        pCmdBuffer,
+        pParams,
+        PatchEntryParams,
+        &dwNumPatchEntries));
+
+    MhwCmdTemplate::RecordPatchEntries(pCmdBuffer, PatchEntryParams, dwNumPatchEntries);
+
+    // Add patch entries (CP won't register the upper bound patch point since bUpperBoundPatch = true)
+    MHW_CHK_STATUS(pOsInterface->pfnSetPatchEntries(
+        pOsInterface,
+        PatchEntryParams,
+        dwNumPatchEntries));
+
+finish:
+    return eStatus;
+}
+
+//!
+//! \brief    Adds several resources of one command to the command buffer
+//! \details  Same as calling pfnAddResourceToCmd for each resource. With the
+//!           patch list, the patch entries of all the resources are added to
+//!           the patch list at once. Only the reference picture loops of
+//!           MFX_PIPE_BUF_ADDR_STATE and HCP_PIPE_BUF_ADDR_STATE use it; the
+//!           other resources of these and all other commands still take one
+//!           pfnSetPatchEntries call each, with their upper bound entry.
+//! \param    PMOS_INTERFACE pOsInterface
+//!           [in] OS interface
+//! \param    PMOS_COMMAND_BUFFER pCmdBuffer
+//!           [in] Command buffer
+//! \param    pfnAddResourceToCmd
+//!           [in] AddResourceToCmd function of the calling interface
+//! \param    PMHW_RESOURCE_PARAMS pParams
+//!           [in] Array of dwNumResources resource parameters
+//! \param    uint32_t dwNumResources
+//!           [in] Number of resources
+//! \return   MOS_STATUS
+//!           MOS_STATUS_SUCCESS if success, else fail reason
+//!
+MOS_STATUS Mhw_AddResourcesToCmd(
+    PMOS_INTERFACE              pOsInterface,
+    PMOS_COMMAND_BUFFER         pCmdBuffer,
+    MOS_STATUS                  (*pfnAddResourceToCmd)(PMOS_INTERFACE, PMOS_COMMAND_BUFFER, PMHW_RESOURCE_PARAMS),
+    PMHW_RESOURCE_PARAMS        pParams,
+    uint32_t                    dwNumResources)
+{
+    MOS_PATCH_ENTRY_PARAMS  PatchEntryParams[MHW_MAX_BATCHED_PATCH_ENTRIES];
+    uint32_t                dwNumPatchEntries = 0;
+    uint32_t                dwResourcePatchEntries;
+    MOS_STATUS              eStatus = MOS_STATUS_SUCCESS;
+
+    MHW_CHK_NULL(pOsInterface);
+    MHW_CHK_NULL(pfnAddResourceToCmd);
+
+    if (dwNumResources == 0)
+    {
+        goto finish;
+    }
+
+    MHW_CHK_NULL(pParams);
+
+    if (pfnAddResourceToCmd != Mhw_AddResourceToCmd_PatchList)
+    {
+        for (uint32_t i = 0; i < dwNumResources; i++)
+        {
+            MHW_CHK_STATUS(pfnAddResourceToCmd(pOsInterface, pCmdBuffer, &pParams[i]));
+        }
+        goto finish;
+    }
+
+    for (uint32_t i = 0; i < dwNumResources; i++)
+    {
+        if (dwNumPatchEntries + MHW_MAX_PATCH_ENTRIES_PER_RESOURCE > MHW_MAX_BATCHED_PATCH_ENTRIES)
+        {
+            MhwCmdTemplate::RecordPatchEntries(pCmdBuffer, PatchEntryParams, dwNumPatchEntries);
+            MHW_CHK_STATUS(pOsInterface->pfnSetPatchEntries(
+                pOsInterface,
+                PatchEntryParams,
+                dwNumPatchEntries));
+            dwNumPatchEntries = 0;
+        }
+
+        MHW_CHK_STATUS(Mhw_GetPatchEntries(
             pOsInterface,
-            &PatchEntryParams));
+            pCmdBuffer,
+            &pParams[i],
+            &PatchEntryParams[dwNumPatchEntries],
+            &dwResourcePatchEntries));
+        dwNumPatchEntries += dwResourcePatchEntries;
     }
 
+    MhwCmdTemplate::RecordPatchEntries(pCmdBuffer, PatchEntryParams, dwNumPatchEntries);
+    MHW_CHK_STATUS(pOsInterface->pfnSetPatchEntries(
+        pOsInterface,
+        PatchEntryParams,
+        dwNumPatchEntries));
+
 finish:
     return eStatus;
 }
@@ -316,11 +446,11 @@ finish:
 }
 
 //!
-//! \brief    Inserts the generic prologue command for a command buffer
-//! \details  Client facing function to add the generic prologue commands:
-//!               - the command buffer header (if necessary)
-//!               - flushes for the read/write caches (MI_FLUSH_DW or PIPE_CONTROL)
-//!               - CP prologue if necessary
+//! \brief    Inserts the invariant part of the generic prologue
+//! \details  Adds the commands of the generic prologue which only depend on
+//!           the GPU context: the watchdog timer start. They have no
+//!           relocations, so they may be built once into a batch buffer and
+//!           reused for every command buffer of the GPU context.
 //! \param    PMOS_COMMAND_BUFFER pCmdBuffer
 //!           [in] Command buffer
 //! \param    PMHW_GENERIC_PROLOG_PARAMS pParams
@@ -328,18 +458,13 @@ finish:
 //! \return   MOS_STATUS
 //!           MOS_STATUS_SUCCESS if success, else fail reason
 //!
-MOS_STATUS Mhw_SendGenericPrologCmd (
+MOS_STATUS Mhw_SendGenericPrologInvariantCmd(
     PMOS_COMMAND_BUFFER         pCmdBuffer,
     PMHW_GENERIC_PROLOG_PARAMS  pParams)
 {
     PMOS_INTERFACE                  pOsInterface;
     MhwMiInterface                  *pMiInterface;
-    MEDIA_FEATURE_TABLE             *pSkuTable;
-    MEDIA_WA_TABLE                  *pWaTable;
     MOS_GPU_CONTEXT                 GpuContext;
-    MHW_PIPE_CONTROL_PARAMS         PipeControlParams;
-    MHW_MI_FLUSH_DW_PARAMS          FlushDwParams;
-    bool                            bRcsEngineUsed = false;
     MOS_STATUS                      eStatus = MOS_STATUS_SUCCESS;
 
     MHW_FUNCTION_ENTER;
@@ -352,12 +477,6 @@ MOS_STATUS Mhw_SendGenericPrologCmd (
 
     MHW_CHK_NULL(pParams->pvMiInterface);
     pMiInterface = (MhwMiInterface *)pParams->pvMiInterface;
-    MHW_CHK_NULL(pMiInterface);
-
-    pSkuTable = pOsInterface->pfnGetSkuTable(pOsInterface);
-    MHW_CHK_NULL(pSkuTable);
-    pWaTable = pOsInterface->pfnGetWaTable(pOsInterface);
-    MHW_CHK_NULL(pWaTable);
 
     GpuContext = pOsInterface->pfnGetGpuContext(pOsInterface);
 
@@ -383,6 +502,62 @@ MOS_STATUS Mhw_SendGenericPrologCmd (
         }
     }
 
+finish:
+    return eStatus;
+}
+
+//!
+//! \brief    Inserts the generic prologue command for a command buffer
+//! \details  Client facing function to add the generic prologue commands:
+//!               - the invariant commands, unless pParams->bSkipInvariantCmds
+//!               - the command buffer header (if necessary)
+//!               - flushes for the read/write caches (MI_FLUSH_DW or PIPE_CONTROL)
+//!               - CP prologue if necessary
+//! \param    PMOS_COMMAND_BUFFER pCmdBuffer
+//!           [in] Command buffer
+//! \param    PMHW_GENERIC_PROLOG_PARAMS pParams
+//!           [in] Parameters necessary to add the generic prologue commands
+//! \return   MOS_STATUS
+//!           MOS_STATUS_SUCCESS if success, else fail reason
+//!
+MOS_STATUS Mhw_SendGenericPrologCmd (
+    PMOS_COMMAND_BUFFER         pCmdBuffer,
+    PMHW_GENERIC_PROLOG_PARAMS  pParams)
+{
+    PMOS_INTERFACE                  pOsInterface;
+    MhwMiInterface                  *pMiInterface;
+    MEDIA_FEATURE_TABLE             *pSkuTable;
+    MEDIA_WA_TABLE                  *pWaTable;
+    MOS_GPU_CONTEXT                 GpuContext;
+    MHW_PIPE_CONTROL_PARAMS         PipeControlParams;
+    MHW_MI_FLUSH_DW_PARAMS          FlushDwParams;
+    bool                            bRcsEngineUsed = false;
+    MOS_STATUS                      eStatus = MOS_STATUS_SUCCESS;
+
+    MHW_FUNCTION_ENTER;
+
+    MHW_CHK_NULL(pCmdBuffer);
+    MHW_CHK_NULL(pParams);
+    MHW_CHK_NULL(pParams->pOsInterface);
+
+    pOsInterface = pParams->pOsInterface;
+
+    MHW_CHK_NULL(pParams->pvMiInterface);
+    pMiInterface = (MhwMiInterface *)pParams->pvMiInterface;
+    MHW_CHK_NULL(pMiInterface);
+
+    pSkuTable = pOsInterface->pfnGetSkuTable(pOsInterface);
+    MHW_CHK_NULL(pSkuTable);
+    pWaTable = pOsInterface->pfnGetWaTable(pOsInterface);
+    MHW_CHK_NULL(pWaTable);
+
+    GpuContext = pOsInterface->pfnGetGpuContext(pOsInterface);
+
+    if (!pParams->bSkipInvariantCmds)
+    {
+        MHW_CHK_STATUS(Mhw_SendGenericPrologInvariantCmd(pCmdBuffer, pParams));
+    }
+
     bRcsEngineUsed = MOS_RCS_ENGINE_USED(GpuContext);
 
     if (bRcsEngineUsed)
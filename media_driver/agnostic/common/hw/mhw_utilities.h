@@ -28,6 +28,7 @@
 
 #include "mos_os.h"
 #include <math.h>
+#include <new>
 #include "mos_util_debug.h"
 #include "mhw_mmio.h"
 
@@ -40,6 +41,9 @@ typedef struct _MHW_BATCH_BUFFER MHW_BATCH_BUFFER, *PMHW_BATCH_BUFFER;
 #define MHW_TIMEOUT_MS_DEFAULT  1000
 #define MHW_EVENT_TIMEOUT_MS    5
 
+#define MHW_MAX_PATCH_ENTRIES_PER_RESOURCE  2   //!< Address and upper bound
+#define MHW_MAX_BATCHED_PATCH_ENTRIES       64  //!< Patch entries added to the patch list at once by Mhw_AddResourcesToCmd
+
 #define MHW_WIDTH_IN_DW(w)  ((w + 0x3) >> 2)
 
 #define MHW_AVS_TBL_COEF_PREC   6           //!< Table coef precision (after decimal point
@@ -621,6 +625,7 @@ typedef struct _MHW_GENERIC_PROLOG_PARAMS
     PMOS_RESOURCE               presStoreData;
     uint32_t                    dwStoreDataOffset;
     uint32_t                    dwStoreDataValue;
+    bool                        bSkipInvariantCmds;     //!< Invariant commands were added by the caller
 } MHW_GENERIC_PROLOG_PARAMS, *PMHW_GENERIC_PROLOG_PARAMS;
 
 MOS_STATUS Mhw_AddResourceToCmd_GfxAddress(
@@ -633,6 +638,13 @@ MOS_STATUS Mhw_AddResourceToCmd_PatchList(
     PMOS_COMMAND_BUFFER         pCmdBuffer,
     PMHW_RESOURCE_PARAMS        pParams);
 
+MOS_STATUS Mhw_AddResourcesToCmd(
+    PMOS_INTERFACE              pOsInterface,
+    PMOS_COMMAND_BUFFER         pCmdBuffer,
+    MOS_STATUS                  (*pfnAddResourceToCmd)(PMOS_INTERFACE, PMOS_COMMAND_BUFFER, PMHW_RESOURCE_PARAMS),
+    PMHW_RESOURCE_PARAMS        pParams,
+    uint32_t                    dwNumResources);
+
 MOS_STATUS Mhw_SurfaceFormatToType(
     uint32_t                    dwForceSurfaceFormat,
     PMOS_SURFACE                psSurface,
@@ -642,6 +654,10 @@ MOS_STATUS Mhw_SendGenericPrologCmd(
     PMOS_COMMAND_BUFFER         pCmdBuffer,
     PMHW_GENERIC_PROLOG_PARAMS  pParams);
 
+MOS_STATUS Mhw_SendGenericPrologInvariantCmd(
+    PMOS_COMMAND_BUFFER         pCmdBuffer,
+    PMHW_GENERIC_PROLOG_PARAMS  pParams);
+
 MOS_STATUS Mhw_SetNearestModeTable(
     int32_t         *iCoefs,
     uint32_t        dwPlane,
@@ -757,4 +773,42 @@ static __inline MOS_STATUS Mhw_AddCommandCmdOrBB(
     }
 }
 
+//!
+//! \brief    Reserve a command in the command buffer and construct it in place
+//! \details  The command is built directly in the command buffer instead of on
+//!           the stack and copied by Mos_AddCommand. It must be committed by
+//!           Mhw_CommitCommand before anything else is added to the buffer,
+//!           an uncommitted command is overwritten by the next one. Commands
+//!           with 64 bit fields are staged when the buffer is only dword aligned.
+//! \param    [in] cmdBuffer
+//!           Pointer to Command Buffer
+//! \return   TCmd *
+//!           Default constructed command, nullptr if no space
+//!
+template <class TCmd>
+static __inline TCmd *Mhw_ReserveCommand(PMOS_COMMAND_BUFFER cmdBuffer)
+{
+    static_assert(alignof(TCmd) <= sizeof(uint32_t) ||
+        (alignof(TCmd) <= MOS_CMD_STAGING_ALIGNMENT && TCmd::byteSize <= MOS_CMD_STAGING_SIZE),
+        "Command cannot be staged when the command buffer is not aligned for it");
+
+    void *cmd = Mos_ReserveCommand(cmdBuffer, TCmd::byteSize, alignof(TCmd));
+    return cmd ? new (cmd) TCmd : nullptr;
+}
+
+//!
+//! \brief    Commit a command reserved by Mhw_ReserveCommand
+//! \param    [in] cmdBuffer
+//!           Pointer to Command Buffer
+//! \param    [in] cmd
+//!           Command returned by Mhw_ReserveCommand
+//! \return   MOS_STATUS
+//!           MOS_STATUS_SUCCESS if succeeded, else error code
+//!
+template <class TCmd>
+static __inline MOS_STATUS Mhw_CommitCommand(PMOS_COMMAND_BUFFER cmdBuffer, const TCmd *cmd)
+{
+    return Mos_CommitCommand(cmdBuffer, cmd, TCmd::byteSize);
+}
+
 #endif // __MHW_UTILITIES_H__
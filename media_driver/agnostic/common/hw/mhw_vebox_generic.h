@@ -95,8 +95,9 @@ public:
     {
         MOS_STATUS eStatus;
         bool       bOutputValid;
+        uint32_t   dwInputFormat;
 
-        typename TVeboxCmds::VEBOX_SURFACE_STATE_CMD cmd1, cmd2;
+        typename TVeboxCmds::VEBOX_SURFACE_STATE_CMD *cmd1, *cmd2;
 
         MHW_CHK_NULL(pCmdBuffer);
         MHW_CHK_NULL(pVeboxSurfaceStateCmdParams);
@@ -105,33 +106,39 @@ public:
         bOutputValid = pVeboxSurfaceStateCmdParams->bOutputValid;
 
         // Setup Surface State for Input surface
+        cmd1 = Mhw_ReserveCommand<typename TVeboxCmds::VEBOX_SURFACE_STATE_CMD>(pCmdBuffer);
+        MHW_CHK_NULL(cmd1);
         SetVeboxSurfaces(
             &pVeboxSurfaceStateCmdParams->SurfInput,
             &pVeboxSurfaceStateCmdParams->SurfSTMM,
             nullptr,
-            &cmd1,
+            cmd1,
             false,
             pVeboxSurfaceStateCmdParams->bDIEnable);
-        Mos_AddCommand(pCmdBuffer, &cmd1, cmd1.byteSize);
+        // cmd1 may be overwritten by cmd2 once committed
+        dwInputFormat = cmd1->DW3.SurfaceFormat;
+        MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, cmd1));
 
         // Setup Surface State for Output surface
         if (bOutputValid)
         {
+            cmd2 = Mhw_ReserveCommand<typename TVeboxCmds::VEBOX_SURFACE_STATE_CMD>(pCmdBuffer);
+            MHW_CHK_NULL(cmd2);
             SetVeboxSurfaces(
                 &pVeboxSurfaceStateCmdParams->SurfOutput,
                 &pVeboxSurfaceStateCmdParams->SurfDNOutput,
                 &pVeboxSurfaceStateCmdParams->SurfSkinScoreOutput,
-                &cmd2,
+                cmd2,
                 true,
                 pVeboxSurfaceStateCmdParams->bDIEnable);
 
             // Reset Output Format When Input/Output Format are the same
             if (pVeboxSurfaceStateCmdParams->SurfInput.Format == pVeboxSurfaceStateCmdParams->SurfOutput.Format)
             {
-                cmd2.DW3.SurfaceFormat = cmd1.DW3.SurfaceFormat;
+                cmd2->DW3.SurfaceFormat = dwInputFormat;
             }
 
-            Mos_AddCommand(pCmdBuffer, &cmd2, cmd2.byteSize);
+            MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, cmd2));
         }
 
     finish:
@@ -74,7 +74,9 @@ protected:
 
         MHW_MI_CHK_NULL(params->psSurface);
 
-        typename THcpCmds::HCP_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         uint32_t uvPlaneAlignment = m_uvPlaneAlignmentLegacy;
 
         cmd.DW1.SurfaceId = params->ucSurfaceStateId;
@@ -92,7 +94,7 @@ protected:
         cmd.DW2.YOffsetForUCbInPixel =
             MOS_ALIGN_CEIL(params->psSurface->UPlaneOffset.iYOffset, uvPlaneAlignment);
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -110,7 +112,9 @@ protected:
 
         MHW_MI_CHK_NULL(params->psSurface);
 
-        typename THcpCmds::HCP_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.SurfaceId = params->ucSurfaceStateId;
         cmd.DW1.SurfacePitchMinus1 = params->psSurface->dwPitch - 1;
@@ -126,7 +130,7 @@ protected:
 
         cmd.DW2.YOffsetForUCbInPixel = params->psSurface->UPlaneOffset.iYOffset;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -142,7 +146,9 @@ protected:
         MHW_MI_CHK_NULL(params);
 
         MHW_RESOURCE_PARAMS resourceParams;
-        typename THcpCmds::HCP_IND_OBJ_BASE_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_IND_OBJ_BASE_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
         resourceParams.dwLsbNum = MHW_VDBOX_HCP_UPPER_BOUND_STATE_SHIFT;
@@ -172,7 +178,7 @@ protected:
                 &resourceParams));
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -289,7 +295,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pHevcPicParams);
 
-        typename THcpCmds::HCP_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         auto hevcPicParams = params->pHevcPicParams;
 
@@ -339,7 +347,7 @@ protected:
         cmd.DW5.PcmSampleBitDepthChromaMinus1 = hevcPicParams->pcm_sample_bit_depth_chroma_minus1;
         cmd.DW5.PcmSampleBitDepthLumaMinus1 = hevcPicParams->pcm_sample_bit_depth_luma_minus1;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -352,12 +360,14 @@ protected:
 
         MHW_FUNCTION_ENTER;
 
-        typename THcpCmds::HCP_BSD_OBJECT_CMD   cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_BSD_OBJECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.IndirectBsdDataLength = params->dwBsdDataLength;
         cmd.DW2.IndirectDataStartAddress = params->dwBsdDataStartOffset;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -370,7 +380,9 @@ protected:
 
         MHW_FUNCTION_ENTER;
 
-        typename THcpCmds::HCP_TILE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_TILE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pTileColWidth);
@@ -462,7 +474,7 @@ protected:
             cmd.CtbRowPositionOfTileRow[5].DW0.Ctbpos1I = rowCumulativeValue;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -586,7 +598,9 @@ protected:
 
         MHW_MI_CHK_NULL(hevcSliceState);
 
-        typename THcpCmds::HCP_SLICE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_SLICE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         auto hevcSliceParams = hevcSliceState->pHevcSliceParams;
         auto hevcPicParams = hevcSliceState->pHevcPicParams;
@@ -740,7 +754,7 @@ protected:
 
         cmd.DW5.Sliceheaderlength = hevcSliceParams->ByteOffsetToSliceData;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -755,7 +769,9 @@ protected:
 
         MHW_MI_CHK_NULL(hevcSliceState);
 
-        typename THcpCmds::HCP_SLICE_STATE_CMD      cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_SLICE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         auto hevcSliceParams = hevcSliceState->pHevcSliceParams;
         auto hevcPicParams = hevcSliceState->pHevcPicParams;
@@ -925,7 +941,7 @@ protected:
 
         cmd.DW5.Sliceheaderlength = hevcSliceParams->ByteOffsetToSliceData;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -68,7 +68,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pAvcPicIdx);
 
-        typename TMfxCmds::MFD_AVC_PICID_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFD_AVC_PICID_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.PictureidRemappingDisable = 1;
         if (params->bPicIdRemappingInUse)
@@ -99,7 +101,7 @@ protected:
             }
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -817,7 +819,9 @@ protected:
             longTermFrame |= (((uint16_t)longTermFrameFlag) << frameID);
         }
 
-        typename TMfxCmds::MFD_AVC_DPB_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFD_AVC_DPB_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.NonExistingframeFlag161Bit = nonExistingFrameFlags;
         cmd.DW1.LongtermframeFlag161Bit = longTermFrame;
@@ -872,7 +876,7 @@ protected:
             }
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -946,7 +950,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pMpeg2PicParams);
 
-        typename TMfxCmds::MFX_MPEG2_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_MPEG2_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         auto picParams = params->pMpeg2PicParams;
 
         cmd.DW1.ScanOrder = picParams->W0.m_scanOrder;
@@ -1003,7 +1009,7 @@ protected:
         cmd.DW6.Intrambmaxsize = 0xfff;
         cmd.DW6.Intermbmaxsize = 0xfff;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1020,7 +1026,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pEncodeMpeg2PicParams);
 
-        typename TMfxCmds::MFX_MPEG2_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_MPEG2_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         auto picParams = params->pEncodeMpeg2PicParams;
 
         cmd.DW1.ScanOrder = picParams->m_alternateScan;
@@ -1064,7 +1072,7 @@ protected:
         cmd.DW6.Intrambmaxsize = 0xfff;
         cmd.DW6.Intermbmaxsize = 0xfff;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1230,7 +1238,9 @@ protected:
         auto seqParams = mpeg2SliceState->pEncodeMpeg2SeqParams;
         auto slcData = mpeg2SliceState->pSlcData;
 
-        typename TMfxCmds::MFC_MPEG2_SLICEGROUP_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFC_MPEG2_SLICEGROUP_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.Streamid10EncoderOnly = 0;
         cmd.DW1.Sliceid30EncoderOnly = 0;
@@ -1269,7 +1279,7 @@ protected:
         // H/W should use this start addr only for the first slice, since LoadSlicePointerFlag = 0 in PIC_STATE
         cmd.DW4.BitstreamoffsetIndirectPakBseDataStartAddressWrite = 0;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1481,7 +1491,9 @@ protected:
             }
         }
 
-        typename TMfxCmds::MFX_VC1_PRED_PIPE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_VC1_PRED_PIPE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         cmd.DW1.ReferenceFrameBoundaryReplicationMode = refBoundaryReplicationMode.BY0.value;
 
         uint32_t fwdDoubleIcEnable = 0, fwdSingleIcEnable = 0;
@@ -1854,7 +1866,7 @@ protected:
         cmd.DW1.VinIntensitycompSingleFwden = fwdSingleIcEnable;
         cmd.DW1.VinIntensitycompSingleBwden = bwdSingleIcEnable;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1909,7 +1921,9 @@ protected:
         auto destParams = vc1PicState->ppVc1RefList[vc1PicParams->CurrPic.FrameIdx];
         auto fwdRefParams = vc1PicState->ppVc1RefList[vc1PicParams->ForwardRefIdx];
 
-        typename TMfxCmds::MFD_VC1_LONG_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFD_VC1_LONG_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.Picturewidthinmbsminus1PictureWidthMinus1InMacroblocks = widthInMbs - 1;
         cmd.DW1.Pictureheightinmbsminus1PictureHeightMinus1InMacroblocks = frameFieldHeightInMb - 1;
@@ -2106,7 +2120,7 @@ protected:
             cmd.DW5.MvtabMotionVectorTable = vc1PicParams->mv_fields.mv_table;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -2154,7 +2168,9 @@ protected:
             vc1PicParams->picture_fields.is_first_field,
             vc1PicParams->picture_fields.picture_type);
 
-        typename TMfxCmds::MFD_VC1_SHORT_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFD_VC1_SHORT_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         // DW 1
         cmd.DW1.PictureWidth = widthInMbs - 1;
@@ -2234,7 +2250,7 @@ protected:
             cmd.DW4.BfractionEnumeration = vc1PicParams->b_picture_fraction;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -2250,7 +2266,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMfxCmds::MFX_VC1_DIRECTMODE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_VC1_DIRECTMODE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MHW_RESOURCE_PARAMS resourceParams;
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
@@ -2285,7 +2303,7 @@ protected:
             cmdBuffer,
             &resourceParams));
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -2749,7 +2767,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMfxCmds::MFX_JPEG_HUFF_TABLE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_JPEG_HUFF_TABLE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.Hufftableid1Bit = params->HuffTableID;
 
@@ -2780,7 +2800,7 @@ protected:
             (uint8_t*)params->pACValues + sizeof(cmd.AcHuffval1608BitArray), 
             sizeof(uint16_t)));
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -2796,7 +2816,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMfxCmds::MFD_JPEG_BSD_OBJECT_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFD_JPEG_BSD_OBJECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.IndirectDataLength = params->dwIndirectDataLength;
         cmd.DW2.IndirectDataStartAddress = params->dwDataStartAddress;
@@ -2807,7 +2829,7 @@ protected:
         cmd.DW4.Interleaved = params->bInterleaved;
         cmd.DW5.Restartinterval16Bit = params->dwRestartInterval;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -2823,7 +2845,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMfxCmds::MFD_VP8_BSD_OBJECT_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFD_VP8_BSD_OBJECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         auto vp8PicParams = params->pVp8PicParams;
 
         uint8_t numPartitions = (1 << vp8PicParams->CodedCoeffTokenPartition);
@@ -2891,7 +2915,7 @@ protected:
             cmd.DW20.IndirectPartition8DataStartOffset = cmd.DW18.IndirectPartition7DataStartOffset + vp8PicParams->uiPartitionSize[i - 1];
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -236,6 +236,8 @@ struct MhwVdboxJpegScanParams
     uint32_t                                dwPicWidth;
     uint32_t                                dwPicHeight;
     uint32_t                                mode;
+    uint32_t                                dwMcuCount;         //!< MCUs of the scan, 0 for the MCUs of the picture
+    bool                                    isLastScan;         //!< Last scan of the picture
 };
 
 typedef struct _MHW_VDBOX_VP8_PIC_STATE
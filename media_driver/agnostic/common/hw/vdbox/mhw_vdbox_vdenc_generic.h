@@ -60,7 +60,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TVdencCmds::VD_PIPELINE_FLUSH_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VD_PIPELINE_FLUSH_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.HevcPipelineDone           = params->Flags.bWaitDoneHEVC;
         cmd.DW1.VdencPipelineDone          = params->Flags.bWaitDoneVDENC;
@@ -72,7 +74,7 @@ protected:
         cmd.DW1.MflPipelineCommandFlush    = params->Flags.bFlushMFL;
         cmd.DW1.MfxPipelineCommandFlush    = params->Flags.bFlushMFX;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -86,7 +88,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TVdencCmds::VDENC_CONST_QPT_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_CONST_QPT_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1_10.QpLambdaArrayIndex[0]  = 1;
         cmd.DW1_10.QpLambdaArrayIndex[1]  = 1;
@@ -287,7 +291,7 @@ protected:
             }
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
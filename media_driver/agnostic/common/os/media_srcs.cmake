@@ -21,6 +21,7 @@
 set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_context.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_graphicsresource.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_memory_pool.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_os.c
     ${CMAKE_CURRENT_LIST_DIR}/mos_util_debug.c
     ${CMAKE_CURRENT_LIST_DIR}/mos_util_user_interface.cpp
@@ -36,6 +37,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/mos_context.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_defs.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_graphicsresource.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_memory_pool.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_os.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_os_hw.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_os_trace_event.h
@@ -0,0 +1,247 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_memory_pool.cpp
+//! \brief    Size-class slab pool for small system memory allocations
+//!
+
+#include "mos_memory_pool.h"
+
+//! Depot lock, statically initialized in the OS specific utilities
+extern MOS_MUTEX gMosMemPoolMutex;
+
+MosMemoryPoolBlock  *MosMemoryPool::m_depot[MOS_MEMORY_POOL_SIZE_CLASS_NUM];
+volatile uintptr_t  MosMemoryPool::m_chunkTable[MOS_MEMORY_POOL_CHUNK_TABLE_SIZE];
+uint32_t            MosMemoryPool::m_chunkNum;
+bool                MosMemoryPool::m_destroyed;
+
+static thread_local MosMemoryPoolThreadCache g_mosMemPoolThreadCache;
+
+//!
+//! \brief    Releases pool chunks when the driver library is unloaded
+//!
+static struct MosMemoryPoolReleaser
+{
+    ~MosMemoryPoolReleaser()
+    {
+        MosMemoryPool::Destroy();
+    }
+} g_mosMemPoolReleaser;
+
+MosMemoryPoolThreadCache::~MosMemoryPoolThreadCache()
+{
+    MosMemoryPool::FlushThreadCache(this);
+}
+
+uint32_t MosMemoryPool::GetSizeClass(size_t size)
+{
+    uint32_t sizeClass = 0;
+    size_t   blockSize = (size_t)1 << MOS_MEMORY_POOL_MIN_BLOCK_SHIFT;
+
+    while (blockSize < size)
+    {
+        blockSize <<= 1;
+        sizeClass++;
+    }
+
+    return sizeClass;
+}
+
+bool MosMemoryPool::IsPooled(void *ptr)
+{
+    if (ptr == nullptr)
+    {
+        return false;
+    }
+
+    uintptr_t chunk = (uintptr_t)GetChunk(ptr);
+    uint32_t  slot  = HashChunk(chunk);
+
+    // Entries are never removed while the pool is alive, so the probe stops at the first empty slot.
+    for (uint32_t i = 0; i < MOS_MEMORY_POOL_CHUNK_TABLE_SIZE; i++)
+    {
+        uintptr_t entry = m_chunkTable[slot];
+        if (entry == chunk)
+        {
+            return true;
+        }
+        if (entry == 0)
+        {
+            return false;
+        }
+        slot = (slot + 1) & (MOS_MEMORY_POOL_CHUNK_TABLE_SIZE - 1);
+    }
+
+    return false;
+}
+
+bool MosMemoryPool::AddChunk(uint32_t sizeClass)
+{
+    if (m_destroyed || m_chunkNum >= MOS_MEMORY_POOL_MAX_CHUNK_NUM)
+    {
+        return false;
+    }
+
+    // Raw allocation: chunks are pool bookkeeping and are not tracked by MemNinja,
+    // the blocks carved from them are counted when handed out.
+    uint8_t *base = (uint8_t *)_aligned_malloc(MOS_MEMORY_POOL_CHUNK_SIZE, MOS_MEMORY_POOL_CHUNK_SIZE);
+    if (base == nullptr)
+    {
+        return false;
+    }
+
+    Chunk *chunk     = (Chunk *)base;
+    chunk->sizeClass = sizeClass;
+    chunk->blockSize = 1 << (sizeClass + MOS_MEMORY_POOL_MIN_BLOCK_SHIFT);
+
+    // First slot holds the chunk header
+    for (uint32_t offset = chunk->blockSize; offset + chunk->blockSize <= MOS_MEMORY_POOL_CHUNK_SIZE; offset += chunk->blockSize)
+    {
+        MosMemoryPoolBlock *block = (MosMemoryPoolBlock *)(base + offset);
+        block->next               = m_depot[sizeClass];
+        m_depot[sizeClass]        = block;
+    }
+
+    uint32_t slot = HashChunk((uintptr_t)base);
+    while (m_chunkTable[slot] != 0)
+    {
+        slot = (slot + 1) & (MOS_MEMORY_POOL_CHUNK_TABLE_SIZE - 1);
+    }
+    m_chunkTable[slot] = (uintptr_t)base;
+    m_chunkNum++;
+
+    return true;
+}
+
+void MosMemoryPool::Refill(MosMemoryPoolThreadCache *cache, uint32_t sizeClass)
+{
+    if (m_depot[sizeClass] == nullptr && !AddChunk(sizeClass))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < MOS_MEMORY_POOL_THREAD_CACHE_DEPTH / 2 && m_depot[sizeClass]; i++)
+    {
+        MosMemoryPoolBlock *block   = m_depot[sizeClass];
+        m_depot[sizeClass]          = block->next;
+        block->next                 = cache->freeList[sizeClass];
+        cache->freeList[sizeClass]  = block;
+        cache->count[sizeClass]++;
+    }
+}
+
+void MosMemoryPool::Drain(MosMemoryPoolThreadCache *cache, uint32_t sizeClass, uint32_t num)
+{
+    for (uint32_t i = 0; i < num && cache->freeList[sizeClass]; i++)
+    {
+        MosMemoryPoolBlock *block   = cache->freeList[sizeClass];
+        cache->freeList[sizeClass]  = block->next;
+        cache->count[sizeClass]--;
+        block->next                 = m_depot[sizeClass];
+        m_depot[sizeClass]          = block;
+    }
+}
+
+void *MosMemoryPool::Alloc(size_t size)
+{
+    if (size == 0 || size > MOS_MEMORY_POOL_MAX_BLOCK_SIZE)
+    {
+        return nullptr;
+    }
+
+    uint32_t                 sizeClass = GetSizeClass(size);
+    MosMemoryPoolThreadCache *cache    = &g_mosMemPoolThreadCache;
+
+    if (cache->freeList[sizeClass] == nullptr)
+    {
+        MOS_LockMutex(&gMosMemPoolMutex);
+        Refill(cache, sizeClass);
+        MOS_UnlockMutex(&gMosMemPoolMutex);
+
+        if (cache->freeList[sizeClass] == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    MosMemoryPoolBlock *block  = cache->freeList[sizeClass];
+    cache->freeList[sizeClass] = block->next;
+    cache->count[sizeClass]--;
+
+    return block;
+}
+
+void MosMemoryPool::Free(void *ptr)
+{
+    Chunk                    *chunk    = GetChunk(ptr);
+    uint32_t                 sizeClass = chunk->sizeClass;
+    MosMemoryPoolThreadCache *cache    = &g_mosMemPoolThreadCache;
+    MosMemoryPoolBlock       *block    = (MosMemoryPoolBlock *)ptr;
+
+    block->next                = cache->freeList[sizeClass];
+    cache->freeList[sizeClass] = block;
+    cache->count[sizeClass]++;
+
+    if (cache->count[sizeClass] > MOS_MEMORY_POOL_THREAD_CACHE_DEPTH)
+    {
+        MOS_LockMutex(&gMosMemPoolMutex);
+        Drain(cache, sizeClass, MOS_MEMORY_POOL_THREAD_CACHE_DEPTH / 2);
+        MOS_UnlockMutex(&gMosMemPoolMutex);
+    }
+}
+
+void MosMemoryPool::FlushThreadCache(MosMemoryPoolThreadCache *cache)
+{
+    MOS_LockMutex(&gMosMemPoolMutex);
+    for (uint32_t sizeClass = 0; sizeClass < MOS_MEMORY_POOL_SIZE_CLASS_NUM; sizeClass++)
+    {
+        if (m_destroyed)
+        {
+            // Chunks are gone, the cached blocks must not be touched any more.
+            cache->freeList[sizeClass] = nullptr;
+            cache->count[sizeClass]    = 0;
+            continue;
+        }
+        Drain(cache, sizeClass, cache->count[sizeClass]);
+    }
+    MOS_UnlockMutex(&gMosMemPoolMutex);
+}
+
+void MosMemoryPool::Destroy()
+{
+    MOS_LockMutex(&gMosMemPoolMutex);
+    for (uint32_t slot = 0; slot < MOS_MEMORY_POOL_CHUNK_TABLE_SIZE; slot++)
+    {
+        if (m_chunkTable[slot] != 0)
+        {
+            _aligned_free((void *)m_chunkTable[slot]);
+            m_chunkTable[slot] = 0;
+        }
+    }
+    for (uint32_t sizeClass = 0; sizeClass < MOS_MEMORY_POOL_SIZE_CLASS_NUM; sizeClass++)
+    {
+        m_depot[sizeClass] = nullptr;
+    }
+    m_chunkNum  = 0;
+    m_destroyed = true;
+    MOS_UnlockMutex(&gMosMemPoolMutex);
+}
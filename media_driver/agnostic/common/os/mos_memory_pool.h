@@ -0,0 +1,164 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_memory_pool.h
+//! \brief    Size-class slab pool for small system memory allocations
+//! \details  Blocks up to MOS_MEMORY_POOL_MAX_BLOCK_SIZE bytes are carved from
+//!           chunks of MOS_MEMORY_POOL_CHUNK_SIZE bytes. Each chunk serves one
+//!           size class and is aligned to its own size, so the owning chunk of
+//!           any block is found by masking the block address. Every thread
+//!           keeps a bounded free list per size class; the shared depot is only
+//!           touched when a thread cache runs empty or overflows.
+//!
+
+#ifndef __MOS_MEMORY_POOL_H__
+#define __MOS_MEMORY_POOL_H__
+
+#include "mos_os.h"
+
+#define MOS_MEMORY_POOL_CHUNK_SIZE          (64 * 1024)     //!< Size and alignment of one slab chunk
+#define MOS_MEMORY_POOL_MIN_BLOCK_SHIFT     6               //!< Smallest size class is 64 bytes
+#define MOS_MEMORY_POOL_MAX_BLOCK_SIZE      4096            //!< Largest size class served by the pool
+#define MOS_MEMORY_POOL_SIZE_CLASS_NUM      7               //!< 64, 128, 256, 512, 1K, 2K, 4K
+#define MOS_MEMORY_POOL_MAX_CHUNK_NUM       4096            //!< Up to 256MB of pooled memory
+#define MOS_MEMORY_POOL_CHUNK_TABLE_SIZE    (MOS_MEMORY_POOL_MAX_CHUNK_NUM * 2)
+#define MOS_MEMORY_POOL_THREAD_CACHE_DEPTH  64              //!< Max cached blocks per size class per thread
+
+//!
+//! \brief    Free block link, overlays the first bytes of a free block
+//!
+struct MosMemoryPoolBlock
+{
+    MosMemoryPoolBlock  *next;
+};
+
+//!
+//! \brief    Per-thread cache of free blocks
+//! \details  Flushed back to the depot on thread exit.
+//!
+struct MosMemoryPoolThreadCache
+{
+    MosMemoryPoolBlock  *freeList[MOS_MEMORY_POOL_SIZE_CLASS_NUM];
+    uint32_t            count[MOS_MEMORY_POOL_SIZE_CLASS_NUM];
+
+    ~MosMemoryPoolThreadCache();
+};
+
+//!
+//! \class  MosMemoryPool
+//! \brief  Process wide slab pool behind MOS_AllocPooledMemory
+//!
+class MosMemoryPool
+{
+public:
+    //!
+    //! \brief    Allocate one block from the pool
+    //! \details  Contents of the returned block are undefined.
+    //! \param    [in] size
+    //!           Requested size in bytes
+    //! \return   void *
+    //!           Pointer to the block, nullptr if size is not served by the pool
+    //!           or the pool could not grow
+    //!
+    static void *Alloc(size_t size);
+
+    //!
+    //! \brief    Return one block to the pool
+    //! \param    [in] ptr
+    //!           Pointer returned by MosMemoryPool::Alloc
+    //!
+    static void Free(void *ptr);
+
+    //!
+    //! \brief    Check whether a pointer belongs to a pool chunk
+    //! \details  Only reads pool owned memory, so it is safe to call on any
+    //!           pointer including ones returned by malloc.
+    //! \param    [in] ptr
+    //!           Pointer to check
+    //! \return   bool
+    //!           true if ptr was returned by MosMemoryPool::Alloc
+    //!
+    static bool IsPooled(void *ptr);
+
+    //!
+    //! \brief    Get the usable size of a pool block
+    //! \param    [in] ptr
+    //!           Pointer returned by MosMemoryPool::Alloc
+    //! \return   size_t
+    //!           Size of the size class the block belongs to
+    //!
+    static size_t GetBlockSize(void *ptr)
+    {
+        return GetChunk(ptr)->blockSize;
+    }
+
+    //!
+    //! \brief    Return all blocks cached by a thread to the depot
+    //! \param    [in] cache
+    //!           Thread cache to flush
+    //!
+    static void FlushThreadCache(MosMemoryPoolThreadCache *cache);
+
+    //!
+    //! \brief    Release every chunk owned by the pool
+    //! \details  Only called when the driver library is unloaded.
+    //!
+    static void Destroy();
+
+private:
+    //!
+    //! \brief    Chunk header, stored in the first block slot of each chunk
+    //!
+    struct Chunk
+    {
+        uint32_t    sizeClass;
+        uint32_t    blockSize;
+    };
+
+    static uint32_t GetSizeClass(size_t size);
+
+    static Chunk *GetChunk(void *ptr)
+    {
+        return (Chunk *)((uintptr_t)ptr & ~((uintptr_t)MOS_MEMORY_POOL_CHUNK_SIZE - 1));
+    }
+
+    static uint32_t HashChunk(uintptr_t chunk)
+    {
+        return (uint32_t)((chunk / MOS_MEMORY_POOL_CHUNK_SIZE) * 2654435761u) & (MOS_MEMORY_POOL_CHUNK_TABLE_SIZE - 1);
+    }
+
+    //! \brief  Refill a thread cache from the depot, growing the pool if needed. Depot lock must be held.
+    static void Refill(MosMemoryPoolThreadCache *cache, uint32_t sizeClass);
+
+    //! \brief  Move up to num blocks of a thread cache to the depot. Depot lock must be held.
+    static void Drain(MosMemoryPoolThreadCache *cache, uint32_t sizeClass, uint32_t num);
+
+    //! \brief  Allocate a new chunk and carve it into the depot. Depot lock must be held.
+    static bool AddChunk(uint32_t sizeClass);
+
+    static MosMemoryPoolBlock   *m_depot[MOS_MEMORY_POOL_SIZE_CLASS_NUM];       //!< Shared free lists
+    static volatile uintptr_t   m_chunkTable[MOS_MEMORY_POOL_CHUNK_TABLE_SIZE]; //!< Open addressing set of chunk addresses
+    static uint32_t             m_chunkNum;                                     //!< Number of chunks allocated
+    static bool                 m_destroyed;                                    //!< Set once chunks are released
+};
+
+#endif // __MOS_MEMORY_POOL_H__
@@ -97,6 +97,125 @@ MOS_STATUS Mos_AddCommand(
     return MOS_STATUS_SUCCESS;
 }
 
+//!
+//! \brief    Staging of the reserved commands which are not built in place
+//! \details  Used when the command buffer is not aligned enough for the command,
+//!           the command is copied to the command buffer when committed
+//!
+alignas(MOS_CMD_STAGING_ALIGNMENT) static thread_local uint32_t MosCmdStaging[MOS_CMD_STAGING_SIZE / sizeof(uint32_t)];
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+//!
+//! \brief    Build all reserved commands in staging and copy them
+//! \details  Read from "MOS Copy Command Path" when an OS interface is created,
+//!           to compare the in place commands against the copy path
+//!
+static uint8_t MosCopyCmdPath;
+#endif
+
+//! \brief    Unified OS reserve space for a command in command buffer
+//! \details  Returns the current position of the command buffer so a command
+//!           can be built in place, the buffer is not advanced until
+//!           Mos_CommitCommand. Nothing may be added to the buffer in between.
+//!           If the position is not aligned for the command, or the buffer is
+//!           write combined and would be read back while the command fields are
+//!           set, a staging copy is returned instead and copied to the buffer
+//!           by Mos_CommitCommand.
+//! \param    PMOS_COMMAND_BUFFER pCmdBuffer
+//!           [in] Pointer to Command Buffer
+//! \param    uint32_t dwCmdSize
+//!           [in] Size of command in bytes
+//! \param    uint32_t dwCmdAlignment
+//!           [in] Alignment of command in bytes, power of 2
+//! \return   void *
+//!           Aligned pointer to the command, nullptr if no space
+//!
+void *Mos_ReserveCommand(
+    PMOS_COMMAND_BUFFER pCmdBuffer,
+    uint32_t            dwCmdSize,
+    uint32_t            dwCmdAlignment)
+{
+    bool bStaging = false;
+
+    if (pCmdBuffer == nullptr || pCmdBuffer->pCmdPtr == nullptr || dwCmdSize == 0)
+    {
+        MOS_OS_ASSERTMESSAGE("Invalid command buffer or command size.");
+        return nullptr;
+    }
+
+    if (pCmdBuffer->iRemaining < (int32_t)MOS_ALIGN_CEIL(dwCmdSize, sizeof(uint32_t)))
+    {
+        MOS_OS_ASSERTMESSAGE("Unable to add command (no space).");
+        return nullptr;
+    }
+
+    bStaging = ((uintptr_t)pCmdBuffer->pCmdPtr & (dwCmdAlignment - 1)) != 0 ||
+               pCmdBuffer->bWriteCombined;
+#if (_DEBUG || _RELEASE_INTERNAL)
+    bStaging = bStaging || MosCopyCmdPath;
+    if (!bStaging)
+    {
+        MOS_IncrementUltCounter(MOS_ULT_COUNTER_CMDS_BUILT_IN_PLACE);
+    }
+#endif
+
+    if (bStaging)
+    {
+        if (dwCmdSize > sizeof(MosCmdStaging) || dwCmdAlignment > MOS_CMD_STAGING_ALIGNMENT)
+        {
+            MOS_OS_ASSERTMESSAGE("Command too large to be staged.");
+            return nullptr;
+        }
+        return MosCmdStaging;
+    }
+
+    return pCmdBuffer->pCmdPtr;
+}
+
+//! \brief    Unified OS commit a command built in place
+//! \details  Advances the command buffer past a command returned by
+//!           Mos_ReserveCommand
+//! \param    PMOS_COMMAND_BUFFER pCmdBuffer
+//!           [in/out] Pointer to Command Buffer
+//! \param    void  *pCmd
+//!           [in] Command Pointer returned by Mos_ReserveCommand
+//! \param    uint32_t dwCmdSize
+//!           [in] Size of command in bytes
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS Mos_CommitCommand(
+    PMOS_COMMAND_BUFFER     pCmdBuffer,
+    const void              *pCmd,
+    uint32_t                dwCmdSize)
+{
+    uint32_t dwCmdSizeDwAligned = 0;
+
+    //---------------------------------------------
+    MOS_OS_CHK_NULL_RETURN(pCmdBuffer);
+    MOS_OS_CHK_NULL_RETURN(pCmd);
+    //---------------------------------------------
+
+    dwCmdSizeDwAligned = MOS_ALIGN_CEIL(dwCmdSize, sizeof(uint32_t));
+
+    if (pCmd == MosCmdStaging)
+    {
+        return Mos_AddCommand(pCmdBuffer, pCmd, dwCmdSize);
+    }
+
+    if (pCmd != pCmdBuffer->pCmdPtr || dwCmdSize == 0 || pCmdBuffer->iRemaining < (int32_t)dwCmdSizeDwAligned)
+    {
+        MOS_OS_ASSERTMESSAGE("Command was not reserved at the current position of the command buffer.");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    pCmdBuffer->iOffset    += dwCmdSizeDwAligned;
+    pCmdBuffer->iRemaining -= dwCmdSizeDwAligned;
+    pCmdBuffer->pCmdPtr    += (dwCmdSizeDwAligned / sizeof(uint32_t));
+
+    return MOS_STATUS_SUCCESS;
+}
+
 //!
 //! \brief    Unified OS fill Resource
 //! \details  Locks the surface and fills the resource with data
@@ -738,6 +857,16 @@ MOS_STATUS Mos_InitInterface(
 
     eStatus = Mos_Specific_InitInterface(pOsInterface, pOsDriverContext);
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+    MOS_USER_FEATURE_VALUE_DATA UserFeatureData;
+    MOS_ZeroMemory(&UserFeatureData, sizeof(UserFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __MEDIA_USER_FEATURE_VALUE_MOS_COPY_CMD_PATH_ID,
+        &UserFeatureData);
+    MosCopyCmdPath = UserFeatureData.i32Data ? 1 : 0;
+#endif
+
 #if MOS_COMMAND_BUFFER_DUMP_SUPPORTED
     Mos_DumpCommandBufferInit(pOsInterface);
 #endif // MOS_COMMAND_BUFFER_DUMP_SUPPORTED
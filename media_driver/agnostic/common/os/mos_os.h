@@ -252,6 +252,7 @@ typedef struct _MOS_COMMAND_BUFFER
     int32_t             iCmdIndex;                  //!< command buffer's index
     MOS_VDBOX_NODE_IND  iVdboxNodeIndex;            //!< Which VDBOX buffer is binded to
     int32_t             iSubmissionType;
+    int32_t             bWriteCombined;             //!< CPU mapping is write combined, commands are not built in place
 
     MOS_COMMAND_BUFFER_ATTRIBUTES Attributes;       //!< Attributes for the command buffer to be provided to KMD at submission
     MOS_OCA_BUFFER_HANDLE hOcaBuf;                  //!< Oca buffer handle for current command
@@ -288,6 +289,8 @@ typedef struct _MOS_GFXRES_FLAGS
     int32_t         bOverlay;
     int32_t         bFlipChain;
     int32_t         bSVM;
+    int32_t         bPersistentMap;                                             //!< [in] true: Linear resource written by the CPU every frame, mapped once at allocation, Lock only waits for the GPU.
+    int32_t         bPersistentMapCached;                                       //!< [in] true: With bPersistentMap, map through the CPU cache instead of write combined, only where it is coherent with the GPU.
 } MOS_GFXRES_FLAGS, *PMOS_GFXRES_FLAGS;
 
 //!
@@ -797,6 +800,11 @@ typedef struct _MOS_INTERFACE
         PMOS_INTERFACE              pOsInterface,
         PMOS_PATCH_ENTRY_PARAMS     pParams);
 
+    MOS_STATUS (* pfnSetPatchEntries) (
+        PMOS_INTERFACE              pOsInterface,
+        PMOS_PATCH_ENTRY_PARAMS     pParams,
+        uint32_t                    dwNumEntries);
+
 #if MOS_MEDIASOLO_SUPPORTED
     MOS_STATUS (* pfnInitializeMediaSolo) (
         PMOS_INTERFACE              pOsInterface);
@@ -1135,6 +1143,48 @@ MOS_STATUS Mos_AddCommand(
     const void          *pCmd,
     uint32_t            dwCmdSize);
 
+#define MOS_CMD_STAGING_SIZE            4096    //!< Largest command which can be reserved out of place
+#define MOS_CMD_STAGING_ALIGNMENT       16      //!< Largest alignment of a command which can be reserved
+
+//! \brief    Unified OS reserve space for a command in command buffer
+//! \details  Returns the current position of the command buffer so a command
+//!           can be built in place, the buffer is not advanced until
+//!           Mos_CommitCommand. Nothing may be added to the buffer in between.
+//!           If the position is not aligned for the command, or the buffer is
+//!           write combined and would be read back while the command fields are
+//!           set, a staging copy is returned instead and copied to the buffer
+//!           by Mos_CommitCommand.
+//! \param    PMOS_COMMAND_BUFFER pCmdBuffer
+//!           [in] Pointer to Command Buffer
+//! \param    uint32_t dwCmdSize
+//!           [in] Size of command in bytes
+//! \param    uint32_t dwCmdAlignment
+//!           [in] Alignment of command in bytes, power of 2
+//! \return   void *
+//!           Aligned pointer to the command, nullptr if no space
+//!
+void *Mos_ReserveCommand(
+    PMOS_COMMAND_BUFFER pCmdBuffer,
+    uint32_t            dwCmdSize,
+    uint32_t            dwCmdAlignment);
+
+//! \brief    Unified OS commit a command built in place
+//! \details  Advances the command buffer past a command returned by
+//!           Mos_ReserveCommand
+//! \param    PMOS_COMMAND_BUFFER pCmdBuffer
+//!           [in/out] Pointer to Command Buffer
+//! \param    void  *pCmd
+//!           [in] Command Pointer returned by Mos_ReserveCommand
+//! \param    uint32_t dwCmdSize
+//!           [in] Size of command in bytes
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS Mos_CommitCommand(
+    PMOS_COMMAND_BUFFER pCmdBuffer,
+    const void          *pCmd,
+    uint32_t            dwCmdSize);
+
 #if !EMUL
 //!
 //! \brief    Get memory object based on resource usage
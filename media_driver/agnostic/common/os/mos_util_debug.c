@@ -582,7 +582,7 @@ void MOS_MessageInit()
         MOS_DDIDumpInit();
 
         // all above action should not be covered by memninja since its destroy is behind memninja counter report to test result.
-        MosMemAllocCounter     = 0;
+        MOS_ResetMemAllocCounter();
         MosMemAllocFakeCounter = 0;
         MosMemAllocCounterGfx  = 0;
         MOS_OS_VERBOSEMESSAGE("MemNinja leak detection begin");
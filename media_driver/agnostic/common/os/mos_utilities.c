@@ -29,6 +29,7 @@
 #include "mos_utilities_specific.h"
 #ifdef __cplusplus
 #include "mos_util_user_interface.h"
+#include "mos_memory_pool.h"
 #include <sstream>
 #endif
 #include <fcntl.h>     //open
@@ -200,13 +201,34 @@ std::string PerfUtility::getDashString(uint32_t num)
 
 #endif // __cplusplus
 
-int32_t MosMemAllocCounter;      //!< Counter to check memory leaks
+alignas(MOS_MEM_ALLOC_COUNTER_SHARD_SIZE) MOS_MEM_ALLOC_COUNTER_SHARD MosMemAllocCounterShards[MOS_MEM_ALLOC_COUNTER_SHARD_NUM];  //!< Counter to check memory leaks
+static int32_t MosMemAllocCounterShardNext;
+static thread_local int32_t *MosMemAllocCounterThreadShard;
 int32_t MosMemAllocFakeCounter;
 int32_t MosMemAllocCounterGfx;
 int32_t MosMemAllocCounterNoUserFeature;
 int32_t MosMemAllocCounterNoUserFeatureGfx;
 uint8_t MosUltFlag;
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+#define MOS_ULT_USER_FEATURE_MAX_NUM    16
+#define MOS_ULT_USER_FEATURE_MAX_LENGTH 256
+
+//!
+//! \brief    User feature value set by the ULT
+//!
+typedef struct _MOS_ULT_USER_FEATURE
+{
+    char    valueName[MOS_ULT_USER_FEATURE_MAX_LENGTH];
+    char    value[MOS_ULT_USER_FEATURE_MAX_LENGTH];
+} MOS_ULT_USER_FEATURE;
+
+extern MOS_MUTEX gMosUltUserFeatureMutex;
+static MOS_ULT_USER_FEATURE MosUltUserFeatures[MOS_ULT_USER_FEATURE_MAX_NUM];
+static uint32_t MosUltUserFeatureNum;
+static int32_t MosUltCounters[MOS_ULT_COUNTER_MAX];
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -226,10 +248,117 @@ extern "C" {
         return MosMemAllocCounterNoUserFeatureGfx;
     }
 
+    MOS_FUNC_EXPORT int32_t MOS_GetCurrentMemNinjaCounter()
+    {
+        return MOS_GetMemAllocCounter();
+    }
+
+    MOS_FUNC_EXPORT uint8_t MOS_SetUltUserFeature(const char *valueName, const char *value)
+    {
+#if (_DEBUG || _RELEASE_INTERNAL)
+        uint8_t  applied = 1;
+        uint32_t i       = 0;
+
+        MOS_LockMutex(&gMosUltUserFeatureMutex);
+        if (valueName == nullptr)
+        {
+            MosUltUserFeatureNum = 0;
+            MOS_UnlockMutex(&gMosUltUserFeatureMutex);
+            return applied;
+        }
+
+        for (i = 0; i < MosUltUserFeatureNum; i++)
+        {
+            if (strcmp(MosUltUserFeatures[i].valueName, valueName) == 0)
+            {
+                break;
+            }
+        }
+
+        if (value == nullptr)
+        {
+            if (i < MosUltUserFeatureNum)
+            {
+                MosUltUserFeatures[i] = MosUltUserFeatures[--MosUltUserFeatureNum];
+            }
+        }
+        else if (i == MOS_ULT_USER_FEATURE_MAX_NUM ||
+                 MOS_SecureStrcpy(MosUltUserFeatures[i].valueName, MOS_ULT_USER_FEATURE_MAX_LENGTH, valueName) != MOS_STATUS_SUCCESS ||
+                 MOS_SecureStrcpy(MosUltUserFeatures[i].value, MOS_ULT_USER_FEATURE_MAX_LENGTH, value) != MOS_STATUS_SUCCESS)
+        {
+            applied = 0;
+        }
+        else if (i == MosUltUserFeatureNum)
+        {
+            MosUltUserFeatureNum++;
+        }
+        MOS_UnlockMutex(&gMosUltUserFeatureMutex);
+
+        return applied;
+#else
+        MOS_UNUSED(valueName);
+        MOS_UNUSED(value);
+        return 0;
+#endif
+    }
+
+    MOS_FUNC_EXPORT int32_t MOS_GetUltCounter(uint32_t counter)
+    {
+#if (_DEBUG || _RELEASE_INTERNAL)
+        return (counter < MOS_ULT_COUNTER_MAX) ? MosUltCounters[counter] : -1;
+#else
+        MOS_UNUSED(counter);
+        return -1;
+#endif
+    }
+
 #ifdef __cplusplus
 }
 #endif
 
+void MOS_IncrementUltCounter(MOS_ULT_COUNTER counter)
+{
+#if (_DEBUG || _RELEASE_INTERNAL)
+    if (counter < MOS_ULT_COUNTER_MAX)
+    {
+        MOS_AtomicIncrement(&MosUltCounters[counter]);
+    }
+#else
+    MOS_UNUSED(counter);
+#endif
+}
+
+int32_t *MOS_GetMemAllocCounterShard()
+{
+    if (MosMemAllocCounterThreadShard == nullptr)
+    {
+        int32_t index = MOS_AtomicIncrement(&MosMemAllocCounterShardNext) & (MOS_MEM_ALLOC_COUNTER_SHARD_NUM - 1);
+        MosMemAllocCounterThreadShard = &MosMemAllocCounterShards[index].value;
+    }
+
+    return MosMemAllocCounterThreadShard;
+}
+
+int32_t MOS_GetMemAllocCounter()
+{
+    int32_t counter = 0;
+
+    for (uint32_t i = 0; i < MOS_MEM_ALLOC_COUNTER_SHARD_NUM; i++)
+    {
+        counter += MosMemAllocCounterShards[i].value;
+    }
+
+    return counter;
+}
+
+void MOS_ResetMemAllocCounter()
+{
+    for (uint32_t i = 0; i < MOS_MEM_ALLOC_COUNTER_SHARD_NUM; i++)
+    {
+        MosMemAllocCounterShards[i].value = 0;
+    }
+}
+
 #define __MOS_USER_FEATURE_VALUE_SINGLE_SLICE_VEBOX_DEFAULT_VALUE "1"
 #define __MAX_MULTI_STRING_COUNT         128
 
@@ -284,6 +413,33 @@ static MOS_USER_FEATURE_VALUE MOSUserFeatureDescFields[__MOS_USER_FEATURE_KEY_MA
         MOS_USER_FEATURE_VALUE_TYPE_INT32,
         "0",
         "Linux Performance Tag"),
+    MOS_DECLARE_UF_KEY(__MEDIA_USER_FEATURE_VALUE_VA_CAPTURE_FILE_ID,
+        "VA Capture File",
+        __MEDIA_USER_FEATURE_SUBKEY_PERFORMANCE,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "General",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_STRING,
+        "",
+        "File the VA calls of the process are captured to for replay. Empty disables the capture."),
+    MOS_DECLARE_UF_KEY_DBGONLY(__MEDIA_USER_FEATURE_VALUE_MOS_COPY_CMD_PATH_ID,
+        "MOS Copy Command Path",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "General",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_INT32,
+        "0",
+        "Build the MHW commands out of the command buffer and copy them, instead of building them in place. Read when an OS interface is created."),
+    MOS_DECLARE_UF_KEY_DBGONLY(__MEDIA_USER_FEATURE_VALUE_MOS_PERSISTENT_MAP_DISABLE_ID,
+        "MOS Persistent Map Disable",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "General",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_INT32,
+        "0",
+        "Map the persistently mapped resources on every lock instead. Read when an OS interface is created."),
     MOS_DECLARE_UF_KEY_DBGONLY(__MEDIA_USER_FEATURE_VALUE_PERF_PROFILER_ENABLE_ID,
         "Perf Profiler Enable",
         __MEDIA_USER_FEATURE_SUBKEY_PERFORMANCE,
@@ -436,7 +592,7 @@ static MOS_USER_FEATURE_VALUE MOSUserFeatureDescFields[__MOS_USER_FEATURE_KEY_MA
         MOS_USER_FEATURE_TYPE_USER,
         MOS_USER_FEATURE_VALUE_TYPE_INT32,
         "1",
-        "Enables/Disables MFE MBEnc Mode. This feature is only enabled for AVC encode."),
+        "Enables/Disables MFE MBEnc Mode. This feature is only enabled for AVC and HEVC encode."),
     MOS_DECLARE_UF_KEY_DBGONLY(__MEDIA_USER_FEATURE_VALUE_RC_PANIC_ENABLE_ID,
         "RC Panic Mode",
         __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
@@ -896,6 +1052,42 @@ static MOS_USER_FEATURE_VALUE MOSUserFeatureDescFields[__MOS_USER_FEATURE_KEY_MA
         MOS_USER_FEATURE_VALUE_TYPE_INT32,
         "1",
         "Enables/Disables Frame Tracking."),
+    MOS_DECLARE_UF_KEY(__MEDIA_USER_FEATURE_VALUE_ENCODE_FRAME_CONTEXT_NUM_ID,
+        "Encode Frame Context Number",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "Encode",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_INT32,
+        "2",
+        "Number of frames in flight per encode context. Values above 1 let the next frame be prepared while a worker thread executes the current one, 1 executes each frame in vaEndPicture."),
+    MOS_DECLARE_UF_KEY(__MEDIA_USER_FEATURE_VALUE_ENCODE_BUFFER_POOL_BUDGET_ID,
+        "Encode Buffer Pool Budget",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "Encode",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_INT32,
+        "8192",
+        "KB of destroyed VA buffers each encode context keeps for reuse. 0 disables the buffer pool."),
+    MOS_DECLARE_UF_KEY_DBGONLY(__MEDIA_USER_FEATURE_VALUE_CODEC_PROLOG_CACHE_MODE_ID,
+        "Codec Prolog Cache Mode",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "Codec",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_INT32,
+        "0",
+        "How the invariant prolog commands are added. 0: start the cached batch buffer, 1: copy the cached commands, 2: build them in every command buffer."),
+    MOS_DECLARE_UF_KEY_DBGONLY(__MEDIA_USER_FEATURE_VALUE_JPEG_ENCODE_TABLE_REUSE_DISABLE_ID,
+        "JPEG Encode Table Reuse Disable",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "Encode",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_INT32,
+        "0",
+        "Convert and pack the JPEG quantization and huffman tables of every picture, instead of reusing the ones of the previous picture."),
     MOS_DECLARE_UF_KEY_DBGONLY(__MEDIA_USER_FEATURE_VALUE_COLOR_BIT_SUPPORT_ENABLE_ID,
         "Colorbit Support Enable",
         __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
@@ -2546,6 +2738,15 @@ static MOS_USER_FEATURE_VALUE MOSUserFeatureDescFields[__MOS_USER_FEATURE_KEY_MA
         MOS_USER_FEATURE_VALUE_TYPE_INT32,
         "0",
         "Specify if send HuC and HCP commands in one DMA buffer or two DMA buffer. "),
+    MOS_DECLARE_UF_KEY(__MEDIA_USER_FEATURE_VALUE_HEVC_PIC_TEMPLATE_ENABLE_ID,
+        "HEVC Decode Picture Template Enable",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "Decode",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_INT32,
+        "1",
+        "Replay the recorded HEVC picture level commands while their parameters do not change. "),
     MOS_DECLARE_UF_KEY_DBGONLY(__MEDIA_USER_FEATURE_VALUE_HEVCDATROWSTORECACHE_DISABLE_ID,
         "DisableHevcDatRowStoreCache",
         __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
@@ -2980,6 +3181,24 @@ static MOS_USER_FEATURE_VALUE MOSUserFeatureDescFields[__MOS_USER_FEATURE_KEY_MA
         MOS_USER_FEATURE_VALUE_TYPE_BOOL,
         "0",
         "For debugging purpose. true for disabling SFC"),
+    MOS_DECLARE_UF_KEY(__VPHAL_VEBOX_AUTO_DN_UPDATE_MODE_ID,
+        "VEBOX Auto Denoise Update Mode",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "VP",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_UINT32,
+        "0",
+        "How auto denoise updates the VEBOX DN state. 0: DN update kernel on the render engine, 1: CPU update from the statistics of the previous frame"),
+    MOS_DECLARE_UF_KEY_DBGONLY(__VPHAL_VEBOX_FORCE_AUTO_DENOISE_ID,
+        "VEBOX Force Auto Denoise",
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "VP",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_BOOL,
+        "0",
+        "For debugging purpose. true for auto detecting the noise level of the denoise filter instead of the application strength"),
     MOS_DECLARE_UF_KEY(__VPHAL_ENABLE_SUPER_RESOLUTION_ID,
         "Enable VP Super Resolution",
         __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
@@ -3733,7 +3952,7 @@ bool MOS_SimulateAllocMemoryFail(
         }
 
         if ((MosAllocMemoryFailSimulateCount < MosAllocMemoryFailSimulateFreq)
-            && (MosAllocMemoryFailSimulateCount == MosMemAllocCounter))
+            && (MosAllocMemoryFailSimulateCount == MOS_GetMemAllocCounter()))
         {
             MOS_DEBUGMESSAGE(MOS_MESSAGE_LVL_CRITICAL, MOS_COMPONENT_OS, MOS_SUBCOMP_SELF, \
                 "Simulated Allocate Memory Fail (counter=%d) for: functionName: %s, filename: %s, line: %d, size: %d \n", MosAllocMemoryFailSimulateCount, functionName, filename, line, size, alignment);
@@ -3871,7 +4090,7 @@ void  *MOS_AlignedAllocMemory(
 
     if(ptr != nullptr)
     {
-        MOS_AtomicIncrement(&MosMemAllocCounter);
+        MOS_AtomicIncrement(MOS_GetMemAllocCounterShard());
         MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line);
     }
 
@@ -3902,7 +4121,7 @@ void MOS_AlignedFreeMemory(void  *ptr)
 
     if(ptr != nullptr)
     {
-        MOS_AtomicDecrement(&MosMemAllocCounter);
+        MOS_AtomicDecrement(MOS_GetMemAllocCounterShard());
         MOS_MEMNINJA_FREE_MESSAGE(ptr, functionName, filename, line);
 
         _aligned_free(ptr);
@@ -3944,7 +4163,7 @@ void  *MOS_AllocMemory(size_t size)
 
     if(ptr != nullptr)
     {
-        MOS_AtomicIncrement(&MosMemAllocCounter);
+        MOS_AtomicIncrement(MOS_GetMemAllocCounterShard());
         MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line);
     }
 
@@ -3989,7 +4208,102 @@ void  *MOS_AllocAndZeroMemory(size_t size)
     {
         MOS_ZeroMemory(ptr, size);
 
-        MOS_AtomicIncrement(&MosMemAllocCounter);
+        MOS_AtomicIncrement(MOS_GetMemAllocCounterShard());
+        MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line);
+    }
+
+    return ptr;
+}
+
+//!
+//! \brief    Allocates memory from the small block pool
+//! \details  Sizes up to MOS_MEMORY_POOL_MAX_BLOCK_SIZE come from the calling thread's
+//!           slab cache, larger ones from malloc(). Performs error checking.
+//!           It increases memory allocation counter variable
+//!           MosMemAllocCounter for checking memory leaks.
+//! \param    size_t size
+//!           [in] Size of memorry to be allocated
+//! \return   void *
+//!           Pointer to allocated memory
+//!
+#if MOS_MESSAGES_ENABLED
+void  *MOS_AllocPooledMemoryUtils(
+    size_t      size,
+    const char  *functionName,
+    const char  *filename,
+    int32_t     line)
+#else
+void  *MOS_AllocPooledMemory(size_t size)
+#endif // MOS_MESSAGES_ENABLED
+{
+    void  *ptr;
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    if (MOS_SimulateAllocMemoryFail(size, NO_ALLOC_ALIGNMENT, functionName, filename, line))
+    {
+        return nullptr;
+    }
+#endif
+
+    ptr = MosMemoryPool::Alloc(size);
+    if (ptr == nullptr)
+    {
+        ptr = malloc(size);
+    }
+
+    MOS_OS_ASSERT(ptr != nullptr);
+
+    if(ptr != nullptr)
+    {
+        MOS_AtomicIncrement(MOS_GetMemAllocCounterShard());
+        MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line);
+    }
+
+    return ptr;
+}
+
+//!
+//! \brief    Allocates memory from the small block pool and fills it with 0
+//! \details  Pooled counterpart of MOS_AllocAndZeroMemory(). Performs error checking.
+//!           It increases memory allocation counter variable
+//!           MosMemAllocCounter for checking memory leaks.
+//! \param    size_t size
+//!           [in] Size of memorry to be allocated
+//! \return   void *
+//!           Pointer to allocated memory
+//!
+#if MOS_MESSAGES_ENABLED
+void  *MOS_AllocAndZeroPooledMemoryUtils(
+    size_t      size,
+    const char  *functionName,
+    const char  *filename,
+    int32_t     line)
+#else
+void  *MOS_AllocAndZeroPooledMemory(size_t size)
+#endif // MOS_MESSAGES_ENABLED
+{
+    void  *ptr;
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+    if (MOS_SimulateAllocMemoryFail(size, NO_ALLOC_ALIGNMENT, functionName, filename, line))
+    {
+        return nullptr;
+    }
+#endif
+
+    ptr = MosMemoryPool::Alloc(size);
+    if (ptr == nullptr)
+    {
+        ptr = malloc(size);
+    }
+
+    MOS_OS_ASSERT(ptr != nullptr);
+
+    if(ptr != nullptr)
+    {
+        MOS_ZeroMemory(ptr, size);
+
+        MOS_AtomicIncrement(MOS_GetMemAllocCounterShard());
         MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line);
     }
 
@@ -4032,7 +4346,20 @@ void *MOS_ReallocMemory(
 #endif
 
     oldPtr = ptr;
-    newPtr = realloc(ptr, newSize);
+    if (MosMemoryPool::IsPooled(ptr))
+    {
+        // Pool blocks cannot be grown in place, move the content to a malloc() block
+        newPtr = malloc(newSize);
+        if (newPtr != nullptr)
+        {
+            MOS_SecureMemcpy(newPtr, newSize, ptr, MOS_MIN(newSize, MosMemoryPool::GetBlockSize(ptr)));
+            MosMemoryPool::Free(ptr);
+        }
+    }
+    else
+    {
+        newPtr = realloc(ptr, newSize);
+    }
 
     MOS_OS_ASSERT(newPtr != nullptr);
 
@@ -4040,13 +4367,13 @@ void *MOS_ReallocMemory(
     {
         if (oldPtr != nullptr)
         {
-            MOS_AtomicDecrement(&MosMemAllocCounter);
+            MOS_AtomicDecrement(MOS_GetMemAllocCounterShard());
             MOS_MEMNINJA_FREE_MESSAGE(oldPtr, functionName, filename, line);
         }
 
         if (newPtr != nullptr)
         {
-            MOS_AtomicIncrement(&MosMemAllocCounter);
+            MOS_AtomicIncrement(MOS_GetMemAllocCounterShard());
             MOS_MEMNINJA_ALLOC_MESSAGE(newPtr, newSize, functionName, filename, line);
         }
     }
@@ -4075,10 +4402,17 @@ void MOS_FreeMemory(void  *ptr)
 {
     if(ptr != nullptr)
     {
-        MOS_AtomicDecrement(&MosMemAllocCounter);
+        MOS_AtomicDecrement(MOS_GetMemAllocCounterShard());
         MOS_MEMNINJA_FREE_MESSAGE(ptr, functionName, filename, line);
 
-        free(ptr);
+        if (MosMemoryPool::IsPooled(ptr))
+        {
+            MosMemoryPool::Free(ptr);
+        }
+        else
+        {
+            free(ptr);
+        }
     }
 }
 
@@ -5358,6 +5692,67 @@ MOS_STATUS MOS_DestroyUserFeatureKeysForAllDescFields()
     return eStatus;
 }
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+//!
+//! \brief    Read the user feature value set by the ULT
+//! \details  Values set through MOS_SetUltUserFeature take precedence over
+//!           the user feature file, so that the ULT can select the code paths
+//!           of the driver without exporting a setter per feature.
+//! \param    PMOS_USER_FEATURE_VALUE pUserFeature
+//!           [in] Pointer to the user feature key definition
+//! \param    PMOS_USER_FEATURE_VALUE_DATA pValueData
+//!           [out] Pointer to User Feature Data
+//! \return   MOS_STATUS
+//!           MOS_STATUS_SUCCESS if the ULT set the value,
+//!           MOS_STATUS_USER_FEATURE_KEY_READ_FAILED otherwise
+//!
+static MOS_STATUS MOS_UserFeature_ReadUltValue(
+    PMOS_USER_FEATURE_VALUE         pUserFeature,
+    PMOS_USER_FEATURE_VALUE_DATA    pValueData)
+{
+    MOS_USER_FEATURE_VALUE_DATA     ultData;
+    char                            value[MOS_ULT_USER_FEATURE_MAX_LENGTH];
+    bool                            found = false;
+    MOS_STATUS                      eStatus;
+
+    MOS_OS_ASSERT(pUserFeature);
+    MOS_OS_ASSERT(pValueData);
+
+    if (pUserFeature->ValueType == MOS_USER_FEATURE_VALUE_TYPE_BINARY ||
+        pUserFeature->ValueType == MOS_USER_FEATURE_VALUE_TYPE_MULTI_STRING)
+    {
+        return MOS_STATUS_USER_FEATURE_KEY_READ_FAILED;
+    }
+
+    MOS_LockMutex(&gMosUltUserFeatureMutex);
+    for (uint32_t i = 0; i < MosUltUserFeatureNum; i++)
+    {
+        if (strcmp(MosUltUserFeatures[i].valueName, pUserFeature->pValueName) == 0)
+        {
+            found = (MOS_SecureStrcpy(value, sizeof(value), MosUltUserFeatures[i].value) == MOS_STATUS_SUCCESS);
+            break;
+        }
+    }
+    MOS_UnlockMutex(&gMosUltUserFeatureMutex);
+
+    if (!found)
+    {
+        return MOS_STATUS_USER_FEATURE_KEY_READ_FAILED;
+    }
+
+    MOS_ZeroMemory(&ultData, sizeof(ultData));
+    eStatus = MOS_AssignUserFeatureValueData(&ultData, value, pUserFeature->ValueType);
+    if (eStatus == MOS_STATUS_SUCCESS)
+    {
+        // Frees the string of ultData
+        eStatus = MOS_CopyUserFeatureValueData(&ultData, pValueData, pUserFeature->ValueType);
+    }
+    MOS_SafeFreeMemory(ultData.StringData.pStringData);
+
+    return (eStatus == MOS_STATUS_SUCCESS) ? eStatus : MOS_STATUS_USER_FEATURE_KEY_READ_FAILED;
+}
+#endif
+
 //!
 //! \brief    Initializes read user feature value function
 //! \details  Initializes read user feature value function
@@ -6266,6 +6661,13 @@ MOS_STATUS MOS_UserFeature_ReadValue_FromMap_ID(
         return eStatus;
     }
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+    if (MOS_UserFeature_ReadUltValue(pUserFeature, pValueData) == MOS_STATUS_SUCCESS)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+#endif
+
     // Open the user feature
     // Assigned the pUserFeature to UFKey for future reading
     UFKey = pUserFeature;
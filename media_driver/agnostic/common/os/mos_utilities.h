@@ -144,21 +144,58 @@ double MOS_GetTime();
 #define MAX_USER_FEATURE_FIELD_LENGTH            256
 #endif
 
-extern int32_t MosMemAllocCounter;
+#define MOS_MEM_ALLOC_COUNTER_SHARD_NUM     64      //!< Must be a power of 2
+#define MOS_MEM_ALLOC_COUNTER_SHARD_SIZE    64      //!< One cache line per shard
+
+//!
+//! \brief    One shard of the system memory allocation counter
+//! \details  Each thread updates its own shard so the counter cache line is not
+//!           shared between cores. The leak counter is the sum of all shards.
+//!
+typedef struct _MOS_MEM_ALLOC_COUNTER_SHARD
+{
+    int32_t     value;
+    uint8_t     padding[MOS_MEM_ALLOC_COUNTER_SHARD_SIZE - sizeof(int32_t)];
+} MOS_MEM_ALLOC_COUNTER_SHARD;
+
+extern MOS_MEM_ALLOC_COUNTER_SHARD MosMemAllocCounterShards[MOS_MEM_ALLOC_COUNTER_SHARD_NUM];
 extern int32_t MosMemAllocFakeCounter;
 extern int32_t MosMemAllocCounterGfx;
 extern uint8_t MosUltFlag;
 
+//!
+//! \brief    Counters of debug drivers, read by the ULT through MOS_GetUltCounter
+//!
+typedef enum _MOS_ULT_COUNTER
+{
+    MOS_ULT_COUNTER_ENCODE_WORKER_FRAMES = 0,       //!< Frames executed by the encode workers
+    MOS_ULT_COUNTER_CM_GPU_COPY_TASK_CREATES,       //!< Tasks and thread spaces created by the CM GPU copies
+    MOS_ULT_COUNTER_CM_GPU_COPY_BUFFERUP_CREATES,   //!< BufferUPs created by the CM GPU copies
+    MOS_ULT_COUNTER_ENCODE_BUFFER_POOL_ALLOCS,      //!< VA buffer backings allocated on an encode buffer pool miss
+    MOS_ULT_COUNTER_CMDS_BUILT_IN_PLACE,            //!< Commands reserved in place in the command buffer by Mos_ReserveCommand
+    MOS_ULT_COUNTER_ENCODE_DS_WALKERS,              //!< Media walkers of the encode 4x/16x/32x downscaling kernel
+    MOS_ULT_COUNTER_MAX
+} MOS_ULT_COUNTER;
+
+//!
+//! \brief    Increment a counter read by the ULT
+//! \details  No-op in release builds
+//! \param    [in] counter
+//!           Counter to increment
+//! \return   void
+//!
+void MOS_IncrementUltCounter(MOS_ULT_COUNTER counter);
+
 //! Helper Macros for MEMNINJA debug messages
 #define MOS_MEMNINJA_ALLOC_MESSAGE(ptr, size, functionName, filename, line)                                                \
     MOS_OS_VERBOSEMESSAGE(                                                                                                 \
         "MemNinjaSysAlloc: Time = %f, MemNinjaCounter = %d, memPtr = %p, size = %d, functionName = \"%s\", "               \
-        "filename = \"%s\", line = %d/", MOS_GetTime(), MosMemAllocCounter, ptr, size, functionName, filename, line)
+        "filename = \"%s\", line = %d/", MOS_GetTime(), MOS_GetMemAllocCounter(), ptr, size, functionName, filename, line)
 
 #define MOS_MEMNINJA_FREE_MESSAGE(ptr, functionName, filename, line)                                                       \
     MOS_OS_VERBOSEMESSAGE(                                                                                                 \
        "MemNinjaSysFree: Time = %f, MemNinjaCounter = %d, memPtr = %p, functionName = \"%s\", "                            \
-       "filename = \"%s\", line = %d/", MOS_GetTime(), MosMemAllocCounter, ptr, functionName, filename, line)
+       "filename = \"%s\", line = %d/", MOS_GetTime(), MOS_GetMemAllocCounter(), ptr, functionName, filename, line)
 
 #define MOS_MEMNINJA_GFX_ALLOC_MESSAGE(ptr, bufName, component, size, arraySize, functionName, filename, line)             \
     MOS_OS_VERBOSEMESSAGE(                                                                                                 \
@@ -183,6 +220,9 @@ typedef enum _MOS_USER_FEATURE_VALUE_ID
     __MEDIA_USER_FEATURE_VALUE_SIM_IN_USE_ID,
     __MEDIA_USER_FEATURE_VALUE_FORCE_VDBOX_ID,
     __MEDIA_USER_FEATURE_VALUE_LINUX_PERFORMANCETAG_ENABLE_ID,
+    __MEDIA_USER_FEATURE_VALUE_VA_CAPTURE_FILE_ID,
+    __MEDIA_USER_FEATURE_VALUE_MOS_COPY_CMD_PATH_ID,
+    __MEDIA_USER_FEATURE_VALUE_MOS_PERSISTENT_MAP_DISABLE_ID,
     __MEDIA_USER_FEATURE_VALUE_PERF_PROFILER_ENABLE_ID,
     __MEDIA_USER_FEATURE_VALUE_PERF_PROFILER_FE_BE_TIMING,
     __MEDIA_USER_FEATURE_VALUE_PERF_PROFILER_OUTPUT_FILE,
@@ -213,6 +253,10 @@ typedef enum _MOS_USER_FEATURE_VALUE_ID
     __MEDIA_USER_FEATURE_VALUE_ENCODE_RATECONTROL_METHOD_ID,
     __MEDIA_USER_FEATURE_VALUE_ENCODE_TARGET_USAGE_OVERRIDE_ID,
     __MEDIA_USER_FEATURE_VALUE_ENCODE_ENABLE_FRAME_TRACKING_ID,
+    __MEDIA_USER_FEATURE_VALUE_ENCODE_FRAME_CONTEXT_NUM_ID,
+    __MEDIA_USER_FEATURE_VALUE_ENCODE_BUFFER_POOL_BUDGET_ID,
+    __MEDIA_USER_FEATURE_VALUE_CODEC_PROLOG_CACHE_MODE_ID,
+    __MEDIA_USER_FEATURE_VALUE_JPEG_ENCODE_TABLE_REUSE_DISABLE_ID,
     __MEDIA_USER_FEATURE_VALUE_ENCODE_USED_VDBOX_NUM_ID,
     __MEDIA_USER_FEATURE_VALUE_ENCODE_ENABLE_COMPUTE_CONTEXT_ID,
     __MEDIA_USER_FEATURE_VALUE_DECODE_ENABLE_COMPUTE_CONTEXT_ID,
@@ -446,6 +490,7 @@ typedef enum _MOS_USER_FEATURE_VALUE_ID
     __MOS_USER_FEATURE_KEY_SUB_COMPONENT_BLT_TAG_ID,
 #endif // MOS_MESSAGES_ENABLED
     __MEDIA_USER_FEATURE_VALUE_HEVC_SF_2_DMA_SUBMITS_ENABLE_ID,
+    __MEDIA_USER_FEATURE_VALUE_HEVC_PIC_TEMPLATE_ENABLE_ID,
     __MEDIA_USER_FEATURE_VALUE_HEVCDATROWSTORECACHE_DISABLE_ID,
     __MEDIA_USER_FEATURE_VALUE_HEVCDFROWSTORECACHE_DISABLE_ID,
     __MEDIA_USER_FEATURE_VALUE_HEVCSAOROWSTORECACHE_DISABLE_ID,
@@ -496,6 +541,8 @@ typedef enum _MOS_USER_FEATURE_VALUE_ID
     __VPHAL_SET_SINGLE_SLICE_VEBOX_ID,
     __VPHAL_BYPASS_COMPOSITION_ID,
     __VPHAL_VEBOX_DISABLE_SFC_ID,
+    __VPHAL_VEBOX_AUTO_DN_UPDATE_MODE_ID,
+    __VPHAL_VEBOX_FORCE_AUTO_DENOISE_ID,
     __VPHAL_ENABLE_MMC_ID,
     __VPHAL_ENABLE_MMC_IN_USE_ID,
     __VPHAL_ENABLE_VEBOX_MMC_DECOMPRESS_ID,
@@ -817,6 +864,8 @@ typedef struct
 
 extern "C" int32_t MOS_AtomicIncrement(int32_t *pValue);   // forward declaration
 extern "C" int32_t MOS_AtomicDecrement(int32_t *pValue);   // forward declaration
+extern "C" int32_t *MOS_GetMemAllocCounterShard();         // forward declaration
+extern "C" int32_t MOS_GetMemAllocCounter();               // forward declaration
 
 //template<class _Ty, class... _Types> inline
 //std::shared_ptr<_Ty> MOS_MakeShared(_Types&&... _Args)
@@ -864,7 +913,7 @@ _Ty* MOS_NewUtil(_Types&&... _Args)
         _Ty* ptr = new (std::nothrow) _Ty(std::forward<_Types>(_Args)...);
         if (ptr != nullptr)
         {
-            MOS_AtomicIncrement(&MosMemAllocCounter);
+            MOS_AtomicIncrement(MOS_GetMemAllocCounterShard());
             MOS_MEMNINJA_ALLOC_MESSAGE(ptr, sizeof(_Ty), functionName, filename, line);
         }
         else
@@ -894,7 +943,7 @@ _Ty* MOS_NewArrayUtil(int32_t numElements)
         _Ty* ptr = new (std::nothrow) _Ty[numElements]();
         if (ptr != nullptr)
         {
-            MOS_AtomicIncrement(&MosMemAllocCounter);
+            MOS_AtomicIncrement(MOS_GetMemAllocCounterShard());
             MOS_MEMNINJA_ALLOC_MESSAGE(ptr, numElements*sizeof(_Ty), functionName, filename, line);
         }
         return ptr;
@@ -922,7 +971,7 @@ void MOS_DeleteUtil(_Ty& ptr)
 {
     if (ptr != nullptr)
     {
-        MOS_AtomicDecrement(&MosMemAllocCounter);
+        MOS_AtomicDecrement(MOS_GetMemAllocCounterShard());
         MOS_MEMNINJA_FREE_MESSAGE(ptr, functionName, filename, line);
         delete(ptr);
         ptr = nullptr;
@@ -943,7 +992,7 @@ void MOS_DeleteArrayUtil(_Ty& ptr)
 {
     if (ptr != nullptr)
     {
-        MOS_AtomicDecrement(&MosMemAllocCounter);
+        MOS_AtomicDecrement(MOS_GetMemAllocCounterShard());
         MOS_MEMNINJA_FREE_MESSAGE(ptr, functionName, filename, line);
 
         delete[](ptr);
@@ -1004,6 +1053,28 @@ MOS_STATUS MOS_OS_Utilities_Close();
 //------------------------------------------------------------------------------
 //  Allocate, free and set a memory region
 //------------------------------------------------------------------------------
+//!
+//! \brief    Get the shard of the memory allocation counter owned by this thread
+//! \details  Threads are assigned shards round robin on first use.
+//! \return   int32_t *
+//!           Pointer to the shard value, to be updated with MOS_AtomicIncrement/Decrement
+//!
+int32_t *MOS_GetMemAllocCounterShard();
+
+//!
+//! \brief    Get the system memory allocation counter
+//! \details  Sums all counter shards. Exact when no allocation is in flight.
+//! \return   int32_t
+//!           Number of outstanding MOS system memory allocations
+//!
+int32_t MOS_GetMemAllocCounter();
+
+//!
+//! \brief    Reset the system memory allocation counter to 0
+//! \return   void
+//!
+void MOS_ResetMemAllocCounter();
+
 //!
 //! \brief    Allocates aligned memory and performs error checking
 //! \details  Wrapper for aligned_malloc(). Performs error checking.
@@ -1166,6 +1237,55 @@ void MOS_FreeMemory(
     void            *ptr);
 #endif // MOS_MESSAGES_ENABLED
 
+//!
+//! \brief    Allocates memory from the small block pool
+//! \details  Same as MOS_AllocMemory() but sizes up to MOS_MEMORY_POOL_MAX_BLOCK_SIZE are
+//!           served from per-thread slab caches instead of malloc(). Larger sizes fall
+//!           back to malloc(). The memory must be released with MOS_FreeMemory() and
+//!           must not be passed to realloc()/free() directly.
+//! \param    [in] size
+//!           Size of memorry to be allocated
+//! \return   void *
+//!           Pointer to allocated memory
+//!
+#if MOS_MESSAGES_ENABLED
+void  *MOS_AllocPooledMemoryUtils(
+    size_t     size,
+    const char *functionName,
+    const char *filename,
+    int32_t    line);
+
+#define MOS_AllocPooledMemory(size) \
+    MOS_AllocPooledMemoryUtils(size, __FUNCTION__, __FILE__, __LINE__)
+
+#else // !MOS_MESSAGES_ENABLED
+void  *MOS_AllocPooledMemory(
+    size_t                   size);
+#endif // MOS_MESSAGES_ENABLED
+
+//!
+//! \brief    Allocates memory from the small block pool and fills it with 0
+//! \details  Pooled counterpart of MOS_AllocAndZeroMemory(), see MOS_AllocPooledMemory().
+//! \param    [in] size
+//!           Size of memorry to be allocated
+//! \return   void *
+//!           Pointer to allocated memory
+//!
+#if MOS_MESSAGES_ENABLED
+void  *MOS_AllocAndZeroPooledMemoryUtils(
+    size_t     size,
+    const char *functionName,
+    const char *filename,
+    int32_t    line);
+
+#define MOS_AllocAndZeroPooledMemory(size) \
+    MOS_AllocAndZeroPooledMemoryUtils(size, __FUNCTION__, __FILE__, __LINE__)
+
+#else // !MOS_MESSAGES_ENABLED
+void  *MOS_AllocAndZeroPooledMemory(
+    size_t                   size);
+#endif // MOS_MESSAGES_ENABLED
+
 //!
 //! \brief    Wrapper for MOS_FreeMemory().
 //! \details  Wrapper for MOS_FreeMemory().  Calls MOS_FreeMemory() and then sets ptr to NULL.
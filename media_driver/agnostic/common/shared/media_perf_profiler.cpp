@@ -130,7 +130,7 @@ MediaPerfProfiler::MediaPerfProfiler()
 
     // m_mutex is destroyed after MemNinja report, this will cause fake memory leak,
     // the following 2 lines is to circumvent Memninja counter validation and log parser
-    MOS_AtomicDecrement(&MosMemAllocCounter);
+    MOS_AtomicDecrement(MOS_GetMemAllocCounterShard());
     MOS_MEMNINJA_FREE_MESSAGE(m_mutex, __FUNCTION__, __FILE__, __LINE__);
 }
 
@@ -38,6 +38,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/vphal_mdf_wrapper.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_16alignment.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_fast1ton.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/vphal_render_kernel_launcher.cpp
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_vebox_denoise.cpp
 )
 
@@ -62,8 +63,11 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vphal_mdf_wrapper.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_16alignment.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_fast1ton.h
+    ${CMAKE_CURRENT_LIST_DIR}/vphal_render_kernel_launcher.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_common_hdr.h
     ${CMAKE_CURRENT_LIST_DIR}/vphal_render_vebox_denoise.h
+    ${CMAKE_CURRENT_LIST_DIR}/vphal_render_vebox_denoise_params.h
+    ${CMAKE_CURRENT_LIST_DIR}/vphal_render_hdr_3dlut_cache.h
 )
 
 
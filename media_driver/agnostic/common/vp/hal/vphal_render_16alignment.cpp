@@ -32,7 +32,6 @@
 #include "vphal_debug.h"
 #include "vpkrnheader.h"
 #include "vphal_render_composite.h"
-#include "vphal_render_ief.h"
 #include "vphal_renderer.h"
 
 #define AVS_SAMPLER_INDEX       1
@@ -68,6 +67,17 @@ static const RENDERHAL_KERNEL_PARAM g_16Align_MW_KernelParam[2] =
     { 4, 34,  1, VPHAL_USE_MEDIA_THREADS_MAX,  0,  4,  32,  8,  1,  1 },     // YV12 only
 };
 
+//!
+//! \brief 16 Bytes Alignment kernel launched for Gen9 Media Walker
+//!
+static const VPHAL_KERNEL_LAUNCH_DESC g_16Align_KernelLaunchDesc =
+{
+    (RENDERHAL_COMPONENT)RENDERHAL_COMPONENT_16ALIGN,   // Component
+    IDR_VP_1_1_16aligned,                               // iKUID
+    kernelUserPtr,                                      // KernelID
+    VPHAL_NONE                                          // PerfTag
+};
+
 //!
 //! \brief    16Align load the curbe data
 //! \details  Curbe data for 16Align
@@ -75,17 +85,13 @@ static const RENDERHAL_KERNEL_PARAM g_16Align_MW_KernelParam[2] =
 //!           [in] Pointer to the 16Align State
 //! \param    PVPHAL_16_ALIGN_RENDER_DATA pRenderData
 //!           [in] Pointer to 16Align render data
-//! \param    int32_t* piCurbeOffset
-//!           [out] Pointer to curbe data offset
 //! \return   MOS_STATUS
 //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
 //!
 MOS_STATUS VpHal_16AlignLoadStaticData(
     PVPHAL_16_ALIGN_STATE           p16AlignState,
-    PVPHAL_16_ALIGN_RENDER_DATA     pRenderData,
-    int32_t*                        piCurbeOffset)
+    PVPHAL_16_ALIGN_RENDER_DATA     pRenderData)
 {
-    PRENDERHAL_INTERFACE                    pRenderHal;
     MEDIA_WALKER_16ALIGN_STATIC_DATA        WalkerStatic;
     MOS_STATUS                              eStatus;
     int32_t                                 iCurbeLength;
@@ -94,9 +100,7 @@ MOS_STATUS VpHal_16AlignLoadStaticData(
     float                                   fStepX, fStepY;
 
     VPHAL_RENDER_CHK_NULL(p16AlignState);
-    VPHAL_RENDER_CHK_NULL(p16AlignState->pRenderHal);
     eStatus          = MOS_STATUS_SUCCESS;
-    pRenderHal       = p16AlignState->pRenderHal;
 
     // Set relevant static data
     MOS_ZeroMemory(&WalkerStatic, sizeof(MEDIA_WALKER_16ALIGN_STATIC_DATA));
@@ -153,7 +157,7 @@ MOS_STATUS VpHal_16AlignLoadStaticData(
         default:
             VPHAL_RENDER_ASSERTMESSAGE("16 align input format doesn't support.");
             eStatus = MOS_STATUS_INVALID_PARAMETER;
-            break;
+            goto finish;
     }
 #if defined(LINUX)
     WalkerStatic.DW10.Output_Pitch            = p16AlignState->pTarget->OsResource.iPitch;
@@ -179,7 +183,7 @@ MOS_STATUS VpHal_16AlignLoadStaticData(
         default:
             VPHAL_RENDER_ASSERTMESSAGE("16 align output format doesn't support.");
             eStatus = MOS_STATUS_INVALID_PARAMETER;
-            break;
+            goto finish;
     }
     if (p16AlignState->pTarget->bUsrPtr)
     {
@@ -212,17 +216,10 @@ MOS_STATUS VpHal_16AlignLoadStaticData(
 
     iCurbeLength = sizeof(MEDIA_WALKER_16ALIGN_STATIC_DATA);
 
-    *piCurbeOffset = pRenderHal->pfnLoadCurbeData(
-        pRenderHal,
-        pRenderData->pMediaState,
+    VPHAL_RENDER_CHK_STATUS(VpHal_KernelLauncherLoadCurbe(
+        &p16AlignState->KernelLauncher,
         &WalkerStatic,
-        iCurbeLength);
-
-    if (*piCurbeOffset < 0)
-    {
-        eStatus = MOS_STATUS_UNKNOWN;
-        goto finish;
-    }
+        iCurbeLength));
 
 finish:
     VPHAL_RENDER_ASSERT(eStatus == MOS_STATUS_SUCCESS);
@@ -244,321 +241,23 @@ MOS_STATUS VpHal_16AlignSetupKernel(
     PVPHAL_16_ALIGN_RENDER_DATA  pRenderData)
 {
     MOS_STATUS      eStatus;
-    Kdll_CacheEntry *pCacheEntryTable;
 
     VPHAL_RENDER_CHK_NULL(p16AlignState);
+    MOS_UNUSED(pRenderData);
     eStatus             = MOS_STATUS_SUCCESS;
-    pCacheEntryTable    = 
-        p16AlignState->pKernelDllState->ComponentKernelCache.pCacheEntries;
 
-    // Set the Kernel Parameters
-    pRenderData->pKernelParam   = p16AlignState->pKernelParamTable;
-    pRenderData->PerfTag        = VPHAL_NONE;
-
-    // Set curbe & inline data size
-    pRenderData->iCurbeLength   = pRenderData->pKernelParam->CURBE_Length * GRF_SIZE;
-
-    // Set Kernel entry
-    pRenderData->KernelEntry.iKUID     = IDR_VP_1_1_16aligned;
-    pRenderData->KernelEntry.iKCID     = -1;
-    pRenderData->KernelEntry.iSize     = pCacheEntryTable[IDR_VP_1_1_16aligned].iSize;
-    pRenderData->KernelEntry.pBinary   = pCacheEntryTable[IDR_VP_1_1_16aligned].pBinary;
-
-finish:
-    return eStatus;
-}
-
-//!
-//! \brief    Recalculate Sampler Avs 8x8 Horizontal/Vertical scaling table
-//! \details  Recalculate Sampler Avs 8x8 Horizontal/Vertical scaling table
-//! \param    MOS_FORMAT SrcFormat
-//!           [in] Source Format
-//! \param    float fScale
-//!           [in] Horizontal or Vertical Scale Factor
-//! \param    bool bVertical
-//!           [in] true if Vertical Scaling, else Horizontal Scaling
-//! \param    uint32_t dwChromaSiting
-//!           [in] Chroma Siting
-//! \param    bool bBalancedFilter
-//!           [in] true if Gen9+, balanced filter
-//! \param    bool b8TapAdaptiveEnable
-//!           [in] true if 8Tap Adaptive Enable
-//! \param    PVPHAL_AVS_PARAMS pAvsParams
-//!           [in/out] Pointer to AVS Params
-//! \return   MOS_STATUS
-//!
-static MOS_STATUS VpHal_16AlignSamplerAvsCalcScalingTable(
-    MOS_FORMAT                      SrcFormat,
-    float                           fScale,
-    bool                            bVertical,
-    uint32_t                        dwChromaSiting,
-    bool                            bBalancedFilter,
-    bool                            b8TapAdaptiveEnable,
-    PMHW_AVS_PARAMS                 pAvsParams)
-{
-    MOS_STATUS                      eStatus = MOS_STATUS_SUCCESS;
-    MHW_PLANE                       Plane;
-    int32_t                         iUvPhaseOffset;
-    uint32_t                        dwHwPhrase;
-    uint32_t                        YCoefTableSize;
-    uint32_t                        UVCoefTableSize;
-    float                           fScaleParam;
-    int32_t*                        piYCoefsParam;
-    int32_t*                        piUVCoefsParam;
-    float                           fHPStrength;
-
-    VPHAL_RENDER_CHK_NULL(pAvsParams);
-    VPHAL_RENDER_CHK_NULL(pAvsParams->piYCoefsY);
-    VPHAL_RENDER_CHK_NULL(pAvsParams->piYCoefsX);
-    VPHAL_RENDER_CHK_NULL(pAvsParams->piUVCoefsY);
-    VPHAL_RENDER_CHK_NULL(pAvsParams->piUVCoefsX);
-
-    if (bBalancedFilter)
-    {
-        YCoefTableSize      = POLYPHASE_Y_COEFFICIENT_TABLE_SIZE_G9;
-        UVCoefTableSize     = POLYPHASE_UV_COEFFICIENT_TABLE_SIZE_G9;
-        dwHwPhrase          = NUM_HW_POLYPHASE_TABLES_G9;
-    }
-    else
-    {
-        YCoefTableSize      = POLYPHASE_Y_COEFFICIENT_TABLE_SIZE_G8;
-        UVCoefTableSize     = POLYPHASE_UV_COEFFICIENT_TABLE_SIZE_G8;
-        dwHwPhrase          = MHW_NUM_HW_POLYPHASE_TABLES;
-    }
-
-    fHPStrength = 0.0F;
-    piYCoefsParam   = bVertical ? pAvsParams->piYCoefsY : pAvsParams->piYCoefsX;
-    piUVCoefsParam  = bVertical ? pAvsParams->piUVCoefsY : pAvsParams->piUVCoefsX;
-    fScaleParam     = bVertical ? pAvsParams->fScaleY : pAvsParams->fScaleX;
-
-    // Recalculate Horizontal or Vertical scaling table
-    if (SrcFormat != pAvsParams->Format || fScale != fScaleParam)
-    {
-        MOS_ZeroMemory(piYCoefsParam, YCoefTableSize);
-        MOS_ZeroMemory(piUVCoefsParam, UVCoefTableSize);
-
-        // 4-tap filtering for RGB format G-channel if 8tap adaptive filter is not enabled.
-        Plane = (IS_RGB32_FORMAT(SrcFormat) && !b8TapAdaptiveEnable) ? MHW_U_PLANE : MHW_Y_PLANE;
-        if (bVertical)
-        {
-            pAvsParams->fScaleY = fScale;
-        }
-        else
-        {
-            pAvsParams->fScaleX = fScale;
-        }
-
-        // For 1x scaling in horizontal direction, use special coefficients for filtering
-        // we don't do this when bForcePolyPhaseCoefs flag is set
-        if (fScale == 1.0F && !pAvsParams->bForcePolyPhaseCoefs)
-        {
-            VPHAL_RENDER_CHK_STATUS(Mhw_SetNearestModeTable(
-                piYCoefsParam,
-                Plane,
-                bBalancedFilter));
-            // If the 8-tap adaptive is enabled for all channel, then UV/RB use the same coefficient as Y/G
-            // So, coefficient for UV/RB channels caculation can be passed
-            if (!b8TapAdaptiveEnable)
-            {
-                VPHAL_RENDER_CHK_STATUS(Mhw_SetNearestModeTable(
-                    piUVCoefsParam,
-                    MHW_U_PLANE,
-                    bBalancedFilter));
-            }
-        }
-        else
-        {
-            // Clamp the Scaling Factor if > 1.0x
-            fScale = MOS_MIN(1.0F, fScale);
-
-            VPHAL_RENDER_CHK_STATUS(Mhw_CalcPolyphaseTablesY(
-                piYCoefsParam,
-                fScale,
-                Plane,
-                SrcFormat,
-                fHPStrength,
-                true,
-                dwHwPhrase));
-
-            // If the 8-tap adaptive is enabled for all channel, then UV/RB use the same coefficient as Y/G
-            // So, coefficient for UV/RB channels caculation can be passed
-            if (!b8TapAdaptiveEnable)
-            {
-                if (!bBalancedFilter)
-                {
-                    VPHAL_RENDER_CHK_STATUS(Mhw_CalcPolyphaseTablesY(
-                        piUVCoefsParam,
-                        fScale,
-                        MHW_U_PLANE,
-                        SrcFormat,
-                        fHPStrength,
-                        true,
-                        dwHwPhrase));
-                }
-                else
-                {
-                    // If Chroma Siting info is present
-                    if (dwChromaSiting & (bVertical ? MHW_CHROMA_SITING_VERT_TOP : MHW_CHROMA_SITING_HORZ_LEFT))
-                    {
-                        // No Chroma Siting
-                        VPHAL_RENDER_CHK_STATUS(Mhw_CalcPolyphaseTablesUV(
-                            piUVCoefsParam,
-                            2.0F,
-                            fScale));
-                    }
-                    else
-                    {
-                        // Chroma siting offset needs to be added
-                        if (dwChromaSiting & (bVertical ? MHW_CHROMA_SITING_VERT_CENTER : MHW_CHROMA_SITING_HORZ_CENTER))
-                        {
-                            iUvPhaseOffset = MOS_UF_ROUND(0.5F * 16.0F);   // U0.4
-                        }
-                        else //if (ChromaSiting & (bVertical ? MHW_CHROMA_SITING_VERT_BOTTOM : MHW_CHROMA_SITING_HORZ_RIGHT))
-                        {
-                            iUvPhaseOffset = MOS_UF_ROUND(1.0F * 16.0F);   // U0.4
-                        }
-
-                        VPHAL_RENDER_CHK_STATUS(Mhw_CalcPolyphaseTablesUVOffset(
-                            piUVCoefsParam,
-                            3.0F,
-                            fScale,
-                            iUvPhaseOffset));
-                    }
-                }
-            }
-        }
-    }
+    // Set the Kernel Parameters, the kernel entry is kept by the launcher
+    VPHAL_RENDER_CHK_STATUS(VpHal_KernelLauncherSetKernel(
+        &p16AlignState->KernelLauncher,
+        p16AlignState->pKernelParamTable));
 
 finish:
     return eStatus;
 }
 
 //!
-//! \brief    Set Sampler Avs 8x8 Table for LGCA
-//! \details  Set Sampler Avs 8x8 Table for LGCA
-//! \param    PRENDERHAL_INTERFACE pRenderHal
-//!           [in] Pointer to RenderHal Interface Structure
-//! \param    PMHW_SAMPLER_STATE_PARAM pSamplerStateParams
-//!           [in] Pointer to Sampler State Params
-//! \param    PMHW_AVS_PARAMS pAvsParams
-//!           [in/out] Pointer to AVS Params
-//! \param    MOS_FORMAT SrcFormat
-//!           [in] Source Format
-//! \return   MOS_STATUS
-//!
-static MOS_STATUS VpHal_16AlignSetSamplerAvsTableParam(
-    PRENDERHAL_INTERFACE            pRenderHal,
-    PMHW_SAMPLER_STATE_PARAM        pSamplerStateParams,
-    PMHW_AVS_PARAMS                 pAvsParams,
-    MOS_FORMAT                      SrcFormat,
-    float                           fScaleX,
-    float                           fScaleY,
-    uint32_t                        dwChromaSiting)
-{
-    MOS_STATUS                   eStatus = MOS_STATUS_SUCCESS;
-    bool                         bBalancedFilter;
-    PMHW_SAMPLER_AVS_TABLE_PARAM pMhwSamplerAvsTableParam;
-
-    VPHAL_RENDER_CHK_NULL(pRenderHal);
-    VPHAL_RENDER_CHK_NULL(pSamplerStateParams);
-    VPHAL_RENDER_CHK_NULL(pAvsParams);
-    if (pAvsParams->piUVCoefsX == nullptr || pAvsParams->piYCoefsY  == nullptr ||
-        pAvsParams->piYCoefsX  == nullptr || pAvsParams->piUVCoefsY == nullptr ||
-        pAvsParams             == nullptr)
-    {
-        VPHAL_RENDER_ASSERTMESSAGE("meet null ptr!");
-    }
-
-    pMhwSamplerAvsTableParam = pSamplerStateParams->Avs.pMhwSamplerAvsTableParam;
-
-    pMhwSamplerAvsTableParam->b8TapAdaptiveEnable         = pSamplerStateParams->Avs.b8TapAdaptiveEnable;
-    pMhwSamplerAvsTableParam->byteTransitionArea8Pixels   = MEDIASTATE_AVS_TRANSITION_AREA_8_PIXELS;
-    pMhwSamplerAvsTableParam->byteTransitionArea4Pixels   = MEDIASTATE_AVS_TRANSITION_AREA_4_PIXELS;
-    pMhwSamplerAvsTableParam->byteMaxDerivative8Pixels    = MEDIASTATE_AVS_MAX_DERIVATIVE_8_PIXELS;
-    pMhwSamplerAvsTableParam->byteMaxDerivative4Pixels    = MEDIASTATE_AVS_MAX_DERIVATIVE_4_PIXELS;
-    pMhwSamplerAvsTableParam->byteDefaultSharpnessLevel   = MEDIASTATE_AVS_SHARPNESS_LEVEL_SHARP;
-
-    // Enable Adaptive Filtering, if it is being upscaled
-    // in either direction. we must check for this before clamping the SF.
-    if ((IS_YUV_FORMAT(SrcFormat) && (fScaleX > 1.0F || fScaleY > 1.0F)) ||
-        pMhwSamplerAvsTableParam->b8TapAdaptiveEnable)
-    {
-        pMhwSamplerAvsTableParam->bBypassXAdaptiveFiltering = false;
-        pMhwSamplerAvsTableParam->bBypassYAdaptiveFiltering = false;
-        if (pMhwSamplerAvsTableParam->b8TapAdaptiveEnable)
-        {
-            pMhwSamplerAvsTableParam->bAdaptiveFilterAllChannels = true;
-
-            if (IS_RGB_FORMAT(SrcFormat))
-            {
-                pMhwSamplerAvsTableParam->bEnableRGBAdaptive     = true;
-            }
-        }
-    }
-    else
-    {
-        pMhwSamplerAvsTableParam->bBypassXAdaptiveFiltering = true;
-        pMhwSamplerAvsTableParam->bBypassYAdaptiveFiltering = true;
-    }
-
-    // No changes to AVS parameters -> skip
-    if (SrcFormat == pAvsParams->Format &&
-        fScaleX == pAvsParams->fScaleX &&
-        fScaleY == pAvsParams->fScaleY)
-    {
-        goto finish;
-    }
-
-    // AVS Coefficients don't change for Scaling Factors > 1.0x
-    // Hence recalculation is avoided
-    if (fScaleX > 1.0F && pAvsParams->fScaleX > 1.0F)
-    {
-        pAvsParams->fScaleX = fScaleX;
-    }
-
-    // AVS Coefficients don't change for Scaling Factors > 1.0x
-    // Hence recalculation is avoided
-    if (fScaleY > 1.0F && pAvsParams->fScaleY > 1.0F)
-    {
-        pAvsParams->fScaleY = fScaleY;
-    }
-
-    bBalancedFilter = true;
-    // Recalculate Horizontal scaling table
-    VPHAL_HW_CHK_STATUS(VpHal_16AlignSamplerAvsCalcScalingTable(
-        SrcFormat,
-        fScaleX,
-        false,
-        dwChromaSiting,
-        bBalancedFilter,
-        pMhwSamplerAvsTableParam->b8TapAdaptiveEnable ? true : false,
-        pAvsParams));
-
-    // Recalculate Vertical scaling table
-    VPHAL_HW_CHK_STATUS(VpHal_16AlignSamplerAvsCalcScalingTable(
-        SrcFormat,
-        fScaleY,
-        true,
-        dwChromaSiting,
-        bBalancedFilter,
-        pMhwSamplerAvsTableParam->b8TapAdaptiveEnable ? true : false,
-        pAvsParams));
-
-    pMhwSamplerAvsTableParam->bIsCoeffExtraEnabled = true;
-    // Save format used to calculate AVS parameters
-    pAvsParams->Format                             = SrcFormat;
-    pMhwSamplerAvsTableParam->b4TapGY              = (IS_RGB32_FORMAT(SrcFormat) && !pMhwSamplerAvsTableParam->b8TapAdaptiveEnable);
-    pMhwSamplerAvsTableParam->b4TapRBUV            = (!pMhwSamplerAvsTableParam->b8TapAdaptiveEnable);
-
-    VpHal_RenderCommonSetAVSTableParam(pAvsParams, pMhwSamplerAvsTableParam);
-
-finish:
-    return eStatus;
-}
-
-//!
-//! \brief    16Align setup HW states
-//! \details  Setup HW states for 16Align
+//! \brief    16Align set sampler states
+//! \details  Set the sampler state params of the 16Align kernel
 //! \param    PVPHAL_16_ALIGN_STATE p16AlignState
 //!           [in] Pointer to the 16Align State
 //! \param    PVPHAL_16_ALIGN_RENDER_DATA pRenderData
@@ -571,60 +270,29 @@ MOS_STATUS VpHal_16AlignSetSamplerStates(
     PVPHAL_16_ALIGN_RENDER_DATA  pRenderData)
 {
     MOS_STATUS                  eStatus;
-    PRENDERHAL_INTERFACE        pRenderHal;
-    PMHW_SAMPLER_STATE_PARAM    pSamplerStateParams;
 
     VPHAL_PUBLIC_CHK_NULL(p16AlignState);
     VPHAL_PUBLIC_CHK_NULL(pRenderData);
-
-    pRenderHal = p16AlignState->pRenderHal;
-
-    VPHAL_PUBLIC_CHK_NULL(pRenderHal);
-    pSamplerStateParams                          = &pRenderData->SamplerStateParams;
-    pSamplerStateParams->bInUse                  = true;
+    eStatus = MOS_STATUS_SUCCESS;
 
     if (pRenderData->ScalingRatio_H < 0.0625f ||
         pRenderData->ScalingRatio_V < 0.0625f)
     {
         p16AlignState->pSource->bUseSampleUnorm      = true;
-        pSamplerStateParams->SamplerType             = MHW_SAMPLER_TYPE_3D;
-        pSamplerStateParams->Unorm.SamplerFilterMode = MHW_SAMPLER_FILTER_BILINEAR;
-        pSamplerStateParams->Unorm.AddressU          = MHW_GFX3DSTATE_TEXCOORDMODE_CLAMP;
-        pSamplerStateParams->Unorm.AddressV          = MHW_GFX3DSTATE_TEXCOORDMODE_CLAMP;
-        pSamplerStateParams->Unorm.AddressW          = MHW_GFX3DSTATE_TEXCOORDMODE_CLAMP;
+        VPHAL_RENDER_CHK_STATUS(VpHal_KernelLauncherSet3DSampler(
+                        &p16AlignState->KernelLauncher,
+                        0));
     }
     else
     {
-        pSamplerStateParams->SamplerType             = MHW_SAMPLER_TYPE_AVS;
-        pSamplerStateParams->Avs.AvsType             = false;
-        pSamplerStateParams->Avs.bEnableIEF          = false;
-        pSamplerStateParams->Avs.b8TapAdaptiveEnable = false;
-        pSamplerStateParams->Avs.bHdcDwEnable        = true;
-        pSamplerStateParams->Avs.bEnableAVS          = true;
-        pSamplerStateParams->Avs.WeakEdgeThr         = DETAIL_WEAK_EDGE_THRESHOLD;
-        pSamplerStateParams->Avs.StrongEdgeThr       = DETAIL_STRONG_EDGE_THRESHOLD;
-        pSamplerStateParams->Avs.StrongEdgeWght      = DETAIL_STRONG_EDGE_WEIGHT;
-        pSamplerStateParams->Avs.RegularWght         = DETAIL_REGULAR_EDGE_WEIGHT;
-        pSamplerStateParams->Avs.NonEdgeWght         = DETAIL_NON_EDGE_WEIGHT;
-        pSamplerStateParams->Avs.pMhwSamplerAvsTableParam = &p16AlignState->mhwSamplerAvsTableParam;
-
-        VPHAL_RENDER_CHK_STATUS(VpHal_16AlignSetSamplerAvsTableParam(
-                        pRenderHal,
-                        pSamplerStateParams,
-                        pRenderData->pAVSParameters,
+        VPHAL_RENDER_CHK_STATUS(VpHal_KernelLauncherSetAvsSampler(
+                        &p16AlignState->KernelLauncher,
+                        0,
                         p16AlignState->pSource->Format,
                         pRenderData->ScalingRatio_H,
-                        pRenderData->ScalingRatio_V,
-                        MHW_CHROMA_SITING_HORZ_LEFT | MHW_CHROMA_SITING_VERT_TOP));
+                        pRenderData->ScalingRatio_V));
     }
 
-
-    eStatus = pRenderHal->pfnSetSamplerStates(
-        pRenderHal,
-        pRenderData->iMediaID,
-        pSamplerStateParams,
-        1);
-
 finish:
     return eStatus;
 }
@@ -643,31 +311,12 @@ MOS_STATUS VpHal_16AlignSetupHwStates(
     PVPHAL_16_ALIGN_STATE        p16AlignState,
     PVPHAL_16_ALIGN_RENDER_DATA  pRenderData)
 {
-    PRENDERHAL_INTERFACE        pRenderHal;
-    int32_t                     iKrnAllocation;
-    int32_t                     iCurbeOffset;
     MOS_STATUS                  eStatus;
-    int32_t                     iThreadCount;
-    MHW_KERNEL_PARAM            MhwKernelParam;
 
     VPHAL_RENDER_CHK_NULL(p16AlignState);
     VPHAL_RENDER_CHK_NULL(pRenderData);
 
     eStatus                     = MOS_STATUS_SUCCESS;
-    pRenderHal                  = p16AlignState->pRenderHal;
-    VPHAL_RENDER_CHK_NULL(pRenderHal);
-
-    // Allocate and reset media state
-    pRenderData->pMediaState = pRenderHal->pfnAssignMediaState(pRenderHal, (RENDERHAL_COMPONENT)RENDERHAL_COMPONENT_16ALIGN);
-    VPHAL_RENDER_CHK_NULL(pRenderData->pMediaState);
-
-    // Allocate and reset SSH instance
-    VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnAssignSshInstance(pRenderHal));
-
-    // Assign and Reset Binding Table
-    VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnAssignBindingTable(
-            pRenderHal,
-            &pRenderData->iBindingTable));
 
     // Setup surface states
     VPHAL_RENDER_CHK_STATUS(p16AlignState->pfnSetupSurfaceStates(
@@ -677,141 +326,22 @@ MOS_STATUS VpHal_16AlignSetupHwStates(
     // load static data
     VPHAL_RENDER_CHK_STATUS(p16AlignState->pfnLoadStaticData(
             p16AlignState,
-            pRenderData,
-            &iCurbeOffset));
-
-    if (p16AlignState->pPerfData->CompMaxThreads.bEnabled)
-    {
-        iThreadCount = p16AlignState->pPerfData->CompMaxThreads.uiVal;
-    }
-    else
-    {
-        iThreadCount = pRenderData->pKernelParam->Thread_Count;
-    }
-
-    // Setup VFE State params.
-    VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnSetVfeStateParams(
-        pRenderHal,
-        MEDIASTATE_DEBUG_COUNTER_FREE_RUNNING,
-        iThreadCount,
-        pRenderData->iCurbeLength,
-        pRenderData->iInlineLength,
-        nullptr));
-
-    // Load kernel to GSH
-    INIT_MHW_KERNEL_PARAM(MhwKernelParam, &pRenderData->KernelEntry);
-    iKrnAllocation = pRenderHal->pfnLoadKernel(
-        pRenderHal,
-        pRenderData->pKernelParam,
-        &MhwKernelParam,
-        nullptr);
-
-    if (iKrnAllocation < 0) 
-    {
-        eStatus = MOS_STATUS_UNKNOWN;
-        goto finish;
-    }
-
-    // Allocate Media ID, link to kernel
-    pRenderData->iMediaID = pRenderHal->pfnAllocateMediaID(
-        pRenderHal,
-        iKrnAllocation,
-        pRenderData->iBindingTable,
-        iCurbeOffset,
-        (pRenderData->pKernelParam->CURBE_Length << 5),
-        0,
-        nullptr);
-    
-    if (pRenderData->iMediaID < 0) 
-    {
-        eStatus = MOS_STATUS_UNKNOWN;
-        goto finish;
-    }
+            pRenderData));
 
-    // Set Sampler states for this Media ID
+    // Set Sampler states
     VPHAL_RENDER_CHK_STATUS(p16AlignState->pfnSetSamplerStates(
-        p16AlignState, 
+        p16AlignState,
         pRenderData));
 
+    // VFE, kernel, media ID and samplers
+    VPHAL_RENDER_CHK_STATUS(VpHal_KernelLauncherSetupHwStates(
+        &p16AlignState->KernelLauncher));
+
 finish:
     VPHAL_RENDER_ASSERT(eStatus == MOS_STATUS_SUCCESS);
     return eStatus;
 }
 
-//!
-//! \brief    16Align media walker setup
-//! \details  Media walker setup for bitcopy
-//! \param    PVPHAL_16_ALIGN_STATE p16AlignState
-//!           [in] Pointer to the 16Align State
-//! \param    PVPHAL_16_ALIGN_RENDER_DATA pRenderData
-//!           [in] Pointer to 16Align render data
-//! \param    PMHW_WALKER_PARAMS pWalkerParams
-//!           [in/out] Pointer to Walker params
-//! \return   MOS_STATUS
-//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
-//!
-MOS_STATUS VpHal_16AlignRenderMediaWalker(
-    PVPHAL_16_ALIGN_STATE        p16AlignState,    
-    PVPHAL_16_ALIGN_RENDER_DATA  pRenderData,
-    PMHW_WALKER_PARAMS               pWalkerParams)
-{
-    PRENDERHAL_INTERFACE            pRenderHal;
-    uint32_t                        dwWidth;
-    uint32_t                        dwHeight;
-    MOS_STATUS                      eStatus;
-
-    eStatus     = MOS_STATUS_SUCCESS;
-    pRenderHal  = p16AlignState->pRenderHal;
-
-    // Calculate how many media object commands are needed.
-    dwWidth  = MOS_ALIGN_CEIL((p16AlignState->pTarget->rcDst.right -
-                           p16AlignState->pTarget->rcDst.left),
-                           pRenderData->pKernelParam->block_width);
-    dwHeight = MOS_ALIGN_CEIL((p16AlignState->pTarget->rcDst.bottom -
-                           p16AlignState->pTarget->rcDst.top),
-                           pRenderData->pKernelParam->block_height);
-
-    pRenderData->iBlocksX = dwWidth  / pRenderData->pKernelParam->block_width;
-    pRenderData->iBlocksY = dwHeight / pRenderData->pKernelParam->block_height;
-
-    // Set walker cmd params - Rasterscan
-    MOS_ZeroMemory(pWalkerParams, sizeof(*pWalkerParams));
-
-    pWalkerParams->InterfaceDescriptorOffset    = pRenderData->iMediaID;
-
-    pWalkerParams->dwGlobalLoopExecCount        = 1;
-    pWalkerParams->dwLocalLoopExecCount         = pRenderData->iBlocksY - 1;
-    
-    pWalkerParams->GlobalResolution.x           = pRenderData->iBlocksX;
-    pWalkerParams->GlobalResolution.y           = pRenderData->iBlocksY;
-    
-    pWalkerParams->GlobalStart.x                = 0;
-    pWalkerParams->GlobalStart.y                = 0;
-
-    pWalkerParams->GlobalOutlerLoopStride.x     = pRenderData->iBlocksX;
-    pWalkerParams->GlobalOutlerLoopStride.y     = 0;
-
-    pWalkerParams->GlobalInnerLoopUnit.x        = 0;
-    pWalkerParams->GlobalInnerLoopUnit.y        = pRenderData->iBlocksY;
-
-    pWalkerParams->BlockResolution.x            = pRenderData->iBlocksX;
-    pWalkerParams->BlockResolution.y            = pRenderData->iBlocksY;
-   
-    pWalkerParams->LocalStart.x                 = 0;
-    pWalkerParams->LocalStart.y                 = 0;
-
-    pWalkerParams->LocalEnd.x                   = pRenderData->iBlocksX - 1;
-    pWalkerParams->LocalEnd.y                   = 0;
-
-    pWalkerParams->LocalOutLoopStride.x         = 0;
-    pWalkerParams->LocalOutLoopStride.y         = 1;
-
-    pWalkerParams->LocalInnerLoopUnit.x         = 1;
-    pWalkerParams->LocalInnerLoopUnit.y         = 0;
-    
-    return eStatus;
-}
-
 //!
 //! \brief    16Align renderer
 //! \details  Renderer function for 16Align
@@ -827,11 +357,8 @@ MOS_STATUS VpHal_16AlignRender(
     PVPHAL_RENDER_PARAMS     pRenderParams)
 {
     MOS_STATUS                              eStatus;
-    PRENDERHAL_INTERFACE                    pRenderHal;
     PMOS_INTERFACE                          pOsInterface;
-    MHW_WALKER_PARAMS                       WalkerParams;
     VPHAL_16_ALIGN_RENDER_DATA              RenderData;
-    PRENDERHAL_L3_CACHE_SETTINGS            pCacheSettings = nullptr;
     uint32_t                                dwInputRegionHeight;
     uint32_t                                dwInputRegionWidth;
     uint32_t                                dwOutputRegionHeight;
@@ -845,48 +372,15 @@ MOS_STATUS VpHal_16AlignRender(
 
     eStatus                     = MOS_STATUS_SUCCESS;
     pOsInterface                = p16AlignState->pOsInterface;
-    pRenderHal                  = p16AlignState->pRenderHal;
     MOS_ZeroMemory(&RenderData, sizeof(RenderData));
 
     // Reset reporting
     p16AlignState->Reporting.InitReportValue();
 
-    // Reset states before rendering
-    pOsInterface->pfnResetOsStates(pOsInterface);
-    VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnReset(pRenderHal));
-    pOsInterface->pfnResetPerfBufferID(pOsInterface);   // reset once per frame
-
-    VPHAL_DBG_STATE_DUMPPER_SET_CURRENT_STAGE(VPHAL_DBG_STAGE_COMP);
-
-    // Configure cache settings for this render operation 
-    pCacheSettings      = &pRenderHal->L3CacheSettings;
-    MOS_ZeroMemory(pCacheSettings, sizeof(*pCacheSettings));
-    pCacheSettings->bOverride                  = true;
-    pCacheSettings->bL3CachingEnabled          = p16AlignState->SurfMemObjCtl.bL3CachingEnabled;
-
-    if (p16AlignState->pPerfData->L3SQCReg1Override.bEnabled)
-    {
-        pCacheSettings->bSqcReg1Override       = true;
-        pCacheSettings->dwSqcReg1              = p16AlignState->pPerfData->L3SQCReg1Override.uiVal;
-    }
-
-    if (p16AlignState->pPerfData->L3CntlReg2Override.bEnabled)
-    {
-        pCacheSettings->bCntlReg2Override      = true;
-        pCacheSettings->dwCntlReg2             = p16AlignState->pPerfData->L3CntlReg2Override.uiVal;
-    }
-
-    if (p16AlignState->pPerfData->L3CntlReg3Override.bEnabled)
-    {
-        pCacheSettings->bCntlReg3Override      = true;
-        pCacheSettings->dwCntlReg3             = p16AlignState->pPerfData->L3CntlReg3Override.uiVal;
-    }
-
-    if (p16AlignState->pPerfData->L3LRA1RegOverride.bEnabled)
-    {
-        pCacheSettings->bLra1RegOverride       = true;
-        pCacheSettings->dwLra1Reg              = p16AlignState->pPerfData->L3LRA1RegOverride.uiVal;
-    }
+    // Reset states, configure cache settings and assign the binding table
+    VPHAL_RENDER_CHK_STATUS(VpHal_KernelLauncherBegin(
+            &p16AlignState->KernelLauncher,
+            p16AlignState->SurfMemObjCtl.bL3CachingEnabled));
 
     // Setup Source/Target surface and get the Source width/height for
     p16AlignState->pSource           = pRenderParams->pSrc[0];
@@ -899,9 +393,6 @@ MOS_STATUS VpHal_16AlignRender(
     RenderData.ScalingRatio_H       = (float)dwOutputRegionWidth / (float)dwInputRegionWidth;
     RenderData.ScalingRatio_V       = (float)dwOutputRegionHeight / (float)dwInputRegionHeight;
 
-    RenderData.pAVSParameters = &p16AlignState->AVSParameters;
-    RenderData.SamplerStateParams.Avs.pMhwSamplerAvsTableParam = &RenderData.mhwSamplerAvsTableParam;
-
     p16AlignState->pKernelParamTable =
         (PRENDERHAL_KERNEL_PARAM)((p16AlignState->pTarget->Format != Format_YV12)?&g_16Align_MW_KernelParam[0]:&g_16Align_MW_KernelParam[1]);
 
@@ -929,32 +420,16 @@ MOS_STATUS VpHal_16AlignRender(
             p16AlignState, 
             &RenderData));
 
-    // Set perftag information
-    pOsInterface->pfnResetPerfBufferID(pOsInterface);
-    pOsInterface->pfnSetPerfTag(pOsInterface, RenderData.PerfTag);
-
-    VPHAL_RENDER_CHK_STATUS(VpHal_16AlignRenderMediaWalker(
-            p16AlignState,    
-            &RenderData,
-            &WalkerParams));
-
-    VPHAL_DBG_STATE_DUMPPER_DUMP_GSH(pRenderHal);
-    VPHAL_DBG_STATE_DUMPPER_DUMP_SSH(pRenderHal);
-
-    VPHAL_RENDER_CHK_STATUS(VpHal_RndrSubmitCommands(
-        pRenderHal, 
-        nullptr,
+    // One media walker over the target region
+    VPHAL_RENDER_CHK_STATUS(VpHal_KernelLauncherSubmit(
+        &p16AlignState->KernelLauncher,
+        p16AlignState->pTarget->rcDst.right - p16AlignState->pTarget->rcDst.left,
+        p16AlignState->pTarget->rcDst.bottom - p16AlignState->pTarget->rcDst.top,
         p16AlignState->bNullHwRender16Align,
-        &WalkerParams,
-        nullptr,
-        &p16AlignState->StatusTableUpdateParams,
-        kernelUserPtr,
-        0,
-        nullptr,
-        true));
+        &p16AlignState->StatusTableUpdateParams));
 
 finish:
-    MOS_ZeroMemory(pCacheSettings, sizeof(*pCacheSettings));
+    VpHal_KernelLauncherEnd(&p16AlignState->KernelLauncher);
     VPHAL_RENDER_ASSERT(eStatus == MOS_STATUS_SUCCESS);
     VPHAL_RENDER_NORMALMESSAGE("finished UsrPtr process!");
     return eStatus;
@@ -974,8 +449,7 @@ MOS_STATUS VpHal_16AlignDestroy(
     MOS_STATUS eStatus;
     eStatus = MOS_STATUS_SUCCESS;
     VPHAL_RENDER_CHK_NULL(p16AlignState);
-    VpHal_RenderDestroyAVSParams(&p16AlignState->AVSParameters);
-    MOS_UNUSED(p16AlignState);
+    VpHal_KernelLauncherDestroy(&p16AlignState->KernelLauncher);
 
 finish:
     return eStatus;
@@ -1011,11 +485,13 @@ MOS_STATUS VpHal_16AlignInitialize(
 
     // Setup interface to KDLL
     p16AlignState->pKernelDllState   = pKernelDllState;
-    VpHal_RenderInitAVSParams(&p16AlignState->AVSParameters,
-            POLYPHASE_Y_COEFFICIENT_TABLE_SIZE_G9,
-            POLYPHASE_UV_COEFFICIENT_TABLE_SIZE_G9);
 
-    return MOS_STATUS_SUCCESS;
+    return VpHal_KernelLauncherInitialize(
+            &p16AlignState->KernelLauncher,
+            &g_16Align_KernelLaunchDesc,
+            p16AlignState->pRenderHal,
+            pKernelDllState,
+            p16AlignState->pPerfData);
 }
 
 //!
@@ -1032,6 +508,8 @@ MOS_STATUS VpHal_16AlignInitialize(
 //!           Pointer to Render Surface
 //! \param    [in] pSurfaceParams
 //!           Pointer to RenderHal Surface Params
+//! \param    [in] iBindingTable
+//!           Binding table of the surfaces
 //! \param    [in] PVPHAL_16_ALIGN_RENDER_DATA
 //!           Pointer to Rendering data
 //! \return   MOS_STATUS
@@ -1043,6 +521,7 @@ MOS_STATUS VpHal_16AlignSetupSurfaceStatesInt(
     PVPHAL_SURFACE                      pSurface,
     PRENDERHAL_SURFACE                  pRenderSurface,
     PRENDERHAL_SURFACE_STATE_PARAMS     pSurfaceParams,
+    int32_t                             iBindingTable,
     PVPHAL_16_ALIGN_RENDER_DATA         pRenderData)
 {
     MOS_STATUS                          eStatus = MOS_STATUS_SUCCESS;
@@ -1071,7 +550,7 @@ MOS_STATUS VpHal_16AlignSetupSurfaceStatesInt(
                         pSurface,
                         pRenderSurface,
                         pSurfaceParams,
-                        pRenderData->iBindingTable,
+                        iBindingTable,
                         ((i==0)?ALIGN16_TRG_Y_INDEX:ALIGN16_TRG_UV_INDEX),
                         bSrc?false:true));
                     // add UV offset which was missed in raw buffer common configuration.
@@ -1089,7 +568,7 @@ MOS_STATUS VpHal_16AlignSetupSurfaceStatesInt(
                     pSurface,
                     pRenderSurface,
                     pSurfaceParams,
-                    pRenderData->iBindingTable,
+                    iBindingTable,
                     ALIGN16_TRG_INDEX,
                     bSrc?false:true));
                 break;
@@ -1103,7 +582,7 @@ MOS_STATUS VpHal_16AlignSetupSurfaceStatesInt(
                         pSurface,
                         pRenderSurface,
                         pSurfaceParams,
-                        pRenderData->iBindingTable,
+                        iBindingTable,
                         (i==0)?ALIGN16_TRG_Y_INDEX:((i==1)?ALIGN16_TRG_V_INDEX:ALIGN16_TRG_U_INDEX),
                         bSrc?false:true));
                     // add U, V offset which was missed in raw buffer common configuration.
@@ -1133,7 +612,7 @@ MOS_STATUS VpHal_16AlignSetupSurfaceStatesInt(
             pSurface,
             pRenderSurface,
             pSurfaceParams,
-            pRenderData->iBindingTable,
+            iBindingTable,
             bSrc?ALIGN16_SRC_INDEX:ALIGN16_TRG_INDEX,
             bSrc?false:true));
         // for 1 sampler access YV12 3plane input, Y plane should use the R8 sampler type, the same as U,V plane
@@ -1149,10 +628,10 @@ MOS_STATUS VpHal_16AlignSetupSurfaceStatesInt(
             {
                 // correct the input surface index, from YVU to YUV.
                 pSurfaceEntry   = &pRenderHal->pStateHeap->pSurfaceEntry[1];
-                VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnBindSurfaceState(pRenderHal, pRenderData->iBindingTable,
+                VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnBindSurfaceState(pRenderHal, iBindingTable,
                     ALIGN16_SRC_V_INDEX, pSurfaceEntry));
                 pSurfaceEntry   = &pRenderHal->pStateHeap->pSurfaceEntry[2];
-                VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnBindSurfaceState(pRenderHal, pRenderData->iBindingTable,
+                VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnBindSurfaceState(pRenderHal, iBindingTable,
                     ALIGN16_SRC_U_INDEX, pSurfaceEntry));
             }
         }
@@ -1216,6 +695,7 @@ MOS_STATUS VpHal_16AlignSetupSurfaceStates(
         p16AlignState->pSource,
         &p16AlignState->RenderHalSource,
         &SurfaceParams,
+        p16AlignState->KernelLauncher.iBindingTable,
         pRenderData));
 
     // Target surface
@@ -1231,6 +711,7 @@ MOS_STATUS VpHal_16AlignSetupSurfaceStates(
         p16AlignState->pTarget,
         &p16AlignState->RenderHalTarget,
         &SurfaceParams,
+        p16AlignState->KernelLauncher.iBindingTable,
         pRenderData));
 
 finish:
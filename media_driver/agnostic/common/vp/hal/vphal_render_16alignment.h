@@ -34,6 +34,7 @@
 #include "mos_os.h"
 #include "renderhal.h"
 #include "vphal_render_common.h"
+#include "vphal_render_kernel_launcher.h"
 
 // Static Data for Gen9 16ALIGN kernel
 typedef struct _MEDIA_WALKER_16ALIGN_STATIC_DATA
@@ -233,28 +234,11 @@ typedef struct _MEDIA_WALKER_16ALIGN_STATIC_DATA
 //!
 typedef struct _VPHAL_16_ALIGN_RENDER_DATA
 {
-    int32_t                             iBlocksX;
-    int32_t                             iBlocksY;
-    int32_t                             iBindingTable;
-    int32_t                             iMediaID;
-    PRENDERHAL_MEDIA_STATE              pMediaState;
     float                               ScalingRatio_H;
     float                               ScalingRatio_V;
-    // Kernel Information
-    PRENDERHAL_KERNEL_PARAM             pKernelParam;
-    Kdll_CacheEntry                     KernelEntry;
-    int32_t                             iCurbeLength;
-    int32_t                             iInlineLength;
     uint32_t                            dwSurfStateWd;       //!< Surface Height as programmed in SS
     uint32_t                            dwSurfStateHt;       //!< Surface Height as programmed in SS
 
-    MHW_SAMPLER_STATE_PARAM             SamplerStateParams;           //!< Sampler State 
-    PMHW_AVS_PARAMS                     pAVSParameters;               //!< AVS parameters
-    MHW_SAMPLER_AVS_TABLE_PARAM         mhwSamplerAvsTableParam;      //!< params for AVS scaling 8x8 table
-
-    // Perf
-    VPHAL_PERFTAG                       PerfTag;
-
     // Debug parameters
     // Kernel Used for current rendering
     char*                               pKernelName;
@@ -273,8 +257,9 @@ typedef struct _VPHAL_16_ALIGN_STATE
     MEDIA_FEATURE_TABLE             *pSkuTable;
     MEDIA_WA_TABLE                  *pWaTable;
     bool                            bFtrMediaWalker;
-    MHW_AVS_PARAMS                  AVSParameters;                  //!< AVS for configure Sampler
-    MHW_SAMPLER_AVS_TABLE_PARAM     mhwSamplerAvsTableParam;
+
+    // Kernel, sampler and walker setup shared with the other VP kernels
+    VPHAL_KERNEL_LAUNCHER           KernelLauncher;
     // Input and output surfaces
     PVPHAL_SURFACE                  pSource;
     PVPHAL_SURFACE                  pTarget;
@@ -321,8 +306,7 @@ typedef struct _VPHAL_16_ALIGN_STATE
 
     MOS_STATUS (* pfnLoadStaticData) (
         PVPHAL_16_ALIGN_STATE         p16AlignState,    
-        PVPHAL_16_ALIGN_RENDER_DATA   pRenderData,
-        int32_t                       *piCurbeOffset);
+        PVPHAL_16_ALIGN_RENDER_DATA   pRenderData);
 
     MOS_STATUS (* pfnSetupKernel) (
         PVPHAL_16_ALIGN_STATE         p16AlignState,
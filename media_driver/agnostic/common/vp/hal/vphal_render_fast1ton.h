@@ -34,6 +34,7 @@
 #include "mos_os.h"
 #include "renderhal.h"
 #include "vphal_render_common.h"
+#include "vphal_render_kernel_launcher.h"
 
 #define MAX_1TON_SUPPORT 3    // currently the multi output number max support 3
 
@@ -217,27 +218,10 @@ typedef struct _MEDIA_WALKER_FAST1TON_STATIC_DATA
 //!
 typedef struct _VPHAL_FAST1TON_RENDER_DATA
 {
-    int32_t                             iBlocksX;
-    int32_t                             iBlocksY;
-    int32_t                             iBindingTable;
-    int32_t                             iMediaID;
-    PRENDERHAL_MEDIA_STATE              pMediaState;
     float                               ScalingStep_H[MAX_1TON_SUPPORT];
     float                               ScalingStep_V[MAX_1TON_SUPPORT];
     float                               ScalingRatio_H[MAX_1TON_SUPPORT];
     float                               ScalingRatio_V[MAX_1TON_SUPPORT];
-    // Kernel Information
-    PRENDERHAL_KERNEL_PARAM             pKernelParam;
-    Kdll_CacheEntry                     KernelEntry;
-    int32_t                             iCurbeLength;
-    int32_t                             iInlineLength;
-
-    MHW_SAMPLER_STATE_PARAM             SamplerStateParams[MAX_1TON_SUPPORT];           //!< Sampler State 
-    PMHW_AVS_PARAMS                     pAVSParameters[MAX_1TON_SUPPORT];               //!< AVS parameters
-    MHW_SAMPLER_AVS_TABLE_PARAM         mhwSamplerAvsTableParam[MAX_1TON_SUPPORT];      //!< params for AVS scaling 8x8 table
-
-    // Perf
-    VPHAL_PERFTAG                       PerfTag;
 
     // Debug parameters
     // Kernel Used for current rendering
@@ -257,8 +241,9 @@ typedef struct _VPHAL_FAST1TON_STATE
     MEDIA_FEATURE_TABLE             *pSkuTable;
     MEDIA_WA_TABLE                  *pWaTable;
     bool                            bFtrMediaWalker;
-    MHW_AVS_PARAMS                  AVSParameters[MAX_1TON_SUPPORT];   //!< AVS for configure Sampler
-    MHW_SAMPLER_AVS_TABLE_PARAM     mhwSamplerAvsTableParam[MAX_1TON_SUPPORT];
+
+    // Kernel, one sampler per output and walker setup shared with the other VP kernels
+    VPHAL_KERNEL_LAUNCHER           KernelLauncher;
     // Input and output surfaces
     PVPHAL_SURFACE                  pSource;
     PVPHAL_SURFACE                  pTarget[MAX_1TON_SUPPORT];
@@ -307,8 +292,7 @@ typedef struct _VPHAL_FAST1TON_STATE
 
     MOS_STATUS (* pfnLoadStaticData) (
         PVPHAL_FAST1TON_STATE         pFast1toNState,    
-        PVPHAL_FAST1TON_RENDER_DATA   pRenderData,
-        int32_t                       *piCurbeOffset);
+        PVPHAL_FAST1TON_RENDER_DATA   pRenderData);
 
     MOS_STATUS (* pfnSetupKernel) (
         PVPHAL_FAST1TON_STATE         pFast1toNState,
@@ -0,0 +1,226 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vphal_render_hdr_3dlut_cache.h
+//! \brief    Bookkeeping of the process wide HDR 3D LUT cache
+//! \details  HDR 3D LUTs generated by one VP context are shared read only with
+//!           the contexts of the same device converting with the same tone
+//!           mapping parameters. The table only tracks the LUT handles, the
+//!           caller locks it and allocates and frees the LUTs.
+//!
+#ifndef __VPHAL_RENDER_HDR_3DLUT_CACHE_H__
+#define __VPHAL_RENDER_HDR_3DLUT_CACHE_H__
+
+#include <stdint.h>
+#include <vector>
+
+#define VPHAL_HDR_3DLUT_CACHE_MAX_IDLE_ENTRIES  8   //!< Max unreferenced LUTs kept per device
+
+//!
+//! \brief    Table of the cached HDR 3D LUTs
+//! \details  Entries are reference counted by the generators using them. Idle
+//!           entries beyond VPHAL_HDR_3DLUT_CACHE_MAX_IDLE_ENTRIES are handed
+//!           back least recently used first, and all the entries of a device
+//!           are handed back when its last generator goes away. Not thread safe.
+//!
+template <typename TLut>
+class VpHal3DLutCacheTable
+{
+public:
+    //!
+    //! \brief    Device and tone mapping parameters a 3D LUT is generated for
+    //!
+    struct Key
+    {
+        const void  *device;
+        uint32_t    maxDLL;
+        uint32_t    maxCLL;
+        uint32_t    hdrMode;
+    };
+
+    //! \brief  Register a generator of device
+    void AddUser(const void *device)
+    {
+        for (auto &user : m_users)
+        {
+            if (user.device == device)
+            {
+                user.num++;
+                return;
+            }
+        }
+        m_users.push_back({device, 1});
+    }
+
+    //!
+    //! \brief    Unregister a generator of device
+    //! \return   bool
+    //!           true if it was the last generator of device, its entries are
+    //!           then to be handed back by PopDevice
+    //!
+    bool RemoveUser(const void *device)
+    {
+        for (auto it = m_users.begin(); it != m_users.end(); ++it)
+        {
+            if (it->device == device)
+            {
+                if (--it->num == 0)
+                {
+                    m_users.erase(it);
+                    return true;
+                }
+                return false;
+            }
+        }
+        return false;
+    }
+
+    //! \brief  Whether no generator uses the table anymore
+    bool IsUnused() const
+    {
+        return m_users.empty() && m_entries.empty();
+    }
+
+    //!
+    //! \brief    Take a reference on the LUT generated for key
+    //! \return   bool
+    //!           true on a cache hit, false on a miss
+    //!
+    bool Acquire(const Key &key, TLut *lut)
+    {
+        for (auto &entry : m_entries)
+        {
+            if (entry.key.device  == key.device &&
+                entry.key.maxDLL  == key.maxDLL &&
+                entry.key.maxCLL  == key.maxCLL &&
+                entry.key.hdrMode == key.hdrMode)
+            {
+                entry.refCount++;
+                entry.lastUse = ++m_useCount;
+                *lut          = entry.lut;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //!
+    //! \brief    Add a generated LUT and take a reference on it
+    //! \details  The caller checks with Acquire, under the same lock, that key
+    //!           is not cached yet
+    //!
+    void Insert(const Key &key, TLut lut)
+    {
+        Entry entry    = {};
+        entry.key      = key;
+        entry.lut      = lut;
+        entry.refCount = 1;
+        entry.lastUse  = ++m_useCount;
+        m_entries.push_back(entry);
+    }
+
+    //! \brief  Drop a reference taken by Acquire or Insert
+    void Release(TLut lut)
+    {
+        for (auto &entry : m_entries)
+        {
+            if (entry.lut == lut && entry.refCount > 0)
+            {
+                entry.refCount--;
+                return;
+            }
+        }
+    }
+
+    //!
+    //! \brief    Hand back the least recently used idle LUT of device when it
+    //!           has more than VPHAL_HDR_3DLUT_CACHE_MAX_IDLE_ENTRIES idle LUTs
+    //! \return   bool
+    //!           true if a LUT is to be freed by the caller
+    //!
+    bool PopIdle(const void *device, TLut *lut)
+    {
+        uint32_t idleNum = 0;
+        auto     oldest  = m_entries.end();
+
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->key.device == device && it->refCount == 0)
+            {
+                idleNum++;
+                if (oldest == m_entries.end() || it->lastUse < oldest->lastUse)
+                {
+                    oldest = it;
+                }
+            }
+        }
+
+        if (idleNum <= VPHAL_HDR_3DLUT_CACHE_MAX_IDLE_ENTRIES)
+        {
+            return false;
+        }
+
+        *lut = oldest->lut;
+        m_entries.erase(oldest);
+        return true;
+    }
+
+    //!
+    //! \brief    Hand back any LUT of device
+    //! \return   bool
+    //!           true if a LUT is to be freed by the caller
+    //!
+    bool PopDevice(const void *device, TLut *lut)
+    {
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->key.device == device)
+            {
+                *lut = it->lut;
+                m_entries.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Entry
+    {
+        Key         key;
+        TLut        lut;
+        uint32_t    refCount;
+        uint64_t    lastUse;
+    };
+
+    struct User
+    {
+        const void  *device;
+        uint32_t    num;
+    };
+
+    std::vector<Entry>  m_entries;
+    std::vector<User>   m_users;
+    uint64_t            m_useCount = 0;     //!< Clock for least recently used eviction
+};
+
+#endif // __VPHAL_RENDER_HDR_3DLUT_CACHE_H__
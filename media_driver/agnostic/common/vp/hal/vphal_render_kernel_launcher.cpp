@@ -0,0 +1,799 @@
+/*
+*
+* Copyright (c) Intel Corporation (2018).
+*
+* INTEL MAKES NO WARRANTY OF ANY KIND REGARDING THE CODE.  THIS CODE IS
+* LICENSED ON AN "AS IS" BASIS AND INTEL WILL NOT PROVIDE ANY SUPPORT,
+* ASSISTANCE, INSTALLATION, TRAINING OR OTHER SERVICES.  INTEL DOES NOT
+* PROVIDE ANY UPDATES, ENHANCEMENTS OR EXTENSIONS.  INTEL SPECIFICALLY
+* DISCLAIMS ANY WARRANTY OF MERCHANTABILITY, NONINFRINGEMENT, FITNESS FOR ANY
+* PARTICULAR PURPOSE, OR ANY OTHER WARRANTY.  Intel disclaims all liability,
+* including liability for infringement of any proprietary rights, relating to
+* use of the code. No license, express or implied, by estoppel or otherwise,
+* to any intellectual property rights is granted herein.
+*
+*
+* File Name  : vphal_render_kernel_launcher.cpp
+*
+* Abstract   : Media walker kernel launcher for Video Processing
+*
+* Environment: Linux
+*
+* Notes      : This module contains the launcher shared by the single kernel
+*              render features of VPHAL
+*
+*/
+//!
+//! \file     vphal_render_kernel_launcher.cpp
+//! \brief    Launcher of the single kernel VP render features
+//! \details  Runs one media walker kernel described by a feature table
+//!
+#include "vphal_render_kernel_launcher.h"
+#include "vphal_debug.h"
+#include "vphal_render_ief.h"
+#include "vphal_renderer.h"
+
+//!
+//! \brief    Recalculate Sampler Avs 8x8 Horizontal/Vertical scaling table
+//! \details  Recalculate Sampler Avs 8x8 Horizontal/Vertical scaling table
+//! \param    MOS_FORMAT SrcFormat
+//!           [in] Source Format
+//! \param    float fScale
+//!           [in] Horizontal or Vertical Scale Factor
+//! \param    bool bVertical
+//!           [in] true if Vertical Scaling, else Horizontal Scaling
+//! \param    uint32_t dwChromaSiting
+//!           [in] Chroma Siting
+//! \param    bool bBalancedFilter
+//!           [in] true if Gen9+, balanced filter
+//! \param    bool b8TapAdaptiveEnable
+//!           [in] true if 8Tap Adaptive Enable
+//! \param    PVPHAL_AVS_PARAMS pAvsParams
+//!           [in/out] Pointer to AVS Params
+//! \return   MOS_STATUS
+//!
+static MOS_STATUS VpHal_KernelLauncherSamplerAvsCalcScalingTable(
+    MOS_FORMAT                      SrcFormat,
+    float                           fScale,
+    bool                            bVertical,
+    uint32_t                        dwChromaSiting,
+    bool                            bBalancedFilter,
+    bool                            b8TapAdaptiveEnable,
+    PMHW_AVS_PARAMS                 pAvsParams)
+{
+    MOS_STATUS                      eStatus = MOS_STATUS_SUCCESS;
+    MHW_PLANE                       Plane;
+    int32_t                         iUvPhaseOffset;
+    uint32_t                        dwHwPhrase;
+    uint32_t                        YCoefTableSize;
+    uint32_t                        UVCoefTableSize;
+    float                           fScaleParam;
+    int32_t*                        piYCoefsParam;
+    int32_t*                        piUVCoefsParam;
+    float                           fHPStrength;
+
+    VPHAL_RENDER_CHK_NULL(pAvsParams);
+    VPHAL_RENDER_CHK_NULL(pAvsParams->piYCoefsY);
+    VPHAL_RENDER_CHK_NULL(pAvsParams->piYCoefsX);
+    VPHAL_RENDER_CHK_NULL(pAvsParams->piUVCoefsY);
+    VPHAL_RENDER_CHK_NULL(pAvsParams->piUVCoefsX);
+
+    if (bBalancedFilter)
+    {
+        YCoefTableSize      = POLYPHASE_Y_COEFFICIENT_TABLE_SIZE_G9;
+        UVCoefTableSize     = POLYPHASE_UV_COEFFICIENT_TABLE_SIZE_G9;
+        dwHwPhrase          = NUM_HW_POLYPHASE_TABLES_G9;
+    }
+    else
+    {
+        YCoefTableSize      = POLYPHASE_Y_COEFFICIENT_TABLE_SIZE_G8;
+        UVCoefTableSize     = POLYPHASE_UV_COEFFICIENT_TABLE_SIZE_G8;
+        dwHwPhrase          = MHW_NUM_HW_POLYPHASE_TABLES;
+    }
+
+    fHPStrength = 0.0F;
+    piYCoefsParam   = bVertical ? pAvsParams->piYCoefsY : pAvsParams->piYCoefsX;
+    piUVCoefsParam  = bVertical ? pAvsParams->piUVCoefsY : pAvsParams->piUVCoefsX;
+    fScaleParam     = bVertical ? pAvsParams->fScaleY : pAvsParams->fScaleX;
+
+    // Recalculate Horizontal or Vertical scaling table
+    if (SrcFormat != pAvsParams->Format || fScale != fScaleParam)
+    {
+        MOS_ZeroMemory(piYCoefsParam, YCoefTableSize);
+        MOS_ZeroMemory(piUVCoefsParam, UVCoefTableSize);
+
+        // 4-tap filtering for RGB format G-channel if 8tap adaptive filter is not enabled.
+        Plane = (IS_RGB32_FORMAT(SrcFormat) && !b8TapAdaptiveEnable) ? MHW_U_PLANE : MHW_Y_PLANE;
+        if (bVertical)
+        {
+            pAvsParams->fScaleY = fScale;
+        }
+        else
+        {
+            pAvsParams->fScaleX = fScale;
+        }
+
+        // For 1x scaling in horizontal direction, use special coefficients for filtering
+        // we don't do this when bForcePolyPhaseCoefs flag is set
+        if (fScale == 1.0F && !pAvsParams->bForcePolyPhaseCoefs)
+        {
+            VPHAL_RENDER_CHK_STATUS(Mhw_SetNearestModeTable(
+                piYCoefsParam,
+                Plane,
+                bBalancedFilter));
+            // If the 8-tap adaptive is enabled for all channel, then UV/RB use the same coefficient as Y/G
+            // So, coefficient for UV/RB channels caculation can be passed
+            if (!b8TapAdaptiveEnable)
+            {
+                VPHAL_RENDER_CHK_STATUS(Mhw_SetNearestModeTable(
+                    piUVCoefsParam,
+                    MHW_U_PLANE,
+                    bBalancedFilter));
+            }
+        }
+        else
+        {
+            // Clamp the Scaling Factor if > 1.0x
+            fScale = MOS_MIN(1.0F, fScale);
+
+            VPHAL_RENDER_CHK_STATUS(Mhw_CalcPolyphaseTablesY(
+                piYCoefsParam,
+                fScale,
+                Plane,
+                SrcFormat,
+                fHPStrength,
+                true,
+                dwHwPhrase));
+
+            // If the 8-tap adaptive is enabled for all channel, then UV/RB use the same coefficient as Y/G
+            // So, coefficient for UV/RB channels caculation can be passed
+            if (!b8TapAdaptiveEnable)
+            {
+                if (!bBalancedFilter)
+                {
+                    VPHAL_RENDER_CHK_STATUS(Mhw_CalcPolyphaseTablesY(
+                        piUVCoefsParam,
+                        fScale,
+                        MHW_U_PLANE,
+                        SrcFormat,
+                        fHPStrength,
+                        true,
+                        dwHwPhrase));
+                }
+                else
+                {
+                    // If Chroma Siting info is present
+                    if (dwChromaSiting & (bVertical ? MHW_CHROMA_SITING_VERT_TOP : MHW_CHROMA_SITING_HORZ_LEFT))
+                    {
+                        // No Chroma Siting
+                        VPHAL_RENDER_CHK_STATUS(Mhw_CalcPolyphaseTablesUV(
+                            piUVCoefsParam,
+                            2.0F,
+                            fScale));
+                    }
+                    else
+                    {
+                        // Chroma siting offset needs to be added
+                        if (dwChromaSiting & (bVertical ? MHW_CHROMA_SITING_VERT_CENTER : MHW_CHROMA_SITING_HORZ_CENTER))
+                        {
+                            iUvPhaseOffset = MOS_UF_ROUND(0.5F * 16.0F);   // U0.4
+                        }
+                        else //if (ChromaSiting & (bVertical ? MHW_CHROMA_SITING_VERT_BOTTOM : MHW_CHROMA_SITING_HORZ_RIGHT))
+                        {
+                            iUvPhaseOffset = MOS_UF_ROUND(1.0F * 16.0F);   // U0.4
+                        }
+
+                        VPHAL_RENDER_CHK_STATUS(Mhw_CalcPolyphaseTablesUVOffset(
+                            piUVCoefsParam,
+                            3.0F,
+                            fScale,
+                            iUvPhaseOffset));
+                    }
+                }
+            }
+        }
+    }
+
+finish:
+    return eStatus;
+}
+
+//!
+//! \brief    Set Sampler Avs 8x8 Table
+//! \details  Set Sampler Avs 8x8 Table
+//! \param    PMHW_SAMPLER_STATE_PARAM pSamplerStateParams
+//!           [in] Pointer to Sampler State Params
+//! \param    PMHW_AVS_PARAMS pAvsParams
+//!           [in/out] Pointer to AVS Params
+//! \param    MOS_FORMAT SrcFormat
+//!           [in] Source Format
+//! \param    float fScaleX
+//!           [in] Horizontal scaling ratio
+//! \param    float fScaleY
+//!           [in] Vertical scaling ratio
+//! \param    uint32_t dwChromaSiting
+//!           [in] Chroma Siting
+//! \return   MOS_STATUS
+//!
+static MOS_STATUS VpHal_KernelLauncherSetSamplerAvsTableParam(
+    PMHW_SAMPLER_STATE_PARAM        pSamplerStateParams,
+    PMHW_AVS_PARAMS                 pAvsParams,
+    MOS_FORMAT                      SrcFormat,
+    float                           fScaleX,
+    float                           fScaleY,
+    uint32_t                        dwChromaSiting)
+{
+    MOS_STATUS                   eStatus = MOS_STATUS_SUCCESS;
+    bool                         bBalancedFilter;
+    PMHW_SAMPLER_AVS_TABLE_PARAM pMhwSamplerAvsTableParam;
+
+    VPHAL_RENDER_CHK_NULL(pSamplerStateParams);
+    VPHAL_RENDER_CHK_NULL(pAvsParams);
+
+    pMhwSamplerAvsTableParam = pSamplerStateParams->Avs.pMhwSamplerAvsTableParam;
+    VPHAL_RENDER_CHK_NULL(pMhwSamplerAvsTableParam);
+
+    pMhwSamplerAvsTableParam->b8TapAdaptiveEnable         = pSamplerStateParams->Avs.b8TapAdaptiveEnable;
+    pMhwSamplerAvsTableParam->byteTransitionArea8Pixels   = MEDIASTATE_AVS_TRANSITION_AREA_8_PIXELS;
+    pMhwSamplerAvsTableParam->byteTransitionArea4Pixels   = MEDIASTATE_AVS_TRANSITION_AREA_4_PIXELS;
+    pMhwSamplerAvsTableParam->byteMaxDerivative8Pixels    = MEDIASTATE_AVS_MAX_DERIVATIVE_8_PIXELS;
+    pMhwSamplerAvsTableParam->byteMaxDerivative4Pixels    = MEDIASTATE_AVS_MAX_DERIVATIVE_4_PIXELS;
+    pMhwSamplerAvsTableParam->byteDefaultSharpnessLevel   = MEDIASTATE_AVS_SHARPNESS_LEVEL_SHARP;
+
+    // Enable Adaptive Filtering, if it is being upscaled
+    // in either direction. we must check for this before clamping the SF.
+    if ((IS_YUV_FORMAT(SrcFormat) && (fScaleX > 1.0F || fScaleY > 1.0F)) ||
+        pMhwSamplerAvsTableParam->b8TapAdaptiveEnable)
+    {
+        pMhwSamplerAvsTableParam->bBypassXAdaptiveFiltering = false;
+        pMhwSamplerAvsTableParam->bBypassYAdaptiveFiltering = false;
+        if (pMhwSamplerAvsTableParam->b8TapAdaptiveEnable)
+        {
+            pMhwSamplerAvsTableParam->bAdaptiveFilterAllChannels = true;
+
+            if (IS_RGB_FORMAT(SrcFormat))
+            {
+                pMhwSamplerAvsTableParam->bEnableRGBAdaptive     = true;
+            }
+        }
+    }
+    else
+    {
+        pMhwSamplerAvsTableParam->bBypassXAdaptiveFiltering = true;
+        pMhwSamplerAvsTableParam->bBypassYAdaptiveFiltering = true;
+    }
+
+    // No changes to AVS parameters -> skip
+    if (SrcFormat == pAvsParams->Format &&
+        fScaleX == pAvsParams->fScaleX &&
+        fScaleY == pAvsParams->fScaleY)
+    {
+        goto finish;
+    }
+
+    // AVS Coefficients don't change for Scaling Factors > 1.0x
+    // Hence recalculation is avoided
+    if (fScaleX > 1.0F && pAvsParams->fScaleX > 1.0F)
+    {
+        pAvsParams->fScaleX = fScaleX;
+    }
+
+    // AVS Coefficients don't change for Scaling Factors > 1.0x
+    // Hence recalculation is avoided
+    if (fScaleY > 1.0F && pAvsParams->fScaleY > 1.0F)
+    {
+        pAvsParams->fScaleY = fScaleY;
+    }
+
+    bBalancedFilter = true;
+    // Recalculate Horizontal scaling table
+    VPHAL_HW_CHK_STATUS(VpHal_KernelLauncherSamplerAvsCalcScalingTable(
+        SrcFormat,
+        fScaleX,
+        false,
+        dwChromaSiting,
+        bBalancedFilter,
+        pMhwSamplerAvsTableParam->b8TapAdaptiveEnable ? true : false,
+        pAvsParams));
+
+    // Recalculate Vertical scaling table
+    VPHAL_HW_CHK_STATUS(VpHal_KernelLauncherSamplerAvsCalcScalingTable(
+        SrcFormat,
+        fScaleY,
+        true,
+        dwChromaSiting,
+        bBalancedFilter,
+        pMhwSamplerAvsTableParam->b8TapAdaptiveEnable ? true : false,
+        pAvsParams));
+
+    pMhwSamplerAvsTableParam->bIsCoeffExtraEnabled = true;
+    // Save format used to calculate AVS parameters
+    pAvsParams->Format                             = SrcFormat;
+    pMhwSamplerAvsTableParam->b4TapGY              = (IS_RGB32_FORMAT(SrcFormat) && !pMhwSamplerAvsTableParam->b8TapAdaptiveEnable);
+    pMhwSamplerAvsTableParam->b4TapRBUV            = (!pMhwSamplerAvsTableParam->b8TapAdaptiveEnable);
+
+    VpHal_RenderCommonSetAVSTableParam(pAvsParams, pMhwSamplerAvsTableParam);
+
+finish:
+    return eStatus;
+}
+
+MOS_STATUS VpHal_KernelLauncherInitialize(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    const VPHAL_KERNEL_LAUNCH_DESC  *pDesc,
+    PRENDERHAL_INTERFACE            pRenderHal,
+    Kdll_State                      *pKernelDllState,
+    PVPHAL_RNDR_PERF_DATA           pPerfData)
+{
+    MOS_STATUS  eStatus;
+    uint32_t    index;
+
+    VPHAL_RENDER_CHK_NULL(pLauncher);
+    VPHAL_RENDER_CHK_NULL(pDesc);
+    VPHAL_RENDER_CHK_NULL(pRenderHal);
+    VPHAL_RENDER_CHK_NULL(pKernelDllState);
+    eStatus = MOS_STATUS_SUCCESS;
+
+    MOS_ZeroMemory(pLauncher, sizeof(*pLauncher));
+    pLauncher->pDesc            = pDesc;
+    pLauncher->pOsInterface     = pRenderHal->pOsInterface;
+    pLauncher->pRenderHal       = pRenderHal;
+    pLauncher->pKernelDllState  = pKernelDllState;
+    pLauncher->pPerfData        = pPerfData;
+
+    for (index = 0; index < VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS; index++)
+    {
+        VPHAL_RENDER_CHK_STATUS(VpHal_RenderInitAVSParams(&pLauncher->AVSParameters[index],
+                POLYPHASE_Y_COEFFICIENT_TABLE_SIZE_G9,
+                POLYPHASE_UV_COEFFICIENT_TABLE_SIZE_G9));
+    }
+
+finish:
+    return eStatus;
+}
+
+void VpHal_KernelLauncherDestroy(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher)
+{
+    uint32_t    index;
+
+    if (pLauncher == nullptr)
+    {
+        return;
+    }
+
+    for (index = 0; index < VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS; index++)
+    {
+        VpHal_RenderDestroyAVSParams(&pLauncher->AVSParameters[index]);
+    }
+}
+
+MOS_STATUS VpHal_KernelLauncherSetKernel(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    PRENDERHAL_KERNEL_PARAM         pKernelParam)
+{
+    MOS_STATUS      eStatus;
+    Kdll_CacheEntry *pCacheEntryTable;
+    int32_t         iKUID;
+
+    VPHAL_RENDER_CHK_NULL(pLauncher);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pDesc);
+    VPHAL_RENDER_CHK_NULL(pKernelParam);
+    eStatus = MOS_STATUS_SUCCESS;
+    iKUID   = pLauncher->pDesc->iKUID;
+
+    pLauncher->pKernelParam = pKernelParam;
+
+    // The kernel binary doesn't change once the kernel DLL is loaded
+    if (pLauncher->KernelEntry.pBinary != nullptr)
+    {
+        goto finish;
+    }
+
+    VPHAL_RENDER_CHK_NULL(pLauncher->pKernelDllState);
+    pCacheEntryTable = pLauncher->pKernelDllState->ComponentKernelCache.pCacheEntries;
+    VPHAL_RENDER_CHK_NULL(pCacheEntryTable);
+
+    pLauncher->KernelEntry.iKUID    = iKUID;
+    pLauncher->KernelEntry.iKCID    = -1;
+    pLauncher->KernelEntry.iSize    = pCacheEntryTable[iKUID].iSize;
+    pLauncher->KernelEntry.pBinary  = pCacheEntryTable[iKUID].pBinary;
+
+finish:
+    return eStatus;
+}
+
+MOS_STATUS VpHal_KernelLauncherSetAvsSampler(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    uint32_t                        uIndex,
+    MOS_FORMAT                      SrcFormat,
+    float                           fScaleX,
+    float                           fScaleY)
+{
+    MOS_STATUS                  eStatus;
+    PMHW_SAMPLER_STATE_PARAM    pSamplerStateParams;
+
+    VPHAL_RENDER_CHK_NULL(pLauncher);
+    eStatus = MOS_STATUS_SUCCESS;
+
+    if (uIndex >= VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS)
+    {
+        VPHAL_RENDER_ASSERTMESSAGE("Invalid sampler index %d.", uIndex);
+        eStatus = MOS_STATUS_INVALID_PARAMETER;
+        goto finish;
+    }
+
+    pSamplerStateParams         = &pLauncher->SamplerStateParams[uIndex];
+    pLauncher->uSamplerCount    = MOS_MAX(pLauncher->uSamplerCount, uIndex + 1);
+
+    // Same sampler as the previous frame
+    if (pSamplerStateParams->bInUse                                 &&
+        pSamplerStateParams->SamplerType == MHW_SAMPLER_TYPE_AVS    &&
+        pLauncher->SamplerFormat[uIndex]  == SrcFormat              &&
+        pLauncher->fSamplerScaleX[uIndex] == fScaleX                &&
+        pLauncher->fSamplerScaleY[uIndex] == fScaleY)
+    {
+        goto finish;
+    }
+
+    MOS_ZeroMemory(pSamplerStateParams, sizeof(*pSamplerStateParams));
+    pSamplerStateParams->bInUse                  = true;
+    pSamplerStateParams->SamplerType             = MHW_SAMPLER_TYPE_AVS;
+    pSamplerStateParams->Avs.AvsType             = false;
+    pSamplerStateParams->Avs.bEnableIEF          = false;
+    pSamplerStateParams->Avs.b8TapAdaptiveEnable = false;
+    pSamplerStateParams->Avs.bHdcDwEnable        = true;
+    pSamplerStateParams->Avs.bEnableAVS          = true;
+    pSamplerStateParams->Avs.WeakEdgeThr         = DETAIL_WEAK_EDGE_THRESHOLD;
+    pSamplerStateParams->Avs.StrongEdgeThr       = DETAIL_STRONG_EDGE_THRESHOLD;
+    pSamplerStateParams->Avs.StrongEdgeWght      = DETAIL_STRONG_EDGE_WEIGHT;
+    pSamplerStateParams->Avs.RegularWght         = DETAIL_REGULAR_EDGE_WEIGHT;
+    pSamplerStateParams->Avs.NonEdgeWght         = DETAIL_NON_EDGE_WEIGHT;
+    pSamplerStateParams->Unorm.SamplerFilterMode = MHW_SAMPLER_FILTER_NEAREST;
+    pSamplerStateParams->Avs.pMhwSamplerAvsTableParam = &pLauncher->mhwSamplerAvsTableParam[uIndex];
+
+    VPHAL_RENDER_CHK_STATUS(VpHal_KernelLauncherSetSamplerAvsTableParam(
+        pSamplerStateParams,
+        &pLauncher->AVSParameters[uIndex],
+        SrcFormat,
+        fScaleX,
+        fScaleY,
+        MHW_CHROMA_SITING_HORZ_LEFT | MHW_CHROMA_SITING_VERT_TOP));
+
+    pLauncher->SamplerFormat[uIndex]    = SrcFormat;
+    pLauncher->fSamplerScaleX[uIndex]   = fScaleX;
+    pLauncher->fSamplerScaleY[uIndex]   = fScaleY;
+
+finish:
+    if (eStatus != MOS_STATUS_SUCCESS && pLauncher && uIndex < VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS)
+    {
+        // Build the sampler again next frame
+        pLauncher->SamplerStateParams[uIndex].bInUse = false;
+    }
+    return eStatus;
+}
+
+MOS_STATUS VpHal_KernelLauncherSet3DSampler(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    uint32_t                        uIndex)
+{
+    MOS_STATUS                  eStatus;
+    PMHW_SAMPLER_STATE_PARAM    pSamplerStateParams;
+
+    VPHAL_RENDER_CHK_NULL(pLauncher);
+    eStatus = MOS_STATUS_SUCCESS;
+
+    if (uIndex >= VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS)
+    {
+        VPHAL_RENDER_ASSERTMESSAGE("Invalid sampler index %d.", uIndex);
+        eStatus = MOS_STATUS_INVALID_PARAMETER;
+        goto finish;
+    }
+
+    pSamplerStateParams         = &pLauncher->SamplerStateParams[uIndex];
+    pLauncher->uSamplerCount    = MOS_MAX(pLauncher->uSamplerCount, uIndex + 1);
+
+    if (pSamplerStateParams->bInUse &&
+        pSamplerStateParams->SamplerType == MHW_SAMPLER_TYPE_3D)
+    {
+        goto finish;
+    }
+
+    MOS_ZeroMemory(pSamplerStateParams, sizeof(*pSamplerStateParams));
+    pSamplerStateParams->bInUse                  = true;
+    pSamplerStateParams->SamplerType             = MHW_SAMPLER_TYPE_3D;
+    pSamplerStateParams->Unorm.SamplerFilterMode = MHW_SAMPLER_FILTER_BILINEAR;
+    pSamplerStateParams->Unorm.AddressU          = MHW_GFX3DSTATE_TEXCOORDMODE_CLAMP;
+    pSamplerStateParams->Unorm.AddressV          = MHW_GFX3DSTATE_TEXCOORDMODE_CLAMP;
+    pSamplerStateParams->Unorm.AddressW          = MHW_GFX3DSTATE_TEXCOORDMODE_CLAMP;
+
+finish:
+    return eStatus;
+}
+
+MOS_STATUS VpHal_KernelLauncherBegin(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    bool                            bL3CachingEnabled)
+{
+    MOS_STATUS                      eStatus;
+    PMOS_INTERFACE                  pOsInterface;
+    PRENDERHAL_INTERFACE            pRenderHal;
+    PRENDERHAL_L3_CACHE_SETTINGS    pCacheSettings;
+    PVPHAL_RNDR_PERF_DATA           pPerfData;
+
+    VPHAL_RENDER_CHK_NULL(pLauncher);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pDesc);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pOsInterface);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pRenderHal);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pPerfData);
+
+    eStatus         = MOS_STATUS_SUCCESS;
+    pOsInterface    = pLauncher->pOsInterface;
+    pRenderHal      = pLauncher->pRenderHal;
+    pPerfData       = pLauncher->pPerfData;
+
+    pLauncher->uSamplerCount    = 0;
+    pLauncher->pMediaState      = nullptr;
+    pLauncher->iBindingTable    = -1;
+    pLauncher->iCurbeOffset     = -1;
+    pLauncher->iMediaID         = -1;
+
+    // Reset states before rendering
+    pOsInterface->pfnResetOsStates(pOsInterface);
+    VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnReset(pRenderHal));
+    pOsInterface->pfnResetPerfBufferID(pOsInterface);   // reset once per frame
+
+    VPHAL_DBG_STATE_DUMPPER_SET_CURRENT_STAGE(VPHAL_DBG_STAGE_COMP);
+
+    // Configure cache settings for this render operation
+    pCacheSettings      = &pRenderHal->L3CacheSettings;
+    MOS_ZeroMemory(pCacheSettings, sizeof(*pCacheSettings));
+    pCacheSettings->bOverride                  = true;
+    pCacheSettings->bL3CachingEnabled          = bL3CachingEnabled;
+
+    if (pPerfData->L3SQCReg1Override.bEnabled)
+    {
+        pCacheSettings->bSqcReg1Override       = true;
+        pCacheSettings->dwSqcReg1              = pPerfData->L3SQCReg1Override.uiVal;
+    }
+
+    if (pPerfData->L3CntlReg2Override.bEnabled)
+    {
+        pCacheSettings->bCntlReg2Override      = true;
+        pCacheSettings->dwCntlReg2             = pPerfData->L3CntlReg2Override.uiVal;
+    }
+
+    if (pPerfData->L3CntlReg3Override.bEnabled)
+    {
+        pCacheSettings->bCntlReg3Override      = true;
+        pCacheSettings->dwCntlReg3             = pPerfData->L3CntlReg3Override.uiVal;
+    }
+
+    if (pPerfData->L3LRA1RegOverride.bEnabled)
+    {
+        pCacheSettings->bLra1RegOverride       = true;
+        pCacheSettings->dwLra1Reg              = pPerfData->L3LRA1RegOverride.uiVal;
+    }
+
+    // Allocate and reset media state
+    pLauncher->pMediaState = pRenderHal->pfnAssignMediaState(pRenderHal, pLauncher->pDesc->Component);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pMediaState);
+
+    // Allocate and reset SSH instance
+    VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnAssignSshInstance(pRenderHal));
+
+    // Assign and Reset Binding Table
+    VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnAssignBindingTable(
+            pRenderHal,
+            &pLauncher->iBindingTable));
+
+finish:
+    return eStatus;
+}
+
+MOS_STATUS VpHal_KernelLauncherLoadCurbe(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    void                            *pData,
+    int32_t                         iSize)
+{
+    MOS_STATUS  eStatus;
+
+    VPHAL_RENDER_CHK_NULL(pLauncher);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pRenderHal);
+    VPHAL_RENDER_CHK_NULL(pData);
+    eStatus = MOS_STATUS_SUCCESS;
+
+    pLauncher->iCurbeOffset = pLauncher->pRenderHal->pfnLoadCurbeData(
+        pLauncher->pRenderHal,
+        pLauncher->pMediaState,
+        pData,
+        iSize);
+
+    if (pLauncher->iCurbeOffset < 0)
+    {
+        eStatus = MOS_STATUS_UNKNOWN;
+        goto finish;
+    }
+
+finish:
+    return eStatus;
+}
+
+MOS_STATUS VpHal_KernelLauncherSetupHwStates(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher)
+{
+    PRENDERHAL_INTERFACE        pRenderHal;
+    PRENDERHAL_KERNEL_PARAM     pKernelParam;
+    int32_t                     iKrnAllocation;
+    int32_t                     iThreadCount;
+    MHW_KERNEL_PARAM            MhwKernelParam;
+    MOS_STATUS                  eStatus;
+
+    VPHAL_RENDER_CHK_NULL(pLauncher);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pRenderHal);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pKernelParam);
+    VPHAL_RENDER_CHK_NULL(pLauncher->KernelEntry.pBinary);
+
+    eStatus         = MOS_STATUS_SUCCESS;
+    pRenderHal      = pLauncher->pRenderHal;
+    pKernelParam    = pLauncher->pKernelParam;
+
+    if (pLauncher->pPerfData && pLauncher->pPerfData->CompMaxThreads.bEnabled)
+    {
+        iThreadCount = pLauncher->pPerfData->CompMaxThreads.uiVal;
+    }
+    else
+    {
+        iThreadCount = pKernelParam->Thread_Count;
+    }
+
+    // Setup VFE State params.
+    VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnSetVfeStateParams(
+        pRenderHal,
+        MEDIASTATE_DEBUG_COUNTER_FREE_RUNNING,
+        iThreadCount,
+        pKernelParam->CURBE_Length * GRF_SIZE,
+        0,
+        nullptr));
+
+    // Load kernel to GSH, a kernel already in the GSH is not copied again
+    INIT_MHW_KERNEL_PARAM(MhwKernelParam, &pLauncher->KernelEntry);
+    iKrnAllocation = pRenderHal->pfnLoadKernel(
+        pRenderHal,
+        pKernelParam,
+        &MhwKernelParam,
+        nullptr);
+
+    if (iKrnAllocation < 0)
+    {
+        eStatus = MOS_STATUS_UNKNOWN;
+        goto finish;
+    }
+
+    // Allocate Media ID, link to kernel
+    pLauncher->iMediaID = pRenderHal->pfnAllocateMediaID(
+        pRenderHal,
+        iKrnAllocation,
+        pLauncher->iBindingTable,
+        pLauncher->iCurbeOffset,
+        (pKernelParam->CURBE_Length << 5),
+        0,
+        nullptr);
+
+    if (pLauncher->iMediaID < 0)
+    {
+        eStatus = MOS_STATUS_UNKNOWN;
+        goto finish;
+    }
+
+    // Set Sampler states for this Media ID
+    if (pLauncher->uSamplerCount > 0)
+    {
+        VPHAL_RENDER_CHK_STATUS(pRenderHal->pfnSetSamplerStates(
+            pRenderHal,
+            pLauncher->iMediaID,
+            pLauncher->SamplerStateParams,
+            pLauncher->uSamplerCount));
+    }
+
+finish:
+    VPHAL_RENDER_ASSERT(eStatus == MOS_STATUS_SUCCESS);
+    return eStatus;
+}
+
+MOS_STATUS VpHal_KernelLauncherSubmit(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    uint32_t                        dwWidth,
+    uint32_t                        dwHeight,
+    bool                            bNullRendering,
+    PSTATUS_TABLE_UPDATE_PARAMS     pStatusTableUpdateParams)
+{
+    PMOS_INTERFACE              pOsInterface;
+    PRENDERHAL_INTERFACE        pRenderHal;
+    PRENDERHAL_KERNEL_PARAM     pKernelParam;
+    MHW_WALKER_PARAMS           WalkerParams;
+    int32_t                     iBlocksX;
+    int32_t                     iBlocksY;
+    MOS_STATUS                  eStatus;
+
+    VPHAL_RENDER_CHK_NULL(pLauncher);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pDesc);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pOsInterface);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pRenderHal);
+    VPHAL_RENDER_CHK_NULL(pLauncher->pKernelParam);
+
+    eStatus         = MOS_STATUS_SUCCESS;
+    pOsInterface    = pLauncher->pOsInterface;
+    pRenderHal      = pLauncher->pRenderHal;
+    pKernelParam    = pLauncher->pKernelParam;
+
+    // Set perftag information
+    pOsInterface->pfnResetPerfBufferID(pOsInterface);
+    pOsInterface->pfnSetPerfTag(pOsInterface, pLauncher->pDesc->PerfTag);
+
+    // Calculate how many media object commands are needed.
+    iBlocksX = MOS_ALIGN_CEIL(dwWidth,  pKernelParam->block_width)  / pKernelParam->block_width;
+    iBlocksY = MOS_ALIGN_CEIL(dwHeight, pKernelParam->block_height) / pKernelParam->block_height;
+
+    // Set walker cmd params - Rasterscan
+    MOS_ZeroMemory(&WalkerParams, sizeof(WalkerParams));
+
+    WalkerParams.InterfaceDescriptorOffset    = pLauncher->iMediaID;
+
+    WalkerParams.dwGlobalLoopExecCount        = 1;
+    WalkerParams.dwLocalLoopExecCount         = iBlocksY - 1;
+
+    WalkerParams.GlobalResolution.x           = iBlocksX;
+    WalkerParams.GlobalResolution.y           = iBlocksY;
+
+    WalkerParams.GlobalStart.x                = 0;
+    WalkerParams.GlobalStart.y                = 0;
+
+    WalkerParams.GlobalOutlerLoopStride.x     = iBlocksX;
+    WalkerParams.GlobalOutlerLoopStride.y     = 0;
+
+    WalkerParams.GlobalInnerLoopUnit.x        = 0;
+    WalkerParams.GlobalInnerLoopUnit.y        = iBlocksY;
+
+    WalkerParams.BlockResolution.x            = iBlocksX;
+    WalkerParams.BlockResolution.y            = iBlocksY;
+
+    WalkerParams.LocalStart.x                 = 0;
+    WalkerParams.LocalStart.y                 = 0;
+
+    WalkerParams.LocalEnd.x                   = iBlocksX - 1;
+    WalkerParams.LocalEnd.y                   = 0;
+
+    WalkerParams.LocalOutLoopStride.x         = 0;
+    WalkerParams.LocalOutLoopStride.y         = 1;
+
+    WalkerParams.LocalInnerLoopUnit.x         = 1;
+    WalkerParams.LocalInnerLoopUnit.y         = 0;
+
+    VPHAL_DBG_STATE_DUMPPER_DUMP_GSH(pRenderHal);
+    VPHAL_DBG_STATE_DUMPPER_DUMP_SSH(pRenderHal);
+
+    VPHAL_RENDER_CHK_STATUS(VpHal_RndrSubmitCommands(
+        pRenderHal,
+        nullptr,
+        bNullRendering,
+        &WalkerParams,
+        nullptr,
+        pStatusTableUpdateParams,
+        pLauncher->pDesc->KernelID,
+        0,
+        nullptr,
+        true));
+
+finish:
+    return eStatus;
+}
+
+void VpHal_KernelLauncherEnd(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher)
+{
+    if (pLauncher && pLauncher->pRenderHal)
+    {
+        MOS_ZeroMemory(&pLauncher->pRenderHal->L3CacheSettings, sizeof(pLauncher->pRenderHal->L3CacheSettings));
+    }
+}
@@ -0,0 +1,241 @@
+/*
+*
+* Copyright (c) Intel Corporation (2018).
+*
+* INTEL MAKES NO WARRANTY OF ANY KIND REGARDING THE CODE.  THIS CODE IS
+* LICENSED ON AN "AS IS" BASIS AND INTEL WILL NOT PROVIDE ANY SUPPORT,
+* ASSISTANCE, INSTALLATION, TRAINING OR OTHER SERVICES.  INTEL DOES NOT
+* PROVIDE ANY UPDATES, ENHANCEMENTS OR EXTENSIONS.  INTEL SPECIFICALLY
+* DISCLAIMS ANY WARRANTY OF MERCHANTABILITY, NONINFRINGEMENT, FITNESS FOR ANY
+* PARTICULAR PURPOSE, OR ANY OTHER WARRANTY.  Intel disclaims all liability,
+* including liability for infringement of any proprietary rights, relating to
+* use of the code. No license, express or implied, by estoppel or otherwise,
+* to any intellectual property rights is granted herein.
+*
+*
+* File Name  : vphal_render_kernel_launcher.h
+*
+* Abstract   : Media walker kernel launcher for Video Processing
+*
+* Environment: Linux
+*
+* Notes      : This module contains the launcher shared by the single kernel
+*              render features of VPHAL
+*
+*/
+//!
+//! \file     vphal_render_kernel_launcher.h
+//! \brief    Launcher of the single kernel VP render features
+//! \details  Runs one media walker kernel described by a feature table. The
+//!           kernel entry and the sampler state params are kept across frames,
+//!           so the kernel binary is looked up once and the AVS coefficients
+//!           are only computed again when the format or scaling changes.
+//!
+#ifndef __VPHAL_RENDER_KERNEL_LAUNCHER_H__
+#define __VPHAL_RENDER_KERNEL_LAUNCHER_H__
+
+#include "mos_os.h"
+#include "renderhal.h"
+#include "vphal_render_common.h"
+
+#define VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS  3    // max samplers of a launched kernel
+
+//!
+//! \brief Kernel launched by a VP render feature
+//!
+typedef struct _VPHAL_KERNEL_LAUNCH_DESC
+{
+    RENDERHAL_COMPONENT             Component;          //!< Component of the media state
+    int32_t                         iKUID;              //!< Kernel in the component kernel cache
+    VpKernelID                      KernelID;           //!< Kernel written to the status table
+    VPHAL_PERFTAG                   PerfTag;            //!< Perf tag of the submission
+} VPHAL_KERNEL_LAUNCH_DESC, *PVPHAL_KERNEL_LAUNCH_DESC;
+
+//!
+//! \brief VPHAL kernel launcher state
+//!
+typedef struct _VPHAL_KERNEL_LAUNCHER
+{
+    // External components and tables
+    const VPHAL_KERNEL_LAUNCH_DESC  *pDesc;
+    PMOS_INTERFACE                  pOsInterface;
+    PRENDERHAL_INTERFACE            pRenderHal;
+    Kdll_State                      *pKernelDllState;
+    PVPHAL_RNDR_PERF_DATA           pPerfData;
+
+    // Kept across frames
+    PRENDERHAL_KERNEL_PARAM         pKernelParam;                                           //!< Kernel params of KernelEntry
+    Kdll_CacheEntry                 KernelEntry;                                            //!< Kernel binary, nullptr until looked up
+    MHW_SAMPLER_STATE_PARAM         SamplerStateParams[VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS];     //!< Sampler states
+    MHW_SAMPLER_AVS_TABLE_PARAM     mhwSamplerAvsTableParam[VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS];//!< AVS scaling 8x8 tables
+    MHW_AVS_PARAMS                  AVSParameters[VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS];          //!< AVS coefficients
+    MOS_FORMAT                      SamplerFormat[VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS];          //!< Source format of the sampler params
+    float                           fSamplerScaleX[VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS];         //!< Horizontal scaling of the sampler params
+    float                           fSamplerScaleY[VPHAL_KERNEL_LAUNCHER_MAX_SAMPLERS];         //!< Vertical scaling of the sampler params
+
+    // Set for each frame
+    uint32_t                        uSamplerCount;      //!< Samplers used by the frame
+    PRENDERHAL_MEDIA_STATE          pMediaState;
+    int32_t                         iBindingTable;
+    int32_t                         iCurbeOffset;
+    int32_t                         iMediaID;
+} VPHAL_KERNEL_LAUNCHER, *PVPHAL_KERNEL_LAUNCHER;
+
+//!
+//! \brief    Kernel launcher initialization
+//! \param    [in,out] pLauncher
+//!           Pointer to the kernel launcher
+//! \param    [in] pDesc
+//!           Kernel launched, kept by the launcher
+//! \param    [in] pRenderHal
+//!           Pointer to RenderHal Interface Structure
+//! \param    [in] pKernelDllState
+//!           Pointer to the kernel DLL state
+//! \param    [in] pPerfData
+//!           Pointer to the render perf data
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VpHal_KernelLauncherInitialize(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    const VPHAL_KERNEL_LAUNCH_DESC  *pDesc,
+    PRENDERHAL_INTERFACE            pRenderHal,
+    Kdll_State                      *pKernelDllState,
+    PVPHAL_RNDR_PERF_DATA           pPerfData);
+
+//!
+//! \brief    Kernel launcher destroy
+//! \param    [in,out] pLauncher
+//!           Pointer to the kernel launcher
+//!
+void VpHal_KernelLauncherDestroy(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher);
+
+//!
+//! \brief    Set the kernel params of the launched kernel
+//! \details  The kernel binary is looked up in the kernel DLL once
+//! \param    [in,out] pLauncher
+//!           Pointer to the kernel launcher
+//! \param    [in] pKernelParam
+//!           Kernel params, from a static table of the feature
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VpHal_KernelLauncherSetKernel(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    PRENDERHAL_KERNEL_PARAM         pKernelParam);
+
+//!
+//! \brief    Use an AVS sampler
+//! \details  The sampler params are only built again if the sampler was not
+//!           an AVS sampler of the same format and scaling
+//! \param    [in,out] pLauncher
+//!           Pointer to the kernel launcher
+//! \param    [in] uIndex
+//!           Sampler index
+//! \param    [in] SrcFormat
+//!           Source format
+//! \param    [in] fScaleX
+//!           Horizontal scaling ratio
+//! \param    [in] fScaleY
+//!           Vertical scaling ratio
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VpHal_KernelLauncherSetAvsSampler(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    uint32_t                        uIndex,
+    MOS_FORMAT                      SrcFormat,
+    float                           fScaleX,
+    float                           fScaleY);
+
+//!
+//! \brief    Use a bilinear 3D sampler
+//! \param    [in,out] pLauncher
+//!           Pointer to the kernel launcher
+//! \param    [in] uIndex
+//!           Sampler index
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VpHal_KernelLauncherSet3DSampler(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    uint32_t                        uIndex);
+
+//!
+//! \brief    Start a frame
+//! \details  Resets the states, configures the L3 cache and assigns the media
+//!           state, the SSH instance and the binding table of the frame.
+//!           VpHal_KernelLauncherEnd must be called whatever the result.
+//! \param    [in,out] pLauncher
+//!           Pointer to the kernel launcher
+//! \param    [in] bL3CachingEnabled
+//!           Enable L3 caching
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VpHal_KernelLauncherBegin(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    bool                            bL3CachingEnabled);
+
+//!
+//! \brief    Load the curbe data of the frame
+//! \param    [in,out] pLauncher
+//!           Pointer to the kernel launcher
+//! \param    [in] pData
+//!           Curbe data
+//! \param    [in] iSize
+//!           Size of curbe data
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VpHal_KernelLauncherLoadCurbe(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    void                            *pData,
+    int32_t                         iSize);
+
+//!
+//! \brief    Setup the HW states of the frame
+//! \details  Sets the VFE state, loads the kernel, allocates its media ID and
+//!           sets the samplers of the frame. The surfaces and the curbe data
+//!           must be set up before.
+//! \param    [in,out] pLauncher
+//!           Pointer to the kernel launcher
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VpHal_KernelLauncherSetupHwStates(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher);
+
+//!
+//! \brief    Submit one media walker over a region
+//! \param    [in] pLauncher
+//!           Pointer to the kernel launcher
+//! \param    [in] dwWidth
+//!           Width of the region in pixels
+//! \param    [in] dwHeight
+//!           Height of the region in pixels
+//! \param    [in] bNullRendering
+//!           Null rendering flag
+//! \param    [in] pStatusTableUpdateParams
+//!           Pointer to the status table update params
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VpHal_KernelLauncherSubmit(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher,
+    uint32_t                        dwWidth,
+    uint32_t                        dwHeight,
+    bool                            bNullRendering,
+    PSTATUS_TABLE_UPDATE_PARAMS     pStatusTableUpdateParams);
+
+//!
+//! \brief    End a frame
+//! \details  Restores the L3 cache settings
+//! \param    [in] pLauncher
+//!           Pointer to the kernel launcher
+//!
+void VpHal_KernelLauncherEnd(
+    PVPHAL_KERNEL_LAUNCHER          pLauncher);
+
+#endif // __VPHAL_RENDER_KERNEL_LAUNCHER_H__
@@ -30,6 +30,7 @@
 #include "vphal_debug.h"
 #include "vphal_renderer.h"
 #include "vphal_render_vebox_util_base.h"
+#include "vphal_render_vebox_denoise_params.h"
 
 #include "vphal_render_common.h"
 #include "renderhal_platform_interface.h"
@@ -328,6 +329,17 @@ MOS_STATUS VPHAL_VEBOX_STATE::Initialize(
         m_sfcPipeState->SetDisable(UserFeatureData.bData ? true : false);
     }
 
+#if VEBOX_AUTO_DENOISE_SUPPORTED
+    // Read user feature key to get the auto denoise update mode, DN update kernel by default
+    MOS_ZeroMemory(&UserFeatureData, sizeof(UserFeatureData));
+    MOS_USER_FEATURE_INVALID_KEY_ASSERT(MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __VPHAL_VEBOX_AUTO_DN_UPDATE_MODE_ID,
+        &UserFeatureData));
+    pVeboxState->dwAutoDnUpdateMode = (UserFeatureData.u32Data == VPHAL_AUTO_DN_UPDATE_CPU) ?
+                                      VPHAL_AUTO_DN_UPDATE_CPU : VPHAL_AUTO_DN_UPDATE_KERNEL;
+#endif
+
     pVeboxState->bEnableMMC = 0;
     pVeboxState->bDisableTemporalDenoiseFilter = 0;
     pVeboxState->bDisableTemporalDenoiseFilterUserKey = 0;
@@ -1484,6 +1496,314 @@ finish:
     return eStatus;
 }
 
+//!
+//! \brief    Get denoise factors from the statistics of the previous frame
+//! \details  Replaces the DN update kernel when auto denoise is updated on the
+//!           CPU. The statistics surface stays locked, the GNE sums and counts
+//!           VEBOX wrote for the previous frame are read without waiting and
+//!           the filtered noise levels are used as denoise slider values.
+//!           GNE layout per slice: luma sum, luma count, U sum, U count,
+//!           V sum, V count.
+//! \param    [out] pdwLumaFactor
+//!           Denoise factor for luma, in [NOISEFACTOR_MIN, NOISEFACTOR_MAX]
+//! \param    [out] pdwChromaFactor
+//!           Denoise factor for chroma, in [NOISEFACTOR_MIN, NOISEFACTOR_MAX]
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VPHAL_VEBOX_STATE::VeboxGetAutoDenoiseFactors(
+    uint32_t                    *pdwLumaFactor,
+    uint32_t                    *pdwChromaFactor)
+{
+    PVPHAL_VEBOX_STATE          pVeboxState = this;
+    MOS_LOCK_PARAMS             LockFlags;
+    uint32_t                    dwGneOffset;
+    uint32_t                    dwGne[2 * VPHAL_AUTO_DN_GNE_DWORDS];
+    uint32_t                    dwLevel[3];
+    int32_t                     iOffset0;
+    int32_t                     iOffset1;
+    MOS_STATUS                  eStatus;
+
+    VPHAL_RENDER_CHK_NULL(pdwLumaFactor);
+    VPHAL_RENDER_CHK_NULL(pdwChromaFactor);
+
+    eStatus     = MOS_STATUS_SUCCESS;
+    dwGneOffset = 0;
+
+    if (pVeboxState->pStatisticsData == nullptr)
+    {
+        MOS_ZeroMemory(&LockFlags, sizeof(MOS_LOCK_PARAMS));
+        LockFlags.ReadOnly = 1;
+
+        pVeboxState->pStatisticsData = (uint8_t*)m_pOsInterface->pfnLockResource(
+            m_pOsInterface,
+            &pVeboxState->VeboxStatisticsSurface.OsResource,
+            &LockFlags);
+        VPHAL_RENDER_CHK_NULL(pVeboxState->pStatisticsData);
+    }
+
+    VPHAL_RENDER_CHK_STATUS(VeboxQueryStatLayout(VEBOX_STAT_QUERY_GNE_OFFEST, &dwGneOffset));
+    VPHAL_RENDER_CHK_STATUS(VeboxGetStatisticsSurfaceOffsets(&iOffset0, &iOffset1));
+
+    dwLevel[0] = pVeboxState->dwGlobalNoiseLevel;
+    dwLevel[1] = pVeboxState->dwGlobalNoiseLevelU;
+    dwLevel[2] = pVeboxState->dwGlobalNoiseLevelV;
+
+    // Statistics still being written by VEBOX keep the last levels
+    if (VpHal_ReadAutoDenoiseGne(
+            (uint32_t*)(pVeboxState->pStatisticsData + iOffset0 + dwGneOffset),
+            (uint32_t*)(pVeboxState->pStatisticsData + iOffset1 + dwGneOffset),
+            dwGne))
+    {
+        VpHal_FilterAutoDenoiseLevels(dwGne, pVeboxState->bFirstFrame, dwLevel);
+    }
+
+    pVeboxState->dwGlobalNoiseLevel  = dwLevel[0];
+    pVeboxState->dwGlobalNoiseLevelU = dwLevel[1];
+    pVeboxState->dwGlobalNoiseLevelV = dwLevel[2];
+
+    VpHal_GetAutoDenoiseFactors(dwLevel, NOISEFACTOR_MAX, pdwLumaFactor, pdwChromaFactor);
+
+finish:
+    return eStatus;
+}
+
+//!
+//! \brief    Get the denoise slider factors of the frame
+//! \details  Shared by the SetDNDIParams of each gen. The factors come from the
+//!           application denoise strength, or from the CPU auto denoise update.
+//!           Auto detect updated by the DN update kernel keeps the default DN
+//!           states, and so does a CPU update that cannot read the statistics.
+//! \param    [in] pDNParams
+//!           Denoise parameters of the source surface
+//! \param    [out] pdwLumaFactor
+//!           Denoise factor for luma, in [NOISEFACTOR_MIN, NOISEFACTOR_MAX]
+//! \param    [out] pdwChromaFactor
+//!           Denoise factor for chroma, in [NOISEFACTOR_MIN, NOISEFACTOR_MAX]
+//! \return   bool
+//!           true if the DN states are set from the slider factors
+//!
+bool VPHAL_VEBOX_STATE::VeboxGetDenoiseSliderFactors(
+    PVPHAL_DENOISE_PARAMS       pDNParams,
+    uint32_t                    *pdwLumaFactor,
+    uint32_t                    *pdwChromaFactor)
+{
+    uint32_t                    dwDenoiseFactor;
+
+    if (pDNParams == nullptr || pdwLumaFactor == nullptr || pdwChromaFactor == nullptr)
+    {
+        return false;
+    }
+
+    if (pDNParams->bAutoDetect)
+    {
+        return IsAutoDnCpuUpdate() &&
+               MOS_SUCCEEDED(VeboxGetAutoDenoiseFactors(pdwLumaFactor, pdwChromaFactor));
+    }
+
+    dwDenoiseFactor  = MOS_MIN((uint32_t)pDNParams->fDenoiseFactor, NOISEFACTOR_MAX);
+    *pdwLumaFactor   = dwDenoiseFactor;
+    *pdwChromaFactor = dwDenoiseFactor;
+
+    return true;
+}
+
+//!
+//! \brief    Unlock the statistics surface locked for the CPU auto denoise update
+//! \details  Must be called before the statistics surface is freed or reallocated.
+//!
+void VPHAL_VEBOX_STATE::VeboxUnlockStatisticsSurface()
+{
+    if (pStatisticsData)
+    {
+        m_pOsInterface->pfnUnlockResource(
+            m_pOsInterface,
+            &VeboxStatisticsSurface.OsResource);
+        pStatisticsData = nullptr;
+    }
+}
+
+//!
+//! \brief    Copy the HVS denoise parameters into the DNDI state
+//! \details  The HVS denoise kernel writes the parameters in the DNDI state
+//!           layout on the render engine. Syncing on the buffer orders this
+//!           VEBOX submission after the kernel. Dwords fully computed by the
+//!           kernel are copied, the others are merged with MI_MATH so that the
+//!           bits programmed by the driver are kept. The bits come from
+//!           GetHVSDenoiseDndiDwordMask since the DNDI layout is per gen.
+//! \param    [in] pCmdBuffer
+//!           Pointer to the VEBOX command buffer
+//! \param    [in] pVeboxHeap
+//!           Pointer to the VEBOX heap
+//! \param    [in] bUseKernelResource
+//!           Whether VEBOX reads its states from the kernel resource of the heap
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VPHAL_VEBOX_STATE::VeboxCopyHVSDenoiseParams(
+    PMOS_COMMAND_BUFFER             pCmdBuffer,
+    const MHW_VEBOX_HEAP            *pVeboxHeap,
+    bool                            bUseKernelResource)
+{
+    MOS_STATUS                      eStatus = MOS_STATUS_SUCCESS;
+    PMOS_INTERFACE                  pOsInterface;
+    PMHW_MI_INTERFACE               pMhwMiInterface;
+    PMHW_MI_MMIOREGISTERS           pMmioRegisters;
+    PVPHAL_VEBOX_RENDER_DATA        pRenderData;
+    PMOS_RESOURCE                   presParams;
+    PMOS_RESOURCE                   presDndiState;
+    uint32_t                        dwDndiStateOffset;
+    uint32_t                        dwOffset;
+    uint32_t                        dwMask;
+    const uint32_t                  *pdwMasks;
+    MHW_MI_COPY_MEM_MEM_PARAMS      CopyMemMemParams;
+    MHW_MI_LOAD_REGISTER_MEM_PARAMS LoadRegMemParams;
+    MHW_MI_LOAD_REGISTER_IMM_PARAMS LoadRegImmParams;
+    MHW_MI_STORE_REGISTER_MEM_PARAMS StoreRegMemParams;
+    MHW_MI_MATH_PARAMS              MiMathParams;
+    MHW_MI_ALU_PARAMS               MiAluParams[12];
+    MHW_MI_FLUSH_DW_PARAMS          FlushDwParams;
+
+    VPHAL_RENDER_CHK_NULL_RETURN(pCmdBuffer);
+    VPHAL_RENDER_CHK_NULL_RETURN(pVeboxHeap);
+    VPHAL_RENDER_CHK_NULL_RETURN(m_pRenderHal);
+    VPHAL_RENDER_CHK_NULL_RETURN(m_pRenderHal->pMhwMiInterface);
+
+    pOsInterface        = m_pOsInterface;
+    pMhwMiInterface     = m_pRenderHal->pMhwMiInterface;
+    pMmioRegisters      = pMhwMiInterface->GetMmioRegisters();
+    pRenderData         = GetLastExecRenderData();
+    VPHAL_RENDER_CHK_NULL_RETURN(pOsInterface);
+    VPHAL_RENDER_CHK_NULL_RETURN(pMmioRegisters);
+    VPHAL_RENDER_CHK_NULL_RETURN(pRenderData);
+
+    presParams          = pRenderData->pOsResHVSDenoiseParams;
+    presDndiState       = bUseKernelResource ?
+                              (PMOS_RESOURCE)&pVeboxHeap->KernelResource :
+                              (PMOS_RESOURCE)&pVeboxHeap->DriverResource;
+    dwDndiStateOffset   = pVeboxHeap->uiDndiStateOffset +
+                          pVeboxHeap->uiCurState * pVeboxHeap->uiInstanceSize;
+    VPHAL_RENDER_CHK_NULL_RETURN(presParams);
+
+    pdwMasks            = GetHVSDenoiseDndiDwordMask();
+    if (pdwMasks == nullptr)
+    {
+        VPHAL_RENDER_ASSERTMESSAGE("HVS denoise parameters are not supported by the DNDI state of this platform.");
+        return MOS_STATUS_UNIMPLEMENTED;
+    }
+
+    // Wait for the HVS denoise kernel on the render engine
+    pOsInterface->pfnSyncOnResource(
+        pOsInterface,
+        presParams,
+        MOS_GPU_CONTEXT_VEBOX,
+        false);
+
+    // Merge: GPR0 = (params & mask) | (state & ~mask)
+    MOS_ZeroMemory(MiAluParams, sizeof(MiAluParams));
+    MiAluParams[0].AluOpcode    = MHW_MI_ALU_LOAD;
+    MiAluParams[0].Operand1     = MHW_MI_ALU_SRCA;
+    MiAluParams[0].Operand2     = MHW_MI_ALU_GPREG0;
+    MiAluParams[1].AluOpcode    = MHW_MI_ALU_LOAD;
+    MiAluParams[1].Operand1     = MHW_MI_ALU_SRCB;
+    MiAluParams[1].Operand2     = MHW_MI_ALU_GPREG11;
+    MiAluParams[2].AluOpcode    = MHW_MI_ALU_AND;
+    MiAluParams[3].AluOpcode    = MHW_MI_ALU_STORE;
+    MiAluParams[3].Operand1     = MHW_MI_ALU_GPREG0;
+    MiAluParams[3].Operand2     = MHW_MI_ALU_ACCU;
+    MiAluParams[4].AluOpcode    = MHW_MI_ALU_LOAD;
+    MiAluParams[4].Operand1     = MHW_MI_ALU_SRCA;
+    MiAluParams[4].Operand2     = MHW_MI_ALU_GPREG4;
+    MiAluParams[5].AluOpcode    = MHW_MI_ALU_LOADINV;
+    MiAluParams[5].Operand1     = MHW_MI_ALU_SRCB;
+    MiAluParams[5].Operand2     = MHW_MI_ALU_GPREG11;
+    MiAluParams[6].AluOpcode    = MHW_MI_ALU_AND;
+    MiAluParams[7].AluOpcode    = MHW_MI_ALU_STORE;
+    MiAluParams[7].Operand1     = MHW_MI_ALU_GPREG4;
+    MiAluParams[7].Operand2     = MHW_MI_ALU_ACCU;
+    MiAluParams[8].AluOpcode    = MHW_MI_ALU_LOAD;
+    MiAluParams[8].Operand1     = MHW_MI_ALU_SRCA;
+    MiAluParams[8].Operand2     = MHW_MI_ALU_GPREG0;
+    MiAluParams[9].AluOpcode    = MHW_MI_ALU_LOAD;
+    MiAluParams[9].Operand1     = MHW_MI_ALU_SRCB;
+    MiAluParams[9].Operand2     = MHW_MI_ALU_GPREG4;
+    MiAluParams[10].AluOpcode   = MHW_MI_ALU_OR;
+    MiAluParams[11].AluOpcode   = MHW_MI_ALU_STORE;
+    MiAluParams[11].Operand1    = MHW_MI_ALU_GPREG0;
+    MiAluParams[11].Operand2    = MHW_MI_ALU_ACCU;
+
+    MiMathParams.pAluPayload    = MiAluParams;
+    MiMathParams.dwNumAluParams = 12;
+
+    for (uint32_t i = 0; i < VPHAL_HVS_DN_PARAM_DWORDS; i++)
+    {
+        dwMask      = pdwMasks[i];
+        dwOffset    = i * sizeof(uint32_t);
+
+        if (dwMask == 0)
+        {
+            continue;
+        }
+
+        if (dwMask == 0xffffffff)
+        {
+            MOS_ZeroMemory(&CopyMemMemParams, sizeof(CopyMemMemParams));
+            CopyMemMemParams.presSrc        = presParams;
+            CopyMemMemParams.dwSrcOffset    = dwOffset;
+            CopyMemMemParams.presDst        = presDndiState;
+            CopyMemMemParams.dwDstOffset    = dwDndiStateOffset + dwOffset;
+            VPHAL_RENDER_CHK_STATUS_RETURN(pMhwMiInterface->AddMiCopyMemMemCmd(
+                pCmdBuffer,
+                &CopyMemMemParams));
+            continue;
+        }
+
+        // GPR0 = params, GPR4 = state, GPR11 = mask, only the low dwords are stored
+        MOS_ZeroMemory(&LoadRegMemParams, sizeof(LoadRegMemParams));
+        LoadRegMemParams.presStoreBuffer    = presParams;
+        LoadRegMemParams.dwOffset           = dwOffset;
+        LoadRegMemParams.dwRegister         = pMmioRegisters->generalPurposeRegister0LoOffset;
+        VPHAL_RENDER_CHK_STATUS_RETURN(pMhwMiInterface->AddMiLoadRegisterMemCmd(
+            pCmdBuffer,
+            &LoadRegMemParams));
+
+        MOS_ZeroMemory(&LoadRegMemParams, sizeof(LoadRegMemParams));
+        LoadRegMemParams.presStoreBuffer    = presDndiState;
+        LoadRegMemParams.dwOffset           = dwDndiStateOffset + dwOffset;
+        LoadRegMemParams.dwRegister         = pMmioRegisters->generalPurposeRegister4LoOffset;
+        VPHAL_RENDER_CHK_STATUS_RETURN(pMhwMiInterface->AddMiLoadRegisterMemCmd(
+            pCmdBuffer,
+            &LoadRegMemParams));
+
+        MOS_ZeroMemory(&LoadRegImmParams, sizeof(LoadRegImmParams));
+        LoadRegImmParams.dwData             = dwMask;
+        LoadRegImmParams.dwRegister         = pMmioRegisters->generalPurposeRegister11LoOffset;
+        VPHAL_RENDER_CHK_STATUS_RETURN(pMhwMiInterface->AddMiLoadRegisterImmCmd(
+            pCmdBuffer,
+            &LoadRegImmParams));
+
+        VPHAL_RENDER_CHK_STATUS_RETURN(pMhwMiInterface->AddMiMathCmd(
+            pCmdBuffer,
+            &MiMathParams));
+
+        MOS_ZeroMemory(&StoreRegMemParams, sizeof(StoreRegMemParams));
+        StoreRegMemParams.presStoreBuffer   = presDndiState;
+        StoreRegMemParams.dwOffset          = dwDndiStateOffset + dwOffset;
+        StoreRegMemParams.dwRegister        = pMmioRegisters->generalPurposeRegister0LoOffset;
+        VPHAL_RENDER_CHK_STATUS_RETURN(pMhwMiInterface->AddMiStoreRegisterMemCmd(
+            pCmdBuffer,
+            &StoreRegMemParams));
+    }
+
+    // Make the DNDI state writes visible before VEBOX_STATE loads the state
+    MOS_ZeroMemory(&FlushDwParams, sizeof(FlushDwParams));
+    VPHAL_RENDER_CHK_STATUS_RETURN(pMhwMiInterface->AddMiFlushDwCmd(
+        pCmdBuffer,
+        &FlushDwParams));
+
+    return eStatus;
+}
+
 //!
 //! \brief    Vebox state heap update for auto mode features
 //! \details  Update Vebox indirect states for auto mode features
@@ -1515,6 +1835,13 @@ MOS_STATUS VPHAL_VEBOX_STATE::VeboxUpdateVeboxStates(
         // only when auto denoise is on do we need to update VEBOX states
         return MOS_STATUS_SUCCESS;
     }
+
+    if (IsAutoDnCpuUpdate())
+    {
+        // DN states were already updated on the CPU by VeboxSetDNDIParams
+        return MOS_STATUS_SUCCESS;
+    }
+
     // Switch GPU Context to Render Engine
     pOsInterface->pfnSetGpuContext(pOsInterface, RenderGpuContext);
 
@@ -1975,6 +2302,17 @@ MOS_STATUS VPHAL_VEBOX_STATE::VeboxRenderVeboxCmd(
         &VeboxDiIecpCmdParams,
         &CmdBuffer));
 
+    //---------------------------------
+    // Copy HVS denoise params into the DNDI state
+    //---------------------------------
+    if (pRenderData->bDenoise && pRenderData->pOsResHVSDenoiseParams)
+    {
+        VPHAL_RENDER_CHK_STATUS(VeboxCopyHVSDenoiseParams(
+            &CmdBuffer,
+            pVeboxHeap,
+            VeboxStateCmdParams.bUseVeboxHeapKernelResource));
+    }
+
     //---------------------------------
     // Send CMD: Vebox_State
     //---------------------------------
@@ -2167,7 +2505,7 @@ finish:
 MOS_STATUS VPHAL_VEBOX_STATE::VeboxSyncIndirectStateCmd()
 {
 #if VEBOX_AUTO_DENOISE_SUPPORTED
-    if (GetLastExecRenderData()->bAutoDenoise)
+    if (GetLastExecRenderData()->bAutoDenoise && !IsAutoDnCpuUpdate())
     {
         // Make sure copy kernel and update kernels are finished before submitting
         // VEBOX commands
@@ -4312,6 +4650,8 @@ VPHAL_VEBOX_STATE::VPHAL_VEBOX_STATE(
     dwKernelUpdate      = 0;                        //!< Enable/Disable kernel update
 
     dwCompBypassMode    = 0;                        //!< Bypass Composition Optimization read from User feature keys
+    dwAutoDnUpdateMode  = VPHAL_AUTO_DN_UPDATE_KERNEL; //!< Auto denoise update mode read from User feature keys
+    pStatisticsData     = nullptr;                  //!< Statistics surface kept locked for the CPU auto denoise update
 
     // Debug parameters
     pKernelName                          = nullptr; //!< Kernel Used for current rendering
@@ -4421,69 +4761,13 @@ MOS_STATUS VPHAL_VEBOX_STATE::VeboxSetHVSDNParams(
 
     if (m_hvsDenoiser)
     {
-        m_hvsDenoiser->Render(pSrcSurface);
-        uint32_t *pHVSDenoiseParam = (uint32_t *)m_hvsDenoiser->GetDenoiseParams();
-        if (pHVSDenoiseParam)
+        // Media kernel computes the HVS Denoise Parameters according to the specific mapping function.
+        // They stay in GPU memory and are copied into the VEBOX DNDI state by VeboxCopyHVSDenoiseParams.
+        VPHAL_RENDER_CHK_STATUS_RETURN(m_hvsDenoiser->Render(pSrcSurface));
+        pRenderData->pOsResHVSDenoiseParams = m_hvsDenoiser->GetDenoiseParamsResource();
+        if (pRenderData->pOsResHVSDenoiseParams)
         {
-            // Media kernel computed the HVS Denoise Parameters according to the specific mapping function.
-            // Programming these Parameters to VEBOX for processing.
             VPHAL_RENDER_NORMALMESSAGE("Set HVS Denoised Parameters to VEBOX DNDI params");
-            // DW0
-            pRenderData->VeboxDNDIParams.dwDenoiseMPThreshold       = (pHVSDenoiseParam[0] & 0x0000001f);
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwDenoiseMPThreshold %d", pRenderData->VeboxDNDIParams.dwDenoiseMPThreshold);
-            pRenderData->VeboxDNDIParams.dwDenoiseHistoryDelta      = (pHVSDenoiseParam[0] & 0x00000f00) >> 8;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwDenoiseHistoryDelta %d", pRenderData->VeboxDNDIParams.dwDenoiseHistoryDelta);
-            pRenderData->VeboxDNDIParams.dwDenoiseMaximumHistory    = (pHVSDenoiseParam[0] & 0x000ff000) >> 12;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwDenoiseMaximumHistory %d", pRenderData->VeboxDNDIParams.dwDenoiseMaximumHistory);
-            pRenderData->VeboxDNDIParams.dwDenoiseSTADThreshold     = (pHVSDenoiseParam[0] & 0xfff00000) >> 20;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwDenoiseSTADThreshold %d", pRenderData->VeboxDNDIParams.dwDenoiseSTADThreshold);
-            // DW1
-            pRenderData->VeboxDNDIParams.dwLTDThreshold             = (pHVSDenoiseParam[1] & 0x000003ff);
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwLTDThreshold %d", pRenderData->VeboxDNDIParams.dwLTDThreshold);
-            pRenderData->VeboxDNDIParams.dwTDThreshold              = (pHVSDenoiseParam[1] & 0x000ffc00) >> 10;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwTDThreshold %d", pRenderData->VeboxDNDIParams.dwTDThreshold);
-            pRenderData->VeboxDNDIParams.dwDenoiseASDThreshold      = (pHVSDenoiseParam[1] & 0xfff00000) >> 20;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwDenoiseASDThreshold %d", pRenderData->VeboxDNDIParams.dwDenoiseASDThreshold);
-            // DW2
-            pRenderData->VeboxDNDIParams.dwDenoiseSCMThreshold      = (pHVSDenoiseParam[2] & 0x0fff0000) >> 16;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwDenoiseSCMThreshold %d", pRenderData->VeboxDNDIParams.dwDenoiseSCMThreshold);
-            // DW4
-            pRenderData->VeboxDNDIParams.dwChromaLTDThreshold       = (pHVSDenoiseParam[4] & 0x0000003f);
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwChromaLTDThreshold %d", pRenderData->VeboxDNDIParams.dwChromaLTDThreshold);
-            pRenderData->VeboxDNDIParams.dwChromaTDThreshold        = (pHVSDenoiseParam[4] & 0x00000fc0) >> 6;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwChromaTDThreshold %d", pRenderData->VeboxDNDIParams.dwChromaTDThreshold);
-            pRenderData->VeboxDNDIParams.dwChromaSTADThreshold      = (pHVSDenoiseParam[4] & 0x00ff0000) >> 16;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwChromaSTADThreshold %d", pRenderData->VeboxDNDIParams.dwChromaSTADThreshold);
-            // DW5
-            pRenderData->VeboxDNDIParams.dwPixRangeWeight[0]        = (pHVSDenoiseParam[5] & 0x0000001f);
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeWeight[0] %d", pRenderData->VeboxDNDIParams.dwPixRangeWeight[0]);
-            pRenderData->VeboxDNDIParams.dwPixRangeWeight[1]        = (pHVSDenoiseParam[5] & 0x000003e0) >> 5;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeWeight[1] %d", pRenderData->VeboxDNDIParams.dwPixRangeWeight[1]);
-            pRenderData->VeboxDNDIParams.dwPixRangeWeight[2]        = (pHVSDenoiseParam[5] & 0x00007c00) >> 10;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeWeight[2] %d", pRenderData->VeboxDNDIParams.dwPixRangeWeight[2]);
-            pRenderData->VeboxDNDIParams.dwPixRangeWeight[3]        = (pHVSDenoiseParam[5] & 0x000f8000) >> 15;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeWeight[3] %d", pRenderData->VeboxDNDIParams.dwPixRangeWeight[3]);
-            pRenderData->VeboxDNDIParams.dwPixRangeWeight[4]        = (pHVSDenoiseParam[5] & 0x01f00000) >> 20;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeWeight[4] %d", pRenderData->VeboxDNDIParams.dwPixRangeWeight[4]);
-            pRenderData->VeboxDNDIParams.dwPixRangeWeight[5]        = (pHVSDenoiseParam[5] & 0x3e000000) >> 25;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeWeight[5] %d", pRenderData->VeboxDNDIParams.dwPixRangeWeight[5]);
-            // DW7
-            pRenderData->VeboxDNDIParams.dwPixRangeThreshold[5]     = (pHVSDenoiseParam[7] & 0x1fff0000) >> 16;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeThreshold[5] %d", pRenderData->VeboxDNDIParams.dwPixRangeThreshold[5]);
-            // DW8
-            pRenderData->VeboxDNDIParams.dwPixRangeThreshold[4]     = (pHVSDenoiseParam[8] & 0x1fff0000) >> 16;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeThreshold[4] %d", pRenderData->VeboxDNDIParams.dwPixRangeThreshold[4]);
-            pRenderData->VeboxDNDIParams.dwPixRangeThreshold[3]     = (pHVSDenoiseParam[8] & 0x00001fff);
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeThreshold[3] %d", pRenderData->VeboxDNDIParams.dwPixRangeThreshold[3]);
-            // DW9
-            pRenderData->VeboxDNDIParams.dwPixRangeThreshold[2]     = (pHVSDenoiseParam[9] & 0x1fff0000) >> 16;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeThreshold[2] %d", pRenderData->VeboxDNDIParams.dwPixRangeThreshold[2]);
-            pRenderData->VeboxDNDIParams.dwPixRangeThreshold[1]     = (pHVSDenoiseParam[9] & 0x00001fff);
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeThreshold[1] %d", pRenderData->VeboxDNDIParams.dwPixRangeThreshold[1]);
-            // DW10
-            pRenderData->VeboxDNDIParams.dwPixRangeThreshold[0]     = (pHVSDenoiseParam[10] & 0x1fff0000) >> 16;
-            VPHAL_RENDER_NORMALMESSAGE("HVS: pRenderData->VeboxDNDIParams.dwPixRangeThreshold[0] %d", pRenderData->VeboxDNDIParams.dwPixRangeThreshold[0]);
-
             eStatus = MOS_STATUS_SUCCESS;
         }
     }
@@ -4537,6 +4821,7 @@ VPHAL_VEBOX_RENDER_DATA::VPHAL_VEBOX_RENDER_DATA()
     pRenderTarget      = nullptr;
     SamplerStateParams = { };
     VeboxDNDIParams    = { };
+    pOsResHVSDenoiseParams = nullptr;
     pAlphaParams       = nullptr;
     // Batch Buffer rendering arguments
     BbArgs = { };
@@ -4614,5 +4899,7 @@ MOS_STATUS VPHAL_VEBOX_RENDER_DATA::Init()
     }
     m_pVeboxIecpParams->Init();
 
+    pOsResHVSDenoiseParams = nullptr;
+
     return MOS_STATUS_SUCCESS;
 }
@@ -54,6 +54,12 @@
 #define NOISEFACTOR_MID                                 32                      //!< Mid Slider value, SKL+ only
 #define NOISEFACTOR_MIN                                 0                       //!< Min Slider value
 
+//!
+//! \brief Auto Denoise Update Mode
+//!
+#define VPHAL_AUTO_DN_UPDATE_KERNEL                     0                       //!< DN update kernel on the render engine
+#define VPHAL_AUTO_DN_UPDATE_CPU                        1                       //!< CPU update from the statistics of the previous frame
+
 //!
 //! \brief Temporal Denoise Definitions
 //!
@@ -718,6 +724,7 @@ public:
     MHW_SAMPLER_STATE_PARAM             SamplerStateParams;
 
     MHW_VEBOX_DNDI_PARAMS               VeboxDNDIParams;
+    PMOS_RESOURCE                       pOsResHVSDenoiseParams;                 //!< HVS denoise params copied into the DNDI state by VEBOX
 
     PVPHAL_ALPHA_PARAMS                 pAlphaParams;
 
@@ -959,6 +966,8 @@ public:
     uint32_t                        dwKernelUpdate;                             //!< Enable/Disable kernel update
 
     uint32_t                        dwCompBypassMode;                           //!< Bypass Composition Optimization read from User feature keys
+    uint32_t                        dwAutoDnUpdateMode;                         //!< Auto denoise update mode read from User feature keys
+    uint8_t                         *pStatisticsData;                           //!< Statistics surface kept locked for the CPU auto denoise update
 
     // Debug parameters
     char*                           pKernelName;                                //!< Kernel Used for current rendering
@@ -1716,6 +1725,80 @@ protected:
         int32_t*                            pStatSlice0Offset,
         int32_t*                            pStatSlice1Offset);
 
+    //!
+    //! \brief    Check if the auto denoise state is updated on the CPU
+    //! \return   bool
+    //!           true if auto denoise is on and updated from the CPU, false otherwise
+    //!
+    bool IsAutoDnCpuUpdate()
+    {
+        return GetLastExecRenderData()->bAutoDenoise &&
+               dwAutoDnUpdateMode == VPHAL_AUTO_DN_UPDATE_CPU;
+    }
+
+    //!
+    //! \brief    Get denoise factors from the statistics of the previous frame
+    //! \details  Replaces the DN update kernel when auto denoise is updated on the
+    //!           CPU. The statistics surface stays locked, the GNE sums and counts
+    //!           VEBOX wrote for the previous frame are read without waiting and
+    //!           the filtered noise levels are used as denoise slider values.
+    //! \param    [out] pdwLumaFactor
+    //!           Denoise factor for luma, in [NOISEFACTOR_MIN, NOISEFACTOR_MAX]
+    //! \param    [out] pdwChromaFactor
+    //!           Denoise factor for chroma, in [NOISEFACTOR_MIN, NOISEFACTOR_MAX]
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS VeboxGetAutoDenoiseFactors(
+        uint32_t                            *pdwLumaFactor,
+        uint32_t                            *pdwChromaFactor);
+
+    //!
+    //! \brief    Copy the HVS denoise parameters into the DNDI state
+    //! \details  The parameters computed by the HVS denoise kernel stay in GPU
+    //!           memory. The VEBOX command streamer merges the bits computed by
+    //!           the kernel into the DNDI state of the current VEBOX heap instance,
+    //!           so the DNDI state written by the CPU must be set up before.
+    //!           Fails on gens not providing GetHVSDenoiseDndiDwordMask.
+    //! \param    [in] pCmdBuffer
+    //!           Pointer to the VEBOX command buffer
+    //! \param    [in] pVeboxHeap
+    //!           Pointer to the VEBOX heap
+    //! \param    [in] bUseKernelResource
+    //!           Whether VEBOX reads its states from the kernel resource of the heap
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS VeboxCopyHVSDenoiseParams(
+        PMOS_COMMAND_BUFFER                 pCmdBuffer,
+        const MHW_VEBOX_HEAP                *pVeboxHeap,
+        bool                                bUseKernelResource);
+
+    //!
+    //! \brief    Get the denoise slider factors of the frame
+    //! \details  Shared by the SetDNDIParams of each gen. The factors come from the
+    //!           application denoise strength, or from the CPU auto denoise update.
+    //! \param    [in] pDNParams
+    //!           Denoise parameters of the source surface
+    //! \param    [out] pdwLumaFactor
+    //!           Denoise factor for luma, in [NOISEFACTOR_MIN, NOISEFACTOR_MAX]
+    //! \param    [out] pdwChromaFactor
+    //!           Denoise factor for chroma, in [NOISEFACTOR_MIN, NOISEFACTOR_MAX]
+    //! \return   bool
+    //!           true if the DN states are set from the slider factors, false to
+    //!           keep the auto detect defaults
+    //!
+    bool VeboxGetDenoiseSliderFactors(
+        PVPHAL_DENOISE_PARAMS               pDNParams,
+        uint32_t                            *pdwLumaFactor,
+        uint32_t                            *pdwChromaFactor);
+
+    //!
+    //! \brief    Unlock the statistics surface locked for the CPU auto denoise update
+    //! \details  Must be called before the statistics surface is freed or reallocated.
+    //!
+    void VeboxUnlockStatisticsSurface();
+
     //!
     //! \brief    Check if 2 passes CSC are supported on the platform
     //!
@@ -1810,6 +1893,19 @@ protected:
     virtual MOS_STATUS VeboxSetHVSDNParams(
         PVPHAL_SURFACE pSrcSurface);
 
+    //!
+    //! \brief    Get the bits of the DNDI state computed by the HVS denoise kernel
+    //! \details  The DNDI state layout differs between gens, only the gens with
+    //!           an HVS denoise kernel know where its parameters go
+    //! \return   const uint32_t*
+    //!           VPHAL_HVS_DN_PARAM_DWORDS masks from the first DNDI state dword,
+    //!           nullptr if the platform has no HVS denoise kernel
+    //!
+    virtual const uint32_t *GetHVSDenoiseDndiDwordMask()
+    {
+        return nullptr;
+    }
+
 };
 
 //!
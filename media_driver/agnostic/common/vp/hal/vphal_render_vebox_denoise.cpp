@@ -126,12 +126,13 @@ VphalHVSDenoiser::VphalHVSDenoiser(PRENDERHAL_INTERFACE renderHal) :
     m_eventManager(nullptr),
     m_renderHal(renderHal),
     m_hvsDenoiseCmSurface(nullptr),
-    m_hvsDenoiseParam(nullptr),
     m_hvsDenoise(nullptr),
     m_savedQP(0),
     m_savedStrength(0),
-    m_initHVSDenoise(false)
+    m_initHVSDenoise(false),
+    m_hvsDenoiseParamReady(false)
 {
+    MOS_ZeroMemory(&m_hvsDenoiseParamSurface, sizeof(m_hvsDenoiseParamSurface));
     m_eventManager = MOS_New(EventManager, "HVSEventManager");
     VPHAL_RENDER_NORMALMESSAGE("Constructor!");
 }
@@ -159,23 +160,44 @@ void VphalHVSDenoiser::InitKernelParams(void *kernelBinary, const int32_t kerneB
 void VphalHVSDenoiser::AllocateResouces(const uint32_t width, const uint32_t height)
 {
     uint32_t size         = width * height;
-    
-    m_hvsDenoiseCmSurface = MOS_New(VpCmSurfaceHolder<CmBuffer>, size, 1, 1, GMM_FORMAT_A8_UNORM_TYPE);
-    if (nullptr == m_hvsDenoiseCmSurface)
+    bool     allocated    = false;
+
+    // The parameter buffer is allocated by VPHAL so that VEBOX can read it from the command streamer
+    if (MOS_STATUS_SUCCESS != VpHal_ReAllocateSurface(
+            m_renderHal->pOsInterface,
+            &m_hvsDenoiseParamSurface,
+            "HVSDenoiseParamSurface",
+            Format_Buffer,
+            MOS_GFXRES_BUFFER,
+            MOS_TILE_LINEAR,
+            size,
+            1,
+            false,
+            MOS_MMC_DISABLED,
+            &allocated))
     {
-        VPHAL_RENDER_NORMALMESSAGE("[0x%x] Failed to Allocate m_hvsDenoiseCmSurface(gpu memory) GMM_FORMAT_A8_UNORM_TYPE %d*%d!", this, width, height);
+        VPHAL_RENDER_NORMALMESSAGE("[0x%x] Failed to Allocate m_hvsDenoiseParamSurface(gpu memory) %d*%d!", this, width, height);
+        return;
     }
-    m_hvsDenoiseParam     = MOS_NewArray(uint8_t, size);
-    if (nullptr == m_hvsDenoiseParam)
+
+    m_hvsDenoiseCmSurface = MOS_New(VpCmSurfaceHolder<CmBuffer>, &m_hvsDenoiseParamSurface);
+    if (nullptr == m_hvsDenoiseCmSurface || nullptr == m_hvsDenoiseCmSurface->GetCmSurface())
     {
-        VPHAL_RENDER_NORMALMESSAGE("[0x%x] Failed to Allocate m_hvsDenoiseParam(cpu memory) uint8_t %d*%d!", this, width, height);
+        VPHAL_RENDER_NORMALMESSAGE("[0x%x] Failed to Allocate m_hvsDenoiseCmSurface %d*%d!", this, width, height);
+        MOS_Delete(m_hvsDenoiseCmSurface);
     }
 }
 
 void VphalHVSDenoiser::FreeResources()
 {
-    MOS_DeleteArray(m_hvsDenoiseParam);
     MOS_Delete(m_hvsDenoiseCmSurface);
+    if (!Mos_ResourceIsNull(&m_hvsDenoiseParamSurface.OsResource))
+    {
+        m_renderHal->pOsInterface->pfnFreeResource(
+            m_renderHal->pOsInterface,
+            &m_hvsDenoiseParamSurface.OsResource);
+    }
+    m_hvsDenoiseParamReady = false;
 }
 
 MOS_STATUS VphalHVSDenoiser::Render(const PVPHAL_SURFACE pSrcSuface)
@@ -205,7 +227,9 @@ MOS_STATUS VphalHVSDenoiser::Render(const PVPHAL_SURFACE pSrcSuface)
         VPHAL_RENDER_NORMALMESSAGE("[0x%x] Init HVSDenoise[0x%x] and Allocate necessary resource!", this, m_hvsDenoise);
     }
 
-    if (qp != m_savedQP || strength != m_savedStrength)
+    VPHAL_RENDER_CHK_NULL_RETURN(m_hvsDenoiseCmSurface);
+
+    if (!m_hvsDenoiseParamReady || qp != m_savedQP || strength != m_savedStrength)
     {
         HVSDenoise::HVSDenoisePayload denoisePayload    = {0};
         denoisePayload.denoiseParam                     = m_hvsDenoiseCmSurface;
@@ -216,11 +240,11 @@ MOS_STATUS VphalHVSDenoiser::Render(const PVPHAL_SURFACE pSrcSuface)
         m_hvsDenoise->Render(&denoisePayload);
         CmContext::GetCmContext().FlushBatchTask(false);
         CmContext::GetCmContext().ConnectEventListener(nullptr);
-         
-        m_hvsDenoiseCmSurface->GetCmSurface()->ReadSurface((uint8_t *)m_hvsDenoiseParam, nullptr, m_denoiseBufferInBytes);
 
-        m_savedQP           = qp;
-        m_savedStrength     = strength;
+        // No readback: VEBOX copies the parameters into its DNDI state after syncing on the buffer
+        m_savedQP               = qp;
+        m_savedStrength         = strength;
+        m_hvsDenoiseParamReady  = true;
 
         VPHAL_RENDER_NORMALMESSAGE("Render qp %d, strength %d!", qp, strength);
     } 
@@ -71,9 +71,18 @@ public:
     // This InitKernelParams function needs to be called immediately after constructor function.
     void InitKernelParams(void *kernelBinary, const int32_t kerneBinarySize);
     MOS_STATUS Render(const PVPHAL_SURFACE pSrcSuface);
-    uint8_t*  GetDenoiseParams() 
-    { 
-        return m_hvsDenoiseParam; 
+
+    //!
+    //! \brief    Get the denoise parameters computed by the kernel
+    //! \details  The parameters stay in GPU memory, in the layout of the VEBOX
+    //!           DNDI state. The buffer is written by the render engine, so the
+    //!           VEBOX submission reading it must sync on it.
+    //! \return   PMOS_RESOURCE
+    //!           Buffer of the denoise parameters, nullptr if the kernel did not run yet
+    //!
+    PMOS_RESOURCE GetDenoiseParamsResource()
+    {
+        return m_hvsDenoiseParamReady ? &m_hvsDenoiseParamSurface.OsResource : nullptr;
     }
 
 private:
@@ -83,13 +92,14 @@ private:
     EventManager*                m_eventManager            = nullptr;
     PRENDERHAL_INTERFACE         m_renderHal               = nullptr;
     VpCmSurfaceHolder<CmBuffer> *m_hvsDenoiseCmSurface     = nullptr;
-    // Denoise Parameters in CPU memory
-    uint8_t *                    m_hvsDenoiseParam         = nullptr;
+    // Denoise Parameters in GPU memory, shared by the kernel and VEBOX
+    VPHAL_SURFACE                m_hvsDenoiseParamSurface;
     HVSDenoise *                 m_hvsDenoise              = nullptr;
 
     uint16_t m_savedQP              = 0;
     uint16_t m_savedStrength        = 0;
     bool     m_initHVSDenoise       = false;
+    bool     m_hvsDenoiseParamReady = false;
 
     // It is defined in Media Kernel.
     const uint32_t    m_denoiseBufferInBytes        = 64;
@@ -124,7 +134,7 @@ public:
         return MOS_STATUS_UNIMPLEMENTED;
     };
 
-    uint8_t *GetDenoiseParams()
+    PMOS_RESOURCE GetDenoiseParamsResource()
     {
         return nullptr;
     }
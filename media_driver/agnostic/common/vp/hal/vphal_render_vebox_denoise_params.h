@@ -0,0 +1,203 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vphal_render_vebox_denoise_params.h
+//! \brief    Denoise parameters computed outside of the VEBOX state setup
+//! \details  The HVS denoise kernel writes its parameters in the layout of the
+//!           VEBOX DNDI state. Only some bits of each dword are computed by the
+//!           kernel, the other bits are programmed by the driver.
+//!           The CPU auto denoise update derives the denoise slider factors from
+//!           the GNE statistics VEBOX wrote for the previous frame.
+//!
+#ifndef __VPHAL_RENDER_VEBOX_DENOISE_PARAMS_H__
+#define __VPHAL_RENDER_VEBOX_DENOISE_PARAMS_H__
+
+#include <stdint.h>
+
+#define VPHAL_HVS_DN_PARAM_DWORDS           11      //!< DNDI state dwords holding HVS denoise parameters
+
+#define VPHAL_AUTO_DN_GNE_DWORDS            6       //!< GNE dwords per slice: luma, U and V sums and counts
+#define VPHAL_AUTO_DN_GNE_HISTORY_WEIGHT    3       //!< Weight of the noise level history, out of 4
+#define VPHAL_AUTO_DN_GNE_READ_RETRIES      4       //!< Reads of the GNE statistics before a snapshot is given up
+#define VPHAL_AUTO_DN_LEVEL_PER_FACTOR      1       //!< Global noise level units per denoise slider step
+
+//!
+//! \brief Bits of each Gen9 DNDI state dword computed by the HVS denoise kernel
+//!
+static const uint32_t g_HVSDenoiseDndiDwordMask[VPHAL_HVS_DN_PARAM_DWORDS] =
+{
+    0xffffff1f,     // DW0: MP threshold, history delta, maximum history, STAD threshold
+    0xffffffff,     // DW1: LTD threshold, TD threshold, ASD threshold
+    0x0fff0000,     // DW2: SCM threshold
+    0x00000000,     // DW3
+    0x00ff0fff,     // DW4: chroma LTD, TD and STAD thresholds
+    0x3fffffff,     // DW5: pixel range weights 0 to 5
+    0x00000000,     // DW6
+    0x1fff0000,     // DW7: pixel range threshold 5
+    0x1fff1fff,     // DW8: pixel range thresholds 3 and 4
+    0x1fff1fff,     // DW9: pixel range thresholds 1 and 2
+    0x1fff0000      // DW10: pixel range threshold 0
+};
+
+//!
+//! \brief    Merge the HVS denoise parameters into a Gen9 DNDI state
+//! \details  CPU reference of the merge done by the VEBOX command streamer
+//!           when the parameters stay in GPU memory
+//! \param    [in] pParams
+//!           HVS denoise parameters written by the kernel
+//! \param    [in,out] pDndiState
+//!           DNDI state, the bits not computed by the kernel are kept
+//!
+static inline void VpHal_MergeHVSDenoiseParams(
+    const uint32_t  *pParams,
+    uint32_t        *pDndiState)
+{
+    for (uint32_t i = 0; i < VPHAL_HVS_DN_PARAM_DWORDS; i++)
+    {
+        pDndiState[i] = (pDndiState[i] & ~g_HVSDenoiseDndiDwordMask[i]) |
+                        (pParams[i] & g_HVSDenoiseDndiDwordMask[i]);
+    }
+}
+
+//!
+//! \brief    Copy the GNE statistics of both slices
+//! \details  VEBOX may be writing the statistics of the next frame while they
+//!           are read. The copy is kept only when it matches a second read, so
+//!           a sum is never paired with the count of another frame.
+//! \param    [in] pGneSlice0
+//!           GNE statistics of slice 0
+//! \param    [in] pGneSlice1
+//!           GNE statistics of slice 1
+//! \param    [out] pdwGne
+//!           2 * VPHAL_AUTO_DN_GNE_DWORDS dwords, slice 0 first
+//! \return   bool
+//!           true if a consistent copy was read, false if VEBOX kept writing
+//!
+static inline bool VpHal_ReadAutoDenoiseGne(
+    const volatile uint32_t *pGneSlice0,
+    const volatile uint32_t *pGneSlice1,
+    uint32_t                *pdwGne)
+{
+    for (uint32_t i = 0; i < VPHAL_AUTO_DN_GNE_DWORDS; i++)
+    {
+        pdwGne[i]                            = pGneSlice0[i];
+        pdwGne[VPHAL_AUTO_DN_GNE_DWORDS + i] = pGneSlice1[i];
+    }
+
+    for (uint32_t retry = 0; retry < VPHAL_AUTO_DN_GNE_READ_RETRIES; retry++)
+    {
+        bool bStable = true;
+        for (uint32_t i = 0; i < VPHAL_AUTO_DN_GNE_DWORDS; i++)
+        {
+            uint32_t dwValue0 = pGneSlice0[i];
+            uint32_t dwValue1 = pGneSlice1[i];
+            if (dwValue0 != pdwGne[i] || dwValue1 != pdwGne[VPHAL_AUTO_DN_GNE_DWORDS + i])
+            {
+                pdwGne[i]                            = dwValue0;
+                pdwGne[VPHAL_AUTO_DN_GNE_DWORDS + i] = dwValue1;
+                bStable                              = false;
+            }
+        }
+        if (bStable)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//!
+//! \brief    Filter the GNE statistics of one frame into the global noise levels
+//! \details  Recursive filter so that one noisy frame does not swing the DN
+//!           thresholds. The level of a plane without statistics is kept.
+//! \param    [in] pdwGne
+//!           GNE statistics of both slices, as read by VpHal_ReadAutoDenoiseGne
+//! \param    [in] bFirstFrame
+//!           true to restart the history from this frame
+//! \param    [in,out] pdwLevel
+//!           Luma, U and V global noise levels
+//!
+static inline void VpHal_FilterAutoDenoiseLevels(
+    const uint32_t  *pdwGne,
+    bool            bFirstFrame,
+    uint32_t        *pdwLevel)
+{
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        uint64_t qwSum   = (uint64_t)pdwGne[i * 2] + pdwGne[VPHAL_AUTO_DN_GNE_DWORDS + i * 2];
+        uint64_t qwCount = (uint64_t)pdwGne[i * 2 + 1] + pdwGne[VPHAL_AUTO_DN_GNE_DWORDS + i * 2 + 1];
+
+        if (qwCount == 0)
+        {
+            continue;
+        }
+
+        uint32_t dwLevel = (uint32_t)(qwSum / qwCount);
+        if (bFirstFrame)
+        {
+            pdwLevel[i] = dwLevel;
+        }
+        else
+        {
+            pdwLevel[i] = (uint32_t)(((uint64_t)pdwLevel[i] * VPHAL_AUTO_DN_GNE_HISTORY_WEIGHT + dwLevel) /
+                                     (VPHAL_AUTO_DN_GNE_HISTORY_WEIGHT + 1));
+        }
+    }
+}
+
+//!
+//! \brief    Map the global noise levels to denoise slider factors
+//! \details  The DN update kernel derives the DN thresholds from the noise
+//!           levels itself, its mapping is only shipped as a kernel binary.
+//!           The CPU update goes through the driver slider tables instead:
+//!           a level is the mean block noise estimate of GNE, and each slider
+//!           step raises the Gen9+ luma LTD and TD thresholds by one unit, so
+//!           the thresholds follow the noise level one to one from the slider
+//!           minimum. Levels past the strongest slider saturate at it. This
+//!           calibration was not matched against the kernel output, tune
+//!           VPHAL_AUTO_DN_LEVEL_PER_FACTOR when the kernel mapping is known.
+//! \param    [in] pdwLevel
+//!           Luma, U and V global noise levels
+//! \param    [in] dwFactorMax
+//!           Largest denoise slider factor
+//! \param    [out] pdwLumaFactor
+//!           Denoise factor for luma
+//! \param    [out] pdwChromaFactor
+//!           Denoise factor for chroma, from the noisier chroma plane
+//!
+static inline void VpHal_GetAutoDenoiseFactors(
+    const uint32_t  *pdwLevel,
+    uint32_t        dwFactorMax,
+    uint32_t        *pdwLumaFactor,
+    uint32_t        *pdwChromaFactor)
+{
+    uint32_t dwChromaLevel = (pdwLevel[1] > pdwLevel[2]) ? pdwLevel[1] : pdwLevel[2];
+
+    uint32_t dwLumaStep    = pdwLevel[0] / VPHAL_AUTO_DN_LEVEL_PER_FACTOR;
+    uint32_t dwChromaStep  = dwChromaLevel / VPHAL_AUTO_DN_LEVEL_PER_FACTOR;
+
+    *pdwLumaFactor   = (dwLumaStep < dwFactorMax) ? dwLumaStep : dwFactorMax;
+    *pdwChromaFactor = (dwChromaStep < dwFactorMax) ? dwChromaStep : dwFactorMax;
+}
+
+#endif // __VPHAL_RENDER_VEBOX_DENOISE_PARAMS_H__
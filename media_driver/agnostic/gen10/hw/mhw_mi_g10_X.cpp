@@ -62,7 +62,9 @@ MOS_STATUS MhwMiInterfaceG10::AddMiBatchBufferStartCmd(
     bool vcsEngineUsed =
         MOS_VCS_ENGINE_USED(m_osInterface->pfnGetGpuContext(m_osInterface));
 
-    mhw_mi_g10_X::MI_BATCH_BUFFER_START_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_mi_g10_X::MI_BATCH_BUFFER_START_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     MHW_RESOURCE_PARAMS                     resourceParams;
     MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
     resourceParams.presResource     = &batchBuffer->OsResource;
@@ -83,7 +85,7 @@ MOS_STATUS MhwMiInterfaceG10::AddMiBatchBufferStartCmd(
     cmd.DW0.AddressSpaceIndicator = !IsGlobalGttInUse();
 
     // Send BB start command
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -104,7 +106,9 @@ MOS_STATUS MhwMiInterfaceG10::AddMiConditionalBatchBufferEndCmd(
     //          but after end of conditional batch buffer CP will be re-enabled.
     MHW_MI_CHK_STATUS(m_cpInterface->AddEpilog(m_osInterface, cmdBuffer));
 
-    mhw_mi_g10_X::MI_CONDITIONAL_BATCH_BUFFER_END_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_mi_g10_X::MI_CONDITIONAL_BATCH_BUFFER_END_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     cmd.DW0.UseGlobalGtt        = IsGlobalGttInUse();
     cmd.DW0.CompareSemaphore    = 1; // CompareDataDword is always assumed to be set
     cmd.DW0.CompareMaskMode     = !params->bDisableCompareMask;
@@ -125,7 +129,7 @@ MOS_STATUS MhwMiInterfaceG10::AddMiConditionalBatchBufferEndCmd(
         &resourceParams));
 
     // Send Conditional Batch Buffer End command
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     //Re-enable CP for Case 2
     MHW_MI_CHK_STATUS(m_cpInterface->AddProlog(m_osInterface, cmdBuffer));
@@ -593,7 +593,9 @@ MOS_STATUS MhwVeboxInterfaceG10::AddVeboxState(
     MHW_RESOURCE_PARAMS        ResourceParams;
     MOS_ALLOC_GFXRES_PARAMS    AllocParamsForBufferLinear;
 
-    mhw_vebox_g10_X::VEBOX_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vebox_g10_X::VEBOX_STATE_CMD>(pCmdBuffer);
+    MHW_CHK_NULL_RETURN(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_CHK_NULL(m_osInterface);
     MHW_CHK_NULL(pCmdBuffer);
@@ -843,7 +845,7 @@ MOS_STATUS MhwVeboxInterfaceG10::AddVeboxState(
     cmd.DW18.BypassChromaUpsampling                    = pChromaSampling->BypassChromaUpsampling;
     cmd.DW18.BypassChromaDownsampling                  = pChromaSampling->BypassChromaDownsampling;
 
-    Mos_AddCommand(pCmdBuffer, &cmd, cmd.byteSize);
+    MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, &cmd));
 
 finish:
     return eStatus;
@@ -857,7 +859,9 @@ MOS_STATUS MhwVeboxInterfaceG10::AddVeboxDiIecp(
     PMOS_INTERFACE      pOsInterface;
     MHW_RESOURCE_PARAMS ResourceParams;
 
-    mhw_vebox_g10_X::VEB_DI_IECP_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vebox_g10_X::VEB_DI_IECP_CMD>(pCmdBuffer);
+    MHW_CHK_NULL_RETURN(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_CHK_NULL(m_osInterface);
     MHW_CHK_NULL(pCmdBuffer);
@@ -1058,7 +1062,7 @@ MOS_STATUS MhwVeboxInterfaceG10::AddVeboxDiIecp(
     cmd.DW1.EndingX   = pVeboxDiIecpCmdParams->dwEndingX;
     cmd.DW1.StartingX = pVeboxDiIecpCmdParams->dwStartingX;
 
-    Mos_AddCommand(pCmdBuffer, &cmd, cmd.byteSize);
+    MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, &cmd));
 
 finish:
     return eStatus;
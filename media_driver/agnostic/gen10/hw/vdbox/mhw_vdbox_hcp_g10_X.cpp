@@ -998,7 +998,9 @@ MOS_STATUS MhwVdboxHcpInterfaceG10::AddHcpPipeBufAddrCmd(
 
     MHW_RESOURCE_PARAMS                              resourceParams;
     MOS_SURFACE                                      details;
-    mhw_vdbox_hcp_g10_X::HCP_PIPE_BUF_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g10_X::HCP_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
 
@@ -1560,7 +1562,7 @@ MOS_STATUS MhwVdboxHcpInterfaceG10::AddHcpPipeBufAddrCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -1576,7 +1578,9 @@ MOS_STATUS MhwVdboxHcpInterfaceG10::AddHcpIndObjBaseAddrCmd(
     MHW_MI_CHK_NULL(params);
 
     MHW_RESOURCE_PARAMS resourceParams;
-    mhw_vdbox_hcp_g10_X::HCP_IND_OBJ_BASE_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g10_X::HCP_IND_OBJ_BASE_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
     resourceParams.dwLsbNum = MHW_VDBOX_HCP_UPPER_BOUND_STATE_SHIFT;
@@ -1727,7 +1731,7 @@ MOS_STATUS MhwVdboxHcpInterfaceG10::AddHcpIndObjBaseAddrCmd(
         }
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2584,7 +2588,9 @@ MOS_STATUS MhwVdboxHcpInterfaceG10::AddHcpHevcVp9RdoqStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->pHevcEncSeqParams);
 
-    mhw_vdbox_hcp_g10_X::HEVC_VP9_RDOQ_STATE_CMD    cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g10_X::HEVC_VP9_RDOQ_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     uint16_t                                        lambdaTab[2][2][64];
 
     MHW_MI_CHK_NULL(params->pHevcEncPicParams);
@@ -2654,7 +2660,7 @@ MOS_STATUS MhwVdboxHcpInterfaceG10::AddHcpHevcVp9RdoqStateCmd(
         cmd.Interchromalambda[i].DW0.Lambdavalue1 = lambdaTab[1][1][i * 2 + 1];
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -234,7 +234,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencPipeModeSelectCmd(
     MHW_MI_CHK_NULL(cmdBuffer);
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_vdenc_g10_X::VDENC_PIPE_MODE_SELECT_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g10_X::VDENC_PIPE_MODE_SELECT_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     cmd.DW1.StandardSelect                 = CodecHal_GetStandardFromMode(params->Mode);
     cmd.DW1.FrameStatisticsStreamOutEnable = 1;     // PAK Pipeline Streamout Enable
@@ -251,7 +253,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencPipeModeSelectCmd(
     }
     cmd.DW1.BitDepth = params->ucVdencBitDepthMinus8;
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -268,7 +270,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencPipeBufAddrCmd(
     MHW_MI_CHK_NULL(cmdBuffer);
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_vdenc_g10_X::VDENC_PIPE_BUF_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g10_X::VDENC_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MOS_MEMCOMP_STATE   mmcMode = MOS_MEMCOMP_DISABLED;
     MHW_RESOURCE_PARAMS resourceParams;
@@ -761,7 +765,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencPipeBufAddrCmd(
     // Hence it's a dummy CL for us. Histogram stats start from 4th CL onwards.
     cmd.DW61.WeightsHistogramStreamoutOffset = 3 * MHW_CACHELINE_SIZE;
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -776,7 +780,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencSrcSurfaceStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->psSurface);
 
-    mhw_vdbox_vdenc_g10_X::VDENC_SRC_SURFACE_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g10_X::VDENC_SRC_SURFACE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     cmd.Dwords25.DW0.Width               = params->dwActualWidth - 1;
     cmd.Dwords25.DW0.Height              = params->dwActualHeight - 1;
@@ -803,7 +809,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencSrcSurfaceStateCmd(
     cmd.Dwords25.DW2.YOffsetForUCb = cmd.Dwords25.DW3.YOffsetForVCr =
         MOS_ALIGN_CEIL(params->psSurface->UPlaneOffset.iYOffset, MHW_VDBOX_MFX_RAW_UV_PLANE_ALIGNMENT_GEN9);
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -818,7 +824,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencRefSurfaceStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->psSurface);
 
-    mhw_vdbox_vdenc_g10_X::VDENC_REF_SURFACE_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g10_X::VDENC_REF_SURFACE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     if (params->Mode == CODECHAL_ENCODE_MODE_HEVC)
     {
@@ -850,7 +858,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencRefSurfaceStateCmd(
     cmd.Dwords25.DW1.SurfacePitch     = params->psSurface->dwPitch - 1;
     cmd.Dwords25.DW2.YOffsetForUCb    = cmd.Dwords25.DW3.YOffsetForVCr = params->psSurface->UPlaneOffset.iYOffset;
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -866,7 +874,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencDsRefSurfaceStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->psSurface);
 
-    mhw_vdbox_vdenc_g10_X::VDENC_DS_REF_SURFACE_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g10_X::VDENC_DS_REF_SURFACE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     if (params->Mode == CODECHAL_ENCODE_MODE_HEVC)
     {
@@ -925,7 +935,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencDsRefSurfaceStateCmd(
         cmd.Dwords69.DW2.YOffsetForUCb    = cmd.Dwords69.DW3.YOffsetForVCr = params->psSurface->UPlaneOffset.iYOffset;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -1157,7 +1167,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencWalkerStateCmd(
     MHW_MI_CHK_NULL(cmdBuffer);
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_vdenc_g10_X::VDENC_WALKER_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g10_X::VDENC_WALKER_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     if (params->Mode == CODECHAL_ENCODE_MODE_AVC)
     {
@@ -1206,7 +1218,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencWalkerStateCmd(
         cmd.DW5.TileWidth                    = vp9PicParams->SrcFrameWidthMinus1;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -1221,7 +1233,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencAvcWeightsOffsetsStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->pAvcPicParams);
 
-    mhw_vdbox_vdenc_g10_X::VDENC_WEIGHTSOFFSETS_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g10_X::VDENC_WEIGHTSOFFSETS_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     auto avcPicParams = params->pAvcPicParams;
 
@@ -1245,7 +1259,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG10::AddVdencAvcWeightsOffsetsStateCmd(
         cmd.DW2.OffsetForwardReference2  = 0;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -661,6 +661,13 @@ MOS_STATUS VPHAL_VEBOX_STATE_G10_BASE::AllocateResources()
                   MOS_ROUNDUP_DIVIDE(VPHAL_VEBOX_STATISTICS_SIZE_G10 * sizeof(uint32_t), dwWidth);
     dwSize      = dwWidth * dwHeight;
 
+    // The statistics surface is reallocated when its size changes, release the
+    // CPU auto DN mapping of the current one first
+    if (pVeboxState->VeboxStatisticsSurface.dwWidth != dwSize)
+    {
+        pVeboxState->VeboxUnlockStatisticsSurface();
+    }
+
     VPHAL_RENDER_CHK_STATUS(VpHal_ReAllocateSurface(
                 pOsInterface,
                 &pVeboxState->VeboxStatisticsSurface,
@@ -790,6 +797,7 @@ void VPHAL_VEBOX_STATE_G10_BASE::FreeResources()
     }
 
     // Free Statistics data surface for VEBOX
+    pVeboxState->VeboxUnlockStatisticsSurface();
     pOsInterface->pfnFreeResource(
         pOsInterface,
         &pVeboxState->VeboxStatisticsSurface.OsResource);
@@ -1281,6 +1289,9 @@ MOS_STATUS VPHAL_VEBOX_STATE_G10_BASE::SetDNParams(
     MOS_STATUS                       eStatus;
     PVPHAL_DENOISE_PARAMS            pDNParams;
     uint32_t                         dwDenoiseFactor;
+    uint32_t                         dwLumaFactor;
+    uint32_t                         dwChromaFactor;
+    bool                             bDenoiseSlider;
     PVPHAL_VEBOX_RENDER_DATA         pRenderData = GetLastExecRenderData();
 
     VPHAL_RENDER_ASSERT(pSrcSurface);
@@ -1291,6 +1302,11 @@ MOS_STATUS VPHAL_VEBOX_STATE_G10_BASE::SetDNParams(
     eStatus             = MOS_STATUS_SUCCESS;
     pDNParams           = pSrcSurface->pDenoiseParams;
 
+    // Slider factors from the application, or from the CPU auto DN update
+    dwLumaFactor   = NOISEFACTOR_MIN;
+    dwChromaFactor = NOISEFACTOR_MIN;
+    bDenoiseSlider = VeboxGetDenoiseSliderFactors(pDNParams, &dwLumaFactor, &dwChromaFactor);
+
     // Set Luma DN params
     if (pRenderData->bDenoise)
     {
@@ -1313,15 +1329,10 @@ MOS_STATUS VPHAL_VEBOX_STATE_G10_BASE::SetDNParams(
         pRenderData->VeboxDNDIParams.dwPixRangeWeight[4]    = NOISE_BLF_RANGE_WGTS4_DEFAULT;
         pRenderData->VeboxDNDIParams.dwPixRangeWeight[5]    = NOISE_BLF_RANGE_WGTS5_DEFAULT;
 
-        // User specified Denoise strength case (no auto DN detect)
-        if (!pDNParams->bAutoDetect)
+        // User specified Denoise strength case, or auto DN detect updated on the CPU
+        if (bDenoiseSlider)
         {
-            dwDenoiseFactor = (uint32_t)pDNParams->fDenoiseFactor;
-
-            if (dwDenoiseFactor > NOISEFACTOR_MAX)
-            {
-                dwDenoiseFactor = NOISEFACTOR_MAX;
-            }
+            dwDenoiseFactor = dwLumaFactor;
 
             pLumaParams->dwDenoiseHistoryDelta   = dwDenoiseHistoryDelta[dwDenoiseFactor];
             pLumaParams->dwDenoiseMaximumHistory = dwDenoiseMaximumHistory[dwDenoiseFactor];
@@ -1355,15 +1366,10 @@ MOS_STATUS VPHAL_VEBOX_STATE_G10_BASE::SetDNParams(
         pChromaParams->dwHistoryDeltaUV = NOISE_HISTORY_DELTA_DEFAULT;
         pChromaParams->dwHistoryMaxUV   = NOISE_HISTORY_MAX_DEFAULT;
 
-        // Denoise Slider case (no auto DN detect)
-        if (!pDNParams->bAutoDetect)
+        // Denoise Slider case, or auto DN detect updated on the CPU
+        if (bDenoiseSlider)
         {
-            dwDenoiseFactor = (uint32_t)pDNParams->fDenoiseFactor;
-
-            if (dwDenoiseFactor > NOISEFACTOR_MAX)
-            {
-                dwDenoiseFactor = NOISEFACTOR_MAX;
-            }
+            dwDenoiseFactor = dwChromaFactor;
 
             pChromaParams->dwLTDThresholdU  =
             pChromaParams->dwLTDThresholdV  = dwLTDThresholdUV[dwDenoiseFactor];
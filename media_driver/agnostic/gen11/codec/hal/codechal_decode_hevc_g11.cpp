@@ -889,6 +889,12 @@ MOS_STATUS CodechalDecodeHevcG11::InitPicLongFormatMhwParams()
     return eStatus;
 }
 
+bool CodechalDecodeHevcG11::IsPicTemplateAllowed()
+{
+    return !CodecHalDecodeScalabilityIsScalableMode(m_scalabilityState) &&
+        CodechalDecodeHevc::IsPicTemplateAllowed();
+}
+
 MOS_STATUS CodechalDecodeHevcG11::SendPictureLongFormat()
 {
     MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
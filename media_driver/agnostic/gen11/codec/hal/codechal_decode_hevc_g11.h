@@ -149,6 +149,15 @@ public:
     //!
     MOS_STATUS  InitPicLongFormatMhwParams() override;
 
+    //!
+    //! \brief    Check if the picture level commands can be replayed from a template
+    //! \details  Scalable mode programs different commands for each pipe
+    //!
+    //! \return   bool
+    //!           true if the template can be used for the current picture
+    //!
+    bool IsPicTemplateAllowed() override;
+
     //!
     //! \brief    Send long format picture level commands
     //! \details  Send long format picture level commands in HEVC decode driver
@@ -171,8 +171,12 @@ MOS_STATUS CodechalDecodeJpegG11::DecodeStateLevel()
         &cmdBuffer,
         0));
 
-    CODECHAL_DECODE_CHK_STATUS_RETURN(SendPrologWithFrameTracking(
-        &cmdBuffer, true));
+    // Send command buffer header at the beginning, once for the pictures of a batch
+    if (IsFirstPictureInBatch())
+    {
+        CODECHAL_DECODE_CHK_STATUS_RETURN(SendPrologWithFrameTracking(
+            &cmdBuffer, true));
+    }
 
     // Set PIPE_MODE_SELECT
     MHW_VDBOX_PIPE_MODE_SELECT_PARAMS pipeModeSelectParams;
@@ -464,6 +468,14 @@ MOS_STATUS CodechalDecodeJpegG11::DecodePrimitiveLevel()
             &cmdBuffer));
     }
 
+    // The next picture of a batch continues this command buffer
+    if (!IsLastPictureInBatch())
+    {
+        m_osInterface->pfnReturnCommandBuffer(m_osInterface, &cmdBuffer, 0);
+        SetOutputSurfaceLayout(&m_decodeParams.m_outputSurfLayout);
+        return eStatus;
+    }
+
     CODECHAL_DECODE_CHK_STATUS_RETURN(m_miInterface->AddMiBatchBufferEnd(
         &cmdBuffer,
         nullptr));
@@ -5010,11 +5010,10 @@ MOS_STATUS CodechalEncodeAvcEncG11::ExecuteKernelFunctions()
 
     m_swScoreboardState->SetCurSwScoreboardSurfaceIndex(swScoreboardKernelParames.surfaceIndex);
 
-    // Only called if current pattern was not initialized before
-    if (Mos_ResourceIsNull(&m_swScoreboardState->GetCurSwScoreboardSurface()->OsResource))
-    {
-        swScoreboardInitNeeded = true;
-    }
+    swScoreboardKernelParames.scoreboardWidth           = m_picWidthInMb;
+    swScoreboardKernelParames.scoreboardHeight          = m_frameFieldHeightInMb;
+    swScoreboardKernelParames.swScoreboardSurfaceWidth  = swScoreboardKernelParames.scoreboardWidth * 4;
+    swScoreboardKernelParames.swScoreboardSurfaceHeight = swScoreboardKernelParames.scoreboardHeight;
 
     // BRC init/reset needs to be called before HME since it will reset the Brc Distortion surface
     if (bBrcEnabled && (bBrcInit || bBrcReset))
@@ -5113,11 +5112,6 @@ MOS_STATUS CodechalEncodeAvcEncG11::ExecuteKernelFunctions()
     {
         // Call SW scoreboard Init kernel
         m_lastTaskInPhase = true;
-        swScoreboardKernelParames.scoreboardWidth           = m_picWidthInMb;
-        swScoreboardKernelParames.scoreboardHeight          = m_frameFieldHeightInMb;
-        swScoreboardKernelParames.swScoreboardSurfaceWidth  = swScoreboardKernelParames.scoreboardWidth * 4;
-        swScoreboardKernelParames.swScoreboardSurfaceHeight = swScoreboardKernelParames.scoreboardHeight;
-
         CODECHAL_ENCODE_CHK_STATUS_RETURN(m_swScoreboardState->Execute(&swScoreboardKernelParames));
     }
 
@@ -105,11 +105,6 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
     MOS_COMMAND_BUFFER cmdBuffer;
     CODECHAL_ENCODE_CHK_STATUS_RETURN(m_osInterface->pfnGetCommandBuffer(m_osInterface, &cmdBuffer, 0));
 
-    if (m_encodeParams.dwNumSlices != 1)
-    {
-        CODECHAL_ENCODE_ASSERTMESSAGE("JPEG encode only one scan is supported.");
-    }
-
     MOS_SURFACE *surface = &m_rawSurface;
 
     bool useSingleDefaultQuantTable = (m_jpegQuantMatrixSent == false &&
@@ -118,168 +113,91 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
             (surface->Format == Format_A8B8G8R8) ||
             (surface->Format == Format_X8B8G8R8)));
 
-    CodecJpegQuantMatrix *tempJpegQuantMatrix = (CodecJpegQuantMatrix *)MOS_AllocAndZeroMemory(sizeof(CodecJpegQuantMatrix));
-    CODECHAL_ENCODE_CHK_NULL_RETURN(tempJpegQuantMatrix);
-
     uint32_t numQuantTables = JPEG_MAX_NUM_QUANT_TABLE_INDEX;
-    for (uint32_t scanCount = 0; scanCount < m_encodeParams.dwNumSlices; scanCount++)
+
+    // For monochrome inputs there will be only 1 quantization table and huffman table sent
+    if (m_jpegPicParams->m_inputSurfaceFormat == codechalJpegY8)
     {
-        MHW_VDBOX_QM_PARAMS fqmParams;
-        MOS_ZeroMemory(&fqmParams, sizeof(fqmParams));
+        m_encodeParams.dwNumHuffBuffers = 2; //for Y8 only 2 huff tables
+    }
 
-        // set MFX_FQM_STATE
-        fqmParams.pJpegQuantMatrix = tempJpegQuantMatrix;
+    // The tables of the frame are shared by its scans
+    // set MFX_FQM_STATE
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(SetQuantTableState(useSingleDefaultQuantTable, numQuantTables));
 
-        // For monochrome inputs there will be only 1 quantization table and huffman table sent
-        if (m_jpegPicParams->m_inputSurfaceFormat == codechalJpegY8)
-        {
-            numQuantTables = 1;
-            m_encodeParams.dwNumHuffBuffers = 2; //for Y8 only 2 huff tables
-        }
-        // If there is only 1 quantization table copy over the table to 2nd and 3rd table in JPEG state (used for frame header)
-        // OR For RGB input surfaces, if the app does not send quantization tables, then use luma quant table for all 3 components
-        else if (m_jpegPicParams->m_numQuantTable == 1 || useSingleDefaultQuantTable)
-        {
-            for (auto i = 1; i < JPEG_MAX_NUM_QUANT_TABLE_INDEX; i++)
-            {
-                m_jpegQuantTables->m_quantTable[i].m_precision = m_jpegQuantTables->m_quantTable[0].m_precision;
-                m_jpegQuantTables->m_quantTable[i].m_tableID = m_jpegQuantTables->m_quantTable[0].m_tableID;
+    MHW_VDBOX_QM_PARAMS fqmParams;
+    MOS_ZeroMemory(&fqmParams, sizeof(fqmParams));
+    fqmParams.pJpegQuantMatrix = &m_quantTableState.m_quantMatrix;
 
-                eStatus = MOS_SecureMemcpy(&m_jpegQuantTables->m_quantTable[i].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t),
-                    &m_jpegQuantTables->m_quantTable[0].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t));
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
-                    return eStatus;
-                }
-            }
-        }
-        // If there are 2 quantization tables copy over the second table to 3rd table in JPEG state since U and V share the same table (used for frame header)
-        else if (m_jpegPicParams->m_numQuantTable == 2)
-        {
-            m_jpegQuantTables->m_quantTable[2].m_precision = m_jpegQuantTables->m_quantTable[1].m_precision;
-            m_jpegQuantTables->m_quantTable[2].m_tableID = m_jpegQuantTables->m_quantTable[1].m_tableID;
-
-            eStatus = MOS_SecureMemcpy(&m_jpegQuantTables->m_quantTable[2].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t),
-                &m_jpegQuantTables->m_quantTable[1].m_qm[0], JPEG_NUM_QUANTMATRIX * sizeof(uint16_t));
-            if (eStatus != MOS_STATUS_SUCCESS)
-            {
-                CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
-                return eStatus;
-            }
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxJpegFqmCmd(&cmdBuffer, &fqmParams, numQuantTables));
 
-        }
-        // else 3 quantization tables are sent by the application for non monochrome input formats. In that case, do nothing.
-
-        for (uint32_t i = 0; i < numQuantTables; i++)
-        {
-            fqmParams.pJpegQuantMatrix->m_jpegQMTableType[i] = m_jpegQuantTables->m_quantTable[i].m_tableID; // Used to distinguish between Y,U,V quantization tables for the same scan
+    // set MFC_JPEG_HUFF_TABLE - Convert encoded huffman table to actual table for HW
+    CODECHAL_ENCODE_CHK_STATUS_RETURN(SetHuffTableState());
+    MHW_VDBOX_ENCODE_HUFF_TABLE_PARAMS *huffTableParams = m_huffTableState.m_huffTableParams;
 
-            for (auto j = 0; j < JPEG_NUM_QUANTMATRIX; j++)
-            {
-                uint32_t k = jpeg_qm_scan_8x8[j];
-
-                // copy over Quant matrix in raster order from zig zag
-                fqmParams.pJpegQuantMatrix->m_quantMatrix[i][k] = (uint8_t)m_jpegQuantTables->m_quantTable[i].m_qm[j];
-            }
-        }
-
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxJpegFqmCmd(&cmdBuffer, &fqmParams, numQuantTables));
+    // Send 2 huffman table commands - 1 for Luma and one for chroma for non-monchrome input formats
+    // If only one table is sent by the app (2 buffers), send the same table for Luma and chroma
+    bool repeatHuffTable = false;
+    if ((m_encodeParams.dwNumHuffBuffers / 2 < JPEG_MAX_NUM_HUFF_TABLE_INDEX)
+        && (m_jpegPicParams->m_inputSurfaceFormat != codechalJpegY8))
+    {
+        repeatHuffTable = true;
 
-        // set MFC_JPEG_HUFF_TABLE - Convert encoded huffman table to actual table for HW
-        // We need a different params struct for JPEG Encode Huffman table because JPEG decode huffman table has Bits and codes,
-        // whereas JPEG encode huffman table has huffman code lengths and values
-        MHW_VDBOX_ENCODE_HUFF_TABLE_PARAMS   huffTableParams[JPEG_MAX_NUM_HUFF_TABLE_INDEX];
+        // Copy over huffman data to the other two data buffers for JPEG picture header
         for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers; i++)
         {
-            CodechalEncodeJpegHuffTable huffmanTable;// intermediate table for each AC/DC component which will be copied to huffTableParams
-            MOS_ZeroMemory(&huffmanTable, sizeof(huffmanTable));
+            m_jpegHuffmanTable->m_huffmanData[i + 2].m_tableClass = m_jpegHuffmanTable->m_huffmanData[i].m_tableClass;
+            m_jpegHuffmanTable->m_huffmanData[i + 2].m_tableID = m_jpegHuffmanTable->m_huffmanData[i].m_tableID;
 
-            CODECHAL_ENCODE_CHK_STATUS_RETURN(ConvertHuffDataToTable(m_jpegHuffmanTable->m_huffmanData[i], &huffmanTable));
-
-            huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].HuffTableID = m_jpegHuffmanTable->m_huffmanData[i].m_tableID;
-
-            if (m_jpegHuffmanTable->m_huffmanData[i].m_tableClass == 0) // DC table
-            {
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(
-                    huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].pDCCodeValues,
-                    JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint16_t),
-                    &huffmanTable.m_huffCode,
-                    JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint16_t)));
-
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].pDCCodeLength,
-                    JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint8_t),
-                    &huffmanTable.m_huffSize,
-                    JPEG_NUM_HUFF_TABLE_DC_HUFFVAL * sizeof(uint8_t)));
-            }
-            else // AC Table
+            eStatus = MOS_SecureMemcpy(&m_jpegHuffmanTable->m_huffmanData[i + 2].m_bits[0],
+                sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_BITS,
+                &m_jpegHuffmanTable->m_huffmanData[i].m_bits[0],
+                sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_BITS);
+            if (eStatus != MOS_STATUS_SUCCESS)
             {
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].pACCodeValues,
-                    JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint16_t),
-                    &huffmanTable.m_huffCode,
-                    JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint16_t)));
-
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(MOS_SecureMemcpy(huffTableParams[m_jpegHuffmanTable->m_huffmanData[i].m_tableID].pACCodeLength,
-                    JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint8_t),
-                    &huffmanTable.m_huffSize,
-                    JPEG_NUM_HUFF_TABLE_AC_HUFFVAL * sizeof(uint8_t)));
+                CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
+                return eStatus;
             }
-        }
-
-        // Send 2 huffman table commands - 1 for Luma and one for chroma for non-monchrome input formats
-        // If only one table is sent by the app (2 buffers), send the same table for Luma and chroma
-        bool repeatHuffTable = false;
-        if ((m_encodeParams.dwNumHuffBuffers / 2 < JPEG_MAX_NUM_HUFF_TABLE_INDEX)
-            && (m_jpegPicParams->m_inputSurfaceFormat != codechalJpegY8))
-        {
-            repeatHuffTable = true;
 
-            // Copy over huffman data to the other two data buffers for JPEG picture header
-            for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers; i++)
+            eStatus = MOS_SecureMemcpy(&m_jpegHuffmanTable->m_huffmanData[i + 2].m_huffVal[0],
+                sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_HUFFVAL,
+                &m_jpegHuffmanTable->m_huffmanData[i].m_huffVal[0],
+                sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_HUFFVAL);
+            if (eStatus != MOS_STATUS_SUCCESS)
             {
-                m_jpegHuffmanTable->m_huffmanData[i + 2].m_tableClass = m_jpegHuffmanTable->m_huffmanData[i].m_tableClass;
-                m_jpegHuffmanTable->m_huffmanData[i + 2].m_tableID = m_jpegHuffmanTable->m_huffmanData[i].m_tableID;
-
-                eStatus = MOS_SecureMemcpy(&m_jpegHuffmanTable->m_huffmanData[i + 2].m_bits[0],
-                    sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_BITS,
-                    &m_jpegHuffmanTable->m_huffmanData[i].m_bits[0],
-                    sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_BITS);
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
-                    return eStatus;
-                }
-
-                eStatus = MOS_SecureMemcpy(&m_jpegHuffmanTable->m_huffmanData[i + 2].m_huffVal[0],
-                    sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_HUFFVAL,
-                    &m_jpegHuffmanTable->m_huffmanData[i].m_huffVal[0],
-                    sizeof(uint8_t) * JPEG_NUM_HUFF_TABLE_AC_HUFFVAL);
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
-                    return eStatus;
-                }
+                CODECHAL_ENCODE_ASSERTMESSAGE("Failed to copy memory.");
+                return eStatus;
             }
         }
+    }
 
-        // the number of huffman commands is half of the huffman buffers sent by the app, since AC and DC buffers are combined into one command
-        for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers / 2; i++)
+    // the number of huffman commands is half of the huffman buffers sent by the app, since AC and DC buffers are combined into one command
+    for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers / 2; i++)
+    {
+        if (repeatHuffTable)
         {
-            if (repeatHuffTable)
-            {
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfcJpegHuffTableStateCmd(&cmdBuffer, &huffTableParams[i]));
-            }
-
             CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfcJpegHuffTableStateCmd(&cmdBuffer, &huffTableParams[i]));
         }
 
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfcJpegHuffTableStateCmd(&cmdBuffer, &huffTableParams[i]));
+    }
+
+    for (uint32_t scanCount = 0; scanCount < m_encodeParams.dwNumSlices; scanCount++)
+    {
+        CodecEncodeJpegScanHeader *scanParams = &m_jpegScanParams[scanCount];
+        bool firstScan = (scanCount == 0);
+        bool lastScan  = (scanCount + 1 == m_encodeParams.dwNumSlices);
+
         // set MFC_JPEG_SCAN_OBJECT
         MhwVdboxJpegScanParams scanObjectParams;
+        MOS_ZeroMemory(&scanObjectParams, sizeof(scanObjectParams));
         scanObjectParams.mode = m_mode;
         scanObjectParams.inputSurfaceFormat = (CodecEncodeJpegInputSurfaceFormat)m_jpegPicParams->m_inputSurfaceFormat;
         scanObjectParams.dwPicWidth = m_jpegPicParams->m_picWidth;
         scanObjectParams.dwPicHeight = m_jpegPicParams->m_picHeight;
-        scanObjectParams.pJpegEncodeScanParams = m_jpegScanParams;
+        scanObjectParams.pJpegEncodeScanParams = scanParams;
+        scanObjectParams.dwMcuCount = GetScanMcuCount(scanParams);
+        scanObjectParams.isLastScan = lastScan;
 
         CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfcJpegScanObjCmd(&cmdBuffer, &scanObjectParams));
 
@@ -291,7 +209,8 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
         pakInsertObjectParams.pBsBuffer = (BSBuffer *)MOS_AllocAndZeroMemory(sizeof(CodechalEncodeJpegFrameHeader));
         CODECHAL_ENCODE_CHK_NULL_RETURN(pakInsertObjectParams.pBsBuffer);
 
-        if(!m_fullHeaderInAppData)
+        // The frame headers precede the first scan
+        if (firstScan && !m_fullHeaderInAppData)
         {
             // Add SOI (0xFFD8) (only if it was sent by the application)
             CODECHAL_ENCODE_CHK_STATUS_RETURN(PackSOI(pakInsertObjectParams.pBsBuffer));
@@ -305,7 +224,7 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
         }
 
         // Add Application data if it was sent by application
-        if (m_applicationData != nullptr)
+        if (firstScan && m_applicationData != nullptr)
         {
             uint8_t* appDataChunk = nullptr;
             uint32_t appDataChunkSize = m_appDataSize;
@@ -380,47 +299,19 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
             MOS_FreeMemory(appDataChunk);
         }
 
-        if(!m_fullHeaderInAppData)
+        if (firstScan && !m_fullHeaderInAppData)
         {
-        // Add Quant Table for Y
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(PackQuantTable(pakInsertObjectParams.pBsBuffer, jpegComponentY));
-
-        pakInsertObjectParams.dwOffset = 0;
-        pakInsertObjectParams.dwBitSize = pakInsertObjectParams.pBsBuffer->BufferSize;
-        pakInsertObjectParams.bLastHeader = false;
-        pakInsertObjectParams.bEndOfSlice = false;
-        pakInsertObjectParams.bResetBitstreamStartingPos = 1; // from discussion with HW Architect
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
-            &pakInsertObjectParams));
-        MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
-
-        if (!useSingleDefaultQuantTable)
+        // Add Quant Table for Y, and for U and V unless a single table is used or the format is monochrome
+        for (uint32_t i = 0; i < m_quantTableState.m_numHeaders; i++)
         {
-            // Since there is no U and V in monochrome format, donot add Quantization table header for U and V components
-            if (m_jpegPicParams->m_inputSurfaceFormat != codechalJpegY8)
-            {
-                // Add quant table for U
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(PackQuantTable(pakInsertObjectParams.pBsBuffer, jpegComponentU));
-                pakInsertObjectParams.dwOffset = 0;
-                pakInsertObjectParams.dwBitSize = pakInsertObjectParams.pBsBuffer->BufferSize;
-                pakInsertObjectParams.bLastHeader = false;
-                pakInsertObjectParams.bEndOfSlice = false;
-                pakInsertObjectParams.bResetBitstreamStartingPos = 1; // from discussion with HW Architect
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
-                    &pakInsertObjectParams));
-                MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
-
-                // Add quant table for V
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(PackQuantTable(pakInsertObjectParams.pBsBuffer, jpegComponentV));
-                pakInsertObjectParams.dwOffset = 0;
-                pakInsertObjectParams.dwBitSize = pakInsertObjectParams.pBsBuffer->BufferSize;
-                pakInsertObjectParams.bLastHeader = false;
-                pakInsertObjectParams.bEndOfSlice = false;
-                pakInsertObjectParams.bResetBitstreamStartingPos = 1; // from discussion with HW Architect
-                CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
-                    &pakInsertObjectParams));
-                MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
-            }
+            SetPackedHeader(pakInsertObjectParams.pBsBuffer, &m_quantTableState.m_headers[i], m_quantTableState.m_headerBitSize[i]);
+            pakInsertObjectParams.dwOffset                      = 0;
+            pakInsertObjectParams.dwBitSize                     = pakInsertObjectParams.pBsBuffer->BufferSize;
+            pakInsertObjectParams.bLastHeader                   = false;
+            pakInsertObjectParams.bEndOfSlice                   = false;
+            pakInsertObjectParams.bResetBitstreamStartingPos    = 1; // from discussion with HW Architect
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
+                &pakInsertObjectParams));
         }
 
         // Add Frame Header
@@ -437,7 +328,7 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
         // Add Huffman Table for Y - DC table, Y- AC table, U/V - DC table, U/V - AC table
         for (uint32_t i = 0; i < m_encodeParams.dwNumHuffBuffers; i++)
         {
-            CODECHAL_ENCODE_CHK_STATUS_RETURN(PackHuffmanTable(pakInsertObjectParams.pBsBuffer, i));
+            SetPackedHeader(pakInsertObjectParams.pBsBuffer, &m_huffTableState.m_headers[i], m_huffTableState.m_headerBitSize[i]);
             pakInsertObjectParams.dwOffset = 0;
             pakInsertObjectParams.dwBitSize = pakInsertObjectParams.pBsBuffer->BufferSize;
             pakInsertObjectParams.bLastHeader = false;
@@ -445,13 +336,16 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
             pakInsertObjectParams.bResetBitstreamStartingPos = 1; // from discussion with HW Architect
             CODECHAL_ENCODE_CHK_STATUS_RETURN(m_mfxInterface->AddMfxPakInsertObject(&cmdBuffer, nullptr,
                 &pakInsertObjectParams));
-            MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
+        }
         }
 
-        // Restart Interval - Add only if the restart interval is not zero
-        if (m_jpegScanParams->m_restartInterval != 0)
+        if (!m_fullHeaderInAppData)
         {
-            CODECHAL_ENCODE_CHK_STATUS_RETURN(PackRestartInterval(pakInsertObjectParams.pBsBuffer));
+        // Restart Interval - Add only if the restart interval is not zero, or if it changes between scans
+        if ((firstScan && scanParams->m_restartInterval != 0) ||
+            (!firstScan && scanParams->m_restartInterval != m_jpegScanParams[scanCount - 1].m_restartInterval))
+        {
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(PackRestartInterval(pakInsertObjectParams.pBsBuffer, scanParams));
             pakInsertObjectParams.dwOffset = 0;
             pakInsertObjectParams.dwBitSize = pakInsertObjectParams.pBsBuffer->BufferSize;
             pakInsertObjectParams.bLastHeader = false;
@@ -463,7 +357,7 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
         }
 
         // Add scan header
-        CODECHAL_ENCODE_CHK_STATUS_RETURN(PackScanHeader(pakInsertObjectParams.pBsBuffer));
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(PackScanHeader(pakInsertObjectParams.pBsBuffer, scanParams));
         pakInsertObjectParams.dwOffset = 0;
         pakInsertObjectParams.dwBitSize = pakInsertObjectParams.pBsBuffer->BufferSize;
         pakInsertObjectParams.bLastHeader = true;
@@ -474,12 +368,25 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
         MOS_FreeMemory(pakInsertObjectParams.pBsBuffer->pBase);
         }
         MOS_FreeMemory(pakInsertObjectParams.pBsBuffer);
+
+        // The status report gives where each scan ends
+        if (!lastScan)
+        {
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(ReadScanStatus(&cmdBuffer, scanCount));
+        }
     }
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(ReadMfcStatus(&cmdBuffer));
 
     CODECHAL_ENCODE_CHK_STATUS_RETURN(EndStatusReport(&cmdBuffer, CODECHAL_NUM_MEDIA_STATES));
 
+    // The next picture of a batch continues this command buffer
+    if (!IsLastPictureInBatch())
+    {
+        m_osInterface->pfnReturnCommandBuffer(m_osInterface, &cmdBuffer, 0);
+        return eStatus;
+    }
+
     CODECHAL_ENCODE_CHK_STATUS_RETURN(m_miInterface->AddMiBatchBufferEnd(&cmdBuffer, nullptr));
 
     std::string pakPassName = "PAK_PASS" + std::to_string(static_cast<uint32_t>(m_currPass));
@@ -499,12 +406,6 @@ MOS_STATUS CodechalEncodeJpegStateG11::ExecuteSliceLevel()
     CODECHAL_ENCODE_CHK_STATUS_RETURN(SetAndPopulateVEHintParams(&cmdBuffer));
     CODECHAL_ENCODE_CHK_STATUS_RETURN(m_osInterface->pfnSubmitCommandBuffer(m_osInterface, &cmdBuffer, m_renderContextUsesNullHw));
 
-    if (tempJpegQuantMatrix != nullptr)
-    {
-        MOS_FreeMemory(tempJpegQuantMatrix);
-        tempJpegQuantMatrix = nullptr;
-    }
-
     return eStatus;
 }
 
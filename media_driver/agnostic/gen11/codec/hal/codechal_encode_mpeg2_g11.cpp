@@ -1987,15 +1987,12 @@ MOS_STATUS CodechalEncodeMpeg2G11::ExecuteKernelFunctions()
 
         m_swScoreboardState->SetCurSwScoreboardSurfaceIndex(swScoreboardKernelParames.surfaceIndex);
 
-        if (Mos_ResourceIsNull(&m_swScoreboardState->GetCurSwScoreboardSurface()->OsResource))
-        {
-            swScoreboardKernelParames.scoreboardWidth           = m_picWidthInMb;
-            swScoreboardKernelParames.scoreboardHeight          = m_frameFieldHeightInMb;
-            swScoreboardKernelParames.swScoreboardSurfaceWidth  = swScoreboardKernelParames.scoreboardWidth * 4;
-            swScoreboardKernelParames.swScoreboardSurfaceHeight = swScoreboardKernelParames.scoreboardHeight;
+        swScoreboardKernelParames.scoreboardWidth           = m_picWidthInMb;
+        swScoreboardKernelParames.scoreboardHeight          = m_frameFieldHeightInMb;
+        swScoreboardKernelParames.swScoreboardSurfaceWidth  = swScoreboardKernelParames.scoreboardWidth * 4;
+        swScoreboardKernelParames.swScoreboardSurfaceHeight = swScoreboardKernelParames.scoreboardHeight;
 
-            m_swScoreboardState->Execute(&swScoreboardKernelParames);
-        }
+        m_swScoreboardState->Execute(&swScoreboardKernelParames);
 
         CODECHAL_DEBUG_TOOL(CODECHAL_ENCODE_CHK_STATUS_RETURN(m_debugInterface->DumpBuffer(
             &(m_swScoreboardState->GetCurSwScoreboardSurface())->OsResource,
@@ -5960,11 +5960,11 @@ MOS_STATUS CodechalEncodeVp8G11::ExecuteKernelFunctions()
 
 
     m_swScoreboardState->SetCurSwScoreboardSurfaceIndex(swScoreboardKernelParames.surfaceIndex);
-    // Only called if current pattern was not initialized before
-    if (Mos_ResourceIsNull(&m_swScoreboardState->GetCurSwScoreboardSurface()->OsResource))
-    {
-        swScoreboardInitNeeded = true;
-    }
+
+    swScoreboardKernelParames.scoreboardWidth           = m_picWidthInMb;
+    swScoreboardKernelParames.scoreboardHeight          = m_frameFieldHeightInMb;
+    swScoreboardKernelParames.swScoreboardSurfaceWidth  = swScoreboardKernelParames.scoreboardWidth * 4;
+    swScoreboardKernelParames.swScoreboardSurfaceHeight = swScoreboardKernelParames.scoreboardHeight;
     
     // BRC init/reset needs to be called before HME since it will reset the Brc Distortion surface
     if (m_brcEnabled)
@@ -6053,11 +6053,6 @@ MOS_STATUS CodechalEncodeVp8G11::ExecuteKernelFunctions()
     {
         // Call SW scoreboard Init kernel
         m_lastTaskInPhase = true;
-        swScoreboardKernelParames.scoreboardWidth           = m_picWidthInMb;
-        swScoreboardKernelParames.scoreboardHeight          = m_frameFieldHeightInMb;
-        swScoreboardKernelParames.swScoreboardSurfaceWidth  = swScoreboardKernelParames.scoreboardWidth * 4 ;
-        swScoreboardKernelParames.swScoreboardSurfaceHeight = swScoreboardKernelParames.scoreboardHeight;
-
         CODECHAL_ENCODE_CHK_STATUS_RETURN(m_swScoreboardState->Execute(&swScoreboardKernelParames));
     }
 
@@ -675,7 +675,9 @@ MOS_STATUS MhwVeboxInterfaceG11::AddVeboxState(
     uint32_t                          uiInstanceBaseAddr = 0;
     MHW_RESOURCE_PARAMS               ResourceParams;
     MOS_ALLOC_GFXRES_PARAMS           AllocParamsForBufferLinear;
-    mhw_vebox_g11_X::VEBOX_STATE_CMD  cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vebox_g11_X::VEBOX_STATE_CMD>(pCmdBuffer);
+    MHW_CHK_NULL_RETURN(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_CHK_NULL(m_osInterface);
     MHW_CHK_NULL(pCmdBuffer);
@@ -931,7 +933,7 @@ MOS_STATUS MhwVeboxInterfaceG11::AddVeboxState(
     cmd.DW18.BypassChromaUpsampling                    = pChromaSampling->BypassChromaUpsampling;
     cmd.DW18.BypassChromaDownsampling                  = pChromaSampling->BypassChromaDownsampling;
 
-    Mos_AddCommand(pCmdBuffer, &cmd, cmd.byteSize);
+    MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, &cmd));
 
 finish:
     return eStatus;
@@ -945,7 +947,9 @@ MOS_STATUS MhwVeboxInterfaceG11::AddVeboxDiIecp(
     PMOS_INTERFACE      pOsInterface;
     MHW_RESOURCE_PARAMS ResourceParams;
 
-    mhw_vebox_g11_X::VEB_DI_IECP_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vebox_g11_X::VEB_DI_IECP_CMD>(pCmdBuffer);
+    MHW_CHK_NULL_RETURN(cmdPtr);
+    auto &cmd = *cmdPtr;
     MHW_CHK_NULL(m_osInterface);
     MHW_CHK_NULL(pCmdBuffer);
     MHW_CHK_NULL(pVeboxDiIecpCmdParams);
@@ -1178,7 +1182,7 @@ MOS_STATUS MhwVeboxInterfaceG11::AddVeboxDiIecp(
         MHW_ASSERTMESSAGE("Unsupported Vebox Scalability Settings");
     }
 
-    Mos_AddCommand(pCmdBuffer, &cmd, cmd.byteSize);
+    MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, &cmd));
 
 finish:
     return eStatus;
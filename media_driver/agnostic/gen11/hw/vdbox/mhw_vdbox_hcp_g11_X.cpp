@@ -1417,7 +1417,9 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpPipeBufAddrCmd(
 
     MHW_RESOURCE_PARAMS resourceParams;
     MOS_SURFACE details;
-    mhw_vdbox_hcp_g11_X::HCP_PIPE_BUF_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g11_X::HCP_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
 
@@ -1652,6 +1654,8 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpPipeBufAddrCmd(
 
     bool                firstRefPic = true;
     MOS_MEMCOMP_STATE   mmcMode = MOS_MEMCOMP_DISABLED;
+    MHW_RESOURCE_PARAMS refResourceParams[CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC];
+    uint32_t            numRefResources = 0;
 
     // NOTE: for both HEVC and VP9, set all the 8 ref pic addresses in HCP_PIPE_BUF_ADDR_STATE command to valid addresses for error concealment purpose
     for (uint32_t i = 0; i < CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC; i++)
@@ -1679,13 +1683,18 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpPipeBufAddrCmd(
 
             resourceParams.dwSharedMocsOffset = 53 - resourceParams.dwLocationInCmd; // Common Prodected Data bit is in DW53
 
-            MHW_MI_CHK_STATUS(pfnAddResourceToCmd(
-                m_osInterface,
-                cmdBuffer,
-                &resourceParams));
+            refResourceParams[numRefResources++] = resourceParams;
         }
     }
 
+    // Patch entries of all the references are added at once
+    MHW_MI_CHK_STATUS(Mhw_AddResourcesToCmd(
+        m_osInterface,
+        cmdBuffer,
+        pfnAddResourceToCmd,
+        refResourceParams,
+        numRefResources));
+
     cmd.ReferencePictureBaseAddressMemoryAddressAttributes.DW0.BaseAddressMemoryCompressionEnable =
         (mmcMode != MOS_MEMCOMP_DISABLED) ? MHW_MEDIA_MEMCOMP_ENABLED : MHW_MEDIA_MEMCOMP_DISABLED;
     cmd.ReferencePictureBaseAddressMemoryAddressAttributes.DW0.BaseAddressMemoryCompressionMode =
@@ -2071,7 +2080,7 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpPipeBufAddrCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2087,7 +2096,9 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpIndObjBaseAddrCmd(
     MHW_MI_CHK_NULL(params);
 
     MHW_RESOURCE_PARAMS resourceParams;
-    mhw_vdbox_hcp_g11_X::HCP_IND_OBJ_BASE_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g11_X::HCP_IND_OBJ_BASE_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
     resourceParams.dwLsbNum = MHW_VDBOX_HCP_UPPER_BOUND_STATE_SHIFT;
@@ -2259,7 +2270,7 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpIndObjBaseAddrCmd(
 
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2459,7 +2470,9 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpTileStateCmd(
     MHW_MI_CHK_NULL(params->pTileColWidth);
     MHW_MI_CHK_NULL(params->pTileRowHeight);
 
-    mhw_vdbox_hcp_g11_X::HCP_TILE_STATE_CMD     cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g11_X::HCP_TILE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     auto hevcPicParams = params->pHevcPicParams;
 
@@ -2603,7 +2616,7 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpTileStateCmd(
         }
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -3460,7 +3473,9 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpHevcVp9RdoqStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->pHevcEncSeqParams);
 
-    mhw_vdbox_hcp_g11_X::HEVC_VP9_RDOQ_STATE_CMD    cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g11_X::HEVC_VP9_RDOQ_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     uint16_t                                        lambdaTab[2][2][64];
 
     MHW_MI_CHK_NULL(params->pHevcEncPicParams);
@@ -3537,7 +3552,7 @@ MOS_STATUS MhwVdboxHcpInterfaceG11::AddHcpHevcVp9RdoqStateCmd(
         cmd.DW1.DisableHtqPerformanceFix0 = true;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -3552,7 +3567,9 @@ MOS_STATUS  MhwVdboxHcpInterfaceG11::AddHcpDecodeTileCodingCmd(
 
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_hcp_g11_X::HCP_TILE_CODING_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g11_X::HCP_TILE_CODING_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     MHW_RESOURCE_PARAMS                      resourceParams;
     MEDIA_SYSTEM_INFO  *gtSystemInfo = m_osInterface->pfnGetGtSystemInfo(m_osInterface);
     uint8_t          numVdbox = (uint8_t)gtSystemInfo->VDBoxInfo.NumberOfVDBoxEnabled;
@@ -3567,7 +3584,7 @@ MOS_STATUS  MhwVdboxHcpInterfaceG11::AddHcpDecodeTileCodingCmd(
     cmd.DW3.Tileheightinmincbminus1  = params->TileHeightInMinCbMinus1;
     cmd.DW3.Tilewidthinmincbminus1   = params->TileWidthInMinCbMinus1;
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -3582,7 +3599,9 @@ MOS_STATUS  MhwVdboxHcpInterfaceG11::AddHcpEncodeTileCodingCmd(
 
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_hcp_g11_X::HCP_TILE_CODING_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_hcp_g11_X::HCP_TILE_CODING_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     cmd.DW1.NumberOfActiveBePipes    = params->NumberOfActiveBePipes;
     cmd.DW1.NumOfTileColumnsInAFrame = params->NumOfTileColumnsInFrame; //This field is not used by HW. This field should be same as "Number of Active BE Pipes".
@@ -3624,7 +3643,7 @@ MOS_STATUS  MhwVdboxHcpInterfaceG11::AddHcpEncodeTileCodingCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -671,7 +671,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxPipeModeSelectCmd(
     //for gen 11, we need to add MFX wait for both KIN and VRT before and after MFX Pipemode select...
     MHW_MI_CHK_STATUS(m_MiInterface->AddMfxWaitCmd(cmdBuffer, nullptr, true));
 
-    mhw_vdbox_mfx_g11_X::MFX_PIPE_MODE_SELECT_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_PIPE_MODE_SELECT_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_MI_CHK_STATUS(m_cpInterface->SetProtectionSettingsForMfxPipeModeSelect((uint32_t *)&cmd));
 
@@ -717,7 +719,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxPipeModeSelectCmd(
         cmd.DW1.FrameStatisticsStreamoutEnable = 1;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     //for gen 11, we need to add MFX wait for both KIN and VRT before and after MFX Pipemode select...
     MHW_MI_CHK_STATUS(m_MiInterface->AddMfxWaitCmd(cmdBuffer, nullptr, true));
@@ -750,7 +752,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxSurfaceCmd(
         uvPlaneAlignment = MHW_VDBOX_MFX_UV_PLANE_ALIGNMENT_LEGACY;
     }
 
-    mhw_vdbox_mfx_g11_X::MFX_SURFACE_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_SURFACE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     cmd.DW1.SurfaceId = params->ucSurfaceStateId;
 
     cmd.DW2.Height = params->psSurface->dwHeight - 1;
@@ -793,7 +797,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxSurfaceCmd(
             MOS_ALIGN_CEIL(params->psSurface->VPlaneOffset.iYOffset, uvPlaneAlignment);
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -814,7 +818,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxPipeBufAddrCmd(
     resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
     resourceParams.HwCommandType = MOS_MFX_PIPE_BUF_ADDR;
 
-    mhw_vdbox_mfx_g11_X::MFX_PIPE_BUF_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     // Encoding uses both surfaces regardless of deblocking status
     if (params->psPreDeblockSurface != nullptr)
@@ -989,6 +995,8 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxPipeBufAddrCmd(
     }
 
     bool firstRefPic = true;
+    MHW_RESOURCE_PARAMS refResourceParams[CODEC_MAX_NUM_REF_FRAME];
+    uint32_t            numRefResources = 0;
     for (auto i = 0; i < CODEC_MAX_NUM_REF_FRAME; i++)
     {
         if (params->presReferences[i] != nullptr)
@@ -1028,13 +1036,18 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxPipeBufAddrCmd(
 
             resourceParams.dwSharedMocsOffset = 51 - resourceParams.dwLocationInCmd; // Common Prodected Data bit is in DW51
 
-            MHW_MI_CHK_STATUS(AddResourceToCmd(
-                m_osInterface,
-                cmdBuffer,
-                &resourceParams));
+            refResourceParams[numRefResources++] = resourceParams;
         }
     }
 
+    // Patch entries of all the references are added at once
+    MHW_MI_CHK_STATUS(Mhw_AddResourcesToCmd(
+        m_osInterface,
+        cmdBuffer,
+        AddResourceToCmd,
+        refResourceParams,
+        numRefResources));
+
     // There is only one control DW51 for all references
     cmd.DW51.MemoryObjectControlState =
         m_cacheabilitySettings[MOS_CODEC_RESOURCE_USAGE_REFERENCE_PICTURE_CODEC].Value;
@@ -1133,7 +1146,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxPipeBufAddrCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -1154,7 +1167,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxIndObjBaseAddrCmd(
     resourceParams.dwLsbNum = MHW_VDBOX_MFX_UPPER_BOUND_STATE_SHIFT;
     resourceParams.HwCommandType = MOS_MFX_INDIRECT_OBJ_BASE_ADDR;
 
-    mhw_vdbox_mfx_g11_X::MFX_IND_OBJ_BASE_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_IND_OBJ_BASE_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     // mode specific settings
     if (CodecHalIsDecodeModeVLD(params->Mode) || (params->Mode == CODECHAL_ENCODE_MODE_VP8))
@@ -1244,7 +1259,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxIndObjBaseAddrCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -1265,7 +1280,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxBspBufBaseAddrCmd(
     resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
     resourceParams.HwCommandType = MOS_MFX_BSP_BUF_BASE_ADDR;
 
-    mhw_vdbox_mfx_g11_X::MFX_BSP_BUF_BASE_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_BSP_BUF_BASE_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     if (m_bsdMpcRowstoreCache.bEnabled)         // mbaff and non mbaff mode for all resolutions
     {
@@ -1330,7 +1347,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxBspBufBaseAddrCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -1352,7 +1369,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxDecodeAvcImgCmd(
 
     auto avcPicParams = params->pAvcPicParams;
 
-    mhw_vdbox_mfx_g11_X::MFX_AVC_IMG_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_AVC_IMG_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     uint32_t numMBs =
         (avcPicParams->pic_height_in_mbs_minus1 + 1) *
@@ -1414,7 +1433,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxDecodeAvcImgCmd(
         cmd.DW16.InterViewOrderDisable = 0;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -1614,7 +1633,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxAvcDirectmodeCmd(
     resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
     resourceParams.HwCommandType = MOS_MFX_AVC_DIRECT_MODE;
 
-    mhw_vdbox_mfx_g11_X::MFX_AVC_DIRECTMODE_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_AVC_DIRECTMODE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     if (!params->bDisableDmvBuffers)
     {
@@ -1739,7 +1760,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxAvcDirectmodeCmd(
         }
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -1965,7 +1986,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxJpegPicCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->pJpegPicParams);
 
-    mhw_vdbox_mfx_g11_X::MFX_JPEG_PIC_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_JPEG_PIC_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     auto picParams = params->pJpegPicParams;
 
     if (picParams->m_chromaType == jpegRGB || picParams->m_chromaType == jpegBGR)
@@ -2004,7 +2027,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxJpegPicCmd(
     cmd.DW2.Obj0.FrameWidthInBlocksMinus1 = params->dwWidthInBlocks;
     cmd.DW2.Obj0.FrameHeightInBlocksMinus1 = params->dwHeightInBlocks;
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2021,7 +2044,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxJpegEncodePicStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->pJpegEncodePicParams);
 
-    mhw_vdbox_mfx_g11_X::MFX_JPEG_PIC_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_JPEG_PIC_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     auto picParams = params->pJpegEncodePicParams;
 
     cmd.DW1.Obj0.InputSurfaceFormatYuv = picParams->m_inputSurfaceFormat;
@@ -2082,7 +2107,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxJpegEncodePicStateCmd(
     cmd.DW2.Obj0.FrameWidthInBlocksMinus1 = (((picParams->m_picWidth + (horizontalSamplingFactor * 8 - 1)) / (horizontalSamplingFactor * 8)) * horizontalSamplingFactor) - 1;
     cmd.DW2.Obj0.FrameHeightInBlocksMinus1 = (((picParams->m_picHeight + (verticalSamplingFactor * 8 - 1)) / (verticalSamplingFactor * 8)) * verticalSamplingFactor) - 1;
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2137,7 +2162,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfcJpegHuffTableStateCmd(
     MHW_MI_CHK_NULL(cmdBuffer);
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_mfx_g11_X::MFC_JPEG_HUFF_TABLE_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFC_JPEG_HUFF_TABLE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     cmd.DW1.HuffTableId = params->HuffTableID;
 
@@ -2158,7 +2185,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfcJpegHuffTableStateCmd(
             | ((params->pACCodeValues[j] & 0xFFFF) << 8);
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2175,15 +2202,24 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfcJpegScanObjCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->pJpegEncodeScanParams);
 
-    mhw_vdbox_mfx_g11_X::MFC_JPEG_SCAN_OBJECT_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFC_JPEG_SCAN_OBJECT_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
-    uint32_t horizontalSamplingFactor = GetJpegHorizontalSamplingFactorForY(params->inputSurfaceFormat);
-    uint32_t verticalSamplingFactor = GetJpegVerticalSamplingFactorForY(params->inputSurfaceFormat);
-    cmd.DW1.McuCount = ((params->dwPicWidth + (horizontalSamplingFactor * 8 - 1)) / (horizontalSamplingFactor * 8))
-        * ((params->dwPicHeight + (verticalSamplingFactor * 8 - 1)) / (verticalSamplingFactor * 8));
+    if (params->dwMcuCount != 0)
+    {
+        cmd.DW1.McuCount = params->dwMcuCount;
+    }
+    else
+    {
+        uint32_t horizontalSamplingFactor = GetJpegHorizontalSamplingFactorForY(params->inputSurfaceFormat);
+        uint32_t verticalSamplingFactor = GetJpegVerticalSamplingFactorForY(params->inputSurfaceFormat);
+        cmd.DW1.McuCount = ((params->dwPicWidth + (horizontalSamplingFactor * 8 - 1)) / (horizontalSamplingFactor * 8))
+            * ((params->dwPicHeight + (verticalSamplingFactor * 8 - 1)) / (verticalSamplingFactor * 8));
+    }
     cmd.DW2.RestartInterval = params->pJpegEncodeScanParams->m_restartInterval;
-    cmd.DW2.IsLastScan = 1; // Always 1 since there is only 1 scan in the JPEG frame 
-    cmd.DW2.HeadPresentFlag = 1; // There will always be MFC_JPEG_PAK_INSERT_OBJECT commands sent 
+    cmd.DW2.IsLastScan = params->isLastScan ? 1 : 0;
+    cmd.DW2.HeadPresentFlag = 1; // There will always be MFC_JPEG_PAK_INSERT_OBJECT commands sent
 
     for (auto i = 0; i < jpegNumComponent; i++)
     {
@@ -2191,7 +2227,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfcJpegScanObjCmd(
         cmd.DW2.HuffmanAcTable |= (params->pJpegEncodeScanParams->m_acCodingTblSelector[i]) << i;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2207,7 +2243,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxDecodeVp8PicCmd(
     MHW_MI_CHK_NULL(cmdBuffer);
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_mfx_g11_X::MFX_VP8_PIC_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_VP8_PIC_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     auto vp8PicParams = params->pVp8PicParams;
     auto vp8IqMatrixParams = params->pVp8IqMatrixParams;
 
@@ -2416,7 +2454,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxDecodeVp8PicCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2435,7 +2473,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxEncodeVp8PicCmd(
     MHW_MI_CHK_NULL(params->pEncodeVP8PicParams);
     MHW_MI_CHK_NULL(params->pEncodeVP8QuantData);
 
-    mhw_vdbox_mfx_g11_X::MFX_VP8_PIC_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_VP8_PIC_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     auto vp8SeqParams = params->pEncodeVP8SeqParams;
     auto vp8PicParams = params->pEncodeVP8PicParams;
     auto vp8QuantData = params->pEncodeVP8QuantData;
@@ -2585,7 +2625,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxEncodeVp8PicCmd(
     cmd.DW34.Modelfdelta2ForNearestNearAndNewMode = vp8PicParams->mode_lf_delta[2];
     cmd.DW34.Modelfdelta3ForSplitmvMode = vp8PicParams->mode_lf_delta[3];
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -2708,7 +2748,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxVp8BspBufBaseAddrCmd(
         return eStatus;
     }
 
-    mhw_vdbox_mfx_g11_X::MFX_VP8_BSP_BUF_BASE_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g11_X::MFX_VP8_BSP_BUF_BASE_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_RESOURCE_PARAMS resourceParams;
     MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
@@ -2829,7 +2871,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG11::AddMfxVp8BspBufBaseAddrCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -451,7 +451,9 @@ public:
  
         auto paramsG11 = dynamic_cast<PMHW_VDBOX_PIPE_MODE_SELECT_PARAMS_G11>(params);
         MHW_MI_CHK_NULL(paramsG11);
-        typename TVdencCmds::VDENC_PIPE_MODE_SELECT_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_PIPE_MODE_SELECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.StandardSelect                 = CodecHal_GetStandardFromMode(params->Mode);
         cmd.DW1.ScalabilityMode                = !(paramsG11->MultiEngineMode == MHW_VDBOX_HCP_MULTI_ENGINE_MODE_FE_LEGACY);
@@ -470,7 +472,7 @@ public:
         // can add a DDI flag to control if needed
         cmd.DW1.OutputRangeControlAfterColorSpaceConversion = 1;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -488,7 +490,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(this->m_osInterface);
 
-        typename TVdencCmds::VDENC_PIPE_BUF_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MOS_MEMCOMP_STATE   mmcMode = MOS_MEMCOMP_DISABLED;
         MHW_RESOURCE_PARAMS resourceParams;
@@ -963,7 +967,7 @@ public:
         // Hence it's a dummy CL for us. Histogram stats start from 4th CL onwards. 
         cmd.DW61.WeightsHistogramStreamoutOffset = 3 * MHW_CACHELINE_SIZE;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -978,7 +982,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->psSurface);
 
-        typename TVdencCmds::VDENC_SRC_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_SRC_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.Dwords25.DW0.Width               = params->dwActualWidth - 1;
         cmd.Dwords25.DW0.Height              = params->dwActualHeight - 1;
@@ -1004,7 +1010,7 @@ public:
         cmd.Dwords25.DW2.YOffsetForUCb            = cmd.Dwords25.DW3.YOffsetForVCr =
             MOS_ALIGN_CEIL(params->psSurface->UPlaneOffset.iYOffset, MHW_VDBOX_MFX_RAW_UV_PLANE_ALIGNMENT_GEN9);
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -1019,7 +1025,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->psSurface);
 
-        typename TVdencCmds::VDENC_REF_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_REF_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         if (params->bVdencDynamicScaling)
         {
@@ -1086,7 +1094,7 @@ public:
             cmd.Dwords25.DW2.YOffsetForUCb = cmd.Dwords25.DW3.YOffsetForVCr = params->dwReconSurfHeight;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -1102,7 +1110,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->psSurface);
 
-        typename TVdencCmds::VDENC_DS_REF_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_DS_REF_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         if (params->Mode == CODECHAL_ENCODE_MODE_HEVC)
         {
@@ -1159,7 +1169,7 @@ public:
             cmd.Dwords69.DW2.YOffsetForUCb = cmd.Dwords69.DW3.YOffsetForVCr = params->psSurface->UPlaneOffset.iYOffset;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -1403,7 +1413,9 @@ public:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TVdencCmds::VDENC_WALKER_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_WALKER_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         if (params->Mode == CODECHAL_ENCODE_MODE_AVC)
         {
@@ -1575,7 +1587,7 @@ public:
             }
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -1590,7 +1602,9 @@ public:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pAvcPicParams);
 
-        typename TVdencCmds::VDENC_WEIGHTSOFFSETS_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_WEIGHTSOFFSETS_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         auto avcPicParams = params->pAvcPicParams;
 
@@ -1614,7 +1628,7 @@ public:
             cmd.DW2.OffsetForwardReference2  = 0;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
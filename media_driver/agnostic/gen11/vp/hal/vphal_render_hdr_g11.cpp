@@ -276,6 +276,119 @@ void Hdr3DLutCmRender::PrepareKernel(CmKernel *kernel)
     kernel->SetKernelArg(3, sizeof(uint16_t), &m_cmPayload->hdr3DLutSurfaceHeight);
 }
 
+extern MOS_MUTEX gVpHalHdr3DLutCacheMutex;
+
+VpHal3DLutCacheTable<PMOS_RESOURCE> *Hdr3DLutCache::m_table = nullptr;
+
+void Hdr3DLutCache::AddUser(PMOS_INTERFACE osInterface)
+{
+    MOS_LockMutex(&gVpHalHdr3DLutCacheMutex);
+    if (m_table == nullptr)
+    {
+        m_table = MOS_New(VpHal3DLutCacheTable<PMOS_RESOURCE>);
+    }
+    if (m_table)
+    {
+        m_table->AddUser(osInterface->pfnGetGmmClientContext(osInterface));
+    }
+    MOS_UnlockMutex(&gVpHalHdr3DLutCacheMutex);
+}
+
+void Hdr3DLutCache::RemoveUser(PMOS_INTERFACE osInterface)
+{
+    const void    *device = osInterface->pfnGetGmmClientContext(osInterface);
+    PMOS_RESOURCE lut     = nullptr;
+
+    MOS_LockMutex(&gVpHalHdr3DLutCacheMutex);
+    if (m_table && m_table->RemoveUser(device))
+    {
+        // Last generator of the device, its OS interface is the last one able to free the LUTs
+        while (m_table->PopDevice(device, &lut))
+        {
+            FreeLut(osInterface, lut);
+        }
+    }
+    if (m_table && m_table->IsUnused())
+    {
+        MOS_Delete(m_table);
+    }
+    MOS_UnlockMutex(&gVpHalHdr3DLutCacheMutex);
+}
+
+PMOS_RESOURCE Hdr3DLutCache::Acquire(const Key &key)
+{
+    PMOS_RESOURCE lut = nullptr;
+
+    MOS_LockMutex(&gVpHalHdr3DLutCacheMutex);
+    if (m_table && !m_table->Acquire(key, &lut))
+    {
+        lut = nullptr;
+    }
+    MOS_UnlockMutex(&gVpHalHdr3DLutCacheMutex);
+
+    return lut;
+}
+
+PMOS_RESOURCE Hdr3DLutCache::Insert(PMOS_INTERFACE osInterface, const Key &key, PMOS_RESOURCE lut)
+{
+    PMOS_RESOURCE cachedLut = nullptr;
+
+    MOS_LockMutex(&gVpHalHdr3DLutCacheMutex);
+    if (m_table == nullptr)
+    {
+        cachedLut = lut;
+    }
+    else if (m_table->Acquire(key, &cachedLut))
+    {
+        // Generated by another context meanwhile
+        FreeLut(osInterface, lut);
+    }
+    else
+    {
+        m_table->Insert(key, lut);
+        Trim(osInterface);
+        cachedLut = lut;
+    }
+    MOS_UnlockMutex(&gVpHalHdr3DLutCacheMutex);
+
+    return cachedLut;
+}
+
+void Hdr3DLutCache::Release(PMOS_INTERFACE osInterface, PMOS_RESOURCE lut)
+{
+    if (lut == nullptr)
+    {
+        return;
+    }
+
+    MOS_LockMutex(&gVpHalHdr3DLutCacheMutex);
+    if (m_table)
+    {
+        m_table->Release(lut);
+        Trim(osInterface);
+    }
+    MOS_UnlockMutex(&gVpHalHdr3DLutCacheMutex);
+}
+
+void Hdr3DLutCache::FreeLut(PMOS_INTERFACE osInterface, PMOS_RESOURCE lut)
+{
+    if (lut)
+    {
+        osInterface->pfnFreeResource(osInterface, lut);
+        MOS_Delete(lut);
+    }
+}
+
+void Hdr3DLutCache::Trim(PMOS_INTERFACE osInterface)
+{
+    PMOS_RESOURCE lut = nullptr;
+
+    while (m_table->PopIdle(osInterface->pfnGetGmmClientContext(osInterface), &lut))
+    {
+        FreeLut(osInterface, lut);
+    }
+}
+
 Hdr3DLutGenerator::Hdr3DLutGenerator(PRENDERHAL_INTERFACE renderHal, uint32_t* kernelBinary, uint32_t kernelSize) :
     m_renderHal(renderHal),
     m_hdr3DLutSurface(nullptr),
@@ -292,6 +405,8 @@ Hdr3DLutGenerator::Hdr3DLutGenerator(PRENDERHAL_INTERFACE renderHal, uint32_t* k
 
     m_kernelBinary = kernelBinary;
     m_kernelSize   = kernelSize;
+
+    Hdr3DLutCache::AddUser(m_renderHal->pOsInterface);
 }
 
 Hdr3DLutGenerator::~Hdr3DLutGenerator()
@@ -302,8 +417,16 @@ Hdr3DLutGenerator::~Hdr3DLutGenerator()
 
     MOS_Delete(m_eventManager);
 
-    CmContext::GetCmContext().DecRefCount();
-    m_bHdr3DLutInit = false;    
+    // CM is only set up by contexts that generated a LUT themselves
+    if (m_bHdr3DLutInit)
+    {
+        CmContext::GetCmContext().DecRefCount();
+    }
+    m_bHdr3DLutInit = false;
+
+    Hdr3DLutCache::Release(m_renderHal->pOsInterface, m_cached3DLut);
+    m_cached3DLut = nullptr;
+    Hdr3DLutCache::RemoveUser(m_renderHal->pOsInterface);
 
     VPHAL_RENDER_NORMALMESSAGE("Hdr3DLutGenerator Destructor!");
 }
@@ -441,16 +564,13 @@ void Hdr3DLutGenerator::InitCoefSurface(const uint32_t maxDLL, const uint32_t ma
     m_hdrcoefBuffer[pos_coef[16]]                       = tmMaxDLL;
 }
 
-void Hdr3DLutGenerator::Render(const uint32_t maxDLL, const uint32_t maxCLL, const VPHAL_HDR_MODE hdrMode, const PVPHAL_SURFACE p3DLutSurface)
+PMOS_RESOURCE Hdr3DLutGenerator::Generate3DLut(const Hdr3DLutCache::Key &key)
 {
-    MOS_STATUS eStatus                      = MOS_STATUS_SUCCESS;
-    PMOS_INTERFACE        pOsInterface      = nullptr;
-
-    VPHAL_RENDER_CHK_NULL_NO_STATUS(m_renderHal);
-    VPHAL_RENDER_CHK_NULL_NO_STATUS(p3DLutSurface);
-
-    pOsInterface = m_renderHal->pOsInterface;
-    VPHAL_RENDER_CHK_NULL_NO_STATUS(pOsInterface);
+    PMOS_INTERFACE          pOsInterface = m_renderHal->pOsInterface;
+    PMOS_RESOURCE           lut          = nullptr;
+    uint8_t                 *pLutBuffer  = nullptr;
+    MOS_ALLOC_GFXRES_PARAMS AllocParams;
+    MOS_LOCK_PARAMS         LockFlags;
 
     if (false == m_bHdr3DLutInit)
     {
@@ -465,61 +585,113 @@ void Hdr3DLutGenerator::Render(const uint32_t maxDLL, const uint32_t maxCLL, con
         VPHAL_RENDER_NORMALMESSAGE("Hdr3DLutGenerator Init Hdr3DLutCmRender and Allocate Necessary Resources!");
     }
 
-    if (maxCLL != m_savedMaxCLL || maxDLL != m_savedMaxDLL || hdrMode != m_savedHdrMode)
+    // Allocate the LUT shared by the contexts of the device, it is written once here
+    lut = MOS_New(MOS_RESOURCE);
+    if (lut == nullptr)
     {
-        m_savedMaxCLL = maxCLL;
-        m_savedMaxDLL = maxDLL;
-        m_savedHdrMode = hdrMode;
+        VPHAL_RENDER_ASSERTMESSAGE("Hdr3DLutGenerator::Generate3DLut LUT Allocation Failed!");
+        return nullptr;
+    }
+    MOS_ZeroMemory(lut, sizeof(MOS_RESOURCE));
+
+    MOS_ZeroMemory(&AllocParams, sizeof(MOS_ALLOC_GFXRES_PARAMS));
+    AllocParams.Type     = MOS_GFXRES_2D;
+    AllocParams.TileType = MOS_TILE_LINEAR;
+    AllocParams.Format   = Format_A16B16G16R16;
+    AllocParams.dwWidth  = lutWidth;
+    AllocParams.dwHeight = lutHeight;
+    AllocParams.pBufName = "Hdr3DLutShared_g11";
+
+    if (pOsInterface->pfnAllocateResource(pOsInterface, &AllocParams, lut) != MOS_STATUS_SUCCESS)
+    {
+        VPHAL_RENDER_ASSERTMESSAGE("Hdr3DLutGenerator::Generate3DLut LUT Allocation Failed!");
+        MOS_Delete(lut);
+        return nullptr;
+    }
+
+    InitCoefSurface(key.maxDLL, key.maxCLL, (VPHAL_HDR_MODE)key.hdrMode);
+    m_hdrCoefSurface->GetCmSurface()->WriteSurface((uint8_t*)m_hdrcoefBuffer, nullptr);
+
+    Hdr3DLutCmRender::Hdr3DLutPayload hdr3DLutPayload = { 0 };
+    hdr3DLutPayload.hdr3DLutSurface = m_hdr3DLutSurface;
+    hdr3DLutPayload.hdrCoefSurface = m_hdrCoefSurface;
+    hdr3DLutPayload.hdr3DLutSurfaceWidth = lutWidth;
+    hdr3DLutPayload.hdr3DLutSurfaceHeight = lutHeight;
+
+    CmContext::GetCmContext().ConnectEventListener(m_eventManager);
+    m_hdr3DLutCmRender->Render(&hdr3DLutPayload);
+    CmContext::GetCmContext().FlushBatchTask(false);
+    CmContext::GetCmContext().ConnectEventListener(nullptr);
+
+    MOS_ZeroMemory(&LockFlags, sizeof(MOS_LOCK_PARAMS));
+    LockFlags.WriteOnly = 1;
+    pLutBuffer = (uint8_t*)pOsInterface->pfnLockResource(pOsInterface, lut, &LockFlags);
+    if (pLutBuffer == nullptr)
+    {
+        VPHAL_RENDER_ASSERTMESSAGE("Hdr3DLutGenerator::Generate3DLut LUT Lock Failed!");
+        Hdr3DLutCache::FreeLut(pOsInterface, lut);
+        return nullptr;
+    }
+    m_hdr3DLutSurface->GetCmSurface()->ReadSurface(pLutBuffer, nullptr);
+    pOsInterface->pfnUnlockResource(pOsInterface, lut);
+
+    if (enableDump)
+    {
+        // Dump 3DLut Surface
+        int32_t width = 0, height = 0, depth = 0;
+        m_hdr3DLutSurface->GetSurfaceDimentions(width, height, depth);
+        m_hdr3DLutSurface->DumpSurfaceToFile(OutputDumpDirectory + "3DLutSurface" + std::to_string(width) + "x" + std::to_string(height) + ".dat");
+        // Dump Coefficient Surface(including CCM, Tone Mapping Type etc.)
+        m_hdrCoefSurface->GetSurfaceDimentions(width, height, depth);
+        m_hdrCoefSurface->DumpSurfaceToFile(OutputDumpDirectory + "CoffSurface" + std::to_string(width) + "x" + std::to_string(height) + ".dat");
+    }
+
+    return Hdr3DLutCache::Insert(pOsInterface, key, lut);
+}
 
-        InitCoefSurface(maxDLL, maxCLL, hdrMode);
-        m_hdrCoefSurface->GetCmSurface()->WriteSurface((uint8_t*)m_hdrcoefBuffer, nullptr);
+PMOS_RESOURCE Hdr3DLutGenerator::Render(const uint32_t maxDLL, const uint32_t maxCLL, const VPHAL_HDR_MODE hdrMode)
+{
+    PMOS_INTERFACE        pOsInterface      = nullptr;
+    PMOS_RESOURCE         p3DLut            = nullptr;
+
+    VPHAL_RENDER_CHK_NULL_NO_STATUS(m_renderHal);
+
+    pOsInterface = m_renderHal->pOsInterface;
+    VPHAL_RENDER_CHK_NULL_NO_STATUS(pOsInterface);
 
-        Hdr3DLutCmRender::Hdr3DLutPayload hdr3DLutPayload = { 0 };
-        hdr3DLutPayload.hdr3DLutSurface = m_hdr3DLutSurface;
-        hdr3DLutPayload.hdrCoefSurface = m_hdrCoefSurface;
-        hdr3DLutPayload.hdr3DLutSurfaceWidth = lutWidth;
-        hdr3DLutPayload.hdr3DLutSurfaceHeight = lutHeight;
+    if (m_cached3DLut == nullptr || maxCLL != m_savedMaxCLL || maxDLL != m_savedMaxDLL || hdrMode != m_savedHdrMode)
+    {
+        Hdr3DLutCache::Key key = {};
+        key.device             = pOsInterface->pfnGetGmmClientContext(pOsInterface);
+        key.maxDLL             = maxDLL;
+        key.maxCLL             = maxCLL;
+        key.hdrMode            = hdrMode;
 
-        CmContext::GetCmContext().ConnectEventListener(m_eventManager);
-        m_hdr3DLutCmRender->Render(&hdr3DLutPayload);
-        CmContext::GetCmContext().FlushBatchTask(false);
-        CmContext::GetCmContext().ConnectEventListener(nullptr);
+        PMOS_RESOURCE lut = Hdr3DLutCache::Acquire(key);
 
+        if (lut == nullptr)
         {
-            MOS_LOCK_PARAMS         LockFlags;
-            LockFlags.NoOverWrite = 1;
-            uint8_t   *pVebox3DLutBuffer = (uint8_t*)m_renderHal->pOsInterface->pfnLockResource(
-                pOsInterface,
-                &p3DLutSurface->OsResource,
-                &LockFlags);
-            if (pVebox3DLutBuffer)
-            {                
-                m_hdr3DLutSurface->GetCmSurface()->ReadSurface(pVebox3DLutBuffer, nullptr);
-            }
-            else
-            {
-                VPHAL_RENDER_NORMALMESSAGE("Hdr3DLutGenerator::Render 3DLut Surface Lock Failed!");
-            }
-            pOsInterface->pfnUnlockResource(
-                pOsInterface,
-                &p3DLutSurface->OsResource);
+            lut = Generate3DLut(key);
+            VPHAL_RENDER_CHK_NULL_NO_STATUS(lut);
         }
-
-        if (enableDump)
+        else
         {
-            // Dump 3DLut Surface
-            int32_t width = 0, height = 0, depth = 0;
-            m_hdr3DLutSurface->GetSurfaceDimentions(width, height, depth);
-            m_hdr3DLutSurface->DumpSurfaceToFile(OutputDumpDirectory + "3DLutSurface" + std::to_string(width) + "x" + std::to_string(height) + ".dat");
-            // Dump Coefficient Surface(including CCM, Tone Mapping Type etc.)
-            m_hdrCoefSurface->GetSurfaceDimentions(width, height, depth);
-            m_hdrCoefSurface->DumpSurfaceToFile(OutputDumpDirectory + "CoffSurface" + std::to_string(width) + "x" + std::to_string(height) + ".dat");
+            VPHAL_RENDER_NORMALMESSAGE("Hdr3DLutGenerator 3DLut Cache Hit!");
         }
+
+        Hdr3DLutCache::Release(pOsInterface, m_cached3DLut);
+        m_cached3DLut = lut;
+
+        m_savedMaxCLL = maxCLL;
+        m_savedMaxDLL = maxDLL;
+        m_savedHdrMode = hdrMode;
     }
 
+    p3DLut = m_cached3DLut;
+
     VPHAL_RENDER_NORMALMESSAGE("Hdr3DLutGenerator Render maxCLL %d, maxDLL %d, hdrMode: %d!", maxCLL, maxDLL, hdrMode);
 
 finish:
-    return;
+    return p3DLut;
 }
 #endif
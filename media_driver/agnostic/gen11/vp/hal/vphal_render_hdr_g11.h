@@ -30,6 +30,7 @@
 #if !EMUL
 #include "vphal_common.h"
 #include "vphal_mdf_wrapper.h"
+#include "vphal_render_hdr_3dlut_cache.h"
 
 //!
 //! \brief    Tone Mapping Source Type, Please don't change the Enmu Value.
@@ -93,6 +94,56 @@ private:
     Hdr3DLutPayload *m_cmPayload         = nullptr;
 };
 
+//!
+//! \brief    Process wide cache of generated HDR 3D LUTs
+//! \details  Like CmContext it is shared by every VP context of the process, so
+//!           contexts of a device converting with the same tone mapping
+//!           parameters bind one read only LUT resource and the 3D LUT kernel
+//!           only runs on a cache miss. The table is allocated with the first
+//!           generator and freed with the last one, so nothing is left to tear
+//!           down after MOS at process exit.
+//!
+class Hdr3DLutCache
+{
+public:
+    typedef VpHal3DLutCacheTable<PMOS_RESOURCE>::Key Key;
+
+    //! \brief  Register a generator of the device of osInterface
+    static void AddUser(PMOS_INTERFACE osInterface);
+
+    //! \brief  Unregister a generator, the LUTs of its device are freed with the last one
+    static void RemoveUser(PMOS_INTERFACE osInterface);
+
+    //!
+    //! \brief    Take a reference on the LUT generated for key
+    //! \return   PMOS_RESOURCE
+    //!           The LUT, nullptr on a cache miss
+    //!
+    static PMOS_RESOURCE Acquire(const Key &key);
+
+    //!
+    //! \brief    Add a generated LUT and take a reference on it
+    //! \details  The cache takes ownership of lut, allocated by MOS_New and
+    //!           osInterface. If another context added the same key meanwhile,
+    //!           lut is freed and the cached LUT is returned.
+    //! \return   PMOS_RESOURCE
+    //!           The cached LUT
+    //!
+    static PMOS_RESOURCE Insert(PMOS_INTERFACE osInterface, const Key &key, PMOS_RESOURCE lut);
+
+    //! \brief  Drop a reference taken by Acquire or Insert, nullptr is ignored
+    static void Release(PMOS_INTERFACE osInterface, PMOS_RESOURCE lut);
+
+    //! \brief  Free a LUT handed back by the table
+    static void FreeLut(PMOS_INTERFACE osInterface, PMOS_RESOURCE lut);
+
+private:
+    //! \brief  Free the idle LUTs of device beyond the limit. Lock must be held.
+    static void Trim(PMOS_INTERFACE osInterface);
+
+    static VpHal3DLutCacheTable<PMOS_RESOURCE>  *m_table;   //!< Guarded by gVpHalHdr3DLutCacheMutex
+};
+
 class Hdr3DLutGenerator
 {
 public:
@@ -101,12 +152,20 @@ public:
     Hdr3DLutGenerator &operator=(const Hdr3DLutGenerator &) = delete;
     virtual ~Hdr3DLutGenerator();
 
-    void Render(const uint32_t maxDLL, const uint32_t maxCLL, const VPHAL_HDR_MODE hdrMode, const PVPHAL_SURFACE p3DLutSurface);
+    //!
+    //! \brief    Get the 3D LUT for the tone mapping parameters
+    //! \return   PMOS_RESOURCE
+    //!           The shared read only LUT to bind, nullptr on failure
+    //!
+    PMOS_RESOURCE Render(const uint32_t maxDLL, const uint32_t maxCLL, const VPHAL_HDR_MODE hdrMode);
 
 private:
     void AllocateResources();
     void FreeResources();
 
+    //! \brief  Run the 3D LUT kernel on a cache miss and add its output to the cache
+    PMOS_RESOURCE Generate3DLut(const Hdr3DLutCache::Key &key);
+
     void InitCoefSurface(const uint32_t maxDLL, const uint32_t maxCLL, const VPHAL_HDR_MODE hdrMode);
     void Init3DLutSurface();
 
@@ -118,6 +177,7 @@ private:
     Hdr3DLutCmRender                    *m_hdr3DLutCmRender    = nullptr;
     float                               *m_hdrcoefBuffer       = nullptr;
     uint8_t                             *m_hdr3DLutSysBuffer   = nullptr;
+    PMOS_RESOURCE                       m_cached3DLut          = nullptr;    //!< Cached LUT in use, referenced
 
     bool     m_bHdr3DLutInit            = false;
     uint32_t m_savedMaxDLL              = 1000;
@@ -148,9 +208,9 @@ public:
     Hdr3DLutGenerator &operator=(const Hdr3DLutGenerator &) = delete;
     virtual ~Hdr3DLutGenerator() {};
 
-    void Render(const uint32_t maxDLL, const uint32_t maxCLL, const VPHAL_HDR_MODE hdrMode, const PVPHAL_SURFACE p3DLutSurface)
+    PMOS_RESOURCE Render(const uint32_t maxDLL, const uint32_t maxCLL, const VPHAL_HDR_MODE hdrMode)
     {
-        return ;
+        return nullptr;
     };
 };
 #endif
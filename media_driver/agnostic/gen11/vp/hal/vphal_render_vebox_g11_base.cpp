@@ -668,6 +668,13 @@ MOS_STATUS VPHAL_VEBOX_STATE_G11_BASE::AllocateResources()
                   MOS_ROUNDUP_DIVIDE(VPHAL_VEBOX_STATISTICS_SIZE_G11 * sizeof(uint32_t), dwWidth);
     dwSize      = dwWidth * dwHeight;
 
+    // The statistics surface is reallocated when its size changes, release the
+    // CPU auto DN mapping of the current one first
+    if (pVeboxState->VeboxStatisticsSurface.dwWidth != dwSize)
+    {
+        pVeboxState->VeboxUnlockStatisticsSurface();
+    }
+
     VPHAL_RENDER_CHK_STATUS(VpHal_ReAllocateSurface(
                 pOsInterface,
                 &pVeboxState->VeboxStatisticsSurface,
@@ -857,6 +864,7 @@ void VPHAL_VEBOX_STATE_G11_BASE::FreeResources()
     }
 
     // Free Statistics data surface for VEBOX
+    pVeboxState->VeboxUnlockStatisticsSurface();
     pOsInterface->pfnFreeResource(
         pOsInterface,
         &pVeboxState->VeboxStatisticsSurface.OsResource);
@@ -1416,6 +1424,9 @@ MOS_STATUS VPHAL_VEBOX_STATE_G11_BASE::SetDNParams(
     MOS_STATUS                       eStatus;
     PVPHAL_DENOISE_PARAMS            pDNParams;
     uint32_t                         dwDenoiseFactor;
+    uint32_t                         dwLumaFactor;
+    uint32_t                         dwChromaFactor;
+    bool                             bDenoiseSlider;
     PVPHAL_VEBOX_RENDER_DATA         pRenderData = GetLastExecRenderData();
 
     VPHAL_RENDER_ASSERT(pSrcSurface);
@@ -1426,6 +1437,11 @@ MOS_STATUS VPHAL_VEBOX_STATE_G11_BASE::SetDNParams(
     eStatus             = MOS_STATUS_SUCCESS;
     pDNParams           = pSrcSurface->pDenoiseParams;
 
+    // Slider factors from the application, or from the CPU auto DN update
+    dwLumaFactor   = NOISEFACTOR_MIN;
+    dwChromaFactor = NOISEFACTOR_MIN;
+    bDenoiseSlider = VeboxGetDenoiseSliderFactors(pDNParams, &dwLumaFactor, &dwChromaFactor);
+
     // Set Luma DN params
     if (pRenderData->bDenoise)
     {
@@ -1448,15 +1464,10 @@ MOS_STATUS VPHAL_VEBOX_STATE_G11_BASE::SetDNParams(
         pRenderData->VeboxDNDIParams.dwPixRangeWeight[4]    = NOISE_BLF_RANGE_WGTS4_DEFAULT;
         pRenderData->VeboxDNDIParams.dwPixRangeWeight[5]    = NOISE_BLF_RANGE_WGTS5_DEFAULT;
 
-        // User specified Denoise strength case (no auto DN detect)
-        if (!pDNParams->bAutoDetect)
+        // User specified Denoise strength case, or auto DN detect updated on the CPU
+        if (bDenoiseSlider)
         {
-            dwDenoiseFactor = (uint32_t)pDNParams->fDenoiseFactor;
-
-            if (dwDenoiseFactor > NOISEFACTOR_MAX)
-            {
-                dwDenoiseFactor = NOISEFACTOR_MAX;
-            }
+            dwDenoiseFactor = dwLumaFactor;
 
             pLumaParams->dwDenoiseHistoryDelta   = dwDenoiseHistoryDelta[dwDenoiseFactor];
             pLumaParams->dwDenoiseMaximumHistory = dwDenoiseMaximumHistory[dwDenoiseFactor];
@@ -1490,15 +1501,10 @@ MOS_STATUS VPHAL_VEBOX_STATE_G11_BASE::SetDNParams(
         pChromaParams->dwHistoryDeltaUV = NOISE_HISTORY_DELTA_DEFAULT;
         pChromaParams->dwHistoryMaxUV   = NOISE_HISTORY_MAX_DEFAULT;
 
-        // Denoise Slider case (no auto DN detect)
-        if (!pDNParams->bAutoDetect)
+        // Denoise Slider case, or auto DN detect updated on the CPU
+        if (bDenoiseSlider)
         {
-            dwDenoiseFactor = (uint32_t)pDNParams->fDenoiseFactor;
-
-            if (dwDenoiseFactor > NOISEFACTOR_MAX)
-            {
-                dwDenoiseFactor = NOISEFACTOR_MAX;
-            }
+            dwDenoiseFactor = dwChromaFactor;
 
             pChromaParams->dwLTDThresholdU  =
             pChromaParams->dwLTDThresholdV  = dwLTDThresholdUV[dwDenoiseFactor];
@@ -2013,6 +2019,7 @@ MOS_STATUS VPHAL_VEBOX_STATE_G11_BASE::SetupVeboxState(
     PVPHAL_VEBOX_RENDER_DATA                pRenderData         = GetLastExecRenderData();
     uint8_t*                                p3DLutData          = nullptr;
     uint32_t                                dw3DLutDataSize     = 0;
+    PMOS_RESOURCE                           p3DLookUpTable      = nullptr;
 
     VPHAL_RENDER_CHK_NULL(pVeboxStateCmdParams);
     VPHAL_RENDER_CHK_NULL(pVeboxState);
@@ -2087,25 +2094,32 @@ MOS_STATUS VPHAL_VEBOX_STATE_G11_BASE::SetupVeboxState(
         }
     }    
 
-    if (pRenderData->bHdr3DLut && pLUT3D)
+    // Bind the LUT shared by the contexts with the same tone mapping parameters
+    if (pRenderData->bHdr3DLut && pLUT3D && m_hdr3DLutGenerator)
+    {
+        p3DLookUpTable = m_hdr3DLutGenerator->Render(pRenderData->uiMaxDisplayLum, pRenderData->uiMaxContentLevelLum, pRenderData->hdrMode);
+        if (p3DLookUpTable == nullptr)
+        {
+            // No LUT was generated for these parameters, skip the 3D LUT for this
+            // frame rather than bind a table holding other parameters
+            VPHAL_RENDER_ASSERTMESSAGE("Failed to get the HDR 3D LUT, 3D LUT disabled for this frame.");
+        }
+    }
+
+    if (p3DLookUpTable)
     {
         pVeboxMode->ColorGamutExpansionEnable = true;
 
         // Set Vebox 3D Look Up Table Surfaces
-        pVeboxStateCmdParams->pVebox3DLookUpTables = &pVeboxState->Vebox3DLookUpTables.OsResource;
+        pVeboxStateCmdParams->pVebox3DLookUpTables = p3DLookUpTable;
         VPHAL_RENDER_CHK_STATUS(pOsInterface->pfnRegisterResource(
             pOsInterface,
-            &pVeboxState->Vebox3DLookUpTables.OsResource,
+            p3DLookUpTable,
             false,
             true));
         pVeboxStateCmdParams->Vebox3DLookUpTablesSurfCtrl.Value =
             pVeboxState->DnDiSurfMemObjCtl.Vebox3DLookUpTablesSurfMemObjCtl;
 
-        if (m_hdr3DLutGenerator)
-        {
-            m_hdr3DLutGenerator->Render(pRenderData->uiMaxDisplayLum, pRenderData->uiMaxContentLevelLum, pRenderData->hdrMode, &pVeboxState->Vebox3DLookUpTables);
-        }
-
         pLUT3D->ArbitrationPriorityControl     = 0;
         pLUT3D->Lut3dEnable                    = true;
         // 65^3 is the default.
@@ -42,7 +42,9 @@ MOS_STATUS MhwMiInterfaceG8::AddMiBatchBufferStartCmd(
     bool vcsEngineUsed =
         MOS_VCS_ENGINE_USED(m_osInterface->pfnGetGpuContext(m_osInterface));
 
-    mhw_mi_g8_X::MI_BATCH_BUFFER_START_CMD  cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_mi_g8_X::MI_BATCH_BUFFER_START_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     MHW_RESOURCE_PARAMS                     resourceParams;
     MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
     resourceParams.presResource     = &batchBuffer->OsResource;
@@ -63,7 +65,7 @@ MOS_STATUS MhwMiInterfaceG8::AddMiBatchBufferStartCmd(
     cmd.DW0.AddressSpaceIndicator = !IsGlobalGttInUse();
 
     // Send BB start command
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -84,7 +86,9 @@ MOS_STATUS MhwMiInterfaceG8::AddMiConditionalBatchBufferEndCmd(
     //          but after end of conditional batch buffer CP will be re-enabled.
     MHW_MI_CHK_STATUS(m_cpInterface->AddEpilog(m_osInterface, cmdBuffer));
 
-    mhw_mi_g8_X::MI_CONDITIONAL_BATCH_BUFFER_END_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_mi_g8_X::MI_CONDITIONAL_BATCH_BUFFER_END_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     cmd.DW0.UseGlobalGtt = IsGlobalGttInUse();
     cmd.DW0.CompareSemaphore = 1; // CompareDataDword is always assumed to be set
     cmd.DW1.CompareDataDword = params->dwValue;
@@ -104,7 +108,7 @@ MOS_STATUS MhwMiInterfaceG8::AddMiConditionalBatchBufferEndCmd(
         &resourceParams));
 
     // Send Conditional Batch Buffer End command
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     //Re-enable CP for Case 2
     MHW_MI_CHK_STATUS(m_cpInterface->AddProlog(m_osInterface, cmdBuffer));
@@ -292,7 +292,9 @@ MOS_STATUS MhwVeboxInterfaceG8::AddVeboxState(
     PMHW_VEBOX_MODE                  pVeboxMode;
     uint32_t                         uiInstanceBaseAddr  = 0;
     MHW_RESOURCE_PARAMS              ResourceParams;
-    mhw_vebox_g8_X::VEBOX_STATE_CMD  cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vebox_g8_X::VEBOX_STATE_CMD>(pCmdBuffer);
+    MHW_CHK_NULL_RETURN(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_CHK_NULL(m_osInterface);
     MHW_CHK_NULL(m_veboxHeap);
@@ -435,7 +437,7 @@ MOS_STATUS MhwVeboxInterfaceG8::AddVeboxState(
     cmd.DW1.HotPixelFilteringEnable     = pVeboxMode->HotPixelFilteringEnable;
     cmd.DW1.SingleSliceVeboxEnable      = pVeboxMode->SingleSliceVeboxEnable;
 
-    Mos_AddCommand(pCmdBuffer, &cmd, cmd.byteSize);
+    MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, &cmd));
 
 finish:
     return eStatus;
@@ -653,7 +655,9 @@ MOS_STATUS MhwVeboxInterfaceG8::AddVeboxDiIecp(
 {
     MOS_STATUS          eStatus;;
     MHW_RESOURCE_PARAMS ResourceParams;
-    mhw_vebox_g8_X::VEB_DI_IECP_CMD  cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vebox_g8_X::VEB_DI_IECP_CMD>(pCmdBuffer);
+    MHW_CHK_NULL_RETURN(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_CHK_NULL(m_osInterface);
     MHW_CHK_NULL(pCmdBuffer);
@@ -809,7 +813,7 @@ MOS_STATUS MhwVeboxInterfaceG8::AddVeboxDiIecp(
     cmd.DW1.EndingX   = pVeboxDiIecpCmdParams->dwEndingX;
     cmd.DW1.StartingX = pVeboxDiIecpCmdParams->dwStartingX;
 
-    Mos_AddCommand(pCmdBuffer, &cmd, cmd.byteSize);
+    MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, &cmd));
 
 finish:
     return eStatus;
@@ -590,7 +590,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMfxCmds::MFX_PIPE_MODE_SELECT_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_PIPE_MODE_SELECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MHW_MI_CHK_STATUS(this->m_cpInterface->SetProtectionSettingsForMfxPipeModeSelect((uint32_t *)&cmd));
 
@@ -623,7 +625,7 @@ protected:
 
         cmd.DW1.StandardSelect = CodecHal_GetStandardFromMode(params->Mode);
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -641,7 +643,9 @@ protected:
         MHW_MI_CHK_NULL(params->psSurface);
         MHW_ASSERT(params->Mode != CODECHAL_UNSUPPORTED_MODE);
 
-        typename TMfxCmds::MFX_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.SurfaceId = params->ucSurfaceStateId;
 
@@ -673,7 +677,7 @@ protected:
                 MOS_ALIGN_CEIL(params->psSurface->VPlaneOffset.iYOffset, MHW_VDBOX_MFX_UV_PLANE_ALIGNMENT_LEGACY);
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -694,7 +698,9 @@ protected:
         resourceParams.dwLsbNum = MHW_VDBOX_MFX_UPPER_BOUND_STATE_SHIFT;
         resourceParams.HwCommandType = MOS_MFX_INDIRECT_OBJ_BASE_ADDR;
 
-        typename TMfxCmds::MFX_IND_OBJ_BASE_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_IND_OBJ_BASE_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         // mode specific settings
         if (CodecHalIsDecodeModeVLD(params->Mode) || (params->Mode == CODECHAL_ENCODE_MODE_VP8))
@@ -784,7 +790,7 @@ protected:
                 &resourceParams));
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -806,7 +812,9 @@ protected:
 
         auto avcPicParams = params->pAvcPicParams;
 
-        typename TMfxCmds::MFX_AVC_IMG_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_AVC_IMG_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         uint32_t numMBs =
             (avcPicParams->pic_height_in_mbs_minus1 + 1) *
@@ -866,7 +874,7 @@ protected:
             cmd.DW16.InterViewOrderDisable = 0;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1037,7 +1045,9 @@ protected:
         resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
         resourceParams.HwCommandType = MOS_MFX_AVC_DIRECT_MODE;
 
-        typename TMfxCmds::MFX_AVC_DIRECTMODE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_AVC_DIRECTMODE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         if (!params->bDisableDmvBuffers)
         {
@@ -1166,7 +1176,7 @@ protected:
             }
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
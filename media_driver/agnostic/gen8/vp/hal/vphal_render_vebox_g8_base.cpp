@@ -677,6 +677,13 @@ MOS_STATUS VPHAL_VEBOX_STATE_G8_BASE::AllocateResources()
                   MOS_ROUNDUP_DIVIDE(VPHAL_VEBOX_STATISTICS_SIZE_G8 * sizeof(uint32_t), dwWidth);
     dwSize      = dwWidth * dwHeight;
 
+    // The statistics surface is reallocated when its size changes, release the
+    // CPU auto DN mapping of the current one first
+    if (pVeboxState->VeboxStatisticsSurface.dwWidth != dwSize)
+    {
+        pVeboxState->VeboxUnlockStatisticsSurface();
+    }
+
     VPHAL_RENDER_CHK_STATUS(VpHal_ReAllocateSurface(
                 pOsInterface,
                 &pVeboxState->VeboxStatisticsSurface,
@@ -784,6 +791,7 @@ void VPHAL_VEBOX_STATE_G8_BASE::FreeResources()
     }
 
     // Free Statistics data surface for VEBOX
+    pVeboxState->VeboxUnlockStatisticsSurface();
     pOsInterface->pfnFreeResource(
         pOsInterface,
         &pVeboxState->VeboxStatisticsSurface.OsResource);
@@ -1104,6 +1112,9 @@ MOS_STATUS VPHAL_VEBOX_STATE_G8_BASE::SetDNDIParams(
     MOS_STATUS                       eStatus;
     PVPHAL_DENOISE_PARAMS            pDNParams;
     uint32_t                         dwDenoiseFactor;
+    uint32_t                         dwLumaFactor;
+    uint32_t                         dwChromaFactor;
+    bool                             bDenoiseSlider;
     PVPHAL_VEBOX_RENDER_DATA         pRenderData = GetLastExecRenderData();
 
     VPHAL_RENDER_ASSERT(pSrcSurface);
@@ -1114,21 +1125,21 @@ MOS_STATUS VPHAL_VEBOX_STATE_G8_BASE::SetDNDIParams(
     eStatus             = MOS_STATUS_SUCCESS;
     pDNParams           = pSrcSurface->pDenoiseParams;
 
+    // Slider factors from the application, or from the CPU auto DN update
+    dwLumaFactor   = NOISEFACTOR_MIN;
+    dwChromaFactor = NOISEFACTOR_MIN;
+    bDenoiseSlider = VeboxGetDenoiseSliderFactors(pDNParams, &dwLumaFactor, &dwChromaFactor);
+
     // Set Luma DN params
     if (pRenderData->bDenoise)
     {
         // Setup Denoise Params
         GetLumaDefaultValue(pLumaParams);
 
-        // Denoise Slider case (no auto DN detect)
-        if (!pDNParams->bAutoDetect)
+        // Denoise Slider case, or auto DN detect updated on the CPU
+        if (bDenoiseSlider)
         {
-            dwDenoiseFactor = (uint32_t)pDNParams->fDenoiseFactor;
-
-            if (dwDenoiseFactor > NOISEFACTOR_MAX)
-            {
-                dwDenoiseFactor = NOISEFACTOR_MAX;
-            }
+            dwDenoiseFactor = dwLumaFactor;
 
             pLumaParams->dwGoodNeighborThreshold = dwGoodNeighborThreshold[dwDenoiseFactor];
             pLumaParams->dwDenoiseASDThreshold   = dwDenoiseASDThreshold[dwDenoiseFactor];
@@ -1149,15 +1160,10 @@ MOS_STATUS VPHAL_VEBOX_STATE_G8_BASE::SetDNDIParams(
         pChromaParams->dwHistoryDeltaUV = NOISE_HISTORY_DELTA_DEFAULT;
         pChromaParams->dwHistoryMaxUV   = NOISE_HISTORY_MAX_DEFAULT;
 
-        // Denoise Slider case (no auto DN detect)
-        if (!pDNParams->bAutoDetect)
+        // Denoise Slider case, or auto DN detect updated on the CPU
+        if (bDenoiseSlider)
         {
-            dwDenoiseFactor = (uint32_t)pDNParams->fDenoiseFactor;
-
-            if (dwDenoiseFactor > NOISEFACTOR_MAX)
-            {
-                dwDenoiseFactor = NOISEFACTOR_MAX;
-            }
+            dwDenoiseFactor = dwChromaFactor;
 
             pChromaParams->dwSTADThresholdU = dwSTADThresholdUV[dwDenoiseFactor];
             pChromaParams->dwSTADThresholdV = dwSTADThresholdUV[dwDenoiseFactor];
@@ -42,7 +42,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxPipeBufAddrCmd(
     resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
     resourceParams.HwCommandType = MOS_MFX_PIPE_BUF_ADDR;
 
-    mhw_vdbox_mfx_g8_bdw::MFX_PIPE_BUF_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g8_bdw::MFX_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     // Encoding uses both surfaces regardless of deblocking status
     if (params->psPreDeblockSurface != nullptr)
@@ -172,6 +174,8 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxPipeBufAddrCmd(
             &resourceParams));
     }
 
+    MHW_RESOURCE_PARAMS refResourceParams[CODEC_MAX_NUM_REF_FRAME];
+    uint32_t            numRefResources = 0;
     for (auto i = 0; i < CODEC_MAX_NUM_REF_FRAME; i++)
     {
         if (params->presReferences[i] != nullptr)
@@ -189,13 +193,18 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxPipeBufAddrCmd(
 
             resourceParams.dwSharedMocsOffset = 51 - resourceParams.dwLocationInCmd; // Common Prodected Data bit is in DW51
 
-            MHW_MI_CHK_STATUS(AddResourceToCmd(
-                m_osInterface,
-                cmdBuffer,
-                &resourceParams));
+            refResourceParams[numRefResources++] = resourceParams;
         }
     }
 
+    // Patch entries of all the references are added at once
+    MHW_MI_CHK_STATUS(Mhw_AddResourcesToCmd(
+        m_osInterface,
+        cmdBuffer,
+        AddResourceToCmd,
+        refResourceParams,
+        numRefResources));
+
     // there is only one control DW51 for all references
     cmd.DW51.MemoryObjectControlState =
         m_cacheabilitySettings[MOS_CODEC_RESOURCE_USAGE_REFERENCE_PICTURE_CODEC].Value;
@@ -231,7 +240,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxPipeBufAddrCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -252,7 +261,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxBspBufBaseAddrCmd(
     resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
     resourceParams.HwCommandType = MOS_MFX_BSP_BUF_BASE_ADDR;
 
-    mhw_vdbox_mfx_g8_bdw::MFX_BSP_BUF_BASE_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g8_bdw::MFX_BSP_BUF_BASE_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     if (params->presBsdMpcRowStoreScratchBuffer)
     {
@@ -305,7 +316,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxBspBufBaseAddrCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -322,7 +333,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxJpegPicCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->pJpegPicParams);
 
-    mhw_vdbox_mfx_g8_bdw::MFX_JPEG_PIC_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g8_bdw::MFX_JPEG_PIC_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     auto picParams = params->pJpegPicParams;
 
     if (picParams->m_chromaType == jpegRGB || picParams->m_chromaType == jpegBGR)
@@ -362,7 +375,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxJpegPicCmd(
     cmd.DW2.FrameWidthInBlocksMinus1 = params->dwWidthInBlocks;
     cmd.DW2.FrameHeightInBlocksMinus1 = params->dwHeightInBlocks;
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -378,7 +391,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxDecodeVp8PicCmd(
     MHW_MI_CHK_NULL(cmdBuffer);
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_mfx_g8_bdw::MFX_VP8_PIC_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g8_bdw::MFX_VP8_PIC_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
     auto vp8PicParams = params->pVp8PicParams;
     auto vp8IqMatrixParams = params->pVp8IqMatrixParams;
 
@@ -587,7 +602,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG8Bdw::AddMfxDecodeVp8PicCmd(
             &resourceParams));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -5313,6 +5313,12 @@ MOS_STATUS CodechalEncHevcStateG9::RequestSshAndVerifyCommandBufferSize(PMHW_KER
     auto maxBtCount = m_singleTaskPhaseSupported ?
         m_maxBtCount : kernelState->KernelParams.iBTCount;
 
+    // The merged MFE phase holds one SSH slot of maxBtCount entries per stream in this submission
+    if (m_mfeMbEncPhase)
+    {
+        maxBtCount *= m_mfeEncodeParams.submitNumber;
+    }
+
     CODECHAL_ENCODE_CHK_STATUS_RETURN(m_stateHeapInterface->pfnRequestSshSpaceForCmdBuf(
         m_stateHeapInterface,
         maxBtCount));
@@ -7694,7 +7700,7 @@ MOS_STATUS CodechalEncHevcStateG9::Encode8x8PBMbEncKernel()
             CODECHAL_MEDIA_STATE_HEVC_B_MBENC));
     )
 
-    m_lastTaskInPhase = true;
+    m_lastTaskInPhase = IsLastTaskInMbEncPhase();
     eStatus = Encode8x8BPakKernel(curbe);
 
     return eStatus;
@@ -9437,6 +9443,14 @@ MOS_STATUS CodechalEncHevcStateG9::EncodeKernelFunctions()
     m_firstTaskInPhase = true;
     m_lastTaskInPhase  = false;
 
+    // For MFE, the I kernels of I frames are merged with the other streams. The kernels
+    // ahead of them are not merged and are submitted by this stream on their own.
+    bool singleTaskPhaseSupported = m_singleTaskPhaseSupported;
+    if (IsMfeMbEncEnabled() && m_hevcPicParams->CodingType == I_TYPE)
+    {
+        m_singleTaskPhaseSupported = false;
+    }
+
     // ROI uses the BRC LCU update kernel, even in CQP.  So we will call it
     // first if in CQP.  It has no other kernel execution dependencies, even
     // that brc is not initialized is not a dependency
@@ -9478,7 +9492,10 @@ MOS_STATUS CodechalEncHevcStateG9::EncodeKernelFunctions()
                 }
             }
 
+            m_singleTaskPhaseSupported = singleTaskPhaseSupported;
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(MfeMbEncPhaseBegin());
             CODECHAL_ENCODE_CHK_STATUS_RETURN(Encode8x8PBMbEncKernel());
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(MfeMbEncPhaseEnd());
         }
     }
     else
@@ -9505,6 +9522,12 @@ MOS_STATUS CodechalEncHevcStateG9::EncodeKernelFunctions()
             }
         }
 
+        m_singleTaskPhaseSupported = singleTaskPhaseSupported;
+        if (m_hevcPicParams->CodingType == I_TYPE)
+        {
+            CODECHAL_ENCODE_CHK_STATUS_RETURN(MfeMbEncPhaseBegin());
+        }
+
         //Step 1: perform 2:1 down-scaling
         if (m_hevcSeqParams->bit_depth_luma_minus8 == 0)  // use this for 8 bit only case.
         {
@@ -9551,8 +9574,9 @@ MOS_STATUS CodechalEncHevcStateG9::EncodeKernelFunctions()
         CODECHAL_ENCODE_CHK_STATUS_RETURN(Encode8x8PUKernel());
 
         //Step 6: 8x8 PU FMODE
-        m_lastTaskInPhase = true;
+        m_lastTaskInPhase = IsLastTaskInMbEncPhase();
         CODECHAL_ENCODE_CHK_STATUS_RETURN(Encode8x8PUFMODEKernel());
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(MfeMbEncPhaseEnd());
 
         CODECHAL_DEBUG_TOOL(
             CODECHAL_ENCODE_CHK_STATUS_RETURN(m_debugInterface->DumpYUVSurface(
@@ -9606,6 +9630,8 @@ MOS_STATUS CodechalEncHevcStateG9::EncodeKernelFunctions()
         )
     }
 
+    m_singleTaskPhaseSupported = singleTaskPhaseSupported;
+
     // Sync-wait can be executed after I-kernel is submitted before there is no dependency for I to wait for PAK to be ready
     CODECHAL_ENCODE_CHK_STATUS_RETURN(WaitForPak());
 
@@ -9615,6 +9641,13 @@ MOS_STATUS CodechalEncHevcStateG9::EncodeKernelFunctions()
         m_firstTaskInPhase = true;
         m_lastTaskInPhase = false;
 
+        // For MFE, the B kernels are merged with the other streams. The kernels
+        // ahead of them are not merged and are submitted by this stream on their own.
+        if (IsMfeMbEncEnabled())
+        {
+            m_singleTaskPhaseSupported = false;
+        }
+
         // BRC and MbEnc are included in the same task phase
         if (m_brcEnabled && !brcUpdateComplete)
         {
@@ -9667,7 +9700,10 @@ MOS_STATUS CodechalEncHevcStateG9::EncodeKernelFunctions()
             }
         }
 
+        m_singleTaskPhaseSupported = singleTaskPhaseSupported;
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(MfeMbEncPhaseBegin());
         CODECHAL_ENCODE_CHK_STATUS_RETURN(Encode8x8PBMbEncKernel());
+        CODECHAL_ENCODE_CHK_STATUS_RETURN(MfeMbEncPhaseEnd());
     }
 
     // Notify PAK engine once ENC is done
@@ -440,7 +440,9 @@ MOS_STATUS MhwVeboxInterfaceG9::AddVeboxState(
     MHW_RESOURCE_PARAMS             ResourceParams;
     PMHW_VEBOX_HEAP                 pVeboxHeap;
     MOS_ALLOC_GFXRES_PARAMS         AllocParamsForBufferLinear;
-    mhw_vebox_g9_X::VEBOX_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vebox_g9_X::VEBOX_STATE_CMD>(pCmdBuffer);
+    MHW_CHK_NULL_RETURN(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_CHK_NULL(m_osInterface);
     MHW_CHK_NULL(pCmdBuffer);
@@ -662,7 +664,7 @@ MOS_STATUS MhwVeboxInterfaceG9::AddVeboxState(
     cmd.DW1.SinglePipeEnable             = pVeboxMode->SinglePipeIECPEnable;
     cmd.DW1.ForwardGammaCorrectionEnable = pVeboxMode->ForwardGammaCorrectionEnable;
 
-    Mos_AddCommand(pCmdBuffer, &cmd, cmd.byteSize);
+    MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, &cmd));
 
 finish:
     return eStatus;
@@ -1400,7 +1402,9 @@ MOS_STATUS MhwVeboxInterfaceG9::AddVeboxDiIecp(
     MOS_STATUS                      eStatus;
     PMOS_INTERFACE                  pOsInterface;
     MHW_RESOURCE_PARAMS             ResourceParams;
-    mhw_vebox_g9_X::VEB_DI_IECP_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vebox_g9_X::VEB_DI_IECP_CMD>(pCmdBuffer);
+    MHW_CHK_NULL_RETURN(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     MHW_CHK_NULL(m_osInterface);
     MHW_CHK_NULL(pCmdBuffer);
@@ -1600,7 +1604,7 @@ MOS_STATUS MhwVeboxInterfaceG9::AddVeboxDiIecp(
     cmd.DW1.EndingX   = pVeboxDiIecpCmdParams->dwEndingX;
     cmd.DW1.StartingX = pVeboxDiIecpCmdParams->dwStartingX;
 
-    Mos_AddCommand(pCmdBuffer, &cmd, cmd.byteSize);
+    MHW_CHK_STATUS(Mhw_CommitCommand(pCmdBuffer, &cmd));
 
 finish:
     return eStatus;
@@ -563,7 +563,9 @@ protected:
 
         MHW_MI_CHK_NULL(params);
 
-        typename THcpCmds::HCP_PIPE_MODE_SELECT_CMD  cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_PIPE_MODE_SELECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.CodecStandardSelect = CodecHal_GetStandardFromMode(params->Mode) - CODECHAL_HCP_BASE;
         cmd.DW1.DeblockerStreamoutEnable = params->bDeblockerStreamOutEnable;
@@ -577,7 +579,7 @@ protected:
             cmd.DW1.CodecSelect = cmd.CODEC_SELECT_ENCODE;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -695,7 +697,9 @@ protected:
         MHW_MI_CHK_NULL(params);
 
         MHW_RESOURCE_PARAMS                            resourceParams;
-        typename THcpCmds::HCP_PIPE_BUF_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         bool                                           firstRefPic = true;
 
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
@@ -962,6 +966,9 @@ protected:
         cmd.ReferencePictureBaseAddressMemoryAddressAttributes.DW0.Value |=
             this->m_cacheabilitySettings[MOS_CODEC_RESOURCE_USAGE_REFERENCE_PICTURE_CODEC].Value;
 
+        MHW_RESOURCE_PARAMS refResourceParams[CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC];
+        uint32_t            numRefResources = 0;
+
         // NOTE: for both HEVC and VP9, set all the 8 ref pic addresses in HCP_PIPE_BUF_ADDR_STATE command to valid addresses for error concealment purpose
         for (uint32_t i = 0; i < CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC; i++)
         {
@@ -986,13 +993,18 @@ protected:
 
                 resourceParams.dwSharedMocsOffset = 53 - resourceParams.dwLocationInCmd; // Common Prodected Data bit is in DW53
 
-                MHW_MI_CHK_STATUS(this->pfnAddResourceToCmd(
-                    this->m_osInterface,
-                    cmdBuffer,
-                    &resourceParams));
+                refResourceParams[numRefResources++] = resourceParams;
             }
         }
 
+        // Patch entries of all the references are added at once
+        MHW_MI_CHK_STATUS(Mhw_AddResourcesToCmd(
+            this->m_osInterface,
+            cmdBuffer,
+            this->pfnAddResourceToCmd,
+            refResourceParams,
+            numRefResources));
+
         // Reset dwSharedMocsOffset
         resourceParams.dwSharedMocsOffset = MOS_MFX_PIPE_BUF_ADDR;
 
@@ -1183,7 +1195,7 @@ protected:
                 &resourceParams));
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1199,7 +1211,9 @@ protected:
         MHW_MI_CHK_NULL(params);
 
         MHW_RESOURCE_PARAMS resourceParams;
-        typename THcpCmds::HCP_IND_OBJ_BASE_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_IND_OBJ_BASE_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
         resourceParams.dwLsbNum = MHW_VDBOX_HCP_UPPER_BOUND_STATE_SHIFT;
@@ -1277,7 +1291,7 @@ protected:
             }
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1404,7 +1418,9 @@ protected:
         MHW_MI_CHK_NULL(params->pHevcEncSeqParams);
         MHW_MI_CHK_NULL(params->pHevcEncPicParams);
 
-        typename THcpCmds::HCP_PIC_STATE_CMD  cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename THcpCmds::HCP_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         auto hevcSeqParams  = params->pHevcEncSeqParams;
         auto hevcPicParams  = params->pHevcEncPicParams;
@@ -1517,7 +1533,7 @@ protected:
             }
         }
     
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, cmd.byteSize));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
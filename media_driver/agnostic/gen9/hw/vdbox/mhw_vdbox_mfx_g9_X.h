@@ -682,7 +682,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMfxCmds::MFX_PIPE_MODE_SELECT_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_PIPE_MODE_SELECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MHW_MI_CHK_STATUS(this->m_cpInterface->SetProtectionSettingsForMfxPipeModeSelect((uint32_t *)&cmd));
 
@@ -729,7 +731,7 @@ protected:
             cmd.DW1.FrameStatisticsStreamoutEnable = 1;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -759,7 +761,9 @@ protected:
             uvPlaneAlignment = MHW_VDBOX_MFX_UV_PLANE_ALIGNMENT_LEGACY;
         }
 
-        typename TMfxCmds::MFX_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         cmd.DW1.SurfaceId = params->ucSurfaceStateId;
 
         cmd.DW2.Height = params->psSurface->dwHeight - 1;
@@ -802,7 +806,7 @@ protected:
                 MOS_ALIGN_CEIL(params->psSurface->VPlaneOffset.iYOffset, uvPlaneAlignment);
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -823,7 +827,9 @@ protected:
         resourceParams.dwLsbNum = MHW_VDBOX_MFX_UPPER_BOUND_STATE_SHIFT;
         resourceParams.HwCommandType = MOS_MFX_INDIRECT_OBJ_BASE_ADDR;
 
-        typename TMfxCmds::MFX_IND_OBJ_BASE_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_IND_OBJ_BASE_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         // mode specific settings
         if (CodecHalIsDecodeModeVLD(params->Mode) || (params->Mode == CODECHAL_ENCODE_MODE_VP8))
@@ -913,7 +919,7 @@ protected:
                 &resourceParams));
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -934,7 +940,9 @@ protected:
         resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
         resourceParams.HwCommandType = MOS_MFX_BSP_BUF_BASE_ADDR;
 
-        typename TMfxCmds::MFX_BSP_BUF_BASE_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_BSP_BUF_BASE_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         if (this->m_bsdMpcRowstoreCache.bEnabled)         // mbaff and non mbaff mode for all resolutions
         {
@@ -1000,7 +1008,7 @@ protected:
                 &resourceParams));
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1022,7 +1030,9 @@ protected:
 
         auto avcPicParams = params->pAvcPicParams;
 
-        typename TMfxCmds::MFX_AVC_IMG_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_AVC_IMG_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         uint32_t numMBs =
             (avcPicParams->pic_height_in_mbs_minus1 + 1) *
@@ -1080,7 +1090,7 @@ protected:
             cmd.DW16_17.InterViewOrderDisable = 0;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1285,7 +1295,9 @@ protected:
         resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
         resourceParams.HwCommandType = MOS_MFX_AVC_DIRECT_MODE;
 
-        typename TMfxCmds::MFX_AVC_DIRECTMODE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_AVC_DIRECTMODE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         if (!params->bDisableDmvBuffers)
         {
@@ -1410,7 +1422,7 @@ protected:
             }
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -1637,7 +1649,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pJpegPicParams);
 
-        typename TMfxCmds::MFX_JPEG_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_JPEG_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         auto picParams = params->pJpegPicParams;
 
         if (picParams->m_chromaType == jpegRGB || picParams->m_chromaType == jpegBGR)
@@ -1676,7 +1690,7 @@ protected:
         cmd.DW2.Obj0.FrameWidthInBlocksMinus1 = params->dwWidthInBlocks;
         cmd.DW2.Obj0.FrameHeightInBlocksMinus1 = params->dwHeightInBlocks;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1693,7 +1707,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pJpegEncodePicParams);
 
-        typename TMfxCmds::MFX_JPEG_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_JPEG_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         auto picParams = params->pJpegEncodePicParams;
 
         cmd.DW1.Obj0.InputSurfaceFormatYuv = picParams->m_inputSurfaceFormat;
@@ -1754,7 +1770,7 @@ protected:
         cmd.DW2.Obj0.FrameWidthInBlocksMinus1 = (((picParams->m_picWidth + (horizontalSamplingFactor * 8 - 1)) / (horizontalSamplingFactor * 8)) * horizontalSamplingFactor) - 1;
         cmd.DW2.Obj0.FrameHeightInBlocksMinus1 = (((picParams->m_picHeight + (verticalSamplingFactor * 8 - 1)) / (verticalSamplingFactor * 8)) * verticalSamplingFactor) - 1;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1809,7 +1825,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMfxCmds::MFC_JPEG_HUFF_TABLE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFC_JPEG_HUFF_TABLE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.HuffTableId = params->HuffTableID;
 
@@ -1830,7 +1848,7 @@ protected:
                 | ((params->pACCodeValues[j] & 0xFFFF) << 8);
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1847,14 +1865,23 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->pJpegEncodeScanParams);
 
-        typename TMfxCmds::MFC_JPEG_SCAN_OBJECT_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFC_JPEG_SCAN_OBJECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
-        uint32_t horizontalSamplingFactor = this->GetJpegHorizontalSamplingFactorForY(params->inputSurfaceFormat);
-        uint32_t verticalSamplingFactor = this->GetJpegVerticalSamplingFactorForY(params->inputSurfaceFormat);
-        cmd.DW1.McuCount = ((params->dwPicWidth + (horizontalSamplingFactor * 8 - 1)) / (horizontalSamplingFactor * 8))
-            * ((params->dwPicHeight + (verticalSamplingFactor * 8 - 1)) / (verticalSamplingFactor * 8));
+        if (params->dwMcuCount != 0)
+        {
+            cmd.DW1.McuCount = params->dwMcuCount;
+        }
+        else
+        {
+            uint32_t horizontalSamplingFactor = this->GetJpegHorizontalSamplingFactorForY(params->inputSurfaceFormat);
+            uint32_t verticalSamplingFactor = this->GetJpegVerticalSamplingFactorForY(params->inputSurfaceFormat);
+            cmd.DW1.McuCount = ((params->dwPicWidth + (horizontalSamplingFactor * 8 - 1)) / (horizontalSamplingFactor * 8))
+                * ((params->dwPicHeight + (verticalSamplingFactor * 8 - 1)) / (verticalSamplingFactor * 8));
+        }
         cmd.DW2.RestartInterval = params->pJpegEncodeScanParams->m_restartInterval;
-        cmd.DW2.IsLastScan = 1; // Always 1 since there is only 1 scan in the JPEG frame
+        cmd.DW2.IsLastScan = params->isLastScan ? 1 : 0;
         cmd.DW2.HeadPresentFlag = 1; // There will always be MFC_JPEG_PAK_INSERT_OBJECT commands sent
 
         for (auto i = 0; i < jpegNumComponent; i++)
@@ -1863,7 +1890,7 @@ protected:
             cmd.DW2.HuffmanAcTable |= (params->pJpegEncodeScanParams->m_acCodingTblSelector[i]) << i;
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -1879,7 +1906,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TMfxCmds::MFX_VP8_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_VP8_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         auto vp8PicParams = params->pVp8PicParams;
         auto vp8IqMatrixParams = params->pVp8IqMatrixParams;
 
@@ -2088,7 +2117,7 @@ protected:
                 &resourceParams));
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -2107,7 +2136,9 @@ protected:
         MHW_MI_CHK_NULL(params->pEncodeVP8PicParams);
         MHW_MI_CHK_NULL(params->pEncodeVP8QuantData);
 
-        typename TMfxCmds::MFX_VP8_PIC_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_VP8_PIC_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
         auto vp8SeqParams = params->pEncodeVP8SeqParams;
         auto vp8PicParams = params->pEncodeVP8PicParams;
         auto vp8QuantData = params->pEncodeVP8QuantData;
@@ -2257,7 +2288,7 @@ protected:
         cmd.DW34.Modelfdelta2ForNearestNearAndNewMode = vp8PicParams->mode_lf_delta[2];
         cmd.DW34.Modelfdelta3ForSplitmvMode = vp8PicParams->mode_lf_delta[3];
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -2396,7 +2427,9 @@ protected:
             return eStatus;
         }
 
-        typename TMfxCmds::MFX_VP8_BSP_BUF_BASE_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TMfxCmds::MFX_VP8_BSP_BUF_BASE_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MHW_RESOURCE_PARAMS resourceParams;
         MOS_ZeroMemory(&resourceParams, sizeof(resourceParams));
@@ -2517,7 +2550,7 @@ protected:
                 &resourceParams));
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return eStatus;
     }
@@ -182,7 +182,9 @@ protected:
         MHW_MI_CHK_NULL(cmdBuffer);
         MHW_MI_CHK_NULL(params);
 
-        typename TVdencCmds::VDENC_PIPE_MODE_SELECT_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_PIPE_MODE_SELECT_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.DW1.StandardSelect                 = CodecHal_GetStandardFromMode(params->Mode);
         cmd.DW1.FrameStatisticsStreamOutEnable = 1;
@@ -190,7 +192,7 @@ protected:
         cmd.DW1.PakThresholdCheckEnable        = params->bDynamicSliceEnable;
         cmd.DW1.VdencStreamInEnable            = params->bVdencStreamInEnable;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -208,7 +210,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(this->m_osInterface);
 
-        typename TVdencCmds::VDENC_PIPE_BUF_ADDR_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         MOS_MEMCOMP_STATE   mmcMode = MOS_MEMCOMP_DISABLED;
         MHW_RESOURCE_PARAMS resourceParams;
@@ -432,7 +436,7 @@ protected:
             }
         }
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -447,7 +451,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->psSurface);
 
-        typename TVdencCmds::VDENC_REF_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_REF_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.Dwords25.DW0.Width                       = params->psSurface->dwWidth - 1;
         cmd.Dwords25.DW0.Height                      = params->psSurface->dwHeight - 1;
@@ -465,7 +471,7 @@ protected:
         cmd.Dwords25.DW1.SurfacePitch     = params->psSurface->dwPitch - 1;
         cmd.Dwords25.DW2.YOffsetForUCb    = cmd.Dwords25.DW3.YOffsetForVCr = params->psSurface->UPlaneOffset.iYOffset;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -483,7 +489,9 @@ protected:
         MHW_MI_CHK_NULL(params);
         MHW_MI_CHK_NULL(params->psSurface);
 
-        typename TVdencCmds::VDENC_DS_REF_SURFACE_STATE_CMD cmd;
+        auto cmdPtr = Mhw_ReserveCommand<typename TVdencCmds::VDENC_DS_REF_SURFACE_STATE_CMD>(cmdBuffer);
+        MHW_MI_CHK_NULL(cmdPtr);
+        auto &cmd = *cmdPtr;
 
         cmd.Dwords25.DW0.Width                       = params->psSurface->dwWidth - 1;
         cmd.Dwords25.DW0.Height                      = params->psSurface->dwHeight - 1;
@@ -500,7 +508,7 @@ protected:
         cmd.Dwords25.DW1.SurfacePitch     = params->psSurface->dwPitch - 1;
         cmd.Dwords25.DW2.YOffsetForUCb    = cmd.Dwords25.DW3.YOffsetForVCr = params->psSurface->UPlaneOffset.iYOffset;
 
-        MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+        MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
         return MOS_STATUS_SUCCESS;
     }
@@ -29,6 +29,7 @@
 #include "vphal_render_vebox_g9_base.h"
 #include "vphal_render_sfc_g9_base.h"
 #include "vphal_render_vebox_util_base.h"
+#include "vphal_render_vebox_denoise_params.h"
 #include "vpkrnheader.h"
 #if defined(ENABLE_KERNELS) && !defined(_FULL_OPEN_SOURCE)
 #include "igvpkrn_isa_g9.h"
@@ -657,6 +658,13 @@ MOS_STATUS VPHAL_VEBOX_STATE_G9_BASE::AllocateResources()
                   MOS_ROUNDUP_DIVIDE(VPHAL_VEBOX_STATISTICS_SIZE_G9 * sizeof(uint32_t), dwWidth);
     dwSize      = dwWidth * dwHeight;
 
+    // The statistics surface is reallocated when its size changes, release the
+    // CPU auto DN mapping of the current one first
+    if (pVeboxState->VeboxStatisticsSurface.dwWidth != dwSize)
+    {
+        pVeboxState->VeboxUnlockStatisticsSurface();
+    }
+
     VPHAL_RENDER_CHK_STATUS(VpHal_ReAllocateSurface(
                 pOsInterface,
                 &pVeboxState->VeboxStatisticsSurface,
@@ -786,6 +794,7 @@ void VPHAL_VEBOX_STATE_G9_BASE::FreeResources()
     }
 
     // Free Statistics data surface for VEBOX
+    pVeboxState->VeboxUnlockStatisticsSurface();
     pOsInterface->pfnFreeResource(
         pOsInterface,
         &pVeboxState->VeboxStatisticsSurface.OsResource);
@@ -1278,6 +1287,9 @@ MOS_STATUS VPHAL_VEBOX_STATE_G9_BASE::SetDNDIParams(
     MOS_STATUS                       eStatus;
     PVPHAL_DENOISE_PARAMS            pDNParams;
     uint32_t                         dwDenoiseFactor;
+    uint32_t                         dwLumaFactor;
+    uint32_t                         dwChromaFactor;
+    bool                             bDenoiseSlider;
     PVPHAL_VEBOX_RENDER_DATA         pRenderData = GetLastExecRenderData();
 
     VPHAL_RENDER_ASSERT(pSrcSurface);
@@ -1290,6 +1302,11 @@ MOS_STATUS VPHAL_VEBOX_STATE_G9_BASE::SetDNDIParams(
 
     VPHAL_RENDER_ASSERT(pDNParams);
 
+    // Slider factors from the application, or from the CPU auto DN update
+    dwLumaFactor   = NOISEFACTOR_MIN;
+    dwChromaFactor = NOISEFACTOR_MIN;
+    bDenoiseSlider = VeboxGetDenoiseSliderFactors(pDNParams, &dwLumaFactor, &dwChromaFactor);
+
     // Set Luma DN params
     if (pRenderData->bDenoise)
     {
@@ -1312,15 +1329,10 @@ MOS_STATUS VPHAL_VEBOX_STATE_G9_BASE::SetDNDIParams(
         pRenderData->VeboxDNDIParams.dwPixRangeWeight[4]    = NOISE_BLF_RANGE_WGTS4_DEFAULT;
         pRenderData->VeboxDNDIParams.dwPixRangeWeight[5]    = NOISE_BLF_RANGE_WGTS5_DEFAULT;
 
-        // Denoise Slider case (no auto DN detect)
-        if (!pDNParams->bAutoDetect)
+        // Denoise Slider case, or auto DN detect updated on the CPU
+        if (bDenoiseSlider)
         {
-            dwDenoiseFactor = (uint32_t)pDNParams->fDenoiseFactor;
-
-            if (dwDenoiseFactor > NOISEFACTOR_MAX)
-            {
-                dwDenoiseFactor = NOISEFACTOR_MAX;
-            }
+            dwDenoiseFactor = dwLumaFactor;
 
             pLumaParams->dwDenoiseHistoryDelta   = dwDenoiseHistoryDelta[dwDenoiseFactor];
             pLumaParams->dwDenoiseMaximumHistory = dwDenoiseMaximumHistory[dwDenoiseFactor];
@@ -1354,15 +1366,10 @@ MOS_STATUS VPHAL_VEBOX_STATE_G9_BASE::SetDNDIParams(
         pChromaParams->dwHistoryDeltaUV = NOISE_HISTORY_DELTA_DEFAULT;
         pChromaParams->dwHistoryMaxUV   = NOISE_HISTORY_MAX_DEFAULT;
 
-        // Denoise Slider case (no auto DN detect)
-        if (!pDNParams->bAutoDetect)
+        // Denoise Slider case, or auto DN detect updated on the CPU
+        if (bDenoiseSlider)
         {
-            dwDenoiseFactor = (uint32_t)pDNParams->fDenoiseFactor;
-
-            if (dwDenoiseFactor > NOISEFACTOR_MAX)
-            {
-                dwDenoiseFactor = NOISEFACTOR_MAX;
-            }
+            dwDenoiseFactor = dwChromaFactor;
 
             pChromaParams->dwLTDThresholdU  =
             pChromaParams->dwLTDThresholdV  = dwLTDThresholdUV[dwDenoiseFactor];
@@ -2260,6 +2267,16 @@ VphalSfcState* VPHAL_VEBOX_STATE_G9_BASE::CreateSfcState()
     return sfcState;
 }
 
+//!
+//! \brief    Get the bits of the DNDI state computed by the HVS denoise kernel
+//! \return   const uint32_t*
+//!           Masks of the Gen9 DNDI state dwords
+//!
+const uint32_t *VPHAL_VEBOX_STATE_G9_BASE::GetHVSDenoiseDndiDwordMask()
+{
+    return g_HVSDenoiseDndiDwordMask;
+}
+
 VPHAL_VEBOX_STATE_G9_BASE::VPHAL_VEBOX_STATE_G9_BASE(
     PMOS_INTERFACE                  pOsInterface,
     PMHW_VEBOX_INTERFACE            pVeboxInterface,
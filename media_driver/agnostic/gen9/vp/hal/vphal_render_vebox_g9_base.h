@@ -363,6 +363,8 @@ protected:
         PVPHAL_DNUV_PARAMS              pChromaParams);
 
     virtual VphalSfcState* CreateSfcState();
+
+    virtual const uint32_t *GetHVSDenoiseDndiDwordMask();
 };
 
 #endif // __VPHAL_RENDER_VEBOX_G9_BASE_H__
@@ -42,7 +42,9 @@ MOS_STATUS MhwVdboxMfxInterfaceG9Bxt::AddMfxPipeBufAddrCmd(
     resourceParams.dwLsbNum = MHW_VDBOX_MFX_GENERAL_STATE_SHIFT;
     resourceParams.HwCommandType = MOS_MFX_PIPE_BUF_ADDR;
 
-    mhw_vdbox_mfx_g9_bxt::MFX_PIPE_BUF_ADDR_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_mfx_g9_bxt::MFX_PIPE_BUF_ADDR_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     // Encoding uses both surfaces regardless of deblocking status
     if (params->psPreDeblockSurface != nullptr)
@@ -210,6 +212,8 @@ MOS_STATUS MhwVdboxMfxInterfaceG9Bxt::AddMfxPipeBufAddrCmd(
             &resourceParams));
     }
 
+    MHW_RESOURCE_PARAMS refResourceParams[CODEC_MAX_NUM_REF_FRAME];
+    uint32_t            numRefResources = 0;
     for (auto i = 0; i < CODEC_MAX_NUM_REF_FRAME; i++)
     {
         if (params->presReferences[i] != nullptr)
@@ -243,13 +247,18 @@ MOS_STATUS MhwVdboxMfxInterfaceG9Bxt::AddMfxPipeBufAddrCmd(
 
             resourceParams.dwSharedMocsOffset = 51 - resourceParams.dwLocationInCmd; // Common Prodected Data bit is in DW51
 
-            MHW_MI_CHK_STATUS(AddResourceToCmd(
-                m_osInterface,
-                cmdBuffer,
-                &resourceParams));
+            refResourceParams[numRefResources++] = resourceParams;
         }
     }
 
+    // Patch entries of all the references are added at once
+    MHW_MI_CHK_STATUS(Mhw_AddResourcesToCmd(
+        m_osInterface,
+        cmdBuffer,
+        AddResourceToCmd,
+        refResourceParams,
+        numRefResources));
+
     // There is only one control DW51 for all references
     cmd.DW51.MemoryObjectControlState =
         m_cacheabilitySettings[MOS_CODEC_RESOURCE_USAGE_REFERENCE_PICTURE_CODEC].Value;
@@ -326,7 +335,7 @@ MOS_STATUS MhwVdboxMfxInterfaceG9Bxt::AddMfxPipeBufAddrCmd(
         MHW_MI_CHK_STATUS(m_osInterface->pfnSetMemoryCompressionMode(m_osInterface, resourceParams.presResource, params->Ps4xDsSurfMmcState));
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return eStatus;
 }
@@ -36,7 +36,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Bxt::AddVdencSrcSurfaceStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->psSurface);
 
-    mhw_vdbox_vdenc_g9_bxt::VDENC_SRC_SURFACE_STATE_CMD  cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g9_bxt::VDENC_SRC_SURFACE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     cmd.Dwords25.DW0.Width                       = params->psSurface->dwWidth - 1;
     cmd.Dwords25.DW0.Height                      = params->psSurface->dwHeight - 1;
@@ -53,7 +55,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Bxt::AddVdencSrcSurfaceStateCmd(
     cmd.Dwords25.DW2.YOffsetForUCb = cmd.Dwords25.DW3.YOffsetForVCr =
         MOS_ALIGN_CEIL(params->psSurface->UPlaneOffset.iYOffset, MHW_VDBOX_MFX_RAW_UV_PLANE_ALIGNMENT_GEN9);
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -279,13 +281,15 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Bxt::AddVdencWalkerStateCmd(
     MHW_MI_CHK_NULL(cmdBuffer);
     MHW_MI_CHK_NULL(params);
 
-    mhw_vdbox_vdenc_g9_bxt::VDENC_WALKER_STATE_CMD  cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g9_bxt::VDENC_WALKER_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     // MB start X/Y posistion set to 0
     cmd.DW1.MbLcuStartXPosition = 0;
     cmd.DW1.MbLcuStartYPosition = 0;
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -81,7 +81,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Kbl::AddVdencSrcSurfaceStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->psSurface);
 
-    mhw_vdbox_vdenc_g9_kbl::VDENC_SRC_SURFACE_STATE_CMD  cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g9_kbl::VDENC_SRC_SURFACE_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     cmd.Dwords25.DW0.Width                       = params->psSurface->dwWidth - 1;
     cmd.Dwords25.DW0.Height                      = params->psSurface->dwHeight - 1;
@@ -99,7 +101,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Kbl::AddVdencSrcSurfaceStateCmd(
     cmd.Dwords25.DW2.YOffsetForUCb = cmd.Dwords25.DW3.YOffsetForVCr =
         MOS_ALIGN_CEIL(params->psSurface->UPlaneOffset.iYOffset, MHW_VDBOX_MFX_RAW_UV_PLANE_ALIGNMENT_GEN9);
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -338,7 +340,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Kbl::AddVdencWalkerStateCmd(
     auto avcPicParams = params->pAvcPicParams;
     auto avcSlcParams = params->pAvcSlcParams;
 
-    mhw_vdbox_vdenc_g9_kbl::VDENC_WALKER_STATE_CMD  cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g9_kbl::VDENC_WALKER_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     cmd.DW1.MbLcuStartXPosition = 0;
 
@@ -356,7 +360,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Kbl::AddVdencWalkerStateCmd(
         cmd.DW3.Log2WeightDenomLuma = avcSlcParams->luma_log2_weight_denom;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -371,7 +375,9 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Kbl::AddVdencAvcWeightsOffsetsStateCmd(
     MHW_MI_CHK_NULL(params);
     MHW_MI_CHK_NULL(params->pAvcPicParams);
 
-    mhw_vdbox_vdenc_g9_kbl::VDENC_WEIGHTSOFFSETS_STATE_CMD cmd;
+    auto cmdPtr = Mhw_ReserveCommand<mhw_vdbox_vdenc_g9_kbl::VDENC_WEIGHTSOFFSETS_STATE_CMD>(cmdBuffer);
+    MHW_MI_CHK_NULL(cmdPtr);
+    auto &cmd = *cmdPtr;
 
     auto avcPicParams = params->pAvcPicParams;
 
@@ -395,7 +401,7 @@ MOS_STATUS MhwVdboxVdencInterfaceG9Kbl::AddVdencAvcWeightsOffsetsStateCmd(
         cmd.DW2.OffsetForwardReference2  = 0;
     }
 
-    MHW_MI_CHK_STATUS(Mos_AddCommand(cmdBuffer, &cmd, sizeof(cmd)));
+    MHW_MI_CHK_STATUS(Mhw_CommitCommand(cmdBuffer, &cmd));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -0,0 +1,466 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "cm_test.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using CMRT_UMD::CmQueue;
+using CMRT_UMD::CmEvent;
+
+//! Feeds the print buffer ring with the records printf() writes in kernels and
+//! checks what the runtime parses out of the slots.
+class PrintBufferTest: public CmTest
+{
+public:
+    static const uint32_t SLOT_SIZE = 4096;
+    static const uint32_t BUFFER_HEADER_SIZE = 32;  // PRINT_BUFFER_HEADER_SIZE
+    static const uint32_t FORMAT_SIZE = 128;        // PRINT_FORMAT_STRING_SIZE
+    static const uint32_t OBJECT_TYPE_SCALAR = 3;
+    static const uint32_t OBJECT_TYPE_FORMAT = 5;
+    static const uint32_t DATA_TYPE_INT = 3;
+
+    // Layout of CM_PRINT_HEADER.
+    struct RecordHeader
+    {
+        uint32_t object_type;
+        uint32_t data_type;
+        uint32_t width;
+        uint32_t height;
+        uint32_t tid;
+        uint32_t reserved;
+        uint64_t scalar64;
+    };
+
+    PrintBufferTest(): m_printBufferMem(nullptr) {}
+
+    int32_t DrainRecords()
+    {
+        int32_t result = Initialize();
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        WriteValue(1, "value %d\n", 7);
+        WriteValue(1, "value %d\n", -3);
+        std::string output;
+        result = Flush(output);
+        if (CM_NOT_IMPLEMENTED == result)  // printf is not built in the driver.
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("value 7\nvalue -3\n", output);
+        EXPECT_EQ(static_cast<uint32_t>(BUFFER_HEADER_SIZE), WriteOffset(1));
+
+        // The drained slot is recycled.
+        result = Flush(output);
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("", output);
+        return result;
+    }//===============
+
+    int32_t DrainWraparound()
+    {
+        int32_t result = Initialize();
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        // The ring binds the first task to slot 0, so slot 3 holds the newest
+        // output before any task ran.
+        WriteValue(0, "slot %d\n", 0);
+        WriteValue(3, "slot %d\n", 3);
+        WriteValue(2, "slot %d\n", 2);
+        std::string output;
+        result = Flush(output);
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("slot 0\nslot 2\nslot 3\n", output);
+        return result;
+    }//===============
+
+    int32_t BindSuccessiveSlots()
+    {
+        int32_t result = Initialize();
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        // Each task is bound to the next slot and releases it once completed.
+        for (int i = 0; i < 2; i++)
+        {
+            result = RunTask();
+            if (CM_NOT_IMPLEMENTED == result)  // No GPU copy kernel on the platform
+            {
+                return CM_SUCCESS;
+            }
+            EXPECT_EQ(CM_SUCCESS, result);
+        }
+        WriteValue(0, "slot %d\n", 0);
+        WriteValue(1, "slot %d\n", 1);
+        WriteValue(3, "slot %d\n", 3);
+
+        // Slot 1 of the last task holds the newest output.
+        std::string output;
+        result = Flush(output);
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("slot 3\nslot 0\nslot 1\n", output);
+        return result;
+    }//===============
+
+    int32_t ShareBusySlot()
+    {
+        int32_t result = Initialize();
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        // Output not flushed yet keeps slot 0 busy, the task shares slot 3
+        // instead, and the output of slot 0 stays the oldest one.
+        WriteValue(0, "pending %d\n", 0);
+        result = RunTask();
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        WriteValue(3, "task %d\n", 1);
+
+        std::string output;
+        result = Flush(output);
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("pending 0\ntask 1\n", output);
+        return result;
+    }//===============
+
+    int32_t RecycleFlushedSlot()
+    {
+        int32_t result = Initialize();
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        result = RunTask();
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        WriteValue(0, "task %d\n", 0);
+
+        // The output of the completed tasks is kept until the print buffer is flushed.
+        result = RunTask();
+        EXPECT_EQ(CM_SUCCESS, result);
+        WriteValue(1, "task %d\n", 1);
+        EXPECT_LT(static_cast<uint32_t>(BUFFER_HEADER_SIZE), WriteOffset(0));
+
+        std::string output;
+        result = Flush(output);
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("task 0\ntask 1\n", output);
+        EXPECT_EQ(static_cast<uint32_t>(BUFFER_HEADER_SIZE), WriteOffset(0));
+        EXPECT_EQ(static_cast<uint32_t>(BUFFER_HEADER_SIZE), WriteOffset(1));
+
+        // The flushed slots are bound again once the ring wraps around.
+        for (int i = 2; i < 6; i++)
+        {
+            result = RunTask();
+            EXPECT_EQ(CM_SUCCESS, result);
+        }
+        WriteValue(1, "task %d\n", 5);
+        WriteValue(0, "task %d\n", 4);
+        result = Flush(output);
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("task 4\ntask 5\n", output);
+        return result;
+    }//===============
+
+    int32_t StreamCompletedTasks()
+    {
+        int32_t result = Initialize();
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        // The first flush selects the stream, the output of the slots idle
+        // when a task completes is drained into it without another flush.
+        const char *filename = "print_buffer_stream_test.txt";
+        result = m_mockDevice->FlushPrintBufferIntoFile(filename);
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+
+        WriteValue(0, "streamed %d\n", 0);
+        result = RunTask();
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            m_mockDevice->FlushPrintBuffer();
+            remove(filename);
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ(static_cast<uint32_t>(BUFFER_HEADER_SIZE), WriteOffset(0));
+
+        std::string output;
+        result = ReadFile(filename, output);
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("streamed 0\n", output);
+
+        // Selecting stdout closes the file
+        result = m_mockDevice->FlushPrintBuffer();
+        EXPECT_EQ(CM_SUCCESS, result);
+        remove(filename);
+        return result;
+    }//===============
+
+    int32_t DrainOverflow()
+    {
+        int32_t result = Initialize();
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        // Threads keep adding to the write offset when the slot is full, only
+        // the records that fit in the slot are parsed.
+        std::string expected;
+        for (int i = 0; i < 32; i++)
+        {
+            if (WriteValue(0, "line %d\n", i))
+            {
+                expected += "line " + std::to_string(i) + "\n";
+            }
+        }
+        EXPECT_GT(WriteOffset(0), static_cast<uint32_t>(SLOT_SIZE));
+
+        std::string output;
+        result = Flush(output);
+        if (CM_NOT_IMPLEMENTED == result)
+        {
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ(expected, output);
+
+        // Records written over the consumed output are parsed once.
+        WriteValue(0, "line %d\n", 32);
+        result = Flush(output);
+        EXPECT_EQ(CM_SUCCESS, result);
+        EXPECT_EQ("line 32\n", output);
+        return result;
+    }//===============
+
+private:
+    int32_t Initialize()
+    {
+        m_printBufferMem = nullptr;
+        int32_t result = m_mockDevice.InitPrintBuffer(SLOT_SIZE, m_printBufferMem);
+        EXPECT_EQ(CM_SUCCESS, result);
+        if (CM_SUCCESS == result && nullptr == m_printBufferMem)
+        {
+            return CM_FAILURE;
+        }
+        return result;
+    }//===============
+
+    // Runs a GPU copy to completion, the copy task is bound to a slot as the
+    // tasks running kernels are.
+    int32_t RunTask()
+    {
+        const uint32_t size = 0x10000;
+        CmQueue *queue = nullptr;
+        int32_t result = m_mockDevice->CreateQueue(queue);
+        EXPECT_EQ(CM_SUCCESS, result);
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        unsigned char *src = static_cast<unsigned char*>(AllocateAlignedMemory(size, 0x1000));
+        unsigned char *dst = static_cast<unsigned char*>(AllocateAlignedMemory(size, 0x1000));
+        memset(src, 0x5a, size);
+
+        CmEvent *event = nullptr;
+        result = queue->EnqueueCopyCPUToCPU(dst, src, size, CM_FASTCOPY_OPTION_BLOCKING, event);
+        if (event)
+        {
+            queue->DestroyEvent(event);
+        }
+
+        FreeAlignedMemory(src);
+        FreeAlignedMemory(dst);
+        return result;
+    }//===============
+
+    unsigned char* Slot(uint32_t slot)
+    { return m_printBufferMem + slot*SLOT_SIZE; }
+
+    uint32_t WriteOffset(uint32_t slot)
+    { return *reinterpret_cast<uint32_t*>(Slot(slot)); }
+
+    // Adds one record as the kernel does: the write offset is always advanced,
+    // the record is only stored if it fits. Returns whether it was stored.
+    bool AddRecord(uint32_t slot, const RecordHeader &header,
+                   const char *payload, uint32_t payload_size)
+    {
+        unsigned char *slot_mem = Slot(slot);
+        uint32_t *write_offset = reinterpret_cast<uint32_t*>(slot_mem);
+        uint32_t offset = *write_offset;
+        uint32_t size = sizeof(RecordHeader) + payload_size;
+        *write_offset += size;
+        if (offset + size >= SLOT_SIZE)  // Same bound as the parser.
+        {
+            return false;
+        }
+        memcpy(slot_mem + offset, &header, sizeof(header));
+        memset(slot_mem + offset + sizeof(header), 0, payload_size);
+        if (payload)
+        {
+            strncpy(reinterpret_cast<char*>(slot_mem + offset + sizeof(header)),
+                    payload, payload_size - 1);
+        }
+        return true;
+    }//=============
+
+    bool WriteValue(uint32_t slot, const char *format, int32_t value)
+    {
+        RecordHeader header = {};
+        header.object_type = OBJECT_TYPE_FORMAT;
+        bool stored = AddRecord(slot, header, format, FORMAT_SIZE);
+
+        header.object_type = OBJECT_TYPE_SCALAR;
+        header.data_type = DATA_TYPE_INT;
+        header.scalar64 = static_cast<uint32_t>(value);
+        stored &= AddRecord(slot, header, nullptr, 0);
+        return stored;
+    }//===============
+
+    int32_t Flush(std::string &output)
+    {
+        const char *filename = "print_buffer_test.txt";
+        output.clear();
+        int32_t result = m_mockDevice->FlushPrintBufferIntoFile(filename);
+        if (CM_SUCCESS != result)
+        {
+            return result;
+        }
+
+        result = ReadFile(filename, output);
+        remove(filename);
+        return result;
+    }//===============
+
+    int32_t ReadFile(const char *filename, std::string &output)
+    {
+        output.clear();
+        FILE *file = fopen(filename, "rb");
+        EXPECT_NE(nullptr, file);
+        if (nullptr == file)
+        {
+            return CM_FAILURE;
+        }
+        char buffer[256];
+        size_t read_size = 0;
+        while ((read_size = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            output.append(buffer, read_size);
+        }
+        fclose(file);
+        return CM_SUCCESS;
+    }//===============
+
+    unsigned char *m_printBufferMem;
+};//===============================
+
+TEST_F(PrintBufferTest, DrainRecords)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return DrainRecords(); });
+    return;
+}//========
+
+TEST_F(PrintBufferTest, DrainWraparound)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return DrainWraparound(); });
+    return;
+}//========
+
+TEST_F(PrintBufferTest, BindSuccessiveSlots)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return BindSuccessiveSlots(); });
+    return;
+}//========
+
+TEST_F(PrintBufferTest, ShareBusySlot)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return ShareBusySlot(); });
+    return;
+}//========
+
+TEST_F(PrintBufferTest, RecycleFlushedSlot)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return RecycleFlushedSlot(); });
+    return;
+}//========
+
+TEST_F(PrintBufferTest, DrainOverflow)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return DrainOverflow(); });
+    return;
+}//========
+
+TEST_F(PrintBufferTest, StreamCompletedTasks)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return StreamCompletedTasks(); });
+    return;
+}//========
@@ -23,6 +23,8 @@
 #include "cm_test.h"
 
 using CMRT_UMD::CmQueue;
+using CMRT_UMD::CmEvent;
+using CMRT_UMD::CmSurface2D;
 class QueueTest: public CmTest
 {
 public:
@@ -53,7 +55,140 @@ public:
         return CM_SUCCESS;
     }//===================
 
+    // Repeated non-blocking copies reuse the task and thread space of the first
+    // copy. Once a copy completed, its BufferUPs are not reused, the system
+    // memory may have been freed since.
+    int32_t RepeatCopyCPUToCPU()
+    {
+        const uint32_t size = 0x10000;
+        int32_t result = m_mockDevice->CreateQueue(m_queue);
+        EXPECT_EQ(CM_SUCCESS, result);
+
+        unsigned char *src = static_cast<unsigned char*>(AllocateAlignedMemory(size, 0x1000));
+        unsigned char *dst = static_cast<unsigned char*>(AllocateAlignedMemory(size, 0x1000));
+        memset(src, 0x5a, size);
+
+        CmEvent *event = CM_NO_EVENT;
+        result = m_queue->EnqueueCopyCPUToCPU(dst, src, size, CM_FASTCOPY_OPTION_NONBLOCKING, event);
+        if (CM_NOT_IMPLEMENTED == result)  // No GPU copy kernel on the platform
+        {
+            FreeAlignedMemory(src);
+            FreeAlignedMemory(dst);
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        if (!IsCopyCreateCounted())
+        {
+            // Release drivers don't count the GPU copy creations
+            FreeAlignedMemory(src);
+            FreeAlignedMemory(dst);
+            return result;
+        }
+
+        int32_t taskCountBefore = GetCopyTaskCreateCount();
+        for (int i = 0; i < 8; i++)
+        {
+            event = CM_NO_EVENT;
+            result = m_queue->EnqueueCopyCPUToCPU(dst, src, size, CM_FASTCOPY_OPTION_NONBLOCKING, event);
+            EXPECT_EQ(CM_SUCCESS, result);
+        }
+        EXPECT_EQ(taskCountBefore, GetCopyTaskCreateCount());
+
+        for (int i = 0; i < 2; i++)
+        {
+            int32_t bufferUPCountBefore = GetCopyBufferUPCreateCount();
+            event = nullptr;
+            result = m_queue->EnqueueCopyCPUToCPU(dst, src, size, CM_FASTCOPY_OPTION_BLOCKING, event);
+            EXPECT_EQ(CM_SUCCESS, result);
+            if (event)
+            {
+                m_queue->DestroyEvent(event);
+            }
+            EXPECT_LT(bufferUPCountBefore, GetCopyBufferUPCreateCount());
+        }
+        EXPECT_EQ(taskCountBefore, GetCopyTaskCreateCount());
+
+        FreeAlignedMemory(src);
+        FreeAlignedMemory(dst);
+        return result;
+    }//===================
+
+    int32_t RepeatCopyCPUToGPU()
+    {
+        const uint32_t width = 256;
+        const uint32_t height = 128;
+        const uint32_t size = width*height*4;
+        int32_t result = m_mockDevice->CreateQueue(m_queue);
+        EXPECT_EQ(CM_SUCCESS, result);
+
+        CmSurface2D *surface = nullptr;
+        result = m_mockDevice->CreateSurface2D(width, height, CM_SURFACE_FORMAT_A8R8G8B8, surface);
+        EXPECT_EQ(CM_SUCCESS, result);
+
+        unsigned char *sysMem = static_cast<unsigned char*>(AllocateAlignedMemory(size, 0x1000));
+        memset(sysMem, 0xa5, size);
+
+        CmEvent *event = CM_NO_EVENT;
+        result = m_queue->EnqueueCopyCPUToGPUFullStride(surface, sysMem, width*4, height, CM_FASTCOPY_OPTION_NONBLOCKING, event);
+        if (CM_NOT_IMPLEMENTED == result)  // No GPU copy kernel on the platform
+        {
+            m_mockDevice->DestroySurface(surface);
+            FreeAlignedMemory(sysMem);
+            return CM_SUCCESS;
+        }
+        EXPECT_EQ(CM_SUCCESS, result);
+        if (!IsCopyCreateCounted())
+        {
+            // Release drivers don't count the GPU copy creations
+            m_mockDevice->DestroySurface(surface);
+            FreeAlignedMemory(sysMem);
+            return result;
+        }
+
+        int32_t taskCountBefore = GetCopyTaskCreateCount();
+        for (int i = 0; i < 8; i++)
+        {
+            event = CM_NO_EVENT;
+            result = m_queue->EnqueueCopyCPUToGPUFullStride(surface, sysMem, width*4, height, CM_FASTCOPY_OPTION_NONBLOCKING, event);
+            EXPECT_EQ(CM_SUCCESS, result);
+        }
+        EXPECT_EQ(taskCountBefore, GetCopyTaskCreateCount());
+
+        for (int i = 0; i < 2; i++)
+        {
+            int32_t bufferUPCountBefore = GetCopyBufferUPCreateCount();
+            event = nullptr;
+            result = m_queue->EnqueueCopyCPUToGPUFullStride(surface, sysMem, width*4, height, CM_FASTCOPY_OPTION_BLOCKING, event);
+            EXPECT_EQ(CM_SUCCESS, result);
+            if (event)
+            {
+                m_queue->DestroyEvent(event);
+            }
+            EXPECT_LT(bufferUPCountBefore, GetCopyBufferUPCreateCount());
+        }
+        EXPECT_EQ(taskCountBefore, GetCopyTaskCreateCount());
+
+        m_mockDevice->DestroySurface(surface);
+        FreeAlignedMemory(sysMem);
+        return result;
+    }//===================
+
 private:
+    // Tasks and thread spaces created by the GPU copies of the driver so far.
+    int32_t GetCopyTaskCreateCount()
+    {
+        return m_driverLoader.GetUltCounter(MOS_ULT_COUNTER_CM_GPU_COPY_TASK_CREATES);
+    }
+
+    // BufferUPs created by the GPU copies of the driver so far.
+    int32_t GetCopyBufferUPCreateCount()
+    {
+        return m_driverLoader.GetUltCounter(MOS_ULT_COUNTER_CM_GPU_COPY_BUFFERUP_CREATES);
+    }
+
+    // Release drivers do not count, a copy always creates its task first.
+    bool IsCopyCreateCounted() { return GetCopyTaskCreateCount() > 0; }
+
     CmQueue *m_queue;
 };//=================
 
@@ -70,3 +205,17 @@ TEST_F(QueueTest, EnqueueWithoutTask)
                      [this]() { return EnqueueWithoutTask(); });
     return;
 }//========
+
+TEST_F(QueueTest, RepeatCopyCPUToCPU)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return RepeatCopyCPUToCPU(); });
+    return;
+}//========
+
+TEST_F(QueueTest, RepeatCopyCPUToGPU)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return RepeatCopyCPUToGPU(); });
+    return;
+}//========
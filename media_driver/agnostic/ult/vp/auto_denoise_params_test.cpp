@@ -0,0 +1,142 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "gtest/gtest.h"
+#include "vphal_render_vebox_denoise_params.h"
+
+class AutoDenoiseParamsTest: public testing::Test
+{
+public:
+    //!
+    //! \brief    Fill the GNE statistics of both slices with the same luma, U and V
+    //!           sums and counts
+    //!
+    static void SetGne(uint32_t *gne, const uint32_t sum[3], const uint32_t count[3])
+    {
+        for (uint32_t slice = 0; slice < 2; slice++)
+        {
+            for (uint32_t i = 0; i < 3; i++)
+            {
+                gne[slice * VPHAL_AUTO_DN_GNE_DWORDS + i * 2]     = sum[i];
+                gne[slice * VPHAL_AUTO_DN_GNE_DWORDS + i * 2 + 1] = count[i];
+            }
+        }
+    }
+};
+
+TEST_F(AutoDenoiseParamsTest, FirstFrameTakesMeasuredLevel)
+{
+    uint32_t gne[2 * VPHAL_AUTO_DN_GNE_DWORDS];
+    const uint32_t sum[3]   = {1200, 300, 500};
+    const uint32_t count[3] = {100, 100, 100};
+    uint32_t level[3]       = {60, 60, 60};
+    SetGne(gne, sum, count);
+
+    VpHal_FilterAutoDenoiseLevels(gne, true, level);
+
+    EXPECT_EQ(12u, level[0]);
+    EXPECT_EQ(3u, level[1]);
+    EXPECT_EQ(5u, level[2]);
+}
+
+TEST_F(AutoDenoiseParamsTest, HistoryWeighsOldLevel)
+{
+    uint32_t gne[2 * VPHAL_AUTO_DN_GNE_DWORDS];
+    const uint32_t sum[3]   = {2000, 0, 4000};
+    const uint32_t count[3] = {100, 100, 100};
+    uint32_t level[3]       = {4, 8, 0};
+    SetGne(gne, sum, count);
+
+    VpHal_FilterAutoDenoiseLevels(gne, false, level);
+
+    // (old * 3 + new) / 4
+    EXPECT_EQ((4u * VPHAL_AUTO_DN_GNE_HISTORY_WEIGHT + 20) / (VPHAL_AUTO_DN_GNE_HISTORY_WEIGHT + 1), level[0]);
+    EXPECT_EQ((8u * VPHAL_AUTO_DN_GNE_HISTORY_WEIGHT) / (VPHAL_AUTO_DN_GNE_HISTORY_WEIGHT + 1), level[1]);
+    EXPECT_EQ(40u / (VPHAL_AUTO_DN_GNE_HISTORY_WEIGHT + 1), level[2]);
+}
+
+TEST_F(AutoDenoiseParamsTest, NoStatisticsKeepsLevel)
+{
+    uint32_t gne[2 * VPHAL_AUTO_DN_GNE_DWORDS];
+    const uint32_t sum[3]   = {1000, 1000, 1000};
+    const uint32_t count[3] = {0, 10, 0};
+    uint32_t level[3]       = {7, 7, 7};
+    SetGne(gne, sum, count);
+
+    VpHal_FilterAutoDenoiseLevels(gne, true, level);
+
+    EXPECT_EQ(7u, level[0]);
+    EXPECT_EQ(100u, level[1]);
+    EXPECT_EQ(7u, level[2]);
+}
+
+TEST_F(AutoDenoiseParamsTest, LargeSumsDoNotWrap)
+{
+    // Sums of the two slices together do not fit in 32 bits
+    uint32_t gne[2 * VPHAL_AUTO_DN_GNE_DWORDS];
+    const uint32_t sum[3]   = {0xc0000000, 0xc0000000, 0xc0000000};
+    const uint32_t count[3] = {0x04000000, 0x04000000, 0x04000000};
+    uint32_t level[3]       = {};
+    SetGne(gne, sum, count);
+
+    VpHal_FilterAutoDenoiseLevels(gne, true, level);
+
+    EXPECT_EQ(48u, level[0]);
+    EXPECT_EQ(48u, level[1]);
+    EXPECT_EQ(48u, level[2]);
+}
+
+TEST_F(AutoDenoiseParamsTest, FactorsFromLevels)
+{
+    const uint32_t factorMax = 64;
+    uint32_t luma            = 0;
+    uint32_t chroma          = 0;
+
+    const uint32_t level[3] = {10 * VPHAL_AUTO_DN_LEVEL_PER_FACTOR, 3 * VPHAL_AUTO_DN_LEVEL_PER_FACTOR, 9 * VPHAL_AUTO_DN_LEVEL_PER_FACTOR};
+    VpHal_GetAutoDenoiseFactors(level, factorMax, &luma, &chroma);
+    EXPECT_EQ(10u, luma);
+    EXPECT_EQ(9u, chroma);      // The noisier chroma plane
+
+    const uint32_t quiet[3] = {VPHAL_AUTO_DN_LEVEL_PER_FACTOR - 1, 0, 0};
+    VpHal_GetAutoDenoiseFactors(quiet, factorMax, &luma, &chroma);
+    EXPECT_EQ(0u, luma);        // Below one slider step
+    EXPECT_EQ(0u, chroma);
+
+    const uint32_t noisy[3] = {200 * VPHAL_AUTO_DN_LEVEL_PER_FACTOR, 65 * VPHAL_AUTO_DN_LEVEL_PER_FACTOR, 2};
+    VpHal_GetAutoDenoiseFactors(noisy, factorMax, &luma, &chroma);
+    EXPECT_EQ(factorMax, luma);
+    EXPECT_EQ(factorMax, chroma);
+}
+
+TEST_F(AutoDenoiseParamsTest, ReadCopiesBothSlices)
+{
+    uint32_t slice0[VPHAL_AUTO_DN_GNE_DWORDS] = {1, 2, 3, 4, 5, 6};
+    uint32_t slice1[VPHAL_AUTO_DN_GNE_DWORDS] = {7, 8, 9, 10, 11, 12};
+    uint32_t gne[2 * VPHAL_AUTO_DN_GNE_DWORDS] = {};
+
+    EXPECT_TRUE(VpHal_ReadAutoDenoiseGne(slice0, slice1, gne));
+    for (uint32_t i = 0; i < VPHAL_AUTO_DN_GNE_DWORDS; i++)
+    {
+        EXPECT_EQ(slice0[i], gne[i]);
+        EXPECT_EQ(slice1[i], gne[VPHAL_AUTO_DN_GNE_DWORDS + i]);
+    }
+}
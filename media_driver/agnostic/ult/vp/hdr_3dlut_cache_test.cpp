@@ -0,0 +1,129 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "gtest/gtest.h"
+#include "vphal_render_hdr_3dlut_cache.h"
+
+class Hdr3DLutCacheTest: public testing::Test
+{
+public:
+    typedef VpHal3DLutCacheTable<uintptr_t> Table;
+
+    static Table::Key MakeKey(const void *device, uint32_t maxDLL)
+    {
+        Table::Key key = {};
+        key.device     = device;
+        key.maxDLL     = maxDLL;
+        key.maxCLL     = 4000;
+        key.hdrMode    = 1;
+        return key;
+    }
+
+    int         m_device0 = 0;
+    int         m_device1 = 0;
+    Table       m_table;
+};
+
+TEST_F(Hdr3DLutCacheTest, AcquireHitsOnlySameDeviceAndParams)
+{
+    uintptr_t lut = 0;
+
+    m_table.AddUser(&m_device0);
+    m_table.AddUser(&m_device1);
+
+    EXPECT_FALSE(m_table.Acquire(MakeKey(&m_device0, 1000), &lut));
+    m_table.Insert(MakeKey(&m_device0, 1000), 0x10);
+
+    EXPECT_TRUE(m_table.Acquire(MakeKey(&m_device0, 1000), &lut));
+    EXPECT_EQ(0x10u, lut);
+
+    // Other parameters or another device miss
+    EXPECT_FALSE(m_table.Acquire(MakeKey(&m_device0, 500), &lut));
+    EXPECT_FALSE(m_table.Acquire(MakeKey(&m_device1, 1000), &lut));
+}
+
+TEST_F(Hdr3DLutCacheTest, ReferencedLutsAreNotEvicted)
+{
+    uintptr_t lut = 0;
+
+    m_table.AddUser(&m_device0);
+    for (uint32_t i = 0; i <= VPHAL_HDR_3DLUT_CACHE_MAX_IDLE_ENTRIES; i++)
+    {
+        m_table.Insert(MakeKey(&m_device0, i), 0x100 + i);
+    }
+    EXPECT_FALSE(m_table.PopIdle(&m_device0, &lut));
+
+    // Dropping every reference leaves one idle LUT too many
+    for (uint32_t i = 0; i <= VPHAL_HDR_3DLUT_CACHE_MAX_IDLE_ENTRIES; i++)
+    {
+        m_table.Release(0x100 + i);
+    }
+    EXPECT_TRUE(m_table.PopIdle(&m_device0, &lut));
+    EXPECT_EQ(0x100u, lut);
+    EXPECT_FALSE(m_table.PopIdle(&m_device0, &lut));
+}
+
+TEST_F(Hdr3DLutCacheTest, IdleLutsAreEvictedLeastRecentlyUsedFirst)
+{
+    uintptr_t lut = 0;
+
+    m_table.AddUser(&m_device0);
+    for (uint32_t i = 0; i <= VPHAL_HDR_3DLUT_CACHE_MAX_IDLE_ENTRIES; i++)
+    {
+        m_table.Insert(MakeKey(&m_device0, i), 0x100 + i);
+        m_table.Release(0x100 + i);
+    }
+
+    // Reusing the oldest LUT makes the second one the least recently used
+    EXPECT_TRUE(m_table.Acquire(MakeKey(&m_device0, 0), &lut));
+    m_table.Release(lut);
+
+    EXPECT_TRUE(m_table.PopIdle(&m_device0, &lut));
+    EXPECT_EQ(0x101u, lut);
+    EXPECT_FALSE(m_table.Acquire(MakeKey(&m_device0, 1), &lut));
+}
+
+TEST_F(Hdr3DLutCacheTest, LastUserOfDeviceHandsBackItsLuts)
+{
+    uintptr_t lut = 0;
+
+    m_table.AddUser(&m_device0);
+    m_table.AddUser(&m_device0);
+    m_table.AddUser(&m_device1);
+    m_table.Insert(MakeKey(&m_device0, 1000), 0x10);
+    m_table.Insert(MakeKey(&m_device1, 1000), 0x20);
+
+    EXPECT_FALSE(m_table.RemoveUser(&m_device0));
+    EXPECT_TRUE(m_table.RemoveUser(&m_device0));
+
+    EXPECT_TRUE(m_table.PopDevice(&m_device0, &lut));
+    EXPECT_EQ(0x10u, lut);
+    EXPECT_FALSE(m_table.PopDevice(&m_device0, &lut));
+    EXPECT_FALSE(m_table.IsUnused());
+
+    // The other device keeps its LUT until its own last user goes away
+    EXPECT_TRUE(m_table.Acquire(MakeKey(&m_device1, 1000), &lut));
+    EXPECT_TRUE(m_table.RemoveUser(&m_device1));
+    EXPECT_TRUE(m_table.PopDevice(&m_device1, &lut));
+    EXPECT_EQ(0x20u, lut);
+    EXPECT_TRUE(m_table.IsUnused());
+}
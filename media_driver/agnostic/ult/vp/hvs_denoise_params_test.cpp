@@ -0,0 +1,132 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <random>
+#include "gtest/gtest.h"
+#include "vphal_render_vebox_denoise_params.h"
+
+class HVSDenoiseParamsTest: public testing::Test
+{
+public:
+    // DNDI params read by the CPU from the HVS denoise kernel output
+    struct DndiFields
+    {
+        uint32_t dwDenoiseMPThreshold;
+        uint32_t dwDenoiseHistoryDelta;
+        uint32_t dwDenoiseMaximumHistory;
+        uint32_t dwDenoiseSTADThreshold;
+        uint32_t dwLTDThreshold;
+        uint32_t dwTDThreshold;
+        uint32_t dwDenoiseASDThreshold;
+        uint32_t dwDenoiseSCMThreshold;
+        uint32_t dwChromaLTDThreshold;
+        uint32_t dwChromaTDThreshold;
+        uint32_t dwChromaSTADThreshold;
+        uint32_t dwPixRangeWeight[6];
+        uint32_t dwPixRangeThreshold[6];
+    };
+
+    //!
+    //! \brief    Field mapping of the CPU unpack previously done in VeboxSetHVSDNParams
+    //!
+    static void Unpack(const uint32_t *params, DndiFields &fields)
+    {
+        fields.dwDenoiseMPThreshold     = (params[0] & 0x0000001f);
+        fields.dwDenoiseHistoryDelta    = (params[0] & 0x00000f00) >> 8;
+        fields.dwDenoiseMaximumHistory  = (params[0] & 0x000ff000) >> 12;
+        fields.dwDenoiseSTADThreshold   = (params[0] & 0xfff00000) >> 20;
+        fields.dwLTDThreshold           = (params[1] & 0x000003ff);
+        fields.dwTDThreshold            = (params[1] & 0x000ffc00) >> 10;
+        fields.dwDenoiseASDThreshold    = (params[1] & 0xfff00000) >> 20;
+        fields.dwDenoiseSCMThreshold    = (params[2] & 0x0fff0000) >> 16;
+        fields.dwChromaLTDThreshold     = (params[4] & 0x0000003f);
+        fields.dwChromaTDThreshold      = (params[4] & 0x00000fc0) >> 6;
+        fields.dwChromaSTADThreshold    = (params[4] & 0x00ff0000) >> 16;
+        fields.dwPixRangeWeight[0]      = (params[5] & 0x0000001f);
+        fields.dwPixRangeWeight[1]      = (params[5] & 0x000003e0) >> 5;
+        fields.dwPixRangeWeight[2]      = (params[5] & 0x00007c00) >> 10;
+        fields.dwPixRangeWeight[3]      = (params[5] & 0x000f8000) >> 15;
+        fields.dwPixRangeWeight[4]      = (params[5] & 0x01f00000) >> 20;
+        fields.dwPixRangeWeight[5]      = (params[5] & 0x3e000000) >> 25;
+        fields.dwPixRangeThreshold[5]   = (params[7] & 0x1fff0000) >> 16;
+        fields.dwPixRangeThreshold[4]   = (params[8] & 0x1fff0000) >> 16;
+        fields.dwPixRangeThreshold[3]   = (params[8] & 0x00001fff);
+        fields.dwPixRangeThreshold[2]   = (params[9] & 0x1fff0000) >> 16;
+        fields.dwPixRangeThreshold[1]   = (params[9] & 0x00001fff);
+        fields.dwPixRangeThreshold[0]   = (params[10] & 0x1fff0000) >> 16;
+    }
+};
+
+TEST_F(HVSDenoiseParamsTest, MergeMatchesUnpack)
+{
+    std::mt19937 random(0x48565344);
+
+    for (int iteration = 0; iteration < 256; iteration++)
+    {
+        uint32_t params[VPHAL_HVS_DN_PARAM_DWORDS];
+        uint32_t state[VPHAL_HVS_DN_PARAM_DWORDS];
+        uint32_t merged[VPHAL_HVS_DN_PARAM_DWORDS];
+        for (uint32_t i = 0; i < VPHAL_HVS_DN_PARAM_DWORDS; i++)
+        {
+            params[i] = random();
+            state[i]  = random();
+            merged[i] = state[i];
+        }
+
+        VpHal_MergeHVSDenoiseParams(params, merged);
+
+        // VEBOX reads the fields the CPU used to unpack from the kernel output
+        DndiFields expected = {};
+        DndiFields actual   = {};
+        Unpack(params, expected);
+        Unpack(merged, actual);
+        EXPECT_EQ(0, memcmp(&expected, &actual, sizeof(DndiFields)));
+
+        // The bits programmed by the driver are kept
+        for (uint32_t i = 0; i < VPHAL_HVS_DN_PARAM_DWORDS; i++)
+        {
+            EXPECT_EQ(state[i] & ~g_HVSDenoiseDndiDwordMask[i],
+                      merged[i] & ~g_HVSDenoiseDndiDwordMask[i]);
+        }
+    }
+}
+
+TEST_F(HVSDenoiseParamsTest, MaskCoversOnlyUnpackedBits)
+{
+    // A bit of the kernel output belongs to the mask only if the unpack reads it
+    for (uint32_t i = 0; i < VPHAL_HVS_DN_PARAM_DWORDS; i++)
+    {
+        for (uint32_t bit = 0; bit < 32; bit++)
+        {
+            uint32_t params[VPHAL_HVS_DN_PARAM_DWORDS] = {};
+            DndiFields empty  = {};
+            DndiFields fields = {};
+            params[i] = 1u << bit;
+            Unpack(params, fields);
+
+            bool bRead   = memcmp(&empty, &fields, sizeof(DndiFields)) != 0;
+            bool bMasked = (g_HVSDenoiseDndiDwordMask[i] & (1u << bit)) != 0;
+            EXPECT_EQ(bRead, bMasked) << "DW" << i << " bit " << bit;
+        }
+    }
+}
@@ -1240,9 +1240,12 @@ public:
     //! \details    The default size of print buffer is 1M bytes. User can set
     //!             its size according to the length of message printed in
     //!             kernel and the number of threads. printf() can be used for
-    //!             kernel debug purpose
+    //!             kernel debug purpose. The print buffer is a ring of
+    //!             CM_PRINT_BUFFER_SLOT_COUNT slots, each task writes into the
+    //!             next slot, or shares the slot of the previous task when the
+    //!             next one is still in use or not flushed yet.
     //! \param      [in] size
-    //!             The size of print buffer in bytes.
+    //!             The size of a print buffer slot in bytes.
     //! \retval     CM_SUCCESS if the print buffer is created successfully.
     //! \retval     CM_OUT_OF_HOST_MEMORY if print buffer allication is failed.
     //! \retval     CM_FAILURE otherwise.
@@ -1257,6 +1260,9 @@ public:
     //! \brief      This function prints the message on the standard display
     //!             device that are dumped by kernel.
     //! \details    It should be called after the task being finished. The
+    //!             output of the completed tasks not printed yet is printed.
+    //!             From then on the output of each task is printed when it
+    //!             completes, until FlushPrintBufferIntoFile() selects a file. The
     //!             order of printf output is not deterministic due to thread
     //!             scheduling and the fact that different threads may be
     //!             interleaved. To distinguish which thread the printf string
@@ -1519,7 +1525,10 @@ public:
     //!             instead of stdout.
     //! \details    This function's usage is the same as
     //!             CmDevice::FlushPrintBuffer(). It is recommended to use this
-    //!             interface when there are tons of messages from kernel.
+    //!             interface when there are tons of messages from kernel. The
+    //!             output of the tasks completing afterwards is appended to the
+    //!             file, which stays open until another flush selects a stream
+    //!             or the device is destroyed.
     //! \param      [in] filename
     //!             name of file the message printed into.
     //! \retval     CM_SUCCESS if the buffer is flushed successfully into file.
@@ -833,7 +833,7 @@ VAStatus DdiMediaDecode::CreateBuffer(
         return VA_STATUS_ERROR_INVALID_PARAMETER;
     }
 
-    buf               = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_BUFFER));
+    buf               = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroPooledMemory(sizeof(DDI_MEDIA_BUFFER));
     if (buf == nullptr)
     {
         return VA_STATUS_ERROR_ALLOCATION_FAILED;
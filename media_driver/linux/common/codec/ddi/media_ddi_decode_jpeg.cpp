@@ -429,8 +429,19 @@ VAStatus DdiDecodeJPEG::RenderPicture(
         }
         case VAPictureParameterBufferType:
         {
+            if (m_imageStarted && m_ddiDecodeCtx->bJpegBatch)
+            {
+                // Another image of the batch, keep the previous one
+                if (m_batchImages.size() + 2 > CODECHAL_DECODE_MAX_BATCH_PICS)
+                {
+                    DDI_ASSERTMESSAGE("Too many images in JPEG batch.");
+                    return VA_STATUS_ERROR_MAX_NUM_EXCEEDED;
+                }
+                DDI_CHK_RET(SaveBatchImage(), "SaveBatchImage failed!");
+            }
             VAPictureParameterBufferJPEGBaseline *picParam = (VAPictureParameterBufferJPEGBaseline *)data;
             DDI_CHK_RET(ParsePicParams(mediaCtx, picParam),"ParsePicParams failed!");
+            m_imageStarted = true;
             break;
         }
         case VAHuffmanTableBufferType:
@@ -441,6 +452,15 @@ VAStatus DdiDecodeJPEG::RenderPicture(
         }
         case VAProcPipelineParameterBufferType:
         {
+            // Images after the first one of a batch are decoded to the first additional output
+            if (!m_batchImages.empty())
+            {
+                VAProcPipelineParameterBuffer *procBuf = (VAProcPipelineParameterBuffer *)data;
+                DDI_CHK_CONDITION((procBuf->num_additional_outputs == 0 || procBuf->additional_outputs == nullptr),
+                    "No target for JPEG batch image", VA_STATUS_ERROR_INVALID_SURFACE);
+                DDI_CHK_RET(SetImageTarget(mediaCtx, procBuf->additional_outputs[0]), "SetImageTarget failed!");
+                break;
+            }
             DDI_NORMALMESSAGE("ProcPipeline is not supported for JPEGBaseline decoding\n");
             break;
         }
@@ -479,6 +499,7 @@ VAStatus DdiDecodeJPEG::BeginPicture(
         MOS_FreeMemory(m_jpegBitstreamBuf);
         m_jpegBitstreamBuf = nullptr;
     }
+    ClearBatchImages();
 
     CodecDecodeJpegScanParameter *jpegSliceParam =
         (CodecDecodeJpegScanParameter *)(m_ddiDecodeCtx->DecodeParams.m_sliceParams);
@@ -487,7 +508,9 @@ VAStatus DdiDecodeJPEG::BeginPicture(
     CodecDecodeJpegPicParams *picParam = (CodecDecodeJpegPicParams *)(m_ddiDecodeCtx->DecodeParams.m_picParams);
     picParam->m_totalScans             = 0;
 
-    m_numScans = 0;
+    m_numScans     = 0;
+    m_imageStarted = false;
+    m_imageSurface = m_ddiDecodeCtx->RTtbl.pCurrentRT;
     return vaStatus;
 }
 
@@ -513,6 +536,13 @@ VAStatus DdiDecodeJPEG::InitDecodeParams(
 }
 
 VAStatus DdiDecodeJPEG::SetDecodeParams()
+{
+    DDI_CHK_RET(CombineBitstream(), "CombineBitstream failed!");
+
+    return SetImageParams();
+}
+
+VAStatus DdiDecodeJPEG::CombineBitstream()
 {
     DDI_CODEC_COM_BUFFER_MGR *bufMgr = &(m_ddiDecodeCtx->BufMgr);
 
@@ -600,18 +630,32 @@ VAStatus DdiDecodeJPEG::SetDecodeParams()
     bufMgr->dwNumOfRenderedSlicePara  = 0;
     bufMgr->dwSizeOfRenderedSliceData = 0;
 
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus DdiDecodeJPEG::SetImageParams()
+{
+    DDI_CODEC_COM_BUFFER_MGR *bufMgr = &(m_ddiDecodeCtx->BufMgr);
+    DDI_CHK_NULL(m_imageSurface, "nullptr m_imageSurface", VA_STATUS_ERROR_INVALID_SURFACE);
+
+    memset(&m_destSurface, 0, sizeof(MOS_SURFACE));
     m_destSurface.dwOffset = 0;
     m_destSurface.Format   = Format_NV12;
 
     CodecDecodeJpegPicParams *jpegPicParam = (CodecDecodeJpegPicParams *)(m_ddiDecodeCtx->DecodeParams.m_picParams);
-    if((m_ddiDecodeCtx->RTtbl.pCurrentRT->format == Media_Format_NV12)
+    if((m_imageSurface->format == Media_Format_NV12)
         &&(jpegPicParam->m_chromaType == jpegYUV444))
     {
-        m_ddiDecodeCtx->RTtbl.pCurrentRT = DdiMedia_ReplaceSurfaceWithNewFormat(m_ddiDecodeCtx->RTtbl.pCurrentRT, Media_Format_444P);
+        bool currentRT = (m_imageSurface == m_ddiDecodeCtx->RTtbl.pCurrentRT);
+        m_imageSurface = DdiMedia_ReplaceSurfaceWithNewFormat(m_imageSurface, Media_Format_444P);
+        if (currentRT)
+        {
+            m_ddiDecodeCtx->RTtbl.pCurrentRT = m_imageSurface;
+        }
     }
-    if(m_ddiDecodeCtx->RTtbl.pCurrentRT != nullptr)
+    if(m_imageSurface != nullptr)
     {
-        DdiMedia_MediaSurfaceToMosResource((&(m_ddiDecodeCtx->RTtbl))->pCurrentRT, &(m_destSurface.OsResource));
+        DdiMedia_MediaSurfaceToMosResource(m_imageSurface, &(m_destSurface.OsResource));
     }
 
     (&m_ddiDecodeCtx->DecodeParams)->m_destSurface = &m_destSurface;
@@ -637,6 +681,227 @@ VAStatus DdiDecodeJPEG::SetDecodeParams()
     return VA_STATUS_SUCCESS;
 }
 
+VAStatus DdiDecodeJPEG::SaveBatchImage()
+{
+    DDI_CHK_NULL(m_imageSurface, "nullptr m_imageSurface", VA_STATUS_ERROR_INVALID_SURFACE);
+
+    CodecDecodeJpegScanParameter *jpegSliceParam =
+        (CodecDecodeJpegScanParameter *)(m_ddiDecodeCtx->DecodeParams.m_sliceParams);
+    CodecDecodeJpegPicParams *picParam = (CodecDecodeJpegPicParams *)(m_ddiDecodeCtx->DecodeParams.m_picParams);
+    DDI_CHK_NULL(jpegSliceParam, "nullptr jpegSliceParam", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_NULL(picParam, "nullptr picParam", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    // Each image of the batch keeps its own bitstream buffer
+    DDI_CHK_RET(CombineBitstream(), "CombineBitstream failed!");
+
+    BatchImage image;
+    image.picParams    = *picParam;
+    image.scanParams   = *jpegSliceParam;
+    image.iqMatrix     = *(CodecJpegQuantMatrix *)(m_ddiDecodeCtx->DecodeParams.m_iqMatrixBuffer);
+    image.huffmanTable = *(PCODECHAL_DECODE_JPEG_HUFFMAN_TABLE)(m_ddiDecodeCtx->DecodeParams.m_huffmanTable);
+    image.numSlices    = m_ddiDecodeCtx->DecodeParams.m_numSlices;
+    image.dataSize     = m_ddiDecodeCtx->DecodeParams.m_dataSize;
+    image.bitstreamBuf = m_jpegBitstreamBuf;
+    image.surface      = m_imageSurface;
+    m_batchImages.push_back(image);
+    m_jpegBitstreamBuf = nullptr;
+
+    // The next image starts without scans and target, the tables are kept until they are replaced
+    jpegSliceParam->NumScans    = 0;
+    picParam->m_totalScans      = 0;
+    picParam->m_interleavedData = 0;
+    m_numScans                  = 0;
+    m_imageSurface              = nullptr;
+    m_ddiDecodeCtx->DecodeParams.m_numSlices = 0;
+    m_ddiDecodeCtx->DecodeParams.m_dataSize  = 0;
+
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus DdiDecodeJPEG::RestoreBatchImage(uint32_t index)
+{
+    DDI_CHK_CONDITION((index >= m_batchImages.size()), "Invalid JPEG batch image", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    BatchImage &image = m_batchImages[index];
+    *(CodecDecodeJpegPicParams *)(m_ddiDecodeCtx->DecodeParams.m_picParams)          = image.picParams;
+    *(CodecDecodeJpegScanParameter *)(m_ddiDecodeCtx->DecodeParams.m_sliceParams)    = image.scanParams;
+    *(CodecJpegQuantMatrix *)(m_ddiDecodeCtx->DecodeParams.m_iqMatrixBuffer)         = image.iqMatrix;
+    *(PCODECHAL_DECODE_JPEG_HUFFMAN_TABLE)(m_ddiDecodeCtx->DecodeParams.m_huffmanTable) = image.huffmanTable;
+    m_ddiDecodeCtx->DecodeParams.m_numSlices = image.numSlices;
+    m_ddiDecodeCtx->DecodeParams.m_dataSize  = image.dataSize;
+
+    DdiMedia_MediaBufferToMosResource(image.bitstreamBuf, &(m_ddiDecodeCtx->BufMgr.resBitstreamBuffer));
+    m_imageSurface = image.surface;
+    DDI_CHK_RET(SetImageParams(), "SetImageParams failed!");
+
+    // The target may have been reallocated in 444P
+    image.surface = m_imageSurface;
+    return VA_STATUS_SUCCESS;
+}
+
+void DdiDecodeJPEG::ClearBatchImages()
+{
+    for (auto &image : m_batchImages)
+    {
+        if (image.bitstreamBuf)
+        {
+            DdiMediaUtil_FreeBuffer(image.bitstreamBuf);
+            MOS_FreeMemory(image.bitstreamBuf);
+            image.bitstreamBuf = nullptr;
+        }
+    }
+    m_batchImages.clear();
+}
+
+VAStatus DdiDecodeJPEG::SetImageTarget(
+    DDI_MEDIA_CONTEXT *mediaCtx,
+    VASurfaceID        target)
+{
+    DDI_MEDIA_SURFACE *surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, target);
+    DDI_CHK_NULL(surface, "nullptr surface", VA_STATUS_ERROR_INVALID_SURFACE);
+
+    // The status of the target is queried as for the render target of the picture
+    DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
+    surface->curCtxType                = DDI_MEDIA_CONTEXT_TYPE_DECODER;
+    surface->curStatusReportQueryState = DDI_MEDIA_STATUS_REPORT_QUREY_STATE_PENDING;
+    DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
+    surface->pDecCtx = m_ddiDecodeCtx;
+
+    DDI_CHK_RET(RegisterRTSurfaces(&(m_ddiDecodeCtx->RTtbl), surface), "RegisterRTSurfaces failed!");
+    m_imageSurface = surface;
+
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus DdiDecodeJPEG::CheckBatchImages()
+{
+    DDI_CHK_CONDITION((m_batchImages.size() > CODECHAL_DECODE_MAX_BATCH_PICS),
+        "Too many images in JPEG batch.", VA_STATUS_ERROR_MAX_NUM_EXCEEDED);
+
+    for (auto &image : m_batchImages)
+    {
+        DDI_CHK_NULL(image.surface, "nullptr JPEG batch image target", VA_STATUS_ERROR_INVALID_SURFACE);
+        DDI_CHK_NULL(image.bitstreamBuf, "nullptr JPEG batch image bitstream", VA_STATUS_ERROR_INVALID_BUFFER);
+        DDI_CHK_CONDITION((image.picParams.m_frameWidth == 0 || image.picParams.m_frameHeight == 0),
+            "Invalid JPEG batch image size.", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+        // The images share the command buffer, so none of them may wait for more bitstream data
+        CodecDecodeJpegScanParameter &scanParams = image.scanParams;
+        DDI_CHK_CONDITION((scanParams.NumScans == 0 || scanParams.NumScans < image.picParams.m_totalScans),
+            "JPEG batch image misses scans.", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+        uint32_t lastScan = scanParams.NumScans - 1;
+        DDI_CHK_CONDITION((image.dataSize < scanParams.ScanHeader[lastScan].DataOffset + scanParams.ScanHeader[lastScan].DataLength),
+            "JPEG batch image misses bitstream data.", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+        // ARGB targets are output through SFC, which a batch can not use
+        DDI_CHK_CONDITION((image.surface->format == Media_Format_A8R8G8B8),
+            "JPEG batch image can not be output through SFC.", VA_STATUS_ERROR_INVALID_SURFACE);
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus DdiDecodeJPEG::EndPicture(
+    VADriverContextP ctx,
+    VAContextID      context)
+{
+    if (m_batchImages.empty())
+    {
+        m_ddiDecodeCtx->DecodeParams.m_batchPicIdx    = 0;
+        m_ddiDecodeCtx->DecodeParams.m_batchPicNum    = 0;
+        m_ddiDecodeCtx->DecodeParams.m_batchNumSlices = 0;
+        return DdiMediaDecode::EndPicture(ctx, context);
+    }
+
+    DDI_FUNCTION_ENTER();
+
+    if (m_ddiDecodeCtx->bDecodeModeReported == false)
+    {
+        ReportDecodeMode(m_ddiDecodeCtx->wMode);
+        m_ddiDecodeCtx->bDecodeModeReported = true;
+    }
+
+    DDI_CHK_RET(InitDecodeParams(ctx, context), "InitDecodeParams failed!");
+    DDI_CHK_RET(SaveBatchImage(), "SaveBatchImage failed!");
+    DDI_CHK_RET(ClearRefList(&(m_ddiDecodeCtx->RTtbl), m_withDpb), "ClearRefList failed!");
+    if (m_ddiDecodeCtx->pCodecHal == nullptr)
+    {
+        return VA_STATUS_ERROR_ALLOCATION_FAILED;
+    }
+
+    // All the images are checked before the first one is added to the command buffer
+    m_imageStarted = false;
+    DDI_CHK_RET(CheckBatchImages(), "Invalid JPEG batch!");
+
+    // The watchdog timer of the command buffer covers the area of all the images
+    uint32_t numSlices = 0;
+    uint32_t width     = 0;
+    uint64_t area      = 0;
+    for (auto &image : m_batchImages)
+    {
+        numSlices += image.numSlices;
+        width     = MOS_MAX(width, image.picParams.m_frameWidth);
+        area      += (uint64_t)image.picParams.m_frameWidth * image.picParams.m_frameHeight;
+    }
+
+    // The images are programmed back to back, the command buffer is submitted with the last one
+    VAStatus vaStatus = VA_STATUS_SUCCESS;
+    for (uint32_t i = 0; i < m_batchImages.size(); i++)
+    {
+        vaStatus = RestoreBatchImage(i);
+        if (vaStatus != VA_STATUS_SUCCESS)
+        {
+            break;
+        }
+
+        m_ddiDecodeCtx->DecodeParams.m_batchPicIdx    = i;
+        m_ddiDecodeCtx->DecodeParams.m_batchPicNum    = m_batchImages.size();
+        m_ddiDecodeCtx->DecodeParams.m_batchNumSlices = numSlices;
+        m_ddiDecodeCtx->DecodeParams.m_batchWidth     = width;
+        m_ddiDecodeCtx->DecodeParams.m_batchHeight    = (uint32_t)((area + width - 1) / width);
+
+        MOS_STATUS status = m_ddiDecodeCtx->pCodecHal->Execute((void *)(&m_ddiDecodeCtx->DecodeParams));
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            DDI_ASSERTMESSAGE("DDI:DdiDecode_DecodeInCodecHal return failure.");
+            vaStatus = VA_STATUS_ERROR_DECODING_ERROR;
+            break;
+        }
+    }
+
+    m_ddiDecodeCtx->DecodeParams.m_batchPicIdx    = 0;
+    m_ddiDecodeCtx->DecodeParams.m_batchPicNum    = 0;
+    m_ddiDecodeCtx->DecodeParams.m_batchNumSlices = 0;
+    m_ddiDecodeCtx->DecodeParams.m_batchWidth     = 0;
+    m_ddiDecodeCtx->DecodeParams.m_batchHeight    = 0;
+
+    if (vaStatus != VA_STATUS_SUCCESS)
+    {
+        // Drop the images already in the command buffer, the next picture starts a new one
+        PMOS_INTERFACE osInterface = m_ddiDecodeCtx->pCodecHal->GetOsInterface();
+        if (osInterface)
+        {
+            MOS_COMMAND_BUFFER cmdBuffer;
+            MOS_ZeroMemory(&cmdBuffer, sizeof(cmdBuffer));
+            osInterface->pfnResetCommandBuffer(osInterface, &cmdBuffer);
+            osInterface->pfnResetOsStates(osInterface);
+        }
+        DDI_ASSERTMESSAGE("JPEG batch decoding failed!");
+        return vaStatus;
+    }
+
+    (&(m_ddiDecodeCtx->RTtbl))->pCurrentRT = nullptr;
+
+    MOS_STATUS status = m_ddiDecodeCtx->pCodecHal->EndFrame();
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        return VA_STATUS_ERROR_DECODING_ERROR;
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+
 VAStatus DdiDecodeJPEG::AllocSliceParamContext(
     uint32_t numSlices)
 {
@@ -831,6 +1096,8 @@ void DdiDecodeJPEG::FreeResourceBuffer()
 
     bufMgr->dwNumSliceData    = 0;
 
+    ClearBatchImages();
+
     if (m_jpegBitstreamBuf)
     {
         DdiMediaUtil_FreeBuffer(m_jpegBitstreamBuf);
@@ -28,7 +28,9 @@
 #define __MEDIA_DDI_JPEG_DECODER_H__
 
 #include <va/va.h>
+#include <vector>
 #include "media_ddi_decode_base.h"
+#include "codechal_decode_jpeg.h"
 
 //forward declaration of DDI_MEDIA_BUFFER
 struct _DDI_MEDIA_BUFFER;
@@ -65,6 +67,17 @@ public:
         VABufferID       *buffers,
         int32_t          numBuffers) override;
 
+    //!
+    //! \brief   End a picture, decoding the images of a batch in one command buffer
+    //! \details In contexts created with DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH, each picture parameter
+    //!          buffer after the first one starts another image. Its decode target is
+    //!          additional_outputs[0] of a VAProcPipelineParameterBuffer rendered after it, the
+    //!          other fields of that buffer are ignored. See docs/media_features.md
+    //!
+    virtual VAStatus EndPicture(
+        VADriverContextP ctx,
+        VAContextID      context) override;
+
     virtual VAStatus InitDecodeParams(
         VADriverContextP ctx,
         VAContextID      context) override;
@@ -189,11 +202,90 @@ private:
     //!          else fail reason
     VAStatus SetBufferRendered(VABufferID bufferID);
 
+    //! \brief   Combine the rendered slice data of the image in one bitstream buffer
+    //!
+    //! \return  VA_STATUS_SUCCESS is returned if it is combined successfully.
+    //!          else fail reason
+    VAStatus CombineBitstream();
+
+    //! \brief   Set the target and bitstream decode params of the current image
+    //!
+    //! \return  VA_STATUS_SUCCESS is returned if it is set successfully.
+    //!          else fail reason
+    VAStatus SetImageParams();
+
+    //! \brief   Keep the current image for a batched decode
+    //! \details The params, tables and bitstream of the image are moved to the batch,
+    //!          the next image starts without scans or target
+    //!
+    //! \return  VA_STATUS_SUCCESS is returned if it is kept successfully.
+    //!          else fail reason
+    VAStatus SaveBatchImage();
+
+    //! \brief   Make a kept image the current one
+    //!
+    //! \param   [in] index
+    //!          uint32_t index of the image in the batch
+    //!
+    //! \return  VA_STATUS_SUCCESS is returned if it is restored successfully.
+    //!          else fail reason
+    VAStatus RestoreBatchImage(uint32_t index);
+
+    //! \brief   Check that every image of the batch can be decoded
+    //! \details Done before the first image is added to the command buffer, an image
+    //!          needs its target and all its scans and bitstream data
+    //!
+    //! \return  VA_STATUS_SUCCESS is returned if all the images are valid.
+    //!          else fail reason
+    VAStatus CheckBatchImages();
+
+    //! \brief   Drop the kept images and their bitstream buffers
+    //!
+    void ClearBatchImages();
+
+    //! \brief   Set the target of the current image of a batch
+    //!
+    //! \param   [in] *mediaCtx
+    //!          DDI_MEDIA_CONTEXT
+    //! \param   [in] target
+    //!          VASurfaceID
+    //!
+    //! \return  VA_STATUS_SUCCESS is returned if it is set successfully.
+    //!          else fail reason
+    VAStatus SetImageTarget(
+        DDI_MEDIA_CONTEXT *mediaCtx,
+        VASurfaceID        target);
+
+    //!
+    //! \struct  BatchImage
+    //! \brief   Image of a batch decoded in one command buffer
+    //!
+    struct BatchImage
+    {
+        CodecDecodeJpegPicParams            picParams;
+        CodecDecodeJpegScanParameter        scanParams;
+        CodecJpegQuantMatrix                iqMatrix;
+        CODECHAL_DECODE_JPEG_HUFFMAN_TABLE  huffmanTable;
+        uint32_t                            numSlices;
+        uint32_t                            dataSize;
+        struct _DDI_MEDIA_BUFFER            *bitstreamBuf;  //!< Owned by the image
+        DDI_MEDIA_SURFACE                   *surface;       //!< Target surface
+    };
+
     //! \brief  the internal JPEG bit-stream buffer
     struct _DDI_MEDIA_BUFFER *m_jpegBitstreamBuf = nullptr;
 
     //! \brief the total num of JPEG scans
     int32_t m_numScans = 0;
+
+    //! \brief the target of the current image
+    DDI_MEDIA_SURFACE *m_imageSurface = nullptr;
+
+    //! \brief picture params of the current image were rendered
+    bool m_imageStarted = false;
+
+    //! \brief images before the current one in this picture, decoded in one command buffer
+    std::vector<BatchImage> m_batchImages;
 };
 
 #endif
@@ -114,6 +114,231 @@ VAStatus DdiEncodeBase::AddToStatusReportQueue(void *codedBuf)
 
 }
 
+uint32_t DdiEncodeBase::GetFrameContextNum()
+{
+    MOS_USER_FEATURE_VALUE_DATA userFeatureData;
+    MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __MEDIA_USER_FEATURE_VALUE_ENCODE_FRAME_CONTEXT_NUM_ID,
+        &userFeatureData);
+    int32_t frameCtxNum = userFeatureData.i32Data;
+
+    return (frameCtxNum > 1) ? MOS_MIN((uint32_t)frameCtxNum, DDI_ENCODE_MAX_FRAME_CONTEXTS) : 1;
+}
+
+VAStatus DdiEncodeBase::CreateFrameWorker(uint32_t frameCtxNum)
+{
+    DDI_CHK_LESS(frameCtxNum, DDI_ENCODE_MAX_FRAME_CONTEXTS + 1, "Invalid frameCtxNum", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    if (frameCtxNum < 2 || m_frameWorker)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    m_frameQueued = MOS_CreateSemaphore(0, frameCtxNum);
+    m_frameFree   = MOS_CreateSemaphore(frameCtxNum, frameCtxNum);
+    m_frameMutex  = MOS_CreateMutex();
+    if (m_frameQueued == nullptr || m_frameFree == nullptr || m_frameMutex == nullptr)
+    {
+        DestroyFrameWorker();
+        return VA_STATUS_ERROR_ALLOCATION_FAILED;
+    }
+
+    m_frameCtxNum     = frameCtxNum;
+    m_frameHead       = 0;
+    m_frameTail       = 0;
+    m_frameStatus     = VA_STATUS_SUCCESS;
+    m_frameWorkerExit = false;
+
+    m_frameWorker = MOS_CreateThread((void *)FrameWorker, this);
+    if (m_frameWorker == 0)
+    {
+        DestroyFrameWorker();
+        return VA_STATUS_ERROR_OPERATION_FAILED;
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+
+void DdiEncodeBase::DestroyFrameWorker()
+{
+    if (m_frameWorker)
+    {
+        WaitForFrames();
+
+        m_frameWorkerExit = true;
+        MOS_PostSemaphore(m_frameQueued, 1);
+        MOS_WaitThread(m_frameWorker);
+        m_frameWorker = 0;
+    }
+
+    if (m_frameQueued)
+    {
+        MOS_DestroySemaphore(m_frameQueued);
+        m_frameQueued = nullptr;
+    }
+    if (m_frameFree)
+    {
+        MOS_DestroySemaphore(m_frameFree);
+        m_frameFree = nullptr;
+    }
+    if (m_frameMutex)
+    {
+        MOS_DestroyMutex(m_frameMutex);
+        m_frameMutex = nullptr;
+    }
+    m_frameCtxNum = 0;
+}
+
+void *DdiEncodeBase::FrameWorker(void *arg)
+{
+    DdiEncodeBase *encode = (DdiEncodeBase *)arg;
+
+    while (true)
+    {
+        MOS_WaitSemaphore(encode->m_frameQueued, INFINITE);
+        if (encode->m_frameWorkerExit)
+        {
+            break;
+        }
+
+        uint32_t frameCtxIdx = encode->m_frameTail;
+        encode->m_frameTail  = (frameCtxIdx + 1) % encode->m_frameCtxNum;
+
+        VAStatus status = encode->ExecuteFrameContext(frameCtxIdx);
+        if (status != VA_STATUS_SUCCESS)
+        {
+            DDI_ASSERTMESSAGE("DDI: encode worker failed to execute the frame.");
+            MOS_LockMutex(encode->m_frameMutex);
+            if (encode->m_frameStatus == VA_STATUS_SUCCESS)
+            {
+                encode->m_frameStatus = status;
+            }
+            MOS_UnlockMutex(encode->m_frameMutex);
+        }
+        MOS_IncrementUltCounter(MOS_ULT_COUNTER_ENCODE_WORKER_FRAMES);
+
+        encode->ReleaseFrameResources(frameCtxIdx);
+
+        // The surface may be destroyed as soon as it is released
+        PMEDIA_SEM_T surfaceSem = encode->m_frameSurfaceSem[frameCtxIdx];
+        encode->m_frameSurfaceSem[frameCtxIdx] = nullptr;
+        if (surfaceSem)
+        {
+            DdiMediaUtil_PostSemaphore(surfaceSem);
+        }
+
+        MOS_PostSemaphore(encode->m_frameFree, 1);
+    }
+
+    return nullptr;
+}
+
+uint32_t DdiEncodeBase::AcquireFrameContext()
+{
+    MOS_WaitSemaphore(m_frameFree, INFINITE);
+
+    uint32_t frameCtxIdx = m_frameHead;
+    m_frameHead          = (frameCtxIdx + 1) % m_frameCtxNum;
+
+    return frameCtxIdx;
+}
+
+void DdiEncodeBase::HoldFrameResource(uint32_t frameCtxIdx, PMOS_RESOURCE resource)
+{
+    if (resource == nullptr || resource->bo == nullptr)
+    {
+        return;
+    }
+
+    uint32_t boNum = m_frameBoNum[frameCtxIdx];
+    for (uint32_t i = 0; i < boNum; i++)
+    {
+        if (m_frameBos[frameCtxIdx][i] == resource->bo)
+        {
+            return;
+        }
+    }
+    if (boNum >= DDI_ENCODE_MAX_FRAME_BOS)
+    {
+        DDI_ASSERTMESSAGE("DDI: too many buffer objects in the frame context.");
+        return;
+    }
+
+    // The application may destroy the VA surface or buffer as soon as EndPicture
+    // returns, the reference keeps the bo alive until the worker executes the frame
+    // and the hold keeps the buffer pool from handing it out again before
+    mos_bo_reference(resource->bo);
+    if (m_bufferPool)
+    {
+        m_bufferPool->HoldBo(resource->bo);
+    }
+    m_frameBos[frameCtxIdx][boNum] = resource->bo;
+    m_frameBoNum[frameCtxIdx]      = boNum + 1;
+}
+
+void DdiEncodeBase::ReleaseFrameResources(uint32_t frameCtxIdx)
+{
+    for (uint32_t i = 0; i < m_frameBoNum[frameCtxIdx]; i++)
+    {
+        if (m_bufferPool)
+        {
+            m_bufferPool->UnholdBo(m_frameBos[frameCtxIdx][i]);
+        }
+        mos_bo_unreference(m_frameBos[frameCtxIdx][i]);
+        m_frameBos[frameCtxIdx][i] = nullptr;
+    }
+    m_frameBoNum[frameCtxIdx] = 0;
+}
+
+void DdiEncodeBase::QueueFrameContext(uint32_t frameCtxIdx, DDI_MEDIA_SURFACE *rawSurface)
+{
+    if (rawSurface)
+    {
+        PDDI_MEDIA_CONTEXT mediaCtx = m_encodeCtx->pMediaCtx;
+
+        DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
+        if (rawSurface->pCurrentFrameSemaphore == nullptr)
+        {
+            rawSurface->pCurrentFrameSemaphore = MOS_CreateSemaphore(1, 1);
+        }
+        DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
+
+        // Hold the surface busy until the worker has executed the frame. If an earlier
+        // queued frame still holds it, this waits for that frame first.
+        if (rawSurface->pCurrentFrameSemaphore)
+        {
+            DdiMediaUtil_WaitSemaphore(rawSurface->pCurrentFrameSemaphore);
+            m_frameSurfaceSem[frameCtxIdx] = rawSurface->pCurrentFrameSemaphore;
+        }
+    }
+
+    MOS_PostSemaphore(m_frameQueued, 1);
+}
+
+VAStatus DdiEncodeBase::WaitForFrames()
+{
+    if (m_frameWorker == 0)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    // All the frame contexts are free once the worker is idle
+    for (uint32_t i = 0; i < m_frameCtxNum; i++)
+    {
+        MOS_WaitSemaphore(m_frameFree, INFINITE);
+    }
+    MOS_PostSemaphore(m_frameFree, m_frameCtxNum);
+
+    MOS_LockMutex(m_frameMutex);
+    VAStatus status = m_frameStatus;
+    m_frameStatus   = VA_STATUS_SUCCESS;
+    MOS_UnlockMutex(m_frameMutex);
+
+    return status;
+}
+
 VAStatus DdiEncodeBase::InitCompBuffer()
 {
     DDI_CHK_NULL(m_encodeCtx, "Null m_encodeCtx.", VA_STATUS_ERROR_INVALID_CONTEXT);
@@ -908,7 +1133,7 @@ VAStatus DdiEncodeBase::CreateBuffer(
         return VA_STATUS_ERROR_INVALID_PARAMETER;
     }
 
-    DDI_MEDIA_BUFFER *buf = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_BUFFER));
+    DDI_MEDIA_BUFFER *buf = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroPooledMemory(sizeof(DDI_MEDIA_BUFFER));
     if (buf == nullptr)
     {
         return VA_STATUS_ERROR_ALLOCATION_FAILED;
@@ -955,7 +1180,7 @@ VAStatus DdiEncodeBase::CreateBuffer(
         buf->format        = Media_Format_2DBuffer;
         buf->uiNumElements = 1;
 
-        va = DdiMediaUtil_CreateBuffer(buf, mediaCtx->pDrmBufMgr);
+        va = CreatePooledBuffer(buf, mediaCtx->pDrmBufMgr, data == nullptr);
         if (va != VA_STATUS_SUCCESS)
         {
             MOS_FreeMemory(buf);
@@ -970,7 +1195,7 @@ VAStatus DdiEncodeBase::CreateBuffer(
         buf->iSize    = m_encodeCtx->wPicHeightInMB * m_encodeCtx->wPicWidthInMB;
         buf->format   = Media_Format_2DBuffer;
 
-        va = DdiMediaUtil_CreateBuffer(buf, mediaCtx->pDrmBufMgr);
+        va = CreatePooledBuffer(buf, mediaCtx->pDrmBufMgr, data == nullptr);
         if (va != VA_STATUS_SUCCESS)
         {
             MOS_FreeMemory(buf);
@@ -1090,7 +1315,7 @@ VAStatus DdiEncodeBase::CreateBuffer(
         bufSize       = size;
         buf->iSize  = size;
         buf->format = Media_Format_Buffer;
-        va           = DdiMediaUtil_CreateBuffer(buf, mediaCtx->pDrmBufMgr);
+        va           = CreatePooledBuffer(buf, mediaCtx->pDrmBufMgr, data == nullptr);
         if (va != VA_STATUS_SUCCESS)
         {
             MOS_FreeMemory(buf);
@@ -1103,7 +1328,7 @@ VAStatus DdiEncodeBase::CreateBuffer(
         bufSize       = size;
         buf->iSize  = size;
         buf->format = Media_Format_Buffer;
-        va           = DdiMediaUtil_CreateBuffer(buf, mediaCtx->pDrmBufMgr);
+        va           = CreatePooledBuffer(buf, mediaCtx->pDrmBufMgr, data == nullptr);
         if (va != VA_STATUS_SUCCESS)
         {
             MOS_FreeMemory(buf);
@@ -1142,7 +1367,7 @@ VAStatus DdiEncodeBase::CreateBuffer(
             buf->iSize  = size;
             buf->format = Media_Format_Buffer;
         }
-        va = DdiMediaUtil_CreateBuffer(buf, mediaCtx->pDrmBufMgr);
+        va = CreatePooledBuffer(buf, mediaCtx->pDrmBufMgr, data == nullptr);
         if (va != VA_STATUS_SUCCESS)
         {
             MOS_FreeMemory(buf);
@@ -1209,7 +1434,7 @@ VAStatus DdiEncodeBase::CreateBuffer(
         bufSize       = size;
         buf->iSize  = size * elementsNum;
         buf->format = Media_Format_Buffer;
-        va           = DdiMediaUtil_CreateBuffer(buf, mediaCtx->pDrmBufMgr);
+        va           = CreatePooledBuffer(buf, mediaCtx->pDrmBufMgr, data == nullptr);
         if (va != VA_STATUS_SUCCESS)
         {
             MOS_FreeMemory(buf);
@@ -1278,15 +1503,15 @@ VAStatus DdiEncodeBase::CreateBuffer(
         (VAEncMacroblockDisableSkipMapBufferType != (int32_t)type) &&
         (VAProbabilityBufferType != (int32_t)type))
     {
-        buf->pData = (uint8_t*)MOS_AllocAndZeroMemory(bufSize);
-        if (nullptr == buf->pData)
+        // Parameter buffers created with data are overwritten as a whole
+        buf->iSize  = bufSize;
+        buf->format = Media_Format_CPU;
+        va          = CreatePooledBuffer(buf, mediaCtx->pDrmBufMgr, data == nullptr);
+        if (va != VA_STATUS_SUCCESS)
         {
-            va = VA_STATUS_ERROR_ALLOCATION_FAILED;
             CleanUpBufferandReturn(buf);
             return va;
         }
-        buf->iSize  = bufSize;
-        buf->format = Media_Format_CPU;
     }
 
     PDDI_MEDIA_BUFFER_HEAP_ELEMENT bufferHeapElement = DdiMediaUtil_AllocPMediaBufferFromHeap(mediaCtx->pBufferHeap);
@@ -1336,6 +1561,16 @@ void DdiEncodeBase::CleanUpBufferandReturn(DDI_MEDIA_BUFFER *buf)
     }
 }
 
+VAStatus DdiEncodeBase::CreatePooledBuffer(DDI_MEDIA_BUFFER *buf, MOS_BUFMGR *bufmgr, bool zero)
+{
+    if (m_bufferPool)
+    {
+        return m_bufferPool->CreateBuffer(buf, bufmgr, zero);
+    }
+
+    return DdiMediaUtil_CreateBuffer(buf, bufmgr);
+}
+
 uint32_t DdiEncodeBase::getSliceParameterBufferSize()
 {
     return 0xffffffff;
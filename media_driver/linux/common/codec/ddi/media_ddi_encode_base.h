@@ -31,6 +31,7 @@
 #include "media_ddi_base.h"
 #include "media_libva_encoder.h"
 #include "codechal_setting.h"
+#include "media_libva_buffer_pool.h"
 
 //!
 //! \class  DdiEncodeBase
@@ -71,8 +72,11 @@ public:
     //!
     virtual ~DdiEncodeBase()
     {
+        DestroyFrameWorker();
         MOS_Delete(m_codechalSettings);
         m_codechalSettings = nullptr;
+        MOS_Delete(m_bufferPool);
+        m_bufferPool = nullptr;
     };
 
     virtual VAStatus BeginPicture(
@@ -105,6 +109,24 @@ public:
         DDI_MEDIA_BUFFER *mediaBuf,
         void             **buf);
 
+    //!
+    //! \brief    Wait for the frames queued to the encode worker
+    //! \details  Returns once every queued frame is executed by Codechal. Called
+    //!           before Codechal is queried or destroyed by the application thread.
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if the frames were executed successfully, else fail reason
+    //!
+    VAStatus WaitForFrames();
+
+    //!
+    //! \brief    Stop the encode worker
+    //! \details  Queued frames are executed before the worker exits
+    //!
+    //! \return   void
+    //!
+    void DestroyFrameWorker();
+
     //!
     //! \brief    Report Status for Enc buffer.
     //!
@@ -266,6 +288,7 @@ public:
     bool m_is10Bit                  = false;   //!< 10 bit flag.
     ChromaFormat m_chromaFormat     = yuv420;  //!< HCP chroma format.
     CodechalSetting    *m_codechalSettings = nullptr;    //!< Codechal Settings
+    DdiMediaBufferPool *m_bufferPool       = nullptr;    //!< Destroyed VA buffers kept for reuse, nullptr if disabled
 protected:
     //!
     //! \brief    Do Encode in codechal
@@ -280,6 +303,103 @@ protected:
     //!
     virtual VAStatus EncodeInCodecHal(uint32_t numSlices) = 0;
 
+    //!
+    //! \brief    Create the encode worker
+    //! \details  The worker executes frames in Codechal while the application thread
+    //!           parses and packs the next frames. Codecs using the worker copy the
+    //!           parameters of each frame into one of frameCtxNum frame contexts.
+    //!           Codechal keeps a single per-frame state (recycled buffer index,
+    //!           status report slot), so the worker runs Execute one frame at a
+    //!           time and only the DDI parameters are double buffered.
+    //!
+    //! \param    [in] frameCtxNum
+    //!           Number of frame contexts in flight
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if successful, else fail reason
+    //!
+    VAStatus CreateFrameWorker(uint32_t frameCtxNum);
+
+    //!
+    //! \brief    Get the number of frame contexts of a new encode context
+    //! \details  Read from the "Encode Frame Context Number" user feature and
+    //!           clamped to DDI_ENCODE_MAX_FRAME_CONTEXTS
+    //!
+    //! \return   uint32_t
+    //!           Number of frame contexts, 1 if frames are executed synchronously
+    //!
+    static uint32_t GetFrameContextNum();
+
+    //!
+    //! \brief    Check whether frames are executed by the encode worker
+    //!
+    //! \return   bool
+    //!           true if the encode worker is created
+    //!
+    bool IsFrameWorkerEnabled() { return m_frameWorker != 0; }
+
+    //!
+    //! \brief    Get the next free frame context
+    //! \details  Waits for the worker if all the frame contexts are in flight
+    //!
+    //! \return   uint32_t
+    //!           Index of the frame context to fill
+    //!
+    uint32_t AcquireFrameContext();
+
+    //!
+    //! \brief    Queue a filled frame context to the encode worker
+    //! \details  The raw surface is reported busy by vaSyncSurface and
+    //!           vaQuerySurfaceStatus until the frame is executed
+    //!
+    //! \param    [in] frameCtxIdx
+    //!           Index returned by AcquireFrameContext
+    //! \param    [in] rawSurface
+    //!           Raw surface of the frame
+    //!
+    //! \return   void
+    //!
+    void QueueFrameContext(uint32_t frameCtxIdx, DDI_MEDIA_SURFACE *rawSurface);
+
+    //!
+    //! \brief    Reference the bo of a resource used by a frame context
+    //! \details  Called while the frame context is filled. The reference is
+    //!           dropped by ReleaseFrameResources once the worker executed the frame.
+    //!
+    //! \param    [in] frameCtxIdx
+    //!           Index returned by AcquireFrameContext
+    //! \param    [in] resource
+    //!           Resource copied into the frame context, ignored if it has no bo
+    //!
+    //! \return   void
+    //!
+    void HoldFrameResource(uint32_t frameCtxIdx, PMOS_RESOURCE resource);
+
+    //!
+    //! \brief    Drop the bo references taken for a frame context
+    //!
+    //! \param    [in] frameCtxIdx
+    //!           Index of the frame context
+    //!
+    //! \return   void
+    //!
+    void ReleaseFrameResources(uint32_t frameCtxIdx);
+
+    //!
+    //! \brief    Execute a frame context in Codechal
+    //! \details  Called on the encode worker, in queue order
+    //!
+    //! \param    [in] frameCtxIdx
+    //!           Index of the frame context
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if successful, else fail reason
+    //!
+    virtual VAStatus ExecuteFrameContext(uint32_t frameCtxIdx)
+    {
+        return VA_STATUS_ERROR_UNIMPLEMENTED;
+    }
+
     //!
     //! \brief    Reset the parameters before each frame
     //! \details  Called by BeginPicture, reset sps parameter, bsbuffer,
@@ -510,10 +630,51 @@ protected:
     //! \return   void
     void CleanUpBufferandReturn(DDI_MEDIA_BUFFER *buf);
 
+    //!
+    //! \brief    Create the backing of a VA buffer from the buffer pool
+    //! \details  Falls back to DdiMediaUtil_CreateBuffer when the pool is disabled
+    //!
+    //! \param    [in,out] buf
+    //!           Pointer to DDI_MEDIA_BUFFER
+    //! \param    [in] bufmgr
+    //!           Mos buffer manager
+    //! \param    [in] zero
+    //!           Zero a CPU buffer taken from the pool
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus CreatePooledBuffer(DDI_MEDIA_BUFFER *buf, MOS_BUFMGR *bufmgr, bool zero);
+
     bool    m_newSeqHeader           = false;    //!< Flag for new Sequence Header.
     bool    m_newPpsHeader           = false;    //!< Flag for new Pps Header.
     bool    m_arbitraryNumMbsInSlice = false;    //!< Flag to indicate if the sliceMapSurface needs to be programmed or not.
     uint8_t m_scalingLists4x4[6][16]{};          //!< Inverse quantization scale lists 4x4.
     uint8_t m_scalingLists8x8[2][64]{};          //!< Inverse quantization scale lists 8x8.
+
+    MOS_THREADHANDLE    m_frameWorker       = 0;                    //!< Encode worker thread
+    PMOS_SEMAPHORE      m_frameQueued       = nullptr;              //!< Counts frame contexts queued to the worker
+    PMOS_SEMAPHORE      m_frameFree         = nullptr;              //!< Counts free frame contexts
+    uint32_t            m_frameCtxNum       = 0;                    //!< Number of frame contexts
+    uint32_t            m_frameHead         = 0;                    //!< Next frame context filled by the application thread
+    uint32_t            m_frameTail         = 0;                    //!< Next frame context executed by the worker
+    VAStatus            m_frameStatus       = VA_STATUS_SUCCESS;    //!< First failure of the worker, reported by WaitForFrames
+    PMOS_MUTEX          m_frameMutex        = nullptr;              //!< Protects m_frameStatus
+    bool                m_frameWorkerExit   = false;                //!< Set to stop the worker
+    PMEDIA_SEM_T        m_frameSurfaceSem[DDI_ENCODE_MAX_FRAME_CONTEXTS] = {};  //!< Raw surface semaphores held by the queued frames
+    MOS_LINUX_BO       *m_frameBos[DDI_ENCODE_MAX_FRAME_CONTEXTS][DDI_ENCODE_MAX_FRAME_BOS] = {};  //!< Bos referenced by the queued frames
+    uint32_t            m_frameBoNum[DDI_ENCODE_MAX_FRAME_CONTEXTS] = {};   //!< Number of bos referenced by each queued frame
+
+private:
+    //!
+    //! \brief    Encode worker thread function
+    //!
+    //! \param    [in] arg
+    //!           Pointer to DdiEncodeBase
+    //!
+    //! \return   void *
+    //!
+    static void *FrameWorker(void *arg);
 };
+
 #endif /* __MEDIA_DDI_ENCODE_BASE_H__ */
@@ -39,6 +39,22 @@ static bool isEncodeHevcRegistered =
 
 DdiEncodeHevc::~DdiEncodeHevc()
 {
+    // The worker reads the frame contexts, stop it before they are freed
+    DestroyFrameWorker();
+
+    if (m_frameCtx)
+    {
+        for (uint32_t i = 0; i < DDI_ENCODE_MAX_FRAME_CONTEXTS; i++)
+        {
+            MOS_FreeMemory(m_frameCtx[i].sliceParams);
+            MOS_FreeMemory(m_frameCtx[i].slcHeaderData);
+            MOS_FreeMemory(m_frameCtx[i].bsBuffer.pBase);
+            MOS_FreeMemory(m_frameCtx[i].seiData.pSEIBuffer);
+        }
+        MOS_FreeMemory(m_frameCtx);
+        m_frameCtx = nullptr;
+    }
+
     if (m_encodeCtx == nullptr)
     {
         return;
@@ -195,6 +211,17 @@ VAStatus DdiEncodeHevc::ContextInitialize(
     m_encodeCtx->pbsBuffer->pBase      = (uint8_t *)MOS_AllocAndZeroMemory(m_encodeCtx->pbsBuffer->BufferSize);
     DDI_CHK_NULL(m_encodeCtx->pbsBuffer->pBase, "nullptr m_encodeCtx->pbsBuffer->pBase.", VA_STATUS_ERROR_ALLOCATION_FAILED);
 
+    // Frame contexts let the next frame be parsed while Codechal executes the current one
+    uint32_t frameCtxNum = GetFrameContextNum();
+
+    if (frameCtxNum > 1 && m_encodeCtx->vaEntrypoint != VAEntrypointFEI)
+    {
+        m_frameCtx = (DdiEncodeHevcFrameContext *)MOS_AllocAndZeroMemory(DDI_ENCODE_MAX_FRAME_CONTEXTS * sizeof(DdiEncodeHevcFrameContext));
+        DDI_CHK_NULL(m_frameCtx, "nullptr m_frameCtx.", VA_STATUS_ERROR_ALLOCATION_FAILED);
+
+        eStatus = CreateFrameWorker(frameCtxNum);
+    }
+
     return eStatus;
 }
 
@@ -284,105 +311,145 @@ VAStatus DdiEncodeHevc::EncodeInCodecHal(uint32_t numSlices)
 
     DDI_CODEC_RENDER_TARGET_TABLE *rtTbl = &(m_encodeCtx->RTtbl);
 
-    EncoderParams encodeParams;
-    MOS_ZeroMemory(&encodeParams, sizeof(encodeParams));
+    // Keep the parameters in the context, MFE executes them later in vaMFSubmit
+    EncoderParams *encodeParams = &m_encodeCtx->EncodeParams;
+    MOS_ZeroMemory(encodeParams, sizeof(EncoderParams));
 
     if (m_encodeCtx->bVdencActive)
     {
-        encodeParams.ExecCodecFunction = CODECHAL_FUNCTION_ENC_VDENC_PAK;
+        encodeParams->ExecCodecFunction = CODECHAL_FUNCTION_ENC_VDENC_PAK;
     }
     else
     {
-        encodeParams.ExecCodecFunction = CODECHAL_FUNCTION_ENC_PAK;
+        encodeParams->ExecCodecFunction = CODECHAL_FUNCTION_ENC_PAK;
     }
 
     // Raw Surface
-    MOS_SURFACE rawSurface;
-    MOS_ZeroMemory(&rawSurface, sizeof(rawSurface));
-    rawSurface.dwOffset = 0;
+    PMOS_SURFACE rawSurface = &encodeParams->rawSurface;
+    rawSurface->dwOffset = 0;
 
-    DdiMedia_MediaSurfaceToMosResource(rtTbl->pCurrentRT, &(rawSurface.OsResource));
+    DdiMedia_MediaSurfaceToMosResource(rtTbl->pCurrentRT, &(rawSurface->OsResource));
 
     // Recon Surface
-    MOS_SURFACE reconSurface;
-    MOS_ZeroMemory(&reconSurface, sizeof(reconSurface));
-    reconSurface.dwOffset = 0;
+    PMOS_SURFACE reconSurface = &encodeParams->reconSurface;
+    reconSurface->dwOffset = 0;
 
-    DdiMedia_MediaSurfaceToMosResource(rtTbl->pCurrentReconTarget, &(reconSurface.OsResource));
+    DdiMedia_MediaSurfaceToMosResource(rtTbl->pCurrentReconTarget, &(reconSurface->OsResource));
 
     //clear registered recon/ref surface flags
     DDI_CHK_RET(ClearRefList(&m_encodeCtx->RTtbl, true), "ClearRefList failed!");
 
     // Bitstream surface
-    MOS_RESOURCE bitstreamSurface;
-    MOS_ZeroMemory(&bitstreamSurface, sizeof(bitstreamSurface));
-    bitstreamSurface        = m_encodeCtx->resBitstreamBuffer;  // in render picture
-    bitstreamSurface.Format = Format_Buffer;
+    PMOS_RESOURCE bitstreamSurface = &encodeParams->resBitstreamBuffer;
+    *bitstreamSurface        = m_encodeCtx->resBitstreamBuffer;  // in render picture
+    bitstreamSurface->Format = Format_Buffer;
 
-    encodeParams.psRawSurface        = &rawSurface;
-    encodeParams.psReconSurface      = &reconSurface;
-    encodeParams.presBitstreamBuffer = &bitstreamSurface;
+    encodeParams->psRawSurface        = rawSurface;
+    encodeParams->psReconSurface      = reconSurface;
+    encodeParams->presBitstreamBuffer = bitstreamSurface;
 
-    MOS_SURFACE mbQpSurface;
     if (m_encodeCtx->bMBQpEnable)
     {
         // MBQp surface
-        MOS_ZeroMemory(&mbQpSurface, sizeof(mbQpSurface));
-        mbQpSurface.Format     = Format_Buffer_2D;
-        mbQpSurface.dwOffset   = 0;
-        mbQpSurface.OsResource = m_encodeCtx->resMBQpBuffer;
+        PMOS_SURFACE mbQpSurface = &encodeParams->mbQpSurface;
+        mbQpSurface->Format     = Format_Buffer_2D;
+        mbQpSurface->dwOffset   = 0;
+        mbQpSurface->OsResource = m_encodeCtx->resMBQpBuffer;
 
-        encodeParams.psMbQpDataSurface = &mbQpSurface;
-        encodeParams.bMbQpDataEnabled  = true;
+        encodeParams->psMbQpDataSurface = mbQpSurface;
+        encodeParams->bMbQpDataEnabled  = true;
     }
 
     PCODEC_HEVC_ENCODE_SEQUENCE_PARAMS hevcSeqParams = (PCODEC_HEVC_ENCODE_SEQUENCE_PARAMS)((uint8_t *)m_encodeCtx->pSeqParams);
     hevcSeqParams->TargetUsage = m_encodeCtx->targetUsage;
-    encodeParams.pSeqParams   = m_encodeCtx->pSeqParams;
-    encodeParams.pVuiParams   = m_encodeCtx->pVuiParams;
-    encodeParams.pPicParams   = m_encodeCtx->pPicParams;
-    encodeParams.pSliceParams = m_encodeCtx->pSliceParams;
+    encodeParams->pSeqParams   = m_encodeCtx->pSeqParams;
+    encodeParams->pVuiParams   = m_encodeCtx->pVuiParams;
+    encodeParams->pPicParams   = m_encodeCtx->pPicParams;
+    encodeParams->pSliceParams = m_encodeCtx->pSliceParams;
 
     // Sequence data
-    encodeParams.bNewSeq = m_encodeCtx->bNewSeq;
+    encodeParams->bNewSeq = m_encodeCtx->bNewSeq;
 
     // VUI
-    encodeParams.bNewVuiData = m_encodeCtx->bNewVuiData;
+    encodeParams->bNewVuiData = m_encodeCtx->bNewVuiData;
 
     // Slice level data
-    encodeParams.dwNumSlices = numSlices;
+    encodeParams->dwNumSlices = numSlices;
 
     // IQmatrix params
-    encodeParams.bNewQmatrixData = m_encodeCtx->bNewQmatrixData;
-    encodeParams.bPicQuant       = m_encodeCtx->bPicQuant;
-    encodeParams.ppNALUnitParams = m_encodeCtx->ppNALUnitParams;
-    encodeParams.pSeiData        = m_encodeCtx->pSEIFromApp;
-    encodeParams.pSeiParamBuffer = m_encodeCtx->pSEIFromApp->pSEIBuffer;
-    encodeParams.dwSEIDataOffset = 0;
+    encodeParams->bNewQmatrixData = m_encodeCtx->bNewQmatrixData;
+    encodeParams->bPicQuant       = m_encodeCtx->bPicQuant;
+    encodeParams->ppNALUnitParams = m_encodeCtx->ppNALUnitParams;
+    encodeParams->pSeiData        = m_encodeCtx->pSEIFromApp;
+    encodeParams->pSeiParamBuffer = m_encodeCtx->pSEIFromApp->pSEIBuffer;
+    encodeParams->dwSEIDataOffset = 0;
 
-    CODECHAL_HEVC_IQ_MATRIX_PARAMS hevcIqMatrixParams;
-    encodeParams.pIQMatrixBuffer = &hevcIqMatrixParams;
+    encodeParams->pIQMatrixBuffer = &m_iqMatrixParams;
 
     // whether driver need to pack slice header
     if (m_encodeCtx->bHavePackedSliceHdr)
     {
-        encodeParams.bAcceleratorHeaderPackingCaps = false;
+        encodeParams->bAcceleratorHeaderPackingCaps = false;
     }
     else
     {
-        encodeParams.bAcceleratorHeaderPackingCaps = true;
+        encodeParams->bAcceleratorHeaderPackingCaps = true;
+    }
+
+    encodeParams->pBSBuffer      = m_encodeCtx->pbsBuffer;
+    encodeParams->pSlcHeaderData = (void *)m_encodeCtx->pSliceHeaderData;
+
+    CodechalEncoderState *encoder = dynamic_cast<CodechalEncoderState *>(m_encodeCtx->pCodecHal);
+    DDI_CHK_NULL(encoder, "nullptr Codechal encode", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    // MFE streams are executed together by vaMFSubmit
+    if (encoder->m_mfeEnabled)
+    {
+        return VA_STATUS_SUCCESS;
     }
 
-    encodeParams.pBSBuffer      = m_encodeCtx->pbsBuffer;
-    encodeParams.pSlcHeaderData = (void *)m_encodeCtx->pSliceHeaderData;
-    
+    if (IsFrameWorkerEnabled())
+    {
+        // Copy the frame out of the encode context, the application parses the next
+        // frame into it while the worker executes this one
+        uint32_t                  frameCtxIdx = AcquireFrameContext();
+        DdiEncodeHevcFrameContext *frameCtx   = &m_frameCtx[frameCtxIdx];
+
+        VAStatus status  = CopyToFrameContext(frameCtx, numSlices);
+        frameCtx->status = status;
+        if (status == VA_STATUS_SUCCESS)
+        {
+            EncoderParams *frameParams = &frameCtx->encodeParams;
+            HoldFrameResource(frameCtxIdx, &frameParams->rawSurface.OsResource);
+            HoldFrameResource(frameCtxIdx, &frameParams->reconSurface.OsResource);
+            HoldFrameResource(frameCtxIdx, &frameParams->resBitstreamBuffer);
+            if (frameParams->bMbQpDataEnabled)
+            {
+                HoldFrameResource(frameCtxIdx, &frameParams->mbQpSurface.OsResource);
+            }
+            if (frameParams->bMbDisableSkipMapEnabled)
+            {
+                HoldFrameResource(frameCtxIdx, &frameParams->disableSkipMapSurface.OsResource);
+            }
+        }
+        QueueFrameContext(frameCtxIdx, rtTbl->pCurrentRT);
+
+        return status;
+    }
+
+    return ExecuteInCodecHal(encodeParams);
+}
+
+VAStatus DdiEncodeHevc::ExecuteInCodecHal(EncoderParams *encodeParams)
+{
     CodechalEncoderState *encoder = dynamic_cast<CodechalEncoderState *>(m_encodeCtx->pCodecHal);
+    DDI_CHK_NULL(encoder, "nullptr Codechal encode", VA_STATUS_ERROR_INVALID_PARAMETER);
 
     encoder->m_mfeEncodeParams.submitIndex  = 0;
     encoder->m_mfeEncodeParams.submitNumber = 1; //By default we only use one stream
-    encoder->m_mfeEncodeParams.streamId  = 0;
+    encoder->m_mfeEncodeParams.streamId     = 0;
 
-    MOS_STATUS status = m_encodeCtx->pCodecHal->Execute(&encodeParams);
+    MOS_STATUS status = encoder->Execute(encodeParams);
     if (MOS_STATUS_SUCCESS != status)
     {
         DDI_ASSERTMESSAGE("DDI:Failed in Codechal!");
@@ -392,6 +459,115 @@ VAStatus DdiEncodeHevc::EncodeInCodecHal(uint32_t numSlices)
     return VA_STATUS_SUCCESS;
 }
 
+VAStatus DdiEncodeHevc::CopyToFrameContext(DdiEncodeHevcFrameContext *frameCtx, uint32_t numSlices)
+{
+    DDI_CHK_NULL(frameCtx, "nullptr frameCtx", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    EncoderParams *encodeParams = &frameCtx->encodeParams;
+    *encodeParams               = m_encodeCtx->EncodeParams;
+
+    // Slice arrays only grow, the frame context is reused for later frames
+    if (numSlices > frameCtx->maxNumSlices)
+    {
+        MOS_FreeMemory(frameCtx->sliceParams);
+        MOS_FreeMemory(frameCtx->slcHeaderData);
+        frameCtx->sliceParams   = (CODEC_HEVC_ENCODE_SLICE_PARAMS *)MOS_AllocMemory(numSlices * sizeof(CODEC_HEVC_ENCODE_SLICE_PARAMS));
+        frameCtx->slcHeaderData = (CODEC_ENCODER_SLCDATA *)MOS_AllocMemory(numSlices * sizeof(CODEC_ENCODER_SLCDATA));
+        frameCtx->maxNumSlices  = numSlices;
+        if (frameCtx->sliceParams == nullptr || frameCtx->slcHeaderData == nullptr)
+        {
+            frameCtx->maxNumSlices = 0;
+            return VA_STATUS_ERROR_ALLOCATION_FAILED;
+        }
+    }
+
+    BSBuffer *bsBuffer  = m_encodeCtx->pbsBuffer;
+    uint32_t headerSize = (uint32_t)(bsBuffer->pCurrent - bsBuffer->pBase);
+    if (frameCtx->bsBuffer.pBase == nullptr || frameCtx->bsBuffer.BufferSize < bsBuffer->BufferSize)
+    {
+        MOS_FreeMemory(frameCtx->bsBuffer.pBase);
+        frameCtx->bsBuffer.pBase = (uint8_t *)MOS_AllocMemory(bsBuffer->BufferSize);
+        DDI_CHK_NULL(frameCtx->bsBuffer.pBase, "nullptr frameCtx->bsBuffer.pBase", VA_STATUS_ERROR_ALLOCATION_FAILED);
+    }
+    uint8_t *headerBase = frameCtx->bsBuffer.pBase;
+    frameCtx->bsBuffer          = *bsBuffer;
+    frameCtx->bsBuffer.pBase    = headerBase;
+    frameCtx->bsBuffer.pCurrent = headerBase + headerSize;
+    if (headerSize)
+    {
+        MOS_SecureMemcpy(headerBase, bsBuffer->BufferSize, bsBuffer->pBase, headerSize);
+    }
+
+    frameCtx->seqParams      = *(PCODEC_HEVC_ENCODE_SEQUENCE_PARAMS)m_encodeCtx->pSeqParams;
+    frameCtx->picParams      = *(PCODEC_HEVC_ENCODE_PICTURE_PARAMS)m_encodeCtx->pPicParams;
+    frameCtx->iqMatrixParams = m_iqMatrixParams;
+
+    // The packed SEI of the application is rewritten by the next frame
+    CodechalEncodeSeiData *seiData = m_encodeCtx->pSEIFromApp;
+    if (seiData->dwSEIBufSize > frameCtx->seiData.dwSEIBufSize)
+    {
+        MOS_FreeMemory(frameCtx->seiData.pSEIBuffer);
+        frameCtx->seiData.pSEIBuffer   = (uint8_t *)MOS_AllocMemory(seiData->dwSEIBufSize);
+        frameCtx->seiData.dwSEIBufSize = frameCtx->seiData.pSEIBuffer ? seiData->dwSEIBufSize : 0;
+        DDI_CHK_NULL(frameCtx->seiData.pSEIBuffer, "nullptr frameCtx->seiData.pSEIBuffer", VA_STATUS_ERROR_ALLOCATION_FAILED);
+    }
+    frameCtx->seiData.newSEIData    = seiData->newSEIData;
+    frameCtx->seiData.dwSEIDataSize = seiData->dwSEIDataSize;
+    if (seiData->dwSEIDataSize && seiData->pSEIBuffer)
+    {
+        MOS_SecureMemcpy(frameCtx->seiData.pSEIBuffer, frameCtx->seiData.dwSEIBufSize,
+            seiData->pSEIBuffer, seiData->dwSEIDataSize);
+    }
+
+    if (numSlices)
+    {
+        MOS_SecureMemcpy(frameCtx->sliceParams, numSlices * sizeof(CODEC_HEVC_ENCODE_SLICE_PARAMS),
+            m_encodeCtx->pSliceParams, numSlices * sizeof(CODEC_HEVC_ENCODE_SLICE_PARAMS));
+        MOS_SecureMemcpy(frameCtx->slcHeaderData, numSlices * sizeof(CODEC_ENCODER_SLCDATA),
+            m_encodeCtx->pSliceHeaderData, numSlices * sizeof(CODEC_ENCODER_SLCDATA));
+    }
+    for (uint32_t i = 0; i < HEVC_MAX_NAL_UNIT_TYPE; i++)
+    {
+        frameCtx->nalUnitParams[i]     = *m_encodeCtx->ppNALUnitParams[i];
+        frameCtx->nalUnitParamsList[i] = &frameCtx->nalUnitParams[i];
+    }
+
+    encodeParams->psRawSurface        = &encodeParams->rawSurface;
+    encodeParams->psReconSurface      = &encodeParams->reconSurface;
+    encodeParams->presBitstreamBuffer = &encodeParams->resBitstreamBuffer;
+    if (encodeParams->bMbQpDataEnabled)
+    {
+        encodeParams->psMbQpDataSurface = &encodeParams->mbQpSurface;
+    }
+    encodeParams->pSeqParams      = &frameCtx->seqParams;
+    encodeParams->pPicParams      = &frameCtx->picParams;
+    encodeParams->pSliceParams    = frameCtx->sliceParams;
+    encodeParams->pIQMatrixBuffer = &frameCtx->iqMatrixParams;
+    encodeParams->ppNALUnitParams = frameCtx->nalUnitParamsList;
+    encodeParams->pSeiData        = &frameCtx->seiData;
+    encodeParams->pSeiParamBuffer = frameCtx->seiData.pSEIBuffer;
+    // The HEVC VUI is carried in the sequence parameters copied above
+    encodeParams->pVuiParams      = nullptr;
+    encodeParams->pBSBuffer       = &frameCtx->bsBuffer;
+    encodeParams->pSlcHeaderData  = (void *)frameCtx->slcHeaderData;
+
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus DdiEncodeHevc::ExecuteFrameContext(uint32_t frameCtxIdx)
+{
+    DDI_CHK_NULL(m_frameCtx, "nullptr m_frameCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    DdiEncodeHevcFrameContext *frameCtx = &m_frameCtx[frameCtxIdx];
+    if (frameCtx->status != VA_STATUS_SUCCESS)
+    {
+        // Already reported by EndPicture
+        return VA_STATUS_SUCCESS;
+    }
+
+    return ExecuteInCodecHal(&frameCtx->encodeParams);
+}
+
 VAStatus DdiEncodeHevc::ResetAtFrameLevel()
 {
     DDI_CHK_NULL(m_encodeCtx, "nullptr m_encodeCtx", VA_STATUS_ERROR_INVALID_PARAMETER);
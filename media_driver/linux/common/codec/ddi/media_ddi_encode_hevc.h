@@ -36,6 +36,26 @@ static const uint8_t sliceTypeI = 2;
 static const uint8_t numMaxRefFrame    = 15;
 static const uint8_t vdencRoiBlockSize = 32;
 
+//!
+//! \struct   DdiEncodeHevcFrameContext
+//! \brief    Copy of the parameters of one HEVC frame queued to the encode worker
+//!
+struct DdiEncodeHevcFrameContext
+{
+    EncoderParams                       encodeParams;                               //!< Points into the copies below
+    CODEC_HEVC_ENCODE_SEQUENCE_PARAMS   seqParams;
+    CODEC_HEVC_ENCODE_PICTURE_PARAMS    picParams;
+    CODECHAL_HEVC_IQ_MATRIX_PARAMS      iqMatrixParams;
+    CODECHAL_NAL_UNIT_PARAMS            nalUnitParams[HEVC_MAX_NAL_UNIT_TYPE];
+    PCODECHAL_NAL_UNIT_PARAMS           nalUnitParamsList[HEVC_MAX_NAL_UNIT_TYPE];
+    CodechalEncodeSeiData               seiData;                                    //!< Packed SEI, pSEIBuffer grows on demand
+    BSBuffer                            bsBuffer;                                   //!< Packed headers, pBase grows on demand
+    CODEC_HEVC_ENCODE_SLICE_PARAMS      *sliceParams;                               //!< Grows on demand
+    CODEC_ENCODER_SLCDATA               *slcHeaderData;                             //!< Grows on demand
+    uint32_t                            maxNumSlices;                               //!< Number of entries allocated in the slice arrays
+    VAStatus                            status;                                     //!< Failure while copying the frame, reported by the worker
+};
+
 //!
 //! \class  DdiEncodeHevc
 //! \brief  DDi encode HEVC
@@ -107,6 +127,32 @@ protected:
     //!
     VAStatus EncodeInCodecHal(uint32_t numSlices) override;
 
+    //!
+    //! \brief    Execute one frame in CodecHal for Hevc
+    //!
+    //! \param    [in] encodeParams
+    //!           Pointer to encode parameters of the frame
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus ExecuteInCodecHal(EncoderParams *encodeParams);
+
+    //!
+    //! \brief    Copy the parameters of the current frame to a frame context
+    //!
+    //! \param    [in] frameCtx
+    //!           Pointer to the frame context to fill
+    //! \param    [in] numSlices
+    //!           Number of slice data structures
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus CopyToFrameContext(DdiEncodeHevcFrameContext *frameCtx, uint32_t numSlices);
+
+    VAStatus ExecuteFrameContext(uint32_t frameCtxIdx) override;
+
     //!
     //! \brief    Parse Picture Parameter buffer to Encode Context
     //!
@@ -212,6 +258,10 @@ protected:
 
     uint16_t m_previousFRvalue = 0; //!< For saving FR value to be used in case of dynamic BRC reset.
 
+    CODECHAL_HEVC_IQ_MATRIX_PARAMS m_iqMatrixParams = {}; //!< IQ matrix, kept alive until the frame is executed.
+
+    DdiEncodeHevcFrameContext *m_frameCtx = nullptr; //!< Frame contexts executed by the encode worker.
+
 private:
     //!
     //! \brief    Get Encode Codechal Picture Type from Va Slice Type
@@ -61,6 +61,8 @@ DdiEncodeJpeg::~DdiEncodeJpeg()
 
     MOS_FreeMemory(m_appData);
     m_appData = nullptr;
+
+    ClearBatchImages();
 }
 
 VAStatus DdiEncodeJpeg::ContextInitialize(CodechalSetting *codecHalSettings)
@@ -92,8 +94,8 @@ VAStatus DdiEncodeJpeg::ContextInitialize(CodechalSetting *codecHalSettings)
     m_encodeCtx->pEncodeStatusReport = (void *)MOS_AllocAndZeroMemory(CODECHAL_ENCODE_STATUS_NUM * sizeof(EncodeStatusReport));
     DDI_CHK_NULL(m_encodeCtx->pEncodeStatusReport, "nullptr m_encodeCtx->pEncodeStatusReport.", VA_STATUS_ERROR_ALLOCATION_FAILED);
 
-    // for scan header from application
-    m_encodeCtx->pSliceParams = (void *)MOS_AllocAndZeroMemory(sizeof(CodecEncodeJpegScanHeader));
+    // for scan headers from application, at most one scan per component
+    m_encodeCtx->pSliceParams = (void *)MOS_AllocAndZeroMemory(jpegNumComponent * sizeof(CodecEncodeJpegScanHeader));
     DDI_CHK_NULL(m_encodeCtx->pSliceParams, "nullptr m_encodeCtx->pSliceParams.", VA_STATUS_ERROR_ALLOCATION_FAILED);
 
     // for Quant table
@@ -148,10 +150,22 @@ VAStatus DdiEncodeJpeg::RenderPicture(
             break;
 
         case VAEncPictureParameterBufferType:
+            if (m_imageStarted && m_encodeCtx->bJpegBatch)
+            {
+                // Another image of the batch, keep the previous one
+                if (m_batchImages.size() + 2 > CODECHAL_ENCODE_MAX_BATCH_PICS)
+                {
+                    DDI_ASSERTMESSAGE("Too many images in JPEG batch.");
+                    vaStatus = VA_STATUS_ERROR_INVALID_BUFFER;
+                    break;
+                }
+                DDI_CHK_STATUS(SaveBatchImage(), VA_STATUS_ERROR_INVALID_BUFFER);
+            }
             DDI_CHK_STATUS(ParsePicParams(mediaCtx, data), VA_STATUS_ERROR_INVALID_BUFFER);
             DDI_CHK_STATUS(
                     AddToStatusReportQueue((void *)m_encodeCtx->resBitstreamBuffer.bo),
                     VA_STATUS_ERROR_INVALID_BUFFER);
+            m_imageStarted = true;
             break;
 
         case VAEncSliceParameterBufferType:
@@ -214,6 +228,73 @@ VAStatus DdiEncodeJpeg::RenderPicture(
     return vaStatus;
 }
 
+VAStatus DdiEncodeJpeg::StatusReport(
+    DDI_MEDIA_BUFFER *mediaBuf,
+    void             **buf)
+{
+    DDI_CHK_RET(DdiEncodeBase::StatusReport(mediaBuf, buf), "Failed to report the status");
+
+    VACodedBufferSegment *codedBufferSegment = m_encodeCtx->BufMgr.pCodedBufferSegment;
+    codedBufferSegment->next = nullptr;
+
+    uint32_t size   = 0;
+    uint32_t status = 0;
+    int32_t  index  = 0;
+    if (GetSizeFromStatusReportBuffer(mediaBuf, &size, &status, &index) != VA_STATUS_SUCCESS || size == 0)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    // The last scan ends with the picture, anything else is the entry of an older picture
+    uint32_t  numScans      = m_numScans[index];
+    uint32_t *scanEndOffset = m_scanEndOffset[index];
+    if (numScans < 2 || scanEndOffset[numScans - 1] != size)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    codedBufferSegment->size = scanEndOffset[0];
+    for (uint32_t i = 1; i < numScans; i++)
+    {
+        if (scanEndOffset[i] < scanEndOffset[i - 1])
+        {
+            DDI_ASSERTMESSAGE("DDI: invalid JPEG scan end offset.");
+            codedBufferSegment->size = size;
+            codedBufferSegment->next = nullptr;
+            return VA_STATUS_SUCCESS;
+        }
+
+        VACodedBufferSegment *scanSegment = &m_scanSegments[i - 1];
+        scanSegment->buf    = (uint8_t *)codedBufferSegment->buf + scanEndOffset[i - 1];
+        scanSegment->size   = scanEndOffset[i] - scanEndOffset[i - 1];
+        scanSegment->status = status;
+        scanSegment->next   = nullptr;
+
+        (i == 1 ? codedBufferSegment : &m_scanSegments[i - 2])->next = scanSegment;
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus DdiEncodeJpeg::ReportExtraStatus(
+    EncodeStatusReport   *encodeStatusReport,
+    VACodedBufferSegment *codedBufferSegment)
+{
+    DDI_CHK_NULL(encodeStatusReport, "nullptr encodeStatusReport", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    // UpdateStatusReportBuffer moved past the entry of this coded buffer
+    uint32_t index = (m_encodeCtx->statusReportBuf.ulUpdatePosition + DDI_ENCODE_MAX_STATUS_REPORT_BUFFER - 1) % DDI_ENCODE_MAX_STATUS_REPORT_BUFFER;
+
+    uint32_t numScans = MOS_MIN(encodeStatusReport->NumberSlices, CODECHAL_ENCODE_MAX_SCANS);
+    m_numScans[index] = numScans;
+    for (uint32_t i = 0; i < numScans; i++)
+    {
+        m_scanEndOffset[index][i] = encodeStatusReport->ScanEndOffset[i];
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+
 // reset the parameters before each frame
 VAStatus DdiEncodeJpeg::ResetAtFrameLevel()
 {
@@ -224,12 +305,16 @@ VAStatus DdiEncodeJpeg::ResetAtFrameLevel()
     DDI_CHK_NULL(picParams, "nullptr picParams", VA_STATUS_ERROR_INVALID_PARAMETER);
 
     picParams->m_inputSurfaceFormat = ConvertMediaFormatToInputSurfaceFormat(m_encodeCtx->RTtbl.pCurrentRT->format);
+    m_imageSurface                  = m_encodeCtx->RTtbl.pCurrentRT;
 
     m_appDataSize = 0;
     m_appDataTotalSize = 0;
     m_appDataWholeHeader = false;
     m_quantSupplied = false;
 
+    m_imageStarted = false;
+    ClearBatchImages();
+
     return VA_STATUS_SUCCESS;
 }
 
@@ -244,6 +329,15 @@ VAStatus DdiEncodeJpeg::ParsePicParams(DDI_MEDIA_CONTEXT *mediaCtx, void *ptr)
     CodecEncodeJpegPictureParams *jpegPicParams = (CodecEncodeJpegPictureParams *)m_encodeCtx->pPicParams;
     DDI_CHK_NULL(jpegPicParams, "nullptr jpegPicParams", VA_STATUS_ERROR_INVALID_PARAMETER);
 
+    // The images of a batch are read from their reconstructed_picture
+    if (m_encodeCtx->bJpegBatch)
+    {
+        m_imageSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, picParams->reconstructed_picture);
+        DDI_CHK_NULL(m_imageSurface, "nullptr m_imageSurface", VA_STATUS_ERROR_INVALID_SURFACE);
+
+        jpegPicParams->m_inputSurfaceFormat = ConvertMediaFormatToInputSurfaceFormat(m_imageSurface->format);
+    }
+
     if (jpegPicParams->m_inputSurfaceFormat == DDI_ENCODE_JPEG_INPUTFORMAT_RESERVED)
     {
         return VA_STATUS_ERROR_INVALID_PARAMETER;
@@ -281,7 +375,8 @@ VAStatus DdiEncodeJpeg::ParseSlcParams(DDI_MEDIA_CONTEXT *mediaCtx, void *ptr, u
 {
     DDI_UNUSED(mediaCtx);
 
-    if (numSlices != 1)
+    // Each slice parameter is a scan, a component is coded by one scan
+    if (numSlices == 0 || numSlices > jpegNumComponent)
     {
         return VA_STATUS_ERROR_INVALID_PARAMETER;
     }
@@ -297,20 +392,40 @@ VAStatus DdiEncodeJpeg::ParseSlcParams(DDI_MEDIA_CONTEXT *mediaCtx, void *ptr, u
 
     m_encodeCtx->dwNumSlices = numSlices;
 
-    // Only 1 scan is supported for JPEG
-    scanData->m_restartInterval = scanParams->restart_interval;
-    scanData->m_numComponent    = scanParams->num_components;
+    for (uint32_t scanCount = 0; scanCount < numSlices; scanCount++)
+    {
+        if (scanParams[scanCount].num_components > jpegNumComponent)
+        {
+            return VA_STATUS_ERROR_INVALID_PARAMETER;
+        }
+
+        scanData[scanCount].m_restartInterval = scanParams[scanCount].restart_interval;
+        scanData[scanCount].m_numComponent    = scanParams[scanCount].num_components;
+
+        for (int32_t componentCount = 0; componentCount < jpegNumComponent; componentCount++)
+        {
+            scanData[scanCount].m_componentSelector[componentCount]   = scanParams[scanCount].components[componentCount].component_selector;
+            scanData[scanCount].m_dcCodingTblSelector[componentCount] = scanParams[scanCount].components[componentCount].dc_table_selector;
+            scanData[scanCount].m_acCodingTblSelector[componentCount] = scanParams[scanCount].components[componentCount].ac_table_selector;
+        }
+    }
 
     for (int32_t componentCount = 0; componentCount < jpegNumComponent; componentCount++)
     {
-        scanData->m_componentSelector[componentCount]   = scanParams->components[componentCount].component_selector;
-        scanData->m_dcCodingTblSelector[componentCount] = scanParams->components[componentCount].dc_table_selector;
-        scanData->m_acCodingTblSelector[componentCount] = scanParams->components[componentCount].ac_table_selector;
-
         // AC and DC table selectors always have the same value for android
         m_huffmanTable->m_huffmanData[componentCount].m_tableID = scanData->m_dcCodingTblSelector[componentCount];
     }
 
+    // The luma tables are selected by the first scan component and the chroma tables by the
+    // second one, which starts the second scan when the first scan has a single component
+    CodecEncodeJpegScanHeader *chromaScan      = scanData;
+    uint32_t                  chromaComponent = 1;
+    if (numSlices > 1 && scanData->m_numComponent == 1)
+    {
+        chromaScan      = &scanData[1];
+        chromaComponent = 0;
+    }
+
     // Table ID for DC table for luma
     m_huffmanTable->m_huffmanData[0].m_tableID = scanData->m_dcCodingTblSelector[0];
 
@@ -318,10 +433,10 @@ VAStatus DdiEncodeJpeg::ParseSlcParams(DDI_MEDIA_CONTEXT *mediaCtx, void *ptr, u
     m_huffmanTable->m_huffmanData[1].m_tableID = scanData->m_acCodingTblSelector[0];
 
     // Table ID for DC table for chroma
-    m_huffmanTable->m_huffmanData[2].m_tableID = scanData->m_dcCodingTblSelector[1];
+    m_huffmanTable->m_huffmanData[2].m_tableID = chromaScan->m_dcCodingTblSelector[chromaComponent];
 
     // Table ID for AC table for chroma
-    m_huffmanTable->m_huffmanData[3].m_tableID = scanData->m_dcCodingTblSelector[1];
+    m_huffmanTable->m_huffmanData[3].m_tableID = chromaScan->m_dcCodingTblSelector[chromaComponent];
 
     return VA_STATUS_SUCCESS;
 }
@@ -491,18 +606,117 @@ VAStatus DdiEncodeJpeg::ParseAppData(void *ptr, int32_t size)
     return VA_STATUS_SUCCESS;
 }
 
+VAStatus DdiEncodeJpeg::SaveBatchImage()
+{
+    DDI_CHK_NULL(m_encodeCtx, "nullptr m_encodeCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CHK_NULL(m_huffmanTable, "nullptr m_huffmanTable", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    BatchImage image;
+    image.picParams          = *(CodecEncodeJpegPictureParams *)m_encodeCtx->pPicParams;
+    image.numScans           = m_encodeCtx->dwNumSlices;
+    MOS_SecureMemcpy(image.scanData, sizeof(image.scanData), m_encodeCtx->pSliceParams, sizeof(image.scanData));
+    image.quantTables        = *(CodecEncodeJpegQuantTable *)m_encodeCtx->pQmatrixParams;
+    image.huffmanTable       = *m_huffmanTable;
+    image.appData            = m_appData;
+    image.appDataTotalSize   = m_appDataTotalSize;
+    image.appDataWholeHeader = m_appDataWholeHeader;
+    image.quantSupplied      = m_quantSupplied;
+    image.surface            = m_imageSurface;
+    image.resBitstreamBuffer = m_encodeCtx->resBitstreamBuffer;
+    m_batchImages.push_back(image);
+
+    m_appData            = nullptr;
+    m_appDataSize        = 0;
+    m_appDataTotalSize   = 0;
+    m_appDataWholeHeader = false;
+    m_quantSupplied      = false;
+
+    return VA_STATUS_SUCCESS;
+}
+
+VAStatus DdiEncodeJpeg::RestoreBatchImage(uint32_t idx)
+{
+    DDI_CHK_NULL(m_encodeCtx, "nullptr m_encodeCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CHK_NULL(m_huffmanTable, "nullptr m_huffmanTable", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CHK_CONDITION(idx >= m_batchImages.size(), "Invalid batch image", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    BatchImage &image = m_batchImages[idx];
+    *(CodecEncodeJpegPictureParams *)m_encodeCtx->pPicParams = image.picParams;
+    MOS_SecureMemcpy(m_encodeCtx->pSliceParams, sizeof(image.scanData), image.scanData, sizeof(image.scanData));
+    m_encodeCtx->dwNumSlices                                 = image.numScans;
+    *(CodecEncodeJpegQuantTable *)m_encodeCtx->pQmatrixParams = image.quantTables;
+    *m_huffmanTable                                          = image.huffmanTable;
+
+    MOS_FreeMemory(m_appData);
+    m_appData            = image.appData;
+    image.appData        = nullptr;
+    m_appDataTotalSize   = image.appDataTotalSize;
+    m_appDataWholeHeader = image.appDataWholeHeader;
+    m_quantSupplied      = image.quantSupplied;
+    m_imageSurface       = image.surface;
+    m_encodeCtx->resBitstreamBuffer = image.resBitstreamBuffer;
+
+    return VA_STATUS_SUCCESS;
+}
+
+void DdiEncodeJpeg::ClearBatchImages()
+{
+    for (auto &image : m_batchImages)
+    {
+        MOS_FreeMemory(image.appData);
+        image.appData = nullptr;
+    }
+    m_batchImages.clear();
+}
+
 VAStatus DdiEncodeJpeg::EncodeInCodecHal(uint32_t numSlices)
+{
+    if (m_batchImages.empty())
+    {
+        return EncodeImage(numSlices, 0, 0, 0);
+    }
+
+    // Keep the last image too, then encode the images in their order in one command buffer
+    DDI_CHK_RET(SaveBatchImage(), "Failed to keep JPEG image");
+
+    uint32_t batchNum         = m_batchImages.size();
+    uint32_t batchAppDataSize = 0;
+    for (auto &image : m_batchImages)
+    {
+        batchAppDataSize += image.appDataTotalSize;
+    }
+
+    VAStatus status = VA_STATUS_SUCCESS;
+    for (uint32_t i = 0; i < batchNum && status == VA_STATUS_SUCCESS; i++)
+    {
+        status = RestoreBatchImage(i);
+        if (status == VA_STATUS_SUCCESS)
+        {
+            status = EncodeImage(m_encodeCtx->dwNumSlices, i, batchNum, batchAppDataSize);
+        }
+    }
+
+    ClearBatchImages();
+    m_imageStarted = false;
+
+    return status;
+}
+
+VAStatus DdiEncodeJpeg::EncodeImage(
+    uint32_t numSlices,
+    uint32_t batchIdx,
+    uint32_t batchNum,
+    uint32_t batchAppDataSize)
 {
     DDI_CHK_NULL(m_encodeCtx, "nullptr m_encodeCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(m_encodeCtx->pCodecHal, "nullptr m_encodeCtx->pCodecHal", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CHK_NULL(m_imageSurface, "nullptr m_imageSurface", VA_STATUS_ERROR_INVALID_SURFACE);
 
-    if (numSlices != 1)
+    if (numSlices == 0 || numSlices > jpegNumComponent)
     {
         return VA_STATUS_ERROR_INVALID_PARAMETER;
     }
 
-    DDI_CODEC_RENDER_TARGET_TABLE *rtTbl = &(m_encodeCtx->RTtbl);
-
     CodecEncodeJpegPictureParams *picParams = (CodecEncodeJpegPictureParams *)(m_encodeCtx->pPicParams);
 
     CodecEncodeJpegScanHeader *scanData = (CodecEncodeJpegScanHeader *)m_encodeCtx->pSliceParams;
@@ -530,7 +744,7 @@ VAStatus DdiEncodeJpeg::EncodeInCodecHal(uint32_t numSlices)
     rawSurface.Format   = (MOS_FORMAT)picParams->m_inputSurfaceFormat;
     rawSurface.dwOffset = 0;
 
-    DdiMedia_MediaSurfaceToMosResource(rtTbl->pCurrentRT, &(rawSurface.OsResource));
+    DdiMedia_MediaSurfaceToMosResource(m_imageSurface, &(rawSurface.OsResource));
     // Recon Surface
     MOS_SURFACE reconSurface;
     MOS_ZeroMemory(&reconSurface, sizeof(MOS_SURFACE));
@@ -559,12 +773,18 @@ VAStatus DdiEncodeJpeg::EncodeInCodecHal(uint32_t numSlices)
     encodeParams.dwAppDataSize    = m_appDataTotalSize;
     encodeParams.fullHeaderInAppData = m_appDataWholeHeader;
 
+    encodeParams.dwBatchPicIdx      = batchIdx;
+    encodeParams.dwBatchPicNum      = batchNum;
+    encodeParams.dwBatchAppDataSize = batchAppDataSize;
+
     encodeParams.pQuantizationTable = m_encodeCtx->pQmatrixParams;
     encodeParams.pHuffmanTable      = m_huffmanTable;
     encodeParams.pBSBuffer          = m_encodeCtx->pbsBuffer;
     encodeParams.pSlcHeaderData     = (void *)m_encodeCtx->pSliceHeaderData;
 
-    if (scanData->m_numComponent == 1)  // Y8 input format
+    // The first of several scans may code the luma component alone
+    uint32_t numComponent = (numSlices > 1) ? picParams->m_numComponent : scanData->m_numComponent;
+    if (numComponent == 1)  // Y8 input format
     {
         // Take the first table sent by the app
         encodeParams.dwNumHuffBuffers = 2;
@@ -27,6 +27,7 @@
 #ifndef __MEDIA_LIBVA_ENCODER_JPEG_H__
 #define __MEDIA_LIBVA_ENCODER_JPEG_H__
 
+#include <vector>
 #include "media_ddi_encode_base.h"
 
 static const uint8_t maxNumQuantTableIndex = 3;
@@ -102,6 +103,11 @@ public:
 
     //!
     //! \brief    Parse buffer to the server.
+    //! \details  In a context created with DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH, each
+    //!           picture parameter buffer after the first one of a picture starts
+    //!           another image, with its own coded buffer, tables and application
+    //!           data. The input surface of every image is its reconstructed_picture.
+    //!           The images are encoded back to back in one command buffer.
     //!
     //! \param    [in] ctx
     //!           Pointer to VADriverContextP
@@ -121,7 +127,41 @@ public:
         VABufferID       *buffers,
         int32_t          numBuffers) override;
 
+    //!
+    //! \brief    Report the status of a coded buffer
+    //! \details  The coded buffer of a picture with several scans is returned as
+    //!           one segment per scan, the first one starting with the headers.
+    //!           The segments are contiguous, applications reading every segment
+    //!           get the whole picture.
+    //!
+    //! \param    [in] mediaBuf
+    //!           Pointer to DDI_MEDIA_BUFFER
+    //! \param    [out] buf
+    //!           Pointer to buffer
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus StatusReport(
+        DDI_MEDIA_BUFFER *mediaBuf,
+        void             **buf) override;
+
 protected:
+    //!
+    //! \brief    Keep the scan end offsets of a completed coded buffer
+    //!
+    //! \param    [in] encodeStatusReport
+    //!           Pointer to encode status reported by Codechal
+    //! \param    [out] codedBufferSegment
+    //!           Pointer to coded buffer segment
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus ReportExtraStatus(
+        EncodeStatusReport   *encodeStatusReport,
+        VACodedBufferSegment *codedBufferSegment) override;
+
     //!
     //! \brief    Reset Encode Context At Frame Level
     //!
@@ -247,11 +287,83 @@ private:
     //!
     uint32_t ConvertMediaFormatToInputSurfaceFormat(DDI_MEDIA_FORMAT format);
 
+    //!
+    //! \brief    Encode the current image in CodecHal
+    //!
+    //! \param    [in] numSlices
+    //!           Number of slice data structures
+    //! \param    [in] batchIdx
+    //!           Index of the image in its batch
+    //! \param    [in] batchNum
+    //!           Number of images in the batch, 0 if not batched
+    //! \param    [in] batchAppDataSize
+    //!           Application data size of the whole batch
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus EncodeImage(
+        uint32_t numSlices,
+        uint32_t batchIdx,
+        uint32_t batchNum,
+        uint32_t batchAppDataSize);
+
+    //!
+    //! \brief    Keep the current image for a batched encode
+    //! \details  The image state is moved to the batch, and the next image
+    //!           starts without tables or application data of its own
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus SaveBatchImage();
+
+    //!
+    //! \brief    Make a kept image the current one
+    //!
+    //! \param    [in] idx
+    //!           Index of the image in the batch
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus RestoreBatchImage(uint32_t idx);
+
+    //!
+    //! \brief    Drop the kept images and their application data
+    //!
+    void ClearBatchImages();
+
+    //!
+    //! \struct   BatchImage
+    //! \brief    Image of a batch encoded in one command buffer
+    //!
+    struct BatchImage
+    {
+        CodecEncodeJpegPictureParams    picParams;
+        CodecEncodeJpegScanHeader       scanData[jpegNumComponent];
+        uint32_t                        numScans;               //!< Number of scans in scanData
+        CodecEncodeJpegQuantTable       quantTables;
+        CodecEncodeJpegHuffmanDataArray huffmanTable;
+        void                            *appData;               //!< Owned by the image until it is restored
+        uint32_t                        appDataTotalSize;
+        uint32_t                        appDataWholeHeader;
+        bool                            quantSupplied;
+        DDI_MEDIA_SURFACE               *surface;               //!< Input surface
+        MOS_RESOURCE                    resBitstreamBuffer;     //!< Coded buffer
+    };
+
     CodecEncodeJpegHuffmanDataArray    *m_huffmanTable = nullptr;    //!< Huffman table.
     void                               *m_appData      = nullptr;    //!< Application data.
     bool                               m_quantSupplied = false;      //!< whether Quant table is supplied by the app for JPEG encoder.
     uint32_t                           m_appDataTotalSize   = 0;          //!< Total size of application data.
     uint32_t                           m_appDataSize   = 0;          //!< Size of application data.
     uint32_t                           m_appDataWholeHeader = false; //!< whether the app data include whole headers , such as SOI, DQT ...
+    DDI_MEDIA_SURFACE                  *m_imageSurface = nullptr;    //!< Input surface of the current image.
+    bool                               m_imageStarted = false;       //!< Picture parameters of the current image were sent.
+    std::vector<BatchImage>            m_batchImages;                //!< Images before the current one in this picture, encoded in one command buffer.
+    uint32_t                           m_numScans[DDI_ENCODE_MAX_STATUS_REPORT_BUFFER] = {};  //!< Number of scans of each status report entry.
+    uint32_t                           m_scanEndOffset[DDI_ENCODE_MAX_STATUS_REPORT_BUFFER][CODECHAL_ENCODE_MAX_SCANS] = {};  //!< Bitstream size at the end of each scan.
+    VACodedBufferSegment               m_scanSegments[CODECHAL_ENCODE_MAX_SCANS - 1] = {};    //!< Segments of the scans after the first one.
 };
 #endif /* __MEDIA_LIBVA_ENCODER_JPEG_H__ */
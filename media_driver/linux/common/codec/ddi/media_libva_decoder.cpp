@@ -213,6 +213,9 @@ void DdiDecodeCleanUp(
  *  config_id: configuration for the context
  *  picture_width: coded picture width
  *  picture_height: coded picture height
+ *  flag: any combination of the following:
+ *  VA_PROGRESSIVE (only progressive frame pictures in the sequence when set)
+ *  DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH (JPEG pictures carry several images when set)
  *  render_targets: render targets (surfaces) tied to the context
  *  num_render_targets: number of render targets in the above array
  *  context: created context id upon return
@@ -233,8 +236,6 @@ VAStatus DdiDecode_CreateContext (
     DdiMediaDecode                    *ddiDecBase;
     DDI_DECODE_CONFIG_ATTR            decConfigAttr;
 
-    DDI_UNUSED(flag);
-
     VAStatus va            = VA_STATUS_SUCCESS;
     decConfigAttr.uiDecSliceMode = VA_DEC_SLICE_MODE_BASE;
     *context            = VA_INVALID_ID;
@@ -263,6 +264,12 @@ VAStatus DdiDecode_CreateContext (
             &decConfigAttr.uiEncryptionType,
             &decConfigAttr.uiDecProcessingType),"Invalide config_id!");
 
+    // Only JPEG pictures can carry several images
+    if ((flag & DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH) && decConfigAttr.profile != VAProfileJPEGBaseline)
+    {
+        return VA_STATUS_ERROR_INVALID_PARAMETER;
+    }
+
     mode = mediaCtx->m_caps->GetDecodeCodecMode(decConfigAttr.profile);
     codecKey =  mediaCtx->m_caps->GetDecodeCodecKey(decConfigAttr.profile);
     va       =  mediaCtx->m_caps->CheckDecodeResolution(
@@ -301,6 +308,7 @@ VAStatus DdiDecode_CreateContext (
 
     decCtx->pMediaCtx                       = mediaCtx;
     decCtx->m_ddiDecode                     = ddiDecBase;
+    decCtx->bJpegBatch                      = (flag & DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH) != 0;
 
     mosCtx.bufmgr                = mediaCtx->pDrmBufMgr;
     mosCtx.m_gpuContextMgr       = mediaCtx->m_gpuContextMgr;
@@ -80,6 +80,8 @@ struct DDI_DECODE_CONTEXT
     uint32_t                        dwSliceParamBufNum;
     uint32_t                        dwSliceCtrlBufNum;
     uint32_t                        uiDecProcessingType;
+    // Created with DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH
+    bool                            bJpegBatch;
 };
 
 typedef struct DDI_DECODE_CONTEXT *PDDI_DECODE_CONTEXT;
@@ -25,6 +25,7 @@
 //!
 #include <unistd.h>
 #include "media_libva_encoder.h"
+#include "codechal_encode_ds_share.h"
 #include "media_ddi_encode_base.h"
 #include "media_libva_util.h"
 #include "media_libva_caps.h"
@@ -160,7 +161,14 @@ VAStatus DdiEncode_StatusReport(
     DDI_CHK_NULL(mediaBuf, "nullptr mediaBuf", VA_STATUS_ERROR_INVALID_PARAMETER);
     DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_PARAMETER);
 
-    VAStatus vaStatus = encCtx->m_encode->StatusReport(mediaBuf, buf);
+    // Codechal status is only valid once the queued frames are executed
+    VAStatus vaStatus = encCtx->m_encode->WaitForFrames();
+    if (vaStatus != VA_STATUS_SUCCESS)
+    {
+        return vaStatus;
+    }
+
+    vaStatus = encCtx->m_encode->StatusReport(mediaBuf, buf);
 
     return vaStatus;
 }
@@ -199,6 +207,7 @@ void DdiEncodeCleanUp(PDDI_ENCODE_CONTEXT encCtx)
  *  picture_height: encode picture height
  *  flag: any combination of the following:
  *  VA_PROGRESSIVE (only progressive frame pictures in the sequence when set)
+ *  DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH (JPEG pictures carry several images when set)
  *  render_targets: render targets (surfaces) tied to the context
  *  num_render_targets: number of render targets in the above array
  *  context: created context id upon return
@@ -245,6 +254,12 @@ VAStatus DdiEncode_CreateContext(
         return VA_STATUS_ERROR_MAX_NUM_EXCEEDED;
     }
 
+    // Only JPEG pictures can carry several images
+    if ((flag & DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH) && profile != VAProfileJPEGBaseline)
+    {
+        return VA_STATUS_ERROR_INVALID_PARAMETER;
+    }
+
     std::string    encodeKey = mediaDrvCtx->m_caps->GetEncodeCodecKey(profile, entrypoint, feiFunction);
     DdiEncodeBase *ddiEncode = DdiEncodeFactory::CreateCodec(encodeKey);
     DDI_CHK_NULL(ddiEncode, "nullptr ddiEncode", VA_STATUS_ERROR_UNIMPLEMENTED);
@@ -293,6 +308,7 @@ VAStatus DdiEncode_CreateContext(
     encCtx->vaEntrypoint  = entrypoint;
     encCtx->vaProfile     = profile;
     encCtx->uiRCMethod    = rcMode;
+    encCtx->bJpegBatch    = (flag & DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH) != 0;
     encCtx->wModeType     = mediaDrvCtx->m_caps->GetEncodeCodecMode(profile, entrypoint);
     encCtx->codecFunction = mediaDrvCtx->m_caps->GetEncodeCodecFunction(profile, entrypoint, feiFunction);
 
@@ -391,6 +407,18 @@ VAStatus DdiEncode_CreateContext(
         return vaStatus;
     }
 
+    // Destroyed VA buffers are recycled within the context unless the budget is 0
+    MOS_USER_FEATURE_VALUE_DATA userFeatureData;
+    MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __MEDIA_USER_FEATURE_VALUE_ENCODE_BUFFER_POOL_BUDGET_ID,
+        &userFeatureData);
+    if (userFeatureData.i32Data > 0)
+    {
+        encCtx->m_encode->m_bufferPool = MOS_New(DdiMediaBufferPool, (uint32_t)userFeatureData.i32Data * 1024);
+    }
+
     // register the render target surfaces for this encoder instance
     // This is a must as driver has the constraint, 127 surfaces per context
     for (int32_t i = 0; i < num_render_targets; i++)
@@ -450,7 +478,10 @@ VAStatus DdiEncode_DestroyContext(VADriverContextP ctx, VAContextID context)
 
     if (nullptr != encCtx->m_encode)
     {
+        encCtx->m_encode->DestroyFrameWorker();
         encCtx->m_encode->FreeCompBuffer();
+        MOS_Delete(encCtx->m_encode->m_bufferPool);
+        encCtx->m_encode->m_bufferPool = nullptr;
         if(nullptr != encCtx->m_encode->m_codechalSettings)
         {
             MOS_Delete(encCtx->m_encode->m_codechalSettings);
@@ -639,6 +670,7 @@ VAStatus DdiEncode_MfeSubmit(
     CodechalEncodeMdfKernelResource *resMbencKernel = encodeMfeContext->mfeEncodeSharedState->resMbencKernel;
     SurfaceIndex *vmeSurface    = encodeMfeContext->mfeEncodeSharedState->vmeSurface;
     SurfaceIndex *commonSurface = encodeMfeContext->mfeEncodeSharedState->commonSurface;
+    CodechalEncodeDsShare *dsShare = encodeMfeContext->mfeEncodeSharedState->dsShare;
 
 
     MOS_ZeroMemory(encodeMfeContext->mfeEncodeSharedState, sizeof(MfeSharedState));
@@ -649,6 +681,13 @@ VAStatus DdiEncode_MfeSubmit(
     encodeMfeContext->mfeEncodeSharedState->resMbencKernel = resMbencKernel;
     encodeMfeContext->mfeEncodeSharedState->vmeSurface     = vmeSurface;
     encodeMfeContext->mfeEncodeSharedState->commonSurface  = commonSurface;
+    encodeMfeContext->mfeEncodeSharedState->dsShare        = dsShare;
+
+    // DS surfaces shared by the streams are only valid in this submission
+    if (dsShare)
+    {
+        dsShare->NewSubmission();
+    }
 
     // Call Enc functions for all the sub contexts
     MOS_STATUS status = MOS_STATUS_SUCCESS;
@@ -36,6 +36,12 @@
 
 #define DDI_ENCODE_MAX_STATUS_REPORT_BUFFER    CODECHAL_ENCODE_STATUS_NUM
 
+// Frames in flight between the application thread and the encode worker, bounded by the
+// Codechal recycled buffers which rotate once per executed frame
+#define DDI_ENCODE_MAX_FRAME_CONTEXTS          CODECHAL_ENCODE_RECYCLED_BUFFER_NUM
+// Buffer objects a frame context references until the worker executed it
+#define DDI_ENCODE_MAX_FRAME_BOS               8
+
 typedef enum _DDI_ENCODE_FEI_ENC_BUFFER_TYPE
 {
     FEI_ENC_BUFFER_TYPE_MVDATA     = 0,
@@ -172,6 +178,9 @@ typedef struct _DDI_ENCODE_CONTEXT
 
     uint8_t                           targetUsage;
 
+    //Created with DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH
+    bool                              bJpegBatch;
+
 } DDI_ENCODE_CONTEXT, *PDDI_ENCODE_CONTEXT;
 
 typedef struct _DDI_ENCODE_MFE_CONTEXT
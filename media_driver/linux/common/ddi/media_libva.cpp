@@ -43,6 +43,8 @@
 #include "media_libva_util.h"
 #include "media_libva_decoder.h"
 #include "media_libva_encoder.h"
+#include "media_ddi_encode_base.h"
+#include "codechal_encode_ds_share.h"
 #if !defined(ANDROID) && defined(X11_FOUND)
 #include "media_libva_putsurface_linux.h"
 #endif
@@ -53,6 +55,7 @@
 #include "mediamemdecomp.h"
 #include "mos_solo_generic.h"
 #include "media_libva_caps.h"
+#include "media_libva_capture.h"
 #include "media_interfaces_mmd.h"
 #include "mos_util_user_interface.h"
 #include "cplib_utils.h"
@@ -1461,6 +1464,8 @@ VAStatus DdiMedia__Initialize (
         }
     }
 
+    DdiMediaCapture_Install(ctx);
+
     DdiMediaUtil_UnLockMutex(&GlobalMutex);
 
     return VA_STATUS_SUCCESS;
@@ -1539,6 +1544,8 @@ static VAStatus DdiMedia_Terminate (
         return VA_STATUS_SUCCESS;
     }
 
+    DdiMediaCapture_Uninstall(ctx);
+
     mediaCtx->SkuTable.reset();
     mediaCtx->WaTable.reset();
     // destroy libdrm buffer manager
@@ -2260,6 +2267,9 @@ static VAStatus DdiMedia_CreateMfeContextInternal(
         return VA_STATUS_ERROR_ALLOCATION_FAILED;
     }
 
+    // DS surfaces of the raw surfaces encoded by several sub contexts are shared
+    mfeEncodeSharedState->dsShare = MOS_New(CodechalEncodeDsShare);
+
     encodeMfeContext->mfeEncodeSharedState = mfeEncodeSharedState;
 
     DdiMediaUtil_InitMutex(&encodeMfeContext->encodeMfeMutex);
@@ -2286,6 +2296,13 @@ static VAStatus DdiMedia_DestoryMfeContext (
     encodeMfeContext->mfeEncodeSharedState->encoders.clear();
     encodeMfeContext->mfeEncodeSharedState->encoders.shrink_to_fit();
 
+    // the encoders still using the shared DS surfaces delete them with the last of them
+    CodechalEncodeDsShare *dsShare = encodeMfeContext->mfeEncodeSharedState->dsShare;
+    if (dsShare && dsShare->RemoveUser(nullptr) == 0)
+    {
+        MOS_Delete(dsShare);
+    }
+
     DdiMediaUtil_DestroyMutex(&encodeMfeContext->encodeMfeMutex);
     MOS_FreeMemory(encodeMfeContext->mfeEncodeSharedState);
     MOS_FreeMemory(encodeMfeContext);
@@ -2331,6 +2348,12 @@ static VAStatus DdiMedia_AddContextInternal(
         return VA_STATUS_ERROR_UNSUPPORTED_PROFILE;
     }
 
+    // HEVC MFE is only supported by the kernel based encoder, not by HEVC FEI
+    if (encodeContext->vaProfile == VAProfileHEVCMain && encodeContext->vaEntrypoint != VAEntrypointEncSlice)
+    {
+        return VA_STATUS_ERROR_UNSUPPORTED_ENTRYPOINT;
+    }
+
     DdiMediaUtil_LockMutex(&encodeMfeContext->encodeMfeMutex);
     encodeMfeContext->pDdiEncodeContexts.push_back(encodeContext);
 
@@ -2347,6 +2370,12 @@ static VAStatus DdiMedia_AddContextInternal(
         return VA_STATUS_ERROR_INVALID_CONTEXT;
     }
 
+    // Frames already queued to the encode worker are executed as single stream
+    if (encodeContext->m_encode)
+    {
+        encodeContext->m_encode->WaitForFrames();
+    }
+
     encoder->m_mfeEnabled = true;
     // Assign one unique id to this sub context/stream
     encoder->m_mfeEncodeParams.streamId = encodeMfeContext->currentStreamId;
@@ -3016,6 +3045,16 @@ VAStatus DdiMedia_DestroyBuffer (
         default:
             return VA_STATUS_ERROR_INVALID_BUFFER;
     }
+
+    // Buffers created from the encode buffer pool keep their backing for reuse
+    if (encCtx && encCtx->m_encode && encCtx->m_encode->m_bufferPool &&
+        encCtx->m_encode->m_bufferPool->ReleaseBuffer(buf))
+    {
+        MOS_FreeMemory(buf);
+        DdiMedia_DestroyBufFromVABufferID(mediaCtx, buffer_id);
+        return VA_STATUS_SUCCESS;
+    }
+
     switch ((int32_t)buf->uiType)
     {
         case VASliceDataBufferType:
@@ -4264,7 +4303,7 @@ VAStatus DdiMedia_DeriveImage (
 
     mediaCtx->m_caps->PopulateColorMaskInfo(&vaimg->format);
 
-    DDI_MEDIA_BUFFER *buf               = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_BUFFER));
+    DDI_MEDIA_BUFFER *buf               = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroPooledMemory(sizeof(DDI_MEDIA_BUFFER));
     if (buf == nullptr)
     {
         MOS_FreeMemory(vaimg);
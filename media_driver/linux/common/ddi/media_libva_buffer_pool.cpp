@@ -0,0 +1,276 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_buffer_pool.cpp
+//! \brief    Per VA context recycling pool for VA buffers
+//!
+
+#include "media_libva_buffer_pool.h"
+#include "media_libva_util.h"
+
+DdiMediaBufferPool::DdiMediaBufferPool(uint32_t budget) :
+    m_budget(budget)
+{
+    MOS_ZeroMemory(m_entries, sizeof(m_entries));
+    DdiMediaUtil_InitMutex(&m_mutex);
+}
+
+DdiMediaBufferPool::~DdiMediaBufferPool()
+{
+    Flush();
+    DdiMediaUtil_DestroyMutex(&m_mutex);
+}
+
+uint32_t DdiMediaBufferPool::GetCapacity(DDI_MEDIA_FORMAT format, uint32_t size)
+{
+    uint32_t capacity = (format == Media_Format_CPU) ? DDI_MEDIA_BUFFER_POOL_MIN_CPU_SIZE : DDI_MEDIA_BUFFER_POOL_MIN_BO_SIZE;
+
+    // Doubling large buffers would waste up to half of the budget on them
+    if (size > DDI_MEDIA_BUFFER_POOL_MAX_POW2_SIZE)
+    {
+        return MOS_ALIGN_CEIL(size, DDI_MEDIA_BUFFER_POOL_LARGE_ALIGNMENT);
+    }
+
+    while (capacity < size)
+    {
+        capacity <<= 1;
+    }
+
+    return capacity;
+}
+
+void DdiMediaBufferPool::SetBufferSize(DDI_MEDIA_BUFFER *buf, uint32_t size)
+{
+    buf->iSize = size;
+    if (buf->pGmmResourceInfo)
+    {
+        buf->pGmmResourceInfo->OverrideSize(size);
+        buf->pGmmResourceInfo->OverrideBaseWidth(size);
+        buf->pGmmResourceInfo->OverridePitch(size);
+    }
+}
+
+void DdiMediaBufferPool::Remove(uint32_t idx)
+{
+    m_retainedSize -= m_entries[idx].uiPoolCapacity;
+    m_entryNum--;
+    for (uint32_t i = idx; i < m_entryNum; i++)
+    {
+        m_entries[i] = m_entries[i + 1];
+    }
+}
+
+void DdiMediaBufferPool::Evict(uint32_t idx)
+{
+    DdiMediaUtil_FreeBuffer(&m_entries[idx]);
+    Remove(idx);
+}
+
+bool DdiMediaBufferPool::Acquire(DDI_MEDIA_BUFFER *buf)
+{
+    bool     found    = false;
+    uint32_t capacity = GetCapacity(buf->format, buf->iSize);
+
+    DdiMediaUtil_LockMutex(&m_mutex);
+    // Newest first, it is the most likely to still be in the CPU caches
+    for (int32_t i = (int32_t)m_entryNum - 1; i >= 0; i--)
+    {
+        DDI_MEDIA_BUFFER *entry = &m_entries[i];
+        if (entry->uiType != buf->uiType || entry->format != buf->format)
+        {
+            continue;
+        }
+        if (buf->format == Media_Format_2DBuffer)
+        {
+            if (entry->uiWidth != buf->uiWidth || entry->uiHeight != buf->uiHeight)
+            {
+                continue;
+            }
+        }
+        else if (entry->uiPoolCapacity != capacity)
+        {
+            continue;
+        }
+        // The GPU may still read a buffer destroyed right after vaEndPicture,
+        // or a queued frame not submitted yet may read it later
+        if (entry->bo && (m_heldBos.count(entry->bo) || mos_bo_busy(entry->bo)))
+        {
+            continue;
+        }
+
+        buf->pData            = entry->pData;
+        buf->bo               = entry->bo;
+        buf->pGmmResourceInfo = entry->pGmmResourceInfo;
+        buf->TileType         = entry->TileType;
+        buf->uiPoolCapacity   = entry->uiPoolCapacity;
+        if (buf->format == Media_Format_2DBuffer)
+        {
+            buf->uiPitch = entry->uiPitch;
+            buf->iSize   = entry->iSize;
+        }
+
+        // Ownership moved to buf, drop the entry without freeing it
+        Remove(i);
+        found = true;
+        break;
+    }
+    DdiMediaUtil_UnLockMutex(&m_mutex);
+
+    if (found && buf->format == Media_Format_Buffer)
+    {
+        SetBufferSize(buf, buf->iSize);
+    }
+
+    return found;
+}
+
+VAStatus DdiMediaBufferPool::CreateBuffer(DDI_MEDIA_BUFFER *buf, MOS_BUFMGR *bufmgr, bool zero)
+{
+    DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_BUFFER);
+
+    if ((buf->format != Media_Format_CPU &&
+         buf->format != Media_Format_Buffer &&
+         buf->format != Media_Format_2DBuffer) ||
+        buf->iSize > m_budget)
+    {
+        return DdiMediaUtil_CreateBuffer(buf, bufmgr);
+    }
+
+    uint32_t size = buf->iSize;
+    VAStatus hr   = VA_STATUS_SUCCESS;
+
+    buf->bMapped         = false;
+    buf->uiLockedBufID   = VA_INVALID_ID;
+    buf->uiLockedImageID = VA_INVALID_ID;
+    buf->iRefCount       = 0;
+
+    if (Acquire(buf))
+    {
+        // BO contents are undefined for a buffer created without data, as they
+        // are for a new BO. CPU buffers stay zeroed as the applications expect.
+        if (zero && buf->format == Media_Format_CPU)
+        {
+            MOS_ZeroMemory(buf->pData, size);
+        }
+        return VA_STATUS_SUCCESS;
+    }
+
+    MOS_IncrementUltCounter(MOS_ULT_COUNTER_ENCODE_BUFFER_POOL_ALLOCS);
+
+    if (buf->format == Media_Format_CPU)
+    {
+        buf->uiPoolCapacity = GetCapacity(buf->format, size);
+        buf->pData          = zero ? (uint8_t *)MOS_AllocAndZeroPooledMemory(buf->uiPoolCapacity) :
+                                     (uint8_t *)MOS_AllocPooledMemory(buf->uiPoolCapacity);
+        if (nullptr == buf->pData)
+        {
+            buf->uiPoolCapacity = 0;
+            hr = VA_STATUS_ERROR_ALLOCATION_FAILED;
+        }
+    }
+    else if (buf->format == Media_Format_2DBuffer)
+    {
+        hr = DdiMediaUtil_CreateBuffer(buf, bufmgr);
+        buf->uiPoolCapacity = (hr == VA_STATUS_SUCCESS) ? buf->iSize : 0;
+    }
+    else
+    {
+        buf->iSize = GetCapacity(buf->format, size);
+        hr         = DdiMediaUtil_CreateBuffer(buf, bufmgr);
+        if (hr == VA_STATUS_SUCCESS)
+        {
+            buf->uiPoolCapacity = buf->iSize;
+            SetBufferSize(buf, size);
+        }
+    }
+
+    return hr;
+}
+
+bool DdiMediaBufferPool::ReleaseBuffer(DDI_MEDIA_BUFFER *buf)
+{
+    if (nullptr == buf || 0 == buf->uiPoolCapacity || buf->uiPoolCapacity > m_budget)
+    {
+        return false;
+    }
+
+    // Mapped, exported or surface backed buffers are freed the usual way
+    if (buf->bMapped || buf->iRefCount != 0 || buf->uiExportcount != 0 || buf->pSurface)
+    {
+        return false;
+    }
+
+    DdiMediaUtil_LockMutex(&m_mutex);
+    while (m_entryNum > 0 &&
+           (m_entryNum == DDI_MEDIA_BUFFER_POOL_MAX_ENTRIES || m_retainedSize + buf->uiPoolCapacity > m_budget))
+    {
+        Evict(0);
+    }
+
+    m_entries[m_entryNum++] = *buf;
+    m_retainedSize         += buf->uiPoolCapacity;
+    DdiMediaUtil_UnLockMutex(&m_mutex);
+
+    buf->pData            = nullptr;
+    buf->bo               = nullptr;
+    buf->pGmmResourceInfo = nullptr;
+
+    return true;
+}
+
+void DdiMediaBufferPool::Flush()
+{
+    DdiMediaUtil_LockMutex(&m_mutex);
+    while (m_entryNum > 0)
+    {
+        Evict(m_entryNum - 1);
+    }
+    DdiMediaUtil_UnLockMutex(&m_mutex);
+}
+
+void DdiMediaBufferPool::HoldBo(MOS_LINUX_BO *bo)
+{
+    if (nullptr == bo)
+    {
+        return;
+    }
+
+    DdiMediaUtil_LockMutex(&m_mutex);
+    m_heldBos[bo]++;
+    DdiMediaUtil_UnLockMutex(&m_mutex);
+}
+
+void DdiMediaBufferPool::UnholdBo(MOS_LINUX_BO *bo)
+{
+    if (nullptr == bo)
+    {
+        return;
+    }
+
+    DdiMediaUtil_LockMutex(&m_mutex);
+    auto held = m_heldBos.find(bo);
+    if (held != m_heldBos.end() && --held->second == 0)
+    {
+        m_heldBos.erase(held);
+    }
+    DdiMediaUtil_UnLockMutex(&m_mutex);
+}
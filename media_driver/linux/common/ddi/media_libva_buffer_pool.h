@@ -0,0 +1,135 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_buffer_pool.h
+//! \brief    Per VA context recycling pool for VA buffers
+//! \details  Destroyed buffers keep their CPU backing, or their BO and GMM
+//!           resource info, in the pool of the VA context they were created
+//!           for. A later vaCreateBuffer of the same buffer type, format and
+//!           size class takes them back instead of going to the kernel and GMM.
+//!
+
+#ifndef __MEDIA_LIBVA_BUFFER_POOL_H__
+#define __MEDIA_LIBVA_BUFFER_POOL_H__
+
+#include <map>
+#include "media_libva_common.h"
+
+#define DDI_MEDIA_BUFFER_POOL_MAX_ENTRIES       64          //!< Max buffers retained by one pool
+#define DDI_MEDIA_BUFFER_POOL_MIN_CPU_SIZE      64          //!< Smallest size class of CPU buffers
+#define DDI_MEDIA_BUFFER_POOL_MIN_BO_SIZE       4096        //!< Smallest size class of 1D BO buffers
+#define DDI_MEDIA_BUFFER_POOL_MAX_POW2_SIZE     0x100000    //!< Largest power of two size class
+#define DDI_MEDIA_BUFFER_POOL_LARGE_ALIGNMENT   0x10000     //!< Size class alignment above DDI_MEDIA_BUFFER_POOL_MAX_POW2_SIZE
+
+//!
+//! \class  DdiMediaBufferPool
+//! \brief  Bounded pool of retained VA buffer backings
+//!
+class DdiMediaBufferPool
+{
+public:
+    //!
+    //! \brief    Constructor
+    //! \param    [in] budget
+    //!           Max number of bytes retained by the pool
+    //!
+    DdiMediaBufferPool(uint32_t budget);
+
+    //!
+    //! \brief    Destructor, releases every retained buffer
+    //!
+    ~DdiMediaBufferPool();
+
+    //!
+    //! \brief    Create the backing of a VA buffer
+    //! \details  buf->uiType, format and iSize (uiWidth and uiHeight for 2D
+    //!           buffers) must be set by the caller. A retained backing of the
+    //!           same type, format and size class is reused if one is idle,
+    //!           otherwise a new one of the size class is allocated.
+    //! \param    [in,out] buf
+    //!           Pointer to DDI_MEDIA_BUFFER
+    //! \param    [in] bufmgr
+    //!           Mos buffer manager
+    //! \param    [in] zero
+    //!           Zero the CPU backing. Callers copying the whole buffer from
+    //!           application data pass false.
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus CreateBuffer(DDI_MEDIA_BUFFER *buf, MOS_BUFMGR *bufmgr, bool zero);
+
+    //!
+    //! \brief    Retain the backing of a destroyed VA buffer
+    //! \details  Oldest retained buffers are released to keep the pool in budget.
+    //! \param    [in] buf
+    //!           Pointer to DDI_MEDIA_BUFFER created by CreateBuffer
+    //! \return   bool
+    //!           true if the backing is retained, false if the caller has to free it
+    //!
+    bool ReleaseBuffer(DDI_MEDIA_BUFFER *buf);
+
+    //!
+    //! \brief    Release every retained buffer
+    //!
+    void Flush();
+
+    //!
+    //! \brief    Mark a bo as used by a frame not submitted yet
+    //! \details  A destroyed buffer whose bo is held is retained but not handed
+    //!           out again until every hold is dropped by UnholdBo. mos_bo_busy
+    //!           cannot tell, the frame is not executed yet.
+    //! \param    [in] bo
+    //!           Buffer object
+    //!
+    void HoldBo(MOS_LINUX_BO *bo);
+
+    //!
+    //! \brief    Drop a hold taken by HoldBo
+    //! \param    [in] bo
+    //!           Buffer object
+    //!
+    void UnholdBo(MOS_LINUX_BO *bo);
+
+private:
+    static uint32_t GetCapacity(DDI_MEDIA_FORMAT format, uint32_t size);
+
+    //! \brief  Set size of a 1D buffer taken from a larger size class
+    static void SetBufferSize(DDI_MEDIA_BUFFER *buf, uint32_t size);
+
+    //! \brief  Take a retained backing matching buf, return false on miss
+    bool Acquire(DDI_MEDIA_BUFFER *buf);
+
+    //! \brief  Drop retained entry idx without freeing it. Pool lock must be held.
+    void Remove(uint32_t idx);
+
+    //! \brief  Free retained entry idx. Pool lock must be held.
+    void Evict(uint32_t idx);
+
+    DDI_MEDIA_BUFFER    m_entries[DDI_MEDIA_BUFFER_POOL_MAX_ENTRIES];   //!< Retained buffers, oldest first
+    uint32_t            m_entryNum      = 0;                            //!< Number of retained buffers
+    uint32_t            m_retainedSize  = 0;                            //!< Bytes retained
+    uint32_t            m_budget        = 0;                            //!< Max bytes retained
+    std::map<MOS_LINUX_BO *, uint32_t> m_heldBos;                      //!< Holds per bo of the frames not submitted yet
+    MEDIA_MUTEX_T       m_mutex;                                        //!< Protects the entries and the holds
+};
+
+#endif // __MEDIA_LIBVA_BUFFER_POOL_H__
@@ -2980,9 +2980,10 @@ bool MediaLibvaCaps::IsMfeSupportedEntrypoint(VAEntrypoint entrypoint)
 
 bool MediaLibvaCaps::IsMfeSupportedProfile(VAProfile profile)
 {
-    if (profile != VAProfileH264Main &&                  // MFE only support AVC now
+    if (profile != VAProfileH264Main &&                  // MFE only support AVC and HEVC now
         profile != VAProfileH264High &&
-        profile != VAProfileH264ConstrainedBaseline)
+        profile != VAProfileH264ConstrainedBaseline &&
+        profile != VAProfileHEVCMain)
     {
         return false;
     }
@@ -0,0 +1,585 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_capture.cpp
+//! \brief    Capture of the VA calls made to the driver, for replay
+//!
+
+#include <stdio.h>
+#include <time.h>
+#include <map>
+#include "media_libva_capture.h"
+#include "media_libva_util.h"
+
+#define DDI_CAPTURE_ARRAY_SIZE(arr)     ((uint32_t)(sizeof(arr) / sizeof((arr)[0])))
+
+//!
+//! \brief  One piece of variable length record data
+//!
+struct DdiCaptureChunk
+{
+    const void  *data;
+    uint32_t    size;
+};
+
+//!
+//! \brief  Buffer mapped by the application, copied to the capture on unmap
+//!
+struct DdiCaptureMapping
+{
+    const void  *data;
+    uint32_t    size;
+};
+
+static MEDIA_MUTEX_T                                g_captureMutex      = MEDIA_MUTEX_INITIALIZER;
+static FILE                                         *g_captureFile      = nullptr;
+static uint8_t                                      *g_captureBuffer    = nullptr;
+static uint32_t                                     g_captureBufferUsed = 0;
+static VADriverContextP                             g_captureCtx        = nullptr;  //!< Captured display
+static uint32_t                                     g_captureThreadNum  = 0;
+static VADriverVTable                               g_captureDdiVTable  = {};   //!< DdiMedia_* entry points the wrappers call
+static std::map<VABufferID, DdiCaptureMapping>      g_captureMappings;
+
+static thread_local uint32_t                        t_captureThread     = 0;    //!< Capture thread index + 1, 0 until the first call
+
+static inline uint64_t DdiMediaCapture_GetTimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+//!
+//! \brief    Size in bytes of an array to capture
+//! \return   uint32_t
+//!           num * elementSize, 0 if it doesn't fit a record so that the data is dropped
+//!
+static inline uint32_t DdiMediaCapture_ArraySize(uint32_t num, uint32_t elementSize)
+{
+    uint64_t size = (uint64_t)num * elementSize;
+    if (size > DDI_CAPTURE_MAX_DATA_SIZE)
+    {
+        DDI_ASSERTMESSAGE("VA capture drops %u elements of %u bytes", num, elementSize);
+        return 0;
+    }
+    return (uint32_t)size;
+}
+
+//! \brief  Write the buffered records to the file. Capture lock must be held.
+static void DdiMediaCapture_Flush()
+{
+    if (g_captureFile && g_captureBufferUsed)
+    {
+        fwrite(g_captureBuffer, 1, g_captureBufferUsed, g_captureFile);
+    }
+    g_captureBufferUsed = 0;
+}
+
+//! \brief  Append data to the capture. Capture lock must be held.
+static void DdiMediaCapture_Append(const void *data, uint32_t size)
+{
+    if (g_captureBufferUsed + size > DDI_CAPTURE_BUFFER_SIZE)
+    {
+        DdiMediaCapture_Flush();
+    }
+
+    if (size > DDI_CAPTURE_BUFFER_SIZE)
+    {
+        // Large bitstreams go straight to the file
+        fwrite(data, 1, size, g_captureFile);
+        return;
+    }
+
+    MOS_SecureMemcpy(g_captureBuffer + g_captureBufferUsed, size, data, size);
+    g_captureBufferUsed += size;
+}
+
+//!
+//! \brief    Append one record to the capture
+//! \param    [in] entry
+//!           Captured entry point
+//! \param    [in] status
+//!           Status returned by the entry point
+//! \param    [in] startNs
+//!           Time the entry point was called
+//! \param    [in] args
+//!           Fixed 32 bit arguments
+//! \param    [in] argNum
+//!           Number of fixed arguments
+//! \param    [in] chunks
+//!           Variable length arguments, nullptr data entries are written as zeros
+//! \param    [in] chunkNum
+//!           Number of variable length arguments
+//!
+static void DdiMediaCapture_Record(
+    DDI_CAPTURE_ENTRY       entry,
+    VAStatus                status,
+    uint64_t                startNs,
+    const uint32_t          *args,
+    uint32_t                argNum,
+    const DdiCaptureChunk   *chunks,
+    uint32_t                chunkNum)
+{
+    DDI_CAPTURE_RECORD record = {};
+    uint64_t           endNs  = DdiMediaCapture_GetTimeNs();
+
+    record.entry      = (uint16_t)entry;
+    record.status     = (int32_t)status;
+    record.startNs    = startNs;
+    record.durationNs = endNs - startNs;
+    record.argSize    = argNum * sizeof(uint32_t);
+    for (uint32_t i = 0; i < chunkNum; i++)
+    {
+        // Chunks are bounded by DDI_CAPTURE_MAX_DATA_SIZE, so the sum can't wrap
+        record.argSize += chunks[i].data ? chunks[i].size : 0;
+    }
+
+    DdiMediaUtil_LockGuard guard(&g_captureMutex);
+    if (g_captureFile == nullptr)
+    {
+        return;
+    }
+
+    if (t_captureThread == 0)
+    {
+        t_captureThread = ++g_captureThreadNum;
+    }
+    record.thread = t_captureThread - 1;
+
+    DdiMediaCapture_Append(&record, sizeof(record));
+    DdiMediaCapture_Append(args, argNum * sizeof(uint32_t));
+    for (uint32_t i = 0; i < chunkNum; i++)
+    {
+        if (chunks[i].data && chunks[i].size)
+        {
+            DdiMediaCapture_Append(chunks[i].data, chunks[i].size);
+        }
+    }
+}
+
+static VAStatus DdiMediaCapture_CreateConfig(
+    VADriverContextP    ctx,
+    VAProfile           profile,
+    VAEntrypoint        entrypoint,
+    VAConfigAttrib      *attribList,
+    int32_t             numAttribs,
+    VAConfigID          *configId)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaCreateConfig(ctx, profile, entrypoint, attribList, numAttribs, configId);
+
+    uint32_t args[]         = { (uint32_t)profile, (uint32_t)entrypoint, (uint32_t)numAttribs,
+                                configId ? *configId : VA_INVALID_ID };
+    DdiCaptureChunk chunks[] = { { attribList, DdiMediaCapture_ArraySize(numAttribs, sizeof(VAConfigAttrib)) } };
+    DdiMediaCapture_Record(DDI_CAPTURE_CREATE_CONFIG, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), chunks, DDI_CAPTURE_ARRAY_SIZE(chunks));
+    return status;
+}
+
+static VAStatus DdiMediaCapture_DestroyConfig(
+    VADriverContextP    ctx,
+    VAConfigID          configId)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaDestroyConfig(ctx, configId);
+
+    uint32_t args[] = { configId };
+    DdiMediaCapture_Record(DDI_CAPTURE_DESTROY_CONFIG, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+static VAStatus DdiMediaCapture_CreateSurfaces2(
+    VADriverContextP    ctx,
+    uint32_t            format,
+    uint32_t            width,
+    uint32_t            height,
+    VASurfaceID         *surfaces,
+    uint32_t            numSurfaces,
+    VASurfaceAttrib     *attribList,
+    uint32_t            numAttribs)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaCreateSurfaces2(ctx, format, width, height, surfaces, numSurfaces, attribList, numAttribs);
+
+    uint32_t args[]          = { format, width, height, numSurfaces, numAttribs };
+    DdiCaptureChunk chunks[] = { { surfaces,   DdiMediaCapture_ArraySize(numSurfaces, sizeof(VASurfaceID)) },
+                                 { attribList, DdiMediaCapture_ArraySize(numAttribs, sizeof(VASurfaceAttrib)) } };
+    DdiMediaCapture_Record(DDI_CAPTURE_CREATE_SURFACES2, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), chunks, DDI_CAPTURE_ARRAY_SIZE(chunks));
+    return status;
+}
+
+static VAStatus DdiMediaCapture_DestroySurfaces(
+    VADriverContextP    ctx,
+    VASurfaceID         *surfaces,
+    int32_t             numSurfaces)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaDestroySurfaces(ctx, surfaces, numSurfaces);
+
+    uint32_t args[]          = { (uint32_t)numSurfaces };
+    DdiCaptureChunk chunks[] = { { surfaces, DdiMediaCapture_ArraySize(numSurfaces, sizeof(VASurfaceID)) } };
+    DdiMediaCapture_Record(DDI_CAPTURE_DESTROY_SURFACES, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), chunks, DDI_CAPTURE_ARRAY_SIZE(chunks));
+    return status;
+}
+
+static VAStatus DdiMediaCapture_CreateContext(
+    VADriverContextP    ctx,
+    VAConfigID          configId,
+    int32_t             width,
+    int32_t             height,
+    int32_t             flag,
+    VASurfaceID         *renderTargets,
+    int32_t             numRenderTargets,
+    VAContextID         *context)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaCreateContext(ctx, configId, width, height, flag, renderTargets, numRenderTargets, context);
+
+    uint32_t args[]          = { configId, (uint32_t)width, (uint32_t)height, (uint32_t)flag, (uint32_t)numRenderTargets,
+                                 context ? *context : VA_INVALID_ID };
+    DdiCaptureChunk chunks[] = { { renderTargets, DdiMediaCapture_ArraySize(numRenderTargets, sizeof(VASurfaceID)) } };
+    DdiMediaCapture_Record(DDI_CAPTURE_CREATE_CONTEXT, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), chunks, DDI_CAPTURE_ARRAY_SIZE(chunks));
+    return status;
+}
+
+static VAStatus DdiMediaCapture_DestroyContext(
+    VADriverContextP    ctx,
+    VAContextID         context)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaDestroyContext(ctx, context);
+
+    uint32_t args[] = { context };
+    DdiMediaCapture_Record(DDI_CAPTURE_DESTROY_CONTEXT, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+static VAStatus DdiMediaCapture_CreateBuffer(
+    VADriverContextP    ctx,
+    VAContextID         context,
+    VABufferType        type,
+    uint32_t            size,
+    uint32_t            numElements,
+    void                *data,
+    VABufferID          *bufId)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaCreateBuffer(ctx, context, type, size, numElements, data, bufId);
+
+    uint32_t dataSize        = data ? DdiMediaCapture_ArraySize(numElements, size) : 0;
+    uint32_t args[]          = { context, (uint32_t)type, size, numElements, bufId ? *bufId : VA_INVALID_ID, dataSize };
+    DdiCaptureChunk chunks[] = { { data, dataSize } };
+    DdiMediaCapture_Record(DDI_CAPTURE_CREATE_BUFFER, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), chunks, DDI_CAPTURE_ARRAY_SIZE(chunks));
+    return status;
+}
+
+static VAStatus DdiMediaCapture_MapBuffer(
+    VADriverContextP    ctx,
+    VABufferID          bufId,
+    void                **pbuf)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaMapBuffer(ctx, bufId, pbuf);
+
+    uint32_t args[] = { bufId };
+    DdiMediaCapture_Record(DDI_CAPTURE_MAP_BUFFER, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+
+    // Remember the mapping to capture what the application writes through it.
+    // Coded buffers are only read by the application.
+    VABufferType type        = VABufferTypeMax;
+    uint32_t     size        = 0;
+    uint32_t     numElements = 0;
+    if (status == VA_STATUS_SUCCESS && pbuf && *pbuf &&
+        g_captureDdiVTable.vaBufferInfo(ctx, bufId, &type, &size, &numElements) == VA_STATUS_SUCCESS &&
+        type != VAEncCodedBufferType)
+    {
+        DdiMediaUtil_LockGuard guard(&g_captureMutex);
+        g_captureMappings[bufId] = { *pbuf, DdiMediaCapture_ArraySize(numElements, size) };
+    }
+
+    return status;
+}
+
+static VAStatus DdiMediaCapture_UnmapBuffer(
+    VADriverContextP    ctx,
+    VABufferID          bufId)
+{
+    DdiCaptureMapping mapping = {};
+    {
+        DdiMediaUtil_LockGuard guard(&g_captureMutex);
+        auto it = g_captureMappings.find(bufId);
+        if (it != g_captureMappings.end())
+        {
+            mapping = it->second;
+            g_captureMappings.erase(it);
+        }
+    }
+
+    // Snapshot before unmapping, the mapping is gone afterwards
+    uint32_t args[]          = { bufId, mapping.data ? mapping.size : 0 };
+    DdiCaptureChunk chunks[] = { { mapping.data, mapping.size } };
+
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    DdiMediaCapture_Record(DDI_CAPTURE_UNMAP_BUFFER, VA_STATUS_SUCCESS, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), chunks, DDI_CAPTURE_ARRAY_SIZE(chunks));
+
+    return g_captureDdiVTable.vaUnmapBuffer(ctx, bufId);
+}
+
+static VAStatus DdiMediaCapture_DestroyBuffer(
+    VADriverContextP    ctx,
+    VABufferID          bufId)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaDestroyBuffer(ctx, bufId);
+
+    uint32_t args[] = { bufId };
+    DdiMediaCapture_Record(DDI_CAPTURE_DESTROY_BUFFER, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+static VAStatus DdiMediaCapture_BeginPicture(
+    VADriverContextP    ctx,
+    VAContextID         context,
+    VASurfaceID         renderTarget)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaBeginPicture(ctx, context, renderTarget);
+
+    uint32_t args[] = { context, renderTarget };
+    DdiMediaCapture_Record(DDI_CAPTURE_BEGIN_PICTURE, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+static VAStatus DdiMediaCapture_RenderPicture(
+    VADriverContextP    ctx,
+    VAContextID         context,
+    VABufferID          *buffers,
+    int32_t             numBuffers)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaRenderPicture(ctx, context, buffers, numBuffers);
+
+    uint32_t args[]          = { context, (uint32_t)numBuffers };
+    DdiCaptureChunk chunks[] = { { buffers, DdiMediaCapture_ArraySize(numBuffers, sizeof(VABufferID)) } };
+    DdiMediaCapture_Record(DDI_CAPTURE_RENDER_PICTURE, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), chunks, DDI_CAPTURE_ARRAY_SIZE(chunks));
+    return status;
+}
+
+static VAStatus DdiMediaCapture_EndPicture(
+    VADriverContextP    ctx,
+    VAContextID         context)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaEndPicture(ctx, context);
+
+    uint32_t args[] = { context };
+    DdiMediaCapture_Record(DDI_CAPTURE_END_PICTURE, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+static VAStatus DdiMediaCapture_SyncSurface(
+    VADriverContextP    ctx,
+    VASurfaceID         renderTarget)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaSyncSurface(ctx, renderTarget);
+
+    uint32_t args[] = { renderTarget };
+    DdiMediaCapture_Record(DDI_CAPTURE_SYNC_SURFACE, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+static VAStatus DdiMediaCapture_QuerySurfaceStatus(
+    VADriverContextP    ctx,
+    VASurfaceID         renderTarget,
+    VASurfaceStatus     *surfaceStatus)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaQuerySurfaceStatus(ctx, renderTarget, surfaceStatus);
+
+    uint32_t args[] = { renderTarget };
+    DdiMediaCapture_Record(DDI_CAPTURE_QUERY_SURFACE_STATUS, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+static VAStatus DdiMediaCapture_CreateImage(
+    VADriverContextP    ctx,
+    VAImageFormat       *format,
+    int32_t             width,
+    int32_t             height,
+    VAImage             *image)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaCreateImage(ctx, format, width, height, image);
+
+    bool     created         = (status == VA_STATUS_SUCCESS && image);
+    uint32_t args[]          = { (uint32_t)width, (uint32_t)height,
+                                 created ? image->image_id : VA_INVALID_ID, created ? image->buf : VA_INVALID_ID };
+    DdiCaptureChunk chunks[] = { { format, sizeof(VAImageFormat) } };
+    DdiMediaCapture_Record(DDI_CAPTURE_CREATE_IMAGE, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), chunks, DDI_CAPTURE_ARRAY_SIZE(chunks));
+    return status;
+}
+
+static VAStatus DdiMediaCapture_DeriveImage(
+    VADriverContextP    ctx,
+    VASurfaceID         surface,
+    VAImage             *image)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaDeriveImage(ctx, surface, image);
+
+    bool     created = (status == VA_STATUS_SUCCESS && image);
+    uint32_t args[]  = { surface, created ? image->image_id : VA_INVALID_ID, created ? image->buf : VA_INVALID_ID };
+    DdiMediaCapture_Record(DDI_CAPTURE_DERIVE_IMAGE, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+static VAStatus DdiMediaCapture_DestroyImage(
+    VADriverContextP    ctx,
+    VAImageID           image)
+{
+    uint64_t startNs = DdiMediaCapture_GetTimeNs();
+    VAStatus status  = g_captureDdiVTable.vaDestroyImage(ctx, image);
+
+    uint32_t args[] = { image };
+    DdiMediaCapture_Record(DDI_CAPTURE_DESTROY_IMAGE, status, startNs, args, DDI_CAPTURE_ARRAY_SIZE(args), nullptr, 0);
+    return status;
+}
+
+//! \brief  Open the capture file. Capture lock must be held.
+static bool DdiMediaCapture_Open()
+{
+    char                        fileName[MOS_MAX_PATH_LENGTH + 1] = {};
+    MOS_USER_FEATURE_VALUE_DATA userFeatureData;
+    DDI_CAPTURE_FILE_HEADER     header;
+
+    MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+    userFeatureData.StringData.pStringData = fileName;
+    if (MOS_UserFeature_ReadValue_ID(
+            nullptr,
+            __MEDIA_USER_FEATURE_VALUE_VA_CAPTURE_FILE_ID,
+            &userFeatureData) != MOS_STATUS_SUCCESS ||
+        userFeatureData.StringData.uSize == 0)
+    {
+        return false;
+    }
+
+    if (fileName[0] == '\0')
+    {
+        return false;
+    }
+
+    g_captureFile = fopen(fileName, "wb");
+    if (g_captureFile == nullptr)
+    {
+        DDI_ASSERTMESSAGE("Failed to open VA capture file %s", fileName);
+        return false;
+    }
+
+    g_captureBuffer = (uint8_t *)MOS_AllocMemory(DDI_CAPTURE_BUFFER_SIZE);
+    if (g_captureBuffer == nullptr)
+    {
+        fclose(g_captureFile);
+        g_captureFile = nullptr;
+        return false;
+    }
+    g_captureBufferUsed = 0;
+    g_captureThreadNum  = 0;
+
+    header.magic   = DDI_CAPTURE_MAGIC;
+    header.version = DDI_CAPTURE_VERSION;
+    DdiMediaCapture_Append(&header, sizeof(header));
+
+    DDI_NORMALMESSAGE("Capturing VA calls to %s", fileName);
+    return true;
+}
+
+//! \brief  Flush and close the capture file. Capture lock must be held.
+static void DdiMediaCapture_Close()
+{
+    DdiMediaCapture_Flush();
+    fclose(g_captureFile);
+    g_captureFile = nullptr;
+
+    MOS_FreeMemAndSetNull(g_captureBuffer);
+    g_captureMappings.clear();
+}
+
+void DdiMediaCapture_Install(VADriverContextP ctx)
+{
+    if (ctx == nullptr || ctx->vtable == nullptr)
+    {
+        return;
+    }
+
+    DdiMediaUtil_LockGuard guard(&g_captureMutex);
+    if (g_captureCtx)
+    {
+        // Records don't carry the display, so a second one would be replayed as the first
+        DDI_NORMALMESSAGE("VA calls of another display are already captured");
+        return;
+    }
+    if (!DdiMediaCapture_Open())
+    {
+        return;
+    }
+    g_captureCtx = ctx;
+
+    VADriverVTable *vtable = ctx->vtable;
+    g_captureDdiVTable     = *vtable;
+
+    vtable->vaCreateConfig       = DdiMediaCapture_CreateConfig;
+    vtable->vaDestroyConfig      = DdiMediaCapture_DestroyConfig;
+    vtable->vaCreateSurfaces2    = DdiMediaCapture_CreateSurfaces2;
+    vtable->vaDestroySurfaces    = DdiMediaCapture_DestroySurfaces;
+    vtable->vaCreateContext      = DdiMediaCapture_CreateContext;
+    vtable->vaDestroyContext     = DdiMediaCapture_DestroyContext;
+    vtable->vaCreateBuffer       = DdiMediaCapture_CreateBuffer;
+    vtable->vaMapBuffer          = DdiMediaCapture_MapBuffer;
+    vtable->vaUnmapBuffer        = DdiMediaCapture_UnmapBuffer;
+    vtable->vaDestroyBuffer      = DdiMediaCapture_DestroyBuffer;
+    vtable->vaBeginPicture       = DdiMediaCapture_BeginPicture;
+    vtable->vaRenderPicture      = DdiMediaCapture_RenderPicture;
+    vtable->vaEndPicture         = DdiMediaCapture_EndPicture;
+    vtable->vaSyncSurface        = DdiMediaCapture_SyncSurface;
+    vtable->vaQuerySurfaceStatus = DdiMediaCapture_QuerySurfaceStatus;
+    vtable->vaCreateImage        = DdiMediaCapture_CreateImage;
+    vtable->vaDeriveImage        = DdiMediaCapture_DeriveImage;
+    vtable->vaDestroyImage       = DdiMediaCapture_DestroyImage;
+}
+
+void DdiMediaCapture_Uninstall(VADriverContextP ctx)
+{
+    if (ctx == nullptr || ctx->vtable == nullptr)
+    {
+        return;
+    }
+
+    DdiMediaUtil_LockGuard guard(&g_captureMutex);
+    if (ctx != g_captureCtx)
+    {
+        return;
+    }
+
+    *ctx->vtable = g_captureDdiVTable;
+    g_captureCtx = nullptr;
+    DdiMediaCapture_Close();
+}
@@ -0,0 +1,61 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_capture.h
+//! \brief    Capture of the VA calls made to the driver, for replay
+//! \details  When the "VA Capture File" user feature names a file, the VA
+//!           entry points of the first display initialized are wrapped; the
+//!           displays initialized while it is captured are not. Each wrapper calls the
+//!           DdiMedia_* entry point, then appends its arguments, parameter data,
+//!           status and timing to a buffered capture in the format of
+//!           media_libva_capture_format.h. Nothing is wrapped when the capture
+//!           is off, so the entry points cost nothing extra.
+//!
+
+#ifndef __MEDIA_LIBVA_CAPTURE_H__
+#define __MEDIA_LIBVA_CAPTURE_H__
+
+#include "media_libva_common.h"
+#include "media_libva_capture_format.h"
+
+#define DDI_CAPTURE_BUFFER_SIZE     (1024 * 1024)   //!< Records are written to the file by chunks of this size
+#define DDI_CAPTURE_MAX_DATA_SIZE   (256 * 1024 * 1024) //!< Larger arrays are dropped from the records
+
+//!
+//! \brief    Wrap the VA entry points of a display if the capture is enabled
+//! \details  Called once the media context of ctx is created. Only one display
+//!           is captured at a time, the capture file is opened when it is wrapped.
+//! \param    [in] ctx
+//!           Pointer to VA driver context
+//!
+void DdiMediaCapture_Install(VADriverContextP ctx);
+
+//!
+//! \brief    Stop capturing a display
+//! \details  Called when the media context of ctx is destroyed. The capture
+//!           file is flushed and closed if ctx is the captured display.
+//! \param    [in] ctx
+//!           Pointer to VA driver context
+//!
+void DdiMediaCapture_Uninstall(VADriverContextP ctx);
+
+#endif // __MEDIA_LIBVA_CAPTURE_H__
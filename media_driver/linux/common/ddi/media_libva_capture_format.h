@@ -0,0 +1,92 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_capture_format.h
+//! \brief    Binary format of VA call captures
+//! \details  A capture is a DDI_CAPTURE_FILE_HEADER followed by one record per
+//!           captured VA call, in the order the calls returned. Each record is
+//!           a DDI_CAPTURE_RECORD followed by argSize bytes of arguments. The
+//!           arguments are 32 bit words, in the order listed for each entry,
+//!           followed by the variable length arrays and data of the call.
+//!           Object IDs are the ones returned during capture; a replayer maps
+//!           them to the IDs returned during replay.
+//!           Shared by the driver and the replay tool, keep it free of driver types.
+//!
+
+#ifndef __MEDIA_LIBVA_CAPTURE_FORMAT_H__
+#define __MEDIA_LIBVA_CAPTURE_FORMAT_H__
+
+#include <stdint.h>
+
+#define DDI_CAPTURE_MAGIC       0x50414356      //!< "VCAP"
+#define DDI_CAPTURE_VERSION     2
+
+//!
+//! \brief  Captured VA entry points and their arguments
+//!
+typedef enum _DDI_CAPTURE_ENTRY
+{
+    DDI_CAPTURE_CREATE_CONFIG = 0,      //!< profile, entrypoint, numAttribs, config, VAConfigAttrib[numAttribs]
+    DDI_CAPTURE_DESTROY_CONFIG,         //!< config
+    DDI_CAPTURE_CREATE_SURFACES2,       //!< format, width, height, numSurfaces, numAttribs, VASurfaceID[numSurfaces], VASurfaceAttrib[numAttribs]
+    DDI_CAPTURE_DESTROY_SURFACES,       //!< numSurfaces, VASurfaceID[numSurfaces]
+    DDI_CAPTURE_CREATE_CONTEXT,         //!< config, width, height, flag, numRenderTargets, context, VASurfaceID[numRenderTargets]
+    DDI_CAPTURE_DESTROY_CONTEXT,        //!< context
+    DDI_CAPTURE_CREATE_BUFFER,          //!< context, type, size, numElements, buffer, dataSize, data[dataSize]
+    DDI_CAPTURE_MAP_BUFFER,             //!< buffer
+    DDI_CAPTURE_UNMAP_BUFFER,           //!< buffer, dataSize, data[dataSize], contents written through the mapping
+    DDI_CAPTURE_DESTROY_BUFFER,         //!< buffer
+    DDI_CAPTURE_BEGIN_PICTURE,          //!< context, renderTarget
+    DDI_CAPTURE_RENDER_PICTURE,         //!< context, numBuffers, VABufferID[numBuffers]
+    DDI_CAPTURE_END_PICTURE,            //!< context
+    DDI_CAPTURE_SYNC_SURFACE,           //!< renderTarget
+    DDI_CAPTURE_QUERY_SURFACE_STATUS,   //!< renderTarget
+    DDI_CAPTURE_CREATE_IMAGE,           //!< width, height, image, buffer, VAImageFormat
+    DDI_CAPTURE_DERIVE_IMAGE,           //!< surface, image, buffer
+    DDI_CAPTURE_DESTROY_IMAGE,          //!< image
+    DDI_CAPTURE_ENTRY_NUM
+} DDI_CAPTURE_ENTRY;
+
+//!
+//! \brief  Capture file header
+//!
+typedef struct _DDI_CAPTURE_FILE_HEADER
+{
+    uint32_t    magic;                  //!< DDI_CAPTURE_MAGIC
+    uint32_t    version;                //!< DDI_CAPTURE_VERSION
+} DDI_CAPTURE_FILE_HEADER;
+
+//!
+//! \brief  Header of one captured call
+//!
+typedef struct _DDI_CAPTURE_RECORD
+{
+    uint16_t    entry;                  //!< DDI_CAPTURE_ENTRY
+    uint16_t    reserved;
+    uint32_t    thread;                 //!< Capture thread index, in order of first call
+    int32_t     status;                 //!< VAStatus returned by the call
+    uint32_t    argSize;                //!< Bytes of arguments following the record
+    uint64_t    startNs;                //!< Call start, monotonic clock
+    uint64_t    durationNs;             //!< CPU wall time spent in the driver
+} DDI_CAPTURE_RECORD;
+
+#endif // __MEDIA_LIBVA_CAPTURE_FORMAT_H__
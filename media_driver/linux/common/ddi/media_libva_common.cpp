@@ -170,6 +170,7 @@ void DdiMedia_MediaSurfaceToMosResource(DDI_MEDIA_SURFACE *mediaSurface, MOS_RES
     mosResource->ppReferenceFrameSemaphore = &mediaSurface->pReferenceFrameSemaphore;
     mosResource->bSemInitialized           = false;
     mosResource->bMapped                   = false;
+    mosResource->bPersistentMapped         = false;
 
     if(mediaSurface->bMapped == true)
     {
@@ -230,6 +231,7 @@ void DdiMedia_MediaBufferToMosResource(DDI_MEDIA_BUFFER *mediaBuffer, MOS_RESOUR
     mosResource->bo        = mediaBuffer->bo;
     mosResource->name      = mediaBuffer->name;
     mosResource->bMapped   = false;
+    mosResource->bPersistentMapped = false;
 
     if(mediaBuffer->bMapped == true)
     {
@@ -107,6 +107,13 @@ static int32_t atrace_switch            = 0;
 
 #define DDI_MEDIA_INVALID_VACONTEXTID              0
 
+// Driver specific vaCreateContext flag, next to VA_PROGRESSIVE. JPEG pictures of
+// the context may carry several images, each picture parameter buffer after the
+// first one starts another image. The images of a picture share one command buffer.
+// Applications pass the value directly, it is documented with its limits in
+// docs/media_features.md and must not change.
+#define DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH          0x00010000
+
 #define DDI_MEDIA_MAX_COLOR_PLANES                 4       //Maximum color planes supported by media driver, like (A/R/G/B in different planes)
 
 typedef pthread_mutex_t  MEDIA_MUTEX_T, *PMEDIA_MUTEX_T;
@@ -317,6 +324,7 @@ typedef struct _DDI_MEDIA_BUFFER
     uint32_t               uiMemtype;
     uint32_t               uiExportcount;
     uintptr_t              handle;
+    uint32_t               uiPoolCapacity; // Size of the backing when created by a DdiMediaBufferPool, 0 otherwise
 
     bool                   bCFlushReq; // No LLC between CPU & GPU, requries to call CPU Flush for CPU mapped buffer
     PDDI_MEDIA_SURFACE     pSurface;
@@ -680,7 +680,7 @@ VAStatus DdiMediaUtil_CreateBuffer(DDI_MEDIA_BUFFER *buffer, MOS_BUFMGR *bufmgr)
 
     if (buffer->format == Media_Format_CPU)
     {
-        buffer->pData= (uint8_t*)MOS_AllocAndZeroMemory(buffer->iSize);
+        buffer->pData= (uint8_t*)MOS_AllocAndZeroPooledMemory(buffer->iSize);
         if (nullptr == buffer->pData)
             hr = VA_STATUS_ERROR_ALLOCATION_FAILED;
     }
@@ -21,7 +21,9 @@
 set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/media_ddi_base.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_buffer_pool.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_capture.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_util.cpp
 )
@@ -31,8 +33,11 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_ddi_base.h
     ${CMAKE_CURRENT_LIST_DIR}/media_ddi_factory.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_buffer_pool.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps_factory.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_capture.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_capture_format.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_util.h
 )
@@ -346,6 +346,9 @@ extern "C" {
 #endif
 
 drm_export int mos_gem_bo_map_wc(struct mos_linux_bo *bo);
+drm_export int mos_gem_bo_map_persistent(struct mos_linux_bo *bo);
+drm_export int mos_gem_bo_map_persistent_cpu(struct mos_linux_bo *bo);
+drm_export int mos_gem_bo_sync_persistent(struct mos_linux_bo *bo);
 drm_export void mos_gem_bo_clear_relocs(struct mos_linux_bo *bo, int start);
 drm_export int mos_gem_bo_wait(struct mos_linux_bo *bo, int64_t timeout_ns);
 drm_export struct mos_linux_bo *
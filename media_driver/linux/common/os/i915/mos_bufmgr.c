@@ -111,6 +111,10 @@ struct mos_gem_bo_bucket {
     unsigned long size;
 };
 
+#define MOS_EXEC_FENCE_NUM 64
+/* Serial of the batches submitted while all the exec fences are in use */
+#define MOS_EXEC_SERIAL_UNTRACKED (~(uint64_t)0)
+
 struct mos_bufmgr_gem {
     struct mos_bufmgr bufmgr;
 
@@ -157,6 +161,20 @@ struct mos_bufmgr_gem {
         void *ptr;
         uint32_t handle;
     } userptr_active;
+
+    /** Submitted batches not known to be completed, oldest first */
+    struct {
+        struct mos_linux_bo *bo;
+        uint64_t serial;
+    } exec_fences[MOS_EXEC_FENCE_NUM];
+    int exec_fence_first;
+    int exec_fence_count;
+    /** Serial of the last submitted batch */
+    uint64_t exec_serial;
+    /** Serial up to which all the submitted batches are completed */
+    uint64_t retired_serial;
+    /** Whether any buffer was mapped by mos_gem_bo_map_persistent() */
+    bool has_persistent_map;
 } mos_bufmgr_gem;
 
 #define DRM_INTEL_RELOC_FENCE (1<<0)
@@ -260,6 +278,12 @@ struct mos_bo_gem {
      */
     bool idle;
 
+    /**
+     * Serial of the last batch referencing this buffer, see
+     * mos_gem_bo_sync_persistent().
+     */
+    uint64_t exec_serial;
+
     /**
      * Boolean of whether this buffer was allocated with userptr
      */
@@ -1540,6 +1564,217 @@ mos_gem_bo_map_wc_unsynchronized(struct mos_linux_bo *bo) {
     return ret;
 }
 
+/*
+ * Retires the oldest batches completed by the GPU, with bufmgr_gem->lock held.
+ * One busy check of a batch covers all the buffers the batch referenced.
+ */
+static void
+mos_gem_retire_exec_fences(struct mos_bufmgr_gem *bufmgr_gem)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    while (bufmgr_gem->exec_fence_count > 0) {
+        int first = bufmgr_gem->exec_fence_first;
+        struct mos_linux_bo *bo = bufmgr_gem->exec_fences[first].bo;
+
+        if (mos_gem_bo_busy(bo))
+            break;
+
+        bufmgr_gem->retired_serial = bufmgr_gem->exec_fences[first].serial;
+        bufmgr_gem->exec_fences[first].bo = nullptr;
+        bufmgr_gem->exec_fence_first = (first + 1) % MOS_EXEC_FENCE_NUM;
+        bufmgr_gem->exec_fence_count--;
+        mos_gem_bo_unreference_locked_timed(bo, time.tv_sec);
+    }
+}
+
+/*
+ * Tracks a submitted batch, with bufmgr_gem->lock held. Returns the serial
+ * of the batch, the buffers it references are stamped with it. This never
+ * blocks: when the oldest tracked batch is still running, the batch is not
+ * tracked and MOS_EXEC_SERIAL_UNTRACKED is returned, so that its buffers
+ * are waited for in the kernel.
+ */
+static uint64_t
+mos_gem_add_exec_fence(struct mos_bufmgr_gem *bufmgr_gem,
+               struct mos_linux_bo *bo)
+{
+    int last;
+
+    /* Only persistently mapped buffers are synced with the serials, and
+     * they are mapped before the first batch referencing them.
+     */
+    if (!bufmgr_gem->has_persistent_map)
+        return 0;
+
+    if (bufmgr_gem->exec_fence_count == MOS_EXEC_FENCE_NUM) {
+        mos_gem_retire_exec_fences(bufmgr_gem);
+    }
+    if (bufmgr_gem->exec_fence_count == MOS_EXEC_FENCE_NUM) {
+        /* Waiting here would stall every thread of the bufmgr */
+        return MOS_EXEC_SERIAL_UNTRACKED;
+    }
+
+    last = (bufmgr_gem->exec_fence_first + bufmgr_gem->exec_fence_count) %
+        MOS_EXEC_FENCE_NUM;
+    mos_gem_bo_reference(bo);
+    bufmgr_gem->exec_fences[last].bo = bo;
+    bufmgr_gem->exec_fences[last].serial = ++bufmgr_gem->exec_serial;
+    bufmgr_gem->exec_fence_count++;
+
+    return bufmgr_gem->exec_serial;
+}
+
+/*
+ * Maps the buffer write-combined until it is freed. There is no domain
+ * change, mos_gem_bo_sync_persistent() waits for the GPU instead.
+ */
+drm_export int
+mos_gem_bo_map_persistent(struct mos_linux_bo *bo)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
+#ifdef HAVE_VALGRIND
+    struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
+#endif
+    int ret;
+
+    pthread_mutex_lock(&bufmgr_gem->lock);
+
+    ret = map_wc(bo);
+    if (ret == 0) {
+        bufmgr_gem->has_persistent_map = true;
+        mos_gem_bo_mark_mmaps_incoherent(bo);
+        VG(VALGRIND_MAKE_MEM_DEFINED(bo_gem->mem_wc_virtual, bo->size));
+    }
+
+    pthread_mutex_unlock(&bufmgr_gem->lock);
+
+    return ret;
+}
+
+static int
+map_cpu(struct mos_linux_bo *bo)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
+    struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
+    int ret;
+
+    if (bo_gem->is_userptr)
+        return -EINVAL;
+
+    if (bo_gem->map_count++ == 0)
+        mos_gem_bo_open_vma(bufmgr_gem, bo_gem);
+
+    /* Get a mapping of the buffer if we haven't before. */
+    if (bo_gem->mem_virtual == nullptr) {
+        struct drm_i915_gem_mmap mmap_arg;
+
+        MOS_DBG("bo_map_cpu: mmap %d (%s), map_count=%d\n",
+            bo_gem->gem_handle, bo_gem->name, bo_gem->map_count);
+
+        memclear(mmap_arg);
+        mmap_arg.handle = bo_gem->gem_handle;
+        mmap_arg.size = bo->size;
+        ret = drmIoctl(bufmgr_gem->fd,
+                   DRM_IOCTL_I915_GEM_MMAP,
+                   &mmap_arg);
+        if (ret != 0) {
+            ret = -errno;
+            MOS_DBG("%s:%d: Error mapping buffer %d (%s): %s .\n",
+                __FILE__, __LINE__, bo_gem->gem_handle,
+                bo_gem->name, strerror(errno));
+            if (--bo_gem->map_count == 0)
+                mos_gem_bo_close_vma(bufmgr_gem, bo_gem);
+            return ret;
+        }
+        VG(VALGRIND_MALLOCLIKE_BLOCK(mmap_arg.addr_ptr, mmap_arg.size, 0, 1));
+        bo_gem->mem_virtual = (void *)(uintptr_t) mmap_arg.addr_ptr;
+    }
+#ifdef __cplusplus
+    bo->virt = bo_gem->mem_virtual;
+#else
+    bo->virtual = bo_gem->mem_virtual;
+#endif
+
+    MOS_DBG("bo_map_cpu: %d (%s) -> %p\n", bo_gem->gem_handle, bo_gem->name,
+        bo_gem->mem_virtual);
+
+    return 0;
+}
+
+/*
+ * Maps the buffer through the CPU cache until it is freed. Only LLC platforms
+ * keep such a mapping coherent with the GPU, -EINVAL is returned on the
+ * others. There is no domain change, mos_gem_bo_sync_persistent() waits for
+ * the GPU instead. Unlike the write-combined mapping of
+ * mos_gem_bo_map_persistent(), the buffer can be read back at CPU speed.
+ */
+drm_export int
+mos_gem_bo_map_persistent_cpu(struct mos_linux_bo *bo)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
+#ifdef HAVE_VALGRIND
+    struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
+#endif
+    int ret;
+
+    if (!bufmgr_gem->has_llc)
+        return -EINVAL;
+
+    pthread_mutex_lock(&bufmgr_gem->lock);
+
+    ret = map_cpu(bo);
+    if (ret == 0) {
+        bufmgr_gem->has_persistent_map = true;
+        mos_gem_bo_mark_mmaps_incoherent(bo);
+        VG(VALGRIND_MAKE_MEM_DEFINED(bo_gem->mem_virtual, bo->size));
+    }
+
+    pthread_mutex_unlock(&bufmgr_gem->lock);
+
+    return ret;
+}
+
+/*
+ * Waits for the batches referencing a persistently mapped buffer. Nothing is
+ * issued to the kernel if the last batch referencing the buffer is known to
+ * be completed, else the completed batches are retired and the buffer is
+ * only waited for if it is still in use. The buffers of untracked batches
+ * are always waited for in the kernel.
+ */
+drm_export int
+mos_gem_bo_sync_persistent(struct mos_linux_bo *bo)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
+    struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
+    uint64_t serial;
+    bool pending;
+    int ret;
+
+    pthread_mutex_lock(&bufmgr_gem->lock);
+    serial = bo_gem->exec_serial;
+    if (serial > bufmgr_gem->retired_serial)
+        mos_gem_retire_exec_fences(bufmgr_gem);
+    pending = serial > bufmgr_gem->retired_serial;
+    pthread_mutex_unlock(&bufmgr_gem->lock);
+
+    if (!pending)
+        return 0;
+
+    ret = mos_gem_bo_wait(bo, -1);
+    if (ret == 0) {
+        pthread_mutex_lock(&bufmgr_gem->lock);
+        /* Idle until the next batch referencing it */
+        if (bo_gem->exec_serial == serial)
+            bo_gem->exec_serial = 0;
+        pthread_mutex_unlock(&bufmgr_gem->lock);
+    }
+
+    return ret;
+}
+
 drm_export int mos_gem_bo_map(struct mos_linux_bo *bo, int write_enable)
 {
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
@@ -2064,6 +2299,13 @@ mos_bufmgr_gem_destroy(struct mos_bufmgr *bufmgr)
     struct drm_gem_close close_bo;
     int i, ret;
 
+    /* Release the batches of the persistent mapping fences */
+    for (i = 0; i < bufmgr_gem->exec_fence_count; i++) {
+        int index = (bufmgr_gem->exec_fence_first + i) % MOS_EXEC_FENCE_NUM;
+        mos_gem_bo_unreference_locked_timed(bufmgr_gem->exec_fences[index].bo, 0);
+    }
+    bufmgr_gem->exec_fence_count = 0;
+
     free(bufmgr_gem->exec2_objects);
     free(bufmgr_gem->exec_objects);
     free(bufmgr_gem->exec_bos);
@@ -2561,6 +2803,7 @@ mos_gem_bo_exec(struct mos_linux_bo *bo, int used,
 {
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
     struct drm_i915_gem_execbuffer execbuf;
+    uint64_t serial;
     int ret, i;
 
     if (to_bo_gem(bo)->has_error)
@@ -2607,9 +2850,11 @@ mos_gem_bo_exec(struct mos_linux_bo *bo, int used,
     if (bufmgr_gem->bufmgr.debug)
         mos_gem_dump_validation_list(bufmgr_gem);
 
+    serial = mos_gem_add_exec_fence(bufmgr_gem, bo);
     for (i = 0; i < bufmgr_gem->exec_count; i++) {
         struct mos_bo_gem *bo_gem = to_bo_gem(bufmgr_gem->exec_bos[i]);
         bo_gem->idle = false;
+        bo_gem->exec_serial = serial;
 
         /* Disconnect the buffer from the validate list */
         bo_gem->validate_index = -1;
@@ -2630,6 +2875,7 @@ do_exec2(struct mos_linux_bo *bo, int used, struct mos_linux_context *ctx,
 
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)bo->bufmgr;
     struct drm_i915_gem_execbuffer2 execbuf;
+    uint64_t serial;
     int ret = 0;
     int i;
 
@@ -2722,10 +2968,12 @@ skip_execution:
     if (bufmgr_gem->bufmgr.debug)
         mos_gem_dump_validation_list(bufmgr_gem);
 
+    serial = mos_gem_add_exec_fence(bufmgr_gem, bo);
     for (i = 0; i < bufmgr_gem->exec_count; i++) {
         struct mos_bo_gem *bo_gem = to_bo_gem(bufmgr_gem->exec_bos[i]);
 
         bo_gem->idle = false;
+        bo_gem->exec_serial = serial;
 
         /* Disconnect the buffer from the validate list */
         bo_gem->validate_index = -1;
@@ -53,6 +53,13 @@ MOS_STATUS  CommandBufferSpecific::Allocate(OsContext *osContext, uint32_t size)
     params.m_arraySize = 1;
     params.m_name      = "MOS CmdBuf";
 
+    // Mapped once for the lifetime of the buffer, binding it to a GPU context
+    // and submitting it then need no map, unmap or domain change ioctl.
+    // MHW builds commands in place and reads their fields back, so the mapping
+    // is cached. Without LLC the buffer is mapped on bind as before.
+    params.m_flags.bPersistentMap       = true;
+    params.m_flags.bPersistentMapCached = true;
+
     m_graphicsResource = GraphicsResource::CreateGraphicResource(GraphicsResource::osSpecificResource);
     MOS_OS_CHK_NULL_RETURN(m_graphicsResource);
 
@@ -84,8 +91,11 @@ MOS_STATUS CommandBufferSpecific::BindToGpuContext(GpuContext *gpuContext)
     MOS_OS_CHK_NULL_RETURN(gpuContext);
     MOS_OS_CHK_NULL_RETURN(m_graphicsResource);
 
+    // Command buffers are waited for before they are returned to CmdBufMgr,
+    // the persistent mapping doesn't need to wait for the GPU again
     GraphicsResource::LockParams params;
     params.m_writeRequest = true;
+    params.m_noOverWrite  = true;
     m_lockAddr = static_cast<uint8_t *>(m_graphicsResource->Lock(m_osContext, params));
     MOS_OS_CHK_NULL_RETURN(m_lockAddr);
 
@@ -33,6 +33,8 @@
 #include "mos_os_virtualengine.h"
 #include <unistd.h>
 
+#define MOS_RES_REGISTRY_MAX_SIZE   (4 * ALLOCATIONLIST_SIZE)   //!< bos kept in the resource registry across submissions
+
 #define MI_BATCHBUFFER_END 0x05000000
 static pthread_mutex_t command_dump_mutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -116,6 +118,15 @@ MOS_STATUS GpuContextSpecific::Init(OsContext *osContext,
     m_writeModeList = (bool *)MOS_AllocAndZeroMemory(sizeof(bool) * ALLOCATIONLIST_SIZE);
     MOS_OS_CHK_NULL_RETURN(m_writeModeList);
 
+    m_patchAllocBos = (mos_linux_bo **)MOS_AllocAndZeroMemory(sizeof(mos_linux_bo *) * ALLOCATIONLIST_SIZE);
+    MOS_OS_CHK_NULL_RETURN(m_patchAllocBos);
+
+    m_patchBoOffsets = (uint64_t *)MOS_AllocAndZeroMemory(sizeof(uint64_t) * ALLOCATIONLIST_SIZE);
+    MOS_OS_CHK_NULL_RETURN(m_patchBoOffsets);
+
+    // The registry is kept across submissions, size its buckets once
+    m_resRegistry.reserve(MOS_RES_REGISTRY_MAX_SIZE);
+
     m_GPUStatusTag = 1;
 
     m_createOptionEnhanced = (MOS_GPUCTX_CREATOPTIONS_ENHANCED*)MOS_AllocAndZeroMemory(sizeof(MOS_GPUCTX_CREATOPTIONS_ENHANCED));
@@ -298,6 +309,8 @@ void GpuContextSpecific::Clear()
     MOS_SafeFreeMemory(m_patchLocationList);
     MOS_SafeFreeMemory(m_attachedResources);
     MOS_SafeFreeMemory(m_writeModeList);
+    MOS_SafeFreeMemory(m_patchAllocBos);
+    MOS_SafeFreeMemory(m_patchBoOffsets);
     MOS_SafeFreeMemory(m_createOptionEnhanced);
 
     for (int i=0; i<MAX_ENGINE_INSTANCE_NUM; i++)
@@ -320,52 +333,53 @@ MOS_STATUS GpuContextSpecific::RegisterResource(
 
     MOS_OS_CHK_NULL_RETURN(m_attachedResources);
 
-    PMOS_RESOURCE registeredResources = m_attachedResources;
-    uint32_t      allocationIndex     = 0;
+    MOS_OS_CHK_NULL_RETURN(m_allocationList);
+    MOS_OS_CHK_NULL_RETURN(m_writeModeList);
 
-    for ( allocationIndex = 0; allocationIndex < m_resCount; allocationIndex++, registeredResources++)
+    if (m_gpuContext >= MOS_GPU_CONTEXT_MAX)
     {
-        if (osResource->bo == registeredResources->bo)
-        {
-            break;
-        }
+        MOS_OS_ASSERTMESSAGE("Gpu context exceeds max.");
+        return MOS_STATUS_UNKNOWN;
     }
 
-    // Allocation list to be updated
-    if (allocationIndex < m_maxNumAllocations)
-    {
-        // New buffer
-        if (allocationIndex == m_resCount)
-        {
-            m_resCount++;
-        }
+    auto    &registration   = m_resRegistry[osResource->bo];
+    uint32_t allocationIndex = registration.allocationIndex;
 
-        // Set allocation
-        if (m_gpuContext >= MOS_GPU_CONTEXT_MAX)
+    // New buffer
+    if (registration.generation != m_resGeneration)
+    {
+        if (m_numAllocations >= m_maxNumAllocations)
         {
-            MOS_OS_ASSERTMESSAGE("Gpu context exceeds max.");
-            return MOS_STATUS_UNKNOWN; 
+            MOS_OS_ASSERTMESSAGE("Reached max # registrations.");
+            return MOS_STATUS_UNKNOWN;
         }
 
-        osResource->iAllocationIndex[m_gpuContext] = (allocationIndex);
-        m_attachedResources[allocationIndex]           = *osResource;
-        m_writeModeList[allocationIndex] |= writeFlag;
-        m_allocationList[allocationIndex].hAllocation = &m_attachedResources[allocationIndex];
-        m_allocationList[allocationIndex].WriteOperation |= writeFlag;
-        m_numAllocations = m_resCount;
-    }
-    else
-    {
-        MOS_OS_ASSERTMESSAGE("Reached max # registrations.");
-        return MOS_STATUS_UNKNOWN;
+        allocationIndex              = m_numAllocations++;
+        registration.allocationIndex = allocationIndex;
+        registration.generation      = m_resGeneration;
     }
 
+    // Set allocation
+    osResource->iAllocationIndex[m_gpuContext] = (allocationIndex);
+    m_attachedResources[allocationIndex]           = *osResource;
+    m_writeModeList[allocationIndex] |= writeFlag;
+    m_allocationList[allocationIndex].hAllocation = &m_attachedResources[allocationIndex];
+    m_allocationList[allocationIndex].WriteOperation |= writeFlag;
+
     return MOS_STATUS_SUCCESS;
 }
 
 MOS_STATUS GpuContextSpecific::SetPatchEntry(
     PMOS_INTERFACE          osInterface,
     PMOS_PATCH_ENTRY_PARAMS params)
+{
+    return SetPatchEntries(osInterface, params, 1);
+}
+
+MOS_STATUS GpuContextSpecific::SetPatchEntries(
+    PMOS_INTERFACE          osInterface,
+    PMOS_PATCH_ENTRY_PARAMS params,
+    uint32_t                numEntries)
 {
     MOS_OS_FUNCTION_ENTER;
 
@@ -373,27 +387,38 @@ MOS_STATUS GpuContextSpecific::SetPatchEntry(
     MOS_OS_CHK_NULL_RETURN(osInterface);
     MOS_OS_CHK_NULL_RETURN(params);
 
-    m_patchLocationList[m_currentNumPatchLocations].AllocationIndex  = params->uiAllocationIndex;
-    m_patchLocationList[m_currentNumPatchLocations].AllocationOffset = params->uiResourceOffset;
-    m_patchLocationList[m_currentNumPatchLocations].PatchOffset      = params->uiPatchOffset;
-    m_patchLocationList[m_currentNumPatchLocations].uiWriteOperation = params->bWrite ? true: false;
+    if (m_currentNumPatchLocations + numEntries > m_maxPatchLocationsize)
+    {
+        MOS_OS_ASSERTMESSAGE("Patch list is full.");
+        return MOS_STATUS_NO_SPACE;
+    }
+
+    bool hmEnabled = osInterface->osCpInterface && osInterface->osCpInterface->IsHMEnabled();
+    auto patch     = &m_patchLocationList[m_currentNumPatchLocations];
 
-    if (osInterface->osCpInterface &&
-        osInterface->osCpInterface->IsHMEnabled())
+    for (uint32_t i = 0; i < numEntries; i++, patch++)
     {
-        if (MOS_STATUS_SUCCESS != osInterface->osCpInterface->RegisterPatchForHM(
-            (uint32_t *)(params->cmdBufBase + params->uiPatchOffset),
-            params->bWrite,
-            params->HwCommandType,
-            params->forceDwordOffset,
-            params->presResource,
-            &m_patchLocationList[m_currentNumPatchLocations]))
+        patch->AllocationIndex  = params[i].uiAllocationIndex;
+        patch->AllocationOffset = params[i].uiResourceOffset;
+        patch->PatchOffset      = params[i].uiPatchOffset;
+        patch->uiWriteOperation = params[i].bWrite ? true: false;
+
+        if (hmEnabled)
         {
-            MOS_OS_ASSERTMESSAGE("Failed to RegisterPatchForHM.");
+            if (MOS_STATUS_SUCCESS != osInterface->osCpInterface->RegisterPatchForHM(
+                (uint32_t *)(params[i].cmdBufBase + params[i].uiPatchOffset),
+                params[i].bWrite,
+                params[i].HwCommandType,
+                params[i].forceDwordOffset,
+                params[i].presResource,
+                patch))
+            {
+                MOS_OS_ASSERTMESSAGE("Failed to RegisterPatchForHM.");
+            }
         }
     }
 
-    m_currentNumPatchLocations++;
+    m_currentNumPatchLocations += numEntries;
 
     return MOS_STATUS_SUCCESS;
 }
@@ -482,6 +507,7 @@ MOS_STATUS GpuContextSpecific::GetCommandBuffer(
         // zero comamnd buffer
         MOS_ZeroMemory(comamndBuffer->pCmdBase, comamndBuffer->iRemaining);
         comamndBuffer->iSubmissionType = SUBMISSION_TYPE_SINGLE_PIPE;
+        comamndBuffer->bWriteCombined  = comamndBuffer->OsResource.MmapOperation == MOS_MMAP_OPERATION_MMAP_WC;
         MOS_ZeroMemory(&comamndBuffer->Attributes,sizeof(comamndBuffer->Attributes));
 
         // update command buffer relared filed in GPU context
@@ -670,6 +696,64 @@ MOS_STATUS GpuContextSpecific::MapResourcesToAuxTable(mos_linux_bo *cmd_bo)
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS GpuContextSpecific::ResolvePatchAllocations(
+    PMOS_CONTEXT  osContext,
+    mos_linux_bo *cmd_bo)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    MOS_OS_CHK_NULL_RETURN(osContext);
+    MOS_OS_CHK_NULL_RETURN(cmd_bo);
+    MOS_OS_CHK_NULL_RETURN(m_patchAllocBos);
+    MOS_OS_CHK_NULL_RETURN(m_patchBoOffsets);
+
+    bool hasAllocBo = false;
+
+    for (uint32_t i = 0; i < m_numAllocations; i++)
+    {
+        // For now, we'll assume the system memory's DRM bo pointer
+        // is NULL.  If nullptr is detected, then the resource has been
+        // placed inside the command buffer's indirect state area.
+        // We'll simply set alloc_bo to the command buffer's bo pointer.
+        auto resource = (PMOS_RESOURCE)m_allocationList[i].hAllocation;
+        auto alloc_bo = (resource && resource->bo) ? resource->bo : cmd_bo;
+
+        m_patchAllocBos[i]  = alloc_bo;
+        m_patchBoOffsets[i] = alloc_bo->offset64;
+        hasAllocBo |= (alloc_bo != cmd_bo);
+    }
+
+    if (!hasAllocBo)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Single pass over the offsets of the context, walked backwards so that
+    // the first entry of a bo wins as it did with a forward search per patch.
+    for (auto item_ctx = osContext->contextOffsetList.rbegin(); item_ctx != osContext->contextOffsetList.rend(); item_ctx++)
+    {
+        if (item_ctx->intel_context != osContext->intel_context)
+        {
+            continue;
+        }
+
+        // The registry maps the bos of this submission to their allocation
+        if (item_ctx->target_bo == nullptr || item_ctx->target_bo == cmd_bo)
+        {
+            continue;
+        }
+
+        auto registration = m_resRegistry.find(item_ctx->target_bo);
+        if (registration != m_resRegistry.end() &&
+            registration->second.generation == m_resGeneration)
+        {
+            m_patchBoOffsets[registration->second.allocationIndex] = item_ctx->offset64;
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS GpuContextSpecific::SubmitCommandBuffer(
     PMOS_INTERFACE      osInterface,
     PMOS_COMMAND_BUFFER cmdBuffer,
@@ -697,42 +781,36 @@ MOS_STATUS GpuContextSpecific::SubmitCommandBuffer(
     // Map Resource to Aux if needed
     MapResourcesToAuxTable(cmd_bo);
 
+    MOS_OS_CHK_STATUS_RETURN(ResolvePatchAllocations(osContext, cmd_bo));
+
+    MOS_DEVULT_FuncCall(pfnUltGetAllocationList,
+        m_allocationList, m_numAllocations, m_maxNumAllocations,
+        m_patchLocationList, m_currentNumPatchLocations, m_maxPatchLocationsize);
+
     // Now, the patching will be done, based on the patch list.
     for (uint32_t patchIndex = 0; patchIndex < m_currentNumPatchLocations; patchIndex++)
     {
         auto currentPatch = &m_patchLocationList[patchIndex];
         MOS_OS_CHK_NULL_RETURN(currentPatch);
 
+        if (currentPatch->AllocationIndex >= m_numAllocations)
+        {
+            MOS_OS_ASSERTMESSAGE("Patch location refers to unregistered allocation %u.", currentPatch->AllocationIndex);
+            return MOS_STATUS_INVALID_PARAMETER;
+        }
+
         // This is the resource for which patching will be done
         auto resource = (PMOS_RESOURCE)m_allocationList[currentPatch->AllocationIndex].hAllocation;
         MOS_OS_CHK_NULL_RETURN(resource);
-
-        // For now, we'll assume the system memory's DRM bo pointer
-        // is NULL.  If nullptr is detected, then the resource has been
-        // placed inside the command buffer's indirect state area.
-        // We'll simply set alloc_bo to the command buffer's bo pointer.
         MOS_OS_ASSERT(resource->bo);
 
-        auto alloc_bo = (resource->bo) ? resource->bo : cmd_bo;
+        auto     alloc_bo = m_patchAllocBos[currentPatch->AllocationIndex];
+        uint64_t boOffset = m_patchBoOffsets[currentPatch->AllocationIndex];
 
         MOS_OS_CHK_STATUS_RETURN(osInterface->osCpInterface->PermeatePatchForHM(
             cmd_bo->virt,
             currentPatch,
             resource));
-
-        uint64_t boOffset = alloc_bo->offset64;
-        if (alloc_bo != cmd_bo)
-        {
-            auto item_ctx = osContext->contextOffsetList.begin();
-            for (; item_ctx != osContext->contextOffsetList.end(); item_ctx++)
-            {
-                if (item_ctx->intel_context == osContext->intel_context && item_ctx->target_bo == alloc_bo)
-                {
-                    boOffset = item_ctx->offset64;
-                    break;
-                }
-            }
-        }
         if (osContext->bUse64BitRelocs)
         {
             *((uint64_t *)((uint8_t *)cmd_bo->virt + currentPatch->PatchOffset)) =
@@ -780,6 +858,7 @@ MOS_STATUS GpuContextSpecific::SubmitCommandBuffer(
     }
 
     // Now, we can unmap the video command buffer, since we don't need CPU access anymore.
+    // Command buffers are persistently mapped, this is a no-op unless the mapping failed.
     MOS_OS_CHK_NULL_RETURN(cmdBuffer->OsResource.pGfxResource);
     cmdBuffer->OsResource.pGfxResource->Unlock(m_osContext);
 
@@ -991,9 +1070,17 @@ MOS_STATUS GpuContextSpecific::SubmitCommandBuffer(
 pthread_mutex_lock(&command_dump_mutex);
 if (osInterface->bDumpCommandBuffer)
     {
-        mos_bo_map(cmd_bo, 0);
-        osInterface->pfnDumpCommandBuffer(osInterface, cmdBuffer);
-        mos_bo_unmap(cmd_bo);
+        // A persistent mapping stays valid, don't remap it
+        if (cmdBuffer->OsResource.bPersistentMapped)
+        {
+            osInterface->pfnDumpCommandBuffer(osInterface, cmdBuffer);
+        }
+        else
+        {
+            mos_bo_map(cmd_bo, 0);
+            osInterface->pfnDumpCommandBuffer(osInterface, cmdBuffer);
+            mos_bo_unmap(cmd_bo);
+        }
     }
     pthread_mutex_unlock(&command_dump_mutex);
 #endif  // MOS_COMMAND_BUFFER_DUMP_SUPPORTED
@@ -1014,13 +1101,7 @@ if (osInterface->bDumpCommandBuffer)
     mos_gem_bo_clear_relocs(cmd_bo, 0);
 
     // Reset resource allocation
-    m_numAllocations = 0;
-    MOS_ZeroMemory(m_allocationList, sizeof(ALLOCATION_LIST) * m_maxNumAllocations);
-    m_currentNumPatchLocations = 0;
-    MOS_ZeroMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * m_maxNumAllocations);
-    m_resCount = 0;
-
-    MOS_ZeroMemory(m_writeModeList, sizeof(bool) * m_maxNumAllocations);
+    ResetAllocationLists();
 finish:
     return eStatus;
 }
@@ -1034,17 +1115,51 @@ void GpuContextSpecific::IncrementGpuStatusTag()
     }
 }
 
-void GpuContextSpecific::ResetGpuContextStatus()
+void GpuContextSpecific::ResetAllocationLists()
 {
-    MOS_ZeroMemory(m_allocationList, sizeof(ALLOCATION_LIST) * ALLOCATIONLIST_SIZE);
+    // Entries past the counts are zero, only the used ones need to be cleared
+    if (m_allocationList && m_attachedResources && m_writeModeList)
+    {
+        MOS_ZeroMemory(m_allocationList, sizeof(ALLOCATION_LIST) * m_numAllocations);
+        MOS_ZeroMemory(m_attachedResources, sizeof(MOS_RESOURCE) * m_numAllocations);
+        MOS_ZeroMemory(m_writeModeList, sizeof(bool) * m_numAllocations);
+    }
     m_numAllocations = 0;
-    MOS_ZeroMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * PATCHLOCATIONLIST_SIZE);
+
+    if (m_patchLocationList)
+    {
+        MOS_ZeroMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * m_currentNumPatchLocations);
+    }
     m_currentNumPatchLocations = 0;
 
-    MOS_ZeroMemory(m_attachedResources, sizeof(MOS_RESOURCE) * ALLOCATIONLIST_SIZE);
-    m_resCount = 0;
+    // Drop the registrations of the submission. The entries are kept so that
+    // the bos submitted again reuse them, only the bos not submitted in the
+    // last submission are erased once the registry holds too many of them.
+    m_resGeneration++;
+    if (m_resGeneration == 0)
+    {
+        m_resRegistry.clear();
+        m_resGeneration = 1;
+    }
+    else if (m_resRegistry.size() > MOS_RES_REGISTRY_MAX_SIZE)
+    {
+        for (auto it = m_resRegistry.begin(); it != m_resRegistry.end();)
+        {
+            if (it->second.generation + 1 != m_resGeneration)
+            {
+                it = m_resRegistry.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
 
-    MOS_ZeroMemory(m_writeModeList, sizeof(bool) * ALLOCATIONLIST_SIZE);
+void GpuContextSpecific::ResetGpuContextStatus()
+{
+    ResetAllocationLists();
 
     if ((m_cmdBufFlushed == true) && m_commandBuffer->OsResource.bo)
     {
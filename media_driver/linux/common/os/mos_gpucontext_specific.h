@@ -29,6 +29,7 @@
 
 #include "mos_gpucontext.h"
 #include "mos_graphicsresource_specific.h"
+#include <unordered_map>
 
 //!
 //! \class  GpuContextSpecific
@@ -118,6 +119,24 @@ public:
         PMOS_INTERFACE          osInterface,
         PMOS_PATCH_ENTRY_PARAMS params);
 
+    //!
+    //! \brief    Set patch entries
+    //! \details  Sets several patch entries in patch list with one call,
+    //!           typically all the relocations of one command
+    //! \param    [in] osInterface
+    //!           Pointer to OS interface structure
+    //! \param    [in] params
+    //!           Array of numEntries patch entry params
+    //! \param    [in] numEntries
+    //!           Number of patch entries
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS SetPatchEntries(
+        PMOS_INTERFACE          osInterface,
+        PMOS_PATCH_ENTRY_PARAMS params,
+        uint32_t                numEntries);
+
     void ReturnCommandBuffer(
         PMOS_COMMAND_BUFFER cmdBuffer,
         uint32_t            flags);
@@ -196,6 +215,28 @@ protected:
     //!
     MOS_STATUS MapResourcesToAuxTable(mos_linux_bo *cmd_bo);
 
+    //!
+    //! \brief    Resolve the bo and bo offset of each registered allocation
+    //! \details  Done once per submission, so that patching a location is a
+    //!           lookup by its allocation index instead of a search of the
+    //!           context offset list.
+    //! \param    [in] osContext
+    //!           Pointer to OS context
+    //! \param    [in] cmd_bo
+    //!           Command buffer bo, used for allocations without bo
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    MOS_STATUS ResolvePatchAllocations(PMOS_CONTEXT osContext, mos_linux_bo *cmd_bo);
+
+    //!
+    //! \brief    Reset the allocation and patch lists
+    //! \details  Only the used entries are cleared, the registry is reset by
+    //!           starting a new generation.
+    //! \return   void
+    //!
+    void ResetAllocationLists();
+
 private:
     //! \brief    internal command buffer pool per gpu context
     std::vector<CommandBuffer *> m_cmdBufPool;
@@ -226,11 +267,27 @@ private:
     uint32_t           m_currentNumPatchLocations = 0; //!< number of registered patch list
     uint32_t           m_maxPatchLocationsize; //!< max number of patch list
 
-   //! \brief    Resource registrations
-    uint32_t      m_resCount = 0;  //!< number of resources registered
+    //! \brief    Resource registrations
     PMOS_RESOURCE m_attachedResources = nullptr;  //!< Pointer to resources list
     bool         *m_writeModeList     = nullptr;  //!< Write mode
 
+    //! \brief    Allocation index of a registered bo
+    struct ResourceRegistration
+    {
+        uint32_t allocationIndex;   //!< Index in the allocation list
+        uint32_t generation;        //!< Registered in the submission of this generation
+    };
+
+    //! \brief    Registry of the bos of the allocation list
+    //! \details  Entries of an older generation are not registered, so the
+    //!           registry is reset by incrementing m_resGeneration.
+    std::unordered_map<mos_linux_bo *, ResourceRegistration> m_resRegistry;
+    uint32_t      m_resGeneration = 1;  //!< Generation of the current submission, never 0
+
+    //! \brief    Patch targets resolved at submission, indexed by allocation index
+    mos_linux_bo **m_patchAllocBos  = nullptr;  //!< bo patched for each allocation
+    uint64_t      *m_patchBoOffsets = nullptr;  //!< Offset of the bo in this context
+
     //! \brief    GPU Status tag
     uint32_t m_GPUStatusTag = 0;
 
@@ -310,6 +310,30 @@ MOS_STATUS GraphicsResourceSpecific::Allocate(OsContext* osContextPtr, CreatePar
         m_mapped        = false;
         m_mmapOperation = MOS_MMAP_OPERATION_NONE;
 
+        // Resources written by the CPU every frame are mapped once through WC,
+        // Lock then only waits for the GPU instead of remapping and switching domain.
+        // Resources also read back by the CPU are mapped cached, which needs LLC.
+        m_persistentMapped = false;
+        if (params.m_flags.bPersistentMap &&
+            Mos_Specific_IsPersistentMapEnabled() &&
+            tileFormatLinux == I915_TILING_NONE &&
+            params.m_pSystemMemory == nullptr &&
+            !pOsContextSpecific->IsAtomSoc())
+        {
+            if (params.m_flags.bPersistentMapCached)
+            {
+                m_persistentMapped = mos_gem_bo_map_persistent_cpu(boPtr) == 0;
+                m_mmapOperation    = m_persistentMapped ? MOS_MMAP_OPERATION_MMAP : MOS_MMAP_OPERATION_NONE;
+            }
+            else
+            {
+                m_persistentMapped = mos_gem_bo_map_persistent(boPtr) == 0;
+                m_mmapOperation    = m_persistentMapped ? MOS_MMAP_OPERATION_MMAP_WC : MOS_MMAP_OPERATION_NONE;
+            }
+            m_mapped = m_persistentMapped;
+            m_pData  = (uint8_t *)boPtr->virt;
+        }
+
         m_arraySize = 1;
         m_depth     = MOS_MAX(1, gmmResourceInfoPtr->GetBaseDepth());
         m_size      = (uint32_t)gmmResourceInfoPtr->GetSizeSurface();
@@ -350,6 +374,13 @@ void GraphicsResourceSpecific::Free(OsContext* osContextPtr, uint32_t  freeFlag)
         {
             auxTableMgr->UnmapResource(m_gmmResInfo, boPtr);
         }
+        if (m_persistentMapped)
+        {
+            mos_bo_unmap(boPtr);
+            m_persistentMapped = false;
+            m_mapped           = false;
+            m_pData            = nullptr;
+        }
         mos_bo_unreference(boPtr);
         m_bo = nullptr;
         if (nullptr != m_gmmResInfo)
@@ -398,6 +429,7 @@ MOS_STATUS GraphicsResourceSpecific::ConvertToMosResource(MOS_RESOURCE* pMosReso
     pMosResource->bo       = m_bo;
     pMosResource->bMapped  = m_mapped;
     pMosResource->MmapOperation = m_mmapOperation;
+    pMosResource->bPersistentMapped = m_persistentMapped;
     pMosResource->pGmmResInfo   = m_gmmResInfo;
 
     pMosResource->user_provided_va    = m_userProvidedVA;
@@ -428,6 +460,16 @@ void* GraphicsResourceSpecific::Lock(OsContext* osContextPtr, LockParams& params
     void*   dataPtr     = nullptr;
     MOS_LINUX_BO* boPtr = m_bo;
 
+    if (boPtr && m_persistentMapped)
+    {
+        // Already mapped, only wait for the GPU unless the caller does not overwrite in use data
+        if (!params.m_noOverWrite)
+        {
+            mos_gem_bo_sync_persistent(boPtr);
+        }
+        return m_pData;
+    }
+
     if (boPtr)
     {
         // Do decompression for a compressed surface before lock
@@ -525,6 +567,12 @@ MOS_STATUS GraphicsResourceSpecific::Unlock(OsContext* osContextPtr)
     OsContextSpecific *pOsContextSpecific  = static_cast<OsContextSpecific *>(osContextPtr);
 
     MOS_LINUX_BO* boPtr = m_bo;
+    if (boPtr && m_persistentMapped)
+    {
+        // The mapping is kept until the resource is freed
+        return MOS_STATUS_SUCCESS;
+    }
+
     if (boPtr)
     {
         if (m_mapped)
@@ -168,6 +168,11 @@ private:
     //!
     MOS_MMAP_OPERATION m_mmapOperation = MOS_MMAP_OPERATION_NONE;
 
+    //!
+    //! \brief  Whether the graphic resource stays mapped from allocation to free
+    //!
+    bool m_persistentMapped = false;
+
     //!
     //! \brief  the ptr to the buffer object of the graphic buffer
     //!
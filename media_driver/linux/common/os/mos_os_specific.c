@@ -203,6 +203,7 @@ int32_t Linux_GetCommandBuffer(
 
     MOS_ZeroMemory(pCmdBuffer->pCmdBase, cmd_bo->size);
     pCmdBuffer->iSubmissionType = SUBMISSION_TYPE_SINGLE_PIPE;
+    pCmdBuffer->bWriteCombined  = false;
     MOS_ZeroMemory(&pCmdBuffer->Attributes, sizeof(pCmdBuffer->Attributes));
     bResult = true;
 
@@ -1885,6 +1886,24 @@ GMM_RESOURCE_FORMAT Mos_Specific_ConvertMosFmtToGmmFmt(
     }
 }
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+//!
+//! \brief    Map no resource persistently
+//! \details  Read from "MOS Persistent Map Disable" when an OS interface is
+//!           created, to count the ioctls saved by the persistent mappings
+//!
+static uint8_t MosPersistentMapDisable;
+#endif
+
+bool Mos_Specific_IsPersistentMapEnabled()
+{
+#if (_DEBUG || _RELEASE_INTERNAL)
+    return MosPersistentMapDisable == 0;
+#else
+    return true;
+#endif
+}
+
 //!
 //! \brief    Allocate resource
 //! \details  To Allocate Buffer, pass Format as Format_Buffer and set the iWidth as size of the buffer.
@@ -2148,6 +2167,25 @@ MOS_STATUS Mos_Specific_AllocateResource(
         pOsResource->bo           = bo;
         pOsResource->TileType     = tileformat;
         pOsResource->pData        = (uint8_t*) bo->virt; //It is useful for batch buffer to fill commands
+        pOsResource->bPersistentMapped = false;
+        if (pParams->Flags.bPersistentMap &&
+            Mos_Specific_IsPersistentMapEnabled() &&
+            tileformat_linux == I915_TILING_NONE &&
+            !pOsInterface->pOsContext->bIsAtomSOC)
+        {
+            if (pParams->Flags.bPersistentMapCached)
+            {
+                pOsResource->bPersistentMapped = mos_gem_bo_map_persistent_cpu(bo) == 0;
+                pOsResource->MmapOperation     = pOsResource->bPersistentMapped ? MOS_MMAP_OPERATION_MMAP : MOS_MMAP_OPERATION_NONE;
+            }
+            else
+            {
+                pOsResource->bPersistentMapped = mos_gem_bo_map_persistent(bo) == 0;
+                pOsResource->MmapOperation     = pOsResource->bPersistentMapped ? MOS_MMAP_OPERATION_MMAP_WC : MOS_MMAP_OPERATION_NONE;
+            }
+            pOsResource->bMapped = pOsResource->bPersistentMapped;
+            pOsResource->pData   = (uint8_t*) bo->virt;
+        }
         MOS_OS_VERBOSEMESSAGE("Alloc %7d bytes (%d x %d resource).",iSize, pParams->dwWidth, iHeight);
     }
     else
@@ -2410,6 +2448,10 @@ void Mos_Specific_FreeResource(
             }
         }
 
+        if (pOsResource->bPersistentMapped)
+        {
+            mos_bo_unmap(pOsResource->bo);
+        }
         mos_bo_unreference((MOS_LINUX_BO *)(pOsResource->bo));
 
         if ( pOsInterface->pOsContext != nullptr && pOsInterface->pOsContext->contextOffsetList.size()) 
@@ -2575,6 +2617,15 @@ void  *Mos_Specific_LockResource(
     }
 
     pContext = pOsInterface->pOsContext;
+    if (pOsResource && pOsResource->bo && pOsResource->bPersistentMapped)
+    {
+        if (!pLockFlags->NoOverWrite)
+        {
+            mos_gem_bo_sync_persistent(pOsResource->bo);
+        }
+        return pOsResource->pData;
+    }
+
     if (pOsResource && pOsResource->bo && pOsResource->pGmmResInfo)
     {
         MOS_LINUX_BO *bo = pOsResource->bo;
@@ -2709,6 +2760,11 @@ MOS_STATUS Mos_Specific_UnlockResource(
 
     pContext = pOsInterface->pOsContext;
 
+    if(pOsResource->bo && pOsResource->bPersistentMapped)
+    {
+        goto finish;
+    }
+
     if(pOsResource->bo)
     {
         if(true == pOsResource->bMapped)
@@ -2857,6 +2913,45 @@ MOS_STATUS Mos_Specific_SetPatchEntry(
     return eStatus;
 }
 
+//!
+//! \brief    Set patch entries
+//! \details  Sets several patch entries in MS's patch list with one call,
+//!           typically all the relocations of one command
+//! \param    PMOS_INTERFACE pOsInterface
+//!           [in] Pointer to OS interface structure
+//! \param    PMOS_PATCH_ENTRY_PARAMS pParams
+//!           [in] Array of dwNumEntries patch entry params
+//! \param    uint32_t dwNumEntries
+//!           [in] Number of patch entries
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS Mos_Specific_SetPatchEntries(
+    PMOS_INTERFACE              pOsInterface,
+    PMOS_PATCH_ENTRY_PARAMS     pParams,
+    uint32_t                    dwNumEntries)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    MOS_OS_CHK_NULL_RETURN(pOsInterface);
+    MOS_OS_CHK_NULL_RETURN(pParams);
+
+    if (pOsInterface->modularizedGpuCtxEnabled && !Mos_Solo_IsEnabled())
+    {
+        auto gpuContext = Linux_GetGpuContext(pOsInterface, pOsInterface->CurrentGpuContextHandle);
+        MOS_OS_CHK_NULL_RETURN(gpuContext);
+
+        return (gpuContext->SetPatchEntries(pOsInterface, pParams, dwNumEntries));
+    }
+
+    for (uint32_t i = 0; i < dwNumEntries; i++)
+    {
+        MOS_OS_CHK_STATUS_RETURN(Mos_Specific_SetPatchEntry(pOsInterface, &pParams[i]));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
 //!
 //! \brief    Registers Resource
 //! \details  Set the Allocation Index in OS resource structure
@@ -6284,6 +6379,7 @@ MOS_STATUS Mos_Specific_InitInterface(
     pOsInterface->pfnGetIndirectState                       = Mos_Specific_GetIndirectState;
     pOsInterface->pfnGetIndirectStatePointer                = Mos_Specific_GetIndirectStatePointer;
     pOsInterface->pfnSetPatchEntry                          = Mos_Specific_SetPatchEntry;
+    pOsInterface->pfnSetPatchEntries                        = Mos_Specific_SetPatchEntries;
 
     pOsInterface->pfnSleepMs                                = Mos_Specific_SleepMs;
 
@@ -6414,6 +6510,13 @@ MOS_STATUS Mos_Specific_InitInterface(
         __MEDIA_USER_FEATURE_VALUE_NULL_HW_ACCELERATION_ENABLE_ID,
         &UserFeatureData));
     pOsInterface->NullHWAccelerationEnable.Value = UserFeatureData.u32Data;
+
+    MOS_ZeroMemory(&UserFeatureData, sizeof(UserFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __MEDIA_USER_FEATURE_VALUE_MOS_PERSISTENT_MAP_DISABLE_ID,
+        &UserFeatureData);
+    MosPersistentMapDisable = UserFeatureData.i32Data ? 1 : 0;
 #endif // (_DEBUG || _RELEASE_INTERNAL)
 
 #if MOS_MEDIASOLO_SUPPORTED
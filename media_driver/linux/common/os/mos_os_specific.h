@@ -250,6 +250,7 @@ struct _MOS_SPECIFIC_RESOURCE
     uint32_t            name;
     GMM_RESOURCE_INFO   *pGmmResInfo;        //!< GMM resource descriptor
     MOS_MMAP_OPERATION  MmapOperation;
+    bool                bPersistentMapped;  //!< mapped from allocation to free, see MOS_GFXRES_FLAGS::bPersistentMap
     uint8_t             *pSystemShadow;
     bool                bUsrPtrMode;        //!< indicate source info comes from app.
     MOS_PLANE_OFFSET    YPlaneOffset;       //!< Y surface plane offset
@@ -803,6 +804,14 @@ void Mos_Specific_SetResourceFormat(
     PMOS_RESOURCE               pOsResource,
     MOS_FORMAT                  mosFormat);
 
+//!
+//! \brief    Check if resources may be persistently mapped
+//! \details  Debug drivers can disable it through "MOS Persistent Map Disable"
+//! \return   bool
+//!           true if bPersistentMap allocations are mapped at allocation
+//!
+bool Mos_Specific_IsPersistentMapEnabled();
+
 //!
 //! \brief    Get SetMarker enabled flag
 //! \details  Get SetMarker enabled flag from OsInterface
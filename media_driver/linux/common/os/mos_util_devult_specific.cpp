@@ -28,3 +28,11 @@
 #include "mos_util_devult_specific.h"
 
 MOS_DATA_EXPORT void (*pfnUltGetCmdBuf)(PMOS_COMMAND_BUFFER pCmdBuffer) = nullptr;
+
+MOS_DATA_EXPORT void (*pfnUltGetAllocationList)(
+    PALLOCATION_LIST    pAllocationList,
+    uint32_t            uiNumAllocations,
+    uint32_t            uiMaxNumAllocations,
+    PPATCHLOCATIONLIST  pPatchLocationList,
+    uint32_t            uiNumPatchLocations,
+    uint32_t            uiMaxPatchLocations) = nullptr;
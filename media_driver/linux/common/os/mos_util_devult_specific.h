@@ -43,4 +43,14 @@ void MOS_DEVULT_FuncCall(_Fun fun, _Types&&... ags)
 
 MOS_EXPORT_DECL extern void (*pfnUltGetCmdBuf)(PMOS_COMMAND_BUFFER pCmdBuffer);
 
+// Allocation and patch lists of a submission, with their whole capacity so
+// that the ULT can check the entries past the used ones.
+MOS_EXPORT_DECL extern void (*pfnUltGetAllocationList)(
+    PALLOCATION_LIST    pAllocationList,
+    uint32_t            uiNumAllocations,
+    uint32_t            uiMaxNumAllocations,
+    PPATCHLOCATIONLIST  pPatchLocationList,
+    uint32_t            uiNumPatchLocations,
+    uint32_t            uiMaxPatchLocations);
+
 #endif // __MOS_UTIL_DEVULT_SPECIFIC_H__
@@ -149,6 +149,8 @@ MosUtilUserInterface  *utilUserInterface = nullptr;
 //! \brief mutex for mos utilities multi-threading protection
 //!
 MOS_MUTEX gMosUtilMutex = PTHREAD_MUTEX_INITIALIZER;
+MOS_MUTEX gMosMemPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+MOS_MUTEX gMosUltUserFeatureMutex = PTHREAD_MUTEX_INITIALIZER;
 
 static uint32_t uiMOSUtilInitCount = 0; // number count of mos utilities init
 
@@ -2236,7 +2238,7 @@ MOS_STATUS MOS_OS_Utilities_Init()
         // Initialize MOS message params structure and HLT
         MOS_MessageInit();
 #endif // MOS_MESSAGES_ENABLED
-        MosMemAllocCounter     = 0;
+        MOS_ResetMemAllocCounter();
         MosMemAllocFakeCounter = 0;
         MosMemAllocCounterGfx  = 0;
         MOS_TraceEventInit();
@@ -2260,9 +2262,8 @@ MOS_STATUS MOS_OS_Utilities_Close()
     if (uiMOSUtilInitCount == 0 )
     {
         MOS_TraceEventClose();
-        MosMemAllocCounter -= MosMemAllocFakeCounter;
-        MemoryCounter = MosMemAllocCounter + MosMemAllocCounterGfx;
-        MosMemAllocCounterNoUserFeature = MosMemAllocCounter;
+        MosMemAllocCounterNoUserFeature = MOS_GetMemAllocCounter() - MosMemAllocFakeCounter;
+        MemoryCounter = MosMemAllocCounterNoUserFeature + MosMemAllocCounterGfx;
         MosMemAllocCounterNoUserFeatureGfx = MosMemAllocCounterGfx;
         MOS_OS_VERBOSEMESSAGE("MemNinja leak detection end");
 
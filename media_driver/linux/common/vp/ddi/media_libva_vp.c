@@ -2318,6 +2318,17 @@ DdiVp_SetProcFilterDenoiseParams(
     pSrc->pDenoiseParams->bAutoDetect    = false;
     pSrc->pDenoiseParams->NoiseLevel     = NOISELEVEL_DEFAULT;
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+    // VA has no auto denoise, debug builds can still force the noise level detection
+    MOS_USER_FEATURE_VALUE_DATA UserFeatureData;
+    MOS_ZeroMemory(&UserFeatureData, sizeof(UserFeatureData));
+    MOS_UserFeature_ReadValue_ID(
+        nullptr,
+        __VPHAL_VEBOX_FORCE_AUTO_DENOISE_ID,
+        &UserFeatureData);
+    pSrc->pDenoiseParams->bAutoDetect    = UserFeatureData.bData ? true : false;
+#endif //(_DEBUG || _RELEASE_INTERNAL)
+
     return VA_STATUS_SUCCESS;
 }
 
@@ -2750,7 +2761,7 @@ VAStatus DdiVp_CreateBuffer(
     }
 
     // allocate new buf and init
-    pBuf               = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_BUFFER));
+    pBuf               = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroPooledMemory(sizeof(DDI_MEDIA_BUFFER));
     DDI_CHK_NULL(pBuf, "Null pBuf.", VA_STATUS_ERROR_ALLOCATION_FAILED);
     pBuf->pMediaCtx     = pMediaCtx;
     pBuf->iSize         = uiSize * uiNumElements;
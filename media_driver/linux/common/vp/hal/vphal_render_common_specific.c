@@ -27,6 +27,12 @@
 #include "vphal.h"
 #include "mos_os.h"
 
+//!
+//! \brief    Lock of the process wide HDR 3D LUT cache
+//! \details  Statically initialized so that it neither depends on nor outlives MOS
+//!
+MOS_MUTEX gVpHalHdr3DLutCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
 //!
 //! \brief    Determine if the Batch Buffer End is needed to add in the end
 //! \details  Detect platform OS and return the flag whether the Batch Buffer End is needed to add in the end
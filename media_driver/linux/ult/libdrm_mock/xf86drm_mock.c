@@ -177,10 +177,28 @@ drmIoctl(int fd, unsigned long request, void *arg)
 }
 #else
 #include "devconfig.h"
+
+// Number of calls of each ioctl, indexed by the ioctl number, read by the ULT
+// to count the map and wait ioctls issued per frame.
+static uint32_t mosdrmIoctlCount[256];
+
+void mosdrmCountIoctl(unsigned long request)
+{
+    __atomic_add_fetch(&mosdrmIoctlCount[DRM_IOCTL_NR(request) & 0xff], 1, __ATOMIC_RELAXED);
+}
+
+extern "C" drm_export uint32_t
+mos_mock_get_ioctl_count(unsigned long request)
+{
+    return __atomic_load_n(&mosdrmIoctlCount[DRM_IOCTL_NR(request) & 0xff], __ATOMIC_RELAXED);
+}
+
 int
 mosdrmIoctl(int fd, unsigned long request, void *arg)
 {
     int    ret;
+
+    mosdrmCountIoctl(request);
 #if 1
     int DevIdx=fd-1;//use fd to get DevIdx
     switch (request)
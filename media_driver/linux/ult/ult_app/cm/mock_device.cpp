@@ -26,6 +26,7 @@
 //!
 
 #include "mock_device.h"
+#include "cm_wrapper.h"
 
 namespace CMRT_UMD
 {
@@ -52,6 +53,20 @@ int32_t MockDevice::SendRequestMessage(InputData *input, uint32_t function_id)
                                    &output_size);
 }//==============================================
 
+template<class InputData>
+int32_t MockDevice::SendRequestMessage(InputData *input, uint32_t function_id,
+                                       CmDevice *device)
+{
+    uint32_t va_module_id = 2;  // VAExtModuleCMRT.
+    uint32_t input_size = sizeof(InputData);
+    uint32_t output_size = sizeof(device);
+    // The device handle is passed as the output data.
+    return this->vaCmExtSendReqMsg(&m_vaDisplay, &va_module_id,
+                                   &function_id, input,
+                                   &input_size, nullptr, device,
+                                   &output_size);
+}//==============================================
+
 bool MockDevice::Create(DriverDllLoader *driver_loader,
                         uint32_t additinal_options)
 {
@@ -108,4 +123,15 @@ int32_t MockDevice::ReleaseNewDevice(CmDevice *device)
     SendRequestMessage(&destroy_param, function_id);
     return destroy_param.return_value;
 }//===================================
+
+int32_t MockDevice::InitPrintBuffer(size_t size,
+                                    unsigned char *&print_buffer_mem)
+{
+    InitPrintBufferParam init_param;
+    init_param.print_buffer_size = static_cast<uint32_t>(size);
+    uint32_t function_id = CM_FN_CMDEVICE_INIT_PRINT_BUFFER;
+    SendRequestMessage(&init_param, function_id, m_cmDevice);
+    print_buffer_mem = static_cast<unsigned char*>(init_param.print_buffer_mem);
+    return init_param.return_value;
+}//=================================
 }  // namespace
@@ -60,6 +60,17 @@ struct CreateDeviceParam
     int32_t return_value;
 };//=====================
 
+struct InitPrintBufferParam
+{
+    InitPrintBufferParam(): print_buffer_size(0),
+                            print_buffer_mem(nullptr),
+                            return_value(0) {}
+
+    uint32_t print_buffer_size;
+    void *print_buffer_mem;
+    int32_t return_value;
+};//========================
+
 struct DestroyDeviceParam
 {
     DestroyDeviceParam(): device_in_umd(nullptr),
@@ -100,9 +111,17 @@ public:
 
     int32_t ReleaseNewDevice(CmDevice *device);
 
+    //! Creates the print buffer as the thin layer does, which gets the print
+    //! buffer memory written by the kernels.
+    int32_t InitPrintBuffer(size_t size, unsigned char *&print_buffer_mem);
+
 private:
     template<class InputData>
     int32_t SendRequestMessage(InputData *input, uint32_t function_id);
+
+    template<class InputData>
+    int32_t SendRequestMessage(InputData *input, uint32_t function_id,
+                               CmDevice *device);
     
     VADisplayContext m_vaDisplay;
     CmExtSendReqMsgFunc vaCmExtSendReqMsg;
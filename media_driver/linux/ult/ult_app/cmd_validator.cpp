@@ -19,6 +19,7 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include <algorithm>
 #include "cmd_validator.h"
 
 using namespace std;
@@ -29,6 +30,18 @@ void UltGetCmdBuf(PMOS_COMMAND_BUFFER pCmdBuffer)
     cmdValidator->Validate(pCmdBuffer);
 }
 
+void UltGetAllocationList(
+    PALLOCATION_LIST    pAllocationList,
+    uint32_t            uiNumAllocations,
+    uint32_t            uiMaxNumAllocations,
+    PPATCHLOCATIONLIST  pPatchLocationList,
+    uint32_t            uiNumPatchLocations,
+    uint32_t            uiMaxPatchLocations)
+{
+    auto cmdValidator = CmdValidator::GetInstance();
+    cmdValidator->RecordPatchList(pAllocationList, uiNumAllocations, pPatchLocationList, uiNumPatchLocations);
+}
+
 CmdValidator *CmdValidator::m_instance = nullptr;
 
 CmdValidator *CmdValidator::GetInstance()
@@ -48,8 +61,31 @@ void CmdValidator::GpuCmdsValidationInit(const GpuCmdFactory *cmdFactory, Platfo
     cmdValidator->CreateGpuCmds(cmdFactory, platform);
 }
 
-void CmdValidator::Validate(const PMOS_COMMAND_BUFFER pCmdBuffer) const
+void CmdValidator::Validate(const PMOS_COMMAND_BUFFER pCmdBuffer)
 {
+    if (m_capture)
+    {
+        // The addresses of the bos differ between runs, only their patch
+        // locations are compared. The mock bos are below 4GB, so only the
+        // low dword of an address is cleared.
+        m_cmdBufs.emplace_back(pCmdBuffer->pCmdBase, pCmdBuffer->pCmdPtr);
+        vector<uint32_t> &cmdBuf = m_cmdBufs.back();
+        if (m_captureDynamicState)
+        {
+            m_dynamicStates.push_back(GetDynamicState(cmdBuf));
+        }
+        for (const auto &patch : m_pendingPatches)
+        {
+            if (patch.patchOffset / sizeof(uint32_t) < cmdBuf.size())
+            {
+                cmdBuf[patch.patchOffset / sizeof(uint32_t)] = 0;
+            }
+        }
+        m_patches.push_back(move(m_pendingPatches));
+        m_pendingPatches.clear();
+        m_pendingBos.clear();
+    }
+
     for (auto p = pCmdBuffer->pCmdBase; p != pCmdBuffer->pCmdPtr; p++)
     {
         for (const auto &e : m_gpuCmds)
@@ -61,3 +97,113 @@ void CmdValidator::Validate(const PMOS_COMMAND_BUFFER pCmdBuffer) const
         }
     }
 }
+
+void CmdValidator::RecordPatchList(
+    PALLOCATION_LIST    pAllocationList,
+    uint32_t            uiNumAllocations,
+    PPATCHLOCATIONLIST  pPatchLocationList,
+    uint32_t            uiNumPatchLocations)
+{
+    if (!m_capture)
+    {
+        return;
+    }
+
+    vector<MOS_LINUX_BO *> &bos = m_pendingBos;
+    bos.clear();
+    m_pendingPatches.clear();
+    for (uint32_t i = 0; i < uiNumPatchLocations; i++)
+    {
+        const PATCHLOCATIONLIST &location = pPatchLocationList[i];
+        CapturedPatch           patch     = {location.PatchOffset, location.AllocationOffset, UINT32_MAX, location.uiWriteOperation};
+        if (location.AllocationIndex < uiNumAllocations)
+        {
+            PMOS_RESOURCE resource = (PMOS_RESOURCE)pAllocationList[location.AllocationIndex].hAllocation;
+            MOS_LINUX_BO *bo       = resource ? resource->bo : nullptr;
+            auto          it       = find(bos.begin(), bos.end(), bo);
+            patch.bo = (uint32_t)(it - bos.begin());
+            if (it == bos.end())
+            {
+                bos.push_back(bo);
+            }
+
+            // The mock bos are always mapped
+            if (m_targetDwords && bo && bo->virt &&
+                location.AllocationOffset + m_targetDwords * sizeof(uint32_t) <= bo->size)
+            {
+                const uint32_t *target = (const uint32_t *)((uint8_t *)bo->virt + location.AllocationOffset);
+                patch.target.assign(target, target + m_targetDwords);
+            }
+        }
+        m_pendingPatches.push_back(patch);
+    }
+}
+
+vector<uint32_t> CmdValidator::GetCmdOffsets(const vector<uint32_t> &cmdBuf)
+{
+    vector<uint32_t> offsets;
+    for (uint32_t i = 0; i < cmdBuf.size(); )
+    {
+        offsets.push_back(i);
+
+        // The DW0 length is the command size in dwords minus 2. MI commands
+        // below opcode 0x10 and the single dword GFXPIPE commands have none,
+        // the media, MFX, HCP and VEBOX commands use a 16 bit length.
+        uint32_t header  = cmdBuf[i];
+        uint32_t type    = header >> 29;
+        uint32_t subType = (header >> 27) & 0x3;
+        uint32_t size    = 1;
+        if (type == 0)
+        {
+            size = (((header >> 23) & 0x3f) < 0x10) ? 1 : (header & 0xff) + 2;
+        }
+        else if (type == 2)
+        {
+            size = (header & 0xff) + 2;
+        }
+        else if (type == 3)
+        {
+            if (subType == 1)
+            {
+                size = 1;
+            }
+            else
+            {
+                size = (header & ((subType == 2) ? 0xffff : 0xff)) + 2;
+            }
+        }
+        i += size;
+    }
+    return offsets;
+}
+
+vector<uint32_t> CmdValidator::GetDynamicState(const vector<uint32_t> &cmdBuf) const
+{
+    // Gen8+ STATE_BASE_ADDRESS: the dynamic state base address is patched in
+    // DW6, DW13 holds the dynamic state buffer size in pages
+    const uint32_t sbaHeader = 0x61010000;
+    for (auto offset : GetCmdOffsets(cmdBuf))
+    {
+        if ((cmdBuf[offset] & 0xffff0000) != sbaHeader || offset + 13 >= cmdBuf.size())
+        {
+            continue;
+        }
+
+        uint32_t size = cmdBuf[offset + 13] & 0xfffff000;
+        for (const auto &patch : m_pendingPatches)
+        {
+            if (patch.patchOffset != (offset + 6) * sizeof(uint32_t) || patch.bo >= m_pendingBos.size())
+            {
+                continue;
+            }
+            MOS_LINUX_BO *bo = m_pendingBos[patch.bo];
+            if (bo && bo->virt && patch.allocationOffset + size <= bo->size)
+            {
+                const uint32_t *heap = (const uint32_t *)((uint8_t *)bo->virt + patch.allocationOffset);
+                return vector<uint32_t>(heap, heap + size / sizeof(uint32_t));
+            }
+        }
+        break;
+    }
+    return vector<uint32_t>();
+}
@@ -48,13 +48,92 @@ public:
         m_gpuCmds.clear();
     }
 
-    void Validate(const PMOS_COMMAND_BUFFER pCmdBuffer) const;
+    void Validate(const PMOS_COMMAND_BUFFER pCmdBuffer);
+
+    //! \brief   Patch location of a captured command buffer
+    //! \details The bos of a command buffer are numbered in the order of their
+    //!          first patch location, so that the patch lists of command buffers
+    //!          built with different bos can be compared.
+    struct CapturedPatch
+    {
+        uint32_t patchOffset;
+        uint32_t allocationOffset;
+        uint32_t bo;
+        uint32_t write;
+        std::vector<uint32_t> target;   // Dwords at the patched address when submitted, not compared
+
+        bool operator==(const CapturedPatch &other) const
+        {
+            return patchOffset == other.patchOffset && allocationOffset == other.allocationOffset &&
+                bo == other.bo && write == other.write;
+        }
+    };
+
+    // Keep a copy of the command buffers validated until StopCapture. The
+    // patched addresses are cleared in the copies, the patch lists are kept
+    // apart and returned by GetCapturedPatches. With targetDwords, the states
+    // the patched addresses point to are copied too, from the bos mapped by
+    // the driver when the command buffer is submitted. With dynamicState, the
+    // dynamic state heap of each command buffer is copied, see
+    // GetCapturedDynamicStates.
+    void StartCapture(uint32_t targetDwords = 0, bool dynamicState = false)
+    {
+        m_cmdBufs.clear();
+        m_patches.clear();
+        m_pendingPatches.clear();
+        m_pendingBos.clear();
+        m_dynamicStates.clear();
+        m_targetDwords = targetDwords;
+        m_captureDynamicState = dynamicState;
+        m_capture = true;
+    }
+
+    // Record the patch list of the command buffer submitted next
+    void RecordPatchList(
+        PALLOCATION_LIST    pAllocationList,
+        uint32_t            uiNumAllocations,
+        PPATCHLOCATIONLIST  pPatchLocationList,
+        uint32_t            uiNumPatchLocations);
+
+    // Patch lists of the command buffers captured by the last StartCapture
+    const std::vector<std::vector<CapturedPatch>> &GetCapturedPatches() const
+    {
+        return m_patches;
+    }
+
+    // Dynamic state heap of the first STATE_BASE_ADDRESS of each command buffer
+    // captured, empty if the command buffer has none
+    const std::vector<std::vector<uint32_t>> &GetCapturedDynamicStates() const
+    {
+        return m_dynamicStates;
+    }
+
+    std::vector<std::vector<uint32_t>> StopCapture()
+    {
+        m_capture = false;
+        return std::move(m_cmdBufs);
+    }
+
+    // Dword offsets of the commands of a command buffer, following the length
+    // of each MI, render and media command from the first dword on
+    static std::vector<uint32_t> GetCmdOffsets(const std::vector<uint32_t> &cmdBuf);
 
 private:
 
+    std::vector<uint32_t> GetDynamicState(const std::vector<uint32_t> &cmdBuf) const;
+
     static CmdValidator *m_instance;
 
     std::vector<pcmditf_t> m_gpuCmds;
+
+    bool                                    m_capture = false;
+    bool                                    m_captureDynamicState = false;
+    uint32_t                                m_targetDwords = 0;
+    std::vector<std::vector<uint32_t>>      m_cmdBufs;
+    std::vector<std::vector<CapturedPatch>> m_patches;
+    std::vector<std::vector<uint32_t>>      m_dynamicStates;
+    std::vector<CapturedPatch>              m_pendingPatches;
+    std::vector<MOS_LINUX_BO *>             m_pendingBos;       // Bos of the pending patches, by their number
 };
 
 #endif // __CMD_VALIDATOR_H__
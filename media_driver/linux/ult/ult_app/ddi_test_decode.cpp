@@ -19,10 +19,109 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include <algorithm>
+#include <chrono>
+#include <set>
 #include "ddi_test_decode.h"
+#include "ioctl_counter.h"
+#include "va_capture_replay.h"
+#include "mhw_vdbox_mfx_hwcmd_g9_bxt.h"
+#include "mhw_vdbox_mfx_hwcmd_g9_skl.h"
 
 using namespace std;
 
+// Submissions seen by CheckAllocationList, and those with stale or invalid entries
+static uint32_t g_allocListSubmissions = 0;
+static uint32_t g_allocListErrors      = 0;
+
+// The used allocations must be distinct registered resources and the patch
+// locations must refer to them. Entries past the used ones must be clear, so
+// that nothing registered for a previous submission is seen.
+static void CheckAllocationList(
+    PALLOCATION_LIST    pAllocationList,
+    uint32_t            uiNumAllocations,
+    uint32_t            uiMaxNumAllocations,
+    PPATCHLOCATIONLIST  pPatchLocationList,
+    uint32_t            uiNumPatchLocations,
+    uint32_t            uiMaxPatchLocations)
+{
+    static const ALLOCATION_LIST   clearAllocation = {};
+    static const PATCHLOCATIONLIST clearPatch      = {};
+    set<void *>                    bos;
+    bool                           valid = uiNumAllocations <= uiMaxNumAllocations &&
+                                           uiNumPatchLocations <= uiMaxPatchLocations;
+
+    for (uint32_t i = 0; valid && i < uiMaxNumAllocations; i++)
+    {
+        PMOS_RESOURCE resource = (PMOS_RESOURCE)pAllocationList[i].hAllocation;
+        if (i >= uiNumAllocations)
+        {
+            valid = memcmp(&pAllocationList[i], &clearAllocation, sizeof(clearAllocation)) == 0;
+        }
+        else
+        {
+            valid = resource != nullptr && bos.insert(resource->bo).second;
+        }
+    }
+
+    for (uint32_t i = 0; valid && i < uiMaxPatchLocations; i++)
+    {
+        if (i >= uiNumPatchLocations)
+        {
+            valid = memcmp(&pPatchLocationList[i], &clearPatch, sizeof(clearPatch)) == 0;
+        }
+        else
+        {
+            valid = pPatchLocationList[i].AllocationIndex < uiNumAllocations;
+        }
+    }
+
+    g_allocListSubmissions++;
+    g_allocListErrors += valid ? 0 : 1;
+}
+
+// Values expected at the patch locations of each submission seen by
+// RecordPatchLocations, and the submissions with invalid patch lists
+static vector<vector<pair<uint32_t, uint64_t>>> g_patchValues;
+static uint32_t                                 g_patchListErrors = 0;
+
+// Every patch location must be patched once, with the GPU address of the bo
+// of its allocation. The mock gives each bo a distinct address.
+static void RecordPatchLocations(
+    PALLOCATION_LIST    pAllocationList,
+    uint32_t            uiNumAllocations,
+    uint32_t            uiMaxNumAllocations,
+    PPATCHLOCATIONLIST  pPatchLocationList,
+    uint32_t            uiNumPatchLocations,
+    uint32_t            uiMaxPatchLocations)
+{
+    vector<pair<uint32_t, uint64_t>> values;
+    set<uint32_t>                    patchOffsets;
+    set<uint64_t>                    boOffsets;
+    bool                             valid = true;
+
+    for (uint32_t i = 0; valid && i < uiNumAllocations; i++)
+    {
+        PMOS_RESOURCE resource = (PMOS_RESOURCE)pAllocationList[i].hAllocation;
+        valid = resource != nullptr && resource->bo != nullptr &&
+                boOffsets.insert(resource->bo->offset64).second;
+    }
+
+    for (uint32_t i = 0; valid && i < uiNumPatchLocations; i++)
+    {
+        const PATCHLOCATIONLIST &patch = pPatchLocationList[i];
+        valid = patch.AllocationIndex < uiNumAllocations && patchOffsets.insert(patch.PatchOffset).second;
+        if (valid)
+        {
+            PMOS_RESOURCE resource = (PMOS_RESOURCE)pAllocationList[patch.AllocationIndex].hAllocation;
+            values.emplace_back(patch.PatchOffset, resource->bo->offset64 + patch.AllocationOffset);
+        }
+    }
+
+    g_patchValues.push_back(move(values));
+    g_patchListErrors += valid ? 0 : 1;
+}
+
 TEST_F(MediaDecodeDdiTest, DecodeHEVCLong)
 {
     m_GpuCmdFactory = g_gpuCmdFactoryDecodeHEVCLong;
@@ -39,6 +138,445 @@ TEST_F(MediaDecodeDdiTest, DecodeAVCLong)
     delete pDecData;
 }
 
+TEST_F(MediaDecodeDdiTest, DecodeHEVCLong_CaptureReplay)
+{
+    // The VA calls of the decode are captured, then replayed on a new driver instance.
+    const char *captureFile = "./va_capture_decode_hevc.bin";
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeHEVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("HEVC-Long");
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platforms[i]], pDecData->GetFeatureID()))
+        {
+            CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
+            m_driverLoader.SetUserFeature("VA Capture File", captureFile);
+            DecodeExecute(pDecData, platforms[i]);
+            m_driverLoader.SetUserFeature("VA Capture File", nullptr);
+            if (!m_driverLoader.IsUserFeatureApplied())
+            {
+                // Release drivers only capture to the file of the user feature file
+                break;
+            }
+            VaCaptureReplayer::ReplayTest(m_driverLoader, m_GpuCmdFactory, captureFile, platforms[i]);
+        }
+    }
+    delete pDecData;
+}
+
+TEST_F(MediaDecodeDdiTest, DecodeHEVCLong_InPlaceCmds)
+{
+    // The MHW commands are built in place in the command buffer. A debug driver can
+    // build them out of it and copy them as before, both must submit the same bytes.
+    // Command buffers are not mapped write combined, so by default the commands
+    // must be built in place.
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeHEVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("HEVC-Long");
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (!m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platforms[i]], pDecData->GetFeatureID()))
+        {
+            continue;
+        }
+        if (!CompareDecodeVariants(pDecData, platforms[i], 2,
+                [&](int copyCmdPath) { m_driverLoader.SetUserFeature("MOS Copy Command Path", copyCmdPath ? "1" : "0"); },
+                [&]() { return m_driverLoader.IsUserFeatureApplied(); }))
+        {
+            // Release drivers always build in place
+            break;
+        }
+        EXPECT_EQ(0, m_driverLoader.GetUltCounter(MOS_ULT_COUNTER_CMDS_BUILT_IN_PLACE)) << "Platform = "
+            << g_platformName[platforms[i]] << ", commands built in place with the copy path" << endl;
+
+        m_driverLoader.SetUserFeature("MOS Copy Command Path", nullptr);
+        DecodeExecute(pDecData, platforms[i]);
+        EXPECT_LT(0, m_driverLoader.GetUltCounter(MOS_ULT_COUNTER_CMDS_BUILT_IN_PLACE)) << "Platform = "
+            << g_platformName[platforms[i]] << ", no command was built in place" << endl;
+    }
+    m_driverLoader.SetUserFeature("MOS Copy Command Path", nullptr);
+    delete pDecData;
+}
+
+TEST_F(MediaDecodeDdiTest, DecodeHEVCLong_PicTemplate)
+{
+    // The HEVC picture level commands are recorded once and replayed while their
+    // parameters do not change. The stream is decoded several times in the same
+    // context, so pictures are replayed, and the submitted bytes and patch lists
+    // must be the same as when every command is built.
+    const char *picTemplateEnable = "HEVC Decode Picture Template Enable";
+    const int   repeat            = 10;
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeHEVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("HEVC-Long");
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platforms[i]], pDecData->GetFeatureID()) &&
+            !CompareDecodeVariants(pDecData, platforms[i], 2,
+                [&](int disable) { m_driverLoader.SetUserFeature(picTemplateEnable, disable ? "0" : "1"); },
+                [&]() { return m_driverLoader.IsUserFeatureApplied(); }, repeat))
+        {
+            // Release drivers don't take user features from the ULT
+            break;
+        }
+    }
+    m_driverLoader.SetUserFeature(picTemplateEnable, nullptr);
+    delete pDecData;
+}
+
+// A command buffer starting the cached prolog must be the one building it,
+// with the prolog commands replaced by MI_BATCH_BUFFER_START. The batch
+// contents are the commands copied inline by CODECHAL_PROLOG_CACHE_COPY.
+static bool MatchesChainedProlog(const vector<uint32_t> &chained, const vector<uint32_t> &built)
+{
+    const size_t   batchStartSize   = 3;        // Header and 64 bit address
+    const uint32_t batchStartOpcode = 0x31;     // MI_BATCH_BUFFER_START, bits 28:23 of an MI command
+
+    if (chained == built)
+    {
+        // Nothing is cached when the invariant commands are empty
+        return true;
+    }
+
+    size_t common = min(chained.size(), built.size());
+    size_t prefix = mismatch(chained.begin(), chained.begin() + common, built.begin()).first - chained.begin();
+    if (prefix + batchStartSize > chained.size() || chained.size() > built.size() + batchStartSize ||
+        (chained[prefix] >> 29) != 0 || ((chained[prefix] >> 23) & 0x3F) != batchStartOpcode)
+    {
+        return false;
+    }
+
+    size_t suffix = chained.size() - prefix - batchStartSize;
+    return suffix + prefix <= built.size() && equal(chained.end() - suffix, chained.end(), built.end() - suffix);
+}
+
+TEST_F(MediaDecodeDdiTest, DecodeAVCLong_PrologCache)
+{
+    // The invariant prolog of each GPU context is built once into a batch buffer
+    // started from every command buffer. A debug driver can copy the cached
+    // commands instead, or build them in every command buffer. The copied
+    // prolog must submit the same bytes as the built one, and the chained one
+    // the same bytes but for the batch start replacing the prolog.
+    const int repeat = 10;
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeAVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("AVC-Long");
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platforms[i]], pDecData->GetFeatureID()))
+        {
+            vector<vector<uint32_t>> cmdBufs[3];
+
+            CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
+            for (uint8_t mode = 0; mode < 3; mode++)
+            {
+                m_driverLoader.SetUserFeature("Codec Prolog Cache Mode", std::to_string(mode).c_str());
+                cmdValidator->StartCapture();
+                DecodeExecute(pDecData, platforms[i], nullptr, repeat);
+                cmdBufs[mode] = cmdValidator->StopCapture();
+            }
+            m_driverLoader.SetUserFeature("Codec Prolog Cache Mode", nullptr);
+
+            if (!m_driverLoader.IsUserFeatureApplied())
+            {
+                // Release drivers always chain the prolog, the three runs took the same path
+                break;
+            }
+
+            ASSERT_EQ(cmdBufs[0].size(), cmdBufs[2].size()) << "Platform = " << g_platformName[platforms[i]];
+            ASSERT_EQ(cmdBufs[1].size(), cmdBufs[2].size()) << "Platform = " << g_platformName[platforms[i]];
+            for (size_t j = 0; j < cmdBufs[2].size(); j++)
+            {
+                EXPECT_TRUE(cmdBufs[1][j] == cmdBufs[2][j]) << "Platform = " << g_platformName[platforms[i]]
+                    << ", command buffer " << j << " with the copied prolog differs from the built one" << endl;
+                EXPECT_TRUE(MatchesChainedProlog(cmdBufs[0][j], cmdBufs[2][j])) << "Platform = " << g_platformName[platforms[i]]
+                    << ", command buffer " << j << " with the chained prolog differs from the built one" << endl;
+            }
+        }
+    }
+    delete pDecData;
+}
+
+// Headers of the fixed size MFX commands of a JPEG decode picture.
+template<typename TMfxCmds>
+static set<uint32_t> GetJpegDecodeCmdHeaders()
+{
+    return {
+        typename TMfxCmds::MFX_PIPE_MODE_SELECT_CMD().DW0.Value,
+        typename TMfxCmds::MFX_SURFACE_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFX_PIPE_BUF_ADDR_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFX_IND_OBJ_BASE_ADDR_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFX_JPEG_PIC_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFX_QM_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFX_JPEG_HUFF_TABLE_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFD_JPEG_BSD_OBJECT_CMD().DW0.Value };
+}
+
+// MFX command headers of a command buffer in their order.
+static vector<uint32_t> GetJpegDecodeCmdSequence(const vector<uint32_t> &cmdBuf, Platform_t platform)
+{
+    static const set<uint32_t> headersSkl = GetJpegDecodeCmdHeaders<mhw_vdbox_mfx_g9_skl>();
+    static const set<uint32_t> headersBxt = GetJpegDecodeCmdHeaders<mhw_vdbox_mfx_g9_bxt>();
+    const set<uint32_t> &headers = (platform == igfxBROXTON) ? headersBxt : headersSkl;
+
+    vector<uint32_t> sequence;
+    for (auto dw : cmdBuf)
+    {
+        if (headers.count(dw))
+        {
+            sequence.push_back(dw);
+        }
+    }
+    return sequence;
+}
+
+// Dwords of the commands starting with header in a command buffer, in their order.
+static vector<uint32_t> GetJpegDecodeCmds(const vector<uint32_t> &cmdBuf, uint32_t header)
+{
+    vector<uint32_t> cmds;
+    for (size_t j = 0; j < cmdBuf.size(); j++)
+    {
+        if (cmdBuf[j] != header)
+        {
+            continue;
+        }
+        // DW0 holds the command length in dwords minus 2.
+        size_t end = min(cmdBuf.size(), j + (header & 0xfff) + 2);
+        cmds.insert(cmds.end(), cmdBuf.begin() + j, cmdBuf.begin() + end);
+    }
+    return cmds;
+}
+
+TEST_F(MediaDecodeDdiTest, DecodeJPEG_Batch)
+{
+    // The images of the stream have different resolutions and chroma formats.
+    // They are decoded one per frame, then all of them in each frame, back to
+    // back in one command buffer. That command buffer must hold the MFX commands
+    // of each image in the same order as when the image is decoded on its own,
+    // with the same picture and surface states, and each target must be ready.
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("JPEG");
+    DecTestData *pBatchData = m_decDataFactory.GetDecTestData("JPEG-Batch");
+    uint32_t imageNum = static_cast<DecTestDataJPEG *>(pBatchData)->GetImageNum();
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platforms[i]], pDecData->GetFeatureID()))
+        {
+            CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+            cmdValidator->StartCapture();
+            DecodeExecute(pDecData, platforms[i]);
+            vector<vector<uint32_t>> cmdBufs = cmdValidator->StopCapture();
+
+            cmdValidator->StartCapture();
+            DecodeExecute(pBatchData, platforms[i]);
+            vector<vector<uint32_t>> batchCmdBufs = cmdValidator->StopCapture();
+
+            bool bxt = (platforms[i] == igfxBROXTON);
+            uint32_t picStateHeader = bxt ? mhw_vdbox_mfx_g9_bxt::MFX_JPEG_PIC_STATE_CMD().DW0.Value :
+                                            mhw_vdbox_mfx_g9_skl::MFX_JPEG_PIC_STATE_CMD().DW0.Value;
+            uint32_t surfaceStateHeader = bxt ? mhw_vdbox_mfx_g9_bxt::MFX_SURFACE_STATE_CMD().DW0.Value :
+                                                mhw_vdbox_mfx_g9_skl::MFX_SURFACE_STATE_CMD().DW0.Value;
+
+            // Command buffers without MFX commands only store the decode status.
+            vector<uint32_t> expected;
+            vector<uint32_t> expectedPicStates;
+            vector<uint32_t> expectedSurfaceStates;
+            uint32_t decodeCmdBufNum = 0;
+            for (auto &cmdBuf : cmdBufs)
+            {
+                vector<uint32_t> sequence = GetJpegDecodeCmdSequence(cmdBuf, platforms[i]);
+                if (!sequence.empty())
+                {
+                    vector<uint32_t> picStates = GetJpegDecodeCmds(cmdBuf, picStateHeader);
+                    vector<uint32_t> surfaceStates = GetJpegDecodeCmds(cmdBuf, surfaceStateHeader);
+                    expected.insert(expected.end(), sequence.begin(), sequence.end());
+                    expectedPicStates.insert(expectedPicStates.end(), picStates.begin(), picStates.end());
+                    expectedSurfaceStates.insert(expectedSurfaceStates.end(), surfaceStates.begin(), surfaceStates.end());
+                    decodeCmdBufNum++;
+                }
+            }
+            ASSERT_EQ(imageNum, decodeCmdBufNum) << "Platform = " << g_platformName[platforms[i]];
+
+            int batchCmdBufNum = 0;
+            for (auto &cmdBuf : batchCmdBufs)
+            {
+                vector<uint32_t> sequence = GetJpegDecodeCmdSequence(cmdBuf, platforms[i]);
+                if (sequence.empty())
+                {
+                    continue;
+                }
+                batchCmdBufNum++;
+                EXPECT_TRUE(sequence == expected) << "Platform = " << g_platformName[platforms[i]]
+                    << ", command buffer " << batchCmdBufNum << " does not hold the MFX commands of "
+                    << imageNum << " images" << endl;
+                EXPECT_TRUE(GetJpegDecodeCmds(cmdBuf, picStateHeader) == expectedPicStates)
+                    << "Platform = " << g_platformName[platforms[i]] << ", command buffer " << batchCmdBufNum
+                    << " does not hold the picture states of the " << imageNum << " images" << endl;
+                EXPECT_TRUE(GetJpegDecodeCmds(cmdBuf, surfaceStateHeader) == expectedSurfaceStates)
+                    << "Platform = " << g_platformName[platforms[i]] << ", command buffer " << batchCmdBufNum
+                    << " does not hold the surface states of the " << imageNum << " images" << endl;
+            }
+            EXPECT_EQ(pBatchData->m_num_frames, batchCmdBufNum) << "Platform = " << g_platformName[platforms[i]];
+        }
+    }
+    delete pDecData;
+    delete pBatchData;
+}
+
+TEST_F(MediaDecodeDdiTest, DecodeHEVCLong_AllocationListReset)
+{
+    // The allocation and patch lists are reset by clearing their used entries,
+    // and the resource registry by starting a new generation. The stream is
+    // decoded several times in the same context, and the lists of every
+    // submission are checked for entries left by a previous one.
+    const int repeat = 10;
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeHEVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("HEVC-Long");
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platforms[i]], pDecData->GetFeatureID()))
+        {
+            g_allocListSubmissions = 0;
+            g_allocListErrors      = 0;
+
+            CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
+            m_driverLoader.SetAllocationListHook(CheckAllocationList);
+            DecodeExecute(pDecData, platforms[i], nullptr, repeat);
+            m_driverLoader.SetAllocationListHook(nullptr);
+
+            EXPECT_GE(g_allocListSubmissions, (uint32_t)repeat * pDecData->m_num_frames)
+                << "Platform = " << g_platformName[platforms[i]];
+            EXPECT_EQ(0u, g_allocListErrors) << "Platform = " << g_platformName[platforms[i]]
+                << ", submissions with stale allocation or patch list entries" << endl;
+        }
+    }
+    delete pDecData;
+}
+
+TEST_F(MediaDecodeDdiTest, DecodeAVCLong_PatchLocations)
+{
+    // The patch entries are batched per command and their bos are resolved
+    // once per submission through the resource registry, which is kept across
+    // submissions. The stream is decoded several times in the same context and
+    // every patched address of every submitted command buffer is checked.
+    const int repeat = 4;
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeAVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("AVC-Long");
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platforms[i]], pDecData->GetFeatureID()))
+        {
+            g_patchValues.clear();
+            g_patchListErrors = 0;
+
+            CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
+            m_driverLoader.SetAllocationListHook(RecordPatchLocations);
+            cmdValidator->StartCapture();
+            DecodeExecute(pDecData, platforms[i], nullptr, repeat);
+            vector<vector<uint32_t>> cmdBufs = cmdValidator->StopCapture();
+            m_driverLoader.SetAllocationListHook(nullptr);
+
+            EXPECT_EQ(0u, g_patchListErrors) << "Platform = " << g_platformName[platforms[i]]
+                << ", submissions with duplicated patch locations or unresolved allocations" << endl;
+            ASSERT_EQ(g_patchValues.size(), cmdBufs.size()) << "Platform = " << g_platformName[platforms[i]];
+            EXPECT_GE(cmdBufs.size(), (size_t)repeat * pDecData->m_num_frames)
+                << "Platform = " << g_platformName[platforms[i]];
+
+            for (size_t j = 0; j < cmdBufs.size(); j++)
+            {
+                uint32_t mismatches = 0;
+                for (const auto &value : g_patchValues[j])
+                {
+                    // The low dword is written by both the 32 and 64 bit relocations
+                    uint32_t dw = value.first / sizeof(uint32_t);
+                    if (value.first % sizeof(uint32_t) != 0 || dw >= cmdBufs[j].size() ||
+                        cmdBufs[j][dw] != (uint32_t)value.second)
+                    {
+                        mismatches++;
+                    }
+                }
+                EXPECT_EQ(0u, mismatches) << "Platform = " << g_platformName[platforms[i]]
+                    << ", command buffer " << j << " has addresses not patched with their bo" << endl;
+            }
+        }
+    }
+    delete pDecData;
+}
+
+TEST_F(MediaDecodeDdiTest, DecodeAVCLong_IoctlCount)
+{
+    // Command buffers are persistently mapped, they are neither mapped when
+    // bound to the GPU context nor unmapped at submit.
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeAVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("AVC-Long");
+    DecodeIoctlCountTest(pDecData);
+    delete pDecData;
+}
+
+TEST_F(MediaDecodeDdiTest, DecodeHEVCLong_IoctlCount)
+{
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeHEVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("HEVC-Long");
+    DecodeIoctlCountTest(pDecData);
+    delete pDecData;
+}
+
+void MediaDecodeDdiTest::DecodeIoctlCountTest(DecTestData *pDecData)
+{
+    // Command buffers and other bPersistentMap resources are mapped once at
+    // allocation, their locks only wait for the GPU. The stream is decoded
+    // with and without the persistent mappings, which must save SET_DOMAIN
+    // ioctls and map ioctls overall. The mock counts an MMAP for the first
+    // mapping of each bo only, like the mappings cached by libdrm.
+    IoctlCounter ioctlCounter;
+    if (!ioctlCounter.IsAvailable())
+    {
+        FAIL() << "mos_mock_get_ioctl_count not found, the ULT must run with the mock DRM preloaded" << endl;
+    }
+
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_decTestCfg.IsDecTestEnabled(DeviceConfigTable[platforms[i]], pDecData->GetFeatureID()) &&
+            IoctlCounter::HasPersistentMaps(platforms[i]))
+        {
+            uint32_t setDomainCount[2] = {};
+            uint32_t mapCount[2]       = {};
+
+            CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
+            for (int disable = 0; disable < 2; disable++)
+            {
+                m_driverLoader.SetUserFeature("MOS Persistent Map Disable", disable ? "1" : "0");
+                ioctlCounter.Start();
+                DecodeExecute(pDecData, platforms[i]);
+                setDomainCount[disable] = ioctlCounter.GetCount(IoctlCounter::SET_DOMAIN);
+                mapCount[disable]       = ioctlCounter.GetMapCount();
+                if (disable == 0)
+                {
+                    ioctlCounter.Print(g_platformName[platforms[i]], pDecData->m_num_frames);
+                }
+            }
+            m_driverLoader.SetUserFeature("MOS Persistent Map Disable", nullptr);
+
+            if (!m_driverLoader.IsUserFeatureApplied())
+            {
+                // Release drivers always map persistently, both runs took the same path
+                break;
+            }
+
+            EXPECT_LT(setDomainCount[0], setDomainCount[1]) << "Platform = " << g_platformName[platforms[i]]
+                << ", persistent mappings don't save SET_DOMAIN ioctls" << endl;
+            EXPECT_LT(mapCount[0], mapCount[1]) << "Platform = " << g_platformName[platforms[i]]
+                << ", persistent mappings don't save SET_DOMAIN and MMAP ioctls" << endl;
+        }
+    }
+}
+
 void MediaDecodeDdiTest::ExectueDecodeTest(DecTestData *pDecData)
 {
     vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
@@ -53,7 +591,46 @@ void MediaDecodeDdiTest::ExectueDecodeTest(DecTestData *pDecData)
     }
 }
 
-void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platform)
+bool MediaDecodeDdiTest::CompareDecodeVariants(DecTestData *pDecData, Platform_t platform, int variantNum,
+                                               const function<void(int)> &setVariant,
+                                               const function<bool()> &isApplied, int repeat)
+{
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<vector<vector<uint32_t>>>                    cmdBufs(variantNum);
+    vector<vector<vector<CmdValidator::CapturedPatch>>> patches(variantNum);
+
+    CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platform);
+    for (int variant = 0; variant < variantNum; variant++)
+    {
+        setVariant(variant);
+        cmdValidator->StartCapture();
+        DecodeExecute(pDecData, platform, nullptr, repeat);
+        cmdBufs[variant] = cmdValidator->StopCapture();
+        patches[variant] = cmdValidator->GetCapturedPatches();
+        if (!isApplied())
+        {
+            return false;
+        }
+    }
+
+    for (int variant = 0; variant < variantNum; variant++)
+    {
+        EXPECT_EQ(cmdBufs[0].size(), cmdBufs[variant].size()) << "Platform = " << g_platformName[platform]
+            << ", variant " << variant << endl;
+        EXPECT_EQ(cmdBufs[variant].size(), patches[variant].size()) << "Platform = " << g_platformName[platform]
+            << ", variant " << variant << endl;
+        for (size_t j = 0; j < cmdBufs[0].size() && j < cmdBufs[variant].size() && j < patches[variant].size(); j++)
+        {
+            EXPECT_TRUE(cmdBufs[0][j] == cmdBufs[variant][j]) << "Platform = " << g_platformName[platform]
+                << ", command buffer " << j << " of variant " << variant << " differs from variant 0" << endl;
+            EXPECT_TRUE(patches[0][j] == patches[variant][j]) << "Platform = " << g_platformName[platform]
+                << ", patch list " << j << " of variant " << variant << " differs from variant 0" << endl;
+        }
+    }
+    return true;
+}
+
+void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platform, uint64_t *endPictureNs, int repeat)
 {
     VAConfigID      config_id;
     VAContextID     context_id;
@@ -79,12 +656,15 @@ void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platfor
         << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
 
     ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id, pDecData->GetWidth(),
-        pDecData->GetHeight(),VA_PROGRESSIVE, &resources[0], resources.size(), &context_id);
+        pDecData->GetHeight(), pDecData->GetContextFlag(), &resources[0], resources.size(), &context_id);
     EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
         << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
 
-    for (int i = 0; i < pDecData->m_num_frames; i++)
+    // The stream is decoded repeat times in the same context
+    for (int n = 0; n < repeat * pDecData->m_num_frames; n++)
     {
+        int i = n % pDecData->m_num_frames;
+
         // As BeginPicture would reset some parameters, so it should be called before RenderPicture.
         ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id, resources[0]);
         EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
@@ -109,15 +689,25 @@ void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platfor
                 << ", Failed function = m_driverLoader.m_ctx.vtable->vaRenderPicture" << endl;
         }
 
+        auto start = chrono::steady_clock::now();
         ret = m_driverLoader.m_ctx.vtable->vaEndPicture(&m_driverLoader.m_ctx, context_id);
+        if (endPictureNs)
+        {
+            *endPictureNs += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        }
         EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
             << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
 
-        do
+        for (uint32_t t = 0; t < pDecData->GetTargetNum(); t++)
         {
-            ret = m_driverLoader.m_ctx.vtable->vaQuerySurfaceStatus(
-                &m_driverLoader.m_ctx, resources[0], &surface_status);
-        } while (surface_status != VASurfaceReady);
+            do
+            {
+                ret = m_driverLoader.m_ctx.vtable->vaQuerySurfaceStatus(
+                    &m_driverLoader.m_ctx, resources[t], &surface_status);
+            } while (ret == VA_STATUS_SUCCESS && surface_status != VASurfaceReady);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaQuerySurfaceStatus, target " << t << endl;
+        }
 
         for (int j = 0; j < compBufs[i].size(); j++)
         {
@@ -149,10 +739,12 @@ DecodeTestConfig::DecodeTestConfig()
     m_mapPlatformFeatureID[DeviceConfigTable[igfxSKLAKE]]     = {
         TEST_Intel_Decode_HEVC,
         TEST_Intel_Decode_AVC ,
+        TEST_Intel_Decode_JPEG,
     };
     m_mapPlatformFeatureID[DeviceConfigTable[igfxBROXTON]]    = {
         TEST_Intel_Decode_HEVC,
         TEST_Intel_Decode_AVC ,
+        TEST_Intel_Decode_JPEG,
     };
     m_mapPlatformFeatureID[DeviceConfigTable[igfxBROADWELL]]  = {
         TEST_Intel_Decode_AVC ,
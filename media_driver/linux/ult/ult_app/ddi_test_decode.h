@@ -22,6 +22,7 @@
 #ifndef __DDI_TEST_DECODE_H__
 #define __DDI_TEST_DECODE_H__
 
+#include <functional>
 #include "cmd_validator.h"
 #include "driver_loader.h"
 #include "gtest/gtest.h"
@@ -50,10 +51,22 @@ protected:
 
     virtual void TearDown() { }
 
-    void DecodeExecute(DecTestData *pDecData, Platform_t platform);
+    // endPictureNs, if not null, accumulates the CPU time spent in vaEndPicture.
+    void DecodeExecute(DecTestData *pDecData, Platform_t platform, uint64_t *endPictureNs = nullptr, int repeat = 1);
 
     void ExectueDecodeTest(DecTestData *pDecData);
 
+    // Decodes pDecData repeat times in one context once per variant, selected
+    // by setVariant before each decode, and checks that all variants submit the
+    // same command buffers and patch lists. Returns false without comparing if
+    // isApplied reports that the driver ignored the variants.
+    bool CompareDecodeVariants(DecTestData *pDecData, Platform_t platform, int variantNum,
+                               const std::function<void(int)> &setVariant,
+                               const std::function<bool()> &isApplied, int repeat = 1);
+
+    // Decodes pDecData and prints the ioctls counted by the mock DRM per frame.
+    void DecodeIoctlCountTest(DecTestData *pDecData);
+
 protected:
 
     DriverDllLoader     m_driverLoader;
@@ -19,7 +19,18 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
 #include "ddi_test_encode.h"
+#include "ioctl_counter.h"
+#include "media_libva_common.h"
+#include "va_capture_replay.h"
+#include "mhw_vdbox_mfx_hwcmd_g9_bxt.h"
+#include "mhw_vdbox_mfx_hwcmd_g9_skl.h"
+#include "mhw_render_hwcmd_g9_X.h"
+#include "mhw_state_heap_hwcmd_g9_X.h"
 
 using namespace std;
 
@@ -31,6 +42,143 @@ TEST_F(MediaEncodeDdiTest, EncodeHEVC_DualPipe)
     delete pEncData;
 }
 
+TEST_F(MediaEncodeDdiTest, EncodeHEVC_DualPipe_Pipelined)
+{
+    // All the frames are ended before the first sync, so frames queued to
+    // the encode worker must be executed in order before their status is read.
+    // The worker runs with the default "Encode Frame Context Number" of 2.
+    m_GpuCmdFactory = g_gpuCmdFactoryEncodeHevcDualPipe;
+    EncTestData *pEncData = m_encTestFactory.GetEncTestData("HEVC-DualPipe");
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData->GetFeatureID()))
+        {
+            CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
+            EncodeExecute(pEncData, platforms[i], false);
+
+            int32_t workerFrames = m_driverLoader.GetUltCounter(MOS_ULT_COUNTER_ENCODE_WORKER_FRAMES);
+            if (workerFrames < 0)
+            {
+                // Release drivers do not count the worker frames
+                continue;
+            }
+            EXPECT_EQ(pEncData->m_num_frames, workerFrames)
+                << "Platform = " << g_platformName[platforms[i]]
+                << ", the frames were not executed by the encode worker" << endl;
+        }
+    }
+    delete pEncData;
+}
+
+TEST_F(MediaEncodeDdiTest, EncodeHEVC_BufferRecycle)
+{
+    // Parameter buffers and a disable skip map are created, mapped, unmapped and
+    // destroyed every frame, from the second frame on they come back from the per
+    // context buffer pool without allocating.
+    EncTestData *pEncData = m_encTestFactory.GetEncTestData("HEVC-DualPipe");
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData->GetFeatureID()))
+        {
+            EncodeBufferCycleExecute(pEncData, platforms[i], 100);
+        }
+    }
+    delete pEncData;
+}
+
+TEST_F(MediaEncodeDdiTest, EncodeHEVC_CaptureReplay)
+{
+    // The picture parameters refer to the coded buffer by ID, the replay recreates
+    // the objects in the captured order so the driver hands out the same IDs.
+    const char *captureFile = "./va_capture_encode_hevc.bin";
+    m_GpuCmdFactory = g_gpuCmdFactoryEncodeHevcDualPipe;
+    EncTestData *pEncData = m_encTestFactory.GetEncTestData("HEVC-DualPipe");
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData->GetFeatureID()))
+        {
+            CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
+            m_driverLoader.SetUserFeature("VA Capture File", captureFile);
+            EncodeExecute(pEncData, platforms[i]);
+            m_driverLoader.SetUserFeature("VA Capture File", nullptr);
+            if (!m_driverLoader.IsUserFeatureApplied())
+            {
+                // Release drivers only capture to the file of the user feature file
+                break;
+            }
+            VaCaptureReplayer::ReplayTest(m_driverLoader, m_GpuCmdFactory, captureFile, platforms[i]);
+        }
+    }
+    delete pEncData;
+}
+
+TEST_F(MediaEncodeDdiTest, EncodeAVC_VDEnc_MapIoctlCount)
+{
+    // Resources allocated with bPersistentMap, such as the HuC BRC inputs
+    // written by the CPU every frame, are mapped once; their locks only wait
+    // for the GPU. A CBR stream writes them on every frame. It is encoded with
+    // and without the persistent mappings: with them, frames must not map
+    // anything once the first frame mapped them, and the stream must map less.
+    IoctlCounter ioctlCounter;
+    if (!ioctlCounter.IsAvailable())
+    {
+        FAIL() << "mos_mock_get_ioctl_count not found, the ULT must run with the mock DRM preloaded" << endl;
+    }
+
+    EncTestData *pEncData = m_encTestFactory.GetEncTestData("AVC-VDEnc-CBR");
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (!m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData->GetFeatureID()) ||
+            !IoctlCounter::HasPersistentMaps(platforms[i]))
+        {
+            continue;
+        }
+
+        vector<uint32_t> frameMapCount[2];
+        uint32_t         mapCount[2] = {};
+
+        CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+        for (int disable = 0; disable < 2; disable++)
+        {
+            IoctlCounter frameCounter;
+
+            m_driverLoader.SetUserFeature("MOS Persistent Map Disable", disable ? "1" : "0");
+            ioctlCounter.Start();
+            frameCounter.Start();
+            EncodeExecute(pEncData, platforms[i], true, [&](int) {
+                frameMapCount[disable].push_back(frameCounter.GetMapCount());
+                frameCounter.Start();
+            });
+            mapCount[disable] = ioctlCounter.GetMapCount();
+            if (disable == 0)
+            {
+                ioctlCounter.Print(g_platformName[platforms[i]], pEncData->m_num_frames);
+            }
+        }
+        m_driverLoader.SetUserFeature("MOS Persistent Map Disable", nullptr);
+
+        ASSERT_EQ((size_t)pEncData->m_num_frames, frameMapCount[0].size()) << "Platform = " << g_platformName[platforms[i]] << endl;
+        for (size_t f = 1; f < frameMapCount[0].size(); f++)
+        {
+            EXPECT_EQ(0u, frameMapCount[0][f]) << "Platform = " << g_platformName[platforms[i]]
+                << ", frame " << f << " mapped buffers" << endl;
+        }
+
+        if (!m_driverLoader.IsUserFeatureApplied())
+        {
+            // Release drivers always map persistently, both runs took the same path
+            break;
+        }
+        EXPECT_LT(mapCount[0], mapCount[1]) << "Platform = " << g_platformName[platforms[i]]
+            << ", persistent mappings don't save SET_DOMAIN and MMAP ioctls" << endl;
+    }
+    delete pEncData;
+}
+
 TEST_F(MediaEncodeDdiTest, EncodeAVC_DualPipe)
 {
     m_GpuCmdFactory = g_gpuCmdFactoryEncodeAvcDualPipe;
@@ -39,7 +187,635 @@ TEST_F(MediaEncodeDdiTest, EncodeAVC_DualPipe)
     delete pEncData;
 }
 
-void MediaEncodeDdiTest::ExectueEncodeTest(EncTestData *pEncData)
+// Headers of the fixed size MFX commands of a JPEG encode picture.
+template<typename TMfxCmds>
+static set<uint32_t> GetJpegEncodeCmdHeaders()
+{
+    return {
+        typename TMfxCmds::MFX_PIPE_MODE_SELECT_CMD().DW0.Value,
+        typename TMfxCmds::MFX_SURFACE_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFX_PIPE_BUF_ADDR_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFX_IND_OBJ_BASE_ADDR_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFX_FQM_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFC_JPEG_HUFF_TABLE_STATE_CMD().DW0.Value,
+        typename TMfxCmds::MFC_JPEG_SCAN_OBJECT_CMD().DW0.Value };
+}
+
+// MFX command headers of a command buffer in their order.
+static vector<uint32_t> GetJpegEncodeCmdSequence(const vector<uint32_t> &cmdBuf, Platform_t platform)
+{
+    static const set<uint32_t> headersSkl = GetJpegEncodeCmdHeaders<mhw_vdbox_mfx_g9_skl>();
+    static const set<uint32_t> headersBxt = GetJpegEncodeCmdHeaders<mhw_vdbox_mfx_g9_bxt>();
+    const set<uint32_t> &headers = (platform == igfxBROXTON) ? headersBxt : headersSkl;
+
+    vector<uint32_t> sequence;
+    for (auto dw : cmdBuf)
+    {
+        if (headers.count(dw))
+        {
+            sequence.push_back(dw);
+        }
+    }
+    return sequence;
+}
+
+// Dwords of the commands starting with header in a command buffer, in their order.
+static vector<uint32_t> GetJpegEncodeCmds(const vector<uint32_t> &cmdBuf, uint32_t header)
+{
+    vector<uint32_t> cmds;
+    for (size_t j = 0; j < cmdBuf.size(); j++)
+    {
+        if (cmdBuf[j] != header)
+        {
+            continue;
+        }
+        // DW0 holds the command length in dwords minus 2.
+        size_t end = min(cmdBuf.size(), j + (header & 0xfff) + 2);
+        cmds.insert(cmds.end(), cmdBuf.begin() + j, cmdBuf.begin() + end);
+    }
+    return cmds;
+}
+
+TEST_F(MediaEncodeDdiTest, EncodeJPEG_TableReuse)
+{
+    // The quantization and huffman tables of a JPEG picture are converted and
+    // their headers packed only when the application changes them. The
+    // submitted bytes must be the same as when they are rebuilt every frame,
+    // and the table commands of a frame with changed tables must differ from
+    // the ones of the frames around it.
+    const char *descriptions[] = { "JPEG", "JPEG-TableChange" };
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (auto description : descriptions)
+    {
+        EncTestData *pEncData = m_encTestFactory.GetEncTestData(description);
+        int tableChangeFrame = static_cast<EncTestDataJPEG *>(pEncData)->GetTableChangeFrame();
+        for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+        {
+            if (!m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData->GetFeatureID()))
+            {
+                continue;
+            }
+
+            vector<vector<uint32_t>> cmdBufs[2];
+
+            // There are no reference commands for JPEG encode, only the two runs are compared.
+            CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+            for (int disable = 0; disable < 2; disable++)
+            {
+                m_driverLoader.SetUserFeature("JPEG Encode Table Reuse Disable", disable ? "1" : "0");
+                cmdValidator->StartCapture();
+                EncodeExecute(pEncData, platforms[i]);
+                cmdBufs[disable] = cmdValidator->StopCapture();
+            }
+            m_driverLoader.SetUserFeature("JPEG Encode Table Reuse Disable", nullptr);
+
+            if (!m_driverLoader.IsUserFeatureApplied())
+            {
+                // Release drivers always reuse the tables, both runs took the same path
+                break;
+            }
+
+            ASSERT_EQ(cmdBufs[1].size(), cmdBufs[0].size()) << "Platform = " << g_platformName[platforms[i]];
+            for (size_t j = 0; j < cmdBufs[0].size(); j++)
+            {
+                EXPECT_TRUE(cmdBufs[0][j] == cmdBufs[1][j]) << "Platform = " << g_platformName[platforms[i]]
+                    << ", " << description << ", command buffer " << j
+                    << " with reused tables differs from the rebuilt one" << endl;
+            }
+
+            uint32_t fqmHeader  = (platforms[i] == igfxBROXTON) ?
+                mhw_vdbox_mfx_g9_bxt::MFX_FQM_STATE_CMD().DW0.Value :
+                mhw_vdbox_mfx_g9_skl::MFX_FQM_STATE_CMD().DW0.Value;
+            uint32_t huffHeader = (platforms[i] == igfxBROXTON) ?
+                mhw_vdbox_mfx_g9_bxt::MFC_JPEG_HUFF_TABLE_STATE_CMD().DW0.Value :
+                mhw_vdbox_mfx_g9_skl::MFC_JPEG_HUFF_TABLE_STATE_CMD().DW0.Value;
+
+            // Table commands of each frame with reused tables. Command buffers
+            // without MFX commands only store the encode status.
+            vector<vector<uint32_t>> fqmCmds, huffCmds;
+            for (auto &cmdBuf : cmdBufs[0])
+            {
+                if (GetJpegEncodeCmdSequence(cmdBuf, platforms[i]).empty())
+                {
+                    continue;
+                }
+                fqmCmds.push_back(GetJpegEncodeCmds(cmdBuf, fqmHeader));
+                huffCmds.push_back(GetJpegEncodeCmds(cmdBuf, huffHeader));
+            }
+            ASSERT_EQ((size_t)pEncData->m_num_frames, fqmCmds.size()) << "Platform = " << g_platformName[platforms[i]];
+
+            for (int f = 1; f < pEncData->m_num_frames; f++)
+            {
+                ASSERT_FALSE(fqmCmds[f].empty() || huffCmds[f].empty()) << "Platform = " << g_platformName[platforms[i]]
+                    << ", " << description << ", frame " << f << " has no table commands" << endl;
+
+                // The frame after the changed one sends the first tables again.
+                bool changed = (f == tableChangeFrame || f - 1 == tableChangeFrame);
+                EXPECT_EQ(changed, fqmCmds[f] != fqmCmds[f - 1]) << "Platform = " << g_platformName[platforms[i]]
+                    << ", " << description << ", quantization tables of frame " << f
+                    << (changed ? " are not sent again" : " changed") << endl;
+                EXPECT_EQ(changed, huffCmds[f] != huffCmds[f - 1]) << "Platform = " << g_platformName[platforms[i]]
+                    << ", " << description << ", huffman tables of frame " << f
+                    << (changed ? " are not sent again" : " changed") << endl;
+            }
+        }
+        delete pEncData;
+    }
+}
+
+// Register stores of a command buffer, as the register and the bo and offset
+// they write to. Only MI_STORE_REGISTER_MEM headers (MI opcode 0x24 in bits
+// 28:23) followed by a patched address are taken.
+static vector<tuple<uint32_t, uint32_t, uint32_t>> GetRegisterStores(
+    const vector<uint32_t> &cmdBuf,
+    const vector<CmdValidator::CapturedPatch> &patches)
+{
+    map<size_t, const CmdValidator::CapturedPatch *> patchAt;
+    for (auto &patch : patches)
+    {
+        patchAt[patch.patchOffset / sizeof(uint32_t)] = &patch;
+    }
+
+    vector<tuple<uint32_t, uint32_t, uint32_t>> stores;
+    for (size_t j = 0; j + 2 < cmdBuf.size(); j++)
+    {
+        auto patch = patchAt.find(j + 2);
+        if ((cmdBuf[j] >> 23) == 0x24 && patch != patchAt.end())
+        {
+            stores.emplace_back(cmdBuf[j + 1], patch->second->bo, patch->second->allocationOffset);
+        }
+    }
+    return stores;
+}
+
+TEST_F(MediaEncodeDdiTest, EncodeJPEG_Batch)
+{
+    // In a context created with DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH, each frame
+    // sends several images in one picture. They are encoded back to back in
+    // one command buffer, which must hold the MFX commands of each image in
+    // the same order as when the image is encoded on its own. Each image
+    // stores its coded size and status registers to its own status report
+    // entry. Without the flag, the last image of a picture is encoded alone.
+    EncTestData *pEncData = m_encTestFactory.GetEncTestData("JPEG");
+    EncTestData *pBatchData = m_encTestFactory.GetEncTestData("JPEG-Batch");
+    uint32_t imageNum = static_cast<EncTestDataJPEG *>(pBatchData)->GetImageNum();
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData->GetFeatureID()))
+        {
+            CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+            cmdValidator->StartCapture();
+            EncodeExecute(pEncData, platforms[i]);
+            vector<vector<uint32_t>> cmdBufs = cmdValidator->StopCapture();
+            vector<vector<CmdValidator::CapturedPatch>> patches = cmdValidator->GetCapturedPatches();
+
+            cmdValidator->StartCapture();
+            EncodeExecute(pBatchData, platforms[i]);
+            vector<vector<uint32_t>> batchCmdBufs = cmdValidator->StopCapture();
+            vector<vector<CmdValidator::CapturedPatch>> batchPatches = cmdValidator->GetCapturedPatches();
+
+            int32_t batchFlag = pBatchData->GetContextFlag();
+            pBatchData->SetContextFlag(batchFlag & ~DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH);
+            cmdValidator->StartCapture();
+            EncodeExecute(pBatchData, platforms[i]);
+            vector<vector<uint32_t>> unbatchedCmdBufs = cmdValidator->StopCapture();
+            pBatchData->SetContextFlag(batchFlag);
+
+            ASSERT_EQ(cmdBufs.size(), patches.size()) << "Platform = " << g_platformName[platforms[i]];
+            ASSERT_EQ(batchCmdBufs.size(), batchPatches.size()) << "Platform = " << g_platformName[platforms[i]];
+
+            // Command buffers without MFX commands only store the encode status.
+            vector<uint32_t> imageSequence;
+            map<uint32_t, uint32_t> imageStoreNum;
+            for (size_t j = 0; j < cmdBufs.size(); j++)
+            {
+                imageSequence = GetJpegEncodeCmdSequence(cmdBufs[j], platforms[i]);
+                if (!imageSequence.empty())
+                {
+                    for (auto &store : GetRegisterStores(cmdBufs[j], patches[j]))
+                    {
+                        imageStoreNum[get<0>(store)]++;
+                    }
+                    break;
+                }
+            }
+            ASSERT_FALSE(imageSequence.empty()) << "Platform = " << g_platformName[platforms[i]];
+            ASSERT_FALSE(imageStoreNum.empty()) << "Platform = " << g_platformName[platforms[i]]
+                << ", the image stores no status registers" << endl;
+
+            vector<uint32_t> expected;
+            for (uint32_t k = 0; k < imageNum; k++)
+            {
+                expected.insert(expected.end(), imageSequence.begin(), imageSequence.end());
+            }
+
+            int encodeCmdBufNum = 0;
+            for (size_t j = 0; j < batchCmdBufs.size(); j++)
+            {
+                vector<uint32_t> sequence = GetJpegEncodeCmdSequence(batchCmdBufs[j], platforms[i]);
+                if (sequence.empty())
+                {
+                    continue;
+                }
+                encodeCmdBufNum++;
+                EXPECT_TRUE(sequence == expected) << "Platform = " << g_platformName[platforms[i]]
+                    << ", command buffer " << encodeCmdBufNum << " does not hold the MFX commands of "
+                    << imageNum << " images" << endl;
+
+                // Every image stores the registers of a single image, to locations of its own.
+                map<uint32_t, uint32_t> storeNum;
+                set<pair<uint32_t, uint32_t>> storeTargets;
+                vector<tuple<uint32_t, uint32_t, uint32_t>> stores = GetRegisterStores(batchCmdBufs[j], batchPatches[j]);
+                for (auto &store : stores)
+                {
+                    storeNum[get<0>(store)]++;
+                    storeTargets.emplace(get<1>(store), get<2>(store));
+                }
+                for (auto &imageStore : imageStoreNum)
+                {
+                    EXPECT_EQ(imageNum * imageStore.second, storeNum[imageStore.first])
+                        << "Platform = " << g_platformName[platforms[i]] << ", command buffer " << encodeCmdBufNum
+                        << ", register 0x" << hex << imageStore.first << dec << " is not stored once per image" << endl;
+                }
+                EXPECT_EQ(stores.size(), storeTargets.size()) << "Platform = " << g_platformName[platforms[i]]
+                    << ", command buffer " << encodeCmdBufNum << ", images store their status to the same location" << endl;
+            }
+            EXPECT_EQ(pBatchData->m_num_frames, encodeCmdBufNum) << "Platform = " << g_platformName[platforms[i]];
+            EXPECT_EQ(cmdBufs.size(), batchCmdBufs.size()) << "Platform = " << g_platformName[platforms[i]];
+
+            // Without the opt-in, the command buffers hold a single image.
+            encodeCmdBufNum = 0;
+            for (auto &cmdBuf : unbatchedCmdBufs)
+            {
+                vector<uint32_t> sequence = GetJpegEncodeCmdSequence(cmdBuf, platforms[i]);
+                if (sequence.empty())
+                {
+                    continue;
+                }
+                encodeCmdBufNum++;
+                EXPECT_TRUE(sequence == imageSequence) << "Platform = " << g_platformName[platforms[i]]
+                    << ", command buffer " << encodeCmdBufNum << " was batched without DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH" << endl;
+            }
+            EXPECT_EQ(pBatchData->m_num_frames, encodeCmdBufNum) << "Platform = " << g_platformName[platforms[i]];
+        }
+    }
+    delete pEncData;
+    delete pBatchData;
+}
+
+// Component selectors of the scan headers inserted in a command buffer, in
+// their order. A scan header is the SOS marker 0xFFDA followed by its length
+// Ls = 6 + 2 * Ns and the component number Ns, then Ns selector/table pairs.
+static vector<vector<uint8_t>> GetJpegScanHeaders(const vector<uint32_t> &cmdBuf)
+{
+    const uint8_t *bytes = (const uint8_t *)cmdBuf.data();
+    size_t size = cmdBuf.size() * sizeof(uint32_t);
+
+    vector<vector<uint8_t>> headers;
+    for (size_t j = 0; j + 5 <= size; j++)
+    {
+        if (bytes[j] != 0xFF || bytes[j + 1] != 0xDA)
+        {
+            continue;
+        }
+        uint32_t length = (bytes[j + 2] << 8) | bytes[j + 3];
+        uint32_t numComponent = bytes[j + 4];
+        if (numComponent < 1 || numComponent > 4 || length != 6 + 2 * numComponent || j + 2 + length > size)
+        {
+            continue;
+        }
+        vector<uint8_t> components;
+        for (uint32_t k = 0; k < numComponent; k++)
+        {
+            components.push_back(bytes[j + 5 + 2 * k]);
+        }
+        headers.push_back(components);
+    }
+    return headers;
+}
+
+TEST_F(MediaEncodeDdiTest, EncodeJPEG_MultiScan)
+{
+    // The scans of a picture are encoded in one command buffer, with one scan
+    // header and scan object per scan after the tables, which are loaded once.
+    // Each scan header selects the components of its scan parameters. Every
+    // scan but the last stores its end offset to a status location of its own,
+    // the last one is covered by the frame status of a single scan picture.
+    const char *descriptions[] = { "JPEG", "JPEG-2Scan", "JPEG-3Scan" };
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    map<Platform_t, map<uint32_t, uint32_t>> singleScanStoreNum;
+    for (auto description : descriptions)
+    {
+        EncTestData *pEncData = m_encTestFactory.GetEncTestData(description);
+        EncTestDataJPEG *pJpegData = static_cast<EncTestDataJPEG *>(pEncData);
+        uint32_t scanNum = pJpegData->GetScanNum();
+        for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+        {
+            if (!m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData->GetFeatureID()))
+            {
+                continue;
+            }
+
+            CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+            cmdValidator->StartCapture();
+            EncodeExecute(pEncData, platforms[i]);
+            vector<vector<uint32_t>> cmdBufs = cmdValidator->StopCapture();
+            vector<vector<CmdValidator::CapturedPatch>> patches = cmdValidator->GetCapturedPatches();
+            ASSERT_EQ(cmdBufs.size(), patches.size()) << "Platform = " << g_platformName[platforms[i]];
+
+            uint32_t scanHeader  = (platforms[i] == igfxBROXTON) ?
+                mhw_vdbox_mfx_g9_bxt::MFC_JPEG_SCAN_OBJECT_CMD().DW0.Value :
+                mhw_vdbox_mfx_g9_skl::MFC_JPEG_SCAN_OBJECT_CMD().DW0.Value;
+            uint32_t tableHeader = (platforms[i] == igfxBROXTON) ?
+                mhw_vdbox_mfx_g9_bxt::MFC_JPEG_HUFF_TABLE_STATE_CMD().DW0.Value :
+                mhw_vdbox_mfx_g9_skl::MFC_JPEG_HUFF_TABLE_STATE_CMD().DW0.Value;
+
+            int encodeCmdBufNum = 0;
+            for (size_t j = 0; j < cmdBufs.size(); j++)
+            {
+                const vector<uint32_t> &cmdBuf = cmdBufs[j];
+                vector<uint32_t> sequence = GetJpegEncodeCmdSequence(cmdBuf, platforms[i]);
+                if (sequence.empty())
+                {
+                    continue;
+                }
+                encodeCmdBufNum++;
+
+                map<uint32_t, uint32_t> storeNum;
+                set<pair<uint32_t, uint32_t>> storeTargets;
+                vector<tuple<uint32_t, uint32_t, uint32_t>> stores = GetRegisterStores(cmdBuf, patches[j]);
+                for (auto &store : stores)
+                {
+                    storeNum[get<0>(store)]++;
+                    storeTargets.emplace(get<1>(store), get<2>(store));
+                }
+                if (scanNum == 1)
+                {
+                    singleScanStoreNum[platforms[i]] = storeNum;
+                }
+                else if (singleScanStoreNum.count(platforms[i]))
+                {
+                    uint32_t scanStoreNum = 0;
+                    for (auto &regStore : storeNum)
+                    {
+                        uint32_t singleNum = singleScanStoreNum[platforms[i]][regStore.first];
+                        EXPECT_LE(singleNum, regStore.second) << "Platform = " << g_platformName[platforms[i]]
+                            << ", " << description << ", register 0x" << hex << regStore.first << dec << endl;
+                        scanStoreNum += regStore.second - min(singleNum, regStore.second);
+                    }
+                    EXPECT_EQ(scanNum - 1, scanStoreNum) << "Platform = " << g_platformName[platforms[i]]
+                        << ", " << description << ", the scan end offsets are not stored once per scan" << endl;
+                }
+                EXPECT_EQ(stores.size(), storeTargets.size()) << "Platform = " << g_platformName[platforms[i]]
+                    << ", " << description << ", scans store their status to the same location" << endl;
+
+                // Only the headers are compared, the huffman tables are sent per table ID.
+                auto firstScan = find(sequence.begin(), sequence.end(), scanHeader);
+                EXPECT_EQ(scanNum, (uint32_t)count(sequence.begin(), sequence.end(), scanHeader))
+                    << "Platform = " << g_platformName[platforms[i]] << ", " << description << endl;
+                EXPECT_EQ(0, count(firstScan, sequence.end(), tableHeader))
+                    << "Platform = " << g_platformName[platforms[i]] << ", " << description
+                    << ", huffman tables are loaded again between scans" << endl;
+
+                vector<vector<uint8_t>> scanHeaders = GetJpegScanHeaders(cmdBuf);
+                ASSERT_EQ(scanNum, (uint32_t)scanHeaders.size()) << "Platform = " << g_platformName[platforms[i]]
+                    << ", " << description << ", command buffer " << encodeCmdBufNum << endl;
+                for (uint32_t s = 0; s < scanNum; s++)
+                {
+                    EXPECT_TRUE(scanHeaders[s] == pJpegData->GetScanComponents(s))
+                        << "Platform = " << g_platformName[platforms[i]] << ", " << description
+                        << ", scan " << s << " does not select the components of its scan parameters" << endl;
+                }
+            }
+            EXPECT_EQ(pEncData->m_num_frames, encodeCmdBufNum) << "Platform = " << g_platformName[platforms[i]];
+        }
+        delete pEncData;
+    }
+}
+
+// CURBE and binding table of a media kernel, from the MEDIA_CURBE_LOAD and the
+// interface descriptor loaded before its MEDIA_OBJECT_WALKER.
+struct MediaKernelStates
+{
+    uint32_t curbeOffset;
+    uint32_t curbeLength;
+    uint32_t btOffset;
+};
+
+static vector<MediaKernelStates> GetMediaKernelStates(
+    const vector<uint32_t> &cmdBuf,
+    const vector<uint32_t> &dynamicState)
+{
+    using Render    = mhw_render_g9_X;
+    using StateHeap = mhw_state_heap_g9_X;
+    const uint32_t walkerHeader = Render::MEDIA_OBJECT_WALKER_CMD().DW0.Value;
+    const uint32_t curbeHeader  = Render::MEDIA_CURBE_LOAD_CMD().DW0.Value;
+    const uint32_t idLoadHeader = Render::MEDIA_INTERFACE_DESCRIPTOR_LOAD_CMD().DW0.Value;
+
+    vector<MediaKernelStates> kernels;
+    MediaKernelStates         kernel   = {};
+    uint32_t                  idOffset = 0;
+    for (auto offset : CmdValidator::GetCmdOffsets(cmdBuf))
+    {
+        const uint32_t *cmd       = &cmdBuf[offset];
+        size_t          available = cmdBuf.size() - offset;
+        if (cmd[0] == curbeHeader && available >= Render::MEDIA_CURBE_LOAD_CMD::dwSize)
+        {
+            auto curbeLoad     = (const Render::MEDIA_CURBE_LOAD_CMD *)cmd;
+            kernel.curbeOffset = curbeLoad->DW3.CurbeDataStartAddress;
+            kernel.curbeLength = curbeLoad->DW2.CurbeTotalDataLength;
+        }
+        else if (cmd[0] == idLoadHeader && available >= Render::MEDIA_INTERFACE_DESCRIPTOR_LOAD_CMD::dwSize)
+        {
+            idOffset = ((const Render::MEDIA_INTERFACE_DESCRIPTOR_LOAD_CMD *)cmd)->DW3.InterfaceDescriptorDataStartAddress;
+        }
+        else if (cmd[0] == walkerHeader && available >= Render::MEDIA_OBJECT_WALKER_CMD::dwSize)
+        {
+            auto   walker = (const Render::MEDIA_OBJECT_WALKER_CMD *)cmd;
+            size_t id     = (idOffset + walker->DW1.InterfaceDescriptorOffset *
+                sizeof(StateHeap::INTERFACE_DESCRIPTOR_DATA_CMD)) / sizeof(uint32_t);
+
+            // The binding table pointer is in 32 byte units of the SSH
+            kernel.btOffset = UINT32_MAX;
+            if (id + StateHeap::INTERFACE_DESCRIPTOR_DATA_CMD::dwSize <= dynamicState.size())
+            {
+                auto descriptor = (const StateHeap::INTERFACE_DESCRIPTOR_DATA_CMD *)&dynamicState[id];
+                kernel.btOffset = descriptor->DW4.BindingTablePointer << 5;
+            }
+            kernels.push_back(kernel);
+        }
+    }
+    return kernels;
+}
+
+TEST_F(MediaEncodeDdiTest, EncodeHEVC_Mfe)
+{
+    const int streamNum = 2;
+    EncTestData *pEncData[streamNum];
+    for (int i = 0; i < streamNum; i++)
+    {
+        pEncData[i] = m_encTestFactory.GetEncTestData("HEVC-DualPipe");
+    }
+
+    // MFE contexts are only created on SKL. The MbEnc kernels of the streams are
+    // chained in the command buffer of the first stream. There, the first stream
+    // keeps the binding tables of a single stream encode, stream N has the same
+    // ones N SSH slots further, and each stream loads its own CURBEs.
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (platforms[i] != igfxSKLAKE ||
+            !m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData[0]->GetFeatureID()))
+        {
+            continue;
+        }
+
+        // Kernels of each command buffer holding walkers, of one stream then of the MFE context
+        vector<vector<MediaKernelStates>> cmdBufKernels[2];
+        size_t                            walkerNum[2] = {};
+        for (int mfe = 0; mfe < 2; mfe++)
+        {
+            CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+            cmdValidator->StartCapture(0, true);
+            if (mfe)
+            {
+                EncodeMfeExecute(pEncData, streamNum, platforms[i]);
+            }
+            else
+            {
+                EncodeExecute(pEncData[0], platforms[i]);
+            }
+            vector<vector<uint32_t>> cmdBufs = cmdValidator->StopCapture();
+            const vector<vector<uint32_t>> &dynamicStates = cmdValidator->GetCapturedDynamicStates();
+            ASSERT_EQ(cmdBufs.size(), dynamicStates.size());
+
+            for (size_t j = 0; j < cmdBufs.size(); j++)
+            {
+                vector<MediaKernelStates> kernels = GetMediaKernelStates(cmdBufs[j], dynamicStates[j]);
+                if (!kernels.empty())
+                {
+                    walkerNum[mfe] += kernels.size();
+                    cmdBufKernels[mfe].push_back(move(kernels));
+                }
+            }
+        }
+
+        ASSERT_GT(walkerNum[0], 0u) << "Platform = " << g_platformName[platforms[i]];
+        EXPECT_EQ(streamNum * walkerNum[0], walkerNum[1]) << "Platform = " << g_platformName[platforms[i]]
+            << ", each stream of the MFE context must run the kernels of a single stream encode" << endl;
+
+        // A merged command buffer starts with the kernels of a single stream command buffer
+        uint32_t mergedNum = 0;
+        for (const auto &merged : cmdBufKernels[1])
+        {
+            const vector<MediaKernelStates> *single = nullptr;
+            for (const auto &kernels : cmdBufKernels[0])
+            {
+                if (merged.size() == streamNum * kernels.size() &&
+                    equal(kernels.begin(), kernels.end(), merged.begin(),
+                        [](const MediaKernelStates &a, const MediaKernelStates &b) {
+                            return a.btOffset == b.btOffset && a.curbeLength == b.curbeLength; }))
+                {
+                    single = &kernels;
+                    break;
+                }
+            }
+            if (single == nullptr)
+            {
+                continue;
+            }
+            mergedNum++;
+
+            // The slot of a stream holds all the binding tables of the first stream
+            size_t   kernelNum = single->size();
+            uint32_t slotSize  = merged[kernelNum].btOffset - merged[0].btOffset;
+            EXPECT_GT(slotSize, merged[kernelNum - 1].btOffset - merged[0].btOffset)
+                << "Platform = " << g_platformName[platforms[i]] << endl;
+            for (size_t k = 1; k < (size_t)streamNum; k++)
+            {
+                for (size_t j = 0; j < kernelNum; j++)
+                {
+                    const MediaKernelStates &kernel = merged[k * kernelNum + j];
+                    EXPECT_EQ((uint32_t)((*single)[j].btOffset + k * slotSize), kernel.btOffset)
+                        << "Platform = " << g_platformName[platforms[i]] << ", stream " << k << ", kernel " << j << endl;
+                    EXPECT_EQ((*single)[j].curbeLength, kernel.curbeLength)
+                        << "Platform = " << g_platformName[platforms[i]] << ", stream " << k << ", kernel " << j << endl;
+
+                    // No CURBE of another stream overlaps the one of this kernel
+                    for (size_t l = 0; l < k * kernelNum; l++)
+                    {
+                        EXPECT_TRUE(merged[l].curbeOffset >= kernel.curbeOffset + kernel.curbeLength ||
+                            kernel.curbeOffset >= merged[l].curbeOffset + merged[l].curbeLength)
+                            << "Platform = " << g_platformName[platforms[i]] << ", stream " << k << ", kernel " << j
+                            << " shares its CURBE with kernel " << l % kernelNum << " of stream " << l / kernelNum << endl;
+                    }
+                }
+            }
+        }
+        EXPECT_LT(0u, mergedNum) << "Platform = " << g_platformName[platforms[i]]
+            << ", the MbEnc kernels of the streams are not merged in one command buffer" << endl;
+    }
+
+    for (int i = 0; i < streamNum; i++)
+    {
+        delete pEncData[i];
+    }
+}
+
+TEST_F(MediaEncodeDdiTest, EncodeHEVC_MfeSharedDs)
+{
+    // The streams of a MFE context encoding the same raw surface share its
+    // downscaled surfaces, so the downscaling kernels run once per raw surface
+    // instead of once per stream.
+    const int streamNum = 2;
+    EncTestData *pEncData[streamNum];
+    for (int i = 0; i < streamNum; i++)
+    {
+        pEncData[i] = m_encTestFactory.GetEncTestData("HEVC-DualPipe");
+    }
+
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        if (platforms[i] != igfxSKLAKE ||
+            !m_encTestCfg.IsEncTestEnabled(DeviceConfigTable[platforms[i]], pEncData[0]->GetFeatureID()))
+        {
+            continue;
+        }
+
+        int32_t dsWalkerNum[2] = {};
+        for (int sharedRaw = 0; sharedRaw < 2; sharedRaw++)
+        {
+            CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+            EncodeMfeExecute(pEncData, streamNum, platforms[i], sharedRaw);
+            dsWalkerNum[sharedRaw] = m_driverLoader.GetUltCounter(MOS_ULT_COUNTER_ENCODE_DS_WALKERS);
+        }
+
+        // Release drivers do not count the downscaling walkers
+        if (dsWalkerNum[0] < 0)
+        {
+            break;
+        }
+
+        // Each stream downscales its own raw surfaces, the same number of walkers per stream
+        EXPECT_LT(0, dsWalkerNum[0]) << "Platform = " << g_platformName[platforms[i]] << endl;
+        EXPECT_EQ(0, dsWalkerNum[0] % streamNum) << "Platform = " << g_platformName[platforms[i]] << endl;
+        EXPECT_EQ(dsWalkerNum[0] / streamNum, dsWalkerNum[1]) << "Platform = " << g_platformName[platforms[i]]
+            << ", the shared raw surfaces were not downscaled exactly once" << endl;
+    }
+
+    for (int i = 0; i < streamNum; i++)
+    {
+        delete pEncData[i];
+    }
+}
+
+void MediaEncodeDdiTest::ExectueEncodeTest(EncTestData *pEncData, bool syncEachFrame)
 {
     vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
     for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
@@ -48,12 +824,13 @@ void MediaEncodeDdiTest::ExectueEncodeTest(EncTestData *pEncData)
             pEncData->GetFeatureID()))
         {
             CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
-            EncodeExecute(pEncData, platforms[i]);
+            EncodeExecute(pEncData, platforms[i], syncEachFrame);
         }
     }
 }
 
-void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platform)
+void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platform, bool syncEachFrame,
+                                       const function<void(int)> &frameDone, VAStatus endPictureStatus)
 {
     VAConfigID      config_id;
     VAContextID     context_id;
@@ -80,7 +857,7 @@ void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platfor
         << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
 
     ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id, pEncData->GetWidth(),
-        pEncData->GetHeight(), VA_PROGRESSIVE, &resources[0], resources.size(), &context_id);
+        pEncData->GetHeight(), pEncData->GetContextFlag(), &resources[0], resources.size(), &context_id);
     EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
         << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
 
@@ -88,24 +865,35 @@ void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platfor
     {
         ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id,resources[0]);
 
+        // The coded buffers are created first, so that the parameters can refer to them.
         vector<vector<CompBufConif>> &compBufs = pEncData->GetCompBuffers();
-        ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id, compBufs[i][0].bufType,
-            compBufs[i][0].bufSize, 1, compBufs[i][0].pData, &compBufs[i][0].bufID);
-        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
-            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+        for (int j = 0; j < compBufs[i].size(); j++)
+        {
+            if (compBufs[i][j].bufType != VAEncCodedBufferType)
+            {
+                continue;
+            }
+            ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id, compBufs[i][j].bufType,
+                compBufs[i][j].bufSize, 1, compBufs[i][j].pData, &compBufs[i][j].bufID);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+        }
 
         pEncData->UpdateCompBuffers(i);
-        for (int j = 1; j < compBufs[i].size(); j++)
+        for (int j = 0; j < compBufs[i].size(); j++)
         {
-            ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
-                compBufs[i][j].bufType, compBufs[i][j].bufSize, 1, compBufs[i][j].pData, &compBufs[i][j].bufID);
+            if (compBufs[i][j].bufType == VAEncCodedBufferType)
+            {
+                continue;
+            }
+            ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id, compBufs[i][j].bufType,
+                compBufs[i][j].bufSize, compBufs[i][j].bufNum, compBufs[i][j].pData, &compBufs[i][j].bufID);
             EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
                 << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
 
             // In RenderPicture, it suppose all needed buffer has been created already.
-            // Suppose the compBufs[0] is always EncCodedBuffer, so we won't render it.
-            // If we render it, the ret is still Success, but would with log"not supported
-            // buffer type in vpgEncodeRenderPicture."
+            // The EncCodedBuffers are not rendered. If we render them, the ret is still
+            // Success, but would with log"not supported buffer type in vpgEncodeRenderPicture."
             ret = m_driverLoader.m_ctx.vtable->vaRenderPicture(&m_driverLoader.m_ctx,
                 context_id, &compBufs[i][j].bufID, 1);
             EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
@@ -113,9 +901,14 @@ void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platfor
         }
 
         ret = m_driverLoader.m_ctx.vtable->vaEndPicture(&m_driverLoader.m_ctx, context_id);
-        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        EXPECT_EQ(endPictureStatus, ret) << "Platform = " << g_platformName[platform]
             << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
 
+        if (!syncEachFrame && i < pEncData->m_num_frames - 1)
+        {
+            continue;
+        }
+
         ret = m_driverLoader.m_ctx.vtable->vaSyncSurface(&m_driverLoader.m_ctx, resources[0]);
         EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
             << ", Failed function = m_driverLoader.m_ctx.vtable->vaSyncSurface" << endl;
@@ -126,11 +919,19 @@ void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platfor
                 resources[0], &surface_status);
         } while (surface_status != VASurfaceReady);
 
-        for (int j = 0; j < compBufs[i].size(); j++)
+        for (int f = syncEachFrame ? i : 0; f <= i; f++)
         {
-            ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, compBufs[i][j].bufID);
-            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
-                << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+            for (size_t j = 0; j < compBufs[f].size(); j++)
+            {
+                ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, compBufs[f][j].bufID);
+                EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                    << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+            }
+        }
+
+        if (frameDone)
+        {
+            frameDone(i);
         }
       }
 
@@ -152,15 +953,145 @@ void MediaEncodeDdiTest::EncodeExecute(EncTestData *pEncData, Platform_t platfor
         << ", Failed function = m_driverLoader.CloseDriver" << endl;
 }
 
+void MediaEncodeDdiTest::EncodeMfeExecute(EncTestData *pEncData[], int streamNum, Platform_t platform, bool sharedRaw)
+{
+    vector<VAConfigID>  config_id(streamNum);
+    vector<VAContextID> context_id(streamNum);
+    VAMFContextID       mfe_context;
+
+    int ret = m_driverLoader.InitDriver(platform);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateMFContext(&m_driverLoader.m_ctx, &mfe_context);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateMFContext" << endl;
+
+    for (int s = 0; s < streamNum; s++)
+    {
+        ret = m_driverLoader.m_ctx.vtable->vaCreateConfig(&m_driverLoader.m_ctx,
+            pEncData[s]->GetFeatureID().profile, pEncData[s]->GetFeatureID().entrypoint,
+            (VAConfigAttrib *)&(pEncData[s]->GetConfAttrib()[0]), pEncData[s]->GetConfAttrib().size(), &config_id[s]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+        vector<VASurfaceID> &resources = pEncData[s]->GetResources();
+        ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+            pEncData[s]->GetWidth(), pEncData[s]->GetHeight(), &resources[0], resources.size(),
+            (VASurfaceAttrib *)&(pEncData[s]->GetSurfAttrib()[0]), pEncData[s]->GetSurfAttrib().size());
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id[s], pEncData[s]->GetWidth(),
+            pEncData[s]->GetHeight(), VA_PROGRESSIVE, &resources[0], resources.size(), &context_id[s]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaMFAddContext(&m_driverLoader.m_ctx, context_id[s], mfe_context);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaMFAddContext" << endl;
+    }
+
+    for (int i = 0; i < pEncData[0]->m_num_frames; i++)
+    {
+        for (int s = 0; s < streamNum; s++)
+        {
+            // with a shared raw surface, all the streams encode the raw surface of the first one
+            vector<VASurfaceID> &resources = pEncData[sharedRaw ? 0 : s]->GetResources();
+            ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id[s], resources[0]);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaBeginPicture" << endl;
+
+            vector<vector<CompBufConif>> &compBufs = pEncData[s]->GetCompBuffers();
+            ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id[s], compBufs[i][0].bufType,
+                compBufs[i][0].bufSize, 1, compBufs[i][0].pData, &compBufs[i][0].bufID);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+            pEncData[s]->UpdateCompBuffers(i);
+            for (int j = 1; j < compBufs[i].size(); j++)
+            {
+                ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id[s],
+                    compBufs[i][j].bufType, compBufs[i][j].bufSize, 1, compBufs[i][j].pData, &compBufs[i][j].bufID);
+                EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                    << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+                ret = m_driverLoader.m_ctx.vtable->vaRenderPicture(&m_driverLoader.m_ctx,
+                    context_id[s], &compBufs[i][j].bufID, 1);
+                EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                    << ", Failed function = m_driverLoader.m_ctx.vtable->vaRenderPicture" << endl;
+            }
+
+            // With MFE, EndPicture only prepares the frame, it is executed by vaMFSubmit.
+            ret = m_driverLoader.m_ctx.vtable->vaEndPicture(&m_driverLoader.m_ctx, context_id[s]);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
+        }
+
+        ret = m_driverLoader.m_ctx.vtable->vaMFSubmit(&m_driverLoader.m_ctx, mfe_context, &context_id[0], streamNum);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaMFSubmit" << endl;
+
+        for (int s = 0; s < streamNum; s++)
+        {
+            vector<VASurfaceID> &resources = pEncData[s]->GetResources();
+            ret = m_driverLoader.m_ctx.vtable->vaSyncSurface(&m_driverLoader.m_ctx, resources[0]);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaSyncSurface" << endl;
+
+            vector<vector<CompBufConif>> &compBufs = pEncData[s]->GetCompBuffers();
+            for (size_t j = 0; j < compBufs[i].size(); j++)
+            {
+                ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, compBufs[i][j].bufID);
+                EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                    << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+            }
+        }
+    }
+
+    for (int s = 0; s < streamNum; s++)
+    {
+        ret = m_driverLoader.m_ctx.vtable->vaMFReleaseContext(&m_driverLoader.m_ctx, context_id[s], mfe_context);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaMFReleaseContext" << endl;
+
+        vector<VASurfaceID> &resources = pEncData[s]->GetResources();
+        ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx,
+            &resources[0], resources.size());
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, context_id[s]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaDestroyConfig(&m_driverLoader.m_ctx, config_id[s]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyConfig" << endl;
+    }
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, mfe_context);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+}
+
 EncodeTestConfig::EncodeTestConfig()
 {
     m_mapPlatformFeatureID[DeviceConfigTable[igfxSKLAKE]]     = {
         TEST_Intel_Encode_HEVC,
         TEST_Intel_Encode_AVC ,
+        TEST_Intel_Encode_AVC_VDEnc,
+        TEST_Intel_Encode_JPEG,
     };
     m_mapPlatformFeatureID[DeviceConfigTable[igfxBROXTON]]    = {
         TEST_Intel_Encode_HEVC,
         TEST_Intel_Encode_AVC ,
+        TEST_Intel_Encode_AVC_VDEnc,
+        TEST_Intel_Encode_JPEG,
     };
     m_mapPlatformFeatureID[DeviceConfigTable[igfxBROADWELL]]  = {
         TEST_Intel_Encode_AVC ,
@@ -183,3 +1114,100 @@ bool EncodeTestConfig::IsEncTestEnabled(DeviceConfig platform, FeatureID feature
 
     return false;
 }
+
+void MediaEncodeDdiTest::EncodeBufferCycleExecute(EncTestData *pEncData, Platform_t platform, uint32_t frameNum)
+{
+    VAConfigID  config_id;
+    VAContextID context_id;
+
+    int ret = m_driverLoader.InitDriver(platform);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateConfig(&m_driverLoader.m_ctx,
+        pEncData->GetFeatureID().profile, pEncData->GetFeatureID().entrypoint,
+        (VAConfigAttrib *)&(pEncData->GetConfAttrib()[0]), pEncData->GetConfAttrib().size(), &config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+    vector<VASurfaceID> &resources = pEncData->GetResources();
+    ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+        pEncData->GetWidth(), pEncData->GetHeight(), &resources[0], resources.size(),
+        (VASurfaceAttrib *)&(pEncData->GetSurfAttrib()[0]), pEncData->GetSurfAttrib().size());
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id, pEncData->GetWidth(),
+        pEncData->GetHeight(), VA_PROGRESSIVE, &resources[0], resources.size(), &context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
+
+    // compBufs[0][0] is the coded buffer, it is created once per stream by applications.
+    // The parameter buffers are CPU buffers, the disable skip map adds a BO buffer.
+    vector<CompBufConif> compBufs(pEncData->GetCompBuffers()[0].begin() + 1, pEncData->GetCompBuffers()[0].end());
+    vector<uint8_t>      skipMap(((pEncData->GetWidth() + 15) / 16) * ((pEncData->GetHeight() + 15) / 16), 1);
+    compBufs.push_back({ VAEncMacroblockDisableSkipMapBufferType, (uint32_t)skipMap.size(), &skipMap[0], 0 });
+
+    int32_t firstFrameAllocs = -1;
+    for (uint32_t i = 0; i < frameNum; i++)
+    {
+        for (size_t j = 0; j < compBufs.size(); j++)
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
+                compBufs[j].bufType, compBufs[j].bufSize, 1, compBufs[j].pData, &compBufs[j].bufID);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+            void *data = nullptr;
+            ret = m_driverLoader.m_ctx.vtable->vaMapBuffer(&m_driverLoader.m_ctx, compBufs[j].bufID, &data);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaMapBuffer" << endl;
+            EXPECT_EQ(0, memcmp(data, compBufs[j].pData, compBufs[j].bufSize)) << "Platform = "
+                << g_platformName[platform] << ", recycled buffer does not hold the data it was created with" << endl;
+
+            ret = m_driverLoader.m_ctx.vtable->vaUnmapBuffer(&m_driverLoader.m_ctx, compBufs[j].bufID);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaUnmapBuffer" << endl;
+        }
+
+        for (size_t j = 0; j < compBufs.size(); j++)
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, compBufs[j].bufID);
+            EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+                << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+        }
+
+        if (i == 0)
+        {
+            firstFrameAllocs = m_driverLoader.GetUltCounter(MOS_ULT_COUNTER_ENCODE_BUFFER_POOL_ALLOCS);
+        }
+    }
+
+    // Release drivers do not count the allocations
+    if (firstFrameAllocs >= 0)
+    {
+        EXPECT_LT(0, firstFrameAllocs) << "Platform = " << g_platformName[platform]
+            << ", no buffer was created from the buffer pool" << endl;
+        EXPECT_EQ(firstFrameAllocs, m_driverLoader.GetUltCounter(MOS_ULT_COUNTER_ENCODE_BUFFER_POOL_ALLOCS))
+            << "Platform = " << g_platformName[platform]
+            << ", buffers of the frames after the first were not taken back from the buffer pool" << endl;
+    }
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx,
+        &resources[0], resources.size());
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    // Destroying the context releases the retained buffers, CloseDriver checks nothing leaked
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyConfig(&m_driverLoader.m_ctx, config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyConfig" << endl;
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+}
@@ -22,6 +22,7 @@
 #ifndef __DDI_TEST_ENCODE_H__
 #define __DDI_TEST_ENCODE_H__
 
+#include <functional>
 #include "cmd_validator.h"
 #include "driver_loader.h"
 #include "gtest/gtest.h"
@@ -50,9 +51,17 @@ protected:
 
     virtual void TearDown() { }
 
-    void EncodeExecute(EncTestData *pDecData, Platform_t platform);
+    // frameDone is called with the frame index once each synced frame completed.
+    // vaEndPicture is expected to return endPictureStatus for every frame.
+    void EncodeExecute(EncTestData *pDecData, Platform_t platform, bool syncEachFrame = true,
+                       const std::function<void(int)> &frameDone = nullptr,
+                       VAStatus endPictureStatus = VA_STATUS_SUCCESS);
 
-    void ExectueEncodeTest(EncTestData *pDecData);
+    void ExectueEncodeTest(EncTestData *pDecData, bool syncEachFrame = true);
+
+    void EncodeMfeExecute(EncTestData *pEncData[], int streamNum, Platform_t platform, bool sharedRaw = false);
+
+    void EncodeBufferCycleExecute(EncTestData *pEncData, Platform_t platform, uint32_t frameNum);
 
 protected:
 
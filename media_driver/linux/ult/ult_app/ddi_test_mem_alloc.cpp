@@ -0,0 +1,178 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <thread>
+#include "ddi_test_mem_alloc.h"
+
+using namespace std;
+
+// Per-frame DDI objects such as DDI_MEDIA_BUFFER and CPU parameter buffers come from the
+// MOS small block pool and update the sharded MemNinja counter, exercise both from many threads.
+TEST_F(MediaMemAllocDdiTest, MultiThreadCreateDestroyBuffer)
+{
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        CreateDecodeContext(platforms[i]);
+
+        int32_t counterBefore = m_driverLoader.GetDriverSymbols().MOS_GetCurrentMemNinjaCounter();
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> threads;
+        for (uint32_t t = 0; t < m_threadNum; t++)
+        {
+            threads.push_back(thread([this]() { CreateDestroyBuffers(m_iterations); }));
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+        auto end = chrono::steady_clock::now();
+
+        int32_t counterAfter = m_driverLoader.GetDriverSymbols().MOS_GetCurrentMemNinjaCounter();
+        EXPECT_EQ(counterBefore, counterAfter) << "Platform = " << g_platformName[platforms[i]]
+            << ", MemNinja counter changed across balanced create/destroy" << endl;
+
+        double ns = (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+        printf("[ PERF     ] Platform = %s, %u threads, %.1f ns per vaCreateBuffer/vaDestroyBuffer pair\n",
+            g_platformName[platforms[i]], m_threadNum, ns / (m_threadNum * m_iterations));
+
+        DestroyDecodeContext(platforms[i]);
+    }
+}
+
+// Buffers created on one thread and destroyed on another decrement a different counter
+// shard than they incremented, the aggregated counter must still balance.
+TEST_F(MediaMemAllocDdiTest, LeakCounterCrossThreadFree)
+{
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        CreateDecodeContext(platforms[i]);
+
+        const DriverSymbols &drvSyms = m_driverLoader.GetDriverSymbols();
+        int32_t counterBefore        = drvSyms.MOS_GetCurrentMemNinjaCounter();
+
+        vector<VABufferID> bufIds(m_threadNum * 16, VA_INVALID_ID);
+        vector<thread>     threads;
+        for (uint32_t t = 0; t < m_threadNum; t++)
+        {
+            threads.push_back(thread([this, &bufIds, t]() {
+                VASliceParameterBufferH264 sliceParams = {};
+                for (uint32_t j = 0; j < 16; j++)
+                {
+                    m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, m_contextId,
+                        VASliceParameterBufferType, sizeof(sliceParams), 1, &sliceParams, &bufIds[t * 16 + j]);
+                }
+            }));
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+
+        int32_t counterOutstanding = drvSyms.MOS_GetCurrentMemNinjaCounter();
+        EXPECT_LT(counterBefore, counterOutstanding) << "Platform = " << g_platformName[platforms[i]]
+            << ", outstanding buffers are not counted" << endl;
+
+        thread releaser([this, &bufIds]() {
+            for (auto id : bufIds)
+            {
+                EXPECT_EQ(VA_STATUS_SUCCESS, m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, id));
+            }
+        });
+        releaser.join();
+
+        EXPECT_EQ(counterBefore, drvSyms.MOS_GetCurrentMemNinjaCounter()) << "Platform = "
+            << g_platformName[platforms[i]] << ", MemNinja counter not restored after cross thread free" << endl;
+
+        DestroyDecodeContext(platforms[i]);
+    }
+}
+
+void MediaMemAllocDdiTest::CreateDestroyBuffers(uint32_t iterations)
+{
+    VASliceParameterBufferH264 sliceParams = {};
+    VAPictureParameterBufferH264 picParams = {};
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        VABufferID sliceBuf = VA_INVALID_ID;
+        VABufferID picBuf   = VA_INVALID_ID;
+
+        VAStatus ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, m_contextId,
+            VASliceParameterBufferType, sizeof(sliceParams), 1, &sliceParams, &sliceBuf);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, m_contextId,
+            VAPictureParameterBufferType, sizeof(picParams), 1, &picParams, &picBuf);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, sliceBuf);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, picBuf);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+    }
+}
+
+void MediaMemAllocDdiTest::CreateDecodeContext(Platform_t platform)
+{
+    int ret = m_driverLoader.InitDriver(platform);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateConfig(&m_driverLoader.m_ctx, VAProfileH264Main,
+        VAEntrypointVLD, nullptr, 0, &m_configId);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+        64, 64, &m_surface, 1, nullptr, 0);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, m_configId, 64, 64,
+        VA_PROGRESSIVE, &m_surface, 1, &m_contextId);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
+}
+
+void MediaMemAllocDdiTest::DestroyDecodeContext(Platform_t platform)
+{
+    int ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, &m_surface, 1);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, m_contextId);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyConfig(&m_driverLoader.m_ctx, m_configId);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyConfig" << endl;
+
+    // CloseDriver checks the MemNinja counter reported at MOS close is back to 0
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+}
@@ -0,0 +1,351 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include "ddi_test_vp.h"
+#include "mhw_render_hwcmd_g9_X.h"
+#include "mhw_vebox_hwcmd_g9_X.h"
+
+using namespace std;
+
+TEST_F(MediaVpDdiTest, VpFast1toN_SingleWalker)
+{
+    // The fast 1toN kernel writes all the outputs of a frame, so every frame is
+    // one media walker whatever the number of outputs. The kernel and its AVS
+    // samplers are set up once and reused by the following frames.
+    const uint32_t frameNum = 3;
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    uint32_t walkerHeader = mhw_render_g9_X::MEDIA_OBJECT_WALKER_CMD().DW0.Value;
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        // Fast 1toN is a Gen9 render path
+        if (platforms[i] != igfxSKLAKE && platforms[i] != igfxBROXTON)
+        {
+            continue;
+        }
+
+        for (uint32_t outputNum = 2; outputNum <= 3; outputNum++)
+        {
+            CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+            cmdValidator->StartCapture();
+            VpExecute(platforms[i], outputNum, frameNum);
+            vector<vector<uint32_t>> cmdBufs = cmdValidator->StopCapture();
+
+            uint32_t walkerCmdBufNum = 0;
+            for (auto &cmdBuf : cmdBufs)
+            {
+                uint32_t walkerNum = (uint32_t)count(cmdBuf.begin(), cmdBuf.end(), walkerHeader);
+                if (walkerNum == 0)
+                {
+                    continue;
+                }
+                walkerCmdBufNum++;
+                EXPECT_EQ(1, walkerNum) << "Platform = " << g_platformName[platforms[i]]
+                    << ", outputs = " << outputNum << endl;
+            }
+            EXPECT_EQ(frameNum, walkerCmdBufNum) << "Platform = " << g_platformName[platforms[i]]
+                << ", outputs = " << outputNum << endl;
+        }
+    }
+}
+
+TEST_F(MediaVpDdiTest, VpAutoDenoise_CpuUpdateDndiState)
+{
+    // The CPU auto denoise update maps the noise levels measured by VEBOX to
+    // the denoise slider. VEBOX does not run here, so the GNE statistics stay
+    // zero and every frame must get the DNDI state of the weakest slider, not
+    // the auto detect defaults the DN update kernel would start from.
+    const uint32_t frameNum = 3;
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        // Only the Gen9 DNDI state layout is parsed
+        if (platforms[i] != igfxSKLAKE && platforms[i] != igfxBROXTON)
+        {
+            continue;
+        }
+
+        m_driverLoader.SetUserFeature("VEBOX Force Auto Denoise", "1");
+        m_driverLoader.SetUserFeature("VEBOX Auto Denoise Update Mode", "1");
+        CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+        cmdValidator->StartCapture(mhw_vebox_g9_X::VEBOX_DNDI_STATE_CMD::dwSize);
+        VpDenoiseExecute(platforms[i], 0.0F, frameNum);
+        vector<vector<uint32_t>> autoStates = GetDndiStates(cmdValidator->StopCapture());
+        bool userFeatureApplied = m_driverLoader.IsUserFeatureApplied();
+        m_driverLoader.SetUserFeature("VEBOX Force Auto Denoise", nullptr);
+        m_driverLoader.SetUserFeature("VEBOX Auto Denoise Update Mode", nullptr);
+
+        // Auto denoise can only be forced by the debug user features
+        if (!userFeatureApplied)
+        {
+            break;
+        }
+
+        CmdValidator::GpuCmdsValidationInit(nullptr, platforms[i]);
+        cmdValidator->StartCapture(mhw_vebox_g9_X::VEBOX_DNDI_STATE_CMD::dwSize);
+        VpDenoiseExecute(platforms[i], 0.0F, frameNum);
+        vector<vector<uint32_t>> sliderStates = GetDndiStates(cmdValidator->StopCapture());
+
+        ASSERT_EQ(frameNum, autoStates.size()) << "Platform = " << g_platformName[platforms[i]] << endl;
+        ASSERT_EQ(frameNum, sliderStates.size()) << "Platform = " << g_platformName[platforms[i]] << endl;
+        for (uint32_t n = 0; n < frameNum; n++)
+        {
+            auto dndiState = (const mhw_vebox_g9_X::VEBOX_DNDI_STATE_CMD *)autoStates[n].data();
+
+            // Weakest slider of the Gen9 tables
+            EXPECT_EQ(64u, dndiState->DW1.LowTemporalDifferenceThreshold) << "Platform = "
+                << g_platformName[platforms[i]] << ", frame = " << n << endl;
+            EXPECT_EQ(128u, dndiState->DW1.TemporalDifferenceThreshold) << "Platform = "
+                << g_platformName[platforms[i]] << ", frame = " << n << endl;
+            EXPECT_EQ(sliderStates[n], autoStates[n]) << "Platform = "
+                << g_platformName[platforms[i]] << ", frame = " << n << endl;
+        }
+    }
+}
+
+vector<vector<uint32_t>> MediaVpDdiTest::GetDndiStates(const vector<vector<uint32_t>> &cmdBufs)
+{
+    // DW2 and DW3 of VEBOX_STATE hold the DNDI state address
+    const uint32_t dndiPointerDword = 2;
+    CmdValidator *cmdValidator = CmdValidator::GetInstance();
+    uint32_t veboxStateHeader = mhw_vebox_g9_X::VEBOX_STATE_CMD().DW0.Value;
+    vector<vector<uint32_t>> dndiStates;
+
+    const auto &patches = cmdValidator->GetCapturedPatches();
+    for (size_t b = 0; b < cmdBufs.size() && b < patches.size(); b++)
+    {
+        for (size_t j = 0; j < cmdBufs[b].size(); j++)
+        {
+            if (cmdBufs[b][j] != veboxStateHeader)
+            {
+                continue;
+            }
+            uint32_t pointerOffset = (uint32_t)((j + dndiPointerDword) * sizeof(uint32_t));
+            for (const auto &patch : patches[b])
+            {
+                if (patch.patchOffset == pointerOffset && !patch.target.empty())
+                {
+                    dndiStates.push_back(patch.target);
+                    break;
+                }
+            }
+        }
+    }
+
+    return dndiStates;
+}
+
+void MediaVpDdiTest::VpExecute(Platform_t platform, uint32_t outputNum, uint32_t frameNum)
+{
+    const uint32_t  srcWidth    = 1920;
+    const uint32_t  srcHeight   = 1080;
+    const uint32_t  dstWidth[]  = { 1280, 640, 320 };
+    const uint32_t  dstHeight[] = { 720, 360, 180 };
+    VAConfigID      config_id;
+    VAContextID     context_id;
+    VASurfaceID     srcSurface;
+    VASurfaceID     dstSurfaces[3];
+    VASurfaceStatus surface_status;
+
+    ASSERT_LE(outputNum, sizeof(dstSurfaces) / sizeof(dstSurfaces[0]));
+
+    int ret = m_driverLoader.InitDriver(platform);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateConfig(&m_driverLoader.m_ctx,
+        VAProfileNone, VAEntrypointVideoProc, nullptr, 0, &config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+        srcWidth, srcHeight, &srcSurface, 1, nullptr, 0);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+
+    for (uint32_t i = 0; i < outputNum; i++)
+    {
+        ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+            dstWidth[i], dstHeight[i], &dstSurfaces[i], 1, nullptr, 0);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+    }
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id, srcWidth,
+        srcHeight, VA_PROGRESSIVE, dstSurfaces, outputNum, &context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
+
+    for (uint32_t n = 0; n < frameNum; n++)
+    {
+        VAProcPipelineParameterBuffer pipelineParam = {};
+        VABufferID                    bufID;
+
+        pipelineParam.surface                = srcSurface;
+        pipelineParam.additional_outputs     = &dstSurfaces[1];
+        pipelineParam.num_additional_outputs = outputNum - 1;
+
+        ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id, dstSurfaces[0]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaBeginPicture" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
+            VAProcPipelineParameterBufferType, sizeof(pipelineParam), 1, &pipelineParam, &bufID);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaRenderPicture(&m_driverLoader.m_ctx, context_id, &bufID, 1);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaRenderPicture" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaEndPicture(&m_driverLoader.m_ctx, context_id);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
+
+        do
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaQuerySurfaceStatus(
+                &m_driverLoader.m_ctx, dstSurfaces[0], &surface_status);
+        } while (surface_status != VASurfaceReady);
+
+        ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, bufID);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+    }
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, dstSurfaces, outputNum);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, &srcSurface, 1);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyConfig(&m_driverLoader.m_ctx, config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyConfig" << endl;
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+}
+
+void MediaVpDdiTest::VpDenoiseExecute(Platform_t platform, float denoiseFactor, uint32_t frameNum)
+{
+    const uint32_t  width  = 1920;
+    const uint32_t  height = 1080;
+    VAConfigID      config_id;
+    VAContextID     context_id;
+    VASurfaceID     surfaces[2];
+    VABufferID      filterBufID;
+    VASurfaceStatus surface_status;
+
+    int ret = m_driverLoader.InitDriver(platform);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateConfig(&m_driverLoader.m_ctx,
+        VAProfileNone, VAEntrypointVideoProc, nullptr, 0, &config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateConfig" << endl;
+
+    // surfaces[0] is the source, surfaces[1] the render target
+    ret = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2(&m_driverLoader.m_ctx, VA_RT_FORMAT_YUV420,
+        width, height, surfaces, 2, nullptr, 0);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateSurfaces2" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaCreateContext(&m_driverLoader.m_ctx, config_id, width,
+        height, VA_PROGRESSIVE, &surfaces[1], 1, &context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
+
+    VAProcFilterParameterBuffer denoiseParam = {};
+    denoiseParam.type  = VAProcFilterNoiseReduction;
+    denoiseParam.value = denoiseFactor;
+    ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
+        VAProcFilterParameterBufferType, sizeof(denoiseParam), 1, &denoiseParam, &filterBufID);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+    for (uint32_t n = 0; n < frameNum; n++)
+    {
+        VAProcPipelineParameterBuffer pipelineParam = {};
+        VABufferID                    bufID;
+
+        pipelineParam.surface     = surfaces[0];
+        pipelineParam.filters     = &filterBufID;
+        pipelineParam.num_filters = 1;
+
+        ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id, surfaces[1]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaBeginPicture" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaCreateBuffer(&m_driverLoader.m_ctx, context_id,
+            VAProcPipelineParameterBufferType, sizeof(pipelineParam), 1, &pipelineParam, &bufID);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateBuffer" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaRenderPicture(&m_driverLoader.m_ctx, context_id, &bufID, 1);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaRenderPicture" << endl;
+
+        ret = m_driverLoader.m_ctx.vtable->vaEndPicture(&m_driverLoader.m_ctx, context_id);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
+
+        do
+        {
+            ret = m_driverLoader.m_ctx.vtable->vaQuerySurfaceStatus(
+                &m_driverLoader.m_ctx, surfaces[1], &surface_status);
+        } while (surface_status != VASurfaceReady);
+
+        ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, bufID);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+    }
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyBuffer(&m_driverLoader.m_ctx, filterBufID);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyBuffer" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyContext(&m_driverLoader.m_ctx, context_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyContext" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, surfaces, 2);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
+
+    ret = m_driverLoader.m_ctx.vtable->vaDestroyConfig(&m_driverLoader.m_ctx, config_id);
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroyConfig" << endl;
+
+    ret = m_driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+}
@@ -0,0 +1,56 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef __DDI_TEST_VP_H__
+#define __DDI_TEST_VP_H__
+
+#include "cmd_validator.h"
+#include "driver_loader.h"
+#include "gtest/gtest.h"
+#include "memory_leak_detector.h"
+#include "test_data_caps.h"
+
+class MediaVpDdiTest : public testing::Test
+{
+protected:
+
+    virtual void SetUp() { }
+
+    virtual void TearDown() { }
+
+    // Scales one NV12 surface to outputNum NV12 surfaces, the first one is the
+    // render target and the others are additional outputs, for frameNum frames.
+    void VpExecute(Platform_t platform, uint32_t outputNum, uint32_t frameNum);
+
+    // Denoises one NV12 surface into the render target with the VA noise
+    // reduction filter at denoiseFactor, for frameNum frames.
+    void VpDenoiseExecute(Platform_t platform, float denoiseFactor, uint32_t frameNum);
+
+    // VEBOX DNDI states of the command buffers returned by the last
+    // CmdValidator::StopCapture, one per VEBOX_STATE.
+    std::vector<std::vector<uint32_t>> GetDndiStates(const std::vector<std::vector<uint32_t>> &cmdBufs);
+
+protected:
+
+    DriverDllLoader     m_driverLoader;
+};
+
+#endif // __DDI_TEST_VP_H__
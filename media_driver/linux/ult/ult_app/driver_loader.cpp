@@ -45,6 +45,13 @@ extern "C" void MOS_Message(
 #endif
 
 void UltGetCmdBuf(PMOS_COMMAND_BUFFER pCmdBuffer);
+void UltGetAllocationList(
+    PALLOCATION_LIST    pAllocationList,
+    uint32_t            uiNumAllocations,
+    uint32_t            uiMaxNumAllocations,
+    PPATCHLOCATIONLIST  pPatchLocationList,
+    uint32_t            uiNumPatchLocations,
+    uint32_t            uiMaxPatchLocations);
 
 extern char               *g_driverPath;
 extern vector<Platform_t> g_platform;
@@ -94,6 +101,11 @@ VAStatus DriverDllLoader::CloseDriver(bool detectMemLeak)
 {
     VAStatus vaStatus = m_ctx.vtable->vaTerminate(&m_ctx);
 
+    for (uint32_t i = 0; i < MOS_ULT_COUNTER_MAX; i++)
+    {
+        m_ultCounterClosed[i] = GetUltCounter((MOS_ULT_COUNTER)i);
+    }
+
     if (detectMemLeak)
     {
         MemoryLeakDetector::Detect(m_drvSyms.MOS_GetMemNinjaCounter(),
@@ -112,6 +124,33 @@ VAStatus DriverDllLoader::CloseDriver(bool detectMemLeak)
     return vaStatus;
 }
 
+int32_t DriverDllLoader::GetUltCounter(MOS_ULT_COUNTER counter) const
+{
+    if (counter >= MOS_ULT_COUNTER_MAX)
+    {
+        return -1;
+    }
+    if (!m_drvSyms.MOS_GetUltCounter)
+    {
+        return m_ultCounterClosed[counter];
+    }
+
+    int32_t value = m_drvSyms.MOS_GetUltCounter(counter);
+    return (value < 0 || m_ultCounterBase[counter] < 0) ? -1 : value - m_ultCounterBase[counter];
+}
+
+void DriverDllLoader::SetUserFeature(const char *valueName, const char *value)
+{
+    if (value)
+    {
+        m_userFeatures[valueName] = value;
+    }
+    else
+    {
+        m_userFeatures.erase(valueName);
+    }
+}
+
 VAStatus DriverDllLoader::InitDriver(Platform_t platform_id)
 {
     int drm_fd           = platform_id + 1 < 0 ? 1 : platform_id + 1;
@@ -129,6 +168,26 @@ VAStatus DriverDllLoader::InitDriver(Platform_t platform_id)
     }
     m_drvSyms.MOS_SetUltFlag(1);
     *m_drvSyms.ppfnUltGetCmdBuf = UltGetCmdBuf;
+    if (m_drvSyms.ppfnUltGetAllocationList)
+    {
+        *m_drvSyms.ppfnUltGetAllocationList = m_allocationListHook ? m_allocationListHook : UltGetAllocationList;
+    }
+    m_userFeatureApplied = false;
+    if (m_drvSyms.MOS_SetUltUserFeature)
+    {
+        // The values of a previous driver instance may still be loaded
+        m_userFeatureApplied = m_drvSyms.MOS_SetUltUserFeature(nullptr, nullptr) != 0;
+        for (auto &userFeature : m_userFeatures)
+        {
+            m_userFeatureApplied &= m_drvSyms.MOS_SetUltUserFeature(userFeature.first.c_str(), userFeature.second.c_str()) != 0;
+        }
+    }
+    for (uint32_t i = 0; i < MOS_ULT_COUNTER_MAX; i++)
+    {
+        // The counters are per process, GetUltCounter reports the increments of this driver instance
+        m_ultCounterBase[i]   = m_drvSyms.MOS_GetUltCounter ? m_drvSyms.MOS_GetUltCounter(i) : -1;
+        m_ultCounterClosed[i] = -1;
+    }
     return m_drvSyms.__vaDriverInit_(&m_ctx);
 }
 
@@ -159,7 +218,11 @@ VAStatus DriverDllLoader::LoadDriverSymbols()
             m_drvSyms.MOS_SetUltFlag            = (MOS_SetUltFlagFunc)dlsym(m_umdhandle, "MOS_SetUltFlag");
             m_drvSyms.MOS_GetMemNinjaCounter    = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetMemNinjaCounter");
             m_drvSyms.MOS_GetMemNinjaCounterGfx = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetMemNinjaCounterGfx");
+            m_drvSyms.MOS_GetCurrentMemNinjaCounter = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetCurrentMemNinjaCounter");
             m_drvSyms.ppfnUltGetCmdBuf          = (UltGetCmdBufFunc *)dlsym(m_umdhandle, "pfnUltGetCmdBuf");
+            m_drvSyms.ppfnUltGetAllocationList  = (UltGetAllocationListFunc *)dlsym(m_umdhandle, "pfnUltGetAllocationList");
+            m_drvSyms.MOS_SetUltUserFeature     = (MOS_SetUltUserFeatureFunc)dlsym(m_umdhandle, "MOS_SetUltUserFeature");
+            m_drvSyms.MOS_GetUltCounter         = (MOS_GetUltCounterFunc)dlsym(m_umdhandle, "MOS_GetUltCounter");
             break;
         }
     }
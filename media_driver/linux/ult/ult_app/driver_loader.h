@@ -22,6 +22,8 @@
 #ifndef __DRIVER_LOADER_H__
 #define __DRIVER_LOADER_H__
 
+#include <map>
+#include <string>
 #include <vector>
 #include "devconfig.h"
 #include "mos_defs_specific.h"
@@ -59,6 +61,7 @@ struct CompBufConif
     uint32_t     bufSize;
     void*        pData;
     VABufferID   bufID;
+    uint32_t     bufNum = 1;    // Number of elements of bufSize bytes
 };
 
 typedef VAStatus (*CmExtSendReqMsgFunc)(
@@ -77,6 +80,18 @@ typedef int32_t (*MOS_GetMemNinjaCounterFunc)();
 
 typedef void (*UltGetCmdBufFunc)(PMOS_COMMAND_BUFFER pCmdBuffer);
 
+typedef void (*UltGetAllocationListFunc)(
+    PALLOCATION_LIST    pAllocationList,
+    uint32_t            uiNumAllocations,
+    uint32_t            uiMaxNumAllocations,
+    PPATCHLOCATIONLIST  pPatchLocationList,
+    uint32_t            uiNumPatchLocations,
+    uint32_t            uiMaxPatchLocations);
+
+typedef uint8_t (*MOS_SetUltUserFeatureFunc)(const char *valueName, const char *value);
+
+typedef int32_t (*MOS_GetUltCounterFunc)(uint32_t counter);
+
 struct DriverSymbols
 {
     bool Initialized() const
@@ -86,6 +101,7 @@ struct DriverSymbols
             !MOS_SetUltFlag            ||
             !MOS_GetMemNinjaCounter    ||
             !MOS_GetMemNinjaCounterGfx ||
+            !MOS_GetCurrentMemNinjaCounter ||
             !ppfnUltGetCmdBuf)
         {
             return false;
@@ -99,9 +115,13 @@ struct DriverSymbols
     MOS_SetUltFlagFunc          MOS_SetUltFlag;
     MOS_GetMemNinjaCounterFunc  MOS_GetMemNinjaCounter;
     MOS_GetMemNinjaCounterFunc  MOS_GetMemNinjaCounterGfx;
+    MOS_GetMemNinjaCounterFunc  MOS_GetCurrentMemNinjaCounter;
+    MOS_SetUltUserFeatureFunc   MOS_SetUltUserFeature;      // Optional, not checked by Initialized()
+    MOS_GetUltCounterFunc       MOS_GetUltCounter;          // Optional, not checked by Initialized()
 
     // Data
     UltGetCmdBufFunc            *ppfnUltGetCmdBuf;
+    UltGetAllocationListFunc    *ppfnUltGetAllocationList;  // Optional, not checked by Initialized()
 };
 
 class DriverDllLoader
@@ -122,6 +142,23 @@ public:
 
     VAStatus CloseDriver(bool detectMemLeak = true);
 
+    // Set the user feature valueName of the next InitDriver to value, instead
+    // of reading it from the user feature file. nullptr reads it from the file
+    // again. Ignored by release drivers.
+    void SetUserFeature(const char *valueName, const char *value);
+
+    // Whether the driver of the last InitDriver honored every SetUserFeature.
+    bool IsUserFeatureApplied() const { return m_userFeatureApplied; }
+
+    // Increments of counter since the last InitDriver, up to CloseDriver once
+    // the driver is closed. Negative if the driver does not count it.
+    int32_t GetUltCounter(MOS_ULT_COUNTER counter) const;
+
+    // Hook called with the allocation and patch lists of each submission of
+    // the next InitDriver. With nullptr, the command validator records the
+    // patch lists of the command buffers it captures.
+    void SetAllocationListHook(UltGetAllocationListFunc hook) { m_allocationListHook = hook; }
+
 public:
 
     VADriverContext             m_ctx;
@@ -139,6 +176,11 @@ private:
     DriverSymbols               m_drvSyms         = {};
     drm_state                   m_drmstate        = {};
     Platform_t                  m_currentPlatform = igfxSKLAKE;
+    std::map<std::string, std::string> m_userFeatures;
+    bool                        m_userFeatureApplied = false;
+    int32_t                     m_ultCounterBase[MOS_ULT_COUNTER_MAX] = {};    // Counters at InitDriver
+    int32_t                     m_ultCounterClosed[MOS_ULT_COUNTER_MAX] = {};  // Increments up to CloseDriver
+    UltGetAllocationListFunc    m_allocationListHook = nullptr;
     std::vector<Platform_t>     m_platformArray;
 };
 
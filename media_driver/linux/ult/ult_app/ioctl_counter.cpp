@@ -0,0 +1,66 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <dlfcn.h>
+#include <stdio.h>
+#include "i915_drm.h"
+#include "ioctl_counter.h"
+
+static const struct
+{
+    const char      *name;
+    unsigned long   request;
+} g_countedIoctls[IoctlCounter::IOCTL_NUM] = {
+    {"SET_DOMAIN",  DRM_IOCTL_I915_GEM_SET_DOMAIN},
+    {"MMAP",        DRM_IOCTL_I915_GEM_MMAP},
+    {"MMAP_GTT",    DRM_IOCTL_I915_GEM_MMAP_GTT},
+    {"BUSY",        DRM_IOCTL_I915_GEM_BUSY},
+    {"WAIT",        DRM_IOCTL_I915_GEM_WAIT},
+    {"EXECBUFFER2", DRM_IOCTL_I915_GEM_EXECBUFFER2},
+};
+
+IoctlCounter::IoctlCounter()
+{
+    m_getIoctlCount = (GetIoctlCountFunc)dlsym(RTLD_DEFAULT, "mos_mock_get_ioctl_count");
+}
+
+void IoctlCounter::Start()
+{
+    for (int i = 0; i < IOCTL_NUM; i++)
+    {
+        m_start[i] = m_getIoctlCount ? m_getIoctlCount(g_countedIoctls[i].request) : 0;
+    }
+}
+
+uint32_t IoctlCounter::GetCount(Ioctl ioctl) const
+{
+    return m_getIoctlCount ? m_getIoctlCount(g_countedIoctls[ioctl].request) - m_start[ioctl] : 0;
+}
+
+void IoctlCounter::Print(const char *platformName, uint32_t frameNum) const
+{
+    for (int i = 0; i < IOCTL_NUM; i++)
+    {
+        uint32_t count = GetCount((Ioctl)i);
+        printf("[ PERF     ] %s %-12s %6u ioctls, %8.2f per frame\n", platformName,
+            g_countedIoctls[i].name, count, frameNum ? (double)count / frameNum : 0.0);
+    }
+}
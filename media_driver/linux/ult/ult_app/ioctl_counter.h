@@ -0,0 +1,72 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef __IOCTL_COUNTER_H__
+#define __IOCTL_COUNTER_H__
+
+#include <stdint.h>
+#include "devconfig.h"
+
+// Reads the number of ioctls issued to the mock DRM, preloaded with the ULT.
+// Counts are taken since the last Start().
+class IoctlCounter
+{
+public:
+
+    enum Ioctl
+    {
+        SET_DOMAIN,
+        MMAP,
+        MMAP_GTT,
+        BUSY,
+        WAIT,
+        EXECBUFFER2,
+        IOCTL_NUM
+    };
+
+    IoctlCounter();
+
+    // False if the ULT doesn't run on the mock DRM.
+    bool IsAvailable() const { return m_getIoctlCount != nullptr; }
+
+    void Start();
+
+    uint32_t GetCount(Ioctl ioctl) const;
+
+    // SET_DOMAIN and MMAP ioctls, issued when a buffer is mapped for the CPU.
+    uint32_t GetMapCount() const { return GetCount(SET_DOMAIN) + GetCount(MMAP) + GetCount(MMAP_GTT); }
+
+    // False for the Atom SoCs, the driver maps their buffers through the GTT
+    // when they are locked and never persistently.
+    static bool HasPersistentMaps(Platform_t platform) { return platform != igfxBROXTON; }
+
+    // Prints the counts of each ioctl and per frame.
+    void Print(const char *platformName, uint32_t frameNum) const;
+
+private:
+
+    typedef uint32_t (*GetIoctlCountFunc)(unsigned long request);
+
+    GetIoctlCountFunc m_getIoctlCount = nullptr;
+    uint32_t          m_start[IOCTL_NUM] = {};
+};
+
+#endif // __IOCTL_COUNTER_H__
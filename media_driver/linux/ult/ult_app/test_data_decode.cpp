@@ -20,6 +20,7 @@
 * OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "test_data_decode.h"
+#include "media_libva_common.h"
 
 using namespace std;
 
@@ -290,3 +291,142 @@ void DecTestDataAVC::UpdateCompBuffers(int frameId)
         break;
     }
 }
+
+DecTestDataJPEG::DecTestDataJPEG(FeatureID testFeatureID, uint32_t imageNum)
+{
+    // Image k of the stream: width, height and luma sampling factors, chroma is not subsampled.
+    const struct
+    {
+        uint16_t width;
+        uint16_t height;
+        uint8_t  hFactor;
+        uint8_t  vFactor;
+    } images[DEC_FRAME_NUM] = {
+        { 320, 240, 2, 2 },  // YUV420
+        { 176, 144, 2, 1 },  // YUV422H2Y
+        {  64,  48, 1, 2 },  // YUV422V2Y
+    };
+
+    m_featureId   = testFeatureID;
+    m_picWidth    = 320;
+    m_picHeight   = 240;
+    m_imageNum    = imageNum;
+    m_surfacesNum = DEC_FRAME_NUM; // 1 target per image, no references.
+    m_num_frames  = DEC_FRAME_NUM;
+
+    // Batches are only parsed by contexts that opt in.
+    if (imageNum > 1)
+    {
+        m_contextFlag |= DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH;
+    }
+
+    m_confAttrib.resize(1);
+    m_confAttrib[0].type  = VAConfigAttribRTFormat;
+    m_confAttrib[0].value = VA_RT_FORMAT_YUV420;
+
+    m_resources.resize(m_surfacesNum);
+
+    // The scan data is not parsed by the mocked GPU.
+    m_bitstream.assign(1024, 0);
+
+    m_picParams.resize(DEC_FRAME_NUM);
+    m_slcParams.resize(DEC_FRAME_NUM);
+    m_procParams.resize(DEC_FRAME_NUM);
+    for (uint32_t k = 0; k < DEC_FRAME_NUM; k++)
+    {
+        VAPictureParameterBufferJPEGBaseline &picParams = m_picParams[k];
+        memset(&picParams, 0, sizeof(picParams));
+        picParams.picture_width  = images[k].width;
+        picParams.picture_height = images[k].height;
+        picParams.num_components = 3;
+        for (auto i = 0; i < 3; i++)
+        {
+            picParams.components[i].component_id             = i + 1;
+            picParams.components[i].h_sampling_factor        = (i == 0) ? images[k].hFactor : 1;
+            picParams.components[i].v_sampling_factor        = (i == 0) ? images[k].vFactor : 1;
+            picParams.components[i].quantiser_table_selector = (i == 0) ? 0 : 1;
+        }
+
+        VASliceParameterBufferJPEGBaseline &slcParams = m_slcParams[k];
+        memset(&slcParams, 0, sizeof(slcParams));
+        slcParams.slice_data_size   = m_bitstream.size();
+        slcParams.slice_data_offset = 0;
+        slcParams.slice_data_flag   = VA_SLICE_DATA_FLAG_ALL;
+        slcParams.num_components    = 3;
+        for (auto i = 0; i < 3; i++)
+        {
+            slcParams.components[i].component_selector = i + 1;
+            slcParams.components[i].dc_table_selector  = (i == 0) ? 0 : 1;
+            slcParams.components[i].ac_table_selector  = (i == 0) ? 0 : 1;
+        }
+        uint32_t mcuWidth  = 8 * images[k].hFactor;
+        uint32_t mcuHeight = 8 * images[k].vFactor;
+        slcParams.num_mcus = ((images[k].width + mcuWidth - 1) / mcuWidth) *
+                             ((images[k].height + mcuHeight - 1) / mcuHeight);
+
+        // Image k of a batch is decoded to surface k.
+        VAProcPipelineParameterBuffer &procParams = m_procParams[k];
+        memset(&procParams, 0, sizeof(procParams));
+        procParams.additional_outputs     = &m_resources[k];
+        procParams.num_additional_outputs = 1;
+    }
+
+    memset(&m_qMatrix, 0, sizeof(m_qMatrix));
+    m_qMatrix.load_quantiser_table[0] = 1;
+    m_qMatrix.load_quantiser_table[1] = 1;
+    for (auto i = 0; i < 64; i++)
+    {
+        m_qMatrix.quantiser_table[0][i] = 0x10;
+        m_qMatrix.quantiser_table[1][i] = 0x11;
+    }
+
+    // Luminance tables of ITU-T T.81 Annex K.3, loaded for luma and chroma.
+    const uint8_t dcCodes[16]  = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+    const uint8_t acCodes[16]  = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d };
+    const uint8_t acValues[162] = {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+        0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+        0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+        0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+        0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+        0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+        0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+        0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+        0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+        0xf9, 0xfa };
+
+    memset(&m_huffTable, 0, sizeof(m_huffTable));
+    for (auto t = 0; t < 2; t++)
+    {
+        m_huffTable.load_huffman_table[t] = 1;
+        memcpy(m_huffTable.huffman_table[t].num_dc_codes, dcCodes, sizeof(dcCodes));
+        memcpy(m_huffTable.huffman_table[t].num_ac_codes, acCodes, sizeof(acCodes));
+        memcpy(m_huffTable.huffman_table[t].ac_values, acValues, sizeof(acValues));
+        for (auto i = 0; i < 12; i++)
+        {
+            m_huffTable.huffman_table[t].dc_values[i] = i;
+        }
+    }
+
+    // A single frame decodes image i of the stream to the render target. A batch
+    // decodes all the images in each frame, after the first one each image sends
+    // its target in a VAProcPipelineParameterBuffer.
+    m_compBufs.resize(m_num_frames);
+    for (uint32_t i = 0; i < m_num_frames; i++)
+    {
+        for (uint32_t n = 0; n < m_imageNum; n++)
+        {
+            uint32_t k = (m_imageNum == 1) ? i : n;
+            m_compBufs[i].push_back({ VAPictureParameterBufferType, (uint32_t)sizeof(m_picParams[k]), (void *)&m_picParams[k], 0 });
+            if (n > 0)
+            {
+                m_compBufs[i].push_back({ VAProcPipelineParameterBufferType, (uint32_t)sizeof(m_procParams[k]), (void *)&m_procParams[k], 0 });
+            }
+            m_compBufs[i].push_back({ VAIQMatrixBufferType        , (uint32_t)sizeof(m_qMatrix)     , (void *)&m_qMatrix     , 0 });
+            m_compBufs[i].push_back({ VAHuffmanTableBufferType    , (uint32_t)sizeof(m_huffTable)   , (void *)&m_huffTable   , 0 });
+            m_compBufs[i].push_back({ VASliceParameterBufferType  , (uint32_t)sizeof(m_slcParams[k]), (void *)&m_slcParams[k], 0 });
+            m_compBufs[i].push_back({ VASliceDataBufferType       , (uint32_t)m_bitstream.size()    , (void *)&m_bitstream[0], 0 });
+        }
+    }
+}
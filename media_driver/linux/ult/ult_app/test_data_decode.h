@@ -32,6 +32,7 @@
 
 const FeatureID TEST_Intel_Decode_HEVC = { VAProfileHEVCMain, VAEntrypointVLD, };
 const FeatureID TEST_Intel_Decode_AVC  = { VAProfileH264Main, VAEntrypointVLD, };
+const FeatureID TEST_Intel_Decode_JPEG = { VAProfileJPEGBaseline, VAEntrypointVLD, };
 
 class DecBufHEVC
 {
@@ -101,6 +102,13 @@ public:
 
     std::vector<VAConfigAttrib> &GetConfAttrib() {return m_confAttrib; }
 
+    int32_t GetContextFlag() { return m_contextFlag; }
+
+    void SetContextFlag(int32_t flag) { m_contextFlag = flag; }
+
+    // Each frame is decoded to the first GetTargetNum() resources.
+    virtual uint32_t GetTargetNum() { return 1; }
+
     virtual void UpdateCompBuffers(int frameId) { }
 
 public:
@@ -116,6 +124,7 @@ protected:
     std::vector<std::vector<CompBufConif>> m_compBufs;
     std::vector<VASurfaceID>               m_resources;
     std::vector<VAConfigAttrib>            m_confAttrib;
+    int32_t                                m_contextFlag = VA_PROGRESSIVE;
 };
 
 class DecTestDataHEVC : public DecTestData
@@ -208,6 +217,29 @@ protected:
     void InitCompBuffers() { }
 };
 
+class DecTestDataJPEG : public DecTestData
+{
+public:
+
+    // Each frame sends imageNum images, decoded in one batch if more than 1.
+    // The images have different resolutions and chroma formats.
+    DecTestDataJPEG(FeatureID testFeatureID, uint32_t imageNum = 1);
+
+    uint32_t GetImageNum() { return m_imageNum; }
+
+    uint32_t GetTargetNum() override { return m_imageNum; }
+
+protected:
+
+    uint32_t                                          m_imageNum;
+    std::vector<VAPictureParameterBufferJPEGBaseline> m_picParams;  // One per image
+    std::vector<VASliceParameterBufferJPEGBaseline>   m_slcParams;  // One per image
+    std::vector<VAProcPipelineParameterBuffer>        m_procParams; // Target of each image of a batch
+    VAIQMatrixBufferJPEGBaseline                      m_qMatrix;
+    VAHuffmanTableBufferJPEGBaseline                  m_huffTable;
+    std::vector<uint8_t>                              m_bitstream;
+};
+
 class DecTestDataFactory
 {
 public:
@@ -222,6 +254,14 @@ public:
         {
             return new DecTestDataAVCLong(TEST_Intel_Decode_AVC);
         }
+        if (description == "JPEG")
+        {
+            return new DecTestDataJPEG(TEST_Intel_Decode_JPEG);
+        }
+        if (description == "JPEG-Batch")
+        {
+            return new DecTestDataJPEG(TEST_Intel_Decode_JPEG, DEC_FRAME_NUM);
+        }
 
         return nullptr;
     }
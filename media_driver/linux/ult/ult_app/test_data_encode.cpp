@@ -20,6 +20,7 @@
 * OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "test_data_encode.h"
+#include "media_libva_common.h"
 
 using namespace std;
 
@@ -235,16 +236,17 @@ void EncTestDataHEVC::UpdateCompBuffers(int frameId)
     }
 }
 
-EncTestDataAVC::EncTestDataAVC(FeatureID testFeatureID)
+EncTestDataAVC::EncTestDataAVC(FeatureID testFeatureID, uint32_t rcMode)
 {
     m_featureId   = testFeatureID;
     m_picWidth    = 320;
     m_picHeight   = 240;
     m_surfacesNum = 1 + 15; // 1 raw data, 8 references.
 
+    // BRC modes take the bit rate of the SPS.
     m_confAttrib.resize(1);
     m_confAttrib[0].type  = VAConfigAttribRateControl;
-    m_confAttrib[0].value = VA_RC_CQP;
+    m_confAttrib[0].value = rcMode;
 
     m_surfAttrib.resize(1);
     m_surfAttrib[0].type          = VASurfaceAttribPixelFormat;
@@ -366,3 +368,169 @@ void EncTestDataAVC::UpdateCompBuffers(int frameId)
         slc->RefPicList1[0].BottomFieldOrderCnt     = 0x5;
     }
 }
+
+EncTestDataJPEG::EncTestDataJPEG(FeatureID testFeatureID, uint32_t imageNum, uint32_t scanNum, bool tableChange)
+{
+    m_featureId   = testFeatureID;
+    m_picWidth    = 320;
+    m_picHeight   = 240;
+    m_imageNum    = imageNum;
+    m_surfacesNum = imageNum; // 1 raw data per image, no references.
+
+    // Batches are only parsed by contexts that opt in.
+    if (imageNum > 1)
+    {
+        m_contextFlag |= DDI_MEDIA_CONTEXT_FLAG_JPEG_BATCH;
+    }
+
+    m_confAttrib.resize(1);
+    m_confAttrib[0].type  = VAConfigAttribRTFormat;
+    m_confAttrib[0].value = VA_RT_FORMAT_YUV420;
+
+    m_surfAttrib.resize(1);
+    m_surfAttrib[0].type          = VASurfaceAttribPixelFormat;
+    m_surfAttrib[0].flags         = VA_SURFACE_ATTRIB_GETTABLE | VA_SURFACE_ATTRIB_SETTABLE;
+    m_surfAttrib[0].value.type    = VAGenericValueTypePointer;
+    m_surfAttrib[0].value.value.i = VA_FOURCC_NV12;
+
+    m_resources.resize(m_surfacesNum);
+
+    VAEncPictureParameterBufferJPEG picParams;
+    memset(&picParams, 0, sizeof(picParams));
+    picParams.picture_width               = m_picWidth;
+    picParams.picture_height              = m_picHeight;
+    picParams.pic_flags.bits.huffman      = 1;
+    picParams.pic_flags.bits.interleaved  = (scanNum == 1);
+    picParams.sample_bit_depth            = 8;
+    picParams.num_scan                    = scanNum;
+    picParams.num_components              = 3;
+    picParams.quality                     = 50;
+    for (auto i = 0; i < 3; i++)
+    {
+        picParams.component_id[i]             = i + 1;
+        picParams.quantiser_table_selector[i] = (i == 0) ? 0 : 1;
+    }
+    m_picParams.assign(m_imageNum, picParams);
+
+    // The huffman table IDs are taken from the slice parameters, send them first.
+    // Components are coded in order, the last scan takes the remaining ones.
+    m_slcParams.resize(scanNum);
+    uint32_t component = 0;
+    for (uint32_t s = 0; s < scanNum; s++)
+    {
+        VAEncSliceParameterBufferJPEG &slcParams = m_slcParams[s];
+        memset(&slcParams, 0, sizeof(slcParams));
+        slcParams.num_components = (s == scanNum - 1) ? 3 - component : 1;
+        for (auto i = 0; i < slcParams.num_components; i++, component++)
+        {
+            slcParams.components[i].component_selector = component + 1;
+            slcParams.components[i].dc_table_selector  = (component == 0) ? 0 : 1;
+            slcParams.components[i].ac_table_selector  = (component == 0) ? 0 : 1;
+        }
+    }
+
+    // Each image of a batch has its own quantization tables.
+    m_qMatrix.resize(m_imageNum);
+    for (uint32_t k = 0; k < m_imageNum; k++)
+    {
+        memset(&m_qMatrix[k], 0, sizeof(m_qMatrix[k]));
+        m_qMatrix[k].load_lum_quantiser_matrix    = 1;
+        m_qMatrix[k].load_chroma_quantiser_matrix = 1;
+        for (auto i = 0; i < 64; i++)
+        {
+            m_qMatrix[k].lum_quantiser_matrix[i]    = 0x10 + k;
+            m_qMatrix[k].chroma_quantiser_matrix[i] = 0x11 + k;
+        }
+    }
+
+    // Luminance tables of ITU-T T.81 Annex K.3, loaded for luma and chroma.
+    const uint8_t dcCodes[16]  = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+    const uint8_t acCodes[16]  = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d };
+    const uint8_t acValues[162] = {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+        0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+        0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+        0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+        0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+        0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+        0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+        0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+        0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+        0xf9, 0xfa };
+
+    memset(&m_huffTable, 0, sizeof(m_huffTable));
+    for (auto t = 0; t < 2; t++)
+    {
+        m_huffTable.load_huffman_table[t] = 1;
+        memcpy(m_huffTable.huffman_table[t].num_dc_codes, dcCodes, sizeof(dcCodes));
+        memcpy(m_huffTable.huffman_table[t].num_ac_codes, acCodes, sizeof(acCodes));
+        memcpy(m_huffTable.huffman_table[t].ac_values, acValues, sizeof(acValues));
+        for (auto i = 0; i < 12; i++)
+        {
+            m_huffTable.huffman_table[t].dc_values[i] = i;
+        }
+    }
+
+    // The changed tables scale the quantizers and map the DC code lengths to
+    // other categories, so both table commands differ.
+    m_changedQMatrix = m_qMatrix;
+    for (auto &qMatrix : m_changedQMatrix)
+    {
+        for (auto i = 0; i < 64; i++)
+        {
+            qMatrix.lum_quantiser_matrix[i]    *= 2;
+            qMatrix.chroma_quantiser_matrix[i] *= 2;
+        }
+    }
+    m_changedHuffTable = m_huffTable;
+    for (auto t = 0; t < 2; t++)
+    {
+        for (auto i = 0; i < 12; i++)
+        {
+            m_changedHuffTable.huffman_table[t].dc_values[i] = 11 - i;
+        }
+    }
+
+    // Every frame sends the same tables, but for the middle one with tableChange.
+    m_num_frames       = ENC_FRAME_NUM;
+    m_tableChangeFrame = tableChange ? m_num_frames / 2 : -1;
+    m_compBufs.resize(m_num_frames);
+    for (uint32_t i = 0; i < m_num_frames; i++)
+    {
+        bool changed = ((int)i == m_tableChangeFrame);
+        VAQMatrixBufferJPEG *qMatrix = changed ? m_changedQMatrix.data() : m_qMatrix.data();
+        VAHuffmanTableBufferJPEGBaseline *huffTable = changed ? &m_changedHuffTable : &m_huffTable;
+        m_compBufs[i].resize(5 * m_imageNum);
+        for (uint32_t k = 0; k < m_imageNum; k++)
+        {
+            CompBufConif *bufs = &m_compBufs[i][5 * k];
+            // BS buffer
+            bufs[0] = { VAEncCodedBufferType           , (m_picWidth * m_picHeight * 3) >> 1, nullptr                 , 0 };
+            bufs[1] = { VAEncPictureParameterBufferType, (uint32_t)sizeof(m_picParams[k])   , (void *)&m_picParams[k] , 0 };
+            bufs[2] = { VAEncSliceParameterBufferType  , (uint32_t)sizeof(m_slcParams[0])   , (void *)&m_slcParams[0] , 0, scanNum };
+            bufs[3] = { VAQMatrixBufferType            , (uint32_t)sizeof(qMatrix[k])       , (void *)&qMatrix[k]     , 0 };
+            bufs[4] = { VAHuffmanTableBufferType       , (uint32_t)sizeof(*huffTable)       , (void *)huffTable       , 0 };
+        }
+    }
+}
+
+vector<uint8_t> EncTestDataJPEG::GetScanComponents(uint32_t scan)
+{
+    vector<uint8_t> components;
+    for (auto i = 0; i < m_slcParams[scan].num_components; i++)
+    {
+        components.push_back(m_slcParams[scan].components[i].component_selector);
+    }
+    return components;
+}
+
+void EncTestDataJPEG::UpdateCompBuffers(int frameId)
+{
+    // Image k is read from surface k, the first surface is the render target.
+    for (uint32_t k = 0; k < m_imageNum; k++)
+    {
+        m_picParams[k].reconstructed_picture = m_resources[k];
+        m_picParams[k].coded_buf             = m_compBufs[frameId][5 * k].bufID;
+    }
+}
@@ -32,6 +32,7 @@
 
 const FeatureID TEST_Intel_Encode_HEVC  = { VAProfileHEVCMain    , VAEntrypointEncSlice  , };
 const FeatureID TEST_Intel_Encode_AVC   = { VAProfileH264Main    , VAEntrypointEncSlice  , };
+const FeatureID TEST_Intel_Encode_AVC_VDEnc = { VAProfileH264Main, VAEntrypointEncSliceLP, };
 const FeatureID TEST_Intel_Encode_MPEG2 = { VAProfileMPEG2Main   , VAEntrypointEncSlice  , };
 const FeatureID TEST_Intel_Encode_JPEG  = { VAProfileJPEGBaseline, VAEntrypointEncPicture, };
 
@@ -105,6 +106,10 @@ public:
 
     std::vector<VASurfaceAttrib> &GetSurfAttrib() { return m_surfAttrib; }
 
+    int32_t GetContextFlag() { return m_contextFlag; }
+
+    void SetContextFlag(int32_t flag) { m_contextFlag = flag; }
+
     virtual void UpdateCompBuffers(int frameId) { }
 
 public:
@@ -121,6 +126,7 @@ protected:
     std::vector<VASurfaceID>               m_resources;
     std::vector<VAConfigAttrib>            m_confAttrib;
     std::vector<VASurfaceAttrib>           m_surfAttrib;
+    int32_t                                m_contextFlag = VA_PROGRESSIVE;
 };
 
 class EncTestDataHEVC : public EncTestData
@@ -159,7 +165,7 @@ class EncTestDataAVC: public EncTestData
 {
 public:
 
-    EncTestDataAVC(FeatureID testFeatureID);
+    EncTestDataAVC(FeatureID testFeatureID, uint32_t rcMode = VA_RC_CQP);
 
     void UpdateCompBuffers(int frameId) override;
 
@@ -187,6 +193,41 @@ protected:
     std::shared_ptr<AvcEncBufs>      m_pBufs = nullptr;
 };
 
+class EncTestDataJPEG : public EncTestData
+{
+public:
+
+    // Each frame sends imageNum images, encoded in one batch if more than 1.
+    // The images of a batch are read from their reconstructed_picture. Each image has scanNum scans: 1 interleaved scan, the Y scan and an
+    // interleaved CbCr scan, or 1 scan per component. With tableChange, the
+    // frame returned by GetTableChangeFrame sends other quantization and
+    // huffman tables than the frames around it.
+    EncTestDataJPEG(FeatureID testFeatureID, uint32_t imageNum = 1, uint32_t scanNum = 1, bool tableChange = false);
+
+    void UpdateCompBuffers(int frameId) override;
+
+    uint32_t GetImageNum() { return m_imageNum; }
+
+    uint32_t GetScanNum() { return m_slcParams.size(); }
+
+    // Component selectors of a scan, in their order in the scan header.
+    std::vector<uint8_t> GetScanComponents(uint32_t scan);
+
+    // -1 if every frame sends the same tables.
+    int GetTableChangeFrame() { return m_tableChangeFrame; }
+
+protected:
+
+    uint32_t                                     m_imageNum;
+    std::vector<VAEncPictureParameterBufferJPEG> m_picParams;   // One per image
+    std::vector<VAEncSliceParameterBufferJPEG>   m_slcParams;   // One per scan
+    std::vector<VAQMatrixBufferJPEG>             m_qMatrix;     // One per image
+    VAHuffmanTableBufferJPEGBaseline             m_huffTable;
+    int                                          m_tableChangeFrame;
+    std::vector<VAQMatrixBufferJPEG>             m_changedQMatrix;
+    VAHuffmanTableBufferJPEGBaseline             m_changedHuffTable;
+};
+
 class EncTestDataFactory
 {
 public:
@@ -201,6 +242,34 @@ public:
         {
             return new EncTestDataAVC(TEST_Intel_Encode_AVC);
         }
+        if (description == "AVC-VDEnc")
+        {
+            return new EncTestDataAVC(TEST_Intel_Encode_AVC_VDEnc);
+        }
+        if (description == "AVC-VDEnc-CBR")
+        {
+            return new EncTestDataAVC(TEST_Intel_Encode_AVC_VDEnc, VA_RC_CBR);
+        }
+        if (description == "JPEG")
+        {
+            return new EncTestDataJPEG(TEST_Intel_Encode_JPEG);
+        }
+        if (description == "JPEG-Batch")
+        {
+            return new EncTestDataJPEG(TEST_Intel_Encode_JPEG, 3);
+        }
+        if (description == "JPEG-2Scan")
+        {
+            return new EncTestDataJPEG(TEST_Intel_Encode_JPEG, 1, 2);
+        }
+        if (description == "JPEG-3Scan")
+        {
+            return new EncTestDataJPEG(TEST_Intel_Encode_JPEG, 1, 3);
+        }
+        if (description == "JPEG-TableChange")
+        {
+            return new EncTestDataJPEG(TEST_Intel_Encode_JPEG, 1, 1, true);
+        }
 
         return nullptr;
     }
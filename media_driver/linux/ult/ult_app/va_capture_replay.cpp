@@ -0,0 +1,520 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <chrono>
+#include <thread>
+#include "va_capture_replay.h"
+#include "cmd_validator.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static const char *g_captureEntryName[DDI_CAPTURE_ENTRY_NUM] = {
+    "vaCreateConfig",
+    "vaDestroyConfig",
+    "vaCreateSurfaces2",
+    "vaDestroySurfaces",
+    "vaCreateContext",
+    "vaDestroyContext",
+    "vaCreateBuffer",
+    "vaMapBuffer",
+    "vaUnmapBuffer",
+    "vaDestroyBuffer",
+    "vaBeginPicture",
+    "vaRenderPicture",
+    "vaEndPicture",
+    "vaSyncSurface",
+    "vaQuerySurfaceStatus",
+    "vaCreateImage",
+    "vaDeriveImage",
+    "vaDestroyImage",
+};
+
+// Max time a thread waits for an object created by another captured thread.
+static const chrono::seconds g_idWaitTimeout(5);
+
+static uint64_t GetTimeNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Reads the 32 bit arguments then the arrays of a record, in capture order.
+class RecordReader
+{
+public:
+
+    RecordReader(const vector<uint8_t> &args) : m_args(args) { }
+
+    uint32_t Word()
+    {
+        uint32_t word = 0;
+        if (m_offset + sizeof(word) <= m_args.size())
+        {
+            memcpy(&word, &m_args[m_offset], sizeof(word));
+        }
+        m_offset += sizeof(word);
+        return word;
+    }
+
+    const uint8_t *Data(uint32_t size)
+    {
+        const uint8_t *data = (size && m_offset + size <= m_args.size()) ? &m_args[m_offset] : nullptr;
+        m_offset += size;
+        return data;
+    }
+
+    template <class T>
+    vector<T> Array(uint32_t num)
+    {
+        vector<T>      array(num);
+        const uint8_t *data = Data(num * sizeof(T));
+        if (data)
+        {
+            memcpy(array.data(), data, num * sizeof(T));
+        }
+        return array;
+    }
+
+private:
+
+    const vector<uint8_t> &m_args;
+    size_t                m_offset = 0;
+};
+
+void VaCaptureReplayer::ReplayTest(DriverDllLoader &driverLoader, const GpuCmdFactory *cmdFactory,
+                                   const char *captureFile, Platform_t platform)
+{
+    VaCaptureReplayer replayer(driverLoader);
+    bool              loaded = replayer.Load(captureFile);
+    remove(captureFile);
+    ASSERT_TRUE(loaded) << "Platform = " << g_platformName[platform]
+        << ", Failed function = VaCaptureReplayer::Load" << endl;
+    EXPECT_NE(0u, replayer.GetRecordNum()) << "Platform = " << g_platformName[platform] << endl;
+
+    CmdValidator::GpuCmdsValidationInit(cmdFactory, platform);
+    driverLoader.SetUserFeature("VA Capture File", nullptr);
+    int ret = driverLoader.InitDriver(platform);
+    ASSERT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+    replayer.Replay();
+    replayer.PrintProfile();
+    EXPECT_EQ(replayer.GetRecordNum(), replayer.GetReplayedNum()) << "Platform = " << g_platformName[platform] << endl;
+    EXPECT_EQ(0u, replayer.GetMismatchNum()) << "Platform = " << g_platformName[platform] << endl;
+
+    ret = driverLoader.CloseDriver();
+    EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+        << ", Failed function = m_driverLoader.CloseDriver" << endl;
+}
+
+bool VaCaptureReplayer::Load(const char *fileName)
+{
+    DDI_CAPTURE_FILE_HEADER header = {};
+    FILE                    *file  = fopen(fileName, "rb");
+    if (file == nullptr)
+    {
+        printf("ERROR: can't open VA capture %s.\n", fileName);
+        return false;
+    }
+
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != DDI_CAPTURE_MAGIC ||
+        header.version != DDI_CAPTURE_VERSION)
+    {
+        printf("ERROR: %s is not a VA capture.\n", fileName);
+        fclose(file);
+        return false;
+    }
+
+    m_records.clear();
+    m_threadRecords.clear();
+
+    Record record;
+    while (fread(&record.header, sizeof(record.header), 1, file) == 1)
+    {
+        record.args.resize(record.header.argSize);
+        if (record.header.entry >= DDI_CAPTURE_ENTRY_NUM ||
+            (record.header.argSize && fread(record.args.data(), record.header.argSize, 1, file) != 1))
+        {
+            printf("ERROR: VA capture %s is truncated.\n", fileName);
+            fclose(file);
+            return false;
+        }
+
+        m_threadRecords[record.header.thread].push_back(m_records.size());
+        m_records.push_back(record);
+    }
+
+    fclose(file);
+    return true;
+}
+
+void VaCaptureReplayer::Replay()
+{
+    vector<thread> threads;
+
+    m_replayedNum = 0;
+    m_mismatchNum = 0;
+    for (auto &profile : m_profile)
+    {
+        profile = EntryProfile();
+    }
+
+    for (auto &threadRecords : m_threadRecords)
+    {
+        threads.emplace_back(&VaCaptureReplayer::ReplayThread, this, cref(threadRecords.second));
+    }
+
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+}
+
+void VaCaptureReplayer::ReplayThread(const vector<uint32_t> &recordIdx)
+{
+    for (auto idx : recordIdx)
+    {
+        const Record &record  = m_records[idx];
+        uint64_t     startNs  = GetTimeNs();
+        VAStatus     status   = ReplayRecord(record);
+        uint64_t     duration = GetTimeNs() - startNs;
+
+        if (status != record.header.status)
+        {
+            m_mismatchNum++;
+        }
+        m_replayedNum++;
+
+        lock_guard<mutex> lock(m_profileMutex);
+        EntryProfile &profile = m_profile[record.header.entry];
+        profile.calls++;
+        profile.totalNs    += duration;
+        profile.maxNs       = duration > profile.maxNs ? duration : profile.maxNs;
+        profile.capturedNs += record.header.durationNs;
+    }
+}
+
+VAStatus VaCaptureReplayer::ReplayRecord(const Record &record)
+{
+    VADriverContextP ctx = &m_driverLoader.m_ctx;
+    RecordReader     reader(record.args);
+    VAStatus         status = VA_STATUS_SUCCESS;
+
+    switch (record.header.entry)
+    {
+    case DDI_CAPTURE_CREATE_CONFIG:
+    {
+        VAProfile      profile    = (VAProfile)reader.Word();
+        VAEntrypoint   entrypoint = (VAEntrypoint)reader.Word();
+        uint32_t       numAttribs = reader.Word();
+        uint32_t       captured   = reader.Word();
+        auto           attribs    = reader.Array<VAConfigAttrib>(numAttribs);
+        VAConfigID     config     = VA_INVALID_ID;
+
+        status = ctx->vtable->vaCreateConfig(ctx, profile, entrypoint, attribs.data(), numAttribs, &config);
+        if (status == VA_STATUS_SUCCESS)
+        {
+            SetId(m_configs, captured, config);
+        }
+        break;
+    }
+    case DDI_CAPTURE_DESTROY_CONFIG:
+    {
+        uint32_t captured = reader.Word();
+        status = ctx->vtable->vaDestroyConfig(ctx, GetId(m_configs, captured));
+        RemoveId(m_configs, captured);
+        break;
+    }
+    case DDI_CAPTURE_CREATE_SURFACES2:
+    {
+        uint32_t format      = reader.Word();
+        uint32_t width       = reader.Word();
+        uint32_t height      = reader.Word();
+        uint32_t numSurfaces = reader.Word();
+        uint32_t numAttribs  = reader.Word();
+        auto     captured    = reader.Array<VASurfaceID>(numSurfaces);
+        auto     attribs     = reader.Array<VASurfaceAttrib>(numAttribs);
+        vector<VASurfaceID>     surfaces(numSurfaces, VA_INVALID_ID);
+        vector<VASurfaceAttrib> replayAttribs;
+
+        // Pointers of the capturing process can't be replayed
+        for (auto &attrib : attribs)
+        {
+            if (attrib.value.type != VAGenericValueTypePointer)
+            {
+                replayAttribs.push_back(attrib);
+            }
+        }
+
+        status = ctx->vtable->vaCreateSurfaces2(ctx, format, width, height, surfaces.data(), numSurfaces,
+            replayAttribs.empty() ? nullptr : replayAttribs.data(), replayAttribs.size());
+        if (status == VA_STATUS_SUCCESS)
+        {
+            for (uint32_t i = 0; i < numSurfaces; i++)
+            {
+                SetId(m_surfaces, captured[i], surfaces[i]);
+            }
+        }
+        break;
+    }
+    case DDI_CAPTURE_DESTROY_SURFACES:
+    {
+        uint32_t numSurfaces = reader.Word();
+        auto     surfaces    = reader.Array<VASurfaceID>(numSurfaces);
+        auto     captured    = surfaces;
+        for (auto &surface : surfaces)
+        {
+            surface = GetId(m_surfaces, surface);
+        }
+
+        status = ctx->vtable->vaDestroySurfaces(ctx, surfaces.data(), numSurfaces);
+        for (auto surface : captured)
+        {
+            RemoveId(m_surfaces, surface);
+        }
+        break;
+    }
+    case DDI_CAPTURE_CREATE_CONTEXT:
+    {
+        uint32_t    config           = GetId(m_configs, reader.Word());
+        int32_t     width            = reader.Word();
+        int32_t     height           = reader.Word();
+        int32_t     flag             = reader.Word();
+        uint32_t    numRenderTargets = reader.Word();
+        uint32_t    captured         = reader.Word();
+        auto        renderTargets    = reader.Array<VASurfaceID>(numRenderTargets);
+        VAContextID context          = VA_INVALID_ID;
+        for (auto &surface : renderTargets)
+        {
+            surface = GetId(m_surfaces, surface);
+        }
+
+        status = ctx->vtable->vaCreateContext(ctx, config, width, height, flag,
+            renderTargets.empty() ? nullptr : renderTargets.data(), numRenderTargets, &context);
+        if (status == VA_STATUS_SUCCESS)
+        {
+            SetId(m_contexts, captured, context);
+        }
+        break;
+    }
+    case DDI_CAPTURE_DESTROY_CONTEXT:
+    {
+        uint32_t captured = reader.Word();
+        status = ctx->vtable->vaDestroyContext(ctx, GetId(m_contexts, captured));
+        RemoveId(m_contexts, captured);
+        break;
+    }
+    case DDI_CAPTURE_CREATE_BUFFER:
+    {
+        uint32_t     context     = GetId(m_contexts, reader.Word());
+        VABufferType type        = (VABufferType)reader.Word();
+        uint32_t     size        = reader.Word();
+        uint32_t     numElements = reader.Word();
+        uint32_t     captured    = reader.Word();
+        uint32_t     dataSize    = reader.Word();
+        void         *data       = (void *)reader.Data(dataSize);
+        VABufferID   buffer      = VA_INVALID_ID;
+
+        status = ctx->vtable->vaCreateBuffer(ctx, context, type, size, numElements, data, &buffer);
+        if (status == VA_STATUS_SUCCESS)
+        {
+            SetId(m_buffers, captured, buffer);
+        }
+        break;
+    }
+    case DDI_CAPTURE_MAP_BUFFER:
+    {
+        uint32_t buffer = GetId(m_buffers, reader.Word());
+        void     *pbuf  = nullptr;
+
+        status = ctx->vtable->vaMapBuffer(ctx, buffer, &pbuf);
+        if (status == VA_STATUS_SUCCESS)
+        {
+            lock_guard<mutex> lock(m_idMutex);
+            m_mappedBuffers[buffer] = pbuf;
+        }
+        break;
+    }
+    case DDI_CAPTURE_UNMAP_BUFFER:
+    {
+        uint32_t       buffer   = GetId(m_buffers, reader.Word());
+        uint32_t       dataSize = reader.Word();
+        const uint8_t  *data    = reader.Data(dataSize);
+        void           *pbuf    = nullptr;
+        {
+            lock_guard<mutex> lock(m_idMutex);
+            auto it = m_mappedBuffers.find(buffer);
+            if (it != m_mappedBuffers.end())
+            {
+                pbuf = it->second;
+                m_mappedBuffers.erase(it);
+            }
+        }
+
+        // Write what the application wrote through the mapping
+        if (pbuf && data)
+        {
+            memcpy(pbuf, data, dataSize);
+        }
+        status = ctx->vtable->vaUnmapBuffer(ctx, buffer);
+        break;
+    }
+    case DDI_CAPTURE_DESTROY_BUFFER:
+    {
+        uint32_t captured = reader.Word();
+        status = ctx->vtable->vaDestroyBuffer(ctx, GetId(m_buffers, captured));
+        RemoveId(m_buffers, captured);
+        break;
+    }
+    case DDI_CAPTURE_BEGIN_PICTURE:
+    {
+        uint32_t context      = GetId(m_contexts, reader.Word());
+        uint32_t renderTarget = GetId(m_surfaces, reader.Word());
+        status = ctx->vtable->vaBeginPicture(ctx, context, renderTarget);
+        break;
+    }
+    case DDI_CAPTURE_RENDER_PICTURE:
+    {
+        uint32_t context    = GetId(m_contexts, reader.Word());
+        uint32_t numBuffers = reader.Word();
+        auto     buffers    = reader.Array<VABufferID>(numBuffers);
+        for (auto &buffer : buffers)
+        {
+            buffer = GetId(m_buffers, buffer);
+        }
+        status = ctx->vtable->vaRenderPicture(ctx, context, buffers.data(), numBuffers);
+        break;
+    }
+    case DDI_CAPTURE_END_PICTURE:
+        status = ctx->vtable->vaEndPicture(ctx, GetId(m_contexts, reader.Word()));
+        break;
+    case DDI_CAPTURE_SYNC_SURFACE:
+        status = ctx->vtable->vaSyncSurface(ctx, GetId(m_surfaces, reader.Word()));
+        break;
+    case DDI_CAPTURE_QUERY_SURFACE_STATUS:
+    {
+        VASurfaceStatus surfaceStatus;
+        status = ctx->vtable->vaQuerySurfaceStatus(ctx, GetId(m_surfaces, reader.Word()), &surfaceStatus);
+        break;
+    }
+    case DDI_CAPTURE_CREATE_IMAGE:
+    {
+        int32_t       width          = reader.Word();
+        int32_t       height         = reader.Word();
+        uint32_t      capturedImage  = reader.Word();
+        uint32_t      capturedBuffer = reader.Word();
+        auto          format         = reader.Array<VAImageFormat>(1);
+        VAImage       image          = {};
+
+        status = ctx->vtable->vaCreateImage(ctx, format.data(), width, height, &image);
+        if (status == VA_STATUS_SUCCESS)
+        {
+            SetId(m_images, capturedImage, image.image_id);
+            SetId(m_buffers, capturedBuffer, image.buf);
+        }
+        break;
+    }
+    case DDI_CAPTURE_DERIVE_IMAGE:
+    {
+        uint32_t      surface        = GetId(m_surfaces, reader.Word());
+        uint32_t      capturedImage  = reader.Word();
+        uint32_t      capturedBuffer = reader.Word();
+        VAImage       image          = {};
+
+        status = ctx->vtable->vaDeriveImage(ctx, surface, &image);
+        if (status == VA_STATUS_SUCCESS)
+        {
+            SetId(m_images, capturedImage, image.image_id);
+            SetId(m_buffers, capturedBuffer, image.buf);
+        }
+        break;
+    }
+    case DDI_CAPTURE_DESTROY_IMAGE:
+    {
+        uint32_t captured = reader.Word();
+        status = ctx->vtable->vaDestroyImage(ctx, GetId(m_images, captured));
+        RemoveId(m_images, captured);
+        break;
+    }
+    default:
+        status = VA_STATUS_ERROR_UNIMPLEMENTED;
+        break;
+    }
+
+    return status;
+}
+
+uint32_t VaCaptureReplayer::GetId(map<uint32_t, uint32_t> &ids, uint32_t capturedId)
+{
+    if (capturedId == VA_INVALID_ID)
+    {
+        return VA_INVALID_ID;
+    }
+
+    unique_lock<mutex> lock(m_idMutex);
+    if (!m_idCond.wait_for(lock, g_idWaitTimeout, [&] { return ids.count(capturedId) != 0; }))
+    {
+        // Never created during replay, let the driver reject it as it did during capture
+        return capturedId;
+    }
+    return ids[capturedId];
+}
+
+void VaCaptureReplayer::SetId(map<uint32_t, uint32_t> &ids, uint32_t capturedId, uint32_t id)
+{
+    {
+        lock_guard<mutex> lock(m_idMutex);
+        ids[capturedId] = id;
+    }
+    m_idCond.notify_all();
+}
+
+void VaCaptureReplayer::RemoveId(map<uint32_t, uint32_t> &ids, uint32_t capturedId)
+{
+    lock_guard<mutex> lock(m_idMutex);
+    ids.erase(capturedId);
+}
+
+void VaCaptureReplayer::PrintProfile() const
+{
+    printf("[ PERF     ] %u VA calls replayed on %u threads, %u status mismatches\n",
+        (uint32_t)m_replayedNum, (uint32_t)m_threadRecords.size(), (uint32_t)m_mismatchNum);
+
+    for (uint32_t i = 0; i < DDI_CAPTURE_ENTRY_NUM; i++)
+    {
+        const EntryProfile &profile = m_profile[i];
+        if (profile.calls == 0)
+        {
+            continue;
+        }
+
+        printf("[ PERF     ] %-21s %6u calls, total %9.1f us, avg %7.1f us, max %7.1f us (captured total %9.1f us)\n",
+            g_captureEntryName[i], profile.calls,
+            profile.totalNs / 1000.0, profile.totalNs / 1000.0 / profile.calls, profile.maxNs / 1000.0,
+            profile.capturedNs / 1000.0);
+    }
+}
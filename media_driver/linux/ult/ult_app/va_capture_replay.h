@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2018, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef __VA_CAPTURE_REPLAY_H__
+#define __VA_CAPTURE_REPLAY_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <vector>
+#include "driver_loader.h"
+#include "gpu_cmd_factory.h"
+#include "media_libva_capture_format.h"
+
+// Replays a capture of the "VA Capture File" user feature on a loaded driver.
+// Each captured thread is replayed on its own thread, in its captured order,
+// and the CPU time spent in each entry point is reported.
+class VaCaptureReplayer
+{
+public:
+
+    VaCaptureReplayer(DriverDllLoader &driverLoader) : m_driverLoader(driverLoader) { }
+
+    // Replay captureFile on a new driver instance of platform, expect every
+    // call to return its captured status, then remove the capture.
+    static void ReplayTest(DriverDllLoader &driverLoader, const GpuCmdFactory *cmdFactory,
+                           const char *captureFile, Platform_t platform);
+
+    bool Load(const char *fileName);
+
+    // Driver must be initialized by the caller.
+    void Replay();
+
+    void PrintProfile() const;
+
+    uint32_t GetRecordNum() const { return m_records.size(); }
+
+    uint32_t GetReplayedNum() const { return m_replayedNum; }
+
+    uint32_t GetMismatchNum() const { return m_mismatchNum; }
+
+private:
+
+    struct Record
+    {
+        DDI_CAPTURE_RECORD   header;
+        std::vector<uint8_t> args;
+    };
+
+    struct EntryProfile
+    {
+        uint32_t calls      = 0;
+        uint64_t totalNs    = 0;
+        uint64_t maxNs      = 0;
+        uint64_t capturedNs = 0;
+    };
+
+    void ReplayThread(const std::vector<uint32_t> &recordIdx);
+
+    VAStatus ReplayRecord(const Record &record);
+
+    // Replay ID of a captured ID, waits for another thread to create it.
+    uint32_t GetId(std::map<uint32_t, uint32_t> &ids, uint32_t capturedId);
+
+    void SetId(std::map<uint32_t, uint32_t> &ids, uint32_t capturedId, uint32_t id);
+
+    void RemoveId(std::map<uint32_t, uint32_t> &ids, uint32_t capturedId);
+
+private:
+
+    DriverDllLoader                                 &m_driverLoader;
+    std::vector<Record>                             m_records;
+    std::map<uint32_t, std::vector<uint32_t>>       m_threadRecords;    // Captured thread -> record indices
+
+    std::mutex                                      m_idMutex;
+    std::condition_variable                         m_idCond;
+    std::map<uint32_t, uint32_t>                    m_configs;
+    std::map<uint32_t, uint32_t>                    m_surfaces;
+    std::map<uint32_t, uint32_t>                    m_contexts;
+    std::map<uint32_t, uint32_t>                    m_buffers;
+    std::map<uint32_t, uint32_t>                    m_images;
+    std::map<uint32_t, void *>                      m_mappedBuffers;    // Replay buffer ID -> mapping
+
+    std::mutex                                      m_profileMutex;
+    EntryProfile                                    m_profile[DDI_CAPTURE_ENTRY_NUM];
+    std::atomic<uint32_t>                           m_replayedNum{0};
+    std::atomic<uint32_t>                           m_mismatchNum{0};
+};
+
+#endif // __VA_CAPTURE_REPLAY_H__